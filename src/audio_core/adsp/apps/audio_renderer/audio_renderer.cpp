@@ -10,7 +10,9 @@
 #include "audio_core/sink/sink.h"
 #include "common/logging/log.h"
 #include "common/microprofile.h"
+#include "common/perf_metrics.h"
 #include "common/thread.h"
+#include "common/tracing.h"
 #include "core/core.h"
 #include "core/core_timing.h"
 
@@ -134,6 +136,7 @@ void AudioRenderer::Main(std::stop_token stop_token) {
     MicroProfileOnThreadCreate(name);
     Common::SetCurrentThreadName(name);
     Common::SetCurrentThreadPriority(Common::ThreadPriority::High);
+    Common::SetCurrentThreadRole(Common::ThreadRole::Audio);
 
     // TODO: Create buffer map/unmap thread + mailbox
     // TODO: Create gMix devices, initialize them here
@@ -149,6 +152,9 @@ void AudioRenderer::Main(std::stop_token stop_token) {
     // 0.12 seconds (2,304,000 / 19,200,000)
     constexpr u64 max_process_time{2'304'000ULL};
 
+    // Rendering has to keep up with the 5ms the sink plays per command list
+    constexpr auto render_deadline{std::chrono::microseconds{5000}};
+
     while (!stop_token.stop_requested()) {
         auto msg{mailbox.Receive(Direction::DSP)};
         switch (msg) {
@@ -157,6 +163,7 @@ void AudioRenderer::Main(std::stop_token stop_token) {
             return;
 
         case Message::Render: {
+            TRACE_ZONE("ADSP render");
             if (system.IsShuttingDown()) [[unlikely]] {
                 std::this_thread::sleep_for(std::chrono::milliseconds(5));
                 mailbox.Send(Direction::Host, Message::RenderResponse);
@@ -165,6 +172,7 @@ void AudioRenderer::Main(std::stop_token stop_token) {
             std::array<bool, MaxRendererSessions> buffers_reset{};
             std::array<u64, MaxRendererSessions> render_times_taken{};
             const auto start_time{system.CoreTiming().GetGlobalTimeUs().count()};
+            std::chrono::steady_clock::duration process_walltime{};
 
             for (u32 index = 0; index < MaxRendererSessions; index++) {
                 auto& command_buffer{command_buffers[index]};
@@ -177,7 +185,8 @@ void AudioRenderer::Main(std::stop_token stop_token) {
                     if (command_buffer.remaining_command_count == 0) {
                         command_list_processor.Initialize(system, *command_buffer.process,
                                                           command_buffer.buffer,
-                                                          command_buffer.size, streams[index]);
+                                                          command_buffer.size, streams[index],
+                                                          adpcm_cache);
                     }
 
                     if (command_buffer.reset_buffer && !buffers_reset[index]) {
@@ -204,8 +213,10 @@ void AudioRenderer::Main(std::stop_token stop_token) {
                     // Process the command list
                     {
                         MICROPROFILE_SCOPE(Audio_Renderer);
+                        const auto process_begin{std::chrono::steady_clock::now()};
                         render_times_taken[index] =
                             command_list_processor.Process(index) - start_time;
+                        process_walltime += std::chrono::steady_clock::now() - process_begin;
                     }
 
                     const auto end_time{system.CoreTiming().GetGlobalTimeUs().count()};
@@ -216,6 +227,10 @@ void AudioRenderer::Main(std::stop_token stop_token) {
                 }
             }
 
+            const auto process_us{
+                std::chrono::duration_cast<std::chrono::microseconds>(process_walltime)};
+            Common::PerfMetrics::RecordMinimum(Common::PerfMetrics::Minimum::AdspDeadlineMarginUs,
+                                               (render_deadline - process_us).count());
             mailbox.Send(Direction::Host, Message::RenderResponse);
         } break;
 
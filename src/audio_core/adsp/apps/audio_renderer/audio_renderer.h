@@ -10,6 +10,7 @@
 #include "audio_core/adsp/apps/audio_renderer/command_buffer.h"
 #include "audio_core/adsp/apps/audio_renderer/command_list_processor.h"
 #include "audio_core/adsp/mailbox.h"
+#include "audio_core/renderer/command/data_source/decode.h"
 #include "common/common_types.h"
 #include "common/polyfill_thread.h"
 #include "common/reader_writer_queue.h"
@@ -106,6 +107,8 @@ private:
     std::array<CommandBuffer, MaxRendererSessions> command_buffers{};
     /// The command lists to process
     std::array<CommandListProcessor, MaxRendererSessions> command_list_processors{};
+    /// Decoded ADPCM wavebuffers, replayed by the voices of every session
+    Renderer::AdpcmDecodeCache adpcm_cache;
     /// The streams which will receive the processed samples
     std::array<Sink::SinkStream*, MaxRendererSessions> streams{};
     /// CPU Tick when the DSP was signalled to process, uses time rather than tick
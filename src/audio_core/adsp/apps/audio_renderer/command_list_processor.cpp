@@ -1,24 +1,124 @@
 // SPDX-FileCopyrightText: Copyright 2023 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <latch>
 #include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #include "audio_core/adsp/apps/audio_renderer/command_list_processor.h"
 #include "audio_core/renderer/command/command_list_header.h"
+#include "audio_core/renderer/command/command_processing_time_estimator.h"
 #include "audio_core/renderer/command/commands.h"
 #include "common/settings.h"
+#include "common/thread_worker.h"
 #include "core/core.h"
 #include "core/core_timing.h"
 #include "core/hle/kernel/k_process.h"
 #include "core/memory.h"
 
 namespace AudioCore::ADSP::AudioRenderer {
+namespace {
+/// Node id type of the commands generated for voices, stored in the top bits of the node id
+constexpr u32 VoiceNodeIdType{1};
+/// Fewer voices than this are processed serially, as dispatching them would cost more
+constexpr size_t MinParallelVoices{8};
+/// Fewer biquad filter commands than this are processed on their own
+constexpr size_t MinBatchedFilterCommands{2};
+
+size_t GetVoiceWorkerCount() {
+    // The ADSP thread processes a lane itself, so leave one hardware thread for it.
+    static const size_t count{std::clamp<size_t>(std::thread::hardware_concurrency(), 2, 8) - 1};
+    return count;
+}
+
+Common::ThreadWorker& GetVoiceWorkers() {
+    static Common::ThreadWorker workers(GetVoiceWorkerCount(), "AudioVoiceWorker");
+    return workers;
+}
+
+/// Whether a command only touches its voice's state and scratch buffers, or adds to the mix
+/// buffers, so that voices can be processed in any order and summed afterwards.
+bool IsParallelVoiceCommand(const Renderer::ICommand& command) {
+    if ((command.node_id >> 28) != VoiceNodeIdType) {
+        return false;
+    }
+    switch (command.type) {
+    case Renderer::CommandId::DataSourcePcmInt16Version1:
+    case Renderer::CommandId::DataSourcePcmInt16Version2:
+    case Renderer::CommandId::DataSourcePcmFloatVersion1:
+    case Renderer::CommandId::DataSourcePcmFloatVersion2:
+    case Renderer::CommandId::DataSourceAdpcmVersion1:
+    case Renderer::CommandId::DataSourceAdpcmVersion2:
+    case Renderer::CommandId::DepopPrepare:
+    case Renderer::CommandId::BiquadFilter:
+    case Renderer::CommandId::MultiTapBiquadFilter:
+    case Renderer::CommandId::VolumeRamp:
+    case Renderer::CommandId::MixRamp:
+    case Renderer::CommandId::MixRampGrouped:
+        return true;
+    default:
+        // Performance commands share their entry count, so they keep voices serial
+        return false;
+    }
+}
+
+/// Whether a command is a biquad filter command, which the processor can batch.
+bool IsBiquadFilterCommand(const Renderer::ICommand& command) {
+    return command.type == Renderer::CommandId::BiquadFilter ||
+           command.type == Renderer::CommandId::MultiTapBiquadFilter;
+}
+
+/// Whether a biquad filter command filters the same way as the first command of a batch, so
+/// both can be filtered by one kernel call.
+bool FiltersLike(const Renderer::ICommand& first, const Renderer::ICommand& command) {
+    if (command.type != first.type || !command.enabled) {
+        return false;
+    }
+    if (command.type == Renderer::CommandId::BiquadFilter) {
+        return static_cast<const Renderer::BiquadFilterCommand&>(command).use_float_processing ==
+               static_cast<const Renderer::BiquadFilterCommand&>(first).use_float_processing;
+    }
+    return static_cast<const Renderer::MultiTapBiquadFilterCommand&>(command).filter_tap_count ==
+           static_cast<const Renderer::MultiTapBiquadFilterCommand&>(first).filter_tap_count;
+}
+
+/// Mix buffers read and written by a biquad filter command.
+std::pair<s16, s16> GetFilterBuffers(const Renderer::ICommand& command) {
+    if (command.type == Renderer::CommandId::BiquadFilter) {
+        const auto& filter{static_cast<const Renderer::BiquadFilterCommand&>(command)};
+        return {filter.input, filter.output};
+    }
+    const auto& filter{static_cast<const Renderer::MultiTapBiquadFilterCommand&>(command)};
+    return {filter.input, filter.output};
+}
+
+/// Process a command, adding how long it took to the samples if they are being collected.
+void ProcessCommand(Renderer::ICommand& command, const CommandListProcessor& processor,
+                    Renderer::CommandProcessingSamples* samples) {
+    if (samples == nullptr) {
+        command.Process(processor);
+        return;
+    }
+    const auto start{std::chrono::steady_clock::now()};
+    command.Process(processor);
+    const auto elapsed{std::chrono::steady_clock::now() - start};
+    const auto elapsed_ns{std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()};
+    samples->Add(command, static_cast<u64>(elapsed_ns));
+}
+} // Anonymous namespace
 
 void CommandListProcessor::Initialize(Core::System& system_, Kernel::KProcess& process,
-                                      CpuAddr buffer, u64 size, Sink::SinkStream* stream_) {
+                                      CpuAddr buffer, u64 size, Sink::SinkStream* stream_,
+                                      Renderer::AdpcmDecodeCache& adpcm_cache_) {
     system = &system_;
     memory = &process.GetMemory();
     stream = stream_;
+    adpcm_cache = &adpcm_cache_;
     header = reinterpret_cast<Renderer::CommandListHeader*>(buffer);
     commands = reinterpret_cast<u8*>(buffer + sizeof(Renderer::CommandListHeader));
     commands_buffer_size = size;
@@ -54,10 +154,37 @@ u64 CommandListProcessor::Process(u32 session_id) {
     }
 
     std::string dump{fmt::format("\nSession {}\n", session_id)};
+    bool voices_dispatched{false};
+    Renderer::CommandProcessingSamples samples;
+    const bool measure_commands{Settings::values.audio_host_timing.GetValue()};
+    auto* const measured_samples{measure_commands ? &samples : nullptr};
 
     for (u32 index = 0; index < command_count; index++) {
         auto& command{*reinterpret_cast<Renderer::ICommand*>(commands)};
 
+        // Voice commands are generated in one run, try to process it in parallel once
+        if (!voices_dispatched && command.magic == Renderer::CommandMagic &&
+            IsParallelVoiceCommand(command) && !Settings::values.dump_audio_commands) {
+            voices_dispatched = true;
+            const u32 processed{
+                ProcessVoiceCommands(command_base, command_count - index, measured_samples)};
+            if (processed > 0) {
+                index += processed - 1;
+                continue;
+            }
+        }
+
+        // Effects filter each of their channels with a command of its own, in a row
+        if (command.magic == Renderer::CommandMagic && IsBiquadFilterCommand(command) &&
+            !Settings::values.dump_audio_commands) {
+            const u32 processed{
+                ProcessBiquadFilterCommands(command_base, command_count - index, measured_samples)};
+            if (processed > 0) {
+                index += processed - 1;
+                continue;
+            }
+        }
+
         if (command.magic != 0xCAFEBABE) {
             LOG_ERROR(Service_Audio, "Command has invalid magic! Expected 0xCAFEBABE, got {:08X}",
                       command.magic);
@@ -83,7 +210,7 @@ u64 CommandListProcessor::Process(u32 session_id) {
         }
 
         if (command.enabled) {
-            command.Process(*this);
+            ProcessCommand(command, *this, measured_samples);
         } else {
             dump += fmt::format("\tDisabled!\n");
         }
@@ -97,8 +224,170 @@ u64 CommandListProcessor::Process(u32 session_id) {
         last_dump = dump;
     }
 
+    if (measure_commands) {
+        Renderer::CommandProcessingTimeCalibration::Get().Update(samples);
+    }
+
     end_time = system->CoreTiming().GetGlobalTimeUs().count();
     return end_time - start_time_;
 }
 
+u32 CommandListProcessor::ProcessVoiceCommands(CpuAddr command_base, u32 max_count,
+                                               Renderer::CommandProcessingSamples* samples) {
+    if (buffer_count <= MaxChannels) {
+        return 0;
+    }
+
+    // Collect the commands of each voice, depops are prepared up front as they add to the shared
+    // depop buffer, and no other voice command reads it.
+    std::vector<Renderer::ICommand*> depop_commands;
+    std::vector<Renderer::ICommand*> voice_commands;
+    std::vector<size_t> voice_starts;
+    u8* current{commands};
+    u32 count{0};
+    for (; count < max_count; count++) {
+        auto& command{*reinterpret_cast<Renderer::ICommand*>(current)};
+        if (command.magic != Renderer::CommandMagic ||
+            CpuAddr(current) - command_base + command.size > commands_buffer_size ||
+            !IsParallelVoiceCommand(command) || !command.Verify(*this)) {
+            break;
+        }
+        current += command.size;
+        if (!command.enabled) {
+            continue;
+        }
+        if (command.type == Renderer::CommandId::DepopPrepare) {
+            depop_commands.push_back(&command);
+            continue;
+        }
+        if (voice_commands.empty() || voice_commands.back()->node_id != command.node_id) {
+            voice_starts.push_back(voice_commands.size());
+        }
+        voice_commands.push_back(&command);
+    }
+    if (voice_starts.size() < MinParallelVoices) {
+        return 0;
+    }
+    voice_starts.push_back(voice_commands.size());
+
+    for (auto* command : depop_commands) {
+        ProcessCommand(*command, *this, samples);
+    }
+
+    // Voices decode into the scratch buffers after the mix buffers, so each lane needs its own
+    // copy of all of them. The mixes into the mix buffers only add, and sum up the same way in
+    // any order.
+    const size_t voice_count{voice_starts.size() - 1};
+    const size_t lane_count{std::min(GetVoiceWorkerCount() + 1, voice_count)};
+    std::vector<std::vector<s32>> lane_buffers(lane_count, std::vector<s32>(mix_buffers.size()));
+    std::vector<Renderer::CommandProcessingSamples> lane_samples(samples ? lane_count : 0);
+
+    std::atomic<size_t> next_voice{0};
+    std::latch lanes_done{static_cast<std::ptrdiff_t>(lane_count)};
+    const auto process_lane = [&](size_t lane) {
+        CommandListProcessor lane_processor{*this};
+        lane_processor.mix_buffers = lane_buffers[lane];
+        auto* const measured_samples{samples ? &lane_samples[lane] : nullptr};
+        for (size_t voice = next_voice++; voice < voice_count; voice = next_voice++) {
+            for (size_t i = voice_starts[voice]; i < voice_starts[voice + 1]; i++) {
+                ProcessCommand(*voice_commands[i], lane_processor, measured_samples);
+            }
+        }
+        lanes_done.count_down();
+    };
+
+    auto& workers{GetVoiceWorkers()};
+    for (size_t lane = 1; lane < lane_count; lane++) {
+        workers.QueueWork([&process_lane, lane] { process_lane(lane); });
+    }
+    process_lane(0);
+    lanes_done.wait();
+    // Voices are budgeted by the time they add to the command list, so share the lane times
+    for (const auto& lane : lane_samples) {
+        samples->Merge(lane, lane_count);
+    }
+
+    const size_t mix_size{(buffer_count - MaxChannels) * sample_count};
+    for (const auto& buffer : lane_buffers) {
+        for (size_t i = 0; i < mix_size; i++) {
+            mix_buffers[i] += buffer[i];
+        }
+    }
+
+    commands = current;
+    processed_command_count += count;
+    return count;
+}
+
+u32 CommandListProcessor::ProcessBiquadFilterCommands(CpuAddr command_base, u32 max_count,
+                                                      Renderer::CommandProcessingSamples* samples) {
+    // Collect the run of commands filtering like the first one. Channels are filtered together
+    // sample by sample, so none may read or write a buffer an earlier channel writes, or write
+    // a buffer an earlier channel reads.
+    const auto& first{*reinterpret_cast<Renderer::ICommand*>(commands)};
+    std::vector<Renderer::ICommand*> filter_commands;
+    std::vector<s16> read_buffers;
+    std::vector<s16> written_buffers;
+    u8* current{commands};
+    for (u32 count = 0; count < max_count; count++) {
+        auto& command{*reinterpret_cast<Renderer::ICommand*>(current)};
+        if (command.magic != Renderer::CommandMagic ||
+            CpuAddr(current) - command_base + command.size > commands_buffer_size ||
+            !FiltersLike(first, command) || !command.Verify(*this)) {
+            break;
+        }
+        const auto [input, output]{GetFilterBuffers(command)};
+        if (std::ranges::find(written_buffers, input) != written_buffers.end() ||
+            std::ranges::find(written_buffers, output) != written_buffers.end() ||
+            std::ranges::find(read_buffers, output) != read_buffers.end()) {
+            break;
+        }
+        read_buffers.push_back(input);
+        written_buffers.push_back(output);
+        filter_commands.push_back(&command);
+        current += command.size;
+    }
+    if (filter_commands.size() < MinBatchedFilterCommands) {
+        return 0;
+    }
+
+    const auto start{std::chrono::steady_clock::now()};
+    std::vector<Renderer::BiquadFilterChannel> channels;
+    channels.reserve(filter_commands.size());
+    for (auto* command : filter_commands) {
+        if (command->type == Renderer::CommandId::BiquadFilter) {
+            auto& filter{*static_cast<Renderer::BiquadFilterCommand*>(command)};
+            channels.push_back(filter.Prepare(*this));
+        } else {
+            auto& filter{*static_cast<Renderer::MultiTapBiquadFilterCommand*>(command)};
+            channels.push_back(filter.Prepare(*this));
+        }
+    }
+
+    if (first.type == Renderer::CommandId::BiquadFilter) {
+        if (static_cast<const Renderer::BiquadFilterCommand&>(first).use_float_processing) {
+            Renderer::ApplyBiquadFiltersFloat(channels, 1, sample_count);
+        } else {
+            Renderer::ApplyBiquadFiltersInt(channels, 1, sample_count);
+        }
+    } else {
+        const auto& filter{static_cast<const Renderer::MultiTapBiquadFilterCommand&>(first)};
+        Renderer::ApplyBiquadFiltersFloat(channels, filter.filter_tap_count, sample_count);
+    }
+
+    if (samples != nullptr) {
+        // Share the batch's time between its commands, each is estimated on its own
+        const auto elapsed{std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start)};
+        for (auto* command : filter_commands) {
+            samples->Add(*command, static_cast<u64>(elapsed.count()) / filter_commands.size());
+        }
+    }
+
+    const auto count{static_cast<u32>(filter_commands.size())};
+    commands = current;
+    processed_command_count += count;
+    return count;
+}
+
 } // namespace AudioCore::ADSP::AudioRenderer
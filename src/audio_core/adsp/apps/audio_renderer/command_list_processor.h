@@ -26,8 +26,10 @@ class SinkStream;
 }
 
 namespace Renderer {
+class AdpcmDecodeCache;
 struct CommandListHeader;
-}
+struct CommandProcessingSamples;
+} // namespace Renderer
 
 namespace ADSP::AudioRenderer {
 
@@ -43,9 +45,10 @@ public:
      * @param buffer - The command buffer to process.
      * @param size   - The size of the buffer.
      * @param stream - The stream to be used for sending the samples.
+     * @param adpcm_cache - Cache of decoded ADPCM wavebuffers.
      */
     void Initialize(Core::System& system, Kernel::KProcess& process, CpuAddr buffer, u64 size,
-                    Sink::SinkStream* stream);
+                    Sink::SinkStream* stream, Renderer::AdpcmDecodeCache& adpcm_cache);
 
     /**
      * Set the maximum processing time for this command list.
@@ -83,6 +86,8 @@ public:
     Core::Memory::Memory* memory{};
     /// Stream for the processed samples
     Sink::SinkStream* stream{};
+    /// Cache of decoded ADPCM wavebuffers, shared by the sessions
+    Renderer::AdpcmDecodeCache* adpcm_cache{};
     /// Header info for this command list
     Renderer::CommandListHeader* header{};
     /// The command buffer
@@ -111,6 +116,31 @@ public:
     u64 end_time{};
     /// Last command list string generated, used for dumping audio commands to console
     std::string last_dump{};
+
+private:
+    /**
+     * Process the run of voice commands at the current command in parallel, with each voice's
+     * commands mixed into a lane's private mix buffers which are then summed.
+     *
+     * @param command_base - Address the command buffer bounds are checked from.
+     * @param max_count    - Maximum number of commands to process.
+     * @param samples      - Processing times to add the commands' to, or nullptr.
+     * @return Number of commands processed, 0 if they should be processed serially instead.
+     */
+    u32 ProcessVoiceCommands(CpuAddr command_base, u32 max_count,
+                             Renderer::CommandProcessingSamples* samples);
+
+    /**
+     * Process the run of biquad filter commands at the current command together, with their
+     * channels filtered across vector lanes.
+     *
+     * @param command_base - Address the command buffer bounds are checked from.
+     * @param max_count    - Maximum number of commands to process.
+     * @param samples      - Processing times to add the commands' to, or nullptr.
+     * @return Number of commands processed, 0 if they should be processed one by one instead.
+     */
+    u32 ProcessBiquadFilterCommands(CpuAddr command_base, u32 max_count,
+                                    Renderer::CommandProcessingSamples* samples);
 };
 
 } // namespace ADSP::AudioRenderer
@@ -53,6 +53,10 @@ OpusDecoder::~OpusDecoder() {
                Message::ShutdownOK, msg);
     main_thread.request_stop();
     main_thread.join();
+    for (auto& lane : decode_lanes) {
+        lane.thread.request_stop();
+        lane.thread.join();
+    }
     running = false;
 }
 
@@ -64,6 +68,14 @@ u32 OpusDecoder::Receive(Direction dir, std::stop_token stop_token) {
     return mailbox.Receive(dir, stop_token);
 }
 
+void OpusDecoder::SendDecode(size_t lane, Direction dir, u32 message) {
+    decode_lanes[lane].mailbox.Send(dir, std::move(message));
+}
+
+u32 OpusDecoder::ReceiveDecode(size_t lane, Direction dir, std::stop_token stop_token) {
+    return decode_lanes[lane].mailbox.Receive(dir, stop_token);
+}
+
 void OpusDecoder::Init(std::stop_token stop_token) {
     Common::SetCurrentThreadName("DSP_OpusDecoder_Init");
 
@@ -73,6 +85,10 @@ void OpusDecoder::Init(std::stop_token stop_token) {
         return;
     }
     main_thread = std::jthread([this](std::stop_token st) { Main(st); });
+    for (size_t lane = 0; lane < decode_lanes.size(); lane++) {
+        decode_lanes[lane].thread =
+            std::jthread([this, lane](std::stop_token st) { DecodeMain(st, lane); });
+    }
     running = true;
     Send(Direction::Host, Message::StartOK);
 }
@@ -123,43 +139,10 @@ void OpusDecoder::Main(std::stop_token stop_token) {
             Send(Direction::Host, Message::ShutdownDecodeObjectOK);
         } break;
 
-        case DecodeInterleaved: {
-            auto start_time = system.CoreTiming().GetGlobalTimeUs();
-
-            auto buffer = shared_memory->host_send_data[0];
-            auto input_data = shared_memory->host_send_data[1];
-            auto input_data_size = shared_memory->host_send_data[2];
-            auto output_data = shared_memory->host_send_data[3];
-            auto output_data_size = shared_memory->host_send_data[4];
-            auto final_range = static_cast<u32>(shared_memory->host_send_data[5]);
-            auto reset_requested = shared_memory->host_send_data[6];
-
-            u32 decoded_samples{0};
-
-            auto& decoder_object = OpusDecodeObject::Initialize(buffer, buffer);
-            s32 error_code{OPUS_OK};
-            if (reset_requested) {
-                error_code = decoder_object.ResetDecoder();
-            }
-
-            if (error_code == OPUS_OK) {
-                error_code = decoder_object.Decode(decoded_samples, output_data, output_data_size,
-                                                   input_data, input_data_size);
-            }
-
-            if (error_code == OPUS_OK) {
-                if (final_range && decoder_object.GetFinalRange() != final_range) {
-                    error_code = OPUS_INVALID_PACKET;
-                }
-            }
-
-            auto end_time = system.CoreTiming().GetGlobalTimeUs();
-            shared_memory->dsp_return_data[0] = error_code;
-            shared_memory->dsp_return_data[1] = decoded_samples;
-            shared_memory->dsp_return_data[2] = (end_time - start_time).count();
-
+        case DecodeInterleaved:
+            Decode<OpusDecodeObject>(*shared_memory);
             Send(Direction::Host, Message::DecodeInterleavedOK);
-        } break;
+            break;
 
         case MapMemory: {
             [[maybe_unused]] auto buffer = shared_memory->host_send_data[0];
@@ -221,49 +204,83 @@ void OpusDecoder::Main(std::stop_token stop_token) {
             Send(Direction::Host, Message::ShutdownMultiStreamDecodeObjectOK);
         } break;
 
-        case DecodeInterleavedForMultiStream: {
-            auto start_time = system.CoreTiming().GetGlobalTimeUs();
+        case DecodeInterleavedForMultiStream:
+            Decode<OpusMultiStreamDecodeObject>(*shared_memory);
+            Send(Direction::Host, Message::DecodeInterleavedForMultiStreamOK);
+            break;
 
-            auto buffer = shared_memory->host_send_data[0];
-            auto input_data = shared_memory->host_send_data[1];
-            auto input_data_size = shared_memory->host_send_data[2];
-            auto output_data = shared_memory->host_send_data[3];
-            auto output_data_size = shared_memory->host_send_data[4];
-            auto final_range = static_cast<u32>(shared_memory->host_send_data[5]);
-            auto reset_requested = shared_memory->host_send_data[6];
+        default:
+            LOG_ERROR(Service_Audio, "Invalid OpusDecoder command {}", msg);
+            continue;
+        }
+    }
+}
 
-            u32 decoded_samples{0};
+void OpusDecoder::DecodeMain(std::stop_token stop_token, size_t lane) {
+    Common::SetCurrentThreadName(fmt::format("DSP_OpusDecoder_Lane{}", lane).c_str());
 
-            auto& decoder_object = OpusMultiStreamDecodeObject::Initialize(buffer, buffer);
-            s32 error_code{OPUS_OK};
-            if (reset_requested) {
-                error_code = decoder_object.ResetDecoder();
-            }
-
-            if (error_code == OPUS_OK) {
-                error_code = decoder_object.Decode(decoded_samples, output_data, output_data_size,
-                                                   input_data, input_data_size);
-            }
-
-            if (error_code == OPUS_OK) {
-                if (final_range && decoder_object.GetFinalRange() != final_range) {
-                    error_code = OPUS_INVALID_PACKET;
-                }
-            }
-
-            auto end_time = system.CoreTiming().GetGlobalTimeUs();
-            shared_memory->dsp_return_data[0] = error_code;
-            shared_memory->dsp_return_data[1] = decoded_samples;
-            shared_memory->dsp_return_data[2] = (end_time - start_time).count();
+    auto& decode_lane{decode_lanes[lane]};
+    while (!stop_token.stop_requested()) {
+        const auto msg{decode_lane.mailbox.Receive(Direction::DSP, stop_token)};
+        switch (msg) {
+        case Invalid:
+            // Stop requested
+            break;
 
-            Send(Direction::Host, Message::DecodeInterleavedForMultiStreamOK);
-        } break;
+        case DecodeInterleaved:
+            Decode<OpusDecodeObject>(*decode_lane.shared_memory);
+            decode_lane.mailbox.Send(Direction::Host, Message::DecodeInterleavedOK);
+            break;
+
+        case DecodeInterleavedForMultiStream:
+            Decode<OpusMultiStreamDecodeObject>(*decode_lane.shared_memory);
+            decode_lane.mailbox.Send(Direction::Host,
+                                     Message::DecodeInterleavedForMultiStreamOK);
+            break;
 
         default:
-            LOG_ERROR(Service_Audio, "Invalid OpusDecoder command {}", msg);
-            continue;
+            LOG_ERROR(Service_Audio, "Invalid OpusDecoder decode lane command {}", msg);
+            break;
         }
     }
 }
 
+template <typename DecodeObject>
+void OpusDecoder::Decode(SharedMemory& shared_memory_) {
+    MICROPROFILE_SCOPE(OpusDecoder);
+    auto start_time = system.CoreTiming().GetGlobalTimeUs();
+
+    auto buffer = shared_memory_.host_send_data[0];
+    auto input_data = shared_memory_.host_send_data[1];
+    auto input_data_size = shared_memory_.host_send_data[2];
+    auto output_data = shared_memory_.host_send_data[3];
+    auto output_data_size = shared_memory_.host_send_data[4];
+    auto final_range = static_cast<u32>(shared_memory_.host_send_data[5]);
+    auto reset_requested = shared_memory_.host_send_data[6];
+
+    u32 decoded_samples{0};
+
+    auto& decoder_object = DecodeObject::Initialize(buffer, buffer);
+    s32 error_code{OPUS_OK};
+    if (reset_requested) {
+        error_code = decoder_object.ResetDecoder();
+    }
+
+    if (error_code == OPUS_OK) {
+        error_code = decoder_object.Decode(decoded_samples, output_data, output_data_size,
+                                           input_data, input_data_size);
+    }
+
+    if (error_code == OPUS_OK) {
+        if (final_range && decoder_object.GetFinalRange() != final_range) {
+            error_code = OPUS_INVALID_PACKET;
+        }
+    }
+
+    auto end_time = system.CoreTiming().GetGlobalTimeUs();
+    shared_memory_.dsp_return_data[0] = error_code;
+    shared_memory_.dsp_return_data[1] = decoded_samples;
+    shared_memory_.dsp_return_data[2] = (end_time - start_time).count();
+}
+
 } // namespace AudioCore::ADSP::OpusDecoder
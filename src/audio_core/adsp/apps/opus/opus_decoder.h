@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <array>
 #include <memory>
 #include <thread>
 
@@ -16,6 +17,10 @@ class System;
 
 namespace AudioCore::ADSP::OpusDecoder {
 
+/// Number of threads decoding packets, each with its own mailbox and shared memory, so packets
+/// of different decode objects can be decoded concurrently
+constexpr size_t DecodeLaneCount{4};
+
 enum Message : u32 {
     Invalid = 0,
     Start = 1,
@@ -64,7 +69,37 @@ public:
         shared_memory = &shared_memory_;
     }
 
+    /**
+     * Send a decode message to one of the decode lanes.
+     * Only DecodeInterleaved and DecodeInterleavedForMultiStream are handled by them.
+     *
+     * @param lane    - Index of the decode lane, less than DecodeLaneCount.
+     * @param dir     - Direction of the message.
+     * @param message - Message to send.
+     */
+    void SendDecode(size_t lane, Direction dir, u32 message);
+
+    /**
+     * Receive a message from one of the decode lanes.
+     *
+     * @param lane       - Index of the decode lane, less than DecodeLaneCount.
+     * @param dir        - Direction of the message.
+     * @param stop_token - Stops waiting for a message.
+     * @return The message received.
+     */
+    u32 ReceiveDecode(size_t lane, Direction dir, std::stop_token stop_token = {});
+
+    void SetDecodeSharedMemory(size_t lane, SharedMemory& shared_memory_) {
+        decode_lanes[lane].shared_memory = &shared_memory_;
+    }
+
 private:
+    /// A thread decoding packets, with its own mailbox and shared memory
+    struct DecodeLane {
+        Mailbox mailbox;
+        SharedMemory* shared_memory{};
+        std::jthread thread;
+    };
     /**
      * Initializing thread, launched at audio_core boot to avoid blocking the main emu boot thread.
      */
@@ -73,6 +108,18 @@ private:
      * Main OpusDecoder thread, responsible for processing the incoming Opus packets.
      */
     void Main(std::stop_token stop_token);
+    /**
+     * Decode lane thread, decoding the packets sent to its mailbox.
+     */
+    void DecodeMain(std::stop_token stop_token, size_t lane);
+    /**
+     * Decode the packet described by the shared memory, writing back the results.
+     *
+     * @tparam DecodeObject  - OpusDecodeObject or OpusMultiStreamDecodeObject.
+     * @param shared_memory_ - The request and results.
+     */
+    template <typename DecodeObject>
+    void Decode(SharedMemory& shared_memory_);
 
     /// Core system
     Core::System& system;
@@ -87,6 +134,8 @@ private:
     /// Structure shared with the host, input data set by the host before sending a mailbox message,
     /// and the responses are written back by the OpusDecoder.
     SharedMemory* shared_memory{};
+    /// Decode lanes, each decode object is always sent to the same one by the host
+    std::array<DecodeLane, DecodeLaneCount> decode_lanes{};
 };
 
 } // namespace AudioCore::ADSP::OpusDecoder
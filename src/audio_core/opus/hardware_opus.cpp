@@ -35,11 +35,22 @@ static constexpr Result ResultCodeFromLibOpusErrorCode(u64 error_code) {
     UNREACHABLE();
 }
 
+/// Decode objects always use the same lane, so their packets are decoded in order
+size_t GetDecodeLane(const void* buffer) {
+    // Work buffers are separate allocations, so mix their address to spread them out
+    const auto address{reinterpret_cast<u64>(buffer)};
+    return static_cast<size_t>((address * 0x9E3779B97F4A7C15ULL) >> 32) %
+           ADSP::OpusDecoder::DecodeLaneCount;
+}
+
 } // namespace
 
 HardwareOpus::HardwareOpus(Core::System& system_)
     : system{system_}, opus_decoder{system.AudioCore().ADSP().OpusDecoder()} {
     opus_decoder.SetSharedMemory(shared_memory);
+    for (size_t lane = 0; lane < decode_lanes.size(); lane++) {
+        opus_decoder.SetDecodeSharedMemory(lane, decode_lanes[lane].shared_memory);
+    }
 }
 
 u32 HardwareOpus::GetWorkBufferSize(u32 channel) {
@@ -153,29 +164,21 @@ Result HardwareOpus::DecodeInterleaved(u32& out_sample_count, void* output_data,
                                        u64 output_data_size, u32 channel_count, void* input_data,
                                        u64 input_data_size, void* buffer, u64& out_time_taken,
                                        bool reset) {
-    std::scoped_lock l{mutex};
-    shared_memory.host_send_data[0] = (u64)buffer;
-    shared_memory.host_send_data[1] = (u64)input_data;
-    shared_memory.host_send_data[2] = input_data_size;
-    shared_memory.host_send_data[3] = (u64)output_data;
-    shared_memory.host_send_data[4] = output_data_size;
-    shared_memory.host_send_data[5] = 0;
-    shared_memory.host_send_data[6] = reset;
-
-    opus_decoder.Send(ADSP::Direction::DSP, ADSP::OpusDecoder::Message::DecodeInterleaved);
-    auto msg = opus_decoder.Receive(ADSP::Direction::Host);
-    if (msg != ADSP::OpusDecoder::Message::DecodeInterleavedOK) {
-        LOG_ERROR(Service_Audio, "OpusDecoder returned invalid message. Expected {} got {}",
-                  ADSP::OpusDecoder::Message::DecodeInterleavedOK, msg);
-        R_THROW(ResultInvalidOpusDSPReturnCode);
-    }
-
-    auto error_code{static_cast<s32>(shared_memory.dsp_return_data[0])};
-    if (error_code == OPUS_OK) {
-        out_sample_count = static_cast<u32>(shared_memory.dsp_return_data[1]);
-        out_time_taken = 1000 * shared_memory.dsp_return_data[2];
+    OpusDecodeRequest request{
+        .buffer = buffer,
+        .input_data = input_data,
+        .input_data_size = input_data_size,
+        .output_data = output_data,
+        .output_data_size = output_data_size,
+        .multi_stream = false,
+        .reset = reset,
+    };
+    DecodeInterleavedBatch({&request, 1});
+    if (R_SUCCEEDED(request.result)) {
+        out_sample_count = request.sample_count;
+        out_time_taken = request.time_taken;
     }
-    R_RETURN(ResultCodeFromLibOpusErrorCode(error_code));
+    R_RETURN(request.result);
 }
 
 Result HardwareOpus::DecodeInterleavedForMultiStream(u32& out_sample_count, void* output_data,
@@ -183,30 +186,94 @@ Result HardwareOpus::DecodeInterleavedForMultiStream(u32& out_sample_count, void
                                                      void* input_data, u64 input_data_size,
                                                      void* buffer, u64& out_time_taken,
                                                      bool reset) {
-    std::scoped_lock l{mutex};
-    shared_memory.host_send_data[0] = (u64)buffer;
-    shared_memory.host_send_data[1] = (u64)input_data;
-    shared_memory.host_send_data[2] = input_data_size;
-    shared_memory.host_send_data[3] = (u64)output_data;
-    shared_memory.host_send_data[4] = output_data_size;
-    shared_memory.host_send_data[5] = 0;
-    shared_memory.host_send_data[6] = reset;
-
-    opus_decoder.Send(ADSP::Direction::DSP,
-                      ADSP::OpusDecoder::Message::DecodeInterleavedForMultiStream);
-    auto msg = opus_decoder.Receive(ADSP::Direction::Host);
-    if (msg != ADSP::OpusDecoder::Message::DecodeInterleavedForMultiStreamOK) {
-        LOG_ERROR(Service_Audio, "OpusDecoder returned invalid message. Expected {} got {}",
-                  ADSP::OpusDecoder::Message::DecodeInterleavedForMultiStreamOK, msg);
-        R_THROW(ResultInvalidOpusDSPReturnCode);
+    OpusDecodeRequest request{
+        .buffer = buffer,
+        .input_data = input_data,
+        .input_data_size = input_data_size,
+        .output_data = output_data,
+        .output_data_size = output_data_size,
+        .multi_stream = true,
+        .reset = reset,
+    };
+    DecodeInterleavedBatch({&request, 1});
+    if (R_SUCCEEDED(request.result)) {
+        out_sample_count = request.sample_count;
+        out_time_taken = request.time_taken;
     }
+    R_RETURN(request.result);
+}
 
-    auto error_code{static_cast<s32>(shared_memory.dsp_return_data[0])};
-    if (error_code == OPUS_OK) {
-        out_sample_count = static_cast<u32>(shared_memory.dsp_return_data[1]);
-        out_time_taken = 1000 * shared_memory.dsp_return_data[2];
+void HardwareOpus::DecodeInterleavedBatch(std::span<OpusDecodeRequest> requests) {
+    constexpr size_t LaneCount{ADSP::OpusDecoder::DecodeLaneCount};
+
+    // Next request to look at for each lane, requests are submitted in rounds of one per lane
+    std::array<size_t, LaneCount> next_requests{};
+    const auto get_next_request{[&](size_t lane) -> OpusDecodeRequest* {
+        for (size_t& index = next_requests[lane]; index < requests.size(); index++) {
+            if (GetDecodeLane(requests[index].buffer) == lane) {
+                return &requests[index++];
+            }
+        }
+        return nullptr;
+    }};
+
+    while (true) {
+        std::array<OpusDecodeRequest*, LaneCount> round{};
+        std::array<std::unique_lock<std::mutex>, LaneCount> locks{};
+        bool submitted{};
+
+        // Lanes are locked in order, so concurrent batches can not deadlock
+        for (size_t lane = 0; lane < LaneCount; lane++) {
+            auto* request{get_next_request(lane)};
+            if (!request) {
+                continue;
+            }
+            round[lane] = request;
+            locks[lane] = std::unique_lock{decode_lanes[lane].mutex};
+
+            auto& send_data{decode_lanes[lane].shared_memory.host_send_data};
+            send_data[0] = (u64)request->buffer;
+            send_data[1] = (u64)request->input_data;
+            send_data[2] = request->input_data_size;
+            send_data[3] = (u64)request->output_data;
+            send_data[4] = request->output_data_size;
+            send_data[5] = 0;
+            send_data[6] = request->reset;
+            opus_decoder.SendDecode(
+                lane, ADSP::Direction::DSP,
+                request->multi_stream ? ADSP::OpusDecoder::Message::DecodeInterleavedForMultiStream
+                                      : ADSP::OpusDecoder::Message::DecodeInterleaved);
+            submitted = true;
+        }
+        if (!submitted) {
+            return;
+        }
+
+        for (size_t lane = 0; lane < LaneCount; lane++) {
+            auto* request{round[lane]};
+            if (!request) {
+                continue;
+            }
+            const auto expected{request->multi_stream
+                                    ? ADSP::OpusDecoder::Message::DecodeInterleavedForMultiStreamOK
+                                    : ADSP::OpusDecoder::Message::DecodeInterleavedOK};
+            const auto msg{opus_decoder.ReceiveDecode(lane, ADSP::Direction::Host)};
+            if (msg != expected) {
+                LOG_ERROR(Service_Audio, "OpusDecoder returned invalid message. Expected {} got {}",
+                          expected, msg);
+                request->result = ResultInvalidOpusDSPReturnCode;
+                continue;
+            }
+
+            const auto& return_data{decode_lanes[lane].shared_memory.dsp_return_data};
+            const auto error_code{static_cast<s32>(return_data[0])};
+            if (error_code == OPUS_OK) {
+                request->sample_count = static_cast<u32>(return_data[1]);
+                request->time_taken = 1000 * return_data[2];
+            }
+            request->result = ResultCodeFromLibOpusErrorCode(error_code);
+        }
     }
-    R_RETURN(ResultCodeFromLibOpusErrorCode(error_code));
 }
 
 Result HardwareOpus::MapMemory(void* buffer, u64 buffer_size) {
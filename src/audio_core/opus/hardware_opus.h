@@ -3,7 +3,9 @@
 
 #pragma once
 
+#include <array>
 #include <mutex>
+#include <span>
 #include <opus.h>
 
 #include "audio_core/adsp/apps/opus/opus_decoder.h"
@@ -12,6 +14,22 @@
 #include "core/hle/service/audio/errors.h"
 
 namespace AudioCore::OpusDecoder {
+
+/// A packet to decode with HardwareOpus::DecodeInterleavedBatch, and its results
+struct OpusDecodeRequest {
+    void* buffer;
+    void* input_data;
+    u64 input_data_size;
+    void* output_data;
+    u64 output_data_size;
+    bool multi_stream;
+    bool reset;
+
+    Result result;
+    u32 sample_count;
+    u64 time_taken;
+};
+
 class HardwareOpus {
 public:
     HardwareOpus(Core::System& system);
@@ -33,6 +51,15 @@ public:
                                            u64 output_data_size, u32 channel_count,
                                            void* input_data, u64 input_data_size, void* buffer,
                                            u64& out_time_taken, bool reset);
+
+    /**
+     * Decode several packets in one submission. Packets of different decode objects are decoded
+     * concurrently, packets of the same decode object are decoded in order.
+     *
+     * @param requests - The packets to decode, their results are written back to them.
+     */
+    void DecodeInterleavedBatch(std::span<OpusDecodeRequest> requests);
+
     Result MapMemory(void* buffer, u64 buffer_size);
     Result UnmapMemory(void* buffer, u64 buffer_size);
 
@@ -41,5 +68,12 @@ private:
     std::mutex mutex;
     ADSP::OpusDecoder::OpusDecoder& opus_decoder;
     ADSP::OpusDecoder::SharedMemory shared_memory;
+
+    /// Shared memory of a decode lane of the DSP, and the lock for submitting to it
+    struct DecodeLane {
+        std::mutex mutex;
+        ADSP::OpusDecoder::SharedMemory shared_memory;
+    };
+    std::array<DecodeLane, ADSP::OpusDecoder::DecodeLaneCount> decode_lanes;
 };
 } // namespace AudioCore::OpusDecoder
@@ -1,9 +1,24 @@
 // SPDX-FileCopyrightText: Copyright 2022 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+
 #include "audio_core/renderer/command/command_processing_time_estimator.h"
 
 namespace AudioCore::Renderer {
+namespace {
+/// ADSP cycles per nanosecond, the time limits allow 2'880'000 cycles per 5ms audio frame
+constexpr f32 AdspCyclesPerNs{2'880'000.0f / 5'000'000.0f};
+/// Weight of a command list's measurements in the moving averages
+constexpr f32 CalibrationWeight{1.0f / 32.0f};
+/// Bounds of the host to hardware time ratio, so a single stall can't disable voice dropping
+constexpr f32 MinScale{1.0f / 64.0f};
+constexpr f32 MaxScale{64.0f};
+
+f32 MovingAverage(f32 average, f32 sample) {
+    return average + (sample - average) * CalibrationWeight;
+}
+} // Anonymous namespace
 
 u32 CommandProcessingTimeEstimatorVersion1::Estimate(
     const PcmInt16DataSourceVersion1Command& command) const {
@@ -3617,4 +3632,206 @@ u32 CommandProcessingTimeEstimatorVersion5::Estimate(const CompressorCommand& co
     }
 }
 
+void CommandProcessingSamples::Add(const ICommand& command, const u64 processed_ns) {
+    const auto type{static_cast<size_t>(command.type)};
+    if (type >= CommandIdCount) {
+        return;
+    }
+    if (command.estimated_process_time > 0) {
+        estimated_processed_ns[type] += processed_ns;
+        estimated_time[type] += command.estimated_process_time;
+    } else {
+        unestimated_processed_ns[type] += processed_ns;
+        unestimated_count[type]++;
+    }
+}
+
+void CommandProcessingSamples::Merge(const CommandProcessingSamples& other, const u64 parallelism) {
+    for (size_t type = 0; type < CommandIdCount; type++) {
+        estimated_processed_ns[type] += other.estimated_processed_ns[type] / parallelism;
+        estimated_time[type] += other.estimated_time[type];
+        unestimated_processed_ns[type] += other.unestimated_processed_ns[type] / parallelism;
+        unestimated_count[type] += other.unestimated_count[type];
+    }
+}
+
+CommandProcessingTimeCalibration::CommandProcessingTimeCalibration() {
+    // Until commands are measured, estimates are the hardware ones
+    for (auto& scale : scales) {
+        scale.store(1.0f, std::memory_order_relaxed);
+    }
+    for (auto& cycle : cycles) {
+        cycle.store(0.0f, std::memory_order_relaxed);
+    }
+}
+
+CommandProcessingTimeCalibration& CommandProcessingTimeCalibration::Get() {
+    static CommandProcessingTimeCalibration calibration;
+    return calibration;
+}
+
+void CommandProcessingTimeCalibration::Update(const CommandProcessingSamples& samples) {
+    std::scoped_lock lk{update_mutex};
+    for (size_t type = 0; type < CommandIdCount; type++) {
+        if (samples.estimated_time[type] > 0) {
+            const f32 measured{static_cast<f32>(samples.estimated_processed_ns[type]) *
+                               AdspCyclesPerNs};
+            const f32 ratio{measured / static_cast<f32>(samples.estimated_time[type])};
+            const f32 average{MovingAverage(scales[type].load(std::memory_order_relaxed), ratio)};
+            scales[type].store(std::clamp(average, MinScale, MaxScale), std::memory_order_relaxed);
+        }
+        if (samples.unestimated_count[type] > 0) {
+            const f32 measured{static_cast<f32>(samples.unestimated_processed_ns[type]) *
+                               AdspCyclesPerNs /
+                               static_cast<f32>(samples.unestimated_count[type])};
+            const f32 previous{cycles[type].load(std::memory_order_relaxed)};
+            cycles[type].store(MovingAverage(previous, measured), std::memory_order_relaxed);
+        }
+    }
+}
+
+u32 CommandProcessingTimeCalibration::Scale(const CommandId type, const u32 estimate) const {
+    const auto index{static_cast<size_t>(type)};
+    if (index >= CommandIdCount) {
+        return estimate;
+    }
+    if (estimate == 0) {
+        return static_cast<u32>(cycles[index].load(std::memory_order_relaxed));
+    }
+    return static_cast<u32>(static_cast<f32>(estimate) *
+                            scales[index].load(std::memory_order_relaxed));
+}
+
+template <typename T>
+u32 CommandProcessingTimeEstimatorHost::ScaleEstimate(const T& command) const {
+    return CommandProcessingTimeCalibration::Get().Scale(command.type,
+                                                         hardware_estimator->Estimate(command));
+}
+
+u32 CommandProcessingTimeEstimatorHost::Estimate(
+    const PcmInt16DataSourceVersion1Command& command) const {
+    return ScaleEstimate(command);
+}
+
+u32 CommandProcessingTimeEstimatorHost::Estimate(
+    const PcmInt16DataSourceVersion2Command& command) const {
+    return ScaleEstimate(command);
+}
+
+u32 CommandProcessingTimeEstimatorHost::Estimate(
+    const PcmFloatDataSourceVersion1Command& command) const {
+    return ScaleEstimate(command);
+}
+
+u32 CommandProcessingTimeEstimatorHost::Estimate(
+    const PcmFloatDataSourceVersion2Command& command) const {
+    return ScaleEstimate(command);
+}
+
+u32 CommandProcessingTimeEstimatorHost::Estimate(
+    const AdpcmDataSourceVersion1Command& command) const {
+    return ScaleEstimate(command);
+}
+
+u32 CommandProcessingTimeEstimatorHost::Estimate(
+    const AdpcmDataSourceVersion2Command& command) const {
+    return ScaleEstimate(command);
+}
+
+u32 CommandProcessingTimeEstimatorHost::Estimate(const VolumeCommand& command) const {
+    return ScaleEstimate(command);
+}
+
+u32 CommandProcessingTimeEstimatorHost::Estimate(const VolumeRampCommand& command) const {
+    return ScaleEstimate(command);
+}
+
+u32 CommandProcessingTimeEstimatorHost::Estimate(const BiquadFilterCommand& command) const {
+    return ScaleEstimate(command);
+}
+
+u32 CommandProcessingTimeEstimatorHost::Estimate(const MixCommand& command) const {
+    return ScaleEstimate(command);
+}
+
+u32 CommandProcessingTimeEstimatorHost::Estimate(const MixRampCommand& command) const {
+    return ScaleEstimate(command);
+}
+
+u32 CommandProcessingTimeEstimatorHost::Estimate(const MixRampGroupedCommand& command) const {
+    return ScaleEstimate(command);
+}
+
+u32 CommandProcessingTimeEstimatorHost::Estimate(const DepopPrepareCommand& command) const {
+    return ScaleEstimate(command);
+}
+
+u32 CommandProcessingTimeEstimatorHost::Estimate(const DepopForMixBuffersCommand& command) const {
+    return ScaleEstimate(command);
+}
+
+u32 CommandProcessingTimeEstimatorHost::Estimate(const DelayCommand& command) const {
+    return ScaleEstimate(command);
+}
+
+u32 CommandProcessingTimeEstimatorHost::Estimate(const UpsampleCommand& command) const {
+    return ScaleEstimate(command);
+}
+
+u32 CommandProcessingTimeEstimatorHost::Estimate(const DownMix6chTo2chCommand& command) const {
+    return ScaleEstimate(command);
+}
+
+u32 CommandProcessingTimeEstimatorHost::Estimate(const AuxCommand& command) const {
+    return ScaleEstimate(command);
+}
+
+u32 CommandProcessingTimeEstimatorHost::Estimate(const DeviceSinkCommand& command) const {
+    return ScaleEstimate(command);
+}
+
+u32 CommandProcessingTimeEstimatorHost::Estimate(const CircularBufferSinkCommand& command) const {
+    return ScaleEstimate(command);
+}
+
+u32 CommandProcessingTimeEstimatorHost::Estimate(const ReverbCommand& command) const {
+    return ScaleEstimate(command);
+}
+
+u32 CommandProcessingTimeEstimatorHost::Estimate(const I3dl2ReverbCommand& command) const {
+    return ScaleEstimate(command);
+}
+
+u32 CommandProcessingTimeEstimatorHost::Estimate(const PerformanceCommand& command) const {
+    return ScaleEstimate(command);
+}
+
+u32 CommandProcessingTimeEstimatorHost::Estimate(const ClearMixBufferCommand& command) const {
+    return ScaleEstimate(command);
+}
+
+u32 CommandProcessingTimeEstimatorHost::Estimate(const CopyMixBufferCommand& command) const {
+    return ScaleEstimate(command);
+}
+
+u32 CommandProcessingTimeEstimatorHost::Estimate(const LightLimiterVersion1Command& command) const {
+    return ScaleEstimate(command);
+}
+
+u32 CommandProcessingTimeEstimatorHost::Estimate(const LightLimiterVersion2Command& command) const {
+    return ScaleEstimate(command);
+}
+
+u32 CommandProcessingTimeEstimatorHost::Estimate(const MultiTapBiquadFilterCommand& command) const {
+    return ScaleEstimate(command);
+}
+
+u32 CommandProcessingTimeEstimatorHost::Estimate(const CaptureCommand& command) const {
+    return ScaleEstimate(command);
+}
+
+u32 CommandProcessingTimeEstimatorHost::Estimate(const CompressorCommand& command) const {
+    return ScaleEstimate(command);
+}
+
 } // namespace AudioCore::Renderer
@@ -3,6 +3,11 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+
 #include "audio_core/renderer/command/commands.h"
 #include "common/common_types.h"
 
@@ -251,4 +256,110 @@ private:
     u32 buffer_count{};
 };
 
+constexpr size_t CommandIdCount{static_cast<size_t>(CommandId::Compressor) + 1};
+
+/**
+ * Host processing times of the commands of a command list, accumulated by command type.
+ */
+struct CommandProcessingSamples {
+    void Add(const ICommand& command, u64 processed_ns);
+
+    /**
+     * Add the times of another command list part.
+     *
+     * @param other       - Times to add.
+     * @param parallelism - Number of threads the other part ran on, its times are divided by it.
+     */
+    void Merge(const CommandProcessingSamples& other, u64 parallelism = 1);
+
+    /// Time taken by the commands with a hardware estimate, and the sum of the estimates
+    std::array<u64, CommandIdCount> estimated_processed_ns{};
+    std::array<u64, CommandIdCount> estimated_time{};
+    /// Time taken by the commands estimated to take no time, and their count
+    std::array<u64, CommandIdCount> unestimated_processed_ns{};
+    std::array<u32, CommandIdCount> unestimated_count{};
+};
+
+/**
+ * Host measured processing times of the commands, relative to their estimates. All renderer
+ * sessions run on the same host, so they share one calibration.
+ */
+class CommandProcessingTimeCalibration {
+public:
+    CommandProcessingTimeCalibration();
+
+    static CommandProcessingTimeCalibration& Get();
+
+    /**
+     * Fold the times measured for a command list into the moving averages.
+     *
+     * @param samples - Times measured while processing the command list.
+     */
+    void Update(const CommandProcessingSamples& samples);
+
+    /**
+     * Scale a hardware estimate to the host's speed.
+     *
+     * @param type     - Type of the estimated command.
+     * @param estimate - Hardware estimate of the command, in ADSP cycles.
+     * @return The host estimate of the command, in ADSP cycles.
+     */
+    u32 Scale(CommandId type, u32 estimate) const;
+
+private:
+    std::mutex update_mutex;
+    /// Moving average of the measured time over the hardware estimate, by command type
+    std::array<std::atomic<f32>, CommandIdCount> scales;
+    /// Moving average of the measured ADSP cycles, for commands estimated to take no time
+    std::array<std::atomic<f32>, CommandIdCount> cycles;
+};
+
+/**
+ * Estimator scaling the estimates of the hardware estimator in use by the host's measured
+ * processing times, so voices are dropped when the host can't keep up rather than the hardware.
+ */
+class CommandProcessingTimeEstimatorHost final : public ICommandProcessingTimeEstimator {
+public:
+    explicit CommandProcessingTimeEstimatorHost(
+        std::unique_ptr<ICommandProcessingTimeEstimator> hardware_estimator_)
+        : hardware_estimator{std::move(hardware_estimator_)} {}
+
+    u32 Estimate(const PcmInt16DataSourceVersion1Command& command) const override;
+    u32 Estimate(const PcmInt16DataSourceVersion2Command& command) const override;
+    u32 Estimate(const PcmFloatDataSourceVersion1Command& command) const override;
+    u32 Estimate(const PcmFloatDataSourceVersion2Command& command) const override;
+    u32 Estimate(const AdpcmDataSourceVersion1Command& command) const override;
+    u32 Estimate(const AdpcmDataSourceVersion2Command& command) const override;
+    u32 Estimate(const VolumeCommand& command) const override;
+    u32 Estimate(const VolumeRampCommand& command) const override;
+    u32 Estimate(const BiquadFilterCommand& command) const override;
+    u32 Estimate(const MixCommand& command) const override;
+    u32 Estimate(const MixRampCommand& command) const override;
+    u32 Estimate(const MixRampGroupedCommand& command) const override;
+    u32 Estimate(const DepopPrepareCommand& command) const override;
+    u32 Estimate(const DepopForMixBuffersCommand& command) const override;
+    u32 Estimate(const DelayCommand& command) const override;
+    u32 Estimate(const UpsampleCommand& command) const override;
+    u32 Estimate(const DownMix6chTo2chCommand& command) const override;
+    u32 Estimate(const AuxCommand& command) const override;
+    u32 Estimate(const DeviceSinkCommand& command) const override;
+    u32 Estimate(const CircularBufferSinkCommand& command) const override;
+    u32 Estimate(const ReverbCommand& command) const override;
+    u32 Estimate(const I3dl2ReverbCommand& command) const override;
+    u32 Estimate(const PerformanceCommand& command) const override;
+    u32 Estimate(const ClearMixBufferCommand& command) const override;
+    u32 Estimate(const CopyMixBufferCommand& command) const override;
+    u32 Estimate(const LightLimiterVersion1Command& command) const override;
+    u32 Estimate(const LightLimiterVersion2Command& command) const override;
+    u32 Estimate(const MultiTapBiquadFilterCommand& command) const override;
+    u32 Estimate(const CaptureCommand& command) const override;
+    u32 Estimate(const CompressorCommand& command) const override;
+
+private:
+    template <typename T>
+    u32 ScaleEstimate(const T& command) const;
+
+    std::unique_ptr<ICommandProcessingTimeEstimator> hardware_estimator;
+};
+
 } // namespace AudioCore::Renderer
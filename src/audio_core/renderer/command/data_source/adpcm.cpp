@@ -44,7 +44,7 @@ void AdpcmDataSourceVersion1Command::Process(const AudioRenderer::CommandListPro
         .IsVoicePitchAndSrcSkippedSupported{(flags & 2) != 0},
     };
 
-    DecodeFromWaveBuffers(*processor.memory, args);
+    DecodeFromWaveBuffers(*processor.memory, args, processor.adpcm_cache);
 }
 
 bool AdpcmDataSourceVersion1Command::Verify(const AudioRenderer::CommandListProcessor& processor) {
@@ -80,7 +80,7 @@ void AdpcmDataSourceVersion2Command::Process(const AudioRenderer::CommandListPro
         .IsVoicePitchAndSrcSkippedSupported{(flags & 2) != 0},
     };
 
-    DecodeFromWaveBuffers(*processor.memory, args);
+    DecodeFromWaveBuffers(*processor.memory, args, processor.adpcm_cache);
 }
 
 bool AdpcmDataSourceVersion2Command::Verify(const AudioRenderer::CommandListProcessor& processor) {
@@ -1,12 +1,16 @@
 // SPDX-FileCopyrightText: Copyright 2022 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include <array>
+#include <type_traits>
 #include <vector>
 
 #include "audio_core/renderer/command/data_source/decode.h"
 #include "audio_core/renderer/command/resample/resample.h"
+#include "common/div_ceil.h"
 #include "common/fixed_point.h"
+#include "common/hash.h"
 #include "common/logging/log.h"
 #include "common/scratch_buffer.h"
 #include "core/guest_memory.h"
@@ -16,6 +20,13 @@ namespace AudioCore::Renderer {
 
 constexpr u32 TempBufferSize = 0x3F00;
 constexpr std::array<u8, 3> PitchBySrcQuality = {4, 8, 4};
+constexpr u32 AdpcmSamplesPerFrame = 14;
+constexpr u32 AdpcmFrameSize = 8;
+
+static bool IsSameContext(const VoiceState::AdpcmContext& lhs,
+                          const VoiceState::AdpcmContext& rhs) {
+    return lhs.header == rhs.header && lhs.yn0 == rhs.yn0 && lhs.yn1 == rhs.yn1;
+}
 
 /**
  * Decode PCM data. Only s16 or f32 is supported.
@@ -220,14 +231,136 @@ static u32 DecodeAdpcm(Core::Memory::Memory& memory, std::span<s16> out_buffer,
     return samples_to_process;
 }
 
+AdpcmDecodeCache::AdpcmDecodeCache() = default;
+
+AdpcmDecodeCache::~AdpcmDecodeCache() = default;
+
+size_t AdpcmDecodeCache::KeyHash::operator()(const Key& key) const noexcept {
+    static_assert(std::has_unique_object_representations_v<Key>, "Key is hashed as bytes");
+    return static_cast<size_t>(Common::HashBytes(&key, sizeof(key)));
+}
+
+VoiceState::AdpcmContext AdpcmDecodeCache::Entry::ContextAt(u32 start_offset,
+                                                            u32 sample_index) const {
+    if (sample_index == 0) {
+        return initial_context;
+    }
+    // A play starting within a frame uses the context's header until the next frame
+    const u32 position{start_offset + sample_index - 1};
+    const u32 first_frame{start_offset / AdpcmSamplesPerFrame};
+    const u32 frame{position / AdpcmSamplesPerFrame};
+    const bool is_initial_header{frame == first_frame && start_offset % AdpcmSamplesPerFrame != 0};
+    return VoiceState::AdpcmContext{
+        .header = is_initial_header ? initial_context.header : u16{headers[frame - first_frame]},
+        .yn0 = samples[sample_index - 1],
+        .yn1 = sample_index >= 2 ? samples[sample_index - 2] : initial_context.yn0,
+    };
+}
+
+std::shared_ptr<const AdpcmDecodeCache::Entry> AdpcmDecodeCache::Find(const Key& key) {
+    std::scoped_lock lk{mutex};
+    const auto it{slots.find(key)};
+    if (it == slots.end()) {
+        return nullptr;
+    }
+    it->second.last_use = ++use_tick;
+    return it->second.entry;
+}
+
+void AdpcmDecodeCache::Insert(const Key& key, std::shared_ptr<const Entry> entry) {
+    std::scoped_lock lk{mutex};
+    const auto [it, is_new]{slots.try_emplace(key)};
+    if (!is_new) {
+        cached_samples -= it->second.entry->samples.size();
+    }
+    cached_samples += entry->samples.size();
+    it->second = Slot{std::move(entry), ++use_tick};
+
+    while (cached_samples > MaxCachedSamples) {
+        const auto oldest{std::ranges::min_element(
+            slots, [](const auto& lhs, const auto& rhs) { return lhs.last_use < rhs.last_use; },
+            [](const auto& pair) -> const Slot& { return pair.second; })};
+        cached_samples -= oldest->second.entry->samples.size();
+        slots.erase(oldest);
+    }
+}
+
+std::optional<u32> AdpcmDecodeCache::Decode(Core::Memory::Memory& memory,
+                                            std::span<s16> out_buffer, const DecodeArg& req) {
+    if (req.buffer == 0 || req.buffer_size == 0 || req.end_offset <= req.start_offset) {
+        return std::nullopt;
+    }
+    const u32 sample_count{req.end_offset - req.start_offset};
+    if (sample_count > MaxEntrySamples || req.offset >= sample_count) {
+        return std::nullopt;
+    }
+
+    const Key key{
+        .memory = &memory,
+        .buffer = req.buffer,
+        .buffer_size = req.buffer_size,
+        .start_offset = req.start_offset,
+        .end_offset = req.end_offset,
+        .coefficients_hash = Common::HashBytes(req.coefficients.data(), sizeof(req.coefficients)),
+    };
+    std::shared_ptr<const Entry> entry{Find(key)};
+    auto& context{*req.adpcm_context};
+
+    if (req.offset == 0) {
+        // A play starts, make sure the data wasn't written since it was decoded
+        const u64 data_begin{(req.start_offset / AdpcmSamplesPerFrame) * AdpcmFrameSize};
+        const u64 data_end{std::min<u64>(
+            Common::DivCeil(req.end_offset, AdpcmSamplesPerFrame) * AdpcmFrameSize,
+            req.buffer_size)};
+        if (data_begin >= data_end) {
+            return std::nullopt;
+        }
+        Core::Memory::CpuGuestMemory<u8, Core::Memory::GuestMemoryFlags::UnsafeRead> data(
+            memory, req.buffer + data_begin, data_end - data_begin);
+        const u64 data_hash{Common::HashBytes(data.data(), data.size())};
+
+        if (!entry || entry->data_hash != data_hash ||
+            !IsSameContext(entry->initial_context, context)) {
+            auto new_entry{std::make_shared<Entry>()};
+            new_entry->data_hash = data_hash;
+            new_entry->initial_context = context;
+            new_entry->samples.resize(sample_count);
+
+            auto decode_context{context};
+            DecodeArg whole_arg{req};
+            whole_arg.adpcm_context = &decode_context;
+            whole_arg.samples_to_read = sample_count;
+            if (DecodeAdpcm(memory, new_entry->samples, whole_arg) != sample_count) {
+                return std::nullopt;
+            }
+            for (size_t offset = 0; offset < data.size(); offset += AdpcmFrameSize) {
+                new_entry->headers.push_back(data[offset]);
+            }
+            entry = std::move(new_entry);
+            Insert(key, entry);
+        }
+    } else if (!entry || !IsSameContext(entry->ContextAt(req.start_offset, req.offset), context)) {
+        // The voice isn't playing the cached samples, it started before they were cached or
+        // with another context
+        return std::nullopt;
+    }
+
+    const u32 samples_to_copy{std::min(sample_count - req.offset, req.samples_to_read)};
+    std::copy_n(entry->samples.begin() + req.offset, samples_to_copy, out_buffer.begin());
+    context = entry->ContextAt(req.start_offset, req.offset + samples_to_copy);
+    return samples_to_copy;
+}
+
 /**
  * Decode implementation.
  * Decode wavebuffers according to the given args.
  *
- * @param memory - Core memory to read data from.
- * @param args   - The wavebuffer data, and information for how to decode it.
+ * @param memory      - Core memory to read data from.
+ * @param args        - The wavebuffer data, and information for how to decode it.
+ * @param adpcm_cache - Cache of decoded ADPCM wavebuffers, or nullptr to always decode.
  */
-void DecodeFromWaveBuffers(Core::Memory::Memory& memory, const DecodeFromWaveBuffersArgs& args) {
+void DecodeFromWaveBuffers(Core::Memory::Memory& memory, const DecodeFromWaveBuffersArgs& args,
+                           AdpcmDecodeCache* adpcm_cache) {
     static constexpr auto EndWaveBuffer = [](auto& voice_state, auto& wavebuffer, auto& index,
                                              auto& played_samples, auto& consumed) -> void {
         voice_state.wave_buffer_valid[index] = false;
@@ -348,9 +481,13 @@ void DecodeFromWaveBuffers(Core::Memory::Memory& memory, const DecodeFromWaveBuf
             case SampleFormat::Adpcm: {
                 decode_arg.adpcm_context = &voice_state.adpcm_context;
                 memory.ReadBlockUnsafe(args.data_address, &decode_arg.coefficients, args.data_size);
-                samples_decoded = DecodeAdpcm(
-                    memory, {&temp_buffer[temp_buffer_pos], TempBufferSize - temp_buffer_pos},
-                    decode_arg);
+                const std::span<s16> decode_buffer{&temp_buffer[temp_buffer_pos],
+                                                   TempBufferSize - temp_buffer_pos};
+                const auto cached_samples{
+                    adpcm_cache ? adpcm_cache->Decode(memory, decode_buffer, decode_arg)
+                                : std::nullopt};
+                samples_decoded = cached_samples ? *cached_samples
+                                                 : DecodeAdpcm(memory, decode_buffer, decode_arg);
             } break;
 
             default:
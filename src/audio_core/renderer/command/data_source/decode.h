@@ -4,7 +4,12 @@
 #pragma once
 
 #include <array>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <span>
+#include <unordered_map>
+#include <vector>
 
 #include "audio_core/common/common.h"
 #include "audio_core/common/wave_buffer.h"
@@ -48,12 +53,87 @@ struct DecodeArg {
     u32 samples_to_read;
 };
 
+/**
+ * Keeps the samples of recently played ADPCM wavebuffers decoded. Short sounds are replayed from
+ * the same wavebuffers many times, each play then copies the samples instead of decoding them.
+ *
+ * Guest writes aren't tracked. A wavebuffer's data is hashed each time it starts playing, and the
+ * chunks played after that are served only while the voice's decoding context matches the cached
+ * samples, which makes them identical to what decoding would produce.
+ *
+ * Thread-safe, as voices are processed in parallel.
+ */
+class AdpcmDecodeCache {
+public:
+    /// Wavebuffers longer than this are decoded as they play
+    static constexpr u32 MaxEntrySamples = 0x10000;
+    /// Total number of samples kept decoded
+    static constexpr size_t MaxCachedSamples = 0x800000;
+
+    AdpcmDecodeCache();
+    ~AdpcmDecodeCache();
+
+    /**
+     * Copy the samples of a wavebuffer, decoding all of it when its play starts and it's missing.
+     *
+     * @param memory     - Core memory to read data from.
+     * @param out_buffer - Output buffer to receive the samples.
+     * @param req        - Information for how to decode.
+     * @return Number of samples copied, or nothing if the wavebuffer has to be decoded instead.
+     */
+    std::optional<u32> Decode(Core::Memory::Memory& memory, std::span<s16> out_buffer,
+                              const DecodeArg& req);
+
+private:
+    struct Key {
+        Core::Memory::Memory* memory;
+        CpuAddr buffer;
+        u64 buffer_size;
+        u32 start_offset;
+        u32 end_offset;
+        u64 coefficients_hash;
+
+        bool operator==(const Key&) const = default;
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const noexcept;
+    };
+
+    struct Entry {
+        u64 data_hash;
+        VoiceState::AdpcmContext initial_context;
+        /// Header of each frame the samples span
+        std::vector<u8> headers;
+        std::vector<s16> samples;
+
+        /// Returns the decoding context after the given number of samples
+        VoiceState::AdpcmContext ContextAt(u32 start_offset, u32 sample_index) const;
+    };
+
+    struct Slot {
+        std::shared_ptr<const Entry> entry;
+        u64 last_use;
+    };
+
+    std::shared_ptr<const Entry> Find(const Key& key);
+
+    void Insert(const Key& key, std::shared_ptr<const Entry> entry);
+
+    std::mutex mutex;
+    std::unordered_map<Key, Slot, KeyHash> slots;
+    size_t cached_samples{};
+    u64 use_tick{};
+};
+
 /**
  * Decode wavebuffers according to the given args.
  *
- * @param memory - Core memory to read data from.
- * @param args - The wavebuffer data, and information for how to decode it.
+ * @param memory      - Core memory to read data from.
+ * @param args        - The wavebuffer data, and information for how to decode it.
+ * @param adpcm_cache - Cache of decoded ADPCM wavebuffers, or nullptr to always decode.
  */
-void DecodeFromWaveBuffers(Core::Memory::Memory& memory, const DecodeFromWaveBuffersArgs& args);
+void DecodeFromWaveBuffers(Core::Memory::Memory& memory, const DecodeFromWaveBuffersArgs& args,
+                           AdpcmDecodeCache* adpcm_cache = nullptr);
 
 } // namespace AudioCore::Renderer
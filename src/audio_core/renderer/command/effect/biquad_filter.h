@@ -5,6 +5,7 @@
 
 #include <string>
 
+#include "audio_core/renderer/command/effect/biquad_filter_kernels.h"
 #include "audio_core/renderer/command/icommand.h"
 #include "audio_core/renderer/voice/voice_info.h"
 #include "audio_core/renderer/voice/voice_state.h"
@@ -44,6 +45,14 @@ struct BiquadFilterCommand : ICommand {
      */
     bool Verify(const AudioRenderer::CommandListProcessor& processor) override;
 
+    /**
+     * Reset the state if needed, and get the channel this command filters.
+     *
+     * @param processor - The CommandListProcessor processing this command.
+     * @return The channel to filter, with the kernel matching use_float_processing.
+     */
+    BiquadFilterChannel Prepare(const AudioRenderer::CommandListProcessor& processor);
+
     /// Input mix buffer index
     s16 input;
     /// Output mix buffer index
@@ -58,18 +67,4 @@ struct BiquadFilterCommand : ICommand {
     bool use_float_processing;
 };
 
-/**
- * Biquad filter float implementation.
- *
- * @param output       - Output container for filtered samples.
- * @param input        - Input container for samples to be filtered.
- * @param b            - Feedforward coefficients.
- * @param a            - Feedback coefficients.
- * @param state        - State to track previous samples.
- * @param sample_count - Number of samples to process.
- */
-void ApplyBiquadFilterFloat(std::span<s32> output, std::span<const s32> input,
-                            std::array<s16, 3>& b, std::array<s16, 2>& a,
-                            VoiceState::BiquadFilterState& state, const u32 sample_count);
-
 } // namespace AudioCore::Renderer
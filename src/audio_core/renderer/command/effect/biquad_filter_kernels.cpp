@@ -0,0 +1,356 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+
+#include "audio_core/renderer/command/effect/biquad_filter_kernels.h"
+#include "common/bit_cast.h"
+#include "common/fixed_point.h"
+
+#if defined(ARCHITECTURE_x86_64)
+#include <immintrin.h>
+#include "common/x64/cpu_detect.h"
+#endif
+
+#if defined(ARCHITECTURE_x86_64) && (defined(__GNUC__) || defined(__clang__))
+#define TARGET_SSE41 __attribute__((target("sse4.1")))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TARGET_SSE41
+#define TARGET_AVX2
+#endif
+
+namespace AudioCore::Renderer {
+namespace {
+static_assert(MaxBiquadFilters == 2, "The vector kernels are instantiated for 1 or 2 filters");
+
+constexpr s64 MinSample{std::numeric_limits<s32>::min()};
+constexpr s64 MaxSample{std::numeric_limits<s32>::max()};
+
+/**
+ * Coefficients and states of a group of channels' filters, one lane per channel.
+ * Float filters hold doubles, and fixed point filters the raw values.
+ */
+template <typename T, size_t Lanes>
+struct FilterLanes {
+    /// b0, b1, b2, a0 and a1 of each filter
+    T coefficients[MaxBiquadFilters][5][Lanes];
+    /// s0, s1, s2 and s3 of each filter
+    T states[MaxBiquadFilters][4][Lanes];
+};
+
+template <typename T, size_t Lanes>
+FilterLanes<T, Lanes> LoadLanes(const BiquadFilterChannel* channels, u32 filter_count) {
+    FilterLanes<T, Lanes> lanes{};
+    for (size_t lane = 0; lane < Lanes; lane++) {
+        for (u32 filter = 0; filter < filter_count; filter++) {
+            const auto& biquad{*channels[lane].biquads[filter]};
+            const auto& state{*channels[lane].states[filter]};
+            const s16 coefficients[5]{biquad.b[0], biquad.b[1], biquad.b[2], biquad.a[0],
+                                      biquad.a[1]};
+            const s64 states[4]{state.s0, state.s1, state.s2, state.s3};
+            for (size_t i = 0; i < 5; i++) {
+                if constexpr (std::is_same_v<T, f64>) {
+                    lanes.coefficients[filter][i][lane] =
+                        Common::FixedPoint<50, 14>::from_base(coefficients[i]).to_double();
+                } else {
+                    lanes.coefficients[filter][i][lane] = coefficients[i];
+                }
+            }
+            for (size_t i = 0; i < 4; i++) {
+                if constexpr (std::is_same_v<T, f64>) {
+                    lanes.states[filter][i][lane] = Common::BitCast<f64>(states[i]);
+                } else {
+                    lanes.states[filter][i][lane] = states[i];
+                }
+            }
+        }
+    }
+    return lanes;
+}
+
+template <typename T, size_t Lanes>
+void StoreLanes(const FilterLanes<T, Lanes>& lanes, const BiquadFilterChannel* channels,
+                u32 filter_count) {
+    for (size_t lane = 0; lane < Lanes; lane++) {
+        for (u32 filter = 0; filter < filter_count; filter++) {
+            s64 states[4];
+            for (size_t i = 0; i < 4; i++) {
+                if constexpr (std::is_same_v<T, f64>) {
+                    states[i] = Common::BitCast<s64>(lanes.states[filter][i][lane]);
+                } else {
+                    states[i] = lanes.states[filter][i][lane];
+                }
+            }
+            *channels[lane].states[filter] = {states[0], states[1], states[2], states[3]};
+        }
+    }
+}
+
+template <typename T>
+void FilterScalar(const BiquadFilterChannel& channel, u32 filter_count, u32 sample_count) {
+    constexpr f64 min{MinSample};
+    constexpr f64 max{MaxSample};
+    auto lanes{LoadLanes<T, 1>(&channel, filter_count)};
+
+    for (u32 i = 0; i < sample_count; i++) {
+        s64 out_sample{channel.input[i]};
+        for (u32 filter = 0; filter < filter_count; filter++) {
+            const auto& c{lanes.coefficients[filter]};
+            auto& s{lanes.states[filter]};
+            if constexpr (std::is_same_v<T, f64>) {
+                const auto in_sample{static_cast<f64>(out_sample)};
+                const f64 sample{in_sample * c[0][0] + s[0][0] * c[1][0] + s[1][0] * c[2][0] +
+                                 s[2][0] * c[3][0] + s[3][0] * c[4][0]};
+                out_sample = static_cast<s32>(std::clamp(sample, min, max));
+
+                s[1][0] = s[0][0];
+                s[0][0] = in_sample;
+                s[3][0] = s[2][0];
+                s[2][0] = sample;
+            } else {
+                const s64 in_sample{out_sample};
+                const s64 sample{in_sample * c[0][0] + s[0][0]};
+                out_sample = std::clamp<s64>((sample + (1 << 13)) >> 14, MinSample, MaxSample);
+
+                s[0][0] = s[1][0] + c[1][0] * in_sample + c[3][0] * out_sample;
+                s[1][0] = c[2][0] * in_sample + c[4][0] * out_sample;
+            }
+        }
+        channel.output[i] = static_cast<s32>(out_sample);
+    }
+
+    StoreLanes(lanes, &channel, filter_count);
+}
+
+#if defined(ARCHITECTURE_x86_64)
+template <u32 FilterCount>
+TARGET_SSE41 void FilterFloatSse41(const BiquadFilterChannel* channels, u32 sample_count) {
+    const __m128d min{_mm_set1_pd(static_cast<f64>(MinSample))};
+    const __m128d max{_mm_set1_pd(static_cast<f64>(MaxSample))};
+    auto lanes{LoadLanes<f64, 2>(channels, FilterCount)};
+    __m128d c[FilterCount][5];
+    __m128d s[FilterCount][4];
+    for (u32 filter = 0; filter < FilterCount; filter++) {
+        for (size_t i = 0; i < 5; i++) {
+            c[filter][i] = _mm_loadu_pd(lanes.coefficients[filter][i]);
+        }
+        for (size_t i = 0; i < 4; i++) {
+            s[filter][i] = _mm_loadu_pd(lanes.states[filter][i]);
+        }
+    }
+    const s32* const inputs[2]{channels[0].input.data(), channels[1].input.data()};
+    s32* const outputs[2]{channels[0].output.data(), channels[1].output.data()};
+
+    for (u32 i = 0; i < sample_count; i++) {
+        __m128d in_sample{_mm_cvtepi32_pd(_mm_setr_epi32(inputs[0][i], inputs[1][i], 0, 0))};
+        for (u32 filter = 0; filter < FilterCount; filter++) {
+            // Summed in the same order as the scalar filter, so the results are identical
+            __m128d sample{_mm_mul_pd(in_sample, c[filter][0])};
+            sample = _mm_add_pd(sample, _mm_mul_pd(s[filter][0], c[filter][1]));
+            sample = _mm_add_pd(sample, _mm_mul_pd(s[filter][1], c[filter][2]));
+            sample = _mm_add_pd(sample, _mm_mul_pd(s[filter][2], c[filter][3]));
+            sample = _mm_add_pd(sample, _mm_mul_pd(s[filter][3], c[filter][4]));
+
+            s[filter][1] = s[filter][0];
+            s[filter][0] = in_sample;
+            s[filter][3] = s[filter][2];
+            s[filter][2] = sample;
+            in_sample = _mm_round_pd(_mm_min_pd(_mm_max_pd(sample, min), max),
+                                     _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+        }
+        const __m128i out_samples{_mm_cvtpd_epi32(in_sample)};
+        outputs[0][i] = _mm_cvtsi128_si32(out_samples);
+        outputs[1][i] = _mm_extract_epi32(out_samples, 1);
+    }
+
+    for (u32 filter = 0; filter < FilterCount; filter++) {
+        for (size_t i = 0; i < 4; i++) {
+            _mm_storeu_pd(lanes.states[filter][i], s[filter][i]);
+        }
+    }
+    StoreLanes(lanes, channels, FilterCount);
+}
+
+template <u32 FilterCount>
+TARGET_AVX2 void FilterFloatAvx2(const BiquadFilterChannel* channels, u32 sample_count) {
+    const __m256d min{_mm256_set1_pd(static_cast<f64>(MinSample))};
+    const __m256d max{_mm256_set1_pd(static_cast<f64>(MaxSample))};
+    auto lanes{LoadLanes<f64, 4>(channels, FilterCount)};
+    __m256d c[FilterCount][5];
+    __m256d s[FilterCount][4];
+    for (u32 filter = 0; filter < FilterCount; filter++) {
+        for (size_t i = 0; i < 5; i++) {
+            c[filter][i] = _mm256_loadu_pd(lanes.coefficients[filter][i]);
+        }
+        for (size_t i = 0; i < 4; i++) {
+            s[filter][i] = _mm256_loadu_pd(lanes.states[filter][i]);
+        }
+    }
+    const s32* const inputs[4]{channels[0].input.data(), channels[1].input.data(),
+                               channels[2].input.data(), channels[3].input.data()};
+    s32* const outputs[4]{channels[0].output.data(), channels[1].output.data(),
+                          channels[2].output.data(), channels[3].output.data()};
+
+    for (u32 i = 0; i < sample_count; i++) {
+        __m256d in_sample{_mm256_cvtepi32_pd(
+            _mm_setr_epi32(inputs[0][i], inputs[1][i], inputs[2][i], inputs[3][i]))};
+        for (u32 filter = 0; filter < FilterCount; filter++) {
+            // Summed in the same order as the scalar filter, so the results are identical
+            __m256d sample{_mm256_mul_pd(in_sample, c[filter][0])};
+            sample = _mm256_add_pd(sample, _mm256_mul_pd(s[filter][0], c[filter][1]));
+            sample = _mm256_add_pd(sample, _mm256_mul_pd(s[filter][1], c[filter][2]));
+            sample = _mm256_add_pd(sample, _mm256_mul_pd(s[filter][2], c[filter][3]));
+            sample = _mm256_add_pd(sample, _mm256_mul_pd(s[filter][3], c[filter][4]));
+
+            s[filter][1] = s[filter][0];
+            s[filter][0] = in_sample;
+            s[filter][3] = s[filter][2];
+            s[filter][2] = sample;
+            in_sample = _mm256_round_pd(_mm256_min_pd(_mm256_max_pd(sample, min), max),
+                                        _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+        }
+        const __m128i out_samples{_mm256_cvtpd_epi32(in_sample)};
+        outputs[0][i] = _mm_cvtsi128_si32(out_samples);
+        outputs[1][i] = _mm_extract_epi32(out_samples, 1);
+        outputs[2][i] = _mm_extract_epi32(out_samples, 2);
+        outputs[3][i] = _mm_extract_epi32(out_samples, 3);
+    }
+
+    for (u32 filter = 0; filter < FilterCount; filter++) {
+        for (size_t i = 0; i < 4; i++) {
+            _mm256_storeu_pd(lanes.states[filter][i], s[filter][i]);
+        }
+    }
+    StoreLanes(lanes, channels, FilterCount);
+}
+
+/// Arithmetic right shift of 64-bit lanes, which AVX2 lacks.
+template <int Shift>
+TARGET_AVX2 __m256i ShiftRightLanes(__m256i value) {
+    const __m256i sign{_mm256_cmpgt_epi64(_mm256_setzero_si256(), value)};
+    return _mm256_or_si256(_mm256_srli_epi64(value, Shift), _mm256_slli_epi64(sign, 64 - Shift));
+}
+
+template <u32 FilterCount>
+TARGET_AVX2 void FilterIntAvx2(const BiquadFilterChannel* channels, u32 sample_count) {
+    const __m256i min{_mm256_set1_epi64x(MinSample)};
+    const __m256i max{_mm256_set1_epi64x(MaxSample)};
+    const __m256i rounding{_mm256_set1_epi64x(1 << 13)};
+    const __m256i low_halves{_mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6)};
+    auto lanes{LoadLanes<s64, 4>(channels, FilterCount)};
+    // The coefficients are 16-bit and the samples 32-bit, so their products fit the 32-bit
+    // multiplies of the low half of each lane.
+    __m256i c[FilterCount][5];
+    __m256i s[FilterCount][2];
+    for (u32 filter = 0; filter < FilterCount; filter++) {
+        for (size_t i = 0; i < 5; i++) {
+            c[filter][i] =
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lanes.coefficients[filter][i]));
+        }
+        for (size_t i = 0; i < 2; i++) {
+            s[filter][i] =
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lanes.states[filter][i]));
+        }
+    }
+    const s32* const inputs[4]{channels[0].input.data(), channels[1].input.data(),
+                               channels[2].input.data(), channels[3].input.data()};
+    s32* const outputs[4]{channels[0].output.data(), channels[1].output.data(),
+                          channels[2].output.data(), channels[3].output.data()};
+
+    for (u32 i = 0; i < sample_count; i++) {
+        __m256i out_sample{_mm256_cvtepi32_epi64(
+            _mm_setr_epi32(inputs[0][i], inputs[1][i], inputs[2][i], inputs[3][i]))};
+        for (u32 filter = 0; filter < FilterCount; filter++) {
+            const __m256i in_sample{out_sample};
+            const __m256i sample{
+                _mm256_add_epi64(_mm256_mul_epi32(in_sample, c[filter][0]), s[filter][0])};
+            out_sample = ShiftRightLanes<14>(_mm256_add_epi64(sample, rounding));
+            out_sample = _mm256_blendv_epi8(out_sample, max, _mm256_cmpgt_epi64(out_sample, max));
+            out_sample = _mm256_blendv_epi8(out_sample, min, _mm256_cmpgt_epi64(min, out_sample));
+
+            s[filter][0] = _mm256_add_epi64(
+                s[filter][1], _mm256_add_epi64(_mm256_mul_epi32(c[filter][1], in_sample),
+                                               _mm256_mul_epi32(c[filter][3], out_sample)));
+            s[filter][1] = _mm256_add_epi64(_mm256_mul_epi32(c[filter][2], in_sample),
+                                            _mm256_mul_epi32(c[filter][4], out_sample));
+        }
+        const __m128i out_samples{
+            _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(out_sample, low_halves))};
+        outputs[0][i] = _mm_cvtsi128_si32(out_samples);
+        outputs[1][i] = _mm_extract_epi32(out_samples, 1);
+        outputs[2][i] = _mm_extract_epi32(out_samples, 2);
+        outputs[3][i] = _mm_extract_epi32(out_samples, 3);
+    }
+
+    for (u32 filter = 0; filter < FilterCount; filter++) {
+        for (size_t i = 0; i < 2; i++) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes.states[filter][i]),
+                                s[filter][i]);
+        }
+    }
+    StoreLanes(lanes, channels, FilterCount);
+}
+#endif
+} // Anonymous namespace
+
+void ApplyBiquadFiltersFloat(std::span<const BiquadFilterChannel> channels, u32 filter_count,
+                             u32 sample_count) {
+    filter_count = std::min(filter_count, MaxBiquadFilters);
+    if (filter_count == 0) {
+        return;
+    }
+    size_t channel{};
+#if defined(ARCHITECTURE_x86_64)
+    const auto& caps{Common::GetCPUCaps()};
+    if (caps.avx2) {
+        for (; channel + 4 <= channels.size(); channel += 4) {
+            if (filter_count == 1) {
+                FilterFloatAvx2<1>(&channels[channel], sample_count);
+            } else {
+                FilterFloatAvx2<2>(&channels[channel], sample_count);
+            }
+        }
+    }
+    if (caps.sse4_1) {
+        for (; channel + 2 <= channels.size(); channel += 2) {
+            if (filter_count == 1) {
+                FilterFloatSse41<1>(&channels[channel], sample_count);
+            } else {
+                FilterFloatSse41<2>(&channels[channel], sample_count);
+            }
+        }
+    }
+#endif
+    for (; channel < channels.size(); channel++) {
+        FilterScalar<f64>(channels[channel], filter_count, sample_count);
+    }
+}
+
+void ApplyBiquadFiltersInt(std::span<const BiquadFilterChannel> channels, u32 filter_count,
+                           u32 sample_count) {
+    filter_count = std::min(filter_count, MaxBiquadFilters);
+    if (filter_count == 0) {
+        return;
+    }
+    size_t channel{};
+#if defined(ARCHITECTURE_x86_64)
+    // SSE4.1 has no 64-bit compares for the clamping, so the fixed point filters need AVX2
+    if (Common::GetCPUCaps().avx2) {
+        for (; channel + 4 <= channels.size(); channel += 4) {
+            if (filter_count == 1) {
+                FilterIntAvx2<1>(&channels[channel], sample_count);
+            } else {
+                FilterIntAvx2<2>(&channels[channel], sample_count);
+            }
+        }
+    }
+#endif
+    for (; channel < channels.size(); channel++) {
+        FilterScalar<s64>(channels[channel], filter_count, sample_count);
+    }
+}
+
+} // namespace AudioCore::Renderer
@@ -0,0 +1,56 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <span>
+
+#include "audio_core/common/common.h"
+#include "audio_core/renderer/voice/voice_info.h"
+#include "audio_core/renderer/voice/voice_state.h"
+#include "common/common_types.h"
+
+namespace AudioCore::Renderer {
+
+/**
+ * A channel filtered by the biquad filter kernels, through a cascade of biquad filters.
+ */
+struct BiquadFilterChannel {
+    /// Output samples, may be the input samples
+    std::span<s32> output;
+    /// Input samples
+    std::span<const s32> input;
+    /// Parameters of each filter, in the order they are applied
+    std::array<const VoiceInfo::BiquadFilterParameter*, MaxBiquadFilters> biquads{};
+    /// State of each filter, updated each call
+    std::array<VoiceState::BiquadFilterState*, MaxBiquadFilters> states{};
+};
+
+/**
+ * Apply cascaded biquad filters to channels with float processing.
+ * Each filter's clamped output is fed to the next filter sample by sample, and channels are
+ * filtered in parallel across vector lanes when the host supports them. Results match filtering
+ * each channel on its own, one filter after the other.
+ *
+ * @param channels     - Channels to filter, their buffers must not overlap another channel's.
+ * @param filter_count - Number of filters applied to every channel, at most MaxBiquadFilters.
+ * @param sample_count - Number of samples to process.
+ */
+void ApplyBiquadFiltersFloat(std::span<const BiquadFilterChannel> channels, u32 filter_count,
+                             u32 sample_count);
+
+/**
+ * Apply cascaded biquad filters to channels with fixed point processing.
+ * Each filter's clamped output is fed to the next filter sample by sample, and channels are
+ * filtered in parallel across vector lanes when the host supports them. Results match filtering
+ * each channel on its own, one filter after the other.
+ *
+ * @param channels     - Channels to filter, their buffers must not overlap another channel's.
+ * @param filter_count - Number of filters applied to every channel, at most MaxBiquadFilters.
+ * @param sample_count - Number of samples to process.
+ */
+void ApplyBiquadFiltersInt(std::span<const BiquadFilterChannel> channels, u32 filter_count,
+                           u32 sample_count);
+
+} // namespace AudioCore::Renderer
@@ -1,14 +1,19 @@
 // SPDX-FileCopyrightText: Copyright 2022 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include <numbers>
 
 #include "audio_core/adsp/apps/audio_renderer/command_list_processor.h"
 #include "audio_core/renderer/command/effect/i3dl2_reverb.h"
+#include "audio_core/renderer/command/effect/reverb_kernels.h"
 #include "common/polyfill_ranges.h"
 
 namespace AudioCore::Renderer {
 
+/// Samples processed together, each early delay line tap is read for all of them at once
+constexpr u32 I3dl2BlockSize{48};
+
 constexpr std::array<f32, I3dl2ReverbInfo::MaxDelayLines> MinDelayLineTimes{
     5.0f,
     6.0f,
@@ -268,87 +273,113 @@ static void ApplyI3dl2ReverbEffect(I3dl2ReverbInfo::State& state,
         tap_indexes = OutTapIndexes6Ch;
     }
 
-    for (u32 sample_index = 0; sample_index < sample_count; sample_index++) {
-        Common::FixedPoint<50, 14> early_to_late_tap{
-            state.early_delay_line.TapOut(state.early_to_late_taps)};
-        std::array<Common::FixedPoint<50, 14>, NumChannels> output_samples{};
+    for (u32 block_start = 0; block_start < sample_count; block_start += I3dl2BlockSize) {
+        const u32 block_size{std::min(I3dl2BlockSize, sample_count - block_start)};
 
-        for (u32 early_tap = 0; early_tap < I3dl2ReverbInfo::MaxDelayTaps; early_tap++) {
-            output_samples[tap_indexes[early_tap]] +=
-                state.early_delay_line.TapOut(state.early_tap_steps[early_tap]) *
-                EarlyGains[early_tap];
-            if constexpr (NumChannels == 6) {
-                output_samples[static_cast<u32>(Channels::LFE)] +=
-                    state.early_delay_line.TapOut(state.early_tap_steps[early_tap]) *
-                    EarlyGains[early_tap];
+        std::array<Common::FixedPoint<50, 14>, I3dl2BlockSize> input_samples{};
+        for (u32 i = 0; i < block_size; i++) {
+            Common::FixedPoint<50, 14> current_sample{};
+            for (u32 channel = 0; channel < NumChannels; channel++) {
+                current_sample += inputs[channel][block_start + i];
             }
-        }
 
-        Common::FixedPoint<50, 14> current_sample{};
-        for (u32 channel = 0; channel < NumChannels; channel++) {
-            current_sample += inputs[channel][sample_index];
+            state.lowpass_0 =
+                (current_sample * state.lowpass_2 + state.lowpass_0 * state.lowpass_1).to_float();
+            input_samples[i] = state.lowpass_0;
         }
+        const std::span<const Common::FixedPoint<50, 14>> pending{input_samples.data(),
+                                                                  block_size};
 
-        state.lowpass_0 =
-            (current_sample * state.lowpass_2 + state.lowpass_0 * state.lowpass_1).to_float();
-        state.early_delay_line.Tick(state.lowpass_0);
+        // Only the taps read the early delay line, so each of them is read for the whole block
+        // before the block is written
+        std::array<Common::FixedPoint<50, 14>, I3dl2BlockSize> early_to_late_taps{};
+        state.early_delay_line.TapOutBlock(state.early_to_late_taps, pending, false,
+                                           {early_to_late_taps.data(), block_size});
 
-        for (u32 channel = 0; channel < NumChannels; channel++) {
-            output_samples[channel] *= state.early_gain;
-        }
+        std::array<std::array<Common::FixedPoint<50, 14>, I3dl2BlockSize>, NumChannels>
+            output_samples{};
+        std::array<Common::FixedPoint<50, 14>, I3dl2BlockSize> taps{};
+        const std::span tap_samples{taps.data(), block_size};
 
-        std::array<Common::FixedPoint<50, 14>, I3dl2ReverbInfo::MaxDelayLines> filtered_samples{};
-        for (u32 delay_line = 0; delay_line < I3dl2ReverbInfo::MaxDelayLines; delay_line++) {
-            filtered_samples[delay_line] =
-                state.fdn_delay_lines[delay_line].Read() * state.lowpass_coeff[delay_line][0] +
-                state.shelf_filter[delay_line];
-            state.shelf_filter[delay_line] =
-                (filtered_samples[delay_line] * state.lowpass_coeff[delay_line][2] +
-                 state.fdn_delay_lines[delay_line].Read() * state.lowpass_coeff[delay_line][1])
-                    .to_float();
+        for (u32 early_tap = 0; early_tap < I3dl2ReverbInfo::MaxDelayTaps; early_tap++) {
+            state.early_delay_line.TapOutBlock(state.early_tap_steps[early_tap], pending, false,
+                                               tap_samples);
+            MixDelayTaps({output_samples[tap_indexes[early_tap]].data(), block_size},
+                         tap_samples, EarlyGains[early_tap]);
+            if constexpr (NumChannels == 6) {
+                MixDelayTaps({output_samples[static_cast<u32>(Channels::LFE)].data(), block_size},
+                             tap_samples, EarlyGains[early_tap]);
+            }
         }
 
-        const std::array<Common::FixedPoint<50, 14>, I3dl2ReverbInfo::MaxDelayLines> mix_matrix{
-            filtered_samples[1] + filtered_samples[2] + early_to_late_tap * state.late_gain,
-            -filtered_samples[0] - filtered_samples[3] + early_to_late_tap * state.late_gain,
-            filtered_samples[0] - filtered_samples[3] + early_to_late_tap * state.late_gain,
-            filtered_samples[1] - filtered_samples[2] + early_to_late_tap * state.late_gain,
-        };
-
-        std::array<Common::FixedPoint<50, 14>, I3dl2ReverbInfo::MaxDelayLines> allpass_samples{};
-        for (u32 delay_line = 0; delay_line < I3dl2ReverbInfo::MaxDelayLines; delay_line++) {
-            allpass_samples[delay_line] = Axfx2AllPassTick(
-                state.decay_delay_lines0[delay_line], state.decay_delay_lines1[delay_line],
-                state.fdn_delay_lines[delay_line], mix_matrix[delay_line]);
+        state.early_delay_line.TickBlock(pending);
+
+        for (u32 channel = 0; channel < NumChannels; channel++) {
+            ScaleDelayTaps({output_samples[channel].data(), block_size}, state.early_gain);
         }
 
-        if constexpr (NumChannels == 6) {
-            const std::array<Common::FixedPoint<50, 14>, MaxChannels> allpass_outputs{
-                allpass_samples[0], allpass_samples[1], allpass_samples[2] - allpass_samples[3],
-                allpass_samples[3], allpass_samples[2], allpass_samples[3],
-            };
+        for (u32 i = 0; i < block_size; i++) {
+            const u32 sample_index{block_start + i};
+            const auto late_sample{early_to_late_taps[i] * state.late_gain};
+
+            std::array<Common::FixedPoint<50, 14>, I3dl2ReverbInfo::MaxDelayLines>
+                filtered_samples{};
+            for (u32 delay_line = 0; delay_line < I3dl2ReverbInfo::MaxDelayLines; delay_line++) {
+                filtered_samples[delay_line] =
+                    state.fdn_delay_lines[delay_line].Read() * state.lowpass_coeff[delay_line][0] +
+                    state.shelf_filter[delay_line];
+                state.shelf_filter[delay_line] =
+                    (filtered_samples[delay_line] * state.lowpass_coeff[delay_line][2] +
+                     state.fdn_delay_lines[delay_line].Read() * state.lowpass_coeff[delay_line][1])
+                        .to_float();
+            }
 
-            for (u32 channel = 0; channel < NumChannels; channel++) {
-                Common::FixedPoint<50, 14> allpass{};
+            const std::array<Common::FixedPoint<50, 14>, I3dl2ReverbInfo::MaxDelayLines>
+                mix_matrix{
+                    filtered_samples[1] + filtered_samples[2] + late_sample,
+                    -filtered_samples[0] - filtered_samples[3] + late_sample,
+                    filtered_samples[0] - filtered_samples[3] + late_sample,
+                    filtered_samples[1] - filtered_samples[2] + late_sample,
+                };
+
+            std::array<Common::FixedPoint<50, 14>, I3dl2ReverbInfo::MaxDelayLines>
+                allpass_samples{};
+            for (u32 delay_line = 0; delay_line < I3dl2ReverbInfo::MaxDelayLines; delay_line++) {
+                allpass_samples[delay_line] = Axfx2AllPassTick(
+                    state.decay_delay_lines0[delay_line], state.decay_delay_lines1[delay_line],
+                    state.fdn_delay_lines[delay_line], mix_matrix[delay_line]);
+            }
 
-                if (channel == static_cast<u32>(Channels::Center)) {
-                    allpass = state.center_delay_line.Tick(allpass_outputs[channel] * 0.5f);
-                } else {
-                    allpass = allpass_outputs[channel];
+            if constexpr (NumChannels == 6) {
+                const std::array<Common::FixedPoint<50, 14>, MaxChannels> allpass_outputs{
+                    allpass_samples[0], allpass_samples[1], allpass_samples[2] - allpass_samples[3],
+                    allpass_samples[3], allpass_samples[2], allpass_samples[3],
+                };
+
+                for (u32 channel = 0; channel < NumChannels; channel++) {
+                    Common::FixedPoint<50, 14> allpass{};
+
+                    if (channel == static_cast<u32>(Channels::Center)) {
+                        allpass = state.center_delay_line.Tick(allpass_outputs[channel] * 0.5f);
+                    } else {
+                        allpass = allpass_outputs[channel];
+                    }
+
+                    const auto dry_sample{static_cast<f32>(inputs[channel][sample_index])};
+                    auto out_sample{output_samples[channel][i] + allpass +
+                                    state.dry_gain * dry_sample};
+
+                    outputs[channel][sample_index] = static_cast<s32>(
+                        std::clamp(out_sample.to_float(), -8388600.0f, 8388600.0f));
+                }
+            } else {
+                for (u32 channel = 0; channel < NumChannels; channel++) {
+                    const auto dry_sample{static_cast<f32>(inputs[channel][sample_index])};
+                    auto out_sample{output_samples[channel][i] + allpass_samples[channel] +
+                                    state.dry_gain * dry_sample};
+                    outputs[channel][sample_index] = static_cast<s32>(
+                        std::clamp(out_sample.to_float(), -8388600.0f, 8388600.0f));
                 }
-
-                auto out_sample{output_samples[channel] + allpass +
-                                state.dry_gain * static_cast<f32>(inputs[channel][sample_index])};
-
-                outputs[channel][sample_index] =
-                    static_cast<s32>(std::clamp(out_sample.to_float(), -8388600.0f, 8388600.0f));
-            }
-        } else {
-            for (u32 channel = 0; channel < NumChannels; channel++) {
-                auto out_sample{output_samples[channel] + allpass_samples[channel] +
-                                state.dry_gain * static_cast<f32>(inputs[channel][sample_index])};
-                outputs[channel][sample_index] =
-                    static_cast<s32>(std::clamp(out_sample.to_float(), -8388600.0f, 8388600.0f));
             }
         }
     }
@@ -6,6 +6,7 @@
 #include <array>
 #include <string>
 
+#include "audio_core/renderer/command/effect/biquad_filter_kernels.h"
 #include "audio_core/renderer/command/icommand.h"
 #include "audio_core/renderer/voice/voice_info.h"
 #include "common/common_types.h"
@@ -43,6 +44,14 @@ struct MultiTapBiquadFilterCommand : ICommand {
      */
     bool Verify(const AudioRenderer::CommandListProcessor& processor) override;
 
+    /**
+     * Reset the states that need it, and get the channel this command filters.
+     *
+     * @param processor - The CommandListProcessor processing this command.
+     * @return The channel to filter through filter_tap_count cascaded filters.
+     */
+    BiquadFilterChannel Prepare(const AudioRenderer::CommandListProcessor& processor);
+
     /// Input mix buffer index
     s16 input;
     /// Output mix buffer index
@@ -1,11 +1,13 @@
 // SPDX-FileCopyrightText: Copyright 2022 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include <numbers>
 #include <ranges>
 
 #include "audio_core/adsp/apps/audio_renderer/command_list_processor.h"
 #include "audio_core/renderer/command/effect/reverb.h"
+#include "audio_core/renderer/command/effect/reverb_kernels.h"
 #include "common/polyfill_ranges.h"
 
 namespace AudioCore::Renderer {
@@ -217,23 +219,28 @@ static void ApplyReverbEffectBypass(std::span<std::span<const s32>> inputs,
 }
 
 /**
- * Tick the delay lines, reading and returning their current output, and writing a new decaying
- * sample (mix).
+ * Tick the feedback delay network, reading its delay lines ahead for the given samples, and
+ * writing the new decaying samples back to them.
  *
- * @param decay  - The decay line.
- * @param fdn    - Feedback delay network.
- * @param mix    - The new calculated sample to be written and decayed.
- * @return The next delayed and decayed sample.
+ * @param state        - State to use, its delay lines must be able to read ahead each sample.
+ * @param late_samples - The pre-delayed samples fed to the network.
+ * @param block        - Receives the delay line samples, fdn_inputs are the network's outputs.
  */
-static Common::FixedPoint<50, 14> Axfx2AllPassTick(ReverbInfo::ReverbDelayLine& decay,
-                                                   ReverbInfo::ReverbDelayLine& fdn,
-                                                   const Common::FixedPoint<50, 14> mix) {
-    const auto val{decay.Read()};
-    const auto mixed{mix - (val * decay.decay)};
-    const auto out{decay.Tick(mixed) + (mixed * decay.decay)};
-
-    fdn.Tick(out);
-    return out;
+static void TickReverbNetwork(ReverbInfo::State& state,
+                              std::span<const Common::FixedPoint<50, 14>> late_samples,
+                              ReverbNetworkBlock& block) {
+    const auto count{late_samples.size()};
+    for (u32 line = 0; line < ReverbInfo::MaxDelayLines; line++) {
+        state.fdn_delay_lines[line].ReadBlock({block.fdn_outputs[line].data(), count});
+        state.decay_delay_lines[line].ReadBlock({block.decay_outputs[line].data(), count});
+    }
+
+    ProcessReverbNetwork(state, late_samples, block);
+
+    for (u32 line = 0; line < ReverbInfo::MaxDelayLines; line++) {
+        state.decay_delay_lines[line].TickBlock({block.decay_inputs[line].data(), count});
+        state.fdn_delay_lines[line].TickBlock({block.fdn_inputs[line].data(), count});
+    }
 }
 
 /**
@@ -276,84 +283,114 @@ static void ApplyReverbEffect(const ReverbInfo::ParameterVersion2& params, Rever
         tap_indexes = OutTapIndexes6Ch;
     }
 
-    for (u32 sample_index = 0; sample_index < sample_count; sample_index++) {
-        std::array<Common::FixedPoint<50, 14>, NumChannels> output_samples{};
+    const auto base_gain{Common::FixedPoint<50, 14>::from_base(params.base_gain)};
+    const auto late_gain{Common::FixedPoint<50, 14>::from_base(params.late_gain)};
+    const auto dry_gain{Common::FixedPoint<50, 14>::from_base(params.dry_gain)};
+    const auto wet_gain{Common::FixedPoint<50, 14>::from_base(params.wet_gain)};
 
-        for (u32 early_tap = 0; early_tap < ReverbInfo::MaxDelayTaps; early_tap++) {
-            const auto sample{state.pre_delay_line.TapOut(state.early_delay_times[early_tap]) *
-                              state.early_gains[early_tap]};
-            output_samples[tap_indexes[early_tap]] += sample;
-            if constexpr (NumChannels == 6) {
-                output_samples[static_cast<u32>(Channels::LFE)] += sample;
-            }
-        }
+    for (u32 block_start = 0; block_start < sample_count; block_start += ReverbBlockSize) {
+        const u32 block_size{std::min(ReverbBlockSize, sample_count - block_start)};
 
-        if constexpr (NumChannels == 6) {
-            output_samples[static_cast<u32>(Channels::LFE)] *= 0.2f;
-        }
+        std::array<Common::FixedPoint<50, 14>, ReverbBlockSize> input_samples{};
+        for (u32 i = 0; i < block_size; i++) {
+            Common::FixedPoint<50, 14> input_sample{};
+            for (u32 channel = 0; channel < NumChannels; channel++) {
+                input_sample += inputs[channel][block_start + i];
+            }
 
-        Common::FixedPoint<50, 14> input_sample{};
-        for (u32 channel = 0; channel < NumChannels; channel++) {
-            input_sample += inputs[channel][sample_index];
+            input_sample *= 64;
+            input_sample *= base_gain;
+            input_samples[i] = input_sample;
         }
+        const std::span<const Common::FixedPoint<50, 14>> pending{input_samples.data(),
+                                                                  block_size};
 
-        input_sample *= 64;
-        input_sample *= Common::FixedPoint<50, 14>::from_base(params.base_gain);
-        state.pre_delay_line.Write(input_sample);
+        // Only the taps read the pre-delay line, so each of them is read for the whole block
+        // before the block is written
+        std::array<std::array<Common::FixedPoint<50, 14>, ReverbBlockSize>, NumChannels>
+            output_samples{};
+        std::array<Common::FixedPoint<50, 14>, ReverbBlockSize> taps{};
+        const std::span tap_samples{taps.data(), block_size};
 
-        for (u32 i = 0; i < ReverbInfo::MaxDelayLines; i++) {
-            state.prev_feedback_output[i] =
-                state.prev_feedback_output[i] * state.hf_decay_prev_gain[i] +
-                state.fdn_delay_lines[i].Read() * state.hf_decay_gain[i];
+        for (u32 early_tap = 0; early_tap < ReverbInfo::MaxDelayTaps; early_tap++) {
+            state.pre_delay_line.TapOutBlock(state.early_delay_times[early_tap], pending, false,
+                                             tap_samples);
+            MixDelayTaps({output_samples[tap_indexes[early_tap]].data(), block_size},
+                         tap_samples, state.early_gains[early_tap]);
+            if constexpr (NumChannels == 6) {
+                MixDelayTaps({output_samples[static_cast<u32>(Channels::LFE)].data(), block_size},
+                             tap_samples, state.early_gains[early_tap]);
+            }
         }
 
-        Common::FixedPoint<50, 14> pre_delay_sample{
-            state.pre_delay_line.TapOut(state.pre_delay_time) *
-            Common::FixedPoint<50, 14>::from_base(params.late_gain)};
+        if constexpr (NumChannels == 6) {
+            ScaleDelayTaps({output_samples[static_cast<u32>(Channels::LFE)].data(), block_size},
+                           0.2f);
+        }
 
-        std::array<Common::FixedPoint<50, 14>, ReverbInfo::MaxDelayLines> mix_matrix{
-            state.prev_feedback_output[2] + state.prev_feedback_output[1] + pre_delay_sample,
-            -state.prev_feedback_output[0] - state.prev_feedback_output[3] + pre_delay_sample,
-            state.prev_feedback_output[0] - state.prev_feedback_output[3] + pre_delay_sample,
-            state.prev_feedback_output[1] - state.prev_feedback_output[2] + pre_delay_sample,
+        std::array<Common::FixedPoint<50, 14>, ReverbBlockSize> pre_delay_samples{};
+        const std::span late_samples{pre_delay_samples.data(), block_size};
+        state.pre_delay_line.TapOutBlock(state.pre_delay_time, pending, true, late_samples);
+        ScaleDelayTaps(late_samples, late_gain);
+        state.pre_delay_line.WriteBlock(pending);
+
+        // The delay lines are read ahead for the whole block, unless one would read back a
+        // sample written within it, then the block is run a sample at a time
+        ReverbNetworkBlock network;
+        const auto can_read_ahead = [block_size](const ReverbInfo::ReverbDelayLine& line) {
+            return line.CanReadAhead(static_cast<s32>(block_size));
         };
-
-        std::array<Common::FixedPoint<50, 14>, ReverbInfo::MaxDelayLines> allpass_samples{};
-        for (u32 i = 0; i < ReverbInfo::MaxDelayLines; i++) {
-            allpass_samples[i] = Axfx2AllPassTick(state.decay_delay_lines[i],
-                                                  state.fdn_delay_lines[i], mix_matrix[i]);
+        if (std::ranges::all_of(state.fdn_delay_lines, can_read_ahead) &&
+            std::ranges::all_of(state.decay_delay_lines, can_read_ahead)) {
+            TickReverbNetwork(state, late_samples, network);
+        } else {
+            for (u32 i = 0; i < block_size; i++) {
+                ReverbNetworkBlock sample_network;
+                TickReverbNetwork(state, late_samples.subspan(i, 1), sample_network);
+                for (u32 line = 0; line < ReverbInfo::MaxDelayLines; line++) {
+                    network.fdn_inputs[line][i] = sample_network.fdn_inputs[line][0];
+                }
+            }
         }
 
-        const auto dry_gain{Common::FixedPoint<50, 14>::from_base(params.dry_gain)};
-        const auto wet_gain{Common::FixedPoint<50, 14>::from_base(params.wet_gain)};
-
+        std::array<std::span<const Common::FixedPoint<50, 14>>, NumChannels> allpass_samples{};
+        std::array<Common::FixedPoint<50, 14>, ReverbBlockSize> center_samples{};
         if constexpr (NumChannels == 6) {
-            const std::array<Common::FixedPoint<50, 14>, MaxChannels> allpass_outputs{
-                allpass_samples[0], allpass_samples[1], allpass_samples[2] - allpass_samples[3],
-                allpass_samples[3], allpass_samples[2], allpass_samples[3],
-            };
-
-            for (u32 channel = 0; channel < NumChannels; channel++) {
-                auto in_sample{inputs[channel][sample_index] * dry_gain};
+            std::array<Common::FixedPoint<50, 14>, ReverbBlockSize> center_inputs{};
+            for (u32 i = 0; i < block_size; i++) {
+                center_inputs[i] = (network.fdn_inputs[2][i] - network.fdn_inputs[3][i]) * 0.5f;
+            }
 
-                Common::FixedPoint<50, 14> allpass{};
-                if (channel == static_cast<u32>(Channels::Center)) {
-                    allpass = state.center_delay_line.Tick(allpass_outputs[channel] * 0.5f);
-                } else {
-                    allpass = allpass_outputs[channel];
+            auto& center_line{state.center_delay_line};
+            if (center_line.CanReadAhead(static_cast<s32>(block_size))) {
+                center_line.ReadBlock({center_samples.data(), block_size});
+                center_line.TickBlock({center_inputs.data(), block_size});
+            } else {
+                for (u32 i = 0; i < block_size; i++) {
+                    center_samples[i] = center_line.Tick(center_inputs[i]);
                 }
-
-                auto out_sample{((output_samples[channel] + allpass) * wet_gain) / 64};
-                outputs[channel][sample_index] = (in_sample + out_sample).to_int();
             }
+
+            allpass_samples = {
+                std::span{network.fdn_inputs[0].data(), block_size},
+                std::span{network.fdn_inputs[1].data(), block_size},
+                std::span{center_samples.data(), block_size},
+                std::span{network.fdn_inputs[3].data(), block_size},
+                std::span{network.fdn_inputs[2].data(), block_size},
+                std::span{network.fdn_inputs[3].data(), block_size},
+            };
         } else {
             for (u32 channel = 0; channel < NumChannels; channel++) {
-                auto in_sample{inputs[channel][sample_index] * dry_gain};
-                auto out_sample{((output_samples[channel] + allpass_samples[channel]) * wet_gain) /
-                                64};
-                outputs[channel][sample_index] = (in_sample + out_sample).to_int();
+                allpass_samples[channel] = {network.fdn_inputs[channel].data(), block_size};
             }
         }
+
+        for (u32 channel = 0; channel < NumChannels; channel++) {
+            MixReverbOutput(outputs[channel].subspan(block_start, block_size),
+                            inputs[channel].subspan(block_start, block_size),
+                            {output_samples[channel].data(), block_size}, allpass_samples[channel],
+                            dry_gain, wet_gain);
+        }
     }
 }
 
@@ -0,0 +1,357 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <limits>
+
+#include "audio_core/renderer/command/effect/reverb_kernels.h"
+
+#if defined(ARCHITECTURE_x86_64)
+#include <immintrin.h>
+#include "common/x64/cpu_detect.h"
+#endif
+
+#if defined(ARCHITECTURE_x86_64) && (defined(__GNUC__) || defined(__clang__))
+#define TARGET_SSE41 __attribute__((target("sse4.1")))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TARGET_SSE41
+#define TARGET_AVX2
+#endif
+
+namespace AudioCore::Renderer {
+namespace {
+
+/// Whether a gain fits the 32-bit operands of the vector multiplies
+bool FitsVectorGain(const Common::FixedPoint<50, 14> gain) {
+    return gain.to_raw() >= std::numeric_limits<s32>::min() &&
+           gain.to_raw() <= std::numeric_limits<s32>::max();
+}
+
+template <bool Mix>
+void ApplyGainScalar(std::span<Common::FixedPoint<50, 14>> output,
+                     std::span<const Common::FixedPoint<50, 14>> taps,
+                     const Common::FixedPoint<50, 14> gain) {
+    for (size_t i = 0; i < output.size(); i++) {
+        if constexpr (Mix) {
+            output[i] += taps[i] * gain;
+        } else {
+            output[i] = taps[i] * gain;
+        }
+    }
+}
+
+void ProcessNetworkScalar(ReverbInfo::State& state,
+                          std::span<const Common::FixedPoint<50, 14>> late_samples,
+                          ReverbNetworkBlock& block, size_t start) {
+    auto& feedback{state.prev_feedback_output};
+    for (size_t i = start; i < late_samples.size(); i++) {
+        for (u32 line = 0; line < ReverbInfo::MaxDelayLines; line++) {
+            feedback[line] = feedback[line] * state.hf_decay_prev_gain[line] +
+                             block.fdn_outputs[line][i] * state.hf_decay_gain[line];
+        }
+
+        const auto late_sample{late_samples[i]};
+        const std::array<Common::FixedPoint<50, 14>, ReverbInfo::MaxDelayLines> mix_matrix{
+            feedback[2] + feedback[1] + late_sample,
+            -feedback[0] - feedback[3] + late_sample,
+            feedback[0] - feedback[3] + late_sample,
+            feedback[1] - feedback[2] + late_sample,
+        };
+
+        for (u32 line = 0; line < ReverbInfo::MaxDelayLines; line++) {
+            const auto decay{state.decay_delay_lines[line].decay};
+            const auto value{block.decay_outputs[line][i]};
+            const auto mixed{mix_matrix[line] - (value * decay)};
+            block.decay_inputs[line][i] = mixed;
+            block.fdn_inputs[line][i] = value + (mixed * decay);
+        }
+    }
+}
+
+void MixOutputScalar(std::span<s32> output, std::span<const s32> input,
+                     std::span<const Common::FixedPoint<50, 14>> early,
+                     std::span<const Common::FixedPoint<50, 14>> late,
+                     const Common::FixedPoint<50, 14> dry_gain,
+                     const Common::FixedPoint<50, 14> wet_gain, size_t start) {
+    for (size_t i = start; i < output.size(); i++) {
+        auto in_sample{input[i] * dry_gain};
+        auto out_sample{((early[i] + late[i]) * wet_gain) / 64};
+        output[i] = (in_sample + out_sample).to_int();
+    }
+}
+
+#if defined(ARCHITECTURE_x86_64)
+
+/*
+ * The fixed point products are the 128-bit products of the raw values shifted down by the 14
+ * fractional bits, truncated to 64 bits. With a gain of 32 bits, they are built from the 64-bit
+ * products of the gain with each half of the samples. The unsigned low half product treats a
+ * negative gain as gain + 2^32, which is taken back off the high half through negative_low, the
+ * low half mask in lanes with a negative gain.
+ */
+
+TARGET_SSE41 __m128i MultiplySse41(__m128i samples, __m128i gain, __m128i negative_low) {
+    const __m128i low{_mm_mul_epu32(samples, gain)};
+    const __m128i high{_mm_sub_epi64(_mm_mul_epi32(_mm_srli_epi64(samples, 32), gain),
+                                     _mm_and_si128(samples, negative_low))};
+    return _mm_add_epi64(_mm_slli_epi64(high, 32 - 14), _mm_srli_epi64(low, 14));
+}
+
+TARGET_AVX2 __m256i MultiplyAvx2(__m256i samples, __m256i gain, __m256i negative_low) {
+    const __m256i low{_mm256_mul_epu32(samples, gain)};
+    const __m256i high{_mm256_sub_epi64(_mm256_mul_epi32(_mm256_srli_epi64(samples, 32), gain),
+                                        _mm256_and_si256(samples, negative_low))};
+    return _mm256_add_epi64(_mm256_slli_epi64(high, 32 - 14), _mm256_srli_epi64(low, 14));
+}
+
+TARGET_AVX2 __m256i NegativeLowAvx2(__m256i gain) {
+    return _mm256_and_si256(_mm256_cmpgt_epi64(_mm256_setzero_si256(), gain),
+                            _mm256_set1_epi64x(0xFFFFFFFF));
+}
+
+template <bool Mix>
+TARGET_SSE41 void ApplyGainSse41(std::span<Common::FixedPoint<50, 14>> output,
+                                 std::span<const Common::FixedPoint<50, 14>> taps,
+                                 const Common::FixedPoint<50, 14> gain) {
+    const __m128i gains{_mm_set1_epi64x(gain.to_raw())};
+    const __m128i negative_low{_mm_set1_epi64x(gain.to_raw() < 0 ? 0xFFFFFFFF : 0)};
+    size_t i{};
+    for (; i + 2 <= output.size(); i += 2) {
+        auto* out{reinterpret_cast<__m128i*>(&output[i])};
+        const __m128i samples{_mm_loadu_si128(reinterpret_cast<const __m128i*>(&taps[i]))};
+        __m128i result{MultiplySse41(samples, gains, negative_low)};
+        if constexpr (Mix) {
+            result = _mm_add_epi64(_mm_loadu_si128(out), result);
+        }
+        _mm_storeu_si128(out, result);
+    }
+    ApplyGainScalar<Mix>(output.subspan(i), taps.subspan(i), gain);
+}
+
+template <bool Mix>
+TARGET_AVX2 void ApplyGainAvx2(std::span<Common::FixedPoint<50, 14>> output,
+                               std::span<const Common::FixedPoint<50, 14>> taps,
+                               const Common::FixedPoint<50, 14> gain) {
+    const __m256i gains{_mm256_set1_epi64x(gain.to_raw())};
+    const __m256i negative_low{NegativeLowAvx2(gains)};
+    size_t i{};
+    for (; i + 4 <= output.size(); i += 4) {
+        auto* out{reinterpret_cast<__m256i*>(&output[i])};
+        const __m256i samples{_mm256_loadu_si256(reinterpret_cast<const __m256i*>(&taps[i]))};
+        __m256i result{MultiplyAvx2(samples, gains, negative_low)};
+        if constexpr (Mix) {
+            result = _mm256_add_epi64(_mm256_loadu_si256(out), result);
+        }
+        _mm256_storeu_si256(out, result);
+    }
+    ApplyGainScalar<Mix>(output.subspan(i), taps.subspan(i), gain);
+}
+
+/// Transpose 4 rows of 4 samples, into 4 columns
+TARGET_AVX2 void TransposeAvx2(__m256i (&rows)[4]) {
+    const __m256i low01{_mm256_unpacklo_epi64(rows[0], rows[1])};
+    const __m256i high01{_mm256_unpackhi_epi64(rows[0], rows[1])};
+    const __m256i low23{_mm256_unpacklo_epi64(rows[2], rows[3])};
+    const __m256i high23{_mm256_unpackhi_epi64(rows[2], rows[3])};
+    rows[0] = _mm256_permute2x128_si256(low01, low23, 0x20);
+    rows[1] = _mm256_permute2x128_si256(high01, high23, 0x20);
+    rows[2] = _mm256_permute2x128_si256(low01, low23, 0x31);
+    rows[3] = _mm256_permute2x128_si256(high01, high23, 0x31);
+}
+
+TARGET_AVX2 void LoadColumnsAvx2(
+    const std::array<std::array<Common::FixedPoint<50, 14>, ReverbBlockSize>,
+                     ReverbInfo::MaxDelayLines>& lines,
+    size_t start, __m256i (&columns)[4]) {
+    for (u32 line = 0; line < ReverbInfo::MaxDelayLines; line++) {
+        columns[line] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&lines[line][start]));
+    }
+    TransposeAvx2(columns);
+}
+
+TARGET_AVX2 void StoreColumnsAvx2(
+    std::array<std::array<Common::FixedPoint<50, 14>, ReverbBlockSize>,
+               ReverbInfo::MaxDelayLines>& lines,
+    size_t start, __m256i (&columns)[4]) {
+    TransposeAvx2(columns);
+    for (u32 line = 0; line < ReverbInfo::MaxDelayLines; line++) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&lines[line][start]), columns[line]);
+    }
+}
+
+/// Run the network with each delay line in a lane, returns the number of samples processed
+TARGET_AVX2 size_t ProcessNetworkAvx2(ReverbInfo::State& state,
+                                      std::span<const Common::FixedPoint<50, 14>> late_samples,
+                                      ReverbNetworkBlock& block) {
+    static_assert(ReverbInfo::MaxDelayLines == 4, "Each delay line is a lane of a vector");
+    const auto& decay_lines{state.decay_delay_lines};
+    const __m256i prev_gain{
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state.hf_decay_prev_gain.data()))};
+    const __m256i gain{
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state.hf_decay_gain.data()))};
+    const __m256i decay{
+        _mm256_set_epi64x(decay_lines[3].decay.to_raw(), decay_lines[2].decay.to_raw(),
+                          decay_lines[1].decay.to_raw(), decay_lines[0].decay.to_raw())};
+    const __m256i prev_gain_negative{NegativeLowAvx2(prev_gain)};
+    const __m256i gain_negative{NegativeLowAvx2(gain)};
+    const __m256i decay_negative{NegativeLowAvx2(decay)};
+    const __m256i zero{_mm256_setzero_si256()};
+
+    auto* feedback_data{reinterpret_cast<__m256i*>(state.prev_feedback_output.data())};
+    __m256i feedback{_mm256_loadu_si256(feedback_data)};
+
+    size_t i{};
+    for (; i + 4 <= late_samples.size(); i += 4) {
+        __m256i fdn_outputs[4];
+        __m256i decay_outputs[4];
+        LoadColumnsAvx2(block.fdn_outputs, i, fdn_outputs);
+        LoadColumnsAvx2(block.decay_outputs, i, decay_outputs);
+
+        __m256i fdn_inputs[4];
+        __m256i decay_inputs[4];
+        for (size_t sample = 0; sample < 4; sample++) {
+            feedback = _mm256_add_epi64(MultiplyAvx2(feedback, prev_gain, prev_gain_negative),
+                                        MultiplyAvx2(fdn_outputs[sample], gain, gain_negative));
+
+            // Lanes of {2, -0, 0, 1} and {1, -3, -3, -2} of the feedback, added together
+            const __m256i first{_mm256_permute4x64_epi64(feedback, 0b01'00'00'10)};
+            const __m256i second{_mm256_permute4x64_epi64(feedback, 0b10'11'11'01)};
+            const __m256i first_signed{
+                _mm256_blend_epi32(first, _mm256_sub_epi64(zero, first), 0b0000'1100)};
+            const __m256i second_signed{
+                _mm256_blend_epi32(second, _mm256_sub_epi64(zero, second), 0b1111'1100)};
+            const __m256i late{_mm256_set1_epi64x(late_samples[i + sample].to_raw())};
+            const __m256i mix{
+                _mm256_add_epi64(_mm256_add_epi64(first_signed, second_signed), late)};
+
+            const __m256i value{decay_outputs[sample]};
+            const __m256i mixed{
+                _mm256_sub_epi64(mix, MultiplyAvx2(value, decay, decay_negative))};
+            decay_inputs[sample] = mixed;
+            fdn_inputs[sample] =
+                _mm256_add_epi64(value, MultiplyAvx2(mixed, decay, decay_negative));
+        }
+
+        StoreColumnsAvx2(block.fdn_inputs, i, fdn_inputs);
+        StoreColumnsAvx2(block.decay_inputs, i, decay_inputs);
+    }
+
+    _mm256_storeu_si256(feedback_data, feedback);
+    return i;
+}
+
+/// Fixed point raw values divided by 64, rounding towards zero as integer division does
+TARGET_AVX2 __m256i DivideBy64Avx2(__m256i value) {
+    // Arithmetic shifts of 64-bit lanes need AVX-512, so the sign is shifted back in
+    const __m256i sign{_mm256_cmpgt_epi64(_mm256_setzero_si256(), value)};
+    const __m256i biased{_mm256_add_epi64(value, _mm256_and_si256(sign, _mm256_set1_epi64x(63)))};
+    return _mm256_or_si256(_mm256_srli_epi64(biased, 6), _mm256_slli_epi64(sign, 64 - 6));
+}
+
+/// Mix the output with 4 samples in each vector, returns the number of samples processed
+TARGET_AVX2 size_t MixOutputAvx2(std::span<s32> output, std::span<const s32> input,
+                                 std::span<const Common::FixedPoint<50, 14>> early,
+                                 std::span<const Common::FixedPoint<50, 14>> late,
+                                 const Common::FixedPoint<50, 14> dry_gain,
+                                 const Common::FixedPoint<50, 14> wet_gain) {
+    const __m256i dry{_mm256_set1_epi64x(dry_gain.to_raw())};
+    const __m256i wet{_mm256_set1_epi64x(wet_gain.to_raw())};
+    const __m256i wet_negative{NegativeLowAvx2(wet)};
+    const __m256i fractional_mask{_mm256_set1_epi64x(0x3FFF)};
+    const __m256i low_words{_mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6)};
+
+    size_t i{};
+    for (; i + 4 <= output.size(); i += 4) {
+        // The dry input is an integer, so its product with the gain has no fraction to drop
+        const __m256i dry_samples{_mm256_cvtepi32_epi64(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(&input[i])))};
+        const __m256i in_sample{_mm256_mul_epi32(dry_samples, dry)};
+
+        const __m256i wet_samples{_mm256_add_epi64(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&early[i])),
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&late[i])))};
+        const __m256i out_sample{DivideBy64Avx2(MultiplyAvx2(wet_samples, wet, wet_negative))};
+
+        // to_int rounds half of the fraction up before dropping it, keeping the low 32 bits
+        __m256i sample{_mm256_add_epi64(in_sample, out_sample)};
+        sample = _mm256_add_epi64(
+            sample, _mm256_srli_epi64(_mm256_and_si256(sample, fractional_mask), 1));
+        sample = _mm256_permutevar8x32_epi32(_mm256_srli_epi64(sample, 14), low_words);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&output[i]), _mm256_castsi256_si128(sample));
+    }
+    return i;
+}
+
+#endif
+
+template <bool Mix>
+void ApplyGain(std::span<Common::FixedPoint<50, 14>> output,
+               std::span<const Common::FixedPoint<50, 14>> taps,
+               const Common::FixedPoint<50, 14> gain) {
+#if defined(ARCHITECTURE_x86_64)
+    if (FitsVectorGain(gain)) {
+        const auto& caps{Common::GetCPUCaps()};
+        if (caps.avx2) {
+            ApplyGainAvx2<Mix>(output, taps, gain);
+            return;
+        }
+        if (caps.sse4_1) {
+            ApplyGainSse41<Mix>(output, taps, gain);
+            return;
+        }
+    }
+#endif
+    ApplyGainScalar<Mix>(output, taps, gain);
+}
+
+} // Anonymous namespace
+
+void MixDelayTaps(std::span<Common::FixedPoint<50, 14>> output,
+                  std::span<const Common::FixedPoint<50, 14>> taps,
+                  const Common::FixedPoint<50, 14> gain) {
+    ApplyGain<true>(output, taps, gain);
+}
+
+void ScaleDelayTaps(std::span<Common::FixedPoint<50, 14>> samples,
+                    const Common::FixedPoint<50, 14> gain) {
+    ApplyGain<false>(samples, samples, gain);
+}
+
+void ProcessReverbNetwork(ReverbInfo::State& state,
+                          std::span<const Common::FixedPoint<50, 14>> late_samples,
+                          ReverbNetworkBlock& block) {
+    size_t processed{};
+#if defined(ARCHITECTURE_x86_64)
+    const auto fits_vector_gains = [&state] {
+        for (u32 line = 0; line < ReverbInfo::MaxDelayLines; line++) {
+            if (!FitsVectorGain(state.hf_decay_prev_gain[line]) ||
+                !FitsVectorGain(state.hf_decay_gain[line]) ||
+                !FitsVectorGain(state.decay_delay_lines[line].decay)) {
+                return false;
+            }
+        }
+        return true;
+    };
+    if (Common::GetCPUCaps().avx2 && fits_vector_gains()) {
+        processed = ProcessNetworkAvx2(state, late_samples, block);
+    }
+#endif
+    ProcessNetworkScalar(state, late_samples, block, processed);
+}
+
+void MixReverbOutput(std::span<s32> output, std::span<const s32> input,
+                     std::span<const Common::FixedPoint<50, 14>> early,
+                     std::span<const Common::FixedPoint<50, 14>> late,
+                     const Common::FixedPoint<50, 14> dry_gain,
+                     const Common::FixedPoint<50, 14> wet_gain) {
+    size_t processed{};
+#if defined(ARCHITECTURE_x86_64)
+    if (Common::GetCPUCaps().avx2 && FitsVectorGain(dry_gain) && FitsVectorGain(wet_gain)) {
+        processed = MixOutputAvx2(output, input, early, late, dry_gain, wet_gain);
+    }
+#endif
+    MixOutputScalar(output, input, early, late, dry_gain, wet_gain, processed);
+}
+
+} // namespace AudioCore::Renderer
@@ -0,0 +1,94 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <span>
+
+#include "audio_core/renderer/effect/reverb.h"
+#include "common/common_types.h"
+#include "common/fixed_point.h"
+
+namespace AudioCore::Renderer {
+
+/// Samples the reverb processes at once, each of its delay lines is read for all of them together
+constexpr u32 ReverbBlockSize{48};
+
+/**
+ * Delay line samples of a block run through the reverb's feedback delay network, one row per
+ * delay line.
+ */
+struct ReverbNetworkBlock {
+    /// Outputs of the feedback delay lines, read ahead for the block
+    std::array<std::array<Common::FixedPoint<50, 14>, ReverbBlockSize>, ReverbInfo::MaxDelayLines>
+        fdn_outputs;
+    /// Outputs of the decay delay lines, read ahead for the block
+    std::array<std::array<Common::FixedPoint<50, 14>, ReverbBlockSize>, ReverbInfo::MaxDelayLines>
+        decay_outputs;
+    /// Samples to write to the feedback delay lines, which are also the network's outputs
+    std::array<std::array<Common::FixedPoint<50, 14>, ReverbBlockSize>, ReverbInfo::MaxDelayLines>
+        fdn_inputs;
+    /// Samples to write to the decay delay lines
+    std::array<std::array<Common::FixedPoint<50, 14>, ReverbBlockSize>, ReverbInfo::MaxDelayLines>
+        decay_inputs;
+};
+
+/**
+ * Add a block of delay line taps scaled by a gain to the output, output[i] += taps[i] * gain.
+ * Results match Common::FixedPoint<50, 14> arithmetic exactly, using vector instructions when the
+ * host supports them and the gain fits their 32-bit multiplies.
+ *
+ * @param output - Samples to add the scaled taps to.
+ * @param taps   - Taps to scale, as many as output.
+ * @param gain   - Gain to scale the taps by.
+ */
+void MixDelayTaps(std::span<Common::FixedPoint<50, 14>> output,
+                  std::span<const Common::FixedPoint<50, 14>> taps,
+                  Common::FixedPoint<50, 14> gain);
+
+/**
+ * Scale a block of delay line taps by a gain, samples[i] *= gain.
+ * Results match Common::FixedPoint<50, 14> arithmetic exactly, using vector instructions when the
+ * host supports them and the gain fits their 32-bit multiplies.
+ *
+ * @param samples - Samples to scale in place.
+ * @param gain    - Gain to scale the samples by.
+ */
+void ScaleDelayTaps(std::span<Common::FixedPoint<50, 14>> samples,
+                    Common::FixedPoint<50, 14> gain);
+
+/**
+ * Run a block through the reverb's feedback delay network, the high frequency decay filters,
+ * mixing matrix and allpass decay of each delay line. The delay lines must be read ahead into
+ * the block, and written with its results afterwards. Each sample's delay lines are processed
+ * together across vector lanes when the host supports them, with results matching ticking them
+ * one sample at a time.
+ *
+ * @param state        - Reverb state, its feedback filters are updated.
+ * @param late_samples - Pre-delayed input of each sample, at most ReverbBlockSize.
+ * @param block        - Delay line outputs read ahead, receives the delay line inputs.
+ */
+void ProcessReverbNetwork(ReverbInfo::State& state,
+                          std::span<const Common::FixedPoint<50, 14>> late_samples,
+                          ReverbNetworkBlock& block);
+
+/**
+ * Mix a block of the reverb's output,
+ * output[i] = (input[i] * dry_gain + ((early[i] + late[i]) * wet_gain) / 64).to_int().
+ * Results match Common::FixedPoint<50, 14> arithmetic exactly, using vector instructions when the
+ * host supports them and the gains fit their 32-bit multiplies.
+ *
+ * @param output   - Output samples, may be the input samples.
+ * @param input    - Dry input samples, as many as output.
+ * @param early    - Early reflections, as many as output.
+ * @param late     - Late reverberation, as many as output.
+ * @param dry_gain - Gain of the dry input.
+ * @param wet_gain - Gain of the reverberation.
+ */
+void MixReverbOutput(std::span<s32> output, std::span<const s32> input,
+                     std::span<const Common::FixedPoint<50, 14>> early,
+                     std::span<const Common::FixedPoint<50, 14>> late,
+                     Common::FixedPoint<50, 14> dry_gain, Common::FixedPoint<50, 14> wet_gain);
+
+} // namespace AudioCore::Renderer
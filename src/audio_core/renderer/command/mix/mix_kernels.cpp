@@ -0,0 +1,219 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <limits>
+
+#include "audio_core/renderer/command/mix/mix_kernels.h"
+
+#if defined(ARCHITECTURE_x86_64)
+#include <immintrin.h>
+#include "common/x64/cpu_detect.h"
+#elif defined(ARCHITECTURE_arm64)
+#include <arm_neon.h>
+#endif
+
+#if defined(ARCHITECTURE_x86_64) && (defined(__GNUC__) || defined(__clang__))
+#define TARGET_SSE41 __attribute__((target("sse4.1")))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TARGET_SSE41
+#define TARGET_AVX2
+#endif
+
+namespace AudioCore::Renderer {
+namespace {
+/// Matches Common::FixedPoint::to_int, including its rounding of the fractional part.
+template <size_t Q>
+s32 RoundToInt(s64 value) {
+    constexpr s64 fractional_mask{(s64{1} << Q) - 1};
+    value += (value & fractional_mask) >> 1;
+    return static_cast<s32>(value >> Q);
+}
+
+template <size_t Q, bool Accumulate>
+void ApplyScalar(s32* output, const s32* input, s64 gain, s64 ramp, u32 first, u32 count) {
+    gain += ramp * first;
+    for (u32 i = first; i < count; i++) {
+        s64 value{static_cast<s64>(input[i]) * gain};
+        if constexpr (Accumulate) {
+            value += static_cast<s64>(output[i]) * (s64{1} << Q);
+        }
+        output[i] = RoundToInt<Q>(value);
+        gain += ramp;
+    }
+}
+
+/// Vector kernels multiply 32-bit lanes, so every gain used must fit in one.
+bool GainsFitLanes(s64 gain, s64 ramp, u32 sample_count) {
+    constexpr s64 min{std::numeric_limits<s32>::min()};
+    constexpr s64 max{std::numeric_limits<s32>::max()};
+    const s64 last{gain + ramp * (sample_count - 1)};
+    return gain >= min && gain <= max && last >= min && last <= max;
+}
+
+template <size_t Lanes>
+std::array<s32, Lanes> LaneGains(s64 gain, s64 ramp) {
+    std::array<s32, Lanes> gains{};
+    for (size_t i = 0; i < Lanes; i++) {
+        gains[i] = static_cast<s32>(gain + ramp * static_cast<s64>(i));
+    }
+    return gains;
+}
+
+/// Per lane gain step. Lane gains may wrap while stepping past the last sample, which the 32-bit
+/// adds handle, so only the low bits are needed.
+s32 LaneStep(s64 ramp, size_t lanes) {
+    return static_cast<s32>(static_cast<u32>(static_cast<u64>(ramp) * lanes));
+}
+
+#if defined(ARCHITECTURE_x86_64)
+/// Rounds 64-bit lanes like RoundToInt, the results are in the low half of each lane.
+template <size_t Q>
+TARGET_SSE41 __m128i RoundLanes(__m128i value, __m128i fractional_mask) {
+    value = _mm_add_epi64(value, _mm_srli_epi64(_mm_and_si128(value, fractional_mask), 1));
+    return _mm_srli_epi64(value, Q);
+}
+
+template <size_t Q>
+TARGET_AVX2 __m256i RoundLanes(__m256i value, __m256i fractional_mask) {
+    value =
+        _mm256_add_epi64(value, _mm256_srli_epi64(_mm256_and_si256(value, fractional_mask), 1));
+    return _mm256_srli_epi64(value, Q);
+}
+
+template <size_t Q, bool Accumulate>
+TARGET_SSE41 u32 ApplySse41(s32* output, const s32* input, s64 gain, s64 ramp, u32 count) {
+    const __m128i fractional_mask{_mm_set1_epi64x((s64{1} << Q) - 1)};
+    const __m128i one{_mm_set1_epi32(1 << Q)};
+    const __m128i step{_mm_set1_epi32(LaneStep(ramp, 4))};
+    const auto initial_gains{LaneGains<4>(gain, ramp)};
+    __m128i gains{_mm_loadu_si128(reinterpret_cast<const __m128i*>(initial_gains.data()))};
+
+    u32 i{};
+    for (; i + 4 <= count; i += 4) {
+        const __m128i samples{_mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i))};
+        __m128i even{_mm_mul_epi32(samples, gains)};
+        __m128i odd{_mm_mul_epi32(_mm_srli_epi64(samples, 32), _mm_srli_epi64(gains, 32))};
+        if constexpr (Accumulate) {
+            const __m128i mixed{_mm_loadu_si128(reinterpret_cast<const __m128i*>(output + i))};
+            even = _mm_add_epi64(even, _mm_mul_epi32(mixed, one));
+            odd = _mm_add_epi64(odd, _mm_mul_epi32(_mm_srli_epi64(mixed, 32), one));
+        }
+        const __m128i result{
+            _mm_blend_epi16(RoundLanes<Q>(even, fractional_mask),
+                            _mm_slli_epi64(RoundLanes<Q>(odd, fractional_mask), 32), 0xCC)};
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), result);
+        gains = _mm_add_epi32(gains, step);
+    }
+    return i;
+}
+
+template <size_t Q, bool Accumulate>
+TARGET_AVX2 u32 ApplyAvx2(s32* output, const s32* input, s64 gain, s64 ramp, u32 count) {
+    const __m256i fractional_mask{_mm256_set1_epi64x((s64{1} << Q) - 1)};
+    const __m256i one{_mm256_set1_epi32(1 << Q)};
+    const __m256i step{_mm256_set1_epi32(LaneStep(ramp, 8))};
+    const auto initial_gains{LaneGains<8>(gain, ramp)};
+    __m256i gains{_mm256_loadu_si256(reinterpret_cast<const __m256i*>(initial_gains.data()))};
+
+    u32 i{};
+    for (; i + 8 <= count; i += 8) {
+        const __m256i samples{_mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i))};
+        __m256i even{_mm256_mul_epi32(samples, gains)};
+        __m256i odd{
+            _mm256_mul_epi32(_mm256_srli_epi64(samples, 32), _mm256_srli_epi64(gains, 32))};
+        if constexpr (Accumulate) {
+            const __m256i mixed{_mm256_loadu_si256(reinterpret_cast<const __m256i*>(output + i))};
+            even = _mm256_add_epi64(even, _mm256_mul_epi32(mixed, one));
+            odd = _mm256_add_epi64(odd, _mm256_mul_epi32(_mm256_srli_epi64(mixed, 32), one));
+        }
+        const __m256i result{
+            _mm256_blend_epi32(RoundLanes<Q>(even, fractional_mask),
+                               _mm256_slli_epi64(RoundLanes<Q>(odd, fractional_mask), 32), 0xAA)};
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i), result);
+        gains = _mm256_add_epi32(gains, step);
+    }
+    return i;
+}
+#elif defined(ARCHITECTURE_arm64)
+/// Rounds 64-bit lanes like RoundToInt, narrowing them to 32-bit.
+template <size_t Q>
+int32x2_t RoundLanes(int64x2_t value, int64x2_t fractional_mask) {
+    value = vaddq_s64(value, vshrq_n_s64(vandq_s64(value, fractional_mask), 1));
+    return vshrn_n_s64(value, Q);
+}
+
+template <size_t Q, bool Accumulate>
+u32 ApplyNeon(s32* output, const s32* input, s64 gain, s64 ramp, u32 count) {
+    const int64x2_t fractional_mask{vdupq_n_s64((s64{1} << Q) - 1)};
+    const int32x4_t step{vdupq_n_s32(LaneStep(ramp, 4))};
+    const auto initial_gains{LaneGains<4>(gain, ramp)};
+    int32x4_t gains{vld1q_s32(initial_gains.data())};
+
+    u32 i{};
+    for (; i + 4 <= count; i += 4) {
+        const int32x4_t samples{vld1q_s32(input + i)};
+        int64x2_t low;
+        int64x2_t high;
+        if constexpr (Accumulate) {
+            const int32x4_t mixed{vld1q_s32(output + i)};
+            low = vmlal_s32(vshll_n_s32(vget_low_s32(mixed), Q), vget_low_s32(samples),
+                            vget_low_s32(gains));
+            high = vmlal_s32(vshll_n_s32(vget_high_s32(mixed), Q), vget_high_s32(samples),
+                             vget_high_s32(gains));
+        } else {
+            low = vmull_s32(vget_low_s32(samples), vget_low_s32(gains));
+            high = vmull_s32(vget_high_s32(samples), vget_high_s32(gains));
+        }
+        vst1q_s32(output + i, vcombine_s32(RoundLanes<Q>(low, fractional_mask),
+                                             RoundLanes<Q>(high, fractional_mask)));
+        gains = vaddq_s32(gains, step);
+    }
+    return i;
+}
+#endif
+
+template <size_t Q, bool Accumulate>
+void Apply(std::span<s32> output, std::span<const s32> input, s64 gain, s64 ramp,
+           u32 sample_count) {
+    if (sample_count == 0) {
+        return;
+    }
+    u32 processed{};
+    if (GainsFitLanes(gain, ramp, sample_count)) {
+#if defined(ARCHITECTURE_x86_64)
+        const auto& caps{Common::GetCPUCaps()};
+        if (caps.avx2) {
+            processed =
+                ApplyAvx2<Q, Accumulate>(output.data(), input.data(), gain, ramp, sample_count);
+        } else if (caps.sse4_1) {
+            processed =
+                ApplySse41<Q, Accumulate>(output.data(), input.data(), gain, ramp, sample_count);
+        }
+#elif defined(ARCHITECTURE_arm64)
+        processed = ApplyNeon<Q, Accumulate>(output.data(), input.data(), gain, ramp, sample_count);
+#endif
+    }
+    ApplyScalar<Q, Accumulate>(output.data(), input.data(), gain, ramp, processed, sample_count);
+}
+} // Anonymous namespace
+
+template <size_t Q>
+void MixSamples(std::span<s32> output, std::span<const s32> input, s64 gain, s64 ramp,
+                u32 sample_count) {
+    Apply<Q, true>(output, input, gain, ramp, sample_count);
+}
+
+template <size_t Q>
+void ScaleSamples(std::span<s32> output, std::span<const s32> input, s64 gain, s64 ramp,
+                  u32 sample_count) {
+    Apply<Q, false>(output, input, gain, ramp, sample_count);
+}
+
+template void MixSamples<15>(std::span<s32>, std::span<const s32>, s64, s64, u32);
+template void MixSamples<23>(std::span<s32>, std::span<const s32>, s64, s64, u32);
+template void ScaleSamples<15>(std::span<s32>, std::span<const s32>, s64, s64, u32);
+template void ScaleSamples<23>(std::span<s32>, std::span<const s32>, s64, s64, u32);
+
+} // namespace AudioCore::Renderer
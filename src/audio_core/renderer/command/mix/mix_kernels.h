@@ -0,0 +1,44 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <span>
+
+#include "common/common_types.h"
+
+namespace AudioCore::Renderer {
+
+/**
+ * Mix the input samples into the output samples, with a gain applied to the input.
+ * Results match Common::FixedPoint<64 - Q, Q> arithmetic exactly, using vector instructions
+ * when the host supports them.
+ *
+ * @tparam Q           - Number of bits for fixed point operations.
+ * @param output       - Output samples, the scaled input is added to them.
+ * @param input        - Input samples.
+ * @param gain         - Raw fixed point gain applied to the first sample.
+ * @param ramp         - Raw fixed point value added to the gain after every sample.
+ * @param sample_count - Number of samples to process.
+ */
+template <size_t Q>
+void MixSamples(std::span<s32> output, std::span<const s32> input, s64 gain, s64 ramp,
+                u32 sample_count);
+
+/**
+ * Scale the input samples by a gain, saving them to the output samples.
+ * Results match Common::FixedPoint<64 - Q, Q> arithmetic exactly, using vector instructions
+ * when the host supports them.
+ *
+ * @tparam Q           - Number of bits for fixed point operations.
+ * @param output       - Output samples, overwritten with the scaled input.
+ * @param input        - Input samples.
+ * @param gain         - Raw fixed point gain applied to the first sample.
+ * @param ramp         - Raw fixed point value added to the gain after every sample.
+ * @param sample_count - Number of samples to process.
+ */
+template <size_t Q>
+void ScaleSamples(std::span<s32> output, std::span<const s32> input, s64 gain, s64 ramp,
+                  u32 sample_count);
+
+} // namespace AudioCore::Renderer
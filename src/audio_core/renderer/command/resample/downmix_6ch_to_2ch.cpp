@@ -3,6 +3,7 @@
 
 #include "audio_core/adsp/apps/audio_renderer/command_list_processor.h"
 #include "audio_core/renderer/command/resample/downmix_6ch_to_2ch.h"
+#include "audio_core/renderer/command/resample/downmix_kernels.h"
 
 namespace AudioCore::Renderer {
 
@@ -46,20 +47,12 @@ void DownMix6chTo2chCommand::Process(const AudioRenderer::CommandListProcessor&
     auto out_back_right{
         processor.mix_buffers.subspan(outputs[5] * processor.sample_count, processor.sample_count)};
 
-    for (u32 i = 0; i < processor.sample_count; i++) {
-        const auto left_sample{(in_front_left[i] * down_mix_coeff[0] +
-                                in_center[i] * down_mix_coeff[1] + in_lfe[i] * down_mix_coeff[2] +
-                                in_back_left[i] * down_mix_coeff[3])
-                                   .to_int()};
-
-        const auto right_sample{(in_front_right[i] * down_mix_coeff[0] +
-                                 in_center[i] * down_mix_coeff[1] + in_lfe[i] * down_mix_coeff[2] +
-                                 in_back_right[i] * down_mix_coeff[3])
-                                    .to_int()};
-
-        out_front_left[i] = left_sample;
-        out_front_right[i] = right_sample;
-    }
+    DownMix6chTo2chSamples(out_front_left, out_front_right,
+                           {in_front_left, in_front_right, in_center, in_lfe, in_back_left,
+                            in_back_right},
+                           {down_mix_coeff[0].to_raw(), down_mix_coeff[1].to_raw(),
+                            down_mix_coeff[2].to_raw(), down_mix_coeff[3].to_raw()},
+                           processor.sample_count);
 
     std::memset(out_center.data(), 0, out_center.size_bytes());
     std::memset(out_lfe.data(), 0, out_lfe.size_bytes());
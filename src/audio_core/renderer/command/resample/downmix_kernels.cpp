@@ -0,0 +1,234 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <limits>
+
+#include "audio_core/renderer/command/resample/downmix_kernels.h"
+
+#if defined(ARCHITECTURE_x86_64)
+#include <immintrin.h>
+#include "common/x64/cpu_detect.h"
+#elif defined(ARCHITECTURE_arm64)
+#include <arm_neon.h>
+#endif
+
+#if defined(ARCHITECTURE_x86_64) && (defined(__GNUC__) || defined(__clang__))
+#define TARGET_SSE41 __attribute__((target("sse4.1")))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TARGET_SSE41
+#define TARGET_AVX2
+#endif
+
+namespace AudioCore::Renderer {
+namespace {
+constexpr size_t Q{16};
+
+/// Raw pointers to the channels of a frame
+struct Frame {
+    s32* left;
+    s32* right;
+    const s32* front_left;
+    const s32* front_right;
+    const s32* center;
+    const s32* lfe;
+    const s32* back_left;
+    const s32* back_right;
+};
+
+/// Matches Common::FixedPoint::to_int, including its rounding of the fractional part.
+s32 RoundToInt(s64 value) {
+    constexpr s64 fractional_mask{(s64{1} << Q) - 1};
+    value += (value & fractional_mask) >> 1;
+    return static_cast<s32>(value >> Q);
+}
+
+void DownMixScalar(const Frame& frame, const std::array<s64, 4>& coeffs, u32 first, u32 count) {
+    for (u32 i = first; i < count; i++) {
+        const s64 shared{frame.center[i] * coeffs[1] + frame.lfe[i] * coeffs[2]};
+        const s64 left{frame.front_left[i] * coeffs[0] + shared + frame.back_left[i] * coeffs[3]};
+        const s64 right{frame.front_right[i] * coeffs[0] + shared +
+                        frame.back_right[i] * coeffs[3]};
+        frame.left[i] = RoundToInt(left);
+        frame.right[i] = RoundToInt(right);
+    }
+}
+
+/// Vector kernels multiply 32-bit lanes, so every coefficient must fit in one.
+bool CoeffsFitLanes(const std::array<s64, 4>& coeffs) {
+    return std::ranges::all_of(coeffs, [](s64 coeff) {
+        return coeff >= std::numeric_limits<s32>::min() && coeff <= std::numeric_limits<s32>::max();
+    });
+}
+
+#if defined(ARCHITECTURE_x86_64)
+/// 64-bit products of the even lanes and of the odd lanes
+struct Products128 {
+    __m128i even;
+    __m128i odd;
+};
+
+struct Products256 {
+    __m256i even;
+    __m256i odd;
+};
+
+/// Rounds 64-bit lanes like RoundToInt, the results are in the low half of each lane.
+TARGET_SSE41 __m128i RoundLanes(__m128i value, __m128i fractional_mask) {
+    value = _mm_add_epi64(value, _mm_srli_epi64(_mm_and_si128(value, fractional_mask), 1));
+    return _mm_srli_epi64(value, Q);
+}
+
+TARGET_AVX2 __m256i RoundLanes(__m256i value, __m256i fractional_mask) {
+    value =
+        _mm256_add_epi64(value, _mm256_srli_epi64(_mm256_and_si256(value, fractional_mask), 1));
+    return _mm256_srli_epi64(value, Q);
+}
+
+TARGET_SSE41 Products128 Multiply(const s32* samples, __m128i coeff) {
+    const __m128i values{_mm_loadu_si128(reinterpret_cast<const __m128i*>(samples))};
+    return {_mm_mul_epi32(values, coeff), _mm_mul_epi32(_mm_srli_epi64(values, 32), coeff)};
+}
+
+TARGET_SSE41 Products128 Add(Products128 a, Products128 b) {
+    return {_mm_add_epi64(a.even, b.even), _mm_add_epi64(a.odd, b.odd)};
+}
+
+/// Rounds the products, packing the results back into 32-bit lanes.
+TARGET_SSE41 __m128i Round(Products128 value, __m128i fractional_mask) {
+    return _mm_blend_epi16(RoundLanes(value.even, fractional_mask),
+                           _mm_slli_epi64(RoundLanes(value.odd, fractional_mask), 32), 0xCC);
+}
+
+TARGET_AVX2 Products256 Multiply(const s32* samples, __m256i coeff) {
+    const __m256i values{_mm256_loadu_si256(reinterpret_cast<const __m256i*>(samples))};
+    return {_mm256_mul_epi32(values, coeff),
+            _mm256_mul_epi32(_mm256_srli_epi64(values, 32), coeff)};
+}
+
+TARGET_AVX2 Products256 Add(Products256 a, Products256 b) {
+    return {_mm256_add_epi64(a.even, b.even), _mm256_add_epi64(a.odd, b.odd)};
+}
+
+TARGET_AVX2 __m256i Round(Products256 value, __m256i fractional_mask) {
+    return _mm256_blend_epi32(RoundLanes(value.even, fractional_mask),
+                              _mm256_slli_epi64(RoundLanes(value.odd, fractional_mask), 32), 0xAA);
+}
+
+TARGET_SSE41 u32 DownMixSse41(const Frame& frame, const std::array<s64, 4>& coeffs, u32 count) {
+    const __m128i fractional_mask{_mm_set1_epi64x((s64{1} << Q) - 1)};
+    const __m128i front{_mm_set1_epi32(static_cast<s32>(coeffs[0]))};
+    const __m128i center{_mm_set1_epi32(static_cast<s32>(coeffs[1]))};
+    const __m128i lfe{_mm_set1_epi32(static_cast<s32>(coeffs[2]))};
+    const __m128i back{_mm_set1_epi32(static_cast<s32>(coeffs[3]))};
+
+    u32 i{};
+    for (; i + 4 <= count; i += 4) {
+        const auto shared{Add(Multiply(frame.center + i, center), Multiply(frame.lfe + i, lfe))};
+        const auto left{Add(Add(Multiply(frame.front_left + i, front), shared),
+                            Multiply(frame.back_left + i, back))};
+        const auto right{Add(Add(Multiply(frame.front_right + i, front), shared),
+                             Multiply(frame.back_right + i, back))};
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(frame.left + i), Round(left, fractional_mask));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(frame.right + i),
+                         Round(right, fractional_mask));
+    }
+    return i;
+}
+
+TARGET_AVX2 u32 DownMixAvx2(const Frame& frame, const std::array<s64, 4>& coeffs, u32 count) {
+    const __m256i fractional_mask{_mm256_set1_epi64x((s64{1} << Q) - 1)};
+    const __m256i front{_mm256_set1_epi32(static_cast<s32>(coeffs[0]))};
+    const __m256i center{_mm256_set1_epi32(static_cast<s32>(coeffs[1]))};
+    const __m256i lfe{_mm256_set1_epi32(static_cast<s32>(coeffs[2]))};
+    const __m256i back{_mm256_set1_epi32(static_cast<s32>(coeffs[3]))};
+
+    u32 i{};
+    for (; i + 8 <= count; i += 8) {
+        const auto shared{Add(Multiply(frame.center + i, center), Multiply(frame.lfe + i, lfe))};
+        const auto left{Add(Add(Multiply(frame.front_left + i, front), shared),
+                            Multiply(frame.back_left + i, back))};
+        const auto right{Add(Add(Multiply(frame.front_right + i, front), shared),
+                             Multiply(frame.back_right + i, back))};
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(frame.left + i),
+                            Round(left, fractional_mask));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(frame.right + i),
+                            Round(right, fractional_mask));
+    }
+    return i;
+}
+#elif defined(ARCHITECTURE_arm64)
+/// Rounds 64-bit lanes like RoundToInt, narrowing them to 32-bit.
+int32x2_t RoundLanes(int64x2_t value, int64x2_t fractional_mask) {
+    value = vaddq_s64(value, vshrq_n_s64(vandq_s64(value, fractional_mask), 1));
+    return vshrn_n_s64(value, Q);
+}
+
+u32 DownMixNeon(const Frame& frame, const std::array<s64, 4>& coeffs, u32 count) {
+    const int64x2_t fractional_mask{vdupq_n_s64((s64{1} << Q) - 1)};
+    const int32x2_t front{vdup_n_s32(static_cast<s32>(coeffs[0]))};
+    const int32x2_t center{vdup_n_s32(static_cast<s32>(coeffs[1]))};
+    const int32x2_t lfe{vdup_n_s32(static_cast<s32>(coeffs[2]))};
+    const int32x2_t back{vdup_n_s32(static_cast<s32>(coeffs[3]))};
+
+    // Mixes the four channels of a side, low then high half of the lanes
+    const auto mix = [&](int32x4_t side_front, int32x4_t side_back, int32x4_t center_samples,
+                         int32x4_t lfe_samples) {
+        int64x2_t low{vmull_s32(vget_low_s32(side_front), front)};
+        low = vmlal_s32(low, vget_low_s32(center_samples), center);
+        low = vmlal_s32(low, vget_low_s32(lfe_samples), lfe);
+        low = vmlal_s32(low, vget_low_s32(side_back), back);
+        int64x2_t high{vmull_s32(vget_high_s32(side_front), front)};
+        high = vmlal_s32(high, vget_high_s32(center_samples), center);
+        high = vmlal_s32(high, vget_high_s32(lfe_samples), lfe);
+        high = vmlal_s32(high, vget_high_s32(side_back), back);
+        return vcombine_s32(RoundLanes(low, fractional_mask), RoundLanes(high, fractional_mask));
+    };
+
+    u32 i{};
+    for (; i + 4 <= count; i += 4) {
+        const int32x4_t center_samples{vld1q_s32(frame.center + i)};
+        const int32x4_t lfe_samples{vld1q_s32(frame.lfe + i)};
+        const int32x4_t left{mix(vld1q_s32(frame.front_left + i), vld1q_s32(frame.back_left + i),
+                                 center_samples, lfe_samples)};
+        const int32x4_t right{mix(vld1q_s32(frame.front_right + i),
+                                  vld1q_s32(frame.back_right + i), center_samples, lfe_samples)};
+        vst1q_s32(frame.left + i, left);
+        vst1q_s32(frame.right + i, right);
+    }
+    return i;
+}
+#endif
+} // Anonymous namespace
+
+void DownMix6chTo2chSamples(std::span<s32> left, std::span<s32> right,
+                            const std::array<std::span<const s32>, 6>& inputs,
+                            const std::array<s64, 4>& coeffs, u32 sample_count) {
+    const Frame frame{
+        .left = left.data(),
+        .right = right.data(),
+        .front_left = inputs[0].data(),
+        .front_right = inputs[1].data(),
+        .center = inputs[2].data(),
+        .lfe = inputs[3].data(),
+        .back_left = inputs[4].data(),
+        .back_right = inputs[5].data(),
+    };
+    u32 processed{};
+    if (CoeffsFitLanes(coeffs)) {
+#if defined(ARCHITECTURE_x86_64)
+        const auto& caps{Common::GetCPUCaps()};
+        if (caps.avx2) {
+            processed = DownMixAvx2(frame, coeffs, sample_count);
+        } else if (caps.sse4_1) {
+            processed = DownMixSse41(frame, coeffs, sample_count);
+        }
+#elif defined(ARCHITECTURE_arm64)
+        processed = DownMixNeon(frame, coeffs, sample_count);
+#endif
+    }
+    DownMixScalar(frame, coeffs, processed, sample_count);
+}
+
+} // namespace AudioCore::Renderer
@@ -0,0 +1,30 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <span>
+
+#include "common/common_types.h"
+
+namespace AudioCore::Renderer {
+
+/**
+ * Downmix 6 channels to 2, processing every channel of a frame together.
+ * Results match Common::FixedPoint<48, 16> arithmetic exactly, using vector instructions when the
+ * host supports them.
+ *
+ * @param left         - Output left samples, may be any of the inputs.
+ * @param right        - Output right samples, may be any of the inputs.
+ * @param inputs       - Input samples for each channel, in SMPTE order
+ *                       (front left, front right, center, lfe, back left, back right).
+ * @param coeffs       - Raw fixed point coefficients applied to the front, center, lfe and back
+ *                       channels.
+ * @param sample_count - Number of samples to process.
+ */
+void DownMix6chTo2chSamples(std::span<s32> left, std::span<s32> right,
+                            const std::array<std::span<const s32>, 6>& inputs,
+                            const std::array<s64, 4>& coeffs, u32 sample_count);
+
+} // namespace AudioCore::Renderer
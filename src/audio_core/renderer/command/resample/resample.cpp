@@ -1,10 +1,175 @@
 // SPDX-FileCopyrightText: Copyright 2022 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <array>
+
 #include "audio_core/renderer/command/resample/resample.h"
 
+#if defined(ARCHITECTURE_x86_64)
+#include <immintrin.h>
+#include "common/x64/cpu_detect.h"
+#elif defined(ARCHITECTURE_arm64)
+#include <arm_neon.h>
+#endif
+
+#if defined(ARCHITECTURE_x86_64) && (defined(__GNUC__) || defined(__clang__))
+#define TARGET_SSE41 __attribute__((target("sse4.1")))
+#else
+#define TARGET_SSE41
+#endif
+
 namespace AudioCore::Renderer {
 
+/// Number of output frames the vector filters compute per iteration.
+constexpr u32 FramesPerIteration{4};
+
+/**
+ * Advance the read fraction by one output frame.
+ *
+ * @return Number of input samples to advance the read index by.
+ */
+static u32 AdvanceFraction(const Common::FixedPoint<49, 15>& sample_rate_ratio,
+                           Common::FixedPoint<49, 15>& fraction) {
+    fraction += sample_rate_ratio;
+    const auto advance{static_cast<u32>(fraction.to_int_floor())};
+    fraction.clear_int();
+    return advance;
+}
+
+/**
+ * Filter one output frame. Each tap is converted to FixedPoint<56, 8> before summing them, the
+ * vector filters truncate their float products into 24.8 integers in the same way.
+ *
+ * @tparam Taps   - Number of filter taps.
+ * @param samples - Input samples, starting at the first tap.
+ * @param coeffs  - Filter coefficients for the current fraction.
+ * @return The filtered output frame.
+ */
+template <size_t Taps>
+static s32 FilterFrame(const s16* samples, const f32* coeffs) {
+    Common::FixedPoint<56, 8> sum{0};
+    for (size_t tap = 0; tap < Taps; tap++) {
+        const Common::FixedPoint<56, 8> sample{samples[tap] * coeffs[tap]};
+        sum += sample;
+    }
+    return sum.to_int_floor();
+}
+
+#if defined(ARCHITECTURE_x86_64)
+TARGET_SSE41 static __m128i ScaleTapsSse41(__m128i samples, const f32* coeffs) {
+    const __m128 products{_mm_mul_ps(_mm_cvtepi32_ps(samples), _mm_loadu_ps(coeffs))};
+    return _mm_cvttps_epi32(_mm_mul_ps(products, _mm_set1_ps(256.0f)));
+}
+
+/// Returns the taps of one output frame, summed into 4 lanes.
+template <size_t Taps>
+TARGET_SSE41 static __m128i FilterTapsSse41(const s16* samples, const f32* coeffs) {
+    if constexpr (Taps == 4) {
+        const __m128i input{_mm_loadl_epi64(reinterpret_cast<const __m128i*>(samples))};
+        return ScaleTapsSse41(_mm_cvtepi16_epi32(input), coeffs);
+    } else {
+        const __m128i input{_mm_loadu_si128(reinterpret_cast<const __m128i*>(samples))};
+        const __m128i low{ScaleTapsSse41(_mm_cvtepi16_epi32(input), coeffs)};
+        const __m128i high_input{_mm_cvtepi16_epi32(_mm_srli_si128(input, 8))};
+        const __m128i high{ScaleTapsSse41(high_input, coeffs + 4)};
+        return _mm_add_epi32(low, high);
+    }
+}
+
+template <size_t Taps>
+TARGET_SSE41 static u32 ResampleFilterSse41(s32* output, const s16* input,
+                                            const Common::FixedPoint<49, 15>& sample_rate_ratio,
+                                            Common::FixedPoint<49, 15>& fraction, u32& read_index,
+                                            const u32 samples_to_write, const f32* lut) {
+    u32 i{0};
+    for (; i + FramesPerIteration <= samples_to_write; i += FramesPerIteration) {
+        __m128i taps[FramesPerIteration];
+        for (__m128i& frame_taps : taps) {
+            const auto lut_index{(fraction.get_frac() >> 8) * Taps};
+            frame_taps = FilterTapsSse41<Taps>(input + read_index, lut + lut_index);
+            read_index += AdvanceFraction(sample_rate_ratio, fraction);
+        }
+        const __m128i sums{_mm_hadd_epi32(_mm_hadd_epi32(taps[0], taps[1]),
+                                          _mm_hadd_epi32(taps[2], taps[3]))};
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), _mm_srai_epi32(sums, 8));
+    }
+    return i;
+}
+#elif defined(ARCHITECTURE_arm64)
+static int32x4_t ScaleTapsNeon(int32x4_t samples, const f32* coeffs) {
+    const float32x4_t products{vmulq_f32(vcvtq_f32_s32(samples), vld1q_f32(coeffs))};
+    return vcvtq_s32_f32(vmulq_n_f32(products, 256.0f));
+}
+
+/// Returns the taps of one output frame, summed into 4 lanes.
+template <size_t Taps>
+static int32x4_t FilterTapsNeon(const s16* samples, const f32* coeffs) {
+    if constexpr (Taps == 4) {
+        return ScaleTapsNeon(vmovl_s16(vld1_s16(samples)), coeffs);
+    } else {
+        const int16x8_t input{vld1q_s16(samples)};
+        const int32x4_t low{ScaleTapsNeon(vmovl_s16(vget_low_s16(input)), coeffs)};
+        const int32x4_t high{ScaleTapsNeon(vmovl_s16(vget_high_s16(input)), coeffs + 4)};
+        return vaddq_s32(low, high);
+    }
+}
+
+template <size_t Taps>
+static u32 ResampleFilterNeon(s32* output, const s16* input,
+                              const Common::FixedPoint<49, 15>& sample_rate_ratio,
+                              Common::FixedPoint<49, 15>& fraction, u32& read_index,
+                              const u32 samples_to_write, const f32* lut) {
+    u32 i{0};
+    for (; i + FramesPerIteration <= samples_to_write; i += FramesPerIteration) {
+        int32x4_t taps[FramesPerIteration];
+        for (int32x4_t& frame_taps : taps) {
+            const auto lut_index{(fraction.get_frac() >> 8) * Taps};
+            frame_taps = FilterTapsNeon<Taps>(input + read_index, lut + lut_index);
+            read_index += AdvanceFraction(sample_rate_ratio, fraction);
+        }
+        const int32x4_t sums{
+            vpaddq_s32(vpaddq_s32(taps[0], taps[1]), vpaddq_s32(taps[2], taps[3]))};
+        vst1q_s32(output + i, vshrq_n_s32(sums, 8));
+    }
+    return i;
+}
+#endif
+
+/**
+ * Resample with a polyphase filter, using the coefficients of the phase closest to the current
+ * read fraction for every output frame.
+ *
+ * @tparam Taps             - Number of filter taps.
+ * @param output            - Output buffer.
+ * @param input             - Input buffer.
+ * @param sample_rate_ratio - Ratio for resampling.
+ * @param fraction          - Current read fraction.
+ * @param samples_to_write  - Number of samples to write.
+ * @param lut               - Filter coefficients, Taps for each of the 128 phases.
+ */
+template <size_t Taps>
+static void ResampleFilter(std::span<s32> output, std::span<const s16> input,
+                           const Common::FixedPoint<49, 15>& sample_rate_ratio,
+                           Common::FixedPoint<49, 15>& fraction, const u32 samples_to_write,
+                           std::span<const f32> lut) {
+    u32 read_index{0};
+    u32 i{0};
+#if defined(ARCHITECTURE_x86_64)
+    if (Common::GetCPUCaps().sse4_1) {
+        i = ResampleFilterSse41<Taps>(output.data(), input.data(), sample_rate_ratio, fraction,
+                                      read_index, samples_to_write, lut.data());
+    }
+#elif defined(ARCHITECTURE_arm64)
+    i = ResampleFilterNeon<Taps>(output.data(), input.data(), sample_rate_ratio, fraction,
+                                 read_index, samples_to_write, lut.data());
+#endif
+    for (; i < samples_to_write; i++) {
+        const auto lut_index{(fraction.get_frac() >> 8) * Taps};
+        output[i] = FilterFrame<Taps>(&input[read_index], &lut[lut_index]);
+        read_index += AdvanceFraction(sample_rate_ratio, fraction);
+    }
+}
+
 static void ResampleLowQuality(std::span<s32> output, std::span<const s16> input,
                                const Common::FixedPoint<49, 15>& sample_rate_ratio,
                                Common::FixedPoint<49, 15>& fraction, const u32 samples_to_write) {
@@ -292,19 +457,7 @@ static void ResampleNormalQuality(std::span<s32> output, std::span<const s16> in
         }
     };
 
-    auto lut{get_lut()};
-    u32 read_index{0};
-    for (u32 i = 0; i < samples_to_write; i++) {
-        const auto lut_index{(fraction.get_frac() >> 8) * 4};
-        const Common::FixedPoint<56, 8> sample0{input[read_index + 0] * lut[lut_index + 0]};
-        const Common::FixedPoint<56, 8> sample1{input[read_index + 1] * lut[lut_index + 1]};
-        const Common::FixedPoint<56, 8> sample2{input[read_index + 2] * lut[lut_index + 2]};
-        const Common::FixedPoint<56, 8> sample3{input[read_index + 3] * lut[lut_index + 3]};
-        output[i] = (sample0 + sample1 + sample2 + sample3).to_int_floor();
-        fraction += sample_rate_ratio;
-        read_index += static_cast<u32>(fraction.to_int_floor());
-        fraction.clear_int();
-    }
+    ResampleFilter<4>(output, input, sample_rate_ratio, fraction, samples_to_write, get_lut());
 }
 
 static void ResampleHighQuality(std::span<s32> output, std::span<const s16> input,
@@ -842,24 +995,7 @@ static void ResampleHighQuality(std::span<s32> output, std::span<const s16> inpu
         }
     };
 
-    auto lut{get_lut()};
-    u32 read_index{0};
-    for (u32 i = 0; i < samples_to_write; i++) {
-        const auto lut_index{(fraction.get_frac() >> 8) * 8};
-        const Common::FixedPoint<56, 8> sample0{input[read_index + 0] * lut[lut_index + 0]};
-        const Common::FixedPoint<56, 8> sample1{input[read_index + 1] * lut[lut_index + 1]};
-        const Common::FixedPoint<56, 8> sample2{input[read_index + 2] * lut[lut_index + 2]};
-        const Common::FixedPoint<56, 8> sample3{input[read_index + 3] * lut[lut_index + 3]};
-        const Common::FixedPoint<56, 8> sample4{input[read_index + 4] * lut[lut_index + 4]};
-        const Common::FixedPoint<56, 8> sample5{input[read_index + 5] * lut[lut_index + 5]};
-        const Common::FixedPoint<56, 8> sample6{input[read_index + 6] * lut[lut_index + 6]};
-        const Common::FixedPoint<56, 8> sample7{input[read_index + 7] * lut[lut_index + 7]};
-        output[i] = (sample0 + sample1 + sample2 + sample3 + sample4 + sample5 + sample6 + sample7)
-                        .to_int_floor();
-        fraction += sample_rate_ratio;
-        read_index += static_cast<u32>(fraction.to_int_floor());
-        fraction.clear_int();
-    }
+    ResampleFilter<8>(output, input, sample_rate_ratio, fraction, samples_to_write, get_lut());
 }
 
 void Resample(std::span<s32> output, std::span<const s16> input,
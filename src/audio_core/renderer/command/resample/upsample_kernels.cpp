@@ -0,0 +1,260 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+
+#include "audio_core/renderer/command/resample/upsample_kernels.h"
+#include "common/fixed_point.h"
+
+#if defined(ARCHITECTURE_x86_64)
+#include <immintrin.h>
+#include "common/x64/cpu_detect.h"
+#elif defined(ARCHITECTURE_arm64)
+#include <arm_neon.h>
+#endif
+
+#if defined(ARCHITECTURE_x86_64) && (defined(__GNUC__) || defined(__clang__))
+#define TARGET_SSE41 __attribute__((target("sse4.1")))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TARGET_SSE41
+#define TARGET_AVX2
+#endif
+
+namespace AudioCore::Renderer {
+namespace {
+constexpr size_t HistorySize{UpsamplerState::HistorySize};
+constexpr size_t HalfWindow{HistorySize / 2};
+
+using Sinc = std::array<Common::FixedPoint<17, 15>, HalfWindow>;
+
+constexpr Sinc WindowedSinc1{
+    0.95376587f,   -0.12872314f, 0.060028076f,  -0.032470703f, 0.017669678f,
+    -0.009124756f, 0.004272461f, -0.001739502f, 0.000579834f,  -0.000091552734f,
+};
+constexpr Sinc WindowedSinc2{
+    0.8230896f,    -0.19161987f,  0.093444824f,  -0.05090332f,   0.027557373f,
+    -0.014038086f, 0.0064697266f, -0.002532959f, 0.00079345703f, -0.00012207031f,
+};
+constexpr Sinc WindowedSinc3{
+    0.6298828f,    -0.19274902f, 0.09725952f,    -0.05319214f,  0.028625488f,
+    -0.014373779f, 0.006500244f, -0.0024719238f, 0.0007324219f, -0.000091552734f,
+};
+constexpr Sinc WindowedSinc4{
+    0.4057312f,    -0.1468811f,  0.07601929f,    -0.041656494f,  0.022216797f,
+    -0.011016846f, 0.004852295f, -0.0017700195f, 0.00048828125f, -0.000030517578f,
+};
+constexpr Sinc WindowedSinc5{
+    0.1854248f,    -0.075164795f, 0.03967285f,    -0.021728516f,  0.011474609f,
+    -0.005584717f, 0.0024108887f, -0.0008239746f, 0.00021362305f, 0.0f,
+};
+
+/// Raw coefficients applied to the whole history, oldest sample first
+using Window = std::array<s32, HistorySize>;
+
+/**
+ * Lay out a pair of sincs over the history. The first is applied to the older half, backwards
+ * from the middle sample, and the second to the newer half.
+ */
+constexpr Window MakeWindow(const Sinc& older, const Sinc& newer) {
+    Window window{};
+    for (size_t i = 0; i < HalfWindow; i++) {
+        window[i] = older[HalfWindow - 1 - i].to_raw();
+        window[HalfWindow + i] = newer[i].to_raw();
+    }
+    return window;
+}
+
+constexpr Window Window15{MakeWindow(WindowedSinc1, WindowedSinc5)};
+constexpr Window Window24{MakeWindow(WindowedSinc2, WindowedSinc4)};
+constexpr Window Window33{MakeWindow(WindowedSinc3, WindowedSinc3)};
+constexpr Window Window42{MakeWindow(WindowedSinc4, WindowedSinc2)};
+constexpr Window Window51{MakeWindow(WindowedSinc5, WindowedSinc1)};
+
+/// Products are summed with 64-bit wrapping, like the circular history implementation.
+s64 DotScalar(const s32* samples, const s32* window) {
+    u64 result{};
+    for (size_t i = 0; i < HistorySize; i++) {
+        result += static_cast<u64>(static_cast<s64>(samples[i]) * window[i]);
+    }
+    return static_cast<s64>(result);
+}
+
+#if defined(ARCHITECTURE_x86_64)
+TARGET_SSE41 __m128i DotLanes(__m128i sum, const s32* samples, const s32* window) {
+    const __m128i a{_mm_loadu_si128(reinterpret_cast<const __m128i*>(samples))};
+    const __m128i b{_mm_loadu_si128(reinterpret_cast<const __m128i*>(window))};
+    sum = _mm_add_epi64(sum, _mm_mul_epi32(a, b));
+    return _mm_add_epi64(sum, _mm_mul_epi32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32)));
+}
+
+TARGET_SSE41 s64 SumLanes(__m128i sum) {
+    return static_cast<s64>(static_cast<u64>(_mm_extract_epi64(sum, 0)) +
+                            static_cast<u64>(_mm_extract_epi64(sum, 1)));
+}
+
+TARGET_SSE41 s64 DotSse41(const s32* samples, const s32* window) {
+    __m128i sum{_mm_setzero_si128()};
+    for (size_t i = 0; i < HistorySize; i += 4) {
+        sum = DotLanes(sum, samples + i, window + i);
+    }
+    return SumLanes(sum);
+}
+
+TARGET_AVX2 s64 DotAvx2(const s32* samples, const s32* window) {
+    __m256i wide_sum{_mm256_setzero_si256()};
+    size_t i{};
+    for (; i + 8 <= HistorySize; i += 8) {
+        const __m256i a{_mm256_loadu_si256(reinterpret_cast<const __m256i*>(samples + i))};
+        const __m256i b{_mm256_loadu_si256(reinterpret_cast<const __m256i*>(window + i))};
+        wide_sum = _mm256_add_epi64(wide_sum, _mm256_mul_epi32(a, b));
+        wide_sum = _mm256_add_epi64(
+            wide_sum, _mm256_mul_epi32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32)));
+    }
+    __m128i sum{_mm_add_epi64(_mm256_castsi256_si128(wide_sum),
+                              _mm256_extracti128_si256(wide_sum, 1))};
+    for (; i < HistorySize; i += 4) {
+        sum = DotLanes(sum, samples + i, window + i);
+    }
+    return SumLanes(sum);
+}
+#elif defined(ARCHITECTURE_arm64)
+s64 DotNeon(const s32* samples, const s32* window) {
+    int64x2_t sum{vdupq_n_s64(0)};
+    for (size_t i = 0; i < HistorySize; i += 4) {
+        const int32x4_t a{vld1q_s32(samples + i)};
+        const int32x4_t b{vld1q_s32(window + i)};
+        sum = vmlal_s32(sum, vget_low_s32(a), vget_low_s32(b));
+        sum = vmlal_high_s32(sum, a, b);
+    }
+    return vaddvq_s64(sum);
+}
+#endif
+
+template <s64 (*Dot)(const s32*, const s32*)>
+void Upsample(std::span<s32> output, std::span<const s32> input, u32 target_sample_count,
+              UpsamplerState& state) {
+    // Unroll the circular history, oldest sample first, new samples are appended to it
+    constexpr size_t Capacity{256};
+    std::array<s32, HistorySize + Capacity> samples;
+    for (size_t i = 0; i < HistorySize; i++) {
+        samples[i] = state.history[(state.history_input_index + i) % HistorySize].to_raw();
+    }
+    size_t end{HistorySize};
+    u32 read_index{0};
+
+    const auto increment = [&] {
+        if (end == samples.size()) {
+            std::copy(samples.end() - (HistorySize - 1), samples.end(), samples.begin());
+            end = HistorySize - 1;
+        }
+        samples[end++] = Common::FixedPoint<24, 8>(input[read_index++]).to_raw();
+    };
+    // The sample in the middle of the history is played as is
+    const auto middle = [&] { return samples[end - HalfWindow - 1] >> 8; };
+    const auto interpolate = [&](const Window& window) {
+        return static_cast<s32>(Dot(&samples[end - HistorySize], window.data()) >> (8 + 15));
+    };
+
+    switch (state.ratio.to_int_floor()) {
+    // 40 -> 240
+    case 6:
+        for (u32 write_index = 0; write_index < target_sample_count; write_index++) {
+            switch (state.sample_index) {
+            case 0:
+                increment();
+                output[write_index] = middle();
+                break;
+            case 1:
+                output[write_index] = interpolate(Window15);
+                break;
+            case 2:
+                output[write_index] = interpolate(Window24);
+                break;
+            case 3:
+                output[write_index] = interpolate(Window33);
+                break;
+            case 4:
+                output[write_index] = interpolate(Window42);
+                break;
+            case 5:
+                output[write_index] = interpolate(Window51);
+                break;
+            }
+            state.sample_index = static_cast<u8>((state.sample_index + 1) % 6);
+        }
+        break;
+
+    // 80 -> 240
+    case 3:
+        for (u32 write_index = 0; write_index < target_sample_count; write_index++) {
+            switch (state.sample_index) {
+            case 0:
+                increment();
+                output[write_index] = middle();
+                break;
+            case 1:
+                output[write_index] = interpolate(Window24);
+                break;
+            case 2:
+                output[write_index] = interpolate(Window42);
+                break;
+            }
+            state.sample_index = static_cast<u8>((state.sample_index + 1) % 3);
+        }
+        break;
+
+    // 160 -> 240
+    default:
+        for (u32 write_index = 0; write_index < target_sample_count; write_index++) {
+            switch (state.sample_index) {
+            case 0:
+                increment();
+                output[write_index] = middle();
+                break;
+            case 1:
+                output[write_index] = interpolate(Window42);
+                break;
+            case 2:
+                increment();
+                output[write_index] = interpolate(Window24);
+                break;
+            }
+            state.sample_index = static_cast<u8>((state.sample_index + 1) % 3);
+        }
+        break;
+    }
+
+    // Roll the newest samples back into the circular history
+    const auto input_index{
+        static_cast<u16>((state.history_input_index + read_index) % HistorySize)};
+    for (size_t i = 0; i < HistorySize; i++) {
+        state.history[(input_index + i) % HistorySize] =
+            Common::FixedPoint<24, 8>::from_base(samples[end - HistorySize + i]);
+    }
+    state.history_input_index = input_index;
+    state.history_output_index =
+        static_cast<u16>((state.history_output_index + read_index) % HistorySize);
+}
+} // Anonymous namespace
+
+void UpsampleSamples(std::span<s32> output, std::span<const s32> input, u32 target_sample_count,
+                     UpsamplerState& state) {
+#if defined(ARCHITECTURE_x86_64)
+    const auto& caps{Common::GetCPUCaps()};
+    if (caps.avx2) {
+        Upsample<DotAvx2>(output, input, target_sample_count, state);
+    } else if (caps.sse4_1) {
+        Upsample<DotSse41>(output, input, target_sample_count, state);
+    } else {
+        Upsample<DotScalar>(output, input, target_sample_count, state);
+    }
+#elif defined(ARCHITECTURE_arm64)
+    Upsample<DotNeon>(output, input, target_sample_count, state);
+#else
+    Upsample<DotScalar>(output, input, target_sample_count, state);
+#endif
+}
+
+} // namespace AudioCore::Renderer
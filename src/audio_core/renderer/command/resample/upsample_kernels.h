@@ -0,0 +1,27 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <span>
+
+#include "audio_core/renderer/upsampler/upsampler_state.h"
+#include "common/common_types.h"
+
+namespace AudioCore::Renderer {
+
+/**
+ * Upsample the samples of a channel to 48K, continuing from the state's history.
+ * The history is unrolled so each windowed sinc is a dot product over contiguous samples, done
+ * across vector lanes when the host supports them. Results match the per-sample processing of
+ * the circular history exactly.
+ *
+ * @param output              - Output buffer, receives target_sample_count samples.
+ * @param input               - Input buffer, samples are read from it as the ratio requires.
+ * @param target_sample_count - Number of samples for output.
+ * @param state               - Initialized upsampler state, updated each call.
+ */
+void UpsampleSamples(std::span<s32> output, std::span<const s32> input, u32 target_sample_count,
+                     UpsamplerState& state);
+
+} // namespace AudioCore::Renderer
@@ -3,7 +3,9 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <span>
 #include <vector>
 
 #include "audio_core/common/common.h"
@@ -114,6 +116,144 @@ public:
             return *out;
         }
 
+        /**
+         * Read a tap for each of the next samples, as TapOut would while they are written one by
+         * one with Write, leaving the delay line unchanged.
+         *
+         * @param index       - Tap index, as given to TapOut.
+         * @param pending     - The next samples to be written.
+         * @param after_write - If true, each tap is read after writing its sample, else before.
+         * @param out         - Receives a tap for each pending sample.
+         */
+        void TapOutBlock(const s32 index, std::span<const Common::FixedPoint<50, 14>> pending,
+                         const bool after_write,
+                         std::span<Common::FixedPoint<50, 14>> out) const {
+            const auto count{static_cast<s32>(out.size())};
+            const auto size{static_cast<s32>(buffer_end - buffer.data())};
+            const auto start{static_cast<s32>(input - buffer.data())};
+            if (start + count + (after_write ? 1 : 0) <= size) {
+                // Without the input wrapping around, the taps are contiguous runs. Those before
+                // the start wrap around the buffer, and those past it read the pending samples.
+                const s32 distance{index + 1 - (after_write ? 1 : 0)};
+                const s32 wrapped{std::clamp(distance - start, 0, count)};
+                const s32 wrapped_offset{sample_count - distance};
+                if (wrapped_offset >= 0 && wrapped_offset < (after_write ? 1 : 0)) {
+                    std::copy_n(pending.begin() + wrapped_offset, wrapped, out.begin());
+                } else {
+                    std::copy_n(&buffer[start + wrapped_offset], wrapped, out.begin());
+                }
+                const s32 buffered{std::clamp(distance, wrapped, count)};
+                std::copy_n(&buffer[start - distance + wrapped], buffered - wrapped,
+                            out.begin() + wrapped);
+                std::copy_n(pending.begin() + (buffered - distance), count - buffered,
+                            out.begin() + buffered);
+                return;
+            }
+
+            const auto next = [size](s32 position) {
+                return position + 1 >= size ? 0 : position + 1;
+            };
+            for (s32 i = 0; i < count; i++) {
+                const s32 written{i + (after_write ? 1 : 0)};
+                s32 position{start};
+                for (s32 sample = 0; sample < written; sample++) {
+                    position = next(position);
+                }
+                s32 tap{position - (index + 1)};
+                if (tap < 0) {
+                    tap += sample_count;
+                }
+
+                // The latest pending sample written over the tap replaces the buffered one
+                out[i] = buffer[tap];
+                position = start;
+                for (s32 sample = 0; sample < written; sample++) {
+                    if (position == tap) {
+                        out[i] = pending[sample];
+                    }
+                    position = next(position);
+                }
+            }
+        }
+
+        /**
+         * Check if the outputs of the next Ticks were all written before them, so they can be
+         * read ahead with ReadBlock.
+         *
+         * @param count - Number of Ticks to read ahead.
+         * @return True if the next count outputs can be read ahead.
+         */
+        bool CanReadAhead(const s32 count) const {
+            // Updates can move the end before the input or output, they wrap after their next
+            // access
+            if (input >= buffer_end || output >= buffer_end) {
+                return false;
+            }
+            const auto size{static_cast<s32>(buffer_end - buffer.data())};
+            auto distance{static_cast<s32>(input - output)};
+            if (distance < 0) {
+                distance += size;
+            }
+            return count <= size && (distance == 0 || distance >= count);
+        }
+
+        /**
+         * Read the outputs of the next Ticks ahead, leaving the delay line unchanged.
+         * See CanReadAhead.
+         *
+         * @param out - Receives the outputs of the next Ticks.
+         */
+        void ReadBlock(std::span<Common::FixedPoint<50, 14>> out) const {
+            const auto size{static_cast<s32>(buffer_end - buffer.data())};
+            const auto start{static_cast<s32>(output - buffer.data())};
+            const auto count{static_cast<s32>(out.size())};
+            if (start < size) {
+                const s32 contiguous{std::min(count, size - start)};
+                std::copy_n(output, contiguous, out.begin());
+                std::copy_n(buffer.data(), count - contiguous, out.begin() + contiguous);
+                return;
+            }
+            out[0] = *output;
+            std::copy_n(buffer.data(), count - 1, out.begin() + 1);
+        }
+
+        void TickBlock(std::span<const Common::FixedPoint<50, 14>> samples) {
+            const auto size{static_cast<s32>(buffer_end - buffer.data())};
+            const auto count{static_cast<s32>(samples.size())};
+            if (output >= buffer_end || count > size) {
+                for (const auto sample : samples) {
+                    Tick(sample);
+                }
+                return;
+            }
+            auto position{static_cast<s32>(output - buffer.data()) + count};
+            if (position >= size) {
+                position -= size;
+            }
+            output = &buffer[position];
+            WriteBlock(samples);
+        }
+
+        void WriteBlock(std::span<const Common::FixedPoint<50, 14>> samples) {
+            const auto size{static_cast<s32>(buffer_end - buffer.data())};
+            const auto count{static_cast<s32>(samples.size())};
+            if (input >= buffer_end || count > size) {
+                for (const auto sample : samples) {
+                    Write(sample);
+                }
+                return;
+            }
+            const auto start{static_cast<s32>(input - buffer.data())};
+            const s32 contiguous{std::min(count, size - start)};
+            std::copy_n(samples.begin(), contiguous, input);
+            std::copy_n(samples.begin() + contiguous, count - contiguous, buffer.data());
+            auto position{start + count};
+            if (position >= size) {
+                position -= size;
+            }
+            input = &buffer[position];
+        }
+
         s32 sample_count{};
         s32 sample_count_max{};
         std::vector<Common::FixedPoint<50, 14>> buffer{};
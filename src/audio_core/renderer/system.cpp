@@ -29,6 +29,7 @@
 #include "audio_core/renderer/voice/voice_info.h"
 #include "audio_core/renderer/voice/voice_state.h"
 #include "common/alignment.h"
+#include "common/settings.h"
 #include "core/core.h"
 #include "core/core_timing.h"
 #include "core/hle/kernel/k_event.h"
@@ -393,6 +394,10 @@ Result System::Initialize(const AudioRendererParameterInternal& params,
             std::make_unique<CommandProcessingTimeEstimatorVersion1>(sample_count,
                                                                      mix_buffer_count);
     }
+    if (Settings::values.audio_host_timing.GetValue()) {
+        command_processing_time_estimator = std::make_unique<CommandProcessingTimeEstimatorHost>(
+            std::move(command_processing_time_estimator));
+    }
 
     initialized = true;
     return ResultSuccess;
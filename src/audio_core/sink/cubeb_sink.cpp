@@ -9,6 +9,7 @@
 #include "audio_core/sink/sink_stream.h"
 #include "common/logging/log.h"
 #include "common/scope_exit.h"
+#include "common/settings.h"
 #include "core/core.h"
 
 #ifdef _WIN32
@@ -70,7 +71,11 @@ public:
             minimum_latency = TargetSampleCount * 2;
         }
 
-        minimum_latency = std::max(minimum_latency, TargetSampleCount * 2);
+        // The low latency mode takes whatever the device supports, the sink stream adapts its
+        // queue to the device's timing instead
+        if (!Settings::values.audio_low_latency) {
+            minimum_latency = std::max(minimum_latency, TargetSampleCount * 2);
+        }
 
         LOG_INFO(Service_Audio,
                  "Opening cubeb stream {} type {} with: rate {} channels {} (system channels {}) "
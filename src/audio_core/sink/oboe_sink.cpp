@@ -11,6 +11,7 @@
 #include "audio_core/sink/sink_stream.h"
 #include "common/logging/log.h"
 #include "common/scope_exit.h"
+#include "common/settings.h"
 #include "core/core.h"
 
 namespace AudioCore::Sink {
@@ -163,7 +164,8 @@ private:
     bool SetStreamProperties() {
         ASSERT(m_stream);
 
-        m_stream->setBufferSizeInFrames(TargetSampleCount * 2);
+        m_stream->setBufferSizeInFrames(
+            Settings::values.audio_low_latency ? TargetSampleCount : TargetSampleCount * 2);
         device_channels = m_stream->getChannelCount();
 
         const auto sample_rate = m_stream->getSampleRate();
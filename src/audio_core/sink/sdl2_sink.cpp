@@ -10,6 +10,7 @@
 #include "audio_core/sink/sink_stream.h"
 #include "common/logging/log.h"
 #include "common/scope_exit.h"
+#include "common/settings.h"
 #include "core/core.h"
 
 namespace AudioCore::Sink {
@@ -39,7 +40,9 @@ public:
         spec.freq = TargetSampleRate;
         spec.channels = static_cast<u8>(device_channels);
         spec.format = AUDIO_S16SYS;
-        spec.samples = TargetSampleCount * 2;
+        spec.samples =
+            static_cast<u16>(Settings::values.audio_low_latency ? TargetSampleCount
+                                                                : TargetSampleCount * 2);
         spec.callback = &SDLSinkStream::DataCallback;
         spec.userdata = this;
 
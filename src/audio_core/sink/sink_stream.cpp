@@ -16,10 +16,35 @@
 #include "common/settings.h"
 #include "core/core.h"
 #include "core/core_timing.h"
+#include "core/perf_stats.h"
 
 namespace AudioCore::Sink {
+namespace {
+/// Duration of one buffer of the audio render/out systems
+constexpr std::chrono::nanoseconds BufferDuration{
+    std::chrono::nanoseconds{std::chrono::seconds{TargetSampleCount}} / TargetSampleRate};
+/// Frames played without underruns before the low latency mode tries a smaller queue
+constexpr u64 QueueShrinkFrames{TargetSampleRate};
+/// Range of the time stretch ratio
+constexpr f64 MinTimeStretchRatio{0.5};
+constexpr f64 MaxTimeStretchRatio{4.0};
+/// Weight of the latest emulation speed measurement in the time stretch ratio
+constexpr f64 TimeStretchSmoothing{0.1};
+/// Distance of the time stretch ratio from 1 at which stretching starts, and stops
+constexpr f64 TimeStretchStartThreshold{0.1};
+constexpr f64 TimeStretchStopThreshold{0.03};
+
+/// Frames of a buffer's appended samples played, which differ from its frames when time stretched
+u64 SourceFramesPlayed(const SinkBuffer& buffer) {
+    if (buffer.consumed) {
+        return buffer.source_frames;
+    }
+    return buffer.frames == 0 ? 0 : buffer.source_frames * buffer.frames_played / buffer.frames;
+}
+} // Anonymous namespace
 
 void SinkStream::AppendBuffer(SinkBuffer& buffer, std::span<s16> samples) {
+    buffer.source_frames = buffer.frames;
     SCOPE_EXIT {
         queue.enqueue(buffer);
         ++queued_buffers;
@@ -77,7 +102,8 @@ void SinkStream::AppendBuffer(SinkBuffer& buffer, std::span<s16> samples) {
                 static_cast<s16>(std::clamp(right_sample, min, max));
         }
 
-        samples_buffer.Push(samples.subspan(0, samples.size() / system_channels * device_channels));
+        PushOutputSamples(buffer,
+                          samples.subspan(0, samples.size() / system_channels * device_channels));
         return;
     }
 
@@ -106,7 +132,7 @@ void SinkStream::AppendBuffer(SinkBuffer& buffer, std::span<s16> samples) {
             new_samples[write_index + static_cast<u32>(Channels::FrontRight)] = right_sample;
         }
 
-        samples_buffer.Push(new_samples);
+        PushOutputSamples(buffer, new_samples);
         return;
     }
 
@@ -117,7 +143,7 @@ void SinkStream::AppendBuffer(SinkBuffer& buffer, std::span<s16> samples) {
         }
     }
 
-    samples_buffer.Push(samples);
+    PushOutputSamples(buffer, samples);
 }
 
 std::vector<s16> SinkStream::ReleaseBuffer(u64 num_samples) {
@@ -144,6 +170,7 @@ std::vector<s16> SinkStream::ReleaseBuffer(u64 num_samples) {
 }
 
 void SinkStream::ClearQueue() {
+    time_stretcher.Clear();
     samples_buffer.Pop();
     while (queue.pop()) {
     }
@@ -170,8 +197,8 @@ void SinkStream::ProcessAudioIn(std::span<const s16> input_buffer, std::size_t n
             if (!queue.try_dequeue(playing_buffer)) {
                 // If no buffer was available we've underrun, just push the samples and
                 // continue.
-                samples_buffer.Push(&input_buffer[frames_written * frame_size],
-                                    (num_frames - frames_written) * frame_size);
+                PushSamples(input_buffer.subspan(frames_written * frame_size,
+                                                 (num_frames - frames_written) * frame_size));
                 frames_written = num_frames;
                 continue;
             }
@@ -184,8 +211,8 @@ void SinkStream::ProcessAudioIn(std::span<const s16> input_buffer, std::size_t n
         size_t frames_available{std::min<u64>(playing_buffer.frames - playing_buffer.frames_played,
                                               num_frames - frames_written)};
 
-        samples_buffer.Push(&input_buffer[frames_written * frame_size],
-                            frames_available * frame_size);
+        PushSamples(
+            input_buffer.subspan(frames_written * frame_size, frames_available * frame_size));
 
         frames_written += frames_available;
         playing_buffer.frames_played += frames_available;
@@ -205,19 +232,20 @@ void SinkStream::ProcessAudioOutAndRender(std::span<s16> output_buffer, std::siz
     const std::size_t frame_size = num_channels;
     const std::size_t frame_size_bytes = frame_size * sizeof(s16);
     size_t frames_written{0};
-    size_t actual_frames_written{0};
+    u64 source_frames_written{0};
+    bool underran{false};
 
     // If we're paused or going to shut down, we don't want to consume buffers as coretiming is
     // paused and we'll desync, so just play silence.
     if (system.IsPaused() || system.IsShuttingDown()) {
         if (system.IsShuttingDown()) {
-            {
-                std::scoped_lock lk{release_mutex};
-                queued_buffers.store(0);
-            }
-            release_cv.notify_one();
+            queued_buffers.store(0);
+            release_sema.signal();
         }
 
+        // Callbacks while paused do not say anything about the backend's timing
+        last_callback_time = {};
+
         static constexpr std::array<s16, 6> silence{};
         for (size_t i = frames_written; i < num_frames; i++) {
             std::memcpy(&output_buffer[i * frame_size], &silence[0], frame_size_bytes);
@@ -231,6 +259,8 @@ void SinkStream::ProcessAudioOutAndRender(std::span<s16> output_buffer, std::siz
             if (!queue.try_dequeue(playing_buffer)) {
                 // If no buffer was available we've underrun, fill the remaining buffer with
                 // the last written frame and continue.
+                system.GetPerfStats().RecordAudioUnderrun();
+                underran = true;
                 for (size_t i = frames_written; i < num_frames; i++) {
                     std::memcpy(&output_buffer[i * frame_size], &last_frame[0], frame_size_bytes);
                 }
@@ -239,10 +269,7 @@ void SinkStream::ProcessAudioOutAndRender(std::span<s16> output_buffer, std::siz
             }
             // Successfully dequeued a new buffer.
             queued_buffers--;
-
-            { std::unique_lock lk{release_mutex}; }
-
-            release_cv.notify_one();
+            release_sema.signal();
         }
 
         // Get the minimum frames available between the currently playing buffer, and the
@@ -253,8 +280,8 @@ void SinkStream::ProcessAudioOutAndRender(std::span<s16> output_buffer, std::siz
         samples_buffer.Pop(&output_buffer[frames_written * frame_size],
                            frames_available * frame_size);
 
+        const u64 source_frames_played{SourceFramesPlayed(playing_buffer)};
         frames_written += frames_available;
-        actual_frames_written += frames_available;
         playing_buffer.frames_played += frames_available;
 
         // If that's all the frames in the current buffer, add its samples and mark it as
@@ -262,46 +289,155 @@ void SinkStream::ProcessAudioOutAndRender(std::span<s16> output_buffer, std::siz
         if (playing_buffer.frames_played >= playing_buffer.frames) {
             playing_buffer.consumed = true;
         }
+        source_frames_written += SourceFramesPlayed(playing_buffer) - source_frames_played;
     }
 
     std::memcpy(&last_frame[0], &output_buffer[(frames_written - 1) * frame_size],
                 frame_size_bytes);
-
-    {
-        std::scoped_lock lk{sample_count_lock};
-        last_sample_count_update_time = system.CoreTiming().GetGlobalTimeNs();
-        min_played_sample_count = max_played_sample_count;
-        max_played_sample_count += actual_frames_written;
-    }
+    AdaptQueueSize(num_frames, underran);
+
+    // This is the only writer, readers retry if the sequence changed while they were reading
+    const u32 sequence{sample_count_sequence.load(std::memory_order_relaxed)};
+    sample_count_sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    const u64 max_played{max_played_sample_count.load(std::memory_order_relaxed)};
+    last_sample_count_update_time.store(system.CoreTiming().GetGlobalTimeNs().count(),
+                                        std::memory_order_relaxed);
+    min_played_sample_count.store(max_played, std::memory_order_relaxed);
+    max_played_sample_count.store(max_played + source_frames_written, std::memory_order_relaxed);
+    sample_count_sequence.store(sequence + 2, std::memory_order_release);
 }
 
 u64 SinkStream::GetExpectedPlayedSampleCount() {
-    std::scoped_lock lk{sample_count_lock};
+    u64 min_played{};
+    u64 max_played{};
+    std::chrono::nanoseconds update_time{};
+    u32 sequence{};
+    do {
+        sequence = sample_count_sequence.load(std::memory_order_acquire);
+        min_played = min_played_sample_count.load(std::memory_order_relaxed);
+        max_played = max_played_sample_count.load(std::memory_order_relaxed);
+        update_time = std::chrono::nanoseconds{
+            last_sample_count_update_time.load(std::memory_order_relaxed)};
+        std::atomic_thread_fence(std::memory_order_acquire);
+    } while ((sequence & 1) != 0 ||
+             sample_count_sequence.load(std::memory_order_relaxed) != sequence);
+
     auto cur_time{system.CoreTiming().GetGlobalTimeNs()};
-    auto time_delta{cur_time - last_sample_count_update_time};
-    auto exp_played_sample_count{min_played_sample_count +
+    auto time_delta{cur_time - update_time};
+    auto exp_played_sample_count{min_played +
                                  (TargetSampleRate * time_delta) / std::chrono::seconds{1}};
 
     // Add 15ms of latency in sample reporting to allow for some leeway in scheduler timings
-    return std::min<u64>(exp_played_sample_count, max_played_sample_count) + TargetSampleCount * 3;
+    return std::min<u64>(exp_played_sample_count, max_played) + TargetSampleCount * 3;
 }
 
 void SinkStream::WaitFreeSpace(std::stop_token stop_token) {
-    std::unique_lock lk{release_mutex};
-    release_cv.wait_for(lk, std::chrono::milliseconds(5),
-                        [this]() { return paused || queued_buffers < max_queue_size; });
+    const u32 queue_size_limit{GetQueueSizeLimit()};
+    const auto has_free_space{[&] { return paused || queued_buffers < queue_size_limit; }};
+
+    // Forget signals for buffers consumed while nothing was waiting
+    while (release_sema.tryWait()) {
+    }
+
+    const auto deadline{std::chrono::steady_clock::now() + std::chrono::milliseconds(5)};
+    while (!has_free_space()) {
+        const auto remaining{std::chrono::duration_cast<std::chrono::microseconds>(
+            deadline - std::chrono::steady_clock::now())};
+        if (remaining.count() <= 0 || !release_sema.wait(remaining.count())) {
+            break;
+        }
+    }
     if (queued_buffers > max_queue_size + 3) {
-        Common::CondvarWait(release_cv, lk, stop_token,
-                            [this] { return paused || queued_buffers < max_queue_size; });
+        std::stop_callback wake{stop_token, [this] { release_sema.signal(); }};
+        while (!stop_token.stop_requested() && !has_free_space()) {
+            release_sema.wait();
+        }
     }
 }
 
 void SinkStream::SignalPause() {
-    {
-        std::scoped_lock lk{release_mutex};
-        paused = true;
+    paused = true;
+    release_sema.signal();
+}
+
+u32 SinkStream::GetQueueSizeLimit() const {
+    if (!Settings::values.audio_low_latency) {
+        return max_queue_size;
+    }
+    return std::min(low_latency_queue_size.load(std::memory_order_relaxed), max_queue_size);
+}
+
+void SinkStream::AdaptQueueSize(std::size_t num_frames, bool underran) {
+    const auto now{std::chrono::steady_clock::now()};
+    const auto previous_callback_time{std::exchange(last_callback_time, now)};
+    if (!Settings::values.audio_low_latency ||
+        previous_callback_time == std::chrono::steady_clock::time_point{}) {
+        return;
+    }
+
+    const std::chrono::nanoseconds expected_interval{
+        std::chrono::nanoseconds{std::chrono::seconds{static_cast<s64>(num_frames)}} /
+        TargetSampleRate};
+    const auto interval{now - previous_callback_time};
+    peak_callback_jitter =
+        std::max(peak_callback_jitter, std::chrono::abs(interval - expected_interval));
+
+    u32 queue_size{low_latency_queue_size.load(std::memory_order_relaxed)};
+    if (underran) {
+        queue_size = std::min(queue_size + 1, std::max(max_queue_size, MinLowLatencyQueueSize));
+        low_latency_queue_size.store(queue_size, std::memory_order_relaxed);
+        stable_frames = 0;
+        return;
+    }
+
+    stable_frames += num_frames;
+    if (stable_frames >= QueueShrinkFrames) {
+        // Keep enough buffers queued to cover the worst callback delay seen
+        const auto jitter_buffers{static_cast<u32>(
+            (peak_callback_jitter + BufferDuration - std::chrono::nanoseconds{1}) /
+            BufferDuration)};
+        if (queue_size > MinLowLatencyQueueSize + jitter_buffers) {
+            queue_size--;
+        }
+        stable_frames = 0;
+        peak_callback_jitter = {};
+    }
+    low_latency_queue_size.store(queue_size, std::memory_order_relaxed);
+}
+
+void SinkStream::PushOutputSamples(SinkBuffer& buffer, std::span<const s16> samples) {
+    const f64 frame_time_scale{
+        Settings::values.audio_time_stretch ? system.GetPerfStats().GetLastFrameTimeScale() : 1.0};
+    time_stretch_ratio += (std::clamp(frame_time_scale, MinTimeStretchRatio, MaxTimeStretchRatio) -
+                           time_stretch_ratio) *
+                          TimeStretchSmoothing;
+
+    const f64 distance{std::abs(time_stretch_ratio - 1.0)};
+    const bool was_stretching{time_stretching};
+    time_stretching = distance > (time_stretching ? TimeStretchStopThreshold
+                                                  : TimeStretchStartThreshold);
+    if (!time_stretching && !was_stretching) {
+        PushSamples(samples);
+        return;
+    }
+
+    stretched_samples.clear();
+    if (time_stretching) {
+        time_stretcher.Process(samples, device_channels, time_stretch_ratio, stretched_samples);
+    } else {
+        // Back to full speed, play out what the stretcher holds and carry on from there
+        time_stretcher.Flush(stretched_samples);
+        stretched_samples.insert(stretched_samples.end(), samples.begin(), samples.end());
+    }
+    buffer.frames = stretched_samples.size() / device_channels;
+    PushSamples(stretched_samples);
+}
+
+void SinkStream::PushSamples(std::span<const s16> samples) {
+    if (samples_buffer.Push(samples) < samples.size()) {
+        system.GetPerfStats().RecordAudioOverrun();
     }
-    release_cv.notify_one();
 }
 
 } // namespace AudioCore::Sink
@@ -12,6 +12,8 @@
 #include <vector>
 
 #include "audio_core/common/common.h"
+#include "audio_core/sink/time_stretcher.h"
+#include "common/atomic_helpers.h"
 #include "common/common_types.h"
 #include "common/polyfill_thread.h"
 #include "common/reader_writer_queue.h"
@@ -35,6 +37,8 @@ struct SinkBuffer {
     u64 frames_played;
     u64 tag;
     bool consumed;
+    /// Frames appended, set by the stream as time stretching may change the frames played
+    u64 source_frames;
 };
 
 /**
@@ -52,6 +56,10 @@ struct SinkBuffer {
  *
  * If the buffers appear to be stuck, you can stop and re-open an IAudioIn/IAudioOut service (this
  * is what games do), or call ClearQueue to flush all of the buffers without a full restart.
+ *
+ * The backend callbacks (ProcessAudioIn and ProcessAudioOutAndRender) run on realtime audio
+ * threads, so they never take locks. Samples and buffers move through single producer, single
+ * consumer queues, and the callbacks only signal the emulator side with a lightweight semaphore.
  */
 class SinkStream {
 public:
@@ -219,6 +227,38 @@ protected:
      */
     void SignalPause();
 
+private:
+    /**
+     * Push samples to the sample ring buffer, counting an overrun if they do not all fit.
+     *
+     * @param samples - Samples to push.
+     */
+    void PushSamples(std::span<const s16> samples);
+
+    /**
+     * Push a buffer's output samples to the sample ring buffer, time stretching them if enabled.
+     *
+     * @param buffer  - Buffer of the samples, its frames are updated to the frames pushed.
+     * @param samples - Samples to push, in the device's channel layout.
+     */
+    void PushOutputSamples(SinkBuffer& buffer, std::span<const s16> samples);
+
+    /**
+     * Get the number of queued buffers WaitFreeSpace waits to go below.
+     *
+     * @return The queue size limit.
+     */
+    u32 GetQueueSizeLimit() const;
+
+    /**
+     * Adapt the queue size limit of the low latency mode to the backend's timing, growing it on
+     * underruns and shrinking it while the callback jitter allows. Output callback only.
+     *
+     * @param num_frames - Number of frames the callback played.
+     * @param underran   - Whether the callback ran out of buffers.
+     */
+    void AdaptQueueSize(std::size_t num_frames, bool underran);
+
 protected:
     /// Core system
     Core::System& system;
@@ -246,21 +286,39 @@ private:
     std::atomic<u32> queued_buffers{};
     /// The ring size for audio out buffers (usually 4, rarely 2 or 8)
     u32 max_queue_size{};
-    /// Locks access to sample count tracking info
-    std::mutex sample_count_lock;
+    /// Smallest queue size limit of the low latency mode, one buffer playing and one queued
+    static constexpr u32 MinLowLatencyQueueSize{2};
+    /// Queue size limit of the low latency mode, capped to max_queue_size
+    std::atomic<u32> low_latency_queue_size{MinLowLatencyQueueSize};
+    /// Time of the previous output callback
+    std::chrono::steady_clock::time_point last_callback_time{};
+    /// Largest difference between the time of a callback and the audio it played since the
+    /// queue size limit was last reconsidered
+    std::chrono::nanoseconds peak_callback_jitter{};
+    /// Frames played without underruns since the queue size limit was last reconsidered
+    u64 stable_frames{};
+    /// Stretches output while emulation is not running at full speed
+    TimeStretcher time_stretcher;
+    /// Output of the time stretcher, reused between buffers
+    std::vector<s16> stretched_samples;
+    /// Smoothed ratio of walltime to emulated time, the output is stretched by it
+    f64 time_stretch_ratio{1.0};
+    /// Whether output is currently being time stretched
+    bool time_stretching{false};
+    /// Sequence lock of the sample count tracking info, odd while the callback is writing it
+    std::atomic<u32> sample_count_sequence{};
     /// Minimum number of total samples that have been played since the last callback
-    u64 min_played_sample_count{};
+    std::atomic<u64> min_played_sample_count{};
     /// Maximum number of total samples that can be played since the last callback
-    u64 max_played_sample_count{};
-    /// The time the two above tracking variables were last written to
-    std::chrono::nanoseconds last_sample_count_update_time{};
+    std::atomic<u64> max_played_sample_count{};
+    /// The time in nanoseconds the two above tracking variables were last written to
+    std::atomic<s64> last_sample_count_update_time{};
     /// Set by the audio render/in/out system which uses this stream
     f32 system_volume{1.0f};
     /// Set via IAudioDevice service calls
     f32 device_volume{1.0f};
-    /// Signalled when ring buffer entries are consumed
-    std::condition_variable_any release_cv;
-    std::mutex release_mutex;
+    /// Signalled when ring buffer entries are consumed or the stream pauses
+    Common::spsc_sema::LightweightSemaphore release_sema;
 };
 
 using SinkStreamPtr = std::unique_ptr<SinkStream>;
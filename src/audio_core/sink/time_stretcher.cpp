@@ -0,0 +1,115 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "audio_core/sink/time_stretcher.h"
+
+namespace AudioCore::Sink {
+
+void TimeStretcher::Process(std::span<const s16> input, u32 channels_, f64 ratio,
+                            std::vector<s16>& output) {
+    if (channels_ != channels) {
+        Clear();
+        channels = channels_;
+    }
+    samples.insert(samples.end(), input.begin(), input.end());
+
+    const size_t frames{samples.size() / channels};
+    const f64 tempo{1.0 / ratio};
+    while (true) {
+        const auto start{static_cast<size_t>(position)};
+        if (start + SearchFrames + HopFrames + OverlapFrames > frames) {
+            break;
+        }
+
+        const size_t segment{started ? start + FindBestOffset(start) : start};
+        const size_t output_offset{output.size()};
+        output.resize(output_offset + HopFrames * channels);
+
+        s16* out{output.data() + output_offset};
+        const s16* from{samples.data() + continuation * channels};
+        const s16* to{samples.data() + segment * channels};
+        if (started) {
+            for (size_t frame = 0; frame < OverlapFrames; frame++) {
+                const auto fade_in{static_cast<s32>(frame)};
+                const auto fade_out{static_cast<s32>(OverlapFrames - frame)};
+                for (size_t channel = 0; channel < channels; channel++) {
+                    const size_t index{frame * channels + channel};
+                    out[index] = static_cast<s16>((from[index] * fade_out + to[index] * fade_in) /
+                                                  static_cast<s32>(OverlapFrames));
+                }
+            }
+        } else {
+            std::copy_n(to, OverlapFrames * channels, out);
+        }
+        std::copy(to + OverlapFrames * channels, to + HopFrames * channels,
+                  out + OverlapFrames * channels);
+
+        continuation = segment + HopFrames;
+        started = true;
+        position += static_cast<f64>(HopFrames) * tempo;
+    }
+
+    // Drop the samples neither the next segment nor its crossfade can use
+    const size_t consumed{std::min(static_cast<size_t>(position), continuation)};
+    samples.erase(samples.begin(), samples.begin() + consumed * channels);
+    position -= static_cast<f64>(consumed);
+    continuation -= consumed;
+}
+
+void TimeStretcher::Flush(std::vector<s16>& output) {
+    output.insert(output.end(), samples.begin() + continuation * channels, samples.end());
+    Clear();
+}
+
+void TimeStretcher::Clear() {
+    samples.clear();
+    position = 0.0;
+    continuation = 0;
+    started = false;
+}
+
+size_t TimeStretcher::FindBestOffset(size_t start) {
+    // The previous segment's continuation, followed by every candidate segment start
+    const size_t reference_size{OverlapFrames * channels};
+    const size_t candidates_size{(SearchFrames + OverlapFrames) * channels};
+    window.resize(reference_size + candidates_size);
+    std::copy_n(samples.data() + continuation * channels, reference_size, window.data());
+    std::copy_n(samples.data() + start * channels, candidates_size,
+                window.data() + reference_size);
+
+    const f32* reference{window.data()};
+    const f32* candidates{window.data() + reference_size};
+    f64 energy{};
+    for (size_t i = 0; i < reference_size; i++) {
+        energy += candidates[i] * candidates[i];
+    }
+
+    size_t best_offset{};
+    f64 best_score{-std::numeric_limits<f64>::infinity()};
+    for (size_t offset = 0; offset < SearchFrames; offset++) {
+        const f32* candidate{candidates + offset * channels};
+        f32 correlation{};
+        for (size_t i = 0; i < reference_size; i++) {
+            correlation += reference[i] * candidate[i];
+        }
+
+        // Normalize by the candidate's energy, so loud candidates are not favoured
+        const f64 score{correlation / std::sqrt(energy + 1.0)};
+        if (score > best_score) {
+            best_score = score;
+            best_offset = offset;
+        }
+        for (size_t channel = 0; channel < channels; channel++) {
+            const f32 leaving{candidate[channel]};
+            const f32 entering{candidate[reference_size + channel]};
+            energy += entering * entering - leaving * leaving;
+        }
+    }
+    return best_offset;
+}
+
+} // namespace AudioCore::Sink
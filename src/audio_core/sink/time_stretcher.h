@@ -0,0 +1,79 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include "common/common_types.h"
+
+namespace AudioCore::Sink {
+
+/**
+ * Changes the duration of interleaved PCM16 audio without changing its pitch, using WSOLA
+ * (waveform similarity overlap-add).
+ *
+ * Output is built from segments of the input, which are advanced through at the inverse of the
+ * stretch ratio. Each segment is picked from a small window around its nominal position, at the
+ * offset whose start best matches how the previous segment carried on, and crossfaded into it.
+ *
+ * Input is buffered between calls, so the output lags behind it by up to a few segments.
+ */
+class TimeStretcher {
+public:
+    /// Frames output per segment
+    static constexpr size_t HopFrames{720};
+    /// Frames crossfaded between segments
+    static constexpr size_t OverlapFrames{240};
+    /// Frames a segment may be moved by to best match the previous one
+    static constexpr size_t SearchFrames{480};
+
+    /**
+     * Stretch samples to the given ratio of their duration, appending the result to output.
+     *
+     * @param input    - Interleaved samples to stretch.
+     * @param channels - Number of channels of the samples, changing it discards buffered samples.
+     * @param ratio    - Output duration over input duration.
+     * @param output   - Receives the stretched samples.
+     */
+    void Process(std::span<const s16> input, u32 channels, f64 ratio, std::vector<s16>& output);
+
+    /**
+     * Append every buffered sample to output, carrying on from the last stretched segment, and
+     * reset the stretcher.
+     *
+     * @param output - Receives the buffered samples.
+     */
+    void Flush(std::vector<s16>& output);
+
+    /**
+     * Discard every buffered sample.
+     */
+    void Clear();
+
+private:
+    /**
+     * Find the offset from a nominal segment start best matching the previous segment's
+     * continuation.
+     *
+     * @param start - Frame of the nominal segment start.
+     * @return Offset of the best matching segment start, less than SearchFrames.
+     */
+    size_t FindBestOffset(size_t start);
+
+    /// Buffered input samples
+    std::vector<s16> samples;
+    /// Buffered input samples, as floats, of the current search window
+    std::vector<f32> window;
+    /// Number of channels of the buffered samples
+    u32 channels{};
+    /// Nominal start frame of the next segment
+    f64 position{};
+    /// Frame at which the previous segment would carry on, the next segment fades from it
+    size_t continuation{};
+    /// Set once a segment has been output
+    bool started{};
+};
+
+} // namespace AudioCore::Sink
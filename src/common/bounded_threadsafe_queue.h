@@ -3,11 +3,14 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <atomic>
 #include <condition_variable>
 #include <cstddef>
 #include <mutex>
 #include <new>
+#include <span>
 
 #include "common/polyfill_thread.h"
 
@@ -56,6 +59,17 @@ public:
         return t;
     }
 
+    /// Pops as many elements as available into out, without waiting. Returns the number popped.
+    size_t TryPopMany(std::span<T> out) {
+        return PopMany<PopMode::Try>(out);
+    }
+
+    /// Waits for at least one element, then pops as many as available into out.
+    /// Returns the number of elements popped, zero when a stop was requested.
+    size_t PopWaitMany(std::span<T> out, std::stop_token stop_token) {
+        return PopMany<PopMode::WaitWithStopToken>(out, stop_token);
+    }
+
 private:
     enum class PushMode {
         Try,
@@ -107,12 +121,17 @@ private:
 
     template <PopMode Mode>
     bool Pop(T& t, [[maybe_unused]] std::stop_token stop_token = {}) {
+        return PopMany<Mode>(std::span<T>(std::addressof(t), 1), stop_token) != 0;
+    }
+
+    template <PopMode Mode>
+    size_t PopMany(std::span<T> out, [[maybe_unused]] std::stop_token stop_token = {}) {
         const size_t read_index = m_read_index.load(std::memory_order::relaxed);
 
         if constexpr (Mode == PopMode::Try) {
             // Check if the queue is empty.
             if (read_index == m_write_index.load(std::memory_order::acquire)) {
-                return false;
+                return 0;
             }
         } else if constexpr (Mode == PopMode::Wait) {
             // Wait until the queue is not empty.
@@ -127,26 +146,29 @@ private:
                 return read_index != m_write_index.load(std::memory_order::acquire);
             });
             if (stop_token.stop_requested()) {
-                return false;
+                return 0;
             }
         } else {
             static_assert(Mode < PopMode::Count, "Invalid PopMode.");
         }
 
-        // Determine the position to read from.
-        const size_t pos = read_index % Capacity;
+        // Take every element written so far that fits in the output.
+        const size_t count =
+            std::min(m_write_index.load(std::memory_order::acquire) - read_index, out.size());
 
         // Pop the data off the queue, moving it.
-        t = std::move(m_data[pos]);
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = std::move(m_data[(read_index + i) % Capacity]);
+        }
 
-        // Increment the read index.
-        ++m_read_index;
+        // Release all the popped slots at once.
+        m_read_index += count;
 
         // Notify the producer that we have popped off the queue.
         std::scoped_lock lock{producer_cv_mutex};
         producer_cv.notify_one();
 
-        return true;
+        return count;
     }
 
     alignas(128) std::atomic_size_t m_read_index{0};
@@ -195,6 +217,14 @@ public:
         return spsc_queue.PopWait(stop_token);
     }
 
+    size_t TryPopMany(std::span<T> out) {
+        return spsc_queue.TryPopMany(out);
+    }
+
+    size_t PopWaitMany(std::span<T> out, std::stop_token stop_token) {
+        return spsc_queue.PopWaitMany(out, stop_token);
+    }
+
 private:
     SPSCQueue<T, Capacity> spsc_queue;
     std::mutex write_mutex;
@@ -240,6 +270,16 @@ public:
         return spsc_queue.PopWait(stop_token);
     }
 
+    size_t TryPopMany(std::span<T> out) {
+        std::scoped_lock lock{read_mutex};
+        return spsc_queue.TryPopMany(out);
+    }
+
+    size_t PopWaitMany(std::span<T> out, std::stop_token stop_token) {
+        std::scoped_lock lock{read_mutex};
+        return spsc_queue.PopWaitMany(out, stop_token);
+    }
+
 private:
     SPSCQueue<T, Capacity> spsc_queue;
     std::mutex write_mutex;
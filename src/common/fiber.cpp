@@ -1,7 +1,9 @@
 // SPDX-FileCopyrightText: Copyright 2020 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <atomic>
 #include <mutex>
+#include <vector>
 
 #include "common/assert.h"
 #include "common/fiber.h"
@@ -13,9 +15,67 @@ namespace Common {
 
 constexpr std::size_t default_stack_size = 512 * 1024;
 
+// Released stacks kept for new fibers, their touched pages stay resident
+constexpr std::size_t max_pooled_stacks = 32;
+
+namespace {
+
+// Guest threads are often created and destroyed, recycling their stacks avoids mapping and
+// faulting in new ones. Pages are only backed by memory once a fiber touches them.
+class StackPool {
+public:
+    VirtualBuffer<u8> Acquire() {
+        bytes_in_use.fetch_add(default_stack_size, std::memory_order_relaxed);
+        {
+            std::scoped_lock lock{mutex};
+            if (!free_stacks.empty()) {
+                VirtualBuffer<u8> stack = std::move(free_stacks.back());
+                free_stacks.pop_back();
+                return stack;
+            }
+        }
+        return VirtualBuffer<u8>(default_stack_size);
+    }
+
+    void Release(VirtualBuffer<u8>& stack) {
+        if (stack.size() == 0) {
+            return;
+        }
+        bytes_in_use.fetch_sub(default_stack_size, std::memory_order_relaxed);
+        std::scoped_lock lock{mutex};
+        if (free_stacks.size() < max_pooled_stacks) {
+            free_stacks.push_back(std::move(stack));
+        }
+    }
+
+    Fiber::StackMemoryStats Stats() {
+        std::scoped_lock lock{mutex};
+        return {
+            .bytes_in_use = bytes_in_use.load(std::memory_order_relaxed),
+            .bytes_pooled = free_stacks.size() * default_stack_size,
+        };
+    }
+
+private:
+    std::mutex mutex;
+    std::vector<VirtualBuffer<u8>> free_stacks;
+    std::atomic<std::size_t> bytes_in_use{};
+};
+
+StackPool& GetStackPool() {
+    static StackPool pool;
+    return pool;
+}
+
+} // Anonymous namespace
+
 struct Fiber::FiberImpl {
-    FiberImpl() : stack{default_stack_size}, rewind_stack{default_stack_size} {}
+    ~FiberImpl() {
+        GetStackPool().Release(stack);
+        GetStackPool().Release(rewind_stack);
+    }
 
+    // Thread fibers run on the stack of their host thread and don't have one
     VirtualBuffer<u8> stack;
     VirtualBuffer<u8> rewind_stack;
 
@@ -34,6 +94,11 @@ struct Fiber::FiberImpl {
 
 void Fiber::SetRewindPoint(std::function<void()>&& rewind_func) {
     impl->rewind_point = std::move(rewind_func);
+    if (impl->rewind_stack.size() == 0) {
+        // Only fibers that can be rewound need a second stack
+        impl->rewind_stack = GetStackPool().Acquire();
+        impl->rewind_stack_limit = impl->rewind_stack.data();
+    }
 }
 
 void Fiber::Start(boost::context::detail::transfer_t& transfer) {
@@ -68,8 +133,8 @@ void Fiber::RewindStartFunc(boost::context::detail::transfer_t transfer) {
 
 Fiber::Fiber(std::function<void()>&& entry_point_func) : impl{std::make_unique<FiberImpl>()} {
     impl->entry_point = std::move(entry_point_func);
+    impl->stack = GetStackPool().Acquire();
     impl->stack_limit = impl->stack.data();
-    impl->rewind_stack_limit = impl->rewind_stack.data();
     u8* stack_base = impl->stack_limit + default_stack_size;
     impl->context =
         boost::context::detail::make_fcontext(stack_base, impl->stack.size(), FiberStartFunc);
@@ -107,22 +172,27 @@ void Fiber::Rewind() {
     boost::context::detail::jump_fcontext(impl->rewind_context, this);
 }
 
-void Fiber::YieldTo(std::weak_ptr<Fiber> weak_from, Fiber& to) {
+void Fiber::YieldTo(const std::shared_ptr<Fiber>& from, Fiber& to) {
+    // Only the raw pointer is used once resumed, the caller's reference may not outlive the yield.
+    // The previous fiber reference keeps "from" alive until "to" has taken over.
+    FiberImpl* const from_impl = from->impl.get();
     to.impl->guard.lock();
-    to.impl->previous_fiber = weak_from.lock();
+    to.impl->previous_fiber = from;
 
     auto transfer = boost::context::detail::jump_fcontext(to.impl->context, &to);
 
-    // "from" might no longer be valid if the thread was killed
-    if (auto from = weak_from.lock()) {
-        if (from->impl->previous_fiber == nullptr) {
-            ASSERT_MSG(false, "previous_fiber is nullptr!");
-            return;
-        }
-        from->impl->previous_fiber->impl->context = transfer.fctx;
-        from->impl->previous_fiber->impl->guard.unlock();
-        from->impl->previous_fiber.reset();
+    // Running again on the stack of "from", so it is still alive
+    if (from_impl->previous_fiber == nullptr) {
+        ASSERT_MSG(false, "previous_fiber is nullptr!");
+        return;
     }
+    const std::shared_ptr<Fiber> previous_fiber = std::move(from_impl->previous_fiber);
+    previous_fiber->impl->context = transfer.fctx;
+    previous_fiber->impl->guard.unlock();
+}
+
+Fiber::StackMemoryStats Fiber::GetStackMemoryStats() {
+    return GetStackPool().Stats();
 }
 
 std::shared_ptr<Fiber> Fiber::ThreadToFiber() {
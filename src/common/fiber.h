@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <functional>
 #include <memory>
 
@@ -40,9 +41,17 @@ public:
 
     /// Yields control from Fiber 'from' to Fiber 'to'
     /// Fiber 'from' must be the currently running fiber.
-    static void YieldTo(std::weak_ptr<Fiber> weak_from, Fiber& to);
+    static void YieldTo(const std::shared_ptr<Fiber>& from, Fiber& to);
     [[nodiscard]] static std::shared_ptr<Fiber> ThreadToFiber();
 
+    struct StackMemoryStats {
+        std::size_t bytes_in_use; ///< Size of the stacks of live fibers
+        std::size_t bytes_pooled; ///< Size of the released stacks kept for reuse
+    };
+
+    /// Returns the address space used by fiber stacks, pages are only resident once touched
+    [[nodiscard]] static StackMemoryStats GetStackMemoryStats();
+
     void SetRewindPoint(std::function<void()>&& rewind_func);
 
     void Rewind();
@@ -0,0 +1,105 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include "common/fs/mapped_file.h"
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Common::FS {
+
+MappedFile::MappedFile() = default;
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::filesystem::path& path) {
+    const HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                    OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return;
+    }
+    LARGE_INTEGER file_size{};
+    if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart <= 0) {
+        CloseHandle(file);
+        return;
+    }
+    const HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (mapping == nullptr) {
+        LOG_ERROR(Common_Filesystem, "Failed to create a mapping of {}, error={}",
+                  PathToUTF8String(path), GetLastError());
+        return;
+    }
+    // The view keeps the mapping object alive after its handle is closed.
+    void* const view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (view == nullptr) {
+        LOG_ERROR(Common_Filesystem, "Failed to map {}, error={}", PathToUTF8String(path),
+                  GetLastError());
+        return;
+    }
+    data = static_cast<const u8*>(view);
+    size = static_cast<size_t>(file_size.QuadPart);
+}
+
+MappedFile::~MappedFile() {
+    if (data != nullptr) {
+        UnmapViewOfFile(data);
+    }
+}
+
+#else
+
+MappedFile::MappedFile(const std::filesystem::path& path) {
+    const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return;
+    }
+    struct stat stats {};
+    if (fstat(fd, &stats) != 0 || !S_ISREG(stats.st_mode) || stats.st_size <= 0) {
+        close(fd);
+        return;
+    }
+    // The mapping stays valid after the descriptor is closed.
+    const size_t file_size = static_cast<size_t>(stats.st_size);
+    void* const view = mmap(nullptr, file_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (view == MAP_FAILED) {
+        LOG_ERROR(Common_Filesystem, "Failed to map {}, error={}", PathToUTF8String(path),
+                  std::strerror(errno));
+        return;
+    }
+    data = static_cast<const u8*>(view);
+    size = file_size;
+}
+
+MappedFile::~MappedFile() {
+    if (data != nullptr) {
+        munmap(const_cast<u8*>(data), size);
+    }
+}
+
+#endif
+
+size_t MappedFile::Read(u8* dest, size_t length, size_t offset) const {
+    if (offset >= size) {
+        return 0;
+    }
+    const size_t read_size = std::min(length, size - offset);
+    std::memcpy(dest, data + offset, read_size);
+    return read_size;
+}
+
+} // namespace Common::FS
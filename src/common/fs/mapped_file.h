@@ -0,0 +1,62 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <filesystem>
+#include <span>
+
+#include "common/common_funcs.h"
+#include "common/common_types.h"
+
+namespace Common::FS {
+
+/**
+ * Read-only view of a whole file mapped into memory.
+ * Reads are served from the page cache shared with the host, without a system call per read.
+ * The file must not be truncated while it is mapped.
+ */
+class MappedFile {
+public:
+    MappedFile();
+
+    /**
+     * Maps the file at path. Use IsOpen() to check whether the file was mapped.
+     *
+     * @param path Filesystem path
+     */
+    explicit MappedFile(const std::filesystem::path& path);
+
+    ~MappedFile();
+
+    YUZU_NON_COPYABLE(MappedFile);
+    YUZU_NON_MOVEABLE(MappedFile);
+
+    /// Whether the file is mapped.
+    [[nodiscard]] bool IsOpen() const {
+        return data != nullptr;
+    }
+
+    /// Size of the mapped file in bytes.
+    [[nodiscard]] size_t GetSize() const {
+        return size;
+    }
+
+    /// Contents of the mapped file, empty if the file could not be mapped.
+    [[nodiscard]] std::span<const u8> GetSpan() const {
+        return {data, size};
+    }
+
+    /**
+     * Copies up to length bytes starting at offset into dest.
+     *
+     * @returns Number of bytes copied, less than length if the range exceeds the file.
+     */
+    size_t Read(u8* dest, size_t length, size_t offset) const;
+
+private:
+    const u8* data{};
+    size_t size{};
+};
+
+} // namespace Common::FS
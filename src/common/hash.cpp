@@ -0,0 +1,116 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <cstring>
+
+#include "common/cityhash.h"
+#include "common/hash.h"
+
+#if defined(ARCHITECTURE_x86_64)
+#include <nmmintrin.h>
+#include "common/x64/cpu_detect.h"
+#elif defined(ARCHITECTURE_arm64) && defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#endif
+
+namespace Common {
+namespace {
+
+#if defined(ARCHITECTURE_x86_64)
+#if defined(__GNUC__) || defined(__clang__)
+#define CRC32C_TARGET __attribute__((target("sse4.2")))
+#else
+#define CRC32C_TARGET
+#endif
+
+CRC32C_TARGET u64 Crc32c(u64 crc, u64 value) noexcept {
+    return _mm_crc32_u64(crc, value);
+}
+
+const bool has_crc32c = GetCPUCaps().sse4_2;
+#elif defined(ARCHITECTURE_arm64) && defined(__ARM_FEATURE_CRC32)
+#define CRC32C_TARGET
+
+u64 Crc32c(u64 crc, u64 value) noexcept {
+    return __crc32cd(static_cast<u32>(crc), value);
+}
+
+constexpr bool has_crc32c = true;
+#endif
+
+#ifdef CRC32C_TARGET
+// Independent lanes hide the latency of the CRC instruction
+constexpr std::array<u64, 4> LANE_SEEDS{0x9e3779b9, 0x85ebca6b, 0xc2b2ae35, 0x27d4eb2f};
+
+u64 Load64(const u8* data) noexcept {
+    u64 value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+/// Finalizer of MurmurHash3, CRCs are linear and their bits have to be mixed
+constexpr u64 Mix(u64 value) noexcept {
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdULL;
+    value ^= value >> 33;
+    value *= 0xc4ceb9fe1a85ec53ULL;
+    value ^= value >> 33;
+    return value;
+}
+
+CRC32C_TARGET u64 HashCrc32c(const u8* data, size_t size) noexcept {
+    const u8* const end = data + size;
+    u64 lane0 = LANE_SEEDS[0];
+    u64 lane1 = LANE_SEEDS[1];
+    u64 lane2 = LANE_SEEDS[2];
+    u64 lane3 = LANE_SEEDS[3];
+    for (; end - data >= 32; data += 32) {
+        lane0 = Crc32c(lane0, Load64(data));
+        lane1 = Crc32c(lane1, Load64(data + 8));
+        lane2 = Crc32c(lane2, Load64(data + 16));
+        lane3 = Crc32c(lane3, Load64(data + 24));
+    }
+    if (end - data >= 8) {
+        lane0 = Crc32c(lane0, Load64(data));
+        data += 8;
+    }
+    if (end - data >= 8) {
+        lane1 = Crc32c(lane1, Load64(data));
+        data += 8;
+    }
+    if (end - data >= 8) {
+        lane2 = Crc32c(lane2, Load64(data));
+        data += 8;
+    }
+    if (data != end) {
+        // Reread the last 8 bytes when possible instead of copying the remaining ones
+        u64 tail = 0;
+        if (size >= 8) {
+            tail = Load64(end - 8);
+        } else {
+            std::memcpy(&tail, data, size);
+        }
+        lane3 = Crc32c(lane3, tail);
+    }
+    // Lanes don't overlap and the halves are mixed separately, so the linear CRC differences
+    // of distinct lanes can't cancel out
+    const u64 low = lane0 | (lane1 << 32);
+    const u64 high = lane2 | (lane3 << 32);
+    return Mix(low ^ Mix(high ^ (size * 0x9e3779b97f4a7c15ULL)));
+}
+#endif
+
+} // Anonymous namespace
+
+u64 HashBytes(const void* data, size_t size) noexcept {
+#ifdef CRC32C_TARGET
+    // CityHash has faster paths for short inputs
+    if (has_crc32c && size > 32) {
+        return HashCrc32c(static_cast<const u8*>(data), size);
+    }
+#endif
+    return CityHash64(static_cast<const char*>(data), size);
+}
+
+} // namespace Common
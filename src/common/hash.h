@@ -7,8 +7,14 @@
 #include <utility>
 #include <boost/functional/hash.hpp>
 
+#include "common/common_types.h"
+
 namespace Common {
 
+/// Hashes memory for in-memory lookups such as hash table keys. CRC32C instructions are used when
+/// the host has them, so results differ between hosts: persisted hashes must use CityHash.
+[[nodiscard]] u64 HashBytes(const void* data, size_t size) noexcept;
+
 struct PairHash {
     template <class T1, class T2>
     std::size_t operator()(const std::pair<T1, T2>& pair) const noexcept {
@@ -103,58 +103,67 @@ void HeapTracker::Unmap(size_t virtual_offset, size_t size, bool is_separate_hea
 void HeapTracker::Protect(size_t virtual_offset, size_t size, MemoryPermission perm) {
     // Ensure no rebuild occurs while reprotecting.
     std::shared_lock lk{m_rebuild_lock};
+    std::scoped_lock lk2{m_lock};
 
     // Split at the boundaries of the region we are reprotecting.
-    this->SplitHeapMap(virtual_offset, size);
+    this->SplitHeapMapLocked(virtual_offset);
+    this->SplitHeapMapLocked(virtual_offset + size);
 
     // Declare tracking variables.
     const VAddr end = virtual_offset + size;
     VAddr cur = virtual_offset;
 
+    // Adjacent ranges needing protection are merged, so that each run takes a single host call.
+    VAddr protect_begin = cur;
+    const auto flush = [&] {
+        if (protect_begin < cur) {
+            m_buffer.Protect(protect_begin, cur - protect_begin, perm);
+        }
+    };
+
     while (cur < end) {
         VAddr next = cur;
         bool should_protect = false;
 
-        {
-            std::scoped_lock lk2{m_lock};
-
-            const SeparateHeapMap key{
-                .vaddr = next,
-            };
-
-            // Try to get the next mapping corresponding to this address.
-            const auto it = m_mappings.nfind(key);
-
-            if (it == m_mappings.end()) {
-                // There are no separate heap mappings remaining.
-                next = end;
-                should_protect = true;
-            } else if (it->vaddr == cur) {
-                // We are in range.
-                // Update permission bits.
-                it->perm = perm;
-
-                // Determine next address and whether we should protect.
-                next = cur + it->size;
-                should_protect = it->is_resident;
-            } else /* if (it->vaddr > cur) */ {
-                // We weren't in range, but there is a block coming up that will be.
-                next = it->vaddr;
-                should_protect = true;
-            }
+        const SeparateHeapMap key{
+            .vaddr = next,
+        };
+
+        // Try to get the next mapping corresponding to this address.
+        const auto it = m_mappings.nfind(key);
+
+        if (it == m_mappings.end()) {
+            // There are no separate heap mappings remaining.
+            next = end;
+            should_protect = true;
+        } else if (it->vaddr == cur) {
+            // We are in range.
+            // Update permission bits.
+            it->perm = perm;
+
+            // Determine next address and whether we should protect.
+            next = cur + it->size;
+            should_protect = it->is_resident;
+        } else /* if (it->vaddr > cur) */ {
+            // We weren't in range, but there is a block coming up that will be.
+            next = it->vaddr;
+            should_protect = true;
         }
 
         // Clamp to end.
         next = std::min(next, end);
 
-        // Reprotect, if we need to.
-        if (should_protect) {
-            m_buffer.Protect(cur, next - cur, perm);
+        // Reprotect the pending run when reaching a range that must be left alone.
+        if (!should_protect) {
+            flush();
+            protect_begin = next;
         }
 
         // Advance.
         cur = next;
     }
+
+    flush();
 }
 
 bool HeapTracker::DeferredMapSeparateHeap(u8* fault_address) {
@@ -227,13 +236,6 @@ void HeapTracker::RebuildSeparateHeapAddressSpace() {
     }
 }
 
-void HeapTracker::SplitHeapMap(VAddr offset, size_t size) {
-    std::scoped_lock lk{m_lock};
-
-    this->SplitHeapMapLocked(offset);
-    this->SplitHeapMapLocked(offset + size);
-}
-
 void HeapTracker::SplitHeapMapLocked(VAddr offset) {
     const auto it = this->GetNearestHeapMapLocked(offset);
     if (it == m_mappings.end() || it->vaddr == offset) {
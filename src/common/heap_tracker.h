@@ -77,7 +77,6 @@ private:
     TickTree m_resident_mappings{};
 
 private:
-    void SplitHeapMap(VAddr offset, size_t size);
     void SplitHeapMapLocked(VAddr offset);
 
     AddrTree::iterator GetNearestHeapMapLocked(VAddr offset);
@@ -14,6 +14,9 @@
 #ifndef _GNU_SOURCE
 #define _GNU_SOURCE
 #endif
+#include <atomic>
+#include <fstream>
+#include <string>
 #include <boost/icl/interval_set.hpp>
 #include <fcntl.h>
 #include <sys/mman.h>
@@ -477,6 +480,10 @@ public:
         }
 #if defined(__linux__)
         madvise(virtual_base, virtual_size, MADV_HUGEPAGE);
+        // Accesses through the backing pointer allocate the shared memory pages too
+        madvise(backing_base, backing_size, MADV_HUGEPAGE);
+        LOG_INFO(HW_Memory, "Transparent huge pages for shared memory: {}",
+                 ReadShmemHugePagePolicy());
 #endif
 
         free_manager.SetAddressSpace(virtual_base, virtual_size);
@@ -484,6 +491,14 @@ public:
     }
 
     ~Impl() {
+#if defined(__linux__)
+        const size_t mapped = mapped_bytes.load(std::memory_order_relaxed);
+        if (mapped != 0) {
+            const size_t huge = huge_mapped_bytes.load(std::memory_order_relaxed);
+            LOG_INFO(HW_Memory, "{} of {} MiB of fastmem mappings were huge page aligned ({}%)",
+                     huge >> 20, mapped >> 20, huge * 100 / mapped);
+        }
+#endif
         Release();
     }
 
@@ -511,6 +526,9 @@ public:
         void* ret = mmap(virtual_base + virtual_offset, length, flags, MAP_SHARED | MAP_FIXED, fd,
                          host_offset);
         ASSERT_MSG(ret != MAP_FAILED, "mmap failed: {}", strerror(errno));
+#if defined(__linux__)
+        AdviseHugePages(virtual_base + virtual_offset, host_offset, length);
+#endif
     }
 
     void Unmap(size_t virtual_offset, size_t length) {
@@ -613,6 +631,44 @@ private:
         }
     }
 
+#if defined(__linux__)
+    /// Returns the active shmem_enabled setting, which decides if memfd pages can be huge
+    static std::string ReadShmemHugePagePolicy() {
+        std::ifstream file{"/sys/kernel/mm/transparent_hugepage/shmem_enabled"};
+        std::string policy;
+        while (file >> policy) {
+            // The active setting is the one written as [setting]
+            if (policy.size() > 2 && policy.front() == '[' && policy.back() == ']') {
+                return policy.substr(1, policy.size() - 2);
+            }
+        }
+        return "unavailable";
+    }
+
+    /**
+     * Re-applies the huge page hint on a fresh fastmem mapping, MAP_FIXED replaces the advised
+     * reservation. The kernel can only map a huge page of the backing file with a single page
+     * table entry when the virtual address and the file offset share their 2 MiB alignment.
+     */
+    void AdviseHugePages(u8* pointer, size_t host_offset, size_t length) {
+        mapped_bytes.fetch_add(length, std::memory_order_relaxed);
+        const uintptr_t address = reinterpret_cast<uintptr_t>(pointer);
+        if (address % HugePageSize != host_offset % HugePageSize) {
+            return;
+        }
+        const uintptr_t huge_begin = AlignUp(address, HugePageSize);
+        const uintptr_t huge_end = AlignDown(address + length, HugePageSize);
+        if (huge_begin >= huge_end) {
+            return;
+        }
+        madvise(pointer, length, MADV_HUGEPAGE);
+        huge_mapped_bytes.fetch_add(huge_end - huge_begin, std::memory_order_relaxed);
+    }
+
+    std::atomic<size_t> mapped_bytes{};      ///< Bytes mapped into the fastmem region
+    std::atomic<size_t> huge_mapped_bytes{}; ///< Bytes of mappings that can use huge pages
+#endif
+
     int fd{-1}; // memfd file descriptor, -1 is the error value of memfd_create
     FreeRegionManager free_manager{};
 };
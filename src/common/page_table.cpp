@@ -31,12 +31,12 @@ bool PageTable::ContinueTraversal(TraversalEntry* out_entry, TraversalContext* c
 
     // Validate that we can read the actual entry.
     const auto page = context->next_page;
-    if (page >= backing_addr.size()) {
+    if (page >= backing.size()) {
         return false;
     }
 
     // Validate that the entry is mapped.
-    const auto phys_addr = backing_addr[page];
+    const auto phys_addr = backing.Get(page).backing_addr;
     if (phys_addr == 0) {
         return false;
     }
@@ -51,10 +51,27 @@ void PageTable::Resize(std::size_t address_space_width_in_bits, std::size_t page
     const std::size_t num_page_table_entries{1ULL
                                              << (address_space_width_in_bits - page_size_in_bits)};
     pointers.resize(num_page_table_entries);
-    backing_addr.resize(num_page_table_entries);
-    blocks.resize(num_page_table_entries);
+    backing.Resize(num_page_table_entries);
     current_address_space_width_in_bits = address_space_width_in_bits;
     page_size = 1ULL << page_size_in_bits;
 }
 
+void PageTable::BackingTable::Set(std::size_t page, const BackingEntry& entry) {
+    std::unique_ptr<Chunk>& chunk = chunks[page >> CHUNK_BITS];
+    if (!chunk) {
+        if (entry.backing_addr == 0 && entry.block == 0) {
+            // Unallocated chunks already read as unmapped
+            return;
+        }
+        chunk = std::make_unique<Chunk>();
+    }
+    (*chunk)[page & (CHUNK_SIZE - 1)] = entry;
+}
+
+void PageTable::BackingTable::Resize(std::size_t num_pages) {
+    chunks.clear();
+    chunks.resize((num_pages + CHUNK_SIZE - 1) >> CHUNK_BITS);
+    num_entries = num_pages;
+}
+
 } // namespace Common
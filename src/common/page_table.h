@@ -3,7 +3,10 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
+#include <memory>
+#include <vector>
 
 #include "common/common_types.h"
 #include "common/typed_address.h"
@@ -92,6 +95,48 @@ struct PageTable {
         std::atomic<uintptr_t> raw;
     };
 
+    /// Physical backing of a page and the base address of the block it was mapped with
+    struct BackingEntry {
+        u64 backing_addr{};
+        u64 block{};
+    };
+
+    /**
+     * Sparse table of page backings. Unlike `pointers`, it isn't read by the JIT, so it can trade
+     * a level of indirection for only allocating chunks with mapped pages instead of reserving it
+     * for the whole address space.
+     */
+    class BackingTable {
+    public:
+        static constexpr std::size_t CHUNK_BITS = 9;
+        static constexpr std::size_t CHUNK_SIZE = 1ULL << CHUNK_BITS;
+
+        /// Returns the backing of a page, empty if the page has never been mapped
+        [[nodiscard]] BackingEntry Get(std::size_t page) const noexcept {
+            if (page >= num_entries) {
+                return {};
+            }
+            const Chunk* const chunk = chunks[page >> CHUNK_BITS].get();
+            return chunk ? (*chunk)[page & (CHUNK_SIZE - 1)] : BackingEntry{};
+        }
+
+        /// Sets the backing of a page, allocating its chunk if needed
+        void Set(std::size_t page, const BackingEntry& entry);
+
+        /// Resizes the table to a number of pages, dropping all backings
+        void Resize(std::size_t num_pages);
+
+        [[nodiscard]] std::size_t size() const noexcept {
+            return num_entries;
+        }
+
+    private:
+        using Chunk = std::array<BackingEntry, CHUNK_SIZE>;
+
+        std::vector<std::unique_ptr<Chunk>> chunks;
+        std::size_t num_entries{};
+    };
+
     PageTable();
     ~PageTable() noexcept;
 
@@ -124,18 +169,18 @@ struct PageTable {
             return false;
         }
 
-        *out_phys_addr = backing_addr[virt_addr / page_size] + GetInteger(virt_addr);
+        *out_phys_addr = backing.Get(virt_addr / page_size).backing_addr + GetInteger(virt_addr);
         return true;
     }
 
     /**
      * Vector of memory pointers backing each page. An entry can only be non-null if the
-     * corresponding attribute element is of type `Memory`.
+     * corresponding attribute element is of type `Memory`. Kept flat, as the JIT indexes it
+     * directly.
      */
     VirtualBuffer<PageInfo> pointers;
-    VirtualBuffer<u64> blocks;
 
-    VirtualBuffer<u64> backing_addr;
+    BackingTable backing;
 
     std::size_t current_address_space_width_in_bits{};
 
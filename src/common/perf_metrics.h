@@ -0,0 +1,101 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <limits>
+#include <optional>
+
+#include "common/common_types.h"
+
+/// Process-wide performance counters sampled by Core::PerfStats. Updates are wait-free, so they
+/// can be made from any thread, including realtime audio threads.
+namespace Common::PerfMetrics {
+
+/// Counters accumulated between samples
+enum class Counter : u32 {
+    Core0IdleNs,
+    Core1IdleNs,
+    Core2IdleNs,
+    Core3IdleNs,
+    GpuThreadBusyNs,
+    RenderWorkerBusyNs,
+    PipelinesBuilt,
+    StagingBytes,
+    TextureEvictions,
+    Count,
+};
+
+/// Values where only the smallest one between samples is of interest
+enum class Minimum : u32 {
+    AdspDeadlineMarginUs,
+    Count,
+};
+
+/// Values where only the latest one is of interest
+enum class Gauge : u32 {
+    DeviceMemoryBudget,
+    DeviceMemoryUsage,
+    TextureCacheMemory,
+    TextureCacheBudget,
+    BufferCacheMemory,
+    BufferCacheBudget,
+    StagingPoolMemory,
+    StagingPoolBudget,
+    Count,
+};
+
+namespace Detail {
+struct MinimumValue {
+    std::atomic<s64> value{std::numeric_limits<s64>::max()};
+};
+
+inline std::array<std::atomic<u64>, static_cast<size_t>(Counter::Count)> counters{};
+inline std::array<MinimumValue, static_cast<size_t>(Minimum::Count)> minimums{};
+inline std::array<std::atomic<u64>, static_cast<size_t>(Gauge::Count)> gauges{};
+} // namespace Detail
+
+/// Returns the idle counter of an emulated core
+[[nodiscard]] constexpr Counter CoreIdleCounter(size_t core) {
+    return static_cast<Counter>(static_cast<size_t>(Counter::Core0IdleNs) + core);
+}
+
+inline void Add(Counter counter, u64 value) {
+    Detail::counters[static_cast<size_t>(counter)].fetch_add(value, std::memory_order_relaxed);
+}
+
+inline void RecordMinimum(Minimum minimum, s64 value) {
+    auto& current{Detail::minimums[static_cast<size_t>(minimum)].value};
+    s64 expected{current.load(std::memory_order_relaxed)};
+    while (value < expected &&
+           !current.compare_exchange_weak(expected, value, std::memory_order_relaxed)) {
+    }
+}
+
+inline void Set(Gauge gauge, u64 value) {
+    Detail::gauges[static_cast<size_t>(gauge)].store(value, std::memory_order_relaxed);
+}
+
+/// Returns the counter accumulated since the previous call and resets it
+[[nodiscard]] inline u64 Take(Counter counter) {
+    return Detail::counters[static_cast<size_t>(counter)].exchange(0, std::memory_order_relaxed);
+}
+
+/// Returns the smallest value recorded since the previous call, if any, and resets it
+[[nodiscard]] inline std::optional<s64> Take(Minimum minimum) {
+    const s64 value{Detail::minimums[static_cast<size_t>(minimum)].value.exchange(
+        std::numeric_limits<s64>::max(), std::memory_order_relaxed)};
+    if (value == std::numeric_limits<s64>::max()) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+/// Returns the latest value of a gauge, it is not reset
+[[nodiscard]] inline u64 Get(Gauge gauge) {
+    return Detail::gauges[static_cast<size_t>(gauge)].load(std::memory_order_relaxed);
+}
+
+} // namespace Common::PerfMetrics
@@ -0,0 +1,194 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <thread>
+#include <utility>
+
+#ifdef _WIN32
+#include <windows.h>
+#elif defined(__linux__)
+#include <cerrno>
+#include <ctime>
+#endif
+
+#include "common/logging/log.h"
+#include "common/precise_wait.h"
+#include "common/thread.h"
+
+#ifdef ARCHITECTURE_x86_64
+#include "common/x64/cpu_wait.h"
+#endif
+
+// Defines for compatibility with older Windows 10 SDKs.
+#if defined(_WIN32) && !defined(CREATE_WAITABLE_TIMER_HIGH_RESOLUTION)
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x2
+#endif
+
+namespace Common {
+
+namespace {
+
+using namespace std::chrono_literals;
+
+#ifdef _WIN32
+constexpr auto DEFAULT_MIN_SPIN_MARGIN = 500us;
+#else
+constexpr auto DEFAULT_MIN_SPIN_MARGIN = 100us;
+#endif
+
+// Upper bound of the spun margin, late wake ups past it are preemption rather than timer slack
+constexpr auto MAX_SPIN_MARGIN = 2ms;
+
+// Longest sleep between checks of the event on Windows
+[[maybe_unused]] constexpr auto MAX_SLEEP_SLICE = 1ms;
+
+// MicroSleep waits a fixed number of cycles, shorter waits could overshoot with it
+[[maybe_unused]] constexpr auto MIN_MICRO_SLEEP_TIME = 100us;
+
+constexpr auto STATS_INTERVAL = 10s;
+
+void Pause([[maybe_unused]] std::chrono::nanoseconds remaining) {
+#ifdef ARCHITECTURE_x86_64
+    if (remaining >= MIN_MICRO_SLEEP_TIME) {
+        X64::MicroSleep();
+        return;
+    }
+#endif
+    std::this_thread::yield();
+}
+
+} // Anonymous namespace
+
+PreciseWaiter::PreciseWaiter(std::string name_)
+    : name{std::move(name_)}, min_spin_margin{DEFAULT_MIN_SPIN_MARGIN} {
+#ifdef _WIN32
+    timer_handle = CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION,
+                                          TIMER_ALL_ACCESS);
+    if (!timer_handle) {
+        // High resolution timers need Windows 10 1803 or newer
+        timer_handle = CreateWaitableTimerExW(nullptr, nullptr, 0, TIMER_ALL_ACCESS);
+    }
+#endif
+}
+
+PreciseWaiter::~PreciseWaiter() {
+#ifdef _WIN32
+    if (timer_handle) {
+        CloseHandle(timer_handle);
+    }
+#endif
+}
+
+void PreciseWaiter::WaitUntil(Clock::time_point deadline) {
+    const Clock::time_point spin_begin = SpinBegin(deadline);
+    if (Clock::now() < spin_begin) {
+        SleepUntil(spin_begin);
+    }
+    auto now = Clock::now();
+    while (now < deadline) {
+        Pause(deadline - now);
+        now = Clock::now();
+    }
+    RecordWait(deadline, now);
+}
+
+bool PreciseWaiter::WaitUntil(Clock::time_point deadline, Event& event) {
+    const Clock::time_point spin_begin = SpinBegin(deadline);
+    auto now = Clock::now();
+#ifdef _WIN32
+    // Condition variable waits are only as precise as the system timer, sleep in short slices on
+    // the high resolution timer instead and check the event between them
+    while (now < spin_begin) {
+        if (event.IsSet()) {
+            event.Reset();
+            return true;
+        }
+        SleepUntil(std::min<Clock::time_point>(spin_begin, now + MAX_SLEEP_SLICE));
+        now = Clock::now();
+    }
+#else
+    if (now < spin_begin) {
+        if (event.WaitUntil(spin_begin)) {
+            return true;
+        }
+        now = Clock::now();
+        RecordOversleep(now - spin_begin);
+    }
+#endif
+    while (now < deadline) {
+        if (event.IsSet()) {
+            event.Reset();
+            return true;
+        }
+        Pause(deadline - now);
+        now = Clock::now();
+    }
+    RecordWait(deadline, now);
+    return false;
+}
+
+void PreciseWaiter::SetMinimumSpinMargin(std::chrono::nanoseconds margin) {
+    min_spin_margin = std::min<std::chrono::nanoseconds>(margin, MAX_SPIN_MARGIN);
+}
+
+void PreciseWaiter::SleepUntil(Clock::time_point time) {
+    const auto sleep_time =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(time - Clock::now());
+#ifdef _WIN32
+    LARGE_INTEGER due_time{};
+    // Negative due times are relative, in 100ns units
+    due_time.QuadPart = -std::max<LONGLONG>(sleep_time.count() / 100, 1);
+    if (timer_handle && SetWaitableTimer(timer_handle, &due_time, 0, nullptr, nullptr, FALSE)) {
+        WaitForSingleObject(timer_handle, INFINITE);
+    } else {
+        std::this_thread::sleep_for(sleep_time);
+    }
+#elif defined(__linux__)
+    timespec remaining{
+        .tv_sec = static_cast<time_t>(sleep_time.count() / 1'000'000'000),
+        .tv_nsec = static_cast<long>(sleep_time.count() % 1'000'000'000),
+    };
+    while (clock_nanosleep(CLOCK_MONOTONIC, 0, &remaining, &remaining) == EINTR) {
+    }
+#else
+    std::this_thread::sleep_for(sleep_time);
+#endif
+    RecordOversleep(Clock::now() - time);
+}
+
+void PreciseWaiter::RecordOversleep(Clock::duration oversleep) {
+    // Preemptions are clamped, they would leave a large margin spinning for a long time
+    const s64 oversleep_ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::clamp<Clock::duration>(oversleep, Clock::duration::zero(), MAX_SPIN_MARGIN))
+            .count();
+    average_oversleep_ns += (oversleep_ns - average_oversleep_ns) / 8;
+}
+
+PreciseWaiter::Clock::time_point PreciseWaiter::SpinBegin(Clock::time_point deadline) const {
+    const auto margin = std::clamp<std::chrono::nanoseconds>(
+        std::chrono::nanoseconds{average_oversleep_ns * 2}, min_spin_margin, MAX_SPIN_MARGIN);
+    return deadline - margin;
+}
+
+void PreciseWaiter::RecordWait(Clock::time_point deadline, Clock::time_point now) {
+    const s64 lateness_ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(now - deadline).count();
+    ++num_waits;
+    total_lateness_ns += lateness_ns;
+    max_lateness_ns = std::max(max_lateness_ns, lateness_ns);
+    if (now - stats_begin < STATS_INTERVAL) {
+        return;
+    }
+    LOG_DEBUG(Common, "{}: {} waits, late by {:.1f} us on average and {:.1f} us at most",
+              name, num_waits,
+              static_cast<double>(total_lateness_ns) / static_cast<double>(num_waits) / 1000.0,
+              static_cast<double>(max_lateness_ns) / 1000.0);
+    stats_begin = now;
+    num_waits = 0;
+    total_lateness_ns = 0;
+    max_lateness_ns = 0;
+}
+
+} // namespace Common
@@ -0,0 +1,70 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <chrono>
+#include <string>
+
+#include "common/common_types.h"
+
+namespace Common {
+
+class Event;
+
+/**
+ * Waits until deadlines more precisely than plain OS sleeps. Most of a wait is spent sleeping on
+ * a high resolution OS timer, the last stretch is spun with low power wait instructions. The spun
+ * margin adapts to how late the OS timer has been waking up.
+ *
+ * A waiter is meant to be used from a single thread.
+ */
+class PreciseWaiter {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit PreciseWaiter(std::string name);
+    ~PreciseWaiter();
+
+    PreciseWaiter(const PreciseWaiter&) = delete;
+    PreciseWaiter& operator=(const PreciseWaiter&) = delete;
+
+    /// Waits until the deadline.
+    void WaitUntil(Clock::time_point deadline);
+
+    /// Waits until the deadline or until the event is set, returns true when the event was set.
+    bool WaitUntil(Clock::time_point deadline, Event& event);
+
+    /// Sets the shortest margin spun before deadlines, e.g. the period of the OS timer.
+    void SetMinimumSpinMargin(std::chrono::nanoseconds margin);
+
+private:
+    /// Sleeps on the OS timer until about the given time, recording how late it woke up.
+    void SleepUntil(Clock::time_point time);
+
+    /// Updates the spin margin with how late an OS sleep or wait woke up.
+    void RecordOversleep(Clock::duration oversleep);
+
+    /// Returns the time spin waiting should start at for a deadline.
+    Clock::time_point SpinBegin(Clock::time_point deadline) const;
+
+    /// Records how late a wait returned, logging the stats periodically.
+    void RecordWait(Clock::time_point deadline, Clock::time_point now);
+
+    std::string name;
+
+#ifdef _WIN32
+    void* timer_handle{};
+#endif
+
+    std::chrono::nanoseconds min_spin_margin;
+    /// Moving average of the OS timer lateness, in nanoseconds
+    s64 average_oversleep_ns{};
+
+    Clock::time_point stats_begin = Clock::now();
+    u64 num_waits{};
+    s64 total_lateness_ns{};
+    s64 max_lateness_ns{};
+};
+
+} // namespace Common
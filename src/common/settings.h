@@ -189,6 +189,9 @@ struct Values {
         linkage, false, "audio_muted", Category::Audio, Specialization::Default, true, true};
     Setting<bool, false> dump_audio_commands{
         linkage, false, "dump_audio_commands", Category::Audio, Specialization::Default, false};
+    Setting<bool> audio_host_timing{linkage, false, "audio_host_timing", Category::Audio};
+    Setting<bool> audio_low_latency{linkage, false, "audio_low_latency", Category::Audio};
+    Setting<bool> audio_time_stretch{linkage, false, "audio_time_stretch", Category::Audio};
 
     // Core
     SwitchableSetting<bool> use_multi_core{linkage, true, "use_multi_core", Category::Core};
@@ -210,6 +213,8 @@ struct Values {
                                              true,
                                              true,
                                              &use_speed_limit};
+    // Measured in MiB per opened romfs, 0 disables the cache of decrypted romfs blocks
+    Setting<u16, true> romfs_cache_size{linkage, 64, 0, 4096, "romfs_cache_size", Category::Core};
 
     // Cpu
     SwitchableSetting<CpuBackend, true> cpu_backend{linkage,
@@ -384,6 +389,10 @@ struct Values {
                                                                   AstcRecompression::Bc3,
                                                                   "astc_recompression",
                                                                   Category::RendererAdvanced};
+    Setting<bool> use_astc_transcode_cache{linkage, false, "use_astc_transcode_cache",
+                                           Category::RendererAdvanced};
+    Setting<bool> use_sparse_image_residency{linkage, false, "use_sparse_image_residency",
+                                             Category::RendererAdvanced};
     SwitchableSetting<VramUsageMode, true> vram_usage_mode{linkage,
                                                            VramUsageMode::Conservative,
                                                            VramUsageMode::Conservative,
@@ -397,8 +406,14 @@ struct Values {
                                                false,
 #endif
                                                "async_presentation", Category::RendererAdvanced};
+    SwitchableSetting<bool> frame_pacing{linkage, false, "frame_pacing",
+                                         Category::RendererAdvanced};
+    SwitchableSetting<bool> low_latency_mode{linkage, false, "low_latency_mode",
+                                             Category::RendererAdvanced};
     SwitchableSetting<bool> renderer_force_max_clock{linkage, false, "force_max_clock",
                                                      Category::RendererAdvanced};
+    Setting<bool> use_parallel_command_recording{linkage, false, "use_parallel_command_recording",
+                                                 Category::RendererAdvanced};
     SwitchableSetting<bool> use_reactive_flushing{linkage,
 #ifdef ANDROID
                                                   false,
@@ -409,6 +424,14 @@ struct Values {
                                                   Category::RendererAdvanced};
     SwitchableSetting<bool> use_asynchronous_shaders{linkage, false, "use_asynchronous_shaders",
                                                      Category::RendererAdvanced};
+    SwitchableSetting<bool> use_async_fallback_pipelines{
+        linkage, true, "use_async_fallback_pipelines", Category::RendererAdvanced};
+    Setting<bool> use_graphics_pipeline_library{linkage, true, "use_graphics_pipeline_library",
+                                                Category::RendererAdvanced};
+    Setting<bool> use_async_transfer_queue{linkage, false, "use_async_transfer_queue",
+                                           Category::RendererAdvanced};
+    Setting<bool> use_shader_cbuf_specialization{linkage, false, "use_shader_cbuf_specialization",
+                                                 Category::RendererAdvanced};
     SwitchableSetting<bool> use_fast_gpu_time{
         linkage, true, "use_fast_gpu_time", Category::RendererAdvanced, Specialization::Default,
         true,    true};
@@ -433,6 +456,10 @@ struct Values {
                                           Category::RendererDebug};
     Setting<bool> disable_shader_loop_safety_checks{
         linkage, false, "disable_shader_loop_safety_checks", Category::RendererDebug};
+    Setting<bool> disable_shader_gvn{linkage, false, "disable_shader_gvn",
+                                     Category::RendererDebug};
+    Setting<bool> disable_shader_licm{linkage, false, "disable_shader_licm",
+                                      Category::RendererDebug};
     Setting<bool> enable_renderdoc_hotkey{linkage, false, "renderdoc_hotkey",
                                           Category::RendererDebug};
     Setting<bool> disable_buffer_reorder{linkage, false, "disable_buffer_reorder",
@@ -505,6 +532,8 @@ struct Values {
     Setting<bool> controller_navigation{linkage, true, "controller_navigation", Category::Controls};
     Setting<bool> enable_joycon_driver{linkage, true, "enable_joycon_driver", Category::Controls};
     Setting<bool> enable_procon_driver{linkage, false, "enable_procon_driver", Category::Controls};
+    Setting<bool> immediate_hid_updates{linkage, false, "immediate_hid_updates",
+                                        Category::Controls};
 
     SwitchableSetting<bool> vibration_enabled{linkage, true, "vibration_enabled",
                                               Category::Controls};
@@ -583,7 +612,20 @@ struct Values {
         false};
     Setting<bool> dump_macros{
         linkage, false, "dump_macros", Category::DebuggingGraphics, Specialization::Default, false};
+    Setting<bool> profile_macros{linkage, false, "profile_macros", Category::DebuggingGraphics,
+                                 Specialization::Default, false};
+    Setting<bool> profile_shader_compilation{linkage, false, "profile_shader_compilation",
+                                             Category::DebuggingGraphics, Specialization::Default,
+                                             false};
+    Setting<bool> profile_gpu_timestamps{linkage, false, "profile_gpu_timestamps",
+                                         Category::DebuggingGraphics, Specialization::Default,
+                                         false};
     Setting<bool> enable_fs_access_log{linkage, false, "enable_fs_access_log", Category::Debugging};
+    Setting<bool> profile_guest_cpu{linkage, false, "profile_guest_cpu", Category::Debugging,
+                                    Specialization::Default, false};
+    Setting<bool> enable_tracing{linkage, false, "enable_tracing", Category::Debugging,
+                                 Specialization::Default, false};
+    Setting<bool> show_perf_metrics{linkage, false, "show_perf_metrics", Category::Debugging};
     Setting<bool> reporting_services{
         linkage, false, "reporting_services", Category::Debugging, Specialization::Default, false};
     Setting<bool> quest_flag{linkage, false, "quest_flag", Category::Debugging};
@@ -591,6 +633,8 @@ struct Values {
                                     Category::DebuggingGraphics};
     Setting<bool> disable_macro_hle{linkage, false, "disable_macro_hle",
                                     Category::DebuggingGraphics};
+    Setting<bool> record_cache_traces{linkage, false, "record_cache_traces",
+                                      Category::DebuggingGraphics};
     Setting<bool> extended_logging{
         linkage, false, "extended_logging", Category::Debugging, Specialization::Default, false};
     Setting<bool> use_debug_asserts{linkage, false, "use_debug_asserts", Category::Debugging};
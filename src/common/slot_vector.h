@@ -5,7 +5,7 @@
 
 #include <algorithm>
 #include <bit>
-#include <numeric>
+#include <memory>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -18,6 +18,8 @@ namespace Common {
 
 struct SlotId {
     static constexpr u32 INVALID_INDEX = std::numeric_limits<u32>::max();
+    static constexpr u32 SLOT_BITS = 24;
+    static constexpr u32 SLOT_MASK = (1U << SLOT_BITS) - 1;
 
     constexpr auto operator<=>(const SlotId&) const noexcept = default;
 
@@ -25,7 +27,17 @@ struct SlotId {
         return index != INVALID_INDEX;
     }
 
-    u32 index = INVALID_INDEX;
+    /// Returns the position of the object in its slot vector
+    [[nodiscard]] constexpr u32 Slot() const noexcept {
+        return index & SLOT_MASK;
+    }
+
+    /// Returns how many times the slot had been reused when this id was handed out
+    [[nodiscard]] constexpr u32 Generation() const noexcept {
+        return index >> SLOT_BITS;
+    }
+
+    u32 index = INVALID_INDEX; ///< Slot in the low bits, generation in the high bits
 };
 
 template <class T>
@@ -39,16 +51,23 @@ public:
         constexpr Iterator() = default;
 
         Iterator& operator++() noexcept {
-            const u64* const bitset = slot_vector->stored_bitset.data();
-            const u32 size = static_cast<u32>(slot_vector->stored_bitset.size()) * 64;
-            if (id.index < size) {
-                do {
-                    ++id.index;
-                } while (id.index < size && !IsValid(bitset));
-                if (id.index == size) {
-                    id.index = SlotId::INVALID_INDEX;
+            if (slot == SlotId::INVALID_INDEX) {
+                return *this;
+            }
+            bits &= bits - 1;
+            size_t word = slot / 64;
+            if (bits == 0) {
+                // Skip whole words of empty slots at a time
+                const std::vector<u64>& bitset = slot_vector->stored_bitset;
+                while (bits == 0 && ++word < bitset.size()) {
+                    bits = bitset[word];
+                }
+                if (bits == 0) {
+                    slot = SlotId::INVALID_INDEX;
+                    return *this;
                 }
             }
+            slot = static_cast<u32>(word * 64 + std::countr_zero(bits));
             return *this;
         }
 
@@ -59,90 +78,101 @@ public:
         }
 
         bool operator==(const Iterator& other) const noexcept {
-            return id.index == other.id.index;
+            return slot == other.slot;
         }
 
         bool operator!=(const Iterator& other) const noexcept {
-            return id.index != other.id.index;
+            return slot != other.slot;
         }
 
         std::pair<SlotId, T*> operator*() const noexcept {
-            return {id, std::addressof((*slot_vector)[id])};
+            return {slot_vector->MakeId(slot), std::addressof(slot_vector->GetEntry(slot).object)};
         }
 
         T* operator->() const noexcept {
-            return std::addressof((*slot_vector)[id]);
+            return std::addressof(slot_vector->GetEntry(slot).object);
         }
 
     private:
-        Iterator(SlotVector<T>* slot_vector_, SlotId id_) noexcept
-            : slot_vector{slot_vector_}, id{id_} {}
-
-        bool IsValid(const u64* bitset) const noexcept {
-            return ((bitset[id.index / 64] >> (id.index % 64)) & 1) != 0;
-        }
+        Iterator(SlotVector<T>* slot_vector_, u32 slot_, u64 bits_) noexcept
+            : slot_vector{slot_vector_}, slot{slot_}, bits{bits_} {}
 
         SlotVector<T>* slot_vector;
-        SlotId id;
+        u32 slot; ///< Raw slot, generations are only looked up when dereferencing
+        u64 bits; ///< Stored slots of the current word from this one onwards
     };
 
     ~SlotVector() noexcept {
-        size_t index = 0;
-        for (u64 bits : stored_bitset) {
-            for (size_t bit = 0; bits; ++bit, bits >>= 1) {
-                if ((bits & 1) != 0) {
-                    values[index + bit].object.~T();
-                }
+        for (size_t word = 0; word < stored_bitset.size(); ++word) {
+            for (u64 bits = stored_bitset[word]; bits != 0; bits &= bits - 1) {
+                chunks[word][std::countr_zero(bits)].object.~T();
             }
-            index += 64;
         }
-        delete[] values;
     }
 
     [[nodiscard]] T& operator[](SlotId id) noexcept {
         ValidateIndex(id);
-        return values[id.index].object;
+        return GetEntry(id.Slot()).object;
     }
 
     [[nodiscard]] const T& operator[](SlotId id) const noexcept {
         ValidateIndex(id);
-        return values[id.index].object;
+        return GetEntry(id.Slot()).object;
     }
 
     template <typename... Args>
     [[nodiscard]] SlotId insert(Args&&... args) noexcept {
-        const u32 index = FreeValueIndex();
-        new (&values[index].object) T(std::forward<Args>(args)...);
-        SetStorageBit(index);
+        const u32 slot = FreeSlot();
+        new (&GetEntry(slot).object) T(std::forward<Args>(args)...);
+        SetStorageBit(slot);
+        ++num_stored;
 
-        return SlotId{index};
+        return MakeId(slot);
     }
 
     void erase(SlotId id) noexcept {
-        values[id.index].object.~T();
-        free_list.push_back(id.index);
-        ResetStorageBit(id.index);
+        ValidateIndex(id);
+        const u32 slot = id.Slot();
+        GetEntry(slot).object.~T();
+        ResetStorageBit(slot);
+        // Ids handed out for the previous object are now stale
+        generations[slot] = static_cast<u8>(generations[slot] + 1);
+        first_free_word = std::min<size_t>(first_free_word, slot / 64);
+        --num_stored;
+    }
+
+    /// Releases the storage of chunks without objects, meant to run when the cache is idle.
+    /// Objects are never moved, so ids and references stay valid.
+    void Compact() noexcept {
+        for (size_t chunk = 0; chunk < chunks.size(); ++chunk) {
+            if (stored_bitset[chunk] == 0) {
+                chunks[chunk].reset();
+            }
+        }
     }
 
+    /// Iterates stored objects in slot order, objects must not be erased while iterating
     [[nodiscard]] Iterator begin() noexcept {
         const auto it = std::ranges::find_if(stored_bitset, [](u64 value) { return value != 0; });
         if (it == stored_bitset.end()) {
             return end();
         }
-        const u32 word_index = static_cast<u32>(std::distance(it, stored_bitset.begin()));
-        const SlotId first_id{word_index * 64 + static_cast<u32>(std::countr_zero(*it))};
-        return Iterator(this, first_id);
+        const u32 word_index = static_cast<u32>(std::distance(stored_bitset.begin(), it));
+        return Iterator(this, word_index * 64 + static_cast<u32>(std::countr_zero(*it)), *it);
     }
 
     [[nodiscard]] Iterator end() noexcept {
-        return Iterator(this, SlotId{SlotId::INVALID_INDEX});
+        return Iterator(this, SlotId::INVALID_INDEX, 0);
     }
 
     [[nodiscard]] size_t size() const noexcept {
-        return values_capacity - free_list.size();
+        return num_stored;
     }
 
 private:
+    /// Slots per chunk of storage, one chunk for each word of the bitset
+    static constexpr u32 CHUNK_SIZE = 64;
+
     struct NonTrivialDummy {
         NonTrivialDummy() noexcept {}
     };
@@ -155,66 +185,64 @@ private:
         T object;
     };
 
-    void SetStorageBit(u32 index) noexcept {
-        stored_bitset[index / 64] |= u64(1) << (index % 64);
+    [[nodiscard]] Entry& GetEntry(u32 slot) noexcept {
+        return chunks[slot / CHUNK_SIZE][slot % CHUNK_SIZE];
+    }
+
+    [[nodiscard]] const Entry& GetEntry(u32 slot) const noexcept {
+        return chunks[slot / CHUNK_SIZE][slot % CHUNK_SIZE];
     }
 
-    void ResetStorageBit(u32 index) noexcept {
-        stored_bitset[index / 64] &= ~(u64(1) << (index % 64));
+    [[nodiscard]] SlotId MakeId(u32 slot) const noexcept {
+        return SlotId{slot | (static_cast<u32>(generations[slot]) << SlotId::SLOT_BITS)};
     }
 
-    bool ReadStorageBit(u32 index) noexcept {
-        return ((stored_bitset[index / 64] >> (index % 64)) & 1) != 0;
+    void SetStorageBit(u32 slot) noexcept {
+        stored_bitset[slot / 64] |= u64(1) << (slot % 64);
+    }
+
+    void ResetStorageBit(u32 slot) noexcept {
+        stored_bitset[slot / 64] &= ~(u64(1) << (slot % 64));
     }
 
     void ValidateIndex(SlotId id) const noexcept {
         DEBUG_ASSERT(id);
-        DEBUG_ASSERT(id.index / 64 < stored_bitset.size());
-        DEBUG_ASSERT(((stored_bitset[id.index / 64] >> (id.index % 64)) & 1) != 0);
+        DEBUG_ASSERT(id.Slot() / 64 < stored_bitset.size());
+        DEBUG_ASSERT(((stored_bitset[id.Slot() / 64] >> (id.Slot() % 64)) & 1) != 0);
+        DEBUG_ASSERT_MSG(generations[id.Slot()] == id.Generation(), "Stale slot id {:#x}",
+                         id.index);
     }
 
-    [[nodiscard]] u32 FreeValueIndex() noexcept {
-        if (free_list.empty()) {
-            Reserve(values_capacity ? (values_capacity << 1) : 1);
+    [[nodiscard]] u32 FreeSlot() noexcept {
+        // Reuse the lowest free slots first to keep objects packed for iteration
+        while (first_free_word < stored_bitset.size() &&
+               stored_bitset[first_free_word] == ~u64(0)) {
+            ++first_free_word;
         }
-        const u32 free_index = free_list.back();
-        free_list.pop_back();
-        return free_index;
-    }
-
-    void Reserve(size_t new_capacity) noexcept {
-        Entry* const new_values = new Entry[new_capacity];
-        size_t index = 0;
-        for (u64 bits : stored_bitset) {
-            for (size_t bit = 0; bits; ++bit, bits >>= 1) {
-                const size_t i = index + bit;
-                if ((bits & 1) == 0) {
-                    continue;
-                }
-                T& old_value = values[i].object;
-                new (&new_values[i].object) T(std::move(old_value));
-                old_value.~T();
-            }
-            index += 64;
+        if (first_free_word == stored_bitset.size()) {
+            AddChunk();
         }
-
-        stored_bitset.resize((new_capacity + 63) / 64);
-
-        const size_t old_free_size = free_list.size();
-        free_list.resize(old_free_size + (new_capacity - values_capacity));
-        std::iota(free_list.begin() + old_free_size, free_list.end(),
-                  static_cast<u32>(values_capacity));
-
-        delete[] values;
-        values = new_values;
-        values_capacity = new_capacity;
+        if (!chunks[first_free_word]) {
+            chunks[first_free_word] = std::make_unique<Entry[]>(CHUNK_SIZE);
+        }
+        const u32 bit = static_cast<u32>(std::countr_one(stored_bitset[first_free_word]));
+        return static_cast<u32>(first_free_word) * CHUNK_SIZE + bit;
     }
 
-    Entry* values = nullptr;
-    size_t values_capacity = 0;
+    void AddChunk() noexcept {
+        // Keep the highest slots free so ids never alias INVALID_INDEX or sentinel ids
+        ASSERT((chunks.size() + 1) * CHUNK_SIZE < SlotId::SLOT_MASK);
+        chunks.push_back(std::make_unique<Entry[]>(CHUNK_SIZE));
+        stored_bitset.push_back(0);
+        generations.resize(generations.size() + CHUNK_SIZE);
+    }
 
+    // Storage is never reallocated, so objects don't move when the vector grows
+    std::vector<std::unique_ptr<Entry[]>> chunks;
+    std::vector<u8> generations;
     std::vector<u64> stored_bitset;
-    std::vector<u32> free_list;
+    size_t first_free_word = 0; ///< No word before this one has free slots
+    size_t num_stored = 0;
 };
 
 } // namespace Common
@@ -17,7 +17,7 @@
 #endif
 #endif
 
-namespace {
+namespace Common {
 
 void ThreadPause() {
 #if __x86_64__
@@ -29,10 +29,6 @@ void ThreadPause() {
 #endif
 }
 
-} // Anonymous namespace
-
-namespace Common {
-
 void SpinLock::lock() {
     while (lck.test_and_set(std::memory_order_acquire)) {
         ThreadPause();
@@ -0,0 +1,177 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include "common/task_scheduler.h"
+#include "common/thread.h"
+
+namespace Common {
+
+namespace {
+
+using namespace std::chrono_literals;
+
+// How often a worker waiting on a group looks for new tasks to run meanwhile
+constexpr auto WORKER_POLL_INTERVAL = 100us;
+
+thread_local const TaskScheduler* current_scheduler{};
+thread_local size_t current_worker{};
+
+} // Anonymous namespace
+
+TaskScheduler::TaskScheduler(size_t num_workers) {
+    workers.resize(std::max<size_t>(num_workers, 1));
+    for (auto& worker : workers) {
+        worker = std::make_unique<Worker>();
+    }
+    // Workers steal from each other, they can only start once all of them exist
+    for (size_t index = 0; index < workers.size(); ++index) {
+        workers[index]->thread = std::jthread(
+            [this, index](std::stop_token stop_token) { WorkerLoop(stop_token, index); });
+    }
+}
+
+TaskScheduler::~TaskScheduler() {
+    for (auto& worker : workers) {
+        worker->thread.request_stop();
+    }
+    for (auto& worker : workers) {
+        worker->thread.join();
+    }
+}
+
+TaskScheduler& TaskScheduler::Instance() {
+    // Leave a hardware thread to the emulation threads even when all the workers are busy
+    static TaskScheduler scheduler{std::max(std::thread::hardware_concurrency(), 2U) - 1};
+    return scheduler;
+}
+
+void TaskScheduler::Schedule(Task task, TaskPriority priority, size_t affinity_hint) {
+    size_t index;
+    if (affinity_hint != NoAffinity) {
+        index = affinity_hint % workers.size();
+    } else if (IsWorkerThread()) {
+        index = current_worker;
+    } else {
+        index = next_worker.fetch_add(1, std::memory_order_relaxed) % workers.size();
+    }
+    {
+        Worker& worker = *workers[index];
+        std::scoped_lock lock{worker.mutex};
+        worker.queues[static_cast<size_t>(priority)].push_back(std::move(task));
+    }
+    {
+        std::scoped_lock lock{sleep_mutex};
+        ++num_queued;
+    }
+    sleep_condition.notify_one();
+}
+
+bool TaskScheduler::TryRunPendingTask() {
+    Task task;
+    const bool is_worker = IsWorkerThread();
+    const size_t index = is_worker ? current_worker
+                                   : next_worker.fetch_add(1, std::memory_order_relaxed);
+    if (!PopTask(index % workers.size(), is_worker, task)) {
+        return false;
+    }
+    task();
+    return true;
+}
+
+bool TaskScheduler::IsWorkerThread() const {
+    return current_scheduler == this;
+}
+
+void TaskScheduler::WorkerLoop(std::stop_token stop_token, size_t index) {
+    const std::string name = "TaskWorker" + std::to_string(index);
+    SetCurrentThreadName(name.c_str());
+    SetCurrentThreadPriority(ThreadPriority::Low);
+    current_scheduler = this;
+    current_worker = index;
+
+    while (!stop_token.stop_requested()) {
+        Task task;
+        if (PopTask(index, true, task)) {
+            task();
+            continue;
+        }
+        std::unique_lock lock{sleep_mutex};
+        CondvarWait(sleep_condition, lock, stop_token, [this] { return num_queued > 0; });
+    }
+}
+
+bool TaskScheduler::PopTask(size_t index, bool is_owner, Task& task) {
+    const size_t num_workers = workers.size();
+    for (size_t priority = 0; priority < NUM_PRIORITIES; ++priority) {
+        for (size_t offset = 0; offset < num_workers; ++offset) {
+            Worker& worker = *workers[(index + offset) % num_workers];
+            std::scoped_lock lock{worker.mutex};
+            std::deque<Task>& queue = worker.queues[priority];
+            if (queue.empty()) {
+                continue;
+            }
+            // Owners run their newest task while its data is still in cache, thieves take the
+            // oldest, which is usually the start of a larger batch of work
+            if (is_owner && offset == 0) {
+                task = std::move(queue.back());
+                queue.pop_back();
+            } else {
+                task = std::move(queue.front());
+                queue.pop_front();
+            }
+            --num_queued;
+            return true;
+        }
+    }
+    return false;
+}
+
+TaskGroup::TaskGroup(TaskPriority priority_, TaskScheduler& scheduler_)
+    : scheduler{scheduler_}, priority{priority_} {}
+
+TaskGroup::~TaskGroup() {
+    Wait();
+}
+
+void TaskGroup::Run(UniqueFunction<void> task, size_t affinity_hint) {
+    {
+        std::scoped_lock lock{mutex};
+        ++num_pending;
+    }
+    scheduler.Schedule(
+        [this, task = std::move(task)] {
+            task();
+            // The group can be destroyed as soon as its last task is done, it is only notified
+            // under the lock so the waiter can't return before this is done with it
+            std::scoped_lock lock{mutex};
+            if (--num_pending == 0) {
+                condition.notify_all();
+            }
+        },
+        priority, affinity_hint);
+}
+
+void TaskGroup::Wait() {
+    const auto is_done = [this] { return num_pending == 0; };
+    std::unique_lock lock{mutex};
+    if (!scheduler.IsWorkerThread()) {
+        condition.wait(lock, is_done);
+        return;
+    }
+    // Blocking a worker could leave the tasks of the group without a thread to run them
+    while (!is_done()) {
+        lock.unlock();
+        const bool ran_task = scheduler.TryRunPendingTask();
+        lock.lock();
+        if (!ran_task) {
+            condition.wait_for(lock, WORKER_POLL_INTERVAL, is_done);
+        }
+    }
+}
+
+} // namespace Common
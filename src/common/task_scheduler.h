@@ -0,0 +1,119 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "common/common_types.h"
+#include "common/polyfill_thread.h"
+#include "common/unique_function.h"
+
+namespace Common {
+
+/// Priorities of scheduled tasks, pending tasks of a higher priority are always started first
+enum class TaskPriority : size_t {
+    High,   ///< Work an emulated core is blocked on, e.g. reads from the game files
+    Normal, ///< Work the host GPU thread is blocked on, e.g. texture decodes
+    Low,    ///< Work nothing waits on, it can be delayed indefinitely
+};
+
+/**
+ * Work-stealing pool shared by the CPU heavy jobs of the emulator, so they don't oversubscribe
+ * the host with a pool each. Every worker owns a queue per priority, it runs its own tasks newest
+ * first and steals the oldest tasks of other workers when it runs out. Workers run at a low
+ * thread priority to yield to the emulation threads.
+ */
+class TaskScheduler {
+public:
+    using Task = UniqueFunction<void>;
+
+    /// Affinity hint of tasks that may be queued on any worker
+    static constexpr size_t NoAffinity = ~size_t{0};
+
+    explicit TaskScheduler(size_t num_workers);
+    ~TaskScheduler();
+
+    TaskScheduler(const TaskScheduler&) = delete;
+    TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+    /// Returns the scheduler shared by the whole process.
+    [[nodiscard]] static TaskScheduler& Instance();
+
+    /**
+     * Schedules a task. Tasks with the same affinity hint are queued on the same worker, so
+     * related tasks tend to share a core and its caches, idle workers still steal them.
+     * Tasks without a hint scheduled from a worker are queued on that worker.
+     */
+    void Schedule(Task task, TaskPriority priority = TaskPriority::Normal,
+                  size_t affinity_hint = NoAffinity);
+
+    /// Runs a pending task on the calling thread, returns false when there was none.
+    bool TryRunPendingTask();
+
+    /// Returns true when called from a worker of this scheduler.
+    [[nodiscard]] bool IsWorkerThread() const;
+
+    [[nodiscard]] size_t NumWorkers() const {
+        return workers.size();
+    }
+
+private:
+    static constexpr size_t NUM_PRIORITIES = 3;
+
+    struct Worker {
+        std::mutex mutex;
+        std::array<std::deque<Task>, NUM_PRIORITIES> queues;
+        std::jthread thread;
+    };
+
+    void WorkerLoop(std::stop_token stop_token, size_t index);
+
+    /// Pops the task to run next, starting from the queues of the given worker. Owners pop their
+    /// newest task, other tasks are stolen oldest first.
+    bool PopTask(size_t index, bool is_owner, Task& task);
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::atomic<size_t> next_worker{};
+
+    /// Number of queued tasks, may be transiently negative while a task is being queued
+    std::atomic<s64> num_queued{};
+    std::mutex sleep_mutex;
+    std::condition_variable_any sleep_condition;
+};
+
+/**
+ * Batch of tasks scheduled on a TaskScheduler that are waited on together, for fork-join jobs
+ * split across the workers.
+ */
+class TaskGroup {
+public:
+    explicit TaskGroup(TaskPriority priority = TaskPriority::Normal,
+                       TaskScheduler& scheduler = TaskScheduler::Instance());
+    ~TaskGroup();
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    void Run(UniqueFunction<void> task, size_t affinity_hint = TaskScheduler::NoAffinity);
+
+    /// Waits for all the tasks of the group. Workers run other pending tasks while they wait, so
+    /// groups can be waited on from inside tasks without starving the scheduler.
+    void Wait();
+
+private:
+    TaskScheduler& scheduler;
+    TaskPriority priority;
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    size_t num_pending{};
+};
+
+} // namespace Common
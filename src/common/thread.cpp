@@ -2,11 +2,15 @@
 // SPDX-FileCopyrightText: 2014 Citra Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "common/error.h"
 #include "common/logging/log.h"
 #include "common/thread.h"
+#include "common/tracing.h"
 #ifdef __APPLE__
 #include <mach/mach.h>
 #elif defined(_WIN32)
@@ -23,6 +27,9 @@
 #ifndef _WIN32
 #include <unistd.h>
 #endif
+#ifdef __linux__
+#include <fstream>
+#endif
 
 #ifdef __FreeBSD__
 #define cpu_set_t cpuset_t
@@ -80,10 +87,123 @@ void SetCurrentThreadPriority(ThreadPriority new_priority) {
 
 #endif
 
+#if defined(_WIN32) || defined(__linux__)
+
+namespace {
+
+/// Returns the CPUs of the fastest class, or nothing when all CPUs perform alike
+template <typename Id>
+std::vector<Id> SelectPerformanceCpus(const std::vector<std::pair<Id, u64>>& cpus) {
+    u64 max_performance = 0;
+    for (const auto& cpu : cpus) {
+        max_performance = std::max(max_performance, cpu.second);
+    }
+    // Prime and big cores are grouped together, they are much closer than the little cores
+    std::vector<Id> performance_cpus;
+    for (const auto& [id, performance] : cpus) {
+        if (performance * 4 >= max_performance * 3) {
+            performance_cpus.push_back(id);
+        }
+    }
+    if (performance_cpus.size() == cpus.size()) {
+        return {};
+    }
+    LOG_INFO(Common, "Placing emulation threads on {} of {} CPUs", performance_cpus.size(),
+             cpus.size());
+    return performance_cpus;
+}
+
+bool PrefersPerformanceCores(ThreadRole role) {
+    return role != ThreadRole::Audio;
+}
+
+} // Anonymous namespace
+
+#endif
+
+#ifdef _WIN32
+
+void SetCurrentThreadRole(ThreadRole role) {
+    if (!PrefersPerformanceCores(role)) {
+        return;
+    }
+    // CPU sets are a soft affinity, the OS may still move the thread when the set is busy
+    static const std::vector<ULONG> cpu_sets = [] {
+        const HANDLE process = GetCurrentProcess();
+        ULONG length = 0;
+        GetSystemCpuSetInformation(nullptr, 0, &length, process, 0);
+        std::vector<u8> buffer(length);
+        const auto info = reinterpret_cast<PSYSTEM_CPU_SET_INFORMATION>(buffer.data());
+        if (!GetSystemCpuSetInformation(info, length, &length, process, 0)) {
+            return std::vector<ULONG>{};
+        }
+        std::vector<std::pair<ULONG, u64>> cpus;
+        for (size_t offset = 0; offset < length;) {
+            const auto* entry =
+                reinterpret_cast<const SYSTEM_CPU_SET_INFORMATION*>(buffer.data() + offset);
+            if (entry->Type == CpuSetInformation) {
+                cpus.emplace_back(entry->CpuSet.Id, entry->CpuSet.EfficiencyClass);
+            }
+            offset += entry->Size;
+        }
+        return SelectPerformanceCpus(cpus);
+    }();
+    if (!cpu_sets.empty()) {
+        SetThreadSelectedCpuSets(GetCurrentThread(), cpu_sets.data(),
+                                 static_cast<ULONG>(cpu_sets.size()));
+    }
+}
+
+#elif defined(__linux__)
+
+void SetCurrentThreadRole(ThreadRole role) {
+    if (!PrefersPerformanceCores(role)) {
+        return;
+    }
+    // The capacity is reported on big.LITTLE systems, hybrid x86 CPUs differ by peak frequency
+    static const std::vector<int> performance_cpus = [] {
+        std::vector<std::pair<int, u64>> cpus;
+        const long num_cpus = sysconf(_SC_NPROCESSORS_CONF);
+        for (int cpu = 0; cpu < num_cpus; ++cpu) {
+            const std::string path = "/sys/devices/system/cpu/cpu" + std::to_string(cpu);
+            u64 performance = 0;
+            std::ifstream capacity{path + "/cpu_capacity"};
+            if (capacity >> performance) {
+                cpus.emplace_back(cpu, performance);
+                continue;
+            }
+            std::ifstream max_freq{path + "/cpufreq/cpuinfo_max_freq"};
+            if (max_freq >> performance) {
+                cpus.emplace_back(cpu, performance);
+            }
+        }
+        return SelectPerformanceCpus(cpus);
+    }();
+    if (performance_cpus.empty()) {
+        return;
+    }
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    for (const int cpu : performance_cpus) {
+        CPU_SET(cpu, &cpu_set);
+    }
+    if (sched_setaffinity(0, sizeof(cpu_set), &cpu_set) != 0) {
+        LOG_WARNING(Common, "Failed to set the thread affinity: {}", GetLastErrorMsg());
+    }
+}
+
+#else
+
+void SetCurrentThreadRole(ThreadRole) {
+    // Placement is left to the OS, macOS in particular has no thread affinity
+}
+
+#endif
+
 #ifdef _MSC_VER
 
 // Sets the debugger-visible name of the current thread.
-void SetCurrentThreadName(const char* name) {
+static void SetHostThreadName(const char* name) {
     SetThreadDescription(GetCurrentThread(), UTF8ToUTF16W(name).data());
 }
 
@@ -91,7 +211,7 @@ void SetCurrentThreadName(const char* name) {
 
 // MinGW with the POSIX threading model does not support pthread_setname_np
 #if !defined(_WIN32) || defined(_MSC_VER)
-void SetCurrentThreadName(const char* name) {
+static void SetHostThreadName(const char* name) {
 #ifdef __APPLE__
     pthread_setname_np(name);
 #elif defined(__Bitrig__) || defined(__DragonFly__) || defined(__FreeBSD__) || defined(__OpenBSD__)
@@ -113,11 +233,16 @@ void SetCurrentThreadName(const char* name) {
 #endif
 
 #if defined(_WIN32)
-void SetCurrentThreadName(const char* name) {
+static void SetHostThreadName(const char* name) {
     // Do Nothing on MingW
 }
 #endif
 
 #endif
 
+void SetCurrentThreadName(const char* name) {
+    Tracing::SetThreadName(name);
+    SetHostThreadName(name);
+}
+
 } // namespace Common
@@ -104,6 +104,22 @@ enum class ThreadPriority : u32 {
 
 void SetCurrentThreadPriority(ThreadPriority new_priority);
 
+/// Roles of the host threads that keep the emulated system running
+enum class ThreadRole : u32 {
+    EmulatedCore, ///< Runs the guest code of an emulated CPU core
+    GpuCommands,  ///< Processes the guest GPU command lists
+    RenderWorker, ///< Records and submits host graphics commands
+    Audio,        ///< Renders guest audio, light enough to run on any core
+};
+
+/**
+ * Places the current thread on the host cores suited for its role.
+ * On hybrid CPUs, threads that bound the emulation speed are kept on the performance cores, so
+ * the OS doesn't move them to the efficiency cores. Does nothing when all cores are alike or the
+ * topology is unknown.
+ */
+void SetCurrentThreadRole(ThreadRole role);
+
 void SetCurrentThreadName(const char* name);
 
 } // namespace Common
@@ -3,7 +3,10 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <functional>
 #include <mutex>
@@ -15,10 +18,24 @@
 
 #include "common/polyfill_thread.h"
 #include "common/thread.h"
+#include "common/tracing.h"
 #include "common/unique_function.h"
 
 namespace Common {
 
+/// Queues of a thread worker, foreground work is always started before background work
+enum class WorkLane : size_t {
+    Foreground,
+    Background,
+};
+
+struct WorkLaneStatistics {
+    size_t queue_depth{};
+    size_t num_started{};
+    std::chrono::nanoseconds total_wait{};
+    std::chrono::nanoseconds max_wait{};
+};
+
 template <class StateType = void>
 class StatefulThreadWorker {
     static constexpr bool with_state = !std::is_same_v<StateType, void>;
@@ -32,6 +49,14 @@ class StatefulThreadWorker {
     using Task =
         std::conditional_t<with_state, UniqueFunction<void, StateType*>, UniqueFunction<void>>;
     using StateMaker = std::conditional_t<with_state, std::function<StateType()>, DummyCallable>;
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr size_t NUM_LANES = 2;
+
+    struct Request {
+        Task task;
+        Clock::time_point queue_time;
+    };
 
 public:
     explicit StatefulThreadWorker(size_t num_workers, std::string name, StateMaker func = {})
@@ -44,17 +69,17 @@ public:
                     Task task;
                     {
                         std::unique_lock lock{queue_mutex};
-                        if (requests.empty()) {
+                        if (IsQueueEmpty()) {
                             wait_condition.notify_all();
                         }
                         Common::CondvarWait(condition, lock, stop_token,
-                                            [this] { return !requests.empty(); });
+                                            [this] { return HasRunnableWork(); });
                         if (stop_token.stop_requested()) {
                             break;
                         }
-                        task = std::move(requests.front());
-                        requests.pop();
+                        task = PopRequest();
                     }
+                    TRACE_ZONE("Worker task");
                     if constexpr (with_state) {
                         task(&state);
                     } else {
@@ -78,15 +103,37 @@ public:
     StatefulThreadWorker& operator=(StatefulThreadWorker&&) = delete;
     StatefulThreadWorker(StatefulThreadWorker&&) = delete;
 
-    void QueueWork(Task work) {
+    void QueueWork(Task work, WorkLane lane = WorkLane::Foreground) {
         {
             std::unique_lock lock{queue_mutex};
-            requests.emplace(std::move(work));
+            requests[static_cast<size_t>(lane)].push(Request{std::move(work), Clock::now()});
             ++work_scheduled;
         }
         condition.notify_one();
     }
 
+    /// Holds back background work while a thread waits on foreground work to finish.
+    /// Calls must be paired with EndForegroundWait.
+    void BeginForegroundWait() {
+        std::unique_lock lock{queue_mutex};
+        ++num_foreground_waiters;
+    }
+
+    void EndForegroundWait() {
+        {
+            std::unique_lock lock{queue_mutex};
+            --num_foreground_waiters;
+        }
+        condition.notify_all();
+    }
+
+    [[nodiscard]] WorkLaneStatistics GetStatistics(WorkLane lane) {
+        std::unique_lock lock{queue_mutex};
+        WorkLaneStatistics result{statistics[static_cast<size_t>(lane)]};
+        result.queue_depth = requests[static_cast<size_t>(lane)].size();
+        return result;
+    }
+
     void WaitForRequests(std::stop_token stop_token = {}) {
         std::stop_callback callback(stop_token, [this] {
             for (auto& thread : threads) {
@@ -100,7 +147,36 @@ public:
     }
 
 private:
-    std::queue<Task> requests;
+    bool IsQueueEmpty() const {
+        return requests[0].empty() && requests[1].empty();
+    }
+
+    bool HasRunnableWork() const {
+        const bool has_foreground{!requests[static_cast<size_t>(WorkLane::Foreground)].empty()};
+        const bool has_background{!requests[static_cast<size_t>(WorkLane::Background)].empty()};
+        return has_foreground || (has_background && num_foreground_waiters == 0);
+    }
+
+    Task PopRequest() {
+        size_t lane{static_cast<size_t>(WorkLane::Foreground)};
+        if (requests[lane].empty()) {
+            lane = static_cast<size_t>(WorkLane::Background);
+        }
+        Request request{std::move(requests[lane].front())};
+        requests[lane].pop();
+
+        const auto wait{std::chrono::duration_cast<std::chrono::nanoseconds>(
+            Clock::now() - request.queue_time)};
+        WorkLaneStatistics& lane_statistics{statistics[lane]};
+        ++lane_statistics.num_started;
+        lane_statistics.total_wait += wait;
+        lane_statistics.max_wait = std::max(lane_statistics.max_wait, wait);
+        return std::move(request.task);
+    }
+
+    std::array<std::queue<Request>, NUM_LANES> requests;
+    std::array<WorkLaneStatistics, NUM_LANES> statistics{};
+    size_t num_foreground_waiters{};
     std::mutex queue_mutex;
     std::condition_variable_any condition;
     std::condition_variable wait_condition;
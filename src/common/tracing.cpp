@@ -0,0 +1,220 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "common/fs/file.h"
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
+#include "common/tracing.h"
+
+namespace Common::Tracing {
+namespace {
+
+// Caps the memory of threads that record events much faster than others, the oldest
+// events are kept so long sessions still show how they started
+constexpr size_t MAX_EVENTS_PER_THREAD = 1 << 21;
+
+enum class EventType : u32 {
+    Zone,
+    Counter,
+    FlowBegin,
+    FlowEnd,
+};
+
+struct Event {
+    const char* name;
+    u64 timestamp_ns;
+    u64 data; ///< Duration of zones, value of counters or id of flows
+    EventType type;
+};
+
+struct ThreadBuffer {
+    std::mutex mutex;
+    std::vector<Event> events;
+    std::string name;
+    u32 tid;
+    u64 session;
+    u64 num_dropped{};
+};
+
+struct State {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    std::filesystem::path filename;
+    std::atomic<u64> session{};
+    u64 start_ns{};
+    u32 next_tid{};
+};
+
+State& GetState() {
+    static State state;
+    return state;
+}
+
+thread_local std::string current_thread_name;
+thread_local std::shared_ptr<ThreadBuffer> current_buffer;
+
+ThreadBuffer& GetThreadBuffer() {
+    State& state{GetState()};
+    std::scoped_lock lock{state.mutex};
+    const u64 session{state.session.load(std::memory_order_relaxed)};
+    if (!current_buffer || current_buffer->session != session) {
+        current_buffer = std::make_shared<ThreadBuffer>();
+        current_buffer->name = current_thread_name;
+        current_buffer->tid = ++state.next_tid;
+        current_buffer->session = session;
+        state.buffers.push_back(current_buffer);
+    }
+    return *current_buffer;
+}
+
+void Record(const Event& event) {
+    // The buffer lock is only contended while a trace is being written
+    ThreadBuffer* buffer{current_buffer.get()};
+    if (!buffer || buffer->session != GetState().session.load(std::memory_order_relaxed)) {
+        buffer = &GetThreadBuffer();
+    }
+    std::scoped_lock lock{buffer->mutex};
+    if (buffer->events.size() >= MAX_EVENTS_PER_THREAD) {
+        ++buffer->num_dropped;
+        return;
+    }
+    buffer->events.push_back(event);
+}
+
+void AppendEvent(fmt::memory_buffer& out, const ThreadBuffer& buffer, const Event& event,
+                 u64 start_ns) {
+    const double ts_us{static_cast<double>(event.timestamp_ns - start_ns) / 1000.0};
+    switch (event.type) {
+    case EventType::Zone:
+        fmt::format_to(std::back_inserter(out),
+                       ",\n{{\"name\":\"{}\",\"ph\":\"X\",\"ts\":{:.3f},\"dur\":{:.3f},\"pid\":1,"
+                       "\"tid\":{}}}",
+                       event.name, ts_us, static_cast<double>(event.data) / 1000.0, buffer.tid);
+        break;
+    case EventType::Counter:
+        fmt::format_to(std::back_inserter(out),
+                       ",\n{{\"name\":\"{}\",\"ph\":\"C\",\"ts\":{:.3f},\"pid\":1,\"tid\":{},"
+                       "\"args\":{{\"value\":{}}}}}",
+                       event.name, ts_us, buffer.tid, static_cast<s64>(event.data));
+        break;
+    case EventType::FlowBegin:
+    case EventType::FlowEnd:
+        fmt::format_to(std::back_inserter(out),
+                       ",\n{{\"name\":\"{}\",\"cat\":\"flow\",\"ph\":\"{}\",\"id\":{},"
+                       "\"ts\":{:.3f},\"pid\":1,\"tid\":{}{}}}",
+                       event.name, event.type == EventType::FlowBegin ? 's' : 'f', event.data,
+                       ts_us, buffer.tid,
+                       event.type == EventType::FlowEnd ? ",\"bp\":\"e\"" : "");
+        break;
+    }
+}
+
+} // Anonymous namespace
+
+namespace Detail {
+std::atomic_bool is_enabled{false};
+
+u64 Now() {
+    return static_cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                std::chrono::steady_clock::now().time_since_epoch())
+                                .count());
+}
+
+void RecordZone(const char* name, u64 begin_ns) {
+    const u64 end_ns{Now()};
+    Record({name, begin_ns, end_ns - begin_ns, EventType::Zone});
+}
+
+void RecordCounter(const char* name, s64 value) {
+    Record({name, Now(), static_cast<u64>(value), EventType::Counter});
+}
+
+void RecordFlow(const char* name, u64 id, bool begin) {
+    Record({name, Now(), id, begin ? EventType::FlowBegin : EventType::FlowEnd});
+}
+} // namespace Detail
+
+void Start(const std::filesystem::path& filename) {
+    State& state{GetState()};
+    {
+        std::scoped_lock lock{state.mutex};
+        state.buffers.clear();
+        state.filename = filename;
+        state.start_ns = Detail::Now();
+        state.session.fetch_add(1, std::memory_order_relaxed);
+    }
+    Detail::is_enabled.store(true, std::memory_order_relaxed);
+    LOG_INFO(Common, "Recording trace to {}", Common::FS::PathToUTF8String(filename));
+}
+
+void Stop() {
+    if (!Detail::is_enabled.exchange(false, std::memory_order_relaxed)) {
+        return;
+    }
+    State& state{GetState()};
+    std::scoped_lock lock{state.mutex};
+    Common::FS::IOFile file{state.filename, Common::FS::FileAccessMode::Write,
+                            Common::FS::FileType::TextFile};
+    if (!file.IsOpen()) {
+        LOG_ERROR(Common_Filesystem, "Failed to open trace file {}",
+                  Common::FS::PathToUTF8String(state.filename));
+        state.buffers.clear();
+        return;
+    }
+    fmt::memory_buffer out;
+    fmt::format_to(std::back_inserter(out),
+                   "{{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n"
+                   "{{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,"
+                   "\"args\":{{\"name\":\"yuzu\"}}}}");
+    size_t num_events{};
+    for (const auto& buffer : state.buffers) {
+        std::scoped_lock buffer_lock{buffer->mutex};
+        if (!buffer->name.empty()) {
+            fmt::format_to(std::back_inserter(out),
+                           ",\n{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":{},"
+                           "\"args\":{{\"name\":\"{}\"}}}}",
+                           buffer->tid, buffer->name);
+        }
+        if (buffer->num_dropped != 0) {
+            LOG_WARNING(Common, "Thread {} dropped {} trace events", buffer->name,
+                        buffer->num_dropped);
+        }
+        for (const Event& event : buffer->events) {
+            // Zones that began before the trace started have no meaningful timestamp
+            if (event.timestamp_ns >= state.start_ns) {
+                AppendEvent(out, *buffer, event, state.start_ns);
+            }
+        }
+        num_events += buffer->events.size();
+        buffer->events = {};
+
+        // Write each thread out on its own, keeping the text of huge traces off the heap
+        std::ignore = file.WriteString(std::span<const char>(out.data(), out.size()));
+        out.clear();
+    }
+    fmt::format_to(std::back_inserter(out), "\n]}}\n");
+    std::ignore = file.WriteString(std::span<const char>(out.data(), out.size()));
+    state.buffers.clear();
+    LOG_INFO(Common, "Wrote {} trace events to {}", num_events,
+             Common::FS::PathToUTF8String(state.filename));
+}
+
+void SetThreadName(std::string_view name) {
+    current_thread_name = name;
+    if (current_buffer) {
+        std::scoped_lock lock{current_buffer->mutex};
+        current_buffer->name = current_thread_name;
+    }
+}
+
+} // namespace Common::Tracing
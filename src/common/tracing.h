@@ -0,0 +1,85 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <filesystem>
+#include <string_view>
+
+#include "common/common_funcs.h"
+#include "common/common_types.h"
+
+/// Lightweight timeline tracing, written as a Chrome JSON trace that Perfetto and
+/// chrome://tracing can open. Every call is a relaxed atomic load when tracing is disabled.
+namespace Common::Tracing {
+
+namespace Detail {
+extern std::atomic_bool is_enabled;
+
+[[nodiscard]] u64 Now();
+void RecordZone(const char* name, u64 begin_ns);
+void RecordCounter(const char* name, s64 value);
+void RecordFlow(const char* name, u64 id, bool begin);
+} // namespace Detail
+
+/// Returns true while a trace is being recorded
+[[nodiscard]] inline bool IsEnabled() {
+    return Detail::is_enabled.load(std::memory_order_relaxed);
+}
+
+/// Starts recording a trace, discarding any events of a previous session
+void Start(const std::filesystem::path& filename);
+
+/// Stops recording and writes the trace to the file given to Start
+void Stop();
+
+/// Names the current thread in traces, called by Common::SetCurrentThreadName
+void SetThreadName(std::string_view name);
+
+/// Records a counter sample, name must be a string literal
+inline void Counter(const char* name, s64 value) {
+    if (IsEnabled()) {
+        Detail::RecordCounter(name, value);
+    }
+}
+
+/// Starts an arrow between threads, ended by FlowEnd with the same name and id
+inline void FlowBegin(const char* name, u64 id) {
+    if (IsEnabled()) {
+        Detail::RecordFlow(name, id, true);
+    }
+}
+
+inline void FlowEnd(const char* name, u64 id) {
+    if (IsEnabled()) {
+        Detail::RecordFlow(name, id, false);
+    }
+}
+
+/// Records the lifetime of the object as a zone, name must be a string literal
+class ScopedZone {
+public:
+    explicit ScopedZone(const char* name_) : name{name_} {
+        if (IsEnabled()) {
+            begin_ns = Detail::Now();
+        }
+    }
+
+    ~ScopedZone() {
+        if (begin_ns != 0) {
+            Detail::RecordZone(name, begin_ns);
+        }
+    }
+
+    YUZU_NON_COPYABLE(ScopedZone);
+    YUZU_NON_MOVEABLE(ScopedZone);
+
+private:
+    const char* name;
+    u64 begin_ns{};
+};
+
+} // namespace Common::Tracing
+
+#define TRACE_ZONE(name) ::Common::Tracing::ScopedZone CONCAT2(trace_zone_, __LINE__)(name)
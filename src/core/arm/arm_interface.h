@@ -82,8 +82,9 @@ public:
     virtual void SetContext(const Kernel::Svc::ThreadContext& ctx) = 0;
     virtual void SetTpidrroEl0(u64 value) = 0;
 
-    virtual void GetSvcArguments(std::span<uint64_t, 8> args) const = 0;
-    virtual void SetSvcArguments(std::span<const uint64_t, 8> args) = 0;
+    // SVC argument accessors, only the registers set in the mask are copied.
+    virtual void GetSvcArguments(std::span<uint64_t, 8> args, u32 mask) const = 0;
+    virtual void SetSvcArguments(std::span<const uint64_t, 8> args, u32 mask) = 0;
     virtual u32 GetSvcNumber() const = 0;
 
     void SetWatchpointArray(const WatchpointArray* watchpoints) {
@@ -79,97 +79,6 @@ constexpr std::array<u64, 2> SegmentBases{
     0x7100000000ULL,
 };
 
-void SymbolicateBacktrace(Kernel::KProcess* process, std::vector<BacktraceEntry>& out) {
-    auto modules = FindModules(process);
-
-    const bool is_64 = process->Is64Bit();
-
-    std::map<std::string, Symbols::Symbols> symbols;
-    for (const auto& module : modules) {
-        symbols.insert_or_assign(module.second,
-                                 Symbols::GetSymbols(module.first, process->GetMemory(), is_64));
-    }
-
-    for (auto& entry : out) {
-        VAddr base = 0;
-        for (auto iter = modules.rbegin(); iter != modules.rend(); ++iter) {
-            const auto& module{*iter};
-            if (entry.original_address >= module.first) {
-                entry.module = module.second;
-                base = module.first;
-                break;
-            }
-        }
-
-        entry.offset = entry.original_address - base;
-        entry.address = SegmentBases[is_64] + entry.offset;
-
-        if (entry.module.empty()) {
-            entry.module = "unknown";
-        }
-
-        const auto symbol_set = symbols.find(entry.module);
-        if (symbol_set != symbols.end()) {
-            const auto symbol = Symbols::GetSymbolName(symbol_set->second, entry.offset);
-            if (symbol) {
-                entry.name = Common::DemangleSymbol(*symbol);
-            }
-        }
-    }
-}
-
-std::vector<BacktraceEntry> GetAArch64Backtrace(Kernel::KProcess* process,
-                                                const Kernel::Svc::ThreadContext& ctx) {
-    std::vector<BacktraceEntry> out;
-    auto& memory = process->GetMemory();
-    auto pc = ctx.pc, lr = ctx.lr, fp = ctx.fp;
-
-    out.push_back({"", 0, pc, 0, ""});
-
-    // fp (= x29) points to the previous frame record.
-    // Frame records are two words long:
-    // fp+0 : pointer to previous frame record
-    // fp+8 : value of lr for frame
-    for (size_t i = 0; i < 256; i++) {
-        out.push_back({"", 0, lr, 0, ""});
-        if (!fp || (fp % 4 != 0) || !memory.IsValidVirtualAddressRange(fp, 16)) {
-            break;
-        }
-        lr = memory.Read64(fp + 8);
-        fp = memory.Read64(fp);
-    }
-
-    SymbolicateBacktrace(process, out);
-
-    return out;
-}
-
-std::vector<BacktraceEntry> GetAArch32Backtrace(Kernel::KProcess* process,
-                                                const Kernel::Svc::ThreadContext& ctx) {
-    std::vector<BacktraceEntry> out;
-    auto& memory = process->GetMemory();
-    auto pc = ctx.pc, lr = ctx.lr, fp = ctx.fp;
-
-    out.push_back({"", 0, pc, 0, ""});
-
-    // fp (= r11) points to the last frame record.
-    // Frame records are two words long:
-    // fp+0 : pointer to previous frame record
-    // fp+4 : value of lr for frame
-    for (size_t i = 0; i < 256; i++) {
-        out.push_back({"", 0, lr, 0, ""});
-        if (!fp || (fp % 4 != 0) || !memory.IsValidVirtualAddressRange(fp, 8)) {
-            break;
-        }
-        lr = memory.Read32(fp + 4);
-        fp = memory.Read32(fp);
-    }
-
-    SymbolicateBacktrace(process, out);
-
-    return out;
-}
-
 } // namespace
 
 std::optional<std::string> GetThreadName(const Kernel::KThread* thread) {
@@ -328,6 +237,76 @@ Kernel::KProcessAddress FindMainModuleEntrypoint(Kernel::KProcess* process) {
     return GetInteger(process->GetPageTable().GetCodeRegionStart());
 }
 
+std::vector<u64> GetBacktraceAddresses(Kernel::KProcess* process,
+                                       const Kernel::Svc::ThreadContext& ctx, size_t max_depth) {
+    std::vector<u64> out;
+    auto& memory = process->GetMemory();
+    const bool is_64 = process->Is64Bit();
+    auto lr = ctx.lr, fp = ctx.fp;
+
+    out.push_back(ctx.pc);
+
+    // fp (= x29 or r11) points to the previous frame record.
+    // Frame records are two words long:
+    // fp+0 : pointer to previous frame record
+    // fp+8 (fp+4 on AArch32) : value of lr for frame
+    const u64 record_size = is_64 ? 16 : 8;
+    for (size_t i = 0; i < max_depth; i++) {
+        out.push_back(lr);
+        if (!fp || (fp % 4 != 0) || !memory.IsValidVirtualAddressRange(fp, record_size)) {
+            break;
+        }
+        if (is_64) {
+            lr = memory.Read64(fp + 8);
+            fp = memory.Read64(fp);
+        } else {
+            lr = memory.Read32(fp + 4);
+            fp = memory.Read32(fp);
+        }
+    }
+
+    return out;
+}
+
+void SymbolicateBacktrace(Kernel::KProcess* process, std::vector<BacktraceEntry>& out) {
+    auto modules = FindModules(process);
+
+    const bool is_64 = process->Is64Bit();
+
+    std::map<std::string, Symbols::Symbols> symbols;
+    for (const auto& module : modules) {
+        symbols.insert_or_assign(module.second,
+                                 Symbols::GetSymbols(module.first, process->GetMemory(), is_64));
+    }
+
+    for (auto& entry : out) {
+        VAddr base = 0;
+        for (auto iter = modules.rbegin(); iter != modules.rend(); ++iter) {
+            const auto& module{*iter};
+            if (entry.original_address >= module.first) {
+                entry.module = module.second;
+                base = module.first;
+                break;
+            }
+        }
+
+        entry.offset = entry.original_address - base;
+        entry.address = SegmentBases[is_64] + entry.offset;
+
+        if (entry.module.empty()) {
+            entry.module = "unknown";
+        }
+
+        const auto symbol_set = symbols.find(entry.module);
+        if (symbol_set != symbols.end()) {
+            const auto symbol = Symbols::GetSymbolName(symbol_set->second, entry.offset);
+            if (symbol) {
+                entry.name = Common::DemangleSymbol(*symbol);
+            }
+        }
+    }
+}
+
 void InvalidateInstructionCacheRange(const Kernel::KProcess* process, u64 address, u64 size) {
     for (size_t i = 0; i < Core::Hardware::NUM_CPU_CORES; i++) {
         auto* interface = process->GetArmInterface(i);
@@ -339,11 +318,14 @@ void InvalidateInstructionCacheRange(const Kernel::KProcess* process, u64 addres
 
 std::vector<BacktraceEntry> GetBacktraceFromContext(Kernel::KProcess* process,
                                                     const Kernel::Svc::ThreadContext& ctx) {
-    if (process->Is64Bit()) {
-        return GetAArch64Backtrace(process, ctx);
-    } else {
-        return GetAArch32Backtrace(process, ctx);
+    std::vector<BacktraceEntry> out;
+    for (const u64 address : GetBacktraceAddresses(process, ctx, 256)) {
+        out.push_back({"", 0, address, 0, ""});
     }
+
+    SymbolicateBacktrace(process, out);
+
+    return out;
 }
 
 std::vector<BacktraceEntry> GetBacktrace(const Kernel::KThread* thread) {
@@ -28,6 +28,13 @@ struct BacktraceEntry {
     std::string name;
 };
 
+/// Returns the pc followed by the return addresses found walking up to max_depth frame records
+std::vector<u64> GetBacktraceAddresses(Kernel::KProcess* process,
+                                       const Kernel::Svc::ThreadContext& ctx, size_t max_depth);
+
+/// Resolves the module, offset and symbol name of the original addresses of the entries
+void SymbolicateBacktrace(Kernel::KProcess* process, std::vector<BacktraceEntry>& out);
+
 std::vector<BacktraceEntry> GetBacktraceFromContext(Kernel::KProcess* process,
                                                     const Kernel::Svc::ThreadContext& ctx);
 std::vector<BacktraceEntry> GetBacktrace(const Kernel::KThread* thread);
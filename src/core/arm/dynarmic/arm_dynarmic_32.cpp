@@ -279,9 +279,6 @@ std::shared_ptr<Dynarmic::A32::Jit> ArmDynarmic32::MakeJit(Common::PageTable* pa
             if (Settings::values.cpuopt_unsafe_inaccurate_nan) {
                 config.optimizations |= Dynarmic::OptimizationFlag::Unsafe_InaccurateNaN;
             }
-            if (Settings::values.cpuopt_unsafe_ignore_global_monitor) {
-                config.optimizations |= Dynarmic::OptimizationFlag::Unsafe_IgnoreGlobalMonitor;
-            }
         }
 
         // Curated optimizations
@@ -290,6 +287,10 @@ std::shared_ptr<Dynarmic::A32::Jit> ArmDynarmic32::MakeJit(Common::PageTable* pa
             config.optimizations |= Dynarmic::OptimizationFlag::Unsafe_UnfuseFMA;
             config.optimizations |= Dynarmic::OptimizationFlag::Unsafe_IgnoreStandardFPCRValue;
             config.optimizations |= Dynarmic::OptimizationFlag::Unsafe_InaccurateNaN;
+        }
+
+        // Must match the exclusive monitor, which is shared with the HLE kernel
+        if (IsGlobalMonitorIgnored()) {
             config.optimizations |= Dynarmic::OptimizationFlag::Unsafe_IgnoreGlobalMonitor;
         }
 
@@ -348,21 +349,25 @@ u32 ArmDynarmic32::GetSvcNumber() const {
     return m_svc_swi;
 }
 
-void ArmDynarmic32::GetSvcArguments(std::span<uint64_t, 8> args) const {
+void ArmDynarmic32::GetSvcArguments(std::span<uint64_t, 8> args, u32 mask) const {
     Dynarmic::A32::Jit& j = *m_jit;
     auto& gpr = j.Regs();
 
     for (size_t i = 0; i < 8; i++) {
-        args[i] = gpr[i];
+        if (mask & (1U << i)) {
+            args[i] = gpr[i];
+        }
     }
 }
 
-void ArmDynarmic32::SetSvcArguments(std::span<const uint64_t, 8> args) {
+void ArmDynarmic32::SetSvcArguments(std::span<const uint64_t, 8> args, u32 mask) {
     Dynarmic::A32::Jit& j = *m_jit;
     auto& gpr = j.Regs();
 
     for (size_t i = 0; i < 8; i++) {
-        gpr[i] = static_cast<u32>(args[i]);
+        if (mask & (1U << i)) {
+            gpr[i] = static_cast<u32>(args[i]);
+        }
     }
 }
 
@@ -5,6 +5,7 @@
 #include "core/arm/dynarmic/arm_dynarmic.h"
 #include "core/arm/dynarmic/arm_dynarmic_64.h"
 #include "core/arm/dynarmic/dynarmic_exclusive_monitor.h"
+#include "core/arm/spin_detector.h"
 #include "core/core_timing.h"
 #include "core/hle/kernel/k_process.h"
 
@@ -177,7 +178,8 @@ public:
     }
 
     u64 GetCNTPCT() override {
-        return m_parent.m_system.CoreTiming().GetClockTicks();
+        return m_spin_detector.ReadCounter(m_parent.m_system.CoreTiming(),
+                                           m_parent.m_uses_wall_clock);
     }
 
     bool CheckMemoryAccess(u64 addr, u64 size, Kernel::DebugWatchpointType type) {
@@ -217,6 +219,7 @@ public:
     u64 m_tpidrro_el0{};
     u64 m_tpidr_el0{};
     Kernel::KProcess* m_process{};
+    SpinDetector m_spin_detector;
     const bool m_debugger_enabled{};
     const bool m_check_memory_access{};
     static constexpr u64 MinimumRunCycles = 10000U;
@@ -338,9 +341,6 @@ std::shared_ptr<Dynarmic::A64::Jit> ArmDynarmic64::MakeJit(Common::PageTable* pa
             if (Settings::values.cpuopt_unsafe_fastmem_check) {
                 config.fastmem_address_space_bits = 64;
             }
-            if (Settings::values.cpuopt_unsafe_ignore_global_monitor) {
-                config.optimizations |= Dynarmic::OptimizationFlag::Unsafe_IgnoreGlobalMonitor;
-            }
         }
 
         // Curated optimizations
@@ -348,6 +348,10 @@ std::shared_ptr<Dynarmic::A64::Jit> ArmDynarmic64::MakeJit(Common::PageTable* pa
             config.unsafe_optimizations = true;
             config.optimizations |= Dynarmic::OptimizationFlag::Unsafe_UnfuseFMA;
             config.fastmem_address_space_bits = 64;
+        }
+
+        // Must match the exclusive monitor, which is shared with the HLE kernel
+        if (IsGlobalMonitorIgnored()) {
             config.optimizations |= Dynarmic::OptimizationFlag::Unsafe_IgnoreGlobalMonitor;
         }
 
@@ -379,19 +383,23 @@ u32 ArmDynarmic64::GetSvcNumber() const {
     return m_svc;
 }
 
-void ArmDynarmic64::GetSvcArguments(std::span<uint64_t, 8> args) const {
+void ArmDynarmic64::GetSvcArguments(std::span<uint64_t, 8> args, u32 mask) const {
     Dynarmic::A64::Jit& j = *m_jit;
 
     for (size_t i = 0; i < 8; i++) {
-        args[i] = j.GetRegister(i);
+        if (mask & (1U << i)) {
+            args[i] = j.GetRegister(i);
+        }
     }
 }
 
-void ArmDynarmic64::SetSvcArguments(std::span<const uint64_t, 8> args) {
+void ArmDynarmic64::SetSvcArguments(std::span<const uint64_t, 8> args, u32 mask) {
     Dynarmic::A64::Jit& j = *m_jit;
 
     for (size_t i = 0; i < 8; i++) {
-        j.SetRegister(i, args[i]);
+        if (mask & (1U << i)) {
+            j.SetRegister(i, args[i]);
+        }
     }
 }
 
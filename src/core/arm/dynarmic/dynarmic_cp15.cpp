@@ -124,10 +124,11 @@ CallbackOrAccessTwoWords DynarmicCP15::CompileGetTwoWords(bool two, unsigned opc
     if (!two && opc == 0 && CRm == CoprocReg::C14) {
         // CNTPCT
         const auto callback = [](void* arg, u32, u32) -> u64 {
-            const auto& parent_arg = *static_cast<ArmDynarmic32*>(arg);
-            return parent_arg.m_system.CoreTiming().GetClockTicks();
+            auto& cp15 = *static_cast<DynarmicCP15*>(arg);
+            return cp15.spin_detector.ReadCounter(cp15.parent.m_system.CoreTiming(),
+                                                  cp15.parent.m_uses_wall_clock);
         };
-        return Callback{callback, &parent};
+        return Callback{callback, this};
     }
 
     LOG_CRITICAL(Core_ARM, "CP15: mrrc{} p15, {}, <Rt>, <Rt2>, {}", two ? "2" : "", opc, CRm);
@@ -7,6 +7,7 @@
 
 #include <dynarmic/interface/A32/coprocessor.h>
 #include "common/common_types.h"
+#include "core/arm/spin_detector.h"
 
 namespace Core {
 
@@ -33,6 +34,7 @@ public:
                                               std::optional<u8> option) override;
 
     ArmDynarmic32& parent;
+    SpinDetector spin_detector;
     u32 uprw = 0;
     u32 uro = 0;
 
@@ -1,34 +1,72 @@
 // SPDX-FileCopyrightText: Copyright 2018 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include "common/settings.h"
 #include "core/arm/dynarmic/dynarmic_exclusive_monitor.h"
 #include "core/memory.h"
 
 namespace Core {
 
+bool IsGlobalMonitorIgnored() {
+    if (Settings::values.cpu_debug_mode) {
+        return false;
+    }
+    switch (Settings::values.cpu_accuracy.GetValue()) {
+    case Settings::CpuAccuracy::Auto:
+        return true;
+    case Settings::CpuAccuracy::Unsafe:
+        return Settings::values.cpuopt_unsafe_ignore_global_monitor.GetValue();
+    default:
+        return false;
+    }
+}
+
 DynarmicExclusiveMonitor::DynarmicExclusiveMonitor(Memory::Memory& memory_, std::size_t core_count_)
-    : monitor{core_count_}, memory{memory_} {}
+    : monitor{core_count_}, memory{memory_} {
+    // Exclusive stores of the JIT don't check the monitor, so the HLE kernel doesn't need to
+    // serialize its own accesses behind its lock either
+    if (IsGlobalMonitorIgnored()) {
+        reservations.emplace(core_count_);
+    }
+}
 
 DynarmicExclusiveMonitor::~DynarmicExclusiveMonitor() = default;
 
+template <typename T, typename Function>
+T DynarmicExclusiveMonitor::ReadAndMark(std::size_t core_index, VAddr addr, Function&& read) {
+    if (reservations) {
+        return reservations->ReadAndMark<T>(core_index, addr, read);
+    }
+    return monitor.ReadAndMark<T>(core_index, addr, read);
+}
+
+template <typename T, typename Function>
+bool DynarmicExclusiveMonitor::DoExclusiveOperation(std::size_t core_index, VAddr addr,
+                                                    Function&& operation) {
+    if (reservations) {
+        return reservations->DoExclusiveOperation<T>(core_index, addr, operation);
+    }
+    return monitor.DoExclusiveOperation<T>(core_index, addr, operation);
+}
+
 u8 DynarmicExclusiveMonitor::ExclusiveRead8(std::size_t core_index, VAddr addr) {
-    return monitor.ReadAndMark<u8>(core_index, addr, [&]() -> u8 { return memory.Read8(addr); });
+    return ReadAndMark<u8>(core_index, addr, [&]() -> u8 { return memory.Read8(addr); });
 }
 
 u16 DynarmicExclusiveMonitor::ExclusiveRead16(std::size_t core_index, VAddr addr) {
-    return monitor.ReadAndMark<u16>(core_index, addr, [&]() -> u16 { return memory.Read16(addr); });
+    return ReadAndMark<u16>(core_index, addr, [&]() -> u16 { return memory.Read16(addr); });
 }
 
 u32 DynarmicExclusiveMonitor::ExclusiveRead32(std::size_t core_index, VAddr addr) {
-    return monitor.ReadAndMark<u32>(core_index, addr, [&]() -> u32 { return memory.Read32(addr); });
+    return ReadAndMark<u32>(core_index, addr, [&]() -> u32 { return memory.Read32(addr); });
 }
 
 u64 DynarmicExclusiveMonitor::ExclusiveRead64(std::size_t core_index, VAddr addr) {
-    return monitor.ReadAndMark<u64>(core_index, addr, [&]() -> u64 { return memory.Read64(addr); });
+    return ReadAndMark<u64>(core_index, addr, [&]() -> u64 { return memory.Read64(addr); });
 }
 
 u128 DynarmicExclusiveMonitor::ExclusiveRead128(std::size_t core_index, VAddr addr) {
-    return monitor.ReadAndMark<u128>(core_index, addr, [&]() -> u128 {
+    return ReadAndMark<u128>(core_index, addr, [&]() -> u128 {
         u128 result;
         result[0] = memory.Read64(addr);
         result[1] = memory.Read64(addr + 8);
@@ -37,35 +75,39 @@ u128 DynarmicExclusiveMonitor::ExclusiveRead128(std::size_t core_index, VAddr ad
 }
 
 void DynarmicExclusiveMonitor::ClearExclusive(std::size_t core_index) {
+    if (reservations) {
+        reservations->ClearProcessor(core_index);
+        return;
+    }
     monitor.ClearProcessor(core_index);
 }
 
 bool DynarmicExclusiveMonitor::ExclusiveWrite8(std::size_t core_index, VAddr vaddr, u8 value) {
-    return monitor.DoExclusiveOperation<u8>(core_index, vaddr, [&](u8 expected) -> bool {
+    return DoExclusiveOperation<u8>(core_index, vaddr, [&](u8 expected) -> bool {
         return memory.WriteExclusive8(vaddr, value, expected);
     });
 }
 
 bool DynarmicExclusiveMonitor::ExclusiveWrite16(std::size_t core_index, VAddr vaddr, u16 value) {
-    return monitor.DoExclusiveOperation<u16>(core_index, vaddr, [&](u16 expected) -> bool {
+    return DoExclusiveOperation<u16>(core_index, vaddr, [&](u16 expected) -> bool {
         return memory.WriteExclusive16(vaddr, value, expected);
     });
 }
 
 bool DynarmicExclusiveMonitor::ExclusiveWrite32(std::size_t core_index, VAddr vaddr, u32 value) {
-    return monitor.DoExclusiveOperation<u32>(core_index, vaddr, [&](u32 expected) -> bool {
+    return DoExclusiveOperation<u32>(core_index, vaddr, [&](u32 expected) -> bool {
         return memory.WriteExclusive32(vaddr, value, expected);
     });
 }
 
 bool DynarmicExclusiveMonitor::ExclusiveWrite64(std::size_t core_index, VAddr vaddr, u64 value) {
-    return monitor.DoExclusiveOperation<u64>(core_index, vaddr, [&](u64 expected) -> bool {
+    return DoExclusiveOperation<u64>(core_index, vaddr, [&](u64 expected) -> bool {
         return memory.WriteExclusive64(vaddr, value, expected);
     });
 }
 
 bool DynarmicExclusiveMonitor::ExclusiveWrite128(std::size_t core_index, VAddr vaddr, u128 value) {
-    return monitor.DoExclusiveOperation<u128>(core_index, vaddr, [&](u128 expected) -> bool {
+    return DoExclusiveOperation<u128>(core_index, vaddr, [&](u128 expected) -> bool {
         return memory.WriteExclusive128(vaddr, value, expected);
     });
 }
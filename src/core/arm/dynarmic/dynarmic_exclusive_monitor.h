@@ -3,10 +3,13 @@
 
 #pragma once
 
+#include <optional>
+
 #include <dynarmic/interface/exclusive_monitor.h>
 
 #include "common/common_types.h"
 #include "core/arm/exclusive_monitor.h"
+#include "core/arm/exclusive_reservations.h"
 
 namespace Core::Memory {
 class Memory;
@@ -17,6 +20,10 @@ namespace Core {
 class ArmDynarmic32;
 class ArmDynarmic64;
 
+/// Returns true when the JIT completes exclusive stores with a host compare and swap, without
+/// going through the lock of the global monitor
+bool IsGlobalMonitorIgnored();
+
 class DynarmicExclusiveMonitor final : public ExclusiveMonitor {
 public:
     explicit DynarmicExclusiveMonitor(Memory::Memory& memory_, std::size_t core_count_);
@@ -36,9 +43,17 @@ public:
     bool ExclusiveWrite128(std::size_t core_index, VAddr vaddr, u128 value) override;
 
 private:
+    template <typename T, typename Function>
+    T ReadAndMark(std::size_t core_index, VAddr addr, Function&& read);
+
+    template <typename T, typename Function>
+    bool DoExclusiveOperation(std::size_t core_index, VAddr addr, Function&& operation);
+
     friend class ArmDynarmic32;
     friend class ArmDynarmic64;
     Dynarmic::ExclusiveMonitor monitor;
+    /// Lock free reservations, used instead of the monitor when the JIT doesn't go through it
+    std::optional<ExclusiveReservations> reservations;
     Core::Memory::Memory& memory;
 };
 
@@ -0,0 +1,70 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+#include "common/common_types.h"
+
+namespace Core {
+
+/**
+ * Exclusive reservations of each core, for monitors that complete exclusive stores with a host
+ * compare and swap against the value observed by the exclusive load.
+ *
+ * No lock is taken, as a core only ever touches its own reservation. Like with a host compare and
+ * swap, a store succeeds when the value was changed and then restored by another core.
+ */
+class ExclusiveReservations {
+public:
+    explicit ExclusiveReservations(std::size_t core_count) : reservations(core_count) {}
+
+    template <typename T, typename Function>
+    T ReadAndMark(std::size_t core_index, VAddr address, Function&& read) {
+        static_assert(sizeof(T) <= sizeof(Reservation::value));
+        const T value = read();
+        Reservation& reservation = reservations[core_index];
+        reservation.address = address;
+        reservation.size = sizeof(T);
+        std::memcpy(reservation.value.data(), &value, sizeof(T));
+        return value;
+    }
+
+    /// Calls the operation with the reserved value when the address is reserved by the core,
+    /// the reservation is cleared in any case
+    template <typename T, typename Function>
+    bool DoExclusiveOperation(std::size_t core_index, VAddr address, Function&& operation) {
+        Reservation& reservation = reservations[core_index];
+        const bool is_reserved = reservation.size == sizeof(T) && reservation.address == address;
+        reservation.size = 0;
+        if (!is_reserved) {
+            return false;
+        }
+        T expected;
+        std::memcpy(&expected, reservation.value.data(), sizeof(T));
+        return operation(expected);
+    }
+
+    void ClearProcessor(std::size_t core_index) {
+        reservations[core_index].size = 0;
+    }
+
+private:
+    // Covers the adjacent line prefetch of x86 and the 128 byte lines of Apple cores
+    static constexpr std::size_t CacheLineSize = 128;
+
+    // Reservations are written on every exclusive access, keep them in separate cache lines
+    struct alignas(CacheLineSize) Reservation {
+        VAddr address{};
+        std::size_t size{};
+        std::array<u64, 2> value{};
+    };
+
+    std::vector<Reservation> reservations;
+};
+
+} // namespace Core
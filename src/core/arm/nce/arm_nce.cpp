@@ -236,15 +236,19 @@ u32 ArmNce::GetSvcNumber() const {
     return m_guest_ctx.svc;
 }
 
-void ArmNce::GetSvcArguments(std::span<uint64_t, 8> args) const {
+void ArmNce::GetSvcArguments(std::span<uint64_t, 8> args, u32 mask) const {
     for (size_t i = 0; i < 8; i++) {
-        args[i] = m_guest_ctx.cpu_registers[i];
+        if (mask & (1U << i)) {
+            args[i] = m_guest_ctx.cpu_registers[i];
+        }
     }
 }
 
-void ArmNce::SetSvcArguments(std::span<const uint64_t, 8> args) {
+void ArmNce::SetSvcArguments(std::span<const uint64_t, 8> args, u32 mask) {
     for (size_t i = 0; i < 8; i++) {
-        m_guest_ctx.cpu_registers[i] = args[i];
+        if (mask & (1U << i)) {
+            m_guest_ctx.cpu_registers[i] = args[i];
+        }
     }
 }
 
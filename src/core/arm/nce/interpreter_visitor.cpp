@@ -2,11 +2,44 @@
 // SPDX-FileCopyrightText: Copyright 2023 merryhime <https://mary.rs>
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <array>
+#include <atomic>
+#include <bit>
+#include <functional>
+
 #include "common/bit_cast.h"
 #include "core/arm/nce/interpreter_visitor.h"
 
 namespace Core {
 
+namespace {
+/// Counts how often each instruction had to be interpreted. This runs in the fault handler, so
+/// the table is lock free and never allocates.
+class FaultCounters {
+public:
+    /// Returns the new count, or zero when the table is full
+    u64 Increment(const char* name) {
+        const size_t start = std::hash<const char*>{}(name) % NumSlots;
+        for (size_t i = 0; i < NumSlots; ++i) {
+            const size_t slot = (start + i) % NumSlots;
+            const char* expected = nullptr;
+            if (names[slot].compare_exchange_strong(expected, name) || expected == name) {
+                return counts[slot].fetch_add(1, std::memory_order_relaxed) + 1;
+            }
+        }
+        return 0;
+    }
+
+private:
+    static constexpr size_t NumSlots = 128;
+
+    std::array<std::atomic<const char*>, NumSlots> names{};
+    std::array<std::atomic<u64>, NumSlots> counts{};
+};
+
+FaultCounters g_fault_counters;
+} // Anonymous namespace
+
 template <u32 BitSize>
 u64 SignExtendToLong(u64 value) {
     u64 mask = 1ULL << (BitSize - 1);
@@ -402,6 +435,18 @@ bool InterpreterVisitor::STP_LDP_fpsimd(Imm<2> opc, bool not_postindex, bool wba
     return true;
 }
 
+bool InterpreterVisitor::STNP_LDNP_gen(Imm<1> upper_opc, Imm<1> L, Imm<7> imm7, Reg Rt2, Reg Rn,
+                                       Reg Rt) {
+    // The non-temporal hint does not affect behaviour, these are signed offset pairs
+    const Imm<2> opc{upper_opc.ZeroExtend() << 1};
+    return this->STP_LDP_gen(opc, true, false, L, imm7, Rt2, Rn, Rt);
+}
+
+bool InterpreterVisitor::STNP_LDNP_fpsimd(Imm<2> opc, Imm<1> L, Imm<7> imm7, Vec Vt2, Reg Rn,
+                                          Vec Vt) {
+    return this->STP_LDP_fpsimd(opc, true, false, L, imm7, Vt2, Rn, Vt);
+}
+
 bool InterpreterVisitor::RegisterImmediate(bool wback, bool postindex, size_t scale, u64 offset,
                                            Imm<2> size, Imm<2> opc, Reg Rn, Reg Rt) {
     MemOp memop;
@@ -793,6 +838,120 @@ bool InterpreterVisitor::LDR_reg_fpsimd(Imm<2> size, Imm<1> opc_1, Reg Rm, Imm<3
     return this->SIMDOffset(scale, shift, opc_0, Rm, option, Rn, Vt);
 }
 
+bool InterpreterVisitor::MultipleStructures(bool wback, MemOp memop, bool Q, std::optional<Reg> Rm,
+                                            Imm<4> opcode, Imm<2> size, Reg Rn, Vec Vt) {
+    const size_t datasize = Q ? 128 : 64;
+    const size_t esize = 8 << size.ZeroExtend<size_t>();
+    const size_t elements = datasize / esize;
+    const size_t ebytes = esize / 8;
+
+    size_t rpt;
+    size_t selem;
+    switch (opcode.ZeroExtend()) {
+    case 0b0000:
+        rpt = 1;
+        selem = 4;
+        break;
+    case 0b0010:
+        rpt = 4;
+        selem = 1;
+        break;
+    case 0b0100:
+        rpt = 1;
+        selem = 3;
+        break;
+    case 0b0110:
+        rpt = 3;
+        selem = 1;
+        break;
+    case 0b0111:
+        rpt = 1;
+        selem = 1;
+        break;
+    case 0b1000:
+        rpt = 1;
+        selem = 2;
+        break;
+    case 0b1010:
+        rpt = 2;
+        selem = 1;
+        break;
+    default:
+        // Unallocated encoding
+        return false;
+    }
+    if (size == 0b11 && !Q && selem != 1) {
+        // Reserved value
+        return false;
+    }
+
+    u64 address;
+    if (Rn == Reg::SP) {
+        address = this->GetSp();
+    } else {
+        address = this->GetReg(Rn);
+    }
+
+    // Loads write the whole register, so the upper half is cleared for 64-bit transfers
+    std::array<u128, 4> vectors{};
+    for (size_t i = 0; i < rpt * selem; ++i) {
+        if (memop == MemOp::Store) {
+            vectors[i] = this->GetVec(static_cast<Vec>((static_cast<size_t>(Vt) + i) % 32));
+        }
+    }
+
+    u64 offs = 0;
+    for (size_t r = 0; r < rpt; r++) {
+        for (size_t e = 0; e < elements; e++) {
+            for (size_t s = 0; s < selem; s++) {
+                u8* const element = reinterpret_cast<u8*>(vectors[r + s].data()) + e * ebytes;
+                if (memop == MemOp::Store) {
+                    m_memory.WriteBlock(address + offs, element, ebytes);
+                } else {
+                    m_memory.ReadBlock(address + offs, element, ebytes);
+                }
+                offs += ebytes;
+            }
+        }
+    }
+
+    if (memop == MemOp::Load) {
+        for (size_t i = 0; i < rpt * selem; ++i) {
+            this->SetVec(static_cast<Vec>((static_cast<size_t>(Vt) + i) % 32), vectors[i]);
+        }
+    }
+
+    if (wback) {
+        if (*Rm != Reg::SP) {
+            offs = this->GetReg(*Rm);
+        }
+
+        if (Rn == Reg::SP) {
+            this->SetSp(address + offs);
+        } else {
+            this->SetReg(Rn, address + offs);
+        }
+    }
+
+    return true;
+}
+
+bool InterpreterVisitor::STx_mult_1(bool Q, Imm<4> opcode, Imm<2> size, Reg Rn, Vec Vt) {
+    return this->MultipleStructures(false, MemOp::Store, Q, {}, opcode, size, Rn, Vt);
+}
+
+bool InterpreterVisitor::STx_mult_2(bool Q, Reg Rm, Imm<4> opcode, Imm<2> size, Reg Rn, Vec Vt) {
+    return this->MultipleStructures(true, MemOp::Store, Q, Rm, opcode, size, Rn, Vt);
+}
+
+bool InterpreterVisitor::LDx_mult_1(bool Q, Imm<4> opcode, Imm<2> size, Reg Rn, Vec Vt) {
+    return this->MultipleStructures(false, MemOp::Load, Q, {}, opcode, size, Rn, Vt);
+}
+
+bool InterpreterVisitor::LDx_mult_2(bool Q, Reg Rm, Imm<4> opcode, Imm<2> size, Reg Rn, Vec Vt) {
+    return this->MultipleStructures(true, MemOp::Load, Q, Rm, opcode, size, Rn, Vt);
+}
+
 std::optional<u64> MatchAndExecuteOneInstruction(Core::Memory::Memory& memory, mcontext_t* context,
                                                  fpsimd_context* fpsimd_context) {
     // Construct the interpreter.
@@ -810,6 +969,16 @@ std::optional<u64> MatchAndExecuteOneInstruction(Core::Memory::Memory& memory, m
     // Interpret the instruction.
     if (auto decoder = Dynarmic::A64::Decode<VisitorBase>(instruction)) {
         was_executed = decoder->get().call(visitor, instruction);
+
+        // Report instructions that keep faulting, they are worth handling natively
+        const char* const name = decoder->get().GetName();
+        const u64 count = g_fault_counters.Increment(name);
+        if (!was_executed) {
+            LOG_ERROR(Core_ARM, "Failed to interpret {} ({:#x}), {} faults", name, instruction,
+                      count);
+        } else if (std::has_single_bit(count)) {
+            LOG_DEBUG(Core_ARM, "Interpreted {} {} times", name, count);
+        }
     } else {
         LOG_ERROR(Core_ARM, "Unallocated encoding: {:#x}", instruction);
     }
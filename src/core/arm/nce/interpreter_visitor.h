@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <optional>
+
 #include <signal.h>
 #include <unistd.h>
 
@@ -56,6 +58,10 @@ public:
     bool STP_LDP_fpsimd(Imm<2> opc, bool not_postindex, bool wback, Imm<1> L, Imm<7> imm7, Vec Vt2,
                         Reg Rn, Vec Vt) override;
 
+    // Loads and stores - Load/Store no-allocate pair
+    bool STNP_LDNP_gen(Imm<1> upper_opc, Imm<1> L, Imm<7> imm7, Reg Rt2, Reg Rn, Reg Rt) override;
+    bool STNP_LDNP_fpsimd(Imm<2> opc, Imm<1> L, Imm<7> imm7, Vec Vt2, Reg Rn, Vec Vt) override;
+
     // Loads and stores - Load/Store register (immediate)
     bool RegisterImmediate(bool wback, bool postindex, size_t scale, u64 offset, Imm<2> size,
                            Imm<2> opc, Reg Rn, Reg Rt);
@@ -89,6 +95,14 @@ public:
     bool LDR_reg_fpsimd(Imm<2> size, Imm<1> opc_1, Reg Rm, Imm<3> option, bool S, Reg Rn,
                         Vec Vt) override;
 
+    // Loads and stores - Advanced SIMD Load/Store multiple structures
+    bool MultipleStructures(bool wback, MemOp memop, bool Q, std::optional<Reg> Rm, Imm<4> opcode,
+                            Imm<2> size, Reg Rn, Vec Vt);
+    bool STx_mult_1(bool Q, Imm<4> opcode, Imm<2> size, Reg Rn, Vec Vt) override;
+    bool STx_mult_2(bool Q, Reg Rm, Imm<4> opcode, Imm<2> size, Reg Rn, Vec Vt) override;
+    bool LDx_mult_1(bool Q, Imm<4> opcode, Imm<2> size, Reg Rn, Vec Vt) override;
+    bool LDx_mult_2(bool Q, Reg Rm, Imm<4> opcode, Imm<2> size, Reg Rn, Vec Vt) override;
+
 private:
     Core::Memory::Memory& m_memory;
     std::span<u64, 31> m_regs;
@@ -42,7 +42,9 @@ bool Patcher::PatchText(const Kernel::PhysicalMemory& program_image,
                         const Kernel::CodeSet::Segment& code) {
     // If we have patched modules but cannot reach the new module, then it needs its own patcher.
     const size_t image_size = program_image.size();
-    if (total_program_size + image_size > MaxRelativeBranch && total_program_size > 0) {
+    const size_t patch_start = m_patch_instructions.size();
+    if (total_program_size + image_size + patch_start * sizeof(u32) > MaxRelativeBranch &&
+        total_program_size > 0) {
         return false;
     }
 
@@ -113,6 +115,17 @@ bool Patcher::PatchText(const Kernel::PhysicalMemory& program_image,
         }
     }
 
+    // The trampolines of this module grow the patch section, which may push the earlier modules
+    // out of branch range. Undo them, so the module is patched with its own patch section.
+    const size_t patch_size = m_patch_instructions.size() * sizeof(u32);
+    if (total_program_size + image_size + patch_size > MaxRelativeBranch &&
+        total_program_size > 0) {
+        m_patch_instructions.resize(patch_start);
+        modules.pop_back();
+        curr_patch = &modules.back();
+        return false;
+    }
+
     // Determine patching mode for the final relocation step
     total_program_size += image_size;
     this->mode = image_size > MaxRelativeBranch ? PatchMode::PreText : PatchMode::PostData;
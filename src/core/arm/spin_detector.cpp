@@ -0,0 +1,33 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <thread>
+
+#include "core/arm/spin_detector.h"
+#include "core/core_timing.h"
+
+namespace Core {
+
+u64 SpinDetector::ReadCounter(Timing::CoreTiming& core_timing, bool uses_wall_clock) {
+    const u64 counter = core_timing.GetClockTicks();
+    const u64 interval = counter - last_counter;
+    last_counter = counter;
+    if (interval > MaxSpinInterval) {
+        num_close_reads = 0;
+        return counter;
+    }
+    if (num_close_reads < MinSpinReads) {
+        ++num_close_reads;
+        return counter;
+    }
+    if (uses_wall_clock) {
+        std::this_thread::yield();
+    } else {
+        // Nothing changes until the next event, and ticking to it ends the time slice
+        core_timing.AddTicks(static_cast<u64>(std::max<s64>(core_timing.GetDowncount(), 0)));
+    }
+    return counter;
+}
+
+} // namespace Core
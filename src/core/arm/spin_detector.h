@@ -0,0 +1,34 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "common/common_types.h"
+
+namespace Core {
+
+namespace Timing {
+class CoreTiming;
+}
+
+/**
+ * Detects guest code busy waiting on the system counter, which shows up as a long run of reads
+ * only a few microseconds apart. While the guest spins, reads give the host core away: with the
+ * wall clock the host thread yields, otherwise the emulated time skips to the next event.
+ */
+class SpinDetector {
+public:
+    /// Reads the system counter on behalf of the guest
+    u64 ReadCounter(Timing::CoreTiming& core_timing, bool uses_wall_clock);
+
+private:
+    /// Counter ticks between the reads of a spin loop, about 5us at 19.2 MHz
+    static constexpr u64 MaxSpinInterval = 96;
+    /// Consecutive close reads before the guest is considered to be spinning
+    static constexpr u32 MinSpinReads = 64;
+
+    u64 last_counter{};
+    u32 num_close_reads{};
+};
+
+} // namespace Core
@@ -9,11 +9,13 @@
 
 #include "audio_core/audio_core.h"
 #include "common/fs/fs.h"
+#include "common/fs/path_util.h"
 #include "common/logging/log.h"
 #include "common/microprofile.h"
 #include "common/settings.h"
 #include "common/settings_enums.h"
 #include "common/string_util.h"
+#include "common/tracing.h"
 #include "core/arm/exclusive_monitor.h"
 #include "core/core.h"
 #include "core/core_timing.h"
@@ -58,6 +60,7 @@
 #include "core/reporter.h"
 #include "core/telemetry_session.h"
 #include "core/tools/freezer.h"
+#include "core/tools/guest_profiler.h"
 #include "core/tools/renderdoc.h"
 #include "hid_core/hid_core.h"
 #include "network/network.h"
@@ -405,6 +408,17 @@ struct System::Impl {
             }
         }
 
+        if (Settings::values.profile_guest_cpu) {
+            guest_profiler = std::make_unique<Tools::GuestProfiler>(system);
+        }
+
+        if (Settings::values.enable_tracing) {
+            const auto log_dir{Common::FS::GetYuzuPath(Common::FS::YuzuPath::LogDir)};
+            if (Common::FS::CreateDir(log_dir)) {
+                Common::Tracing::Start(log_dir / "yuzu_trace.json");
+            }
+        }
+
         perf_stats = std::make_unique<PerfStats>(params.program_id);
         // Reset counters and set time origin to current frame
         GetAndResetPerfStats();
@@ -447,6 +461,11 @@ struct System::Impl {
                                         perf_stats->GetMeanFrametime());
         }
 
+        // Write the guest profile while the application process is still alive
+        if (guest_profiler) {
+            guest_profiler->Stop();
+        }
+
         is_powered_on = false;
         exit_locked = false;
         exit_requested = false;
@@ -474,11 +493,15 @@ struct System::Impl {
         host1x_core.reset();
         perf_stats.reset();
         cpu_manager.Shutdown();
+        guest_profiler.reset();
         debugger.reset();
         kernel.Shutdown();
         stop_event = {};
         Network::RestartSocketOperations();
 
+        // All emulation threads have exited, so the trace holds their complete timelines
+        Common::Tracing::Stop();
+
         if (auto room_member = room_network.GetRoomMember().lock()) {
             Network::GameInfo game_info{};
             room_member->SendGameInfo(game_info);
@@ -567,6 +590,7 @@ struct System::Impl {
     Reporter reporter;
     std::unique_ptr<Memory::CheatEngine> cheat_engine;
     std::unique_ptr<Tools::Freezer> memory_freezer;
+    std::unique_ptr<Tools::GuestProfiler> guest_profiler;
     std::array<u8, 0x20> build_id{};
 
     std::unique_ptr<Tools::RenderdocAPI> renderdoc_api;
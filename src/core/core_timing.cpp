@@ -5,14 +5,7 @@
 #include <mutex>
 #include <string>
 #include <tuple>
-
-#ifdef _WIN32
-#include "common/windows/timer_resolution.h"
-#endif
-
-#ifdef ARCHITECTURE_x86_64
-#include "common/x64/cpu_wait.h"
-#endif
+#include <vector>
 
 #include "common/microprofile.h"
 #include "core/core_timing.h"
@@ -22,6 +15,9 @@ namespace Core::Timing {
 
 constexpr s64 MAX_SLICE_LENGTH = 10000;
 
+/// Queue size below which cancelled events are only dropped when they reach the top
+constexpr size_t MIN_PURGE_THRESHOLD = 64;
+
 std::shared_ptr<EventType> CreateEvent(std::string name, TimedCallback&& callback) {
     return std::make_shared<EventType>(std::move(callback), std::move(name));
 }
@@ -31,8 +27,15 @@ struct CoreTiming::Event {
     u64 fifo_order;
     std::weak_ptr<EventType> type;
     s64 reschedule_time;
+    /// Sequence number of the type when scheduled, the event is cancelled once they differ
+    size_t sequence_number;
     heap_t::handle_type handle{};
 
+    bool IsCancelled() const {
+        const auto event_type{type.lock()};
+        return !event_type || event_type->sequence_number != sequence_number;
+    }
+
     // Sort by time, unless the times are the same, in which case sort by
     // the order added to the queue
     friend bool operator>(const Event& left, const Event& right) {
@@ -74,6 +77,7 @@ void CoreTiming::Initialize(std::function<void()>&& on_thread_init_) {
 void CoreTiming::ClearPendingEvents() {
     std::scoped_lock lock{advance_lock, basic_lock};
     event_queue.clear();
+    purge_threshold = 0;
     event.Set();
 }
 
@@ -121,7 +125,8 @@ void CoreTiming::ScheduleEvent(std::chrono::nanoseconds ns_into_future,
         std::scoped_lock scope{basic_lock};
         const auto next_time{absolute_time ? ns_into_future : GetGlobalTimeNs() + ns_into_future};
 
-        auto h{event_queue.emplace(Event{next_time.count(), event_fifo_id++, event_type, 0})};
+        auto h{event_queue.emplace(Event{next_time.count(), event_fifo_id++, event_type, 0,
+                                         event_type->sequence_number})};
         (*h).handle = h;
     }
 
@@ -136,8 +141,8 @@ void CoreTiming::ScheduleLoopingEvent(std::chrono::nanoseconds start_time,
         std::scoped_lock scope{basic_lock};
         const auto next_time{absolute_time ? start_time : GetGlobalTimeNs() + start_time};
 
-        auto h{event_queue.emplace(
-            Event{next_time.count(), event_fifo_id++, event_type, resched_time.count()})};
+        auto h{event_queue.emplace(Event{next_time.count(), event_fifo_id++, event_type,
+                                         resched_time.count(), event_type->sequence_number})};
         (*h).handle = h;
     }
 
@@ -147,20 +152,9 @@ void CoreTiming::ScheduleLoopingEvent(std::chrono::nanoseconds start_time,
 void CoreTiming::UnscheduleEvent(const std::shared_ptr<EventType>& event_type,
                                  UnscheduleEventType type) {
     {
+        // Scheduled events of this type are cancelled by the new sequence number, and they are
+        // removed from the queue lazily instead of searching for them here
         std::scoped_lock lk{basic_lock};
-
-        std::vector<heap_t::handle_type> to_remove;
-        for (auto itr = event_queue.begin(); itr != event_queue.end(); itr++) {
-            const Event& e = *itr;
-            if (e.type.lock().get() == event_type.get()) {
-                to_remove.push_back(itr->handle);
-            }
-        }
-
-        for (auto& h : to_remove) {
-            event_queue.erase(h);
-        }
-
         event_type->sequence_number++;
     }
 
@@ -203,6 +197,10 @@ std::optional<s64> CoreTiming::Advance() {
 
     while (!event_queue.empty() && event_queue.top().time <= global_timer) {
         const Event& evt = event_queue.top();
+        if (evt.IsCancelled()) {
+            event_queue.pop();
+            continue;
+        }
 
         if (const auto event_type{evt.type.lock()}) {
             const auto evt_time = evt.time;
@@ -226,7 +224,8 @@ std::optional<s64> CoreTiming::Advance() {
                 basic_lock.lock();
 
                 if (evt_sequence_num != event_type->sequence_number) {
-                    // Heap handle is invalidated after external modification.
+                    // The event was unscheduled while its callback ran.
+                    event_queue.erase(evt.handle);
                     continue;
                 }
 
@@ -241,14 +240,20 @@ std::optional<s64> CoreTiming::Advance() {
                     next_time = pause_end_time + next_schedule_time;
                 }
 
-                event_queue.update(evt.handle, Event{next_time, event_fifo_id++, evt.type,
-                                                     next_schedule_time, evt.handle});
+                event_queue.update(evt.handle,
+                                   Event{next_time, event_fifo_id++, evt.type, next_schedule_time,
+                                         evt_sequence_num, evt.handle});
             }
         }
 
         global_timer = GetGlobalTimeNs().count();
     }
 
+    // Only done here, as no callback of a queued event is running
+    PurgeCancelledEvents();
+    while (!event_queue.empty() && event_queue.top().IsCancelled()) {
+        event_queue.pop();
+    }
     if (!event_queue.empty()) {
         return event_queue.top().time;
     } else {
@@ -256,6 +261,24 @@ std::optional<s64> CoreTiming::Advance() {
     }
 }
 
+void CoreTiming::PurgeCancelledEvents() {
+    // Purging when the queue doubles keeps the cost constant per scheduled event, even when
+    // events are cancelled long before they are due
+    if (event_queue.size() <= std::max(purge_threshold, MIN_PURGE_THRESHOLD)) {
+        return;
+    }
+    std::vector<heap_t::handle_type> to_remove;
+    for (const Event& e : event_queue) {
+        if (e.IsCancelled()) {
+            to_remove.push_back(e.handle);
+        }
+    }
+    for (const auto& h : to_remove) {
+        event_queue.erase(h);
+    }
+    purge_threshold = event_queue.size() * 2;
+}
+
 void CoreTiming::ThreadLoop() {
     has_started = true;
     while (!shutting_down) {
@@ -264,28 +287,12 @@ void CoreTiming::ThreadLoop() {
             const auto next_time = Advance();
             if (next_time) {
                 // There are more events left in the queue, wait until the next event.
-                auto wait_time = *next_time - GetGlobalTimeNs().count();
+                const auto wait_time = *next_time - GetGlobalTimeNs().count();
                 if (wait_time > 0) {
-#ifdef _WIN32
-                    while (!paused && !event.IsSet() && wait_time > 0) {
-                        wait_time = *next_time - GetGlobalTimeNs().count();
-                        if (wait_time >= timer_resolution_ns) {
-                            Common::Windows::SleepForOneTick();
-                        } else {
-#ifdef ARCHITECTURE_x86_64
-                            Common::X64::MicroSleep();
-#else
-                            std::this_thread::yield();
-#endif
-                        }
-                    }
-
-                    if (event.IsSet()) {
-                        event.Reset();
-                    }
-#else
-                    event.WaitFor(std::chrono::nanoseconds(wait_time));
-#endif
+                    // Newly scheduled events and pauses set the event, ending the wait early
+                    timer_waiter.WaitUntil(Common::PreciseWaiter::Clock::now() +
+                                               std::chrono::nanoseconds(wait_time),
+                                           event);
                 }
             } else {
                 // Queue is empty, wait until another event is scheduled and signals us to
@@ -329,7 +336,7 @@ std::chrono::microseconds CoreTiming::GetGlobalTimeUs() const {
 
 #ifdef _WIN32
 void CoreTiming::SetTimerResolutionNs(std::chrono::nanoseconds ns) {
-    timer_resolution_ns = ns.count();
+    timer_waiter.SetMinimumSpinMargin(ns);
 }
 #endif
 
@@ -15,6 +15,7 @@
 #include <boost/heap/fibonacci_heap.hpp>
 
 #include "common/common_types.h"
+#include "common/precise_wait.h"
 #include "common/thread.h"
 #include "common/wall_clock.h"
 
@@ -146,19 +147,22 @@ private:
 
     void Reset();
 
+    /// Removes cancelled events once they make up a large part of the queue
+    void PurgeCancelledEvents();
+
     std::unique_ptr<Common::WallClock> clock;
 
     s64 global_timer = 0;
 
-#ifdef _WIN32
-    s64 timer_resolution_ns;
-#endif
+    /// Waits of the timer thread until the next event
+    Common::PreciseWaiter timer_waiter{"CoreTiming"};
 
     using heap_t =
         boost::heap::fibonacci_heap<CoreTiming::Event, boost::heap::compare<std::greater<>>>;
 
     heap_t event_queue;
     u64 event_fifo_id = 0;
+    size_t purge_threshold = 0;
 
     Common::Event event{};
     Common::Event pause_event{};
@@ -1,10 +1,13 @@
 // SPDX-FileCopyrightText: Copyright 2018 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include <array>
 #include <mbedtls/cipher.h>
 #include "common/assert.h"
+#include "common/div_ceil.h"
 #include "common/logging/log.h"
+#include "common/task_scheduler.h"
 #include "core/crypto/aes_util.h"
 #include "core/crypto/key_manager.h"
 
@@ -20,6 +23,17 @@ NintendoTweak CalculateNintendoTweak(std::size_t sector_id) {
     }
     return out;
 }
+
+constexpr std::size_t ParallelChunkSize = 0x40000;
+
+void AddToCounter(std::array<u8, 0x10>& ctr, u64 num_blocks) {
+    u64 carry = num_blocks;
+    for (std::size_t i = ctr.size(); i-- > 0 && carry != 0;) {
+        const u64 sum = ctr[i] + (carry & 0xFF);
+        ctr[i] = static_cast<u8>(sum);
+        carry = (carry >> 8) + (sum >> 8);
+    }
+}
 } // Anonymous namespace
 
 static_assert(static_cast<std::size_t>(Mode::CTR) ==
@@ -72,7 +86,9 @@ void AESCipher<Key, KeySize>::Transcode(const u8* src, std::size_t size, u8* des
     mbedtls_cipher_reset(context);
 
     std::size_t written = 0;
-    if (mbedtls_cipher_get_cipher_mode(context) == MBEDTLS_MODE_XTS) {
+    const auto cipher_mode = mbedtls_cipher_get_cipher_mode(context);
+    if (cipher_mode == MBEDTLS_MODE_XTS || cipher_mode == MBEDTLS_MODE_CTR) {
+        // CTR is a stream mode, it is transcoded in a single call like XTS.
         mbedtls_cipher_update(context, src, size, dest, &written);
         if (written != size) {
             LOG_WARNING(Crypto, "Not all data was decrypted requested={:016X}, actual={:016X}.",
@@ -126,4 +142,27 @@ void AESCipher<Key, KeySize>::SetIV(std::span<const u8> data) {
 
 template class AESCipher<Key128>;
 template class AESCipher<Key256>;
+
+void ParallelCtrTranscode(const std::array<u8, 0x10>& key, const std::array<u8, 0x10>& ctr,
+                          const u8* src, std::size_t size, u8* dest, Op op) {
+    const std::size_t num_chunks = Common::DivCeil(size, ParallelChunkSize);
+    const auto transcode_chunk = [&](std::size_t index) {
+        const std::size_t offset = index * ParallelChunkSize;
+        auto chunk_ctr = ctr;
+        AddToCounter(chunk_ctr, offset / 0x10);
+
+        AESCipher<Key128> cipher(key, Mode::CTR);
+        cipher.SetIV(chunk_ctr);
+        cipher.Transcode(src + offset, std::min(ParallelChunkSize, size - offset), dest + offset,
+                         op);
+    };
+
+    // The calling thread transcodes the first chunk itself while the workers do the rest
+    Common::TaskGroup workers{Common::TaskPriority::High};
+    for (std::size_t index = 1; index < num_chunks; ++index) {
+        workers.Run([&transcode_chunk, index] { transcode_chunk(index); });
+    }
+    transcode_chunk(0);
+    workers.Wait();
+}
 } // namespace Core::Crypto
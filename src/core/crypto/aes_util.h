@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <array>
 #include <memory>
 #include <span>
 #include <type_traits>
@@ -59,4 +60,17 @@ public:
 private:
     std::unique_ptr<CipherContext> ctx;
 };
+
+/// Size from which CTR transcoding is worth splitting across worker threads
+constexpr std::size_t ParallelTranscodeThreshold = 0x100000;
+
+/**
+ * Transcodes a large AES-128-CTR buffer, splitting it in chunks transcoded in parallel.
+ * Every chunk uses its own cipher context, so the caller's cipher is left untouched.
+ *
+ * @param key Cipher key
+ * @param ctr Counter of the first block of src
+ */
+void ParallelCtrTranscode(const std::array<u8, 0x10>& key, const std::array<u8, 0x10>& ctr,
+                          const u8* src, std::size_t size, u8* dest, Op op);
 } // namespace Core::Crypto
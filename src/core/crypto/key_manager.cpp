@@ -8,6 +8,8 @@
 #include <fstream>
 #include <locale>
 #include <map>
+#include <mutex>
+#include <shared_mutex>
 #include <sstream>
 #include <tuple>
 #include <vector>
@@ -682,6 +684,7 @@ void KeyManager::LoadFromFile(const std::filesystem::path& file_path, bool is_ti
         return;
     }
 
+    std::scoped_lock lock{key_mutex};
     std::string line;
     while (std::getline(file, line)) {
         std::vector<std::string> out;
@@ -781,6 +784,7 @@ void KeyManager::LoadFromFile(const std::filesystem::path& file_path, bool is_ti
 }
 
 bool KeyManager::AreKeysLoaded() const {
+    std::shared_lock lock{key_mutex};
     return !s128_keys.empty() && !s256_keys.empty();
 }
 
@@ -808,42 +812,56 @@ bool KeyManager::BaseDeriveNecessary() const {
 }
 
 bool KeyManager::HasKey(S128KeyType id, u64 field1, u64 field2) const {
+    std::shared_lock lock{key_mutex};
     return s128_keys.find({id, field1, field2}) != s128_keys.end();
 }
 
 bool KeyManager::HasKey(S256KeyType id, u64 field1, u64 field2) const {
+    std::shared_lock lock{key_mutex};
     return s256_keys.find({id, field1, field2}) != s256_keys.end();
 }
 
 Key128 KeyManager::GetKey(S128KeyType id, u64 field1, u64 field2) const {
-    if (!HasKey(id, field1, field2)) {
+    std::shared_lock lock{key_mutex};
+    const auto iter = s128_keys.find({id, field1, field2});
+    if (iter == s128_keys.end()) {
         return {};
     }
-    return s128_keys.at({id, field1, field2});
+    return iter->second;
 }
 
 Key256 KeyManager::GetKey(S256KeyType id, u64 field1, u64 field2) const {
-    if (!HasKey(id, field1, field2)) {
+    std::shared_lock lock{key_mutex};
+    const auto iter = s256_keys.find({id, field1, field2});
+    if (iter == s256_keys.end()) {
         return {};
     }
-    return s256_keys.at({id, field1, field2});
+    return iter->second;
 }
 
 Key256 KeyManager::GetBISKey(u8 partition_id) const {
     Key256 out{};
 
+    std::shared_lock lock{key_mutex};
     for (const auto& bis_type : {BISKeyType::Crypto, BISKeyType::Tweak}) {
-        if (HasKey(S128KeyType::BIS, partition_id, static_cast<u64>(bis_type))) {
-            std::memcpy(
-                out.data() + sizeof(Key128) * static_cast<u64>(bis_type),
-                s128_keys.at({S128KeyType::BIS, partition_id, static_cast<u64>(bis_type)}).data(),
-                sizeof(Key128));
+        const auto iter =
+            s128_keys.find({S128KeyType::BIS, partition_id, static_cast<u64>(bis_type)});
+        if (iter != s128_keys.end()) {
+            std::memcpy(out.data() + sizeof(Key128) * static_cast<u64>(bis_type),
+                        iter->second.data(), sizeof(Key128));
         }
     }
 
     return out;
 }
 
+Key128 KeyManager::GetTitlekey(const u128& rights_id) {
+    if (!HasKey(S128KeyType::Titlekey, rights_id[1], rights_id[0])) {
+        PopulateTickets();
+    }
+    return GetKey(S128KeyType::Titlekey, rights_id[1], rights_id[0]);
+}
+
 template <size_t Size>
 void KeyManager::WriteKeyToFile(KeyCategory category, std::string_view keyname,
                                 const std::array<u8, Size>& key) {
@@ -879,7 +897,7 @@ void KeyManager::WriteKeyToFile(KeyCategory category, std::string_view keyname,
 }
 
 void KeyManager::SetKey(S128KeyType id, Key128 key, u64 field1, u64 field2) {
-    if (s128_keys.find({id, field1, field2}) != s128_keys.end() || key == Key128{}) {
+    if (key == Key128{} || HasKey(id, field1, field2)) {
         return;
     }
     if (id == S128KeyType::Titlekey) {
@@ -928,11 +946,12 @@ void KeyManager::SetKey(S128KeyType id, Key128 key, u64 field1, u64 field2) {
         WriteKeyToFile(category, fmt::format("keyblob_key_source_{:02X}", field2), key);
     }
 
+    std::scoped_lock lock{key_mutex};
     s128_keys[{id, field1, field2}] = key;
 }
 
 void KeyManager::SetKey(S256KeyType id, Key256 key, u64 field1, u64 field2) {
-    if (s256_keys.find({id, field1, field2}) != s256_keys.end() || key == Key256{}) {
+    if (key == Key256{} || HasKey(id, field1, field2)) {
         return;
     }
     const auto iter = std::find_if(
@@ -943,6 +962,7 @@ void KeyManager::SetKey(S256KeyType id, Key256 key, u64 field1, u64 field2) {
     if (iter != s256_file_id.end()) {
         WriteKeyToFile(KeyCategory::Standard, iter->first, key);
     }
+    std::scoped_lock lock{key_mutex};
     s256_keys[{id, field1, field2}] = key;
 }
 
@@ -1189,6 +1209,7 @@ void KeyManager::DeriveETicket(PartitionDataManager& data,
 }
 
 void KeyManager::PopulateTickets() {
+    std::scoped_lock lock{ticket_mutex};
     if (ticket_databases_loaded) {
         return;
     }
@@ -1220,6 +1241,7 @@ void KeyManager::PopulateTickets() {
 }
 
 void KeyManager::SynthesizeTickets() {
+    std::shared_lock lock{key_mutex};
     for (const auto& key : s128_keys) {
         if (key.first.type != S128KeyType::Titlekey) {
             continue;
@@ -6,7 +6,9 @@
 #include <array>
 #include <filesystem>
 #include <map>
+#include <mutex>
 #include <optional>
+#include <shared_mutex>
 #include <span>
 #include <string>
 
@@ -270,6 +272,10 @@ public:
 
     Key256 GetBISKey(u8 partition_id) const;
 
+    // Returns the titlekey of a rights ID. The NAND ticket databases are only scanned the first
+    // time a titlekey is missing, keys found there are persisted to title.keys_autogenerated.
+    Key128 GetTitlekey(const u128& rights_id);
+
     void SetKey(S128KeyType id, Key128 key, u64 field1 = 0, u64 field2 = 0);
     void SetKey(S256KeyType id, Key256 key, u64 field1 = 0, u64 field2 = 0);
 
@@ -300,11 +306,14 @@ private:
 
     std::map<KeyIndex<S128KeyType>, Key128> s128_keys;
     std::map<KeyIndex<S256KeyType>, Key256> s256_keys;
+    // The instance is shared by every system of the process, guards the key maps
+    mutable std::shared_mutex key_mutex;
 
     // Map from rights ID to ticket
     std::map<u128, Ticket> common_tickets;
     std::map<u128, Ticket> personal_tickets;
     bool ticket_databases_loaded = false;
+    std::mutex ticket_mutex;
 
     std::array<std::array<u8, 0xB0>, 0x20> encrypted_keyblobs{};
     std::array<std::array<u8, 0x90>, 0x20> keyblobs{};
@@ -292,20 +292,21 @@ Loader::ResultStatus XCI::AddNCAFromPartition(XCIPartition part) {
             continue;
         }
 
+        // Only the header is parsed here, the sections are opened once they're used.
         auto nca = std::make_shared<NCA>(partition_file);
         if (nca->IsUpdate()) {
             continue;
         }
+        const auto nca_status = nca->GetHeaderStatus();
         if (nca->GetType() == NCAContentType::Program) {
-            program_nca_status = nca->GetStatus();
+            program_nca_status = nca_status;
         }
-        if (nca->GetStatus() == Loader::ResultStatus::Success) {
+        if (nca_status == Loader::ResultStatus::Success) {
             ncas.push_back(std::move(nca));
         } else {
-            const u16 error_id = static_cast<u16>(nca->GetStatus());
+            const u16 error_id = static_cast<u16>(nca_status);
             LOG_CRITICAL(Loader, "Could not load NCA {}/{}, failed with error code {:04X} ({})",
-                         partition_names[partition_index], nca->GetName(), error_id,
-                         nca->GetStatus());
+                         partition_names[partition_index], nca->GetName(), error_id, nca_status);
         }
     }
 
@@ -5,6 +5,7 @@
 
 #include <array>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <vector>
@@ -61,12 +62,15 @@ inline bool IsDirectoryLogoPartition(const VirtualDir& pfs) {
 
 // An implementation of VfsDirectory that represents a Nintendo Content Archive (NCA) container.
 // After construction, use GetStatus to determine if the file is valid and ready to be used.
+// Only the header is parsed at construction, the sections are opened when first accessed.
 class NCA : public ReadOnlyVfsDirectory {
 public:
     explicit NCA(VirtualFile file, const NCA* base_nca = nullptr);
     ~NCA() override;
 
     Loader::ResultStatus GetStatus() const;
+    /// Returns the status of the header alone, without opening the sections.
+    Loader::ResultStatus GetHeaderStatus() const;
 
     std::vector<VirtualFile> GetFiles() const override;
     std::vector<VirtualDir> GetSubdirectories() const override;
@@ -88,21 +92,26 @@ public:
     VirtualDir GetLogoPartition() const;
 
 private:
-    std::vector<VirtualDir> dirs;
-    std::vector<VirtualFile> files;
+    void OpenSections() const;
 
-    VirtualFile romfs = nullptr;
-    VirtualDir exefs = nullptr;
-    VirtualDir logo = nullptr;
+    mutable std::once_flag sections_opened;
+    mutable std::vector<VirtualDir> dirs;
+    mutable std::vector<VirtualFile> files;
+
+    mutable VirtualFile romfs = nullptr;
+    mutable VirtualDir exefs = nullptr;
+    mutable VirtualDir logo = nullptr;
     VirtualFile file;
 
-    Loader::ResultStatus status{};
+    Loader::ResultStatus header_status{};
+    mutable Loader::ResultStatus status{};
 
     bool encrypted = false;
     bool is_update = false;
 
     Core::Crypto::KeyManager& keys;
     std::shared_ptr<NcaReader> reader;
+    std::shared_ptr<NcaReader> base_reader;
 };
 
 } // namespace FileSys
@@ -56,7 +56,12 @@ size_t AesCtrStorage::Read(u8* buffer, size_t size, size_t offset) const {
     std::memcpy(ctr.data(), m_iv.data(), IvSize);
     AddCounter(ctr.data(), IvSize, offset / BlockSize);
 
-    // Decrypt.
+    // Decrypt, splitting large reads across worker threads.
+    if (size >= Core::Crypto::ParallelTranscodeThreshold) {
+        Core::Crypto::ParallelCtrTranscode(m_key, ctr, buffer, size, buffer,
+                                           Core::Crypto::Op::Decrypt);
+        return size;
+    }
     m_cipher->SetIV(ctr);
     m_cipher->Transcode(buffer, size, buffer, Core::Crypto::Op::Decrypt);
 
@@ -0,0 +1,232 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cstring>
+
+#include "common/logging/log.h"
+#include "common/thread_worker.h"
+#include "core/file_sys/fssystem/fssystem_block_cache_storage.h"
+
+namespace FileSys {
+
+namespace {
+
+Common::ThreadWorker& GetPrefetchWorker() {
+    static Common::ThreadWorker worker(1, "RomfsPrefetch");
+    return worker;
+}
+
+} // namespace
+
+BlockCacheStorage::BlockCacheStorage(VirtualFile base_storage, size_t cache_size, u64 program_id)
+    : m_base_storage(std::move(base_storage)), m_size(m_base_storage->GetSize()),
+      m_max_blocks_per_shard(std::max<size_t>(cache_size / BlockSize / NumShards, 1)),
+      m_program_id(program_id) {}
+
+BlockCacheStorage::~BlockCacheStorage() {
+    // Wait for the queued prefetches, they reference this storage.
+    while (const u32 pending = m_pending_prefetches.load(std::memory_order_acquire)) {
+        m_pending_prefetches.wait(pending, std::memory_order_acquire);
+    }
+
+    const u64 hits = this->GetHitCount();
+    const u64 misses = this->GetMissCount();
+    if (hits + misses != 0) {
+        LOG_DEBUG(Common_Filesystem,
+                  "Block cache of {:#x} bytes storage for {:016X}: {} hits, {} misses, {} blocks "
+                  "prefetched, {} used, {} evicted unused",
+                  m_size, m_program_id, hits, misses, this->GetPrefetchedCount(),
+                  this->GetPrefetchHitCount(), m_prefetch_evicted.load(std::memory_order_relaxed));
+    }
+}
+
+size_t BlockCacheStorage::Read(u8* buffer, size_t size, size_t offset) const {
+    if (offset >= m_size) {
+        return 0;
+    }
+    size = std::min(size, m_size - offset);
+
+    // Large reads are mostly streamed once, keep them from flushing the cache.
+    if (size >= BypassSize) {
+        return m_base_storage->Read(buffer, size, offset);
+    }
+
+    this->UpdateStreams(offset, size);
+
+    const size_t end_offset = offset + size;
+    size_t cur_offset = offset;
+    std::vector<u8> run_buffer;
+    while (cur_offset < end_offset) {
+        const u64 block_index = cur_offset / BlockSize;
+        const size_t offset_in_block = cur_offset % BlockSize;
+        const size_t cur_size = std::min(BlockSize - offset_in_block, end_offset - cur_offset);
+        if (this->ReadCachedBlock(block_index, buffer + (cur_offset - offset), offset_in_block,
+                                  cur_size)) {
+            m_hits.fetch_add(1, std::memory_order_relaxed);
+            cur_offset += cur_size;
+            continue;
+        }
+
+        // Read the run of blocks missing from the cache with a single base storage read.
+        u64 last_block_index = block_index;
+        while ((last_block_index + 1) * BlockSize < end_offset &&
+               !this->IsBlockCached(last_block_index + 1)) {
+            ++last_block_index;
+        }
+        const size_t run_offset = block_index * BlockSize;
+        const size_t run_end = std::min<size_t>((last_block_index + 1) * BlockSize, m_size);
+        run_buffer.resize(run_end - run_offset);
+        const size_t read_size =
+            m_base_storage->Read(run_buffer.data(), run_buffer.size(), run_offset);
+        m_misses.fetch_add(last_block_index - block_index + 1, std::memory_order_relaxed);
+
+        // Only cache complete reads, copy whatever was read otherwise.
+        const size_t skip_size = cur_offset - run_offset;
+        const size_t copy_size = std::min(run_end, end_offset) - cur_offset;
+        if (read_size != run_buffer.size()) {
+            const size_t available =
+                read_size > skip_size ? std::min(read_size - skip_size, copy_size) : 0;
+            std::memcpy(buffer + (cur_offset - offset), run_buffer.data() + skip_size, available);
+            return cur_offset + available - offset;
+        }
+        for (size_t block_offset = 0; block_offset < run_buffer.size(); block_offset += BlockSize) {
+            this->InsertBlock(block_index + block_offset / BlockSize,
+                              run_buffer.data() + block_offset,
+                              std::min(BlockSize, run_buffer.size() - block_offset), false);
+        }
+        std::memcpy(buffer + (cur_offset - offset), run_buffer.data() + skip_size, copy_size);
+        cur_offset += copy_size;
+    }
+    return size;
+}
+
+size_t BlockCacheStorage::GetSize() const {
+    return m_size;
+}
+
+bool BlockCacheStorage::ReadCachedBlock(u64 block_index, u8* dest, size_t offset_in_block,
+                                        size_t size) const {
+    Shard& shard = this->GetShard(block_index);
+    std::scoped_lock lk{shard.mutex};
+    const auto it = shard.blocks.find(block_index);
+    if (it == shard.blocks.end()) {
+        return false;
+    }
+
+    // Move the block to the front of the list, it is now the most recently used.
+    shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+    CachedBlock& block = *it->second;
+    if (block.prefetched) {
+        block.prefetched = false;
+        m_prefetch_hits.fetch_add(1, std::memory_order_relaxed);
+    }
+    std::memcpy(dest, block.data.data() + offset_in_block, size);
+    return true;
+}
+
+bool BlockCacheStorage::IsBlockCached(u64 block_index) const {
+    Shard& shard = this->GetShard(block_index);
+    std::scoped_lock lk{shard.mutex};
+    return shard.blocks.contains(block_index);
+}
+
+bool BlockCacheStorage::InsertBlock(u64 block_index, const u8* data, size_t size,
+                                    bool prefetched) const {
+    Shard& shard = this->GetShard(block_index);
+    std::scoped_lock lk{shard.mutex};
+    if (shard.blocks.contains(block_index)) {
+        // Another thread read the same block concurrently.
+        return false;
+    }
+
+    // Reuse the least recently used block once the shard is full.
+    std::vector<u8> block_data;
+    if (shard.lru.size() >= m_max_blocks_per_shard) {
+        CachedBlock& evicted = shard.lru.back();
+        if (evicted.prefetched) {
+            m_prefetch_evicted.fetch_add(1, std::memory_order_relaxed);
+        }
+        shard.blocks.erase(evicted.index);
+        block_data = std::move(evicted.data);
+        shard.lru.pop_back();
+    }
+    block_data.assign(data, data + size);
+    shard.lru.emplace_front(CachedBlock{block_index, std::move(block_data), prefetched});
+    shard.blocks.emplace(block_index, shard.lru.begin());
+    return true;
+}
+
+void BlockCacheStorage::UpdateStreams(size_t offset, size_t size) const {
+    const size_t end_offset = offset + size;
+    size_t prefetch_offset = 0;
+    size_t prefetch_size = 0;
+    {
+        std::scoped_lock lk{m_stream_mutex};
+        const auto it = std::ranges::find(m_streams, offset, &Stream::next_offset);
+        // Unused streams have a next offset of zero, reads from the start always begin one.
+        if (it == m_streams.end() || offset == 0) {
+            // Start tracking a new stream, replacing the oldest one.
+            m_streams[m_next_stream] = Stream{end_offset, end_offset, 0};
+            m_next_stream = (m_next_stream + 1) % NumStreams;
+            return;
+        }
+
+        Stream& stream = *it;
+        stream.next_offset = end_offset;
+        stream.window =
+            stream.window == 0 ? InitialPrefetchSize : std::min(stream.window * 2, MaxPrefetchSize);
+
+        // Read ahead in halves of the window, so that the stream does not catch up with it.
+        const size_t start = std::max(stream.prefetch_end, end_offset);
+        const size_t target = std::min(end_offset + stream.window, m_size);
+        if (start >= target || target - start < stream.window / 2) {
+            return;
+        }
+        stream.prefetch_end = target;
+        prefetch_offset = start;
+        prefetch_size = target - start;
+    }
+
+    m_pending_prefetches.fetch_add(1, std::memory_order_relaxed);
+    GetPrefetchWorker().QueueWork(
+        [this, prefetch_offset, prefetch_size] {
+            this->Prefetch(prefetch_offset, prefetch_size);
+            m_pending_prefetches.fetch_sub(1, std::memory_order_release);
+            m_pending_prefetches.notify_all();
+        },
+        Common::WorkLane::Background);
+}
+
+void BlockCacheStorage::Prefetch(size_t offset, size_t size) const {
+    u64 first_block = offset / BlockSize;
+    u64 last_block = (offset + size - 1) / BlockSize;
+
+    // Skip the blocks that are already cached at both ends of the window.
+    while (first_block <= last_block && this->IsBlockCached(first_block)) {
+        ++first_block;
+    }
+    while (last_block > first_block && this->IsBlockCached(last_block)) {
+        --last_block;
+    }
+    if (first_block > last_block) {
+        return;
+    }
+
+    const size_t run_offset = first_block * BlockSize;
+    const size_t run_end = std::min<size_t>((last_block + 1) * BlockSize, m_size);
+    std::vector<u8> run_buffer(run_end - run_offset);
+    if (m_base_storage->Read(run_buffer.data(), run_buffer.size(), run_offset) !=
+        run_buffer.size()) {
+        return;
+    }
+    for (size_t block_offset = 0; block_offset < run_buffer.size(); block_offset += BlockSize) {
+        if (this->InsertBlock(first_block + block_offset / BlockSize,
+                              run_buffer.data() + block_offset,
+                              std::min(BlockSize, run_buffer.size() - block_offset), true)) {
+            m_prefetched.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+} // namespace FileSys
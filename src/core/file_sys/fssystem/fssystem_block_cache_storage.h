@@ -0,0 +1,109 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "core/file_sys/fssystem/fs_i_storage.h"
+
+namespace FileSys {
+
+/// Read-only storage keeping recently read blocks of its base storage in a bounded, sharded LRU
+/// cache. Placed above the decryption and verification layers, repeated reads of the same
+/// regions are served without decrypting and verifying them again. Sequential streams of reads
+/// are detected and the blocks following them are read into the cache ahead of time.
+class BlockCacheStorage : public IReadOnlyStorage {
+    YUZU_NON_COPYABLE(BlockCacheStorage);
+    YUZU_NON_MOVEABLE(BlockCacheStorage);
+
+public:
+    static constexpr size_t BlockSize = 0x4000;
+    static constexpr size_t NumShards = 8;
+
+    /// Reads at least this large are passed through to the base storage without being cached.
+    static constexpr size_t BypassSize = 0x100000;
+
+    /// The read ahead window of a stream starts at the initial size and doubles with every
+    /// sequential read, up to the maximum size.
+    static constexpr size_t InitialPrefetchSize = 4 * BlockSize;
+    static constexpr size_t MaxPrefetchSize = 0x100000;
+    static constexpr size_t NumStreams = 4;
+
+public:
+    BlockCacheStorage(VirtualFile base_storage, size_t cache_size, u64 program_id);
+    ~BlockCacheStorage() override;
+
+    size_t Read(u8* buffer, size_t size, size_t offset) const override;
+    size_t GetSize() const override;
+
+    u64 GetHitCount() const {
+        return m_hits.load(std::memory_order_relaxed);
+    }
+    u64 GetMissCount() const {
+        return m_misses.load(std::memory_order_relaxed);
+    }
+    u64 GetPrefetchedCount() const {
+        return m_prefetched.load(std::memory_order_relaxed);
+    }
+    u64 GetPrefetchHitCount() const {
+        return m_prefetch_hits.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct CachedBlock {
+        u64 index;
+        std::vector<u8> data;
+        // Set for blocks read ahead and not used since
+        bool prefetched;
+    };
+
+    struct Shard {
+        using BlockList = std::list<CachedBlock>;
+
+        std::mutex mutex;
+        BlockList lru;
+        std::unordered_map<u64, BlockList::iterator> blocks;
+    };
+
+    Shard& GetShard(u64 block_index) const {
+        return m_shards[block_index % NumShards];
+    }
+
+    struct Stream {
+        size_t next_offset;
+        size_t prefetch_end;
+        size_t window;
+    };
+
+    bool ReadCachedBlock(u64 block_index, u8* dest, size_t offset_in_block, size_t size) const;
+    bool IsBlockCached(u64 block_index) const;
+    bool InsertBlock(u64 block_index, const u8* data, size_t size, bool prefetched) const;
+
+    void UpdateStreams(size_t offset, size_t size) const;
+    void Prefetch(size_t offset, size_t size) const;
+
+private:
+    VirtualFile m_base_storage;
+    size_t m_size;
+    size_t m_max_blocks_per_shard;
+    u64 m_program_id;
+    mutable std::array<Shard, NumShards> m_shards;
+    mutable std::atomic<u64> m_hits{};
+    mutable std::atomic<u64> m_misses{};
+
+    mutable std::mutex m_stream_mutex;
+    mutable std::array<Stream, NumStreams> m_streams{};
+    mutable size_t m_next_stream{};
+    mutable std::atomic<u32> m_pending_prefetches{};
+    mutable std::atomic<u64> m_prefetched{};
+    mutable std::atomic<u64> m_prefetch_hits{};
+    mutable std::atomic<u64> m_prefetch_evicted{};
+};
+
+} // namespace FileSys
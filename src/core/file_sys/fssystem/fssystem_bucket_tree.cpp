@@ -1,10 +1,11 @@
 // SPDX-FileCopyrightText: Copyright 2023 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+
 #include "core/file_sys/errors.h"
 #include "core/file_sys/fssystem/fssystem_bucket_tree.h"
 #include "core/file_sys/fssystem/fssystem_bucket_tree_utils.h"
-#include "core/file_sys/fssystem/fssystem_pooled_buffer.h"
 
 namespace FileSys {
 
@@ -89,8 +90,6 @@ private:
 public:
     StorageNode(size_t size, s32 count)
         : m_start(NodeHeaderSize, static_cast<s32>(size)), m_count(count), m_index(-1) {}
-    StorageNode(s64 ofs, size_t size, s32 count)
-        : m_start(NodeHeaderSize + ofs, static_cast<s32>(size)), m_count(count), m_index(-1) {}
 
     s32 GetIndex() const {
         return m_index;
@@ -117,29 +116,6 @@ public:
 
         m_index = static_cast<s32>(pos - m_start) - 1;
     }
-
-    Result Find(VirtualFile storage, s64 virtual_address) {
-        s32 end = m_count;
-        auto pos = m_start;
-
-        while (end > 0) {
-            auto half = end / 2;
-            auto mid = pos + half;
-
-            s64 offset = 0;
-            storage->ReadObject(std::addressof(offset), mid.Get());
-
-            if (offset <= virtual_address) {
-                pos = mid + 1;
-                end -= half + 1;
-            } else {
-                end = half;
-            }
-        }
-
-        m_index = static_cast<s32>(pos - m_start) - 1;
-        R_SUCCEED();
-    }
 };
 
 } // namespace
@@ -172,6 +148,39 @@ Result BucketTree::NodeHeader::Verify(s32 node_index, size_t node_size, size_t e
     R_SUCCEED();
 }
 
+void BucketTree::NodeCache::Initialize(size_t node_size) {
+    m_node_size = node_size;
+    m_capacity = std::max<size_t>(NodeCacheSize / node_size, 1);
+    m_entries.reserve(m_capacity);
+}
+
+void BucketTree::NodeCache::Finalize() {
+    std::scoped_lock lk(m_mutex);
+    m_entries.clear();
+}
+
+BucketTree::NodeCache::NodeData BucketTree::NodeCache::Get(const VirtualFile& storage,
+                                                           s64 offset) {
+    std::scoped_lock lk(m_mutex);
+    ++m_use_count;
+
+    const auto it = std::ranges::find(m_entries, offset, &Entry::offset);
+    if (it != m_entries.end()) {
+        it->last_use = m_use_count;
+        return it->data;
+    }
+
+    // Read the node, replacing the least recently used one if we're full.
+    const auto data = std::make_shared<char[]>(m_node_size);
+    storage->Read(reinterpret_cast<u8*>(data.get()), m_node_size, static_cast<size_t>(offset));
+    if (m_entries.size() < m_capacity) {
+        m_entries.push_back({offset, m_use_count, data});
+    } else {
+        *std::ranges::min_element(m_entries, {}, &Entry::last_use) = {offset, m_use_count, data};
+    }
+    return data;
+}
+
 Result BucketTree::Initialize(VirtualFile node_storage, VirtualFile entry_storage, size_t node_size,
                               size_t entry_size, s32 entry_count) {
     // Validate preconditions.
@@ -222,6 +231,9 @@ Result BucketTree::Initialize(VirtualFile node_storage, VirtualFile entry_storag
     m_offset_count = offset_count;
     m_entry_set_count = entry_set_count;
 
+    m_offset_node_cache.Initialize(node_size);
+    m_entry_set_cache.Initialize(node_size);
+
     m_offset_cache.offsets.start_offset = start_offset;
     m_offset_cache.offsets.end_offset = end_offset;
     m_offset_cache.is_initialized = true;
@@ -247,6 +259,8 @@ void BucketTree::Finalize() {
     if (this->IsInitialized()) {
         m_node_storage = VirtualFile();
         m_entry_storage = VirtualFile();
+        m_offset_node_cache.Finalize();
+        m_entry_set_cache.Finalize();
         m_node_l1.Free(m_node_size);
         m_node_size = 0;
         m_entry_size = 0;
@@ -279,6 +293,10 @@ Result BucketTree::InvalidateCache() {
     // Reset our offsets.
     m_offset_cache.is_initialized = false;
 
+    // Drop our cached nodes.
+    m_offset_node_cache.Finalize();
+    m_entry_set_cache.Finalize();
+
     R_SUCCEED();
 }
 
@@ -349,7 +367,9 @@ Result BucketTree::Visitor::MoveNext() {
         const auto entry_set_size = m_tree->m_node_size;
         const auto entry_set_offset = entry_set_index * static_cast<s64>(entry_set_size);
 
-        m_tree->m_entry_storage->ReadObject(std::addressof(m_entry_set), entry_set_offset);
+        const auto entry_set_data =
+            m_tree->m_entry_set_cache.Get(m_tree->m_entry_storage, entry_set_offset);
+        std::memcpy(std::addressof(m_entry_set), entry_set_data.get(), sizeof(EntrySetHeader));
         R_TRY(m_entry_set.header.Verify(entry_set_index, entry_set_size, m_tree->m_entry_size));
 
         R_UNLESS(m_entry_set.info.start == end && m_entry_set.info.start < m_entry_set.info.end,
@@ -362,9 +382,10 @@ Result BucketTree::Visitor::MoveNext() {
 
     // Read the new entry.
     const auto entry_size = m_tree->m_entry_size;
-    const auto entry_offset = impl::GetBucketTreeEntryOffset(
-        m_entry_set.info.index, m_tree->m_node_size, entry_size, entry_index);
-    m_tree->m_entry_storage->Read(reinterpret_cast<u8*>(m_entry), entry_size, entry_offset);
+    const auto entry_set_data = m_tree->m_entry_set_cache.Get(
+        m_tree->m_entry_storage, m_entry_set.info.index * static_cast<s64>(m_tree->m_node_size));
+    const auto entry_offset = impl::GetBucketTreeEntryOffset(0, entry_size, entry_index);
+    std::memcpy(m_entry, entry_set_data.get() + entry_offset, entry_size);
 
     // Note that we changed index.
     m_entry_index = entry_index;
@@ -387,7 +408,9 @@ Result BucketTree::Visitor::MovePrevious() {
         const auto entry_set_index = m_entry_set.info.index - 1;
         const auto entry_set_offset = entry_set_index * static_cast<s64>(entry_set_size);
 
-        m_tree->m_entry_storage->ReadObject(std::addressof(m_entry_set), entry_set_offset);
+        const auto entry_set_data =
+            m_tree->m_entry_set_cache.Get(m_tree->m_entry_storage, entry_set_offset);
+        std::memcpy(std::addressof(m_entry_set), entry_set_data.get(), sizeof(EntrySetHeader));
         R_TRY(m_entry_set.header.Verify(entry_set_index, entry_set_size, m_tree->m_entry_size));
 
         R_UNLESS(m_entry_set.info.end == start && m_entry_set.info.start < m_entry_set.info.end,
@@ -402,9 +425,10 @@ Result BucketTree::Visitor::MovePrevious() {
 
     // Read the new entry.
     const auto entry_size = m_tree->m_entry_size;
-    const auto entry_offset = impl::GetBucketTreeEntryOffset(
-        m_entry_set.info.index, m_tree->m_node_size, entry_size, entry_index);
-    m_tree->m_entry_storage->Read(reinterpret_cast<u8*>(m_entry), entry_size, entry_offset);
+    const auto entry_set_data = m_tree->m_entry_set_cache.Get(
+        m_tree->m_entry_storage, m_entry_set.info.index * static_cast<s64>(m_tree->m_node_size));
+    const auto entry_offset = impl::GetBucketTreeEntryOffset(0, entry_size, entry_index);
+    std::memcpy(m_entry, entry_set_data.get() + entry_offset, entry_size);
 
     // Note that we changed index.
     m_entry_index = entry_index;
@@ -461,27 +485,13 @@ Result BucketTree::Visitor::Find(s64 virtual_address) {
 }
 
 Result BucketTree::Visitor::FindEntrySet(s32* out_index, s64 virtual_address, s32 node_index) {
-    const auto node_size = m_tree->m_node_size;
-
-    PooledBuffer pool(node_size, 1);
-    if (node_size <= pool.GetSize()) {
-        R_RETURN(
-            this->FindEntrySetWithBuffer(out_index, virtual_address, node_index, pool.GetBuffer()));
-    } else {
-        pool.Deallocate();
-        R_RETURN(this->FindEntrySetWithoutBuffer(out_index, virtual_address, node_index));
-    }
-}
-
-Result BucketTree::Visitor::FindEntrySetWithBuffer(s32* out_index, s64 virtual_address,
-                                                   s32 node_index, char* buffer) {
     // Calculate node extents.
     const auto node_size = m_tree->m_node_size;
     const auto node_offset = (node_index + 1) * static_cast<s64>(node_size);
-    VirtualFile storage = m_tree->m_node_storage;
 
-    // Read the node.
-    storage->Read(reinterpret_cast<u8*>(buffer), node_size, node_offset);
+    // Get the node.
+    const auto node_data = m_tree->m_offset_node_cache.Get(m_tree->m_node_storage, node_offset);
+    const char* const buffer = node_data.get();
 
     // Validate the header.
     NodeHeader header;
@@ -498,50 +508,16 @@ Result BucketTree::Visitor::FindEntrySetWithBuffer(s32* out_index, s64 virtual_a
     R_SUCCEED();
 }
 
-Result BucketTree::Visitor::FindEntrySetWithoutBuffer(s32* out_index, s64 virtual_address,
-                                                      s32 node_index) {
-    // Calculate node extents.
-    const auto node_size = m_tree->m_node_size;
-    const auto node_offset = (node_index + 1) * static_cast<s64>(node_size);
-    VirtualFile storage = m_tree->m_node_storage;
-
-    // Read and validate the header.
-    NodeHeader header;
-    storage->ReadObject(std::addressof(header), node_offset);
-    R_TRY(header.Verify(node_index, node_size, sizeof(s64)));
-
-    // Create the node, and find.
-    StorageNode node(node_offset, sizeof(s64), header.count);
-    R_TRY(node.Find(storage, virtual_address));
-    R_UNLESS(node.GetIndex() >= 0, ResultOutOfRange);
-
-    // Return the index.
-    *out_index = static_cast<s32>(m_tree->GetEntrySetIndex(header.index, node.GetIndex()));
-    R_SUCCEED();
-}
-
 Result BucketTree::Visitor::FindEntry(s64 virtual_address, s32 entry_set_index) {
-    const auto entry_set_size = m_tree->m_node_size;
-
-    PooledBuffer pool(entry_set_size, 1);
-    if (entry_set_size <= pool.GetSize()) {
-        R_RETURN(this->FindEntryWithBuffer(virtual_address, entry_set_index, pool.GetBuffer()));
-    } else {
-        pool.Deallocate();
-        R_RETURN(this->FindEntryWithoutBuffer(virtual_address, entry_set_index));
-    }
-}
-
-Result BucketTree::Visitor::FindEntryWithBuffer(s64 virtual_address, s32 entry_set_index,
-                                                char* buffer) {
     // Calculate entry set extents.
     const auto entry_size = m_tree->m_entry_size;
     const auto entry_set_size = m_tree->m_node_size;
     const auto entry_set_offset = entry_set_index * static_cast<s64>(entry_set_size);
-    VirtualFile storage = m_tree->m_entry_storage;
 
-    // Read the entry set.
-    storage->Read(reinterpret_cast<u8*>(buffer), entry_set_size, entry_set_offset);
+    // Get the entry set.
+    const auto entry_set_data =
+        m_tree->m_entry_set_cache.Get(m_tree->m_entry_storage, entry_set_offset);
+    const char* const buffer = entry_set_data.get();
 
     // Validate the entry_set.
     EntrySetHeader entry_set;
@@ -565,34 +541,4 @@ Result BucketTree::Visitor::FindEntryWithBuffer(s64 virtual_address, s32 entry_s
     R_SUCCEED();
 }
 
-Result BucketTree::Visitor::FindEntryWithoutBuffer(s64 virtual_address, s32 entry_set_index) {
-    // Calculate entry set extents.
-    const auto entry_size = m_tree->m_entry_size;
-    const auto entry_set_size = m_tree->m_node_size;
-    const auto entry_set_offset = entry_set_index * static_cast<s64>(entry_set_size);
-    VirtualFile storage = m_tree->m_entry_storage;
-
-    // Read and validate the entry_set.
-    EntrySetHeader entry_set;
-    storage->ReadObject(std::addressof(entry_set), entry_set_offset);
-    R_TRY(entry_set.header.Verify(entry_set_index, entry_set_size, entry_size));
-
-    // Create the node, and find.
-    StorageNode node(entry_set_offset, entry_size, entry_set.info.count);
-    R_TRY(node.Find(storage, virtual_address));
-    R_UNLESS(node.GetIndex() >= 0, ResultOutOfRange);
-
-    // Copy the data into entry.
-    const auto entry_index = node.GetIndex();
-    const auto entry_offset =
-        impl::GetBucketTreeEntryOffset(entry_set_offset, entry_size, entry_index);
-    storage->Read(reinterpret_cast<u8*>(m_entry), entry_size, entry_offset);
-
-    // Set our entry set/index.
-    m_entry_set = entry_set;
-    m_entry_index = entry_index;
-
-    R_SUCCEED();
-}
-
 } // namespace FileSys
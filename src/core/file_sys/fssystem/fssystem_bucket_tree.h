@@ -3,7 +3,9 @@
 
 #pragma once
 
+#include <memory>
 #include <mutex>
+#include <vector>
 
 #include "common/alignment.h"
 #include "common/common_funcs.h"
@@ -28,6 +30,8 @@ public:
     static constexpr size_t NodeSizeMin = 1_KiB;
     static constexpr size_t NodeSizeMax = 512_KiB;
 
+    static constexpr size_t NodeCacheSize = 256_KiB;
+
 public:
     class Visitor;
 
@@ -189,6 +193,37 @@ private:
         void* m_header;
     };
 
+    /// Keeps the most recently used nodes of a storage in memory. The storages are often
+    /// encrypted, and lookups keep reading the same few nodes.
+    class NodeCache {
+        YUZU_NON_COPYABLE(NodeCache);
+        YUZU_NON_MOVEABLE(NodeCache);
+
+    public:
+        using NodeData = std::shared_ptr<const char[]>;
+
+        NodeCache() = default;
+
+        void Initialize(size_t node_size);
+        void Finalize();
+
+        /// Returns the node at the offset of the storage, reading it on misses.
+        NodeData Get(const VirtualFile& storage, s64 offset);
+
+    private:
+        struct Entry {
+            s64 offset;
+            u64 last_use;
+            NodeData data;
+        };
+
+        std::mutex m_mutex;
+        std::vector<Entry> m_entries;
+        size_t m_node_size{};
+        size_t m_capacity{};
+        u64 m_use_count{};
+    };
+
 private:
     static constexpr s32 GetEntryCount(size_t node_size, size_t entry_size) {
         return static_cast<s32>((node_size - sizeof(NodeHeader)) / entry_size);
@@ -221,7 +256,8 @@ private:
 public:
     BucketTree()
         : m_node_storage(), m_entry_storage(), m_node_l1(), m_node_size(), m_entry_size(),
-          m_entry_count(), m_offset_count(), m_entry_set_count(), m_offset_cache() {}
+          m_entry_count(), m_offset_count(), m_entry_set_count(), m_offset_cache(),
+          m_offset_node_cache(), m_entry_set_cache() {}
     ~BucketTree() {
         this->Finalize();
     }
@@ -327,6 +363,8 @@ private:
     s32 m_offset_count;
     s32 m_entry_set_count;
     OffsetCache m_offset_cache;
+    mutable NodeCache m_offset_node_cache;
+    mutable NodeCache m_entry_set_cache;
 };
 
 class BucketTree::Visitor {
@@ -382,13 +420,7 @@ private:
     Result Find(s64 virtual_address);
 
     Result FindEntrySet(s32* out_index, s64 virtual_address, s32 node_index);
-    Result FindEntrySetWithBuffer(s32* out_index, s64 virtual_address, s32 node_index,
-                                  char* buffer);
-    Result FindEntrySetWithoutBuffer(s32* out_index, s64 virtual_address, s32 node_index);
-
     Result FindEntry(s64 virtual_address, s32 entry_set_index);
-    Result FindEntryWithBuffer(s64 virtual_address, s32 entry_set_index, char* buffer);
-    Result FindEntryWithoutBuffer(s64 virtual_address, s32 entry_set_index);
 
 private:
     friend class BucketTree;
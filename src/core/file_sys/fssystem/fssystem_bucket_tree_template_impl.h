@@ -6,7 +6,6 @@
 #include "core/file_sys/errors.h"
 #include "core/file_sys/fssystem/fssystem_bucket_tree.h"
 #include "core/file_sys/fssystem/fssystem_bucket_tree_utils.h"
-#include "core/file_sys/fssystem/fssystem_pooled_buffer.h"
 
 namespace FileSys {
 
@@ -34,21 +33,14 @@ Result BucketTree::ScanContinuousReading(ContinuousReadingInfo* out_info,
     auto cur_offset = param.offset;
     R_UNLESS(entry.GetVirtualOffset() <= cur_offset, ResultOutOfRange);
 
-    // Create a pooled buffer for our scan.
-    PooledBuffer pool(m_node_size, 1);
-    char* buffer = nullptr;
-
     s64 entry_storage_size = m_entry_storage->GetSize();
 
-    // Read the node.
-    if (m_node_size <= pool.GetSize()) {
-        buffer = pool.GetBuffer();
-        const auto ofs = param.entry_set.index * static_cast<s64>(m_node_size);
-        R_UNLESS(m_node_size + ofs <= static_cast<size_t>(entry_storage_size),
-                 ResultInvalidBucketTreeNodeEntryCount);
-
-        m_entry_storage->Read(reinterpret_cast<u8*>(buffer), m_node_size, ofs);
-    }
+    // Get the node.
+    const auto ofs = param.entry_set.index * static_cast<s64>(m_node_size);
+    R_UNLESS(m_node_size + ofs <= static_cast<size_t>(entry_storage_size),
+             ResultInvalidBucketTreeNodeEntryCount);
+    const auto entry_set_data = m_entry_set_cache.Get(m_entry_storage, ofs);
+    const char* const buffer = entry_set_data.get();
 
     // Calculate extents.
     const auto end_offset = cur_offset + static_cast<s64>(param.size);
@@ -76,14 +68,9 @@ Result BucketTree::ScanContinuousReading(ContinuousReadingInfo* out_info,
         s64 next_entry_offset;
 
         if (entry_index + 1 < entry_count) {
-            if (buffer != nullptr) {
-                const auto ofs = impl::GetBucketTreeEntryOffset(0, m_entry_size, entry_index + 1);
-                std::memcpy(std::addressof(next_entry), buffer + ofs, m_entry_size);
-            } else {
-                const auto ofs = impl::GetBucketTreeEntryOffset(param.entry_set.index, m_node_size,
-                                                                m_entry_size, entry_index + 1);
-                m_entry_storage->ReadObject(std::addressof(next_entry), ofs);
-            }
+            const auto entry_offset_in_set =
+                impl::GetBucketTreeEntryOffset(0, m_entry_size, entry_index + 1);
+            std::memcpy(std::addressof(next_entry), buffer + entry_offset_in_set, m_entry_size);
 
             next_entry_offset = next_entry.GetVirtualOffset();
             R_UNLESS(param.offsets.IsInclude(next_entry_offset), ResultInvalidIndirectEntryOffset);
@@ -3,7 +3,12 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <vector>
+
 #include "common/literals.h"
+#include "common/task_scheduler.h"
 
 #include "core/file_sys/errors.h"
 #include "core/file_sys/fssystem/fs_i_storage.h"
@@ -23,6 +28,11 @@ class CompressedStorage : public IReadOnlyStorage {
 public:
     static constexpr size_t NodeSize = 16_KiB;
 
+    /// Reads at least this large are split at compressed entry boundaries into chunks of at least
+    /// ParallelChunkSize bytes, which are decompressed in parallel.
+    static constexpr size_t ParallelReadSize = 512_KiB;
+    static constexpr size_t ParallelChunkSize = 128_KiB;
+
     struct Entry {
         s64 virt_offset;
         s64 phys_offset;
@@ -948,6 +958,9 @@ public:
     }
 
     virtual size_t Read(u8* buffer, size_t size, size_t offset) const override {
+        if (size >= ParallelReadSize) {
+            return this->ReadParallel(buffer, size, offset);
+        }
         if (R_SUCCEEDED(m_cache_manager.Read(m_core, offset, buffer, size))) {
             return size;
         } else {
@@ -955,6 +968,52 @@ public:
         }
     }
 
+private:
+    size_t ReadParallel(u8* buffer, size_t size, size_t offset) const {
+        // Find where the entries spanned by the read start. If there are more entries than we
+        // can list, the last chunk covers the remaining ones.
+        constexpr s32 EntriesCountMax = 0x80;
+        std::array<Entry, EntriesCountMax> entries;
+        s32 entry_count = 0;
+        if (R_FAILED(m_core.GetEntryList(entries.data(), std::addressof(entry_count),
+                                         EntriesCountMax, offset, size))) {
+            return 0;
+        }
+
+        // Split the read at entry boundaries, each entry is then decompressed exactly once.
+        const s64 end_offset = static_cast<s64>(offset + size);
+        std::vector<s64> chunk_offsets{static_cast<s64>(offset)};
+        for (s32 i = 0; i < entry_count; ++i) {
+            const s64 entry_offset = entries[i].virt_offset;
+            if (entry_offset - chunk_offsets.back() >= static_cast<s64>(ParallelChunkSize) &&
+                entry_offset < end_offset) {
+                chunk_offsets.push_back(entry_offset);
+            }
+        }
+        chunk_offsets.push_back(end_offset);
+
+        const size_t num_chunks = chunk_offsets.size() - 1;
+        std::vector<Result> results(num_chunks, ResultSuccess);
+        const auto read_chunk = [&](size_t index) {
+            const s64 chunk_offset = chunk_offsets[index];
+            results[index] = m_cache_manager.Read(
+                m_core, chunk_offset, buffer + (chunk_offset - static_cast<s64>(offset)),
+                static_cast<size_t>(chunk_offsets[index + 1] - chunk_offset));
+        };
+
+        // The calling thread reads the first chunk itself while the workers do the rest
+        Common::TaskGroup workers{Common::TaskPriority::High};
+        for (size_t index = 1; index < num_chunks; ++index) {
+            workers.Run([&read_chunk, index] { read_chunk(index); });
+        }
+        read_chunk(0);
+        workers.Wait();
+
+        const bool succeeded =
+            std::ranges::all_of(results, [](const Result& rc) { return R_SUCCEEDED(rc); });
+        return succeeded ? size : 0;
+    }
+
 private:
     mutable CompressedStorageCore m_core;
     mutable CacheManager m_cache_manager;
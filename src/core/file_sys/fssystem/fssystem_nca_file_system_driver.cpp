@@ -1,10 +1,13 @@
 // SPDX-FileCopyrightText: Copyright 2023 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include "common/literals.h"
+#include "common/settings.h"
 #include "core/file_sys/fssystem/fssystem_aes_ctr_counter_extended_storage.h"
 #include "core/file_sys/fssystem/fssystem_aes_ctr_storage.h"
 #include "core/file_sys/fssystem/fssystem_aes_xts_storage.h"
 #include "core/file_sys/fssystem/fssystem_alignment_matching_storage.h"
+#include "core/file_sys/fssystem/fssystem_block_cache_storage.h"
 #include "core/file_sys/fssystem/fssystem_compressed_storage.h"
 #include "core/file_sys/fssystem/fssystem_hierarchical_integrity_verification_storage.h"
 #include "core/file_sys/fssystem/fssystem_hierarchical_sha256_storage.h"
@@ -320,6 +323,16 @@ Result NcaFileSystemDriver::CreateStorageByRawStorage(VirtualFile* out,
             std::move(storage), header_reader->GetCompressionInfo()));
     }
 
+    // Cache the decrypted and verified blocks of romfs storages.
+    if (header_reader->GetFsType() == NcaFsHeader::FsType::RomFs) {
+        using namespace Common::Literals;
+        const size_t cache_size = Settings::values.romfs_cache_size.GetValue() * 1_MiB;
+        if (cache_size != 0) {
+            storage = std::make_shared<BlockCacheStorage>(std::move(storage), cache_size,
+                                                          m_reader->GetProgramId());
+        }
+    }
+
     // Set output storage.
     *out = std::move(storage);
     R_SUCCEED();
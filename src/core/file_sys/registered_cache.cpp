@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <algorithm>
+#include <mutex>
 #include <random>
 #include <regex>
 #include <mbedtls/sha256.h>
@@ -10,6 +11,7 @@
 #include "common/hex_util.h"
 #include "common/logging/log.h"
 #include "common/scope_exit.h"
+#include "common/swap.h"
 #include "core/crypto/key_manager.h"
 #include "core/file_sys/card_image.h"
 #include "core/file_sys/common_funcs.h"
@@ -18,6 +20,7 @@
 #include "core/file_sys/registered_cache.h"
 #include "core/file_sys/submission_package.h"
 #include "core/file_sys/vfs/vfs_concat.h"
+#include "core/file_sys/vfs/vfs_vector.h"
 #include "core/loader/loader.h"
 
 namespace FileSys {
@@ -25,6 +28,30 @@ namespace FileSys {
 // The size of blocks to use when vfs raw copying into nand.
 constexpr size_t VFS_RC_LARGE_COPY_BLOCK = 0x400000;
 
+// The name of the file caching the parsed NCAs of a registered cache, replaced as a whole whenever
+// it changes. Bump the version when the layout changes.
+constexpr std::string_view INDEX_FILE_NAME = "yuzu_index";
+constexpr u32 INDEX_MAGIC = Common::MakeMagic('Y', 'R', 'C', 'I');
+constexpr u32 INDEX_VERSION = 1;
+
+struct IndexFileHeader {
+    u32_le magic;
+    u32_le version;
+    u32_le num_entries;
+};
+static_assert(sizeof(IndexFileHeader) == 0xC, "IndexFileHeader has incorrect size.");
+
+// Followed by cnmt_size bytes of raw CNMT
+struct IndexFileEntry {
+    NcaID nca_id;
+    u64_le size;
+    u64_le title_id;
+    u32_le cnmt_size;
+    u8 is_meta;
+    INSERT_PADDING_BYTES(3);
+};
+static_assert(sizeof(IndexFileEntry) == 0x28, "IndexFileEntry has incorrect size.");
+
 std::string ContentProviderEntry::DebugInfo() const {
     return fmt::format("title_id={:016X}, content_type={:02X}", title_id, static_cast<u8>(type));
 }
@@ -413,27 +440,134 @@ std::vector<NcaID> RegisteredCache::AccumulateFiles() const {
 }
 
 void RegisteredCache::ProcessFiles(const std::vector<NcaID>& ids) {
+    // Held while parsing, so that another system refreshing the same directory finds the entries
+    // instead of parsing the NCAs again
+    std::scoped_lock lock{index->mutex};
+    auto& entries = index->entries;
+
+    std::map<NcaID, IndexEntry> new_index;
+    bool index_changed = false;
     for (const auto& id : ids) {
         const auto file = GetFileAtID(id);
 
         if (file == nullptr)
             continue;
-        const auto nca = std::make_shared<NCA>(parser(file, id));
-        if (nca->GetStatus() != Loader::ResultStatus::Success ||
-            nca->GetType() != NCAContentType::Meta || nca->GetSubdirectories().empty()) {
-            continue;
+
+        const auto size = file->GetSize();
+        auto iter = entries.find(id);
+        if (iter == entries.end() || iter->second.size != size) {
+            // Only successfully parsed NCAs are indexed, so that the others are retried once the
+            // keys needed to parse them are available.
+            const auto nca = std::make_shared<NCA>(parser(file, id));
+            if (nca->GetStatus() != Loader::ResultStatus::Success) {
+                continue;
+            }
+
+            IndexEntry entry{size, false, nca->GetTitleId(), {}};
+            if (nca->GetType() == NCAContentType::Meta && !nca->GetSubdirectories().empty()) {
+                for (const auto& section0_file : nca->GetSubdirectories()[0]->GetFiles()) {
+                    if (section0_file->GetExtension() == "cnmt") {
+                        entry.is_meta = true;
+                        entry.cnmt = section0_file->ReadAllBytes();
+                        break;
+                    }
+                }
+            }
+            iter = entries.insert_or_assign(id, std::move(entry)).first;
+            index_changed = true;
+        }
+
+        const auto& entry = iter->second;
+        if (entry.is_meta) {
+            meta.insert_or_assign(entry.title_id,
+                                  CNMT(std::make_shared<VectorVfsFile>(entry.cnmt)));
+            meta_id.insert_or_assign(entry.title_id, id);
         }
+        new_index.insert_or_assign(id, entry);
+    }
 
-        const auto section0 = nca->GetSubdirectories()[0];
+    // Drop the entries of NCAs that have been removed
+    index_changed |= new_index.size() != entries.size();
+    entries = std::move(new_index);
+    if (index_changed) {
+        SaveIndex();
+    }
+}
 
-        for (const auto& section0_file : section0->GetFiles()) {
-            if (section0_file->GetExtension() != "cnmt")
-                continue;
+void RegisteredCache::LoadIndex() {
+    const auto file = dir->GetFile(INDEX_FILE_NAME);
+    if (file == nullptr) {
+        return;
+    }
+
+    IndexFileHeader header{};
+    if (file->ReadObject(&header) != sizeof(IndexFileHeader) || header.magic != INDEX_MAGIC ||
+        header.version != INDEX_VERSION) {
+        LOG_WARNING(Loader, "Ignoring invalid content index in {}", dir->GetName());
+        return;
+    }
+
+    std::size_t offset = sizeof(IndexFileHeader);
+    for (u32 i = 0; i < header.num_entries; ++i) {
+        IndexFileEntry raw{};
+        if (file->ReadObject(&raw, offset) != sizeof(IndexFileEntry)) {
+            break;
+        }
+        offset += sizeof(IndexFileEntry);
 
-            meta.insert_or_assign(nca->GetTitleId(), CNMT(section0_file));
-            meta_id.insert_or_assign(nca->GetTitleId(), id);
+        IndexEntry entry{raw.size, raw.is_meta != 0, raw.title_id,
+                         file->ReadBytes(raw.cnmt_size, offset)};
+        if (entry.cnmt.size() != raw.cnmt_size) {
             break;
         }
+        offset += raw.cnmt_size;
+        index->entries.insert_or_assign(raw.nca_id, std::move(entry));
+    }
+}
+
+void RegisteredCache::SaveIndex() const {
+    std::vector<u8> buffer(sizeof(IndexFileHeader));
+    const IndexFileHeader header{INDEX_MAGIC, INDEX_VERSION,
+                                 static_cast<u32>(index->entries.size())};
+    std::memcpy(buffer.data(), &header, sizeof(IndexFileHeader));
+
+    for (const auto& [id, entry] : index->entries) {
+        IndexFileEntry raw{};
+        raw.nca_id = id;
+        raw.size = entry.size;
+        raw.title_id = entry.title_id;
+        raw.cnmt_size = static_cast<u32>(entry.cnmt.size());
+        raw.is_meta = entry.is_meta ? 1 : 0;
+
+        const auto offset = buffer.size();
+        buffer.resize(offset + sizeof(IndexFileEntry) + entry.cnmt.size());
+        std::memcpy(buffer.data() + offset, &raw, sizeof(IndexFileEntry));
+        std::memcpy(buffer.data() + offset + sizeof(IndexFileEntry), entry.cnmt.data(),
+                    entry.cnmt.size());
+    }
+
+    // The index is only a cache, so read-only directories simply go without one
+    auto file = dir->GetFile(INDEX_FILE_NAME);
+    if (file == nullptr) {
+        file = dir->CreateFile(INDEX_FILE_NAME);
+    }
+    if (file == nullptr || !file->Resize(buffer.size()) ||
+        file->WriteBytes(buffer) != buffer.size()) {
+        LOG_WARNING(Loader, "Failed to write content index in {}", dir->GetName());
+    }
+}
+
+void RegisteredCache::AcquireIndex() {
+    static std::mutex registry_mutex;
+    static std::map<std::string, std::weak_ptr<Index>> registry;
+
+    std::scoped_lock lock{registry_mutex};
+    auto& shared_index = registry[dir->GetFullPath()];
+    index = shared_index.lock();
+    if (index == nullptr) {
+        index = std::make_shared<Index>();
+        shared_index = index;
+        LoadIndex();
     }
 }
 
@@ -465,6 +599,11 @@ void RegisteredCache::Refresh() {
 
 RegisteredCache::RegisteredCache(VirtualDir dir_, ContentProviderParsingFunction parsing_function)
     : dir(std::move(dir_)), parser(std::move(parsing_function)) {
+    if (dir != nullptr) {
+        AcquireIndex();
+    } else {
+        index = std::make_shared<Index>();
+    }
     Refresh();
 }
 
@@ -5,7 +5,9 @@
 
 #include <array>
 #include <functional>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 #include <boost/container/flat_map.hpp>
@@ -184,6 +186,9 @@ private:
                             std::function<bool(const CNMT&, const ContentRecord&)> filter) const;
     std::vector<NcaID> AccumulateFiles() const;
     void ProcessFiles(const std::vector<NcaID>& ids);
+    void LoadIndex();
+    void SaveIndex() const;
+    void AcquireIndex();
     void AccumulateYuzuMeta();
     std::optional<NcaID> GetNcaIDFromMetadata(u64 title_id, ContentRecordType type) const;
     VirtualFile GetFileAtID(NcaID id) const;
@@ -192,9 +197,27 @@ private:
                                 bool overwrite_if_exists, std::optional<NcaID> override_id = {});
     bool RawInstallYuzuMeta(const CNMT& cnmt);
 
+    // What parsing an NCA found out, cached across runs in the index file. NcaIDs are derived
+    // from the hash of the content, so an entry stays valid for as long as the size matches.
+    struct IndexEntry {
+        u64 size;
+        bool is_meta;
+        u64 title_id;
+        // Raw CNMT of meta NCAs
+        std::vector<u8> cnmt;
+    };
+
+    // The index of a directory, shared by every cache of the process opened on it
+    struct Index {
+        std::mutex mutex;
+        // maps NcaID -> parsed NCA info, for every NCA that could be parsed
+        std::map<NcaID, IndexEntry> entries;
+    };
+
     VirtualDir dir;
     ContentProviderParsingFunction parser;
 
+    std::shared_ptr<Index> index;
     // maps tid -> NcaID of meta
     std::map<u64, NcaID> meta_id;
     // maps tid -> meta
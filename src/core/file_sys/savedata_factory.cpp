@@ -9,6 +9,7 @@
 #include "core/core.h"
 #include "core/file_sys/savedata_factory.h"
 #include "core/file_sys/vfs/vfs.h"
+#include "core/file_sys/vfs/vfs_write_back.h"
 
 namespace FileSys {
 
@@ -67,7 +68,7 @@ VirtualDir SaveDataFactory::Create(SaveDataSpaceId space, const SaveDataAttribut
     const auto save_directory = GetFullPath(program_id, dir, space, meta.type, meta.program_id,
                                             meta.user_id, meta.system_save_data_id);
 
-    return dir->CreateDirectoryRelative(save_directory);
+    return GetWriteBackDirectory(save_directory, dir->CreateDirectoryRelative(save_directory));
 }
 
 VirtualDir SaveDataFactory::Open(SaveDataSpaceId space, const SaveDataAttribute& meta) const {
@@ -81,6 +82,24 @@ VirtualDir SaveDataFactory::Open(SaveDataSpaceId space, const SaveDataAttribute&
         return Create(space, meta);
     }
 
+    return GetWriteBackDirectory(save_directory, std::move(out));
+}
+
+VirtualDir SaveDataFactory::GetWriteBackDirectory(const std::string& path,
+                                                  VirtualDir save_directory) const {
+    if (save_directory == nullptr) {
+        return nullptr;
+    }
+    std::scoped_lock lk{write_back_mutex};
+    std::erase_if(write_back_dirs, [](const auto& pair) { return pair.second.expired(); });
+
+    // Mounting the same save data twice must not create two independent write-back buffers
+    auto& write_back_dir = write_back_dirs[path];
+    if (auto out = write_back_dir.lock()) {
+        return out;
+    }
+    auto out = std::make_shared<WriteBackVfsDirectory>(std::move(save_directory));
+    write_back_dir = out;
     return out;
 }
 
@@ -3,7 +3,9 @@
 
 #pragma once
 
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include "common/common_funcs.h"
 #include "common/common_types.h"
@@ -47,10 +49,16 @@ public:
     void SetAutoCreate(bool state);
 
 private:
+    /// Returns the write-back layer of a save directory, shared by all of its mounts
+    VirtualDir GetWriteBackDirectory(const std::string& path, VirtualDir save_directory) const;
+
     Core::System& system;
     ProgramId program_id;
     VirtualDir dir;
     bool auto_create{true};
+
+    mutable std::mutex write_back_mutex;
+    mutable std::map<std::string, std::weak_ptr<VfsDirectory>> write_back_dirs;
 };
 
 } // namespace FileSys
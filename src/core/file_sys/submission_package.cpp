@@ -251,22 +251,24 @@ void NSP::ReadNCAs(const std::vector<VirtualFile>& files) {
                     continue;
                 }
 
+                // Only the header is parsed here, the sections are opened once they're used.
                 auto next_nca = std::make_shared<NCA>(std::move(next_file));
+                const auto next_status = next_nca->GetHeaderStatus();
 
                 if (next_nca->GetType() == NCAContentType::Program) {
-                    program_status[next_nca->GetTitleId()] = next_nca->GetStatus();
+                    program_status[next_nca->GetTitleId()] = next_status;
                     program_ids.insert(next_nca->GetTitleId() & 0xFFFFFFFFFFFFF000);
                 }
 
-                if (next_nca->GetStatus() != Loader::ResultStatus::Success &&
-                    next_nca->GetStatus() != Loader::ResultStatus::ErrorMissingBKTRBaseRomFS) {
+                if (next_status != Loader::ResultStatus::Success &&
+                    next_status != Loader::ResultStatus::ErrorMissingBKTRBaseRomFS) {
                     continue;
                 }
 
                 // If the last 3 hexadecimal digits of the CNMT TitleID is 0x800 or is missing the
                 // BKTRBaseRomFS, this is an update NCA. Otherwise, this is a base NCA.
                 if ((cnmt.GetTitleID() & 0x800) != 0 ||
-                    next_nca->GetStatus() == Loader::ResultStatus::ErrorMissingBKTRBaseRomFS) {
+                    next_status == Loader::ResultStatus::ErrorMissingBKTRBaseRomFS) {
                     // If the last 3 hexadecimal digits of the NCA's TitleID is between 0x1 and
                     // 0x7FF, this is a multi-program update NCA. Otherwise, this is a regular
                     // update NCA.
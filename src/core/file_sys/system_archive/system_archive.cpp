@@ -1,6 +1,10 @@
 // SPDX-FileCopyrightText: Copyright 2018 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <array>
+#include <memory>
+#include <mutex>
+
 #include "common/logging/log.h"
 #include "core/file_sys/romfs.h"
 #include "core/file_sys/system_archive/mii_model.h"
@@ -71,7 +75,18 @@ VirtualFile SynthesizeSystemArchive(const u64 title_id) {
         return nullptr;
     }
 
-    const auto& desc = SYSTEM_ARCHIVES[title_id - SYSTEM_ARCHIVE_BASE_TITLE_ID];
+    // Synthesized archives are never written to, every system of the process reuses the ones
+    // still alive instead of building them again
+    static std::mutex cache_mutex;
+    static std::array<std::weak_ptr<VfsFile>, SYSTEM_ARCHIVE_COUNT> cache;
+
+    const size_t index = title_id - SYSTEM_ARCHIVE_BASE_TITLE_ID;
+    std::scoped_lock lock{cache_mutex};
+    if (auto cached = cache[index].lock()) {
+        return cached;
+    }
+
+    const auto& desc = SYSTEM_ARCHIVES[index];
 
     LOG_INFO(Service_FS, "Synthesizing system archive '{}' (0x{:016X}).", desc.name, desc.title_id);
 
@@ -92,6 +107,7 @@ VirtualFile SynthesizeSystemArchive(const u64 title_id) {
     }
 
     LOG_INFO(Service_FS, "    - System archive generation successful!");
+    cache[index] = romfs;
     return romfs;
 }
 } // namespace FileSys::SystemArchive
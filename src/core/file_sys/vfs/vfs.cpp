@@ -2,9 +2,14 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <mutex>
 #include <numeric>
 #include <string>
+#include "common/div_ceil.h"
 #include "common/fs/path_util.h"
+#include "common/polyfill_thread.h"
 #include "core/file_sys/vfs/vfs.h"
 
 namespace FileSys {
@@ -191,6 +196,10 @@ std::size_t VfsFile::WriteBytes(const std::vector<u8>& data, std::size_t offset)
     return Write(data.data(), data.size(), offset);
 }
 
+bool VfsFile::Commit() {
+    return true;
+}
+
 std::string VfsFile::GetFullPath() const {
     if (GetContainingDirectory() == nullptr)
         return '/' + GetName();
@@ -523,6 +532,96 @@ bool VfsRawCopy(const VirtualFile& src, const VirtualFile& dest, std::size_t blo
     return true;
 }
 
+bool VfsPipelinedCopy(const VirtualFile& src, const VirtualFile& dest, std::size_t block_size,
+                      const VfsCopyBlockCallback& on_block) {
+    if (src == nullptr || dest == nullptr || !src->IsReadable() || !dest->IsWritable())
+        return false;
+    const auto size = src->GetSize();
+    if (!dest->Resize(size))
+        return false;
+
+    // The reader can run up to NumBuffers - 1 blocks ahead of the block being written
+    constexpr std::size_t NumBuffers = 3;
+    const std::size_t num_blocks = Common::DivCeil(size, block_size);
+    std::array<std::vector<u8>, NumBuffers> buffers;
+    for (auto& buffer : buffers) {
+        buffer.resize(std::min(block_size, size));
+    }
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::size_t num_read = 0;
+    std::size_t num_written = 0;
+    bool read_failed = false;
+    bool cancelled = false;
+
+    std::jthread reader([&] {
+        for (std::size_t block = 0; block < num_blocks; ++block) {
+            {
+                std::unique_lock lock{mutex};
+                cv.wait(lock, [&] { return cancelled || block - num_written < NumBuffers; });
+                if (cancelled) {
+                    return;
+                }
+            }
+            const std::size_t offset = block * block_size;
+            const std::size_t length = std::min(block_size, size - offset);
+            const bool success =
+                src->Read(buffers[block % NumBuffers].data(), length, offset) == length;
+            {
+                std::scoped_lock lock{mutex};
+                if (success) {
+                    ++num_read;
+                } else {
+                    read_failed = true;
+                }
+            }
+            cv.notify_all();
+            if (!success) {
+                return;
+            }
+        }
+    });
+
+    bool success = true;
+    for (std::size_t block = 0; block < num_blocks; ++block) {
+        {
+            std::unique_lock lock{mutex};
+            cv.wait(lock, [&] { return read_failed || block < num_read; });
+            if (block >= num_read) {
+                success = false;
+                break;
+            }
+        }
+        const std::size_t offset = block * block_size;
+        const std::span<const u8> data{buffers[block % NumBuffers].data(),
+                                       std::min(block_size, size - offset)};
+        if (on_block && !on_block(data, offset)) {
+            success = false;
+            break;
+        }
+        if (dest->Write(data.data(), data.size(), offset) != data.size()) {
+            success = false;
+            break;
+        }
+        {
+            std::scoped_lock lock{mutex};
+            ++num_written;
+        }
+        cv.notify_all();
+    }
+
+    if (!success) {
+        {
+            std::scoped_lock lock{mutex};
+            cancelled = true;
+        }
+        cv.notify_all();
+    }
+    reader.join();
+    return success;
+}
+
 bool VfsRawCopyD(const VirtualDir& src, const VirtualDir& dest, std::size_t block_size) {
     if (src == nullptr || dest == nullptr || !src->IsReadable() || !dest->IsWritable())
         return false;
@@ -7,6 +7,7 @@
 #include <map>
 #include <memory>
 #include <optional>
+#include <span>
 #include <string>
 #include <type_traits>
 #include <vector>
@@ -177,6 +178,10 @@ public:
     // Renames the file to name. Returns whether or not the operation was successful.
     virtual bool Rename(std::string_view name) = 0;
 
+    // Forces the written data out to the underlying storage. Returns whether or not the operation
+    // was successful.
+    virtual bool Commit();
+
     // Returns the full path of this file as a string, recursively
     virtual std::string GetFullPath() const;
 };
@@ -314,6 +319,16 @@ bool DeepEquals(const VirtualFile& file1, const VirtualFile& file2,
 // directory of src/dest.
 bool VfsRawCopy(const VirtualFile& src, const VirtualFile& dest, std::size_t block_size = 0x1000);
 
+// Called by VfsPipelinedCopy on the calling thread for every block, in order and before the block
+// is written. Returning false cancels the copy.
+using VfsCopyBlockCallback = std::function<bool(std::span<const u8> block, std::size_t offset)>;
+
+// Performs the same copy as VfsRawCopy, but reads the next blocks on a worker thread while the
+// current one is written, so that reading the source overlaps with writing the destination. This
+// is meant for large copies between different devices, like installing content to the NAND.
+bool VfsPipelinedCopy(const VirtualFile& src, const VirtualFile& dest, std::size_t block_size,
+                      const VfsCopyBlockCallback& on_block = {});
+
 // A method that performs a similar function to VfsRawCopy above, but instead copies entire
 // directories. It suffers the same performance penalties as above and an implementation-specific
 // Copy should always be preferred.
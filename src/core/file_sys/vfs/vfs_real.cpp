@@ -8,7 +8,9 @@
 #include "common/assert.h"
 #include "common/fs/file.h"
 #include "common/fs/fs.h"
+#include "common/fs/mapped_file.h"
 #include "common/fs/path_util.h"
+#include "common/literals.h"
 #include "common/logging/log.h"
 #include "core/file_sys/vfs/vfs.h"
 #include "core/file_sys/vfs/vfs_real.h"
@@ -30,8 +32,14 @@ namespace FS = Common::FS;
 
 namespace {
 
+using namespace Common::Literals;
+
 constexpr size_t MaxOpenFiles = 512;
 
+// Game images and other large read-only files are read through a memory mapping. Smaller files
+// such as save data are more likely to be rewritten while open, so they keep using IOFile.
+constexpr u64 MinMappedFileSize = 32_MiB;
+
 constexpr FS::FileAccessMode ModeFlagsToFileAccessMode(OpenMode mode) {
     switch (mode) {
     case OpenMode::Read:
@@ -312,7 +320,32 @@ bool RealVfsFile::IsReadable() const {
     return True(perms & OpenMode::Read);
 }
 
+const FS::MappedFile* RealVfsFile::GetMapping() const {
+    if (perms != OpenMode::Read) {
+        return nullptr;
+    }
+    std::call_once(mapping_flag, [this] {
+#ifdef ANDROID
+        if (path[0] != '/') {
+            return;
+        }
+#endif
+        const u64 file_size = size ? *size : FS::GetSize(path);
+        if (file_size < MinMappedFileSize) {
+            return;
+        }
+        auto mapped_file = std::make_unique<FS::MappedFile>(FS::ToU8String(path));
+        if (mapped_file->IsOpen()) {
+            mapping = std::move(mapped_file);
+        }
+    });
+    return mapping.get();
+}
+
 std::size_t RealVfsFile::Read(u8* data, std::size_t length, std::size_t offset) const {
+    if (const FS::MappedFile* const mapped_file = this->GetMapping()) {
+        return mapped_file->Read(data, length, offset);
+    }
     auto lk = base.RefreshReference(path, perms, *reference);
     if (!reference->file || !reference->file->Seek(static_cast<s64>(offset))) {
         return 0;
@@ -333,6 +366,18 @@ bool RealVfsFile::Rename(std::string_view name) {
     return base.MoveFile(path, parent_path + '/' + std::string(name)) != nullptr;
 }
 
+bool RealVfsFile::Commit() {
+    {
+        auto lk = base.RefreshReference(path, perms, *reference);
+        if (!reference->file || !reference->file->Flush()) {
+            return false;
+        }
+    }
+    // Sync through another handle, the filesystem lock must not be held while the disk catches up
+    const FS::IOFile file{path, FS::FileAccessMode::Append, FS::FileType::BinaryFile};
+    return file.IsOpen() && file.Commit();
+}
+
 // TODO(DarkLordZach): MSVC would not let me combine the following two functions using 'if
 // constexpr' because there is a compile error in the branch not used.
 
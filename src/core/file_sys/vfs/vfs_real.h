@@ -13,7 +13,8 @@
 
 namespace Common::FS {
 class IOFile;
-}
+class MappedFile;
+} // namespace Common::FS
 
 namespace FileSys {
 
@@ -87,14 +88,20 @@ public:
     std::size_t Read(u8* data, std::size_t length, std::size_t offset) const override;
     std::size_t Write(const u8* data, std::size_t length, std::size_t offset) override;
     bool Rename(std::string_view name) override;
+    bool Commit() override;
 
 private:
     RealVfsFile(RealVfsFilesystem& base, std::unique_ptr<FileReference> reference,
                 const std::string& path, OpenMode perms = OpenMode::Read,
                 std::optional<u64> size = {});
 
+    /// Maps large read-only files on the first read, returns null if the file is not mapped.
+    const Common::FS::MappedFile* GetMapping() const;
+
     RealVfsFilesystem& base;
     std::unique_ptr<FileReference> reference;
+    mutable std::once_flag mapping_flag;
+    mutable std::unique_ptr<Common::FS::MappedFile> mapping;
     std::string path;
     std::string parent_path;
     std::vector<std::string> path_components;
@@ -0,0 +1,348 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <mutex>
+
+#include "common/literals.h"
+#include "common/logging/log.h"
+#include "common/thread_worker.h"
+#include "core/file_sys/vfs/vfs_write_back.h"
+
+namespace FileSys {
+
+namespace {
+
+using namespace Common::Literals;
+
+// Files larger than this are written directly instead of being buffered in memory
+constexpr std::size_t MAX_BUFFERED_SIZE = 64_MiB;
+
+Common::ThreadWorker& GetWriteBackWorker() {
+    static Common::ThreadWorker worker(1, "SaveDataWriter");
+    return worker;
+}
+
+} // namespace
+
+class WriteBackState {
+public:
+    struct Entry {
+        VirtualFile base;
+        std::vector<u8> data;
+        // Whether data has changed since the last commit
+        bool dirty{};
+        // Number of queued write backs, the entry is kept until they have finished
+        u32 num_pending{};
+    };
+
+    ~WriteBackState() {
+        // Unmounting doesn't discard uncommitted writes
+        Commit();
+        GetWriteBackWorker().WaitForRequests();
+    }
+
+    void Commit() {
+        std::scoped_lock lk{mutex};
+        for (auto& [path, entry] : entries) {
+            if (!entry->dirty) {
+                continue;
+            }
+            entry->dirty = false;
+            ++entry->num_pending;
+            GetWriteBackWorker().QueueWork(
+                [this, path, entry, data = entry->data] { WriteBack(path, entry, data); });
+        }
+    }
+
+    // Commits and waits for all files to be written back
+    void Flush() {
+        Commit();
+        GetWriteBackWorker().WaitForRequests();
+    }
+
+    // Drops the buffered contents of a path and of everything under it, used when they are about
+    // to be deleted or truncated
+    void Discard(std::string_view prefix) {
+        GetWriteBackWorker().WaitForRequests();
+
+        std::scoped_lock lk{mutex};
+        std::erase_if(entries, [prefix](const auto& pair) {
+            const std::string& path = pair.first;
+            return path.starts_with(prefix) &&
+                   (path.size() == prefix.size() || path[prefix.size()] == '/');
+        });
+    }
+
+    // Returns the buffered contents of a file, loading them if needed. Returns nullptr for files
+    // too large to be buffered. Must be called with the mutex held.
+    Entry* Load(const std::string& path, const VirtualFile& base) {
+        if (const auto it = entries.find(path); it != entries.end()) {
+            return it->second.get();
+        }
+        if (base->GetSize() > MAX_BUFFERED_SIZE) {
+            return nullptr;
+        }
+        auto entry = std::make_shared<Entry>();
+        entry->base = base;
+        entry->data = base->ReadAllBytes();
+        return entries.emplace(path, std::move(entry)).first->second.get();
+    }
+
+    // Returns the buffered contents of a file, if any. Must be called with the mutex held.
+    const Entry* Find(const std::string& path) const {
+        const auto it = entries.find(path);
+        return it != entries.end() ? it->second.get() : nullptr;
+    }
+
+    mutable std::mutex mutex;
+
+private:
+    void WriteBack(const std::string& path, const std::shared_ptr<Entry>& entry,
+                   const std::vector<u8>& data) {
+        const VirtualFile& base = entry->base;
+        if (base->GetSize() != data.size() && !base->Resize(data.size())) {
+            LOG_ERROR(Service_FS, "Failed to resize {} to {} bytes", path, data.size());
+        }
+        if (base->Write(data.data(), data.size()) != data.size()) {
+            LOG_ERROR(Service_FS, "Failed to write back {}", path);
+        }
+        if (!base->Commit()) {
+            LOG_WARNING(Service_FS, "Failed to sync {} to disk", path);
+        }
+
+        std::scoped_lock lk{mutex};
+        --entry->num_pending;
+
+        // Release the memory unless the file has been written again in the meantime
+        const auto it = entries.find(path);
+        if (!entry->dirty && entry->num_pending == 0 && it != entries.end() &&
+            it->second == entry) {
+            entries.erase(it);
+        }
+    }
+
+    std::map<std::string, std::shared_ptr<Entry>, std::less<>> entries;
+};
+
+WriteBackVfsDirectory::WriteBackVfsDirectory(VirtualDir base_)
+    : WriteBackVfsDirectory(std::move(base_), std::make_shared<WriteBackState>()) {}
+
+WriteBackVfsDirectory::WriteBackVfsDirectory(VirtualDir base_,
+                                             std::shared_ptr<WriteBackState> state_)
+    : base(std::move(base_)), state(std::move(state_)) {}
+
+WriteBackVfsDirectory::~WriteBackVfsDirectory() = default;
+
+void WriteBackVfsDirectory::Commit() {
+    state->Commit();
+}
+
+std::vector<VirtualFile> WriteBackVfsDirectory::GetFiles() const {
+    std::vector<VirtualFile> out;
+    for (auto& file : base->GetFiles()) {
+        out.push_back(std::make_shared<WriteBackVfsFile>(std::move(file), state));
+    }
+    return out;
+}
+
+VirtualFile WriteBackVfsDirectory::GetFile(std::string_view name) const {
+    auto file = base->GetFile(name);
+    if (file == nullptr) {
+        return nullptr;
+    }
+    return std::make_shared<WriteBackVfsFile>(std::move(file), state);
+}
+
+FileTimeStampRaw WriteBackVfsDirectory::GetFileTimeStamp(std::string_view path) const {
+    return base->GetFileTimeStamp(path);
+}
+
+std::vector<VirtualDir> WriteBackVfsDirectory::GetSubdirectories() const {
+    std::vector<VirtualDir> out;
+    for (auto& dir : base->GetSubdirectories()) {
+        out.push_back(std::make_shared<WriteBackVfsDirectory>(std::move(dir), state));
+    }
+    return out;
+}
+
+VirtualDir WriteBackVfsDirectory::GetSubdirectory(std::string_view name) const {
+    auto dir = base->GetSubdirectory(name);
+    if (dir == nullptr) {
+        return nullptr;
+    }
+    return std::make_shared<WriteBackVfsDirectory>(std::move(dir), state);
+}
+
+bool WriteBackVfsDirectory::IsWritable() const {
+    return base->IsWritable();
+}
+
+bool WriteBackVfsDirectory::IsReadable() const {
+    return base->IsReadable();
+}
+
+std::string WriteBackVfsDirectory::GetName() const {
+    return base->GetName();
+}
+
+VirtualDir WriteBackVfsDirectory::GetParentDirectory() const {
+    auto dir = base->GetParentDirectory();
+    if (dir == nullptr) {
+        return nullptr;
+    }
+    return std::make_shared<WriteBackVfsDirectory>(std::move(dir), state);
+}
+
+VirtualDir WriteBackVfsDirectory::CreateSubdirectory(std::string_view name) {
+    auto dir = base->CreateSubdirectory(name);
+    if (dir == nullptr) {
+        return nullptr;
+    }
+    return std::make_shared<WriteBackVfsDirectory>(std::move(dir), state);
+}
+
+VirtualFile WriteBackVfsDirectory::CreateFile(std::string_view name) {
+    // Existing files are truncated, don't let older contents be written back over them
+    if (const auto file = base->GetFile(name)) {
+        state->Discard(file->GetFullPath());
+    }
+    auto file = base->CreateFile(name);
+    if (file == nullptr) {
+        return nullptr;
+    }
+    return std::make_shared<WriteBackVfsFile>(std::move(file), state);
+}
+
+bool WriteBackVfsDirectory::DeleteSubdirectory(std::string_view name) {
+    if (const auto dir = base->GetSubdirectory(name)) {
+        state->Discard(dir->GetFullPath());
+    }
+    return base->DeleteSubdirectory(name);
+}
+
+bool WriteBackVfsDirectory::DeleteSubdirectoryRecursive(std::string_view name) {
+    if (const auto dir = base->GetSubdirectory(name)) {
+        state->Discard(dir->GetFullPath());
+    }
+    return base->DeleteSubdirectoryRecursive(name);
+}
+
+bool WriteBackVfsDirectory::CleanSubdirectoryRecursive(std::string_view name) {
+    if (const auto dir = base->GetSubdirectory(name)) {
+        state->Discard(dir->GetFullPath());
+    }
+    return base->CleanSubdirectoryRecursive(name);
+}
+
+bool WriteBackVfsDirectory::DeleteFile(std::string_view name) {
+    if (const auto file = base->GetFile(name)) {
+        state->Discard(file->GetFullPath());
+    }
+    return base->DeleteFile(name);
+}
+
+bool WriteBackVfsDirectory::Rename(std::string_view name) {
+    // Buffers are looked up by path, write them back before the paths change
+    state->Flush();
+    return base->Rename(name);
+}
+
+std::string WriteBackVfsDirectory::GetFullPath() const {
+    return base->GetFullPath();
+}
+
+WriteBackVfsFile::WriteBackVfsFile(VirtualFile base_, std::shared_ptr<WriteBackState> state_)
+    : base(std::move(base_)), state(std::move(state_)), path(base->GetFullPath()) {}
+
+WriteBackVfsFile::~WriteBackVfsFile() = default;
+
+std::string WriteBackVfsFile::GetName() const {
+    return base->GetName();
+}
+
+std::size_t WriteBackVfsFile::GetSize() const {
+    std::scoped_lock lk{state->mutex};
+    if (const auto* const entry = state->Find(path)) {
+        return entry->data.size();
+    }
+    return base->GetSize();
+}
+
+bool WriteBackVfsFile::Resize(std::size_t new_size) {
+    if (!base->IsWritable()) {
+        return false;
+    }
+    std::scoped_lock lk{state->mutex};
+    auto* const entry = state->Load(path, base);
+    if (entry == nullptr) {
+        return base->Resize(new_size);
+    }
+    entry->data.resize(new_size);
+    entry->dirty = true;
+    return true;
+}
+
+VirtualDir WriteBackVfsFile::GetContainingDirectory() const {
+    auto dir = base->GetContainingDirectory();
+    if (dir == nullptr) {
+        return nullptr;
+    }
+    return std::make_shared<WriteBackVfsDirectory>(std::move(dir), state);
+}
+
+bool WriteBackVfsFile::IsWritable() const {
+    return base->IsWritable();
+}
+
+bool WriteBackVfsFile::IsReadable() const {
+    return base->IsReadable();
+}
+
+std::size_t WriteBackVfsFile::Read(u8* data, std::size_t length, std::size_t offset) const {
+    std::scoped_lock lk{state->mutex};
+    const auto* const entry = state->Find(path);
+    if (entry == nullptr) {
+        return base->Read(data, length, offset);
+    }
+    if (offset >= entry->data.size()) {
+        return 0;
+    }
+    const std::size_t read_size = std::min(length, entry->data.size() - offset);
+    std::memcpy(data, entry->data.data() + offset, read_size);
+    return read_size;
+}
+
+std::size_t WriteBackVfsFile::Write(const u8* data, std::size_t length, std::size_t offset) {
+    if (!base->IsWritable()) {
+        return 0;
+    }
+    std::scoped_lock lk{state->mutex};
+    auto* const entry = state->Load(path, base);
+    if (entry == nullptr) {
+        return base->Write(data, length, offset);
+    }
+    if (offset + length > entry->data.size()) {
+        entry->data.resize(offset + length);
+    }
+    std::memcpy(entry->data.data() + offset, data, length);
+    entry->dirty = true;
+    return length;
+}
+
+bool WriteBackVfsFile::Rename(std::string_view name) {
+    state->Flush();
+    if (!base->Rename(name)) {
+        return false;
+    }
+    path = base->GetFullPath();
+    return true;
+}
+
+std::string WriteBackVfsFile::GetFullPath() const {
+    return base->GetFullPath();
+}
+
+} // namespace FileSys
@@ -0,0 +1,76 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "core/file_sys/vfs/vfs.h"
+
+namespace FileSys {
+
+class WriteBackState;
+
+// A directory whose file writes are kept in memory until Commit is called. Committed files are
+// then written to the wrapped directory and synced to disk on a background thread, so frequent
+// writes and flushes from the guest don't wait on slow host storage. Used for save data.
+class WriteBackVfsDirectory : public VfsDirectory {
+public:
+    explicit WriteBackVfsDirectory(VirtualDir base_);
+    explicit WriteBackVfsDirectory(VirtualDir base_, std::shared_ptr<WriteBackState> state_);
+    ~WriteBackVfsDirectory() override;
+
+    // Queues the files changed since the last commit to be written back, in their current state.
+    void Commit();
+
+    std::vector<VirtualFile> GetFiles() const override;
+    VirtualFile GetFile(std::string_view name) const override;
+    FileTimeStampRaw GetFileTimeStamp(std::string_view path) const override;
+    std::vector<VirtualDir> GetSubdirectories() const override;
+    VirtualDir GetSubdirectory(std::string_view name) const override;
+    bool IsWritable() const override;
+    bool IsReadable() const override;
+    std::string GetName() const override;
+    VirtualDir GetParentDirectory() const override;
+    VirtualDir CreateSubdirectory(std::string_view name) override;
+    VirtualFile CreateFile(std::string_view name) override;
+    bool DeleteSubdirectory(std::string_view name) override;
+    bool DeleteSubdirectoryRecursive(std::string_view name) override;
+    bool CleanSubdirectoryRecursive(std::string_view name) override;
+    bool DeleteFile(std::string_view name) override;
+    bool Rename(std::string_view name) override;
+    std::string GetFullPath() const override;
+
+private:
+    VirtualDir base;
+    std::shared_ptr<WriteBackState> state;
+};
+
+// A file of a WriteBackVfsDirectory. Once written, its contents are served from memory until
+// they have been committed and written back.
+class WriteBackVfsFile : public VfsFile {
+public:
+    explicit WriteBackVfsFile(VirtualFile base_, std::shared_ptr<WriteBackState> state_);
+    ~WriteBackVfsFile() override;
+
+    std::string GetName() const override;
+    std::size_t GetSize() const override;
+    bool Resize(std::size_t new_size) override;
+    VirtualDir GetContainingDirectory() const override;
+    bool IsWritable() const override;
+    bool IsReadable() const override;
+    std::size_t Read(u8* data, std::size_t length, std::size_t offset) const override;
+    std::size_t Write(const u8* data, std::size_t length, std::size_t offset) override;
+    bool Rename(std::string_view name) override;
+    std::string GetFullPath() const override;
+
+private:
+    VirtualFile base;
+    std::shared_ptr<WriteBackState> state;
+    std::string path;
+};
+
+} // namespace FileSys
@@ -14,7 +14,9 @@
 
 namespace Core {
 
-class GPUDirtyMemoryManager {
+/// Collects the pages written by a single emulated core, there is one manager per core.
+/// Managers are kept on separate cache lines so cores writing at the same time don't contend.
+class alignas(128) GPUDirtyMemoryManager {
 public:
     GPUDirtyMemoryManager() : current{default_transform} {
         back_buffer.reserve(256);
@@ -23,34 +25,31 @@ public:
 
     ~GPUDirtyMemoryManager() = default;
 
+    /// Must only be called from the core owning this manager.
     void Collect(PAddr address, size_t size) {
-        TransformAddress t = BuildTransform(address, size);
-        TransformAddress tmp, original;
-        do {
-            tmp = current.load(std::memory_order_acquire);
-            original = tmp;
-            if (tmp.address != t.address) {
-                if (IsValid(tmp.address)) {
-                    std::scoped_lock lk(guard);
-                    back_buffer.emplace_back(tmp);
-                    current.exchange(t, std::memory_order_relaxed);
-                    return;
-                }
-                tmp.address = t.address;
-                tmp.mask = 0;
+        // Being the only writer besides Gather, plain loads and stores are enough here. When Gather
+        // takes the transform in between, storing it back only reports its bits again.
+        const TransformAddress t = BuildTransform(address, size);
+        TransformAddress tmp = current.load(std::memory_order_relaxed);
+        if (tmp.address != t.address) {
+            if (IsValid(tmp.address)) {
+                std::scoped_lock lk(guard);
+                back_buffer.emplace_back(tmp);
             }
-            if ((tmp.mask | t.mask) == tmp.mask) {
-                return;
-            }
-            tmp.mask |= t.mask;
-        } while (!current.compare_exchange_weak(original, tmp, std::memory_order_release,
-                                                std::memory_order_relaxed));
+            current.store(t, std::memory_order_release);
+            return;
+        }
+        if ((tmp.mask | t.mask) == tmp.mask) {
+            return;
+        }
+        tmp.mask |= t.mask;
+        current.store(tmp, std::memory_order_release);
     }
 
     void Gather(std::function<void(PAddr, size_t)>& callback) {
         {
             std::scoped_lock lk(guard);
-            TransformAddress t = current.exchange(default_transform, std::memory_order_relaxed);
+            TransformAddress t = current.exchange(default_transform, std::memory_order_acquire);
             front_buffer.swap(back_buffer);
             if (IsValid(t.address)) {
                 front_buffer.emplace_back(t);
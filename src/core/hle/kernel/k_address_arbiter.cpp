@@ -1,6 +1,7 @@
 // SPDX-FileCopyrightText: Copyright 2021 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include "common/scope_exit.h"
 #include "core/arm/exclusive_monitor.h"
 #include "core/core.h"
 #include "core/hle/kernel/k_address_arbiter.h"
@@ -109,13 +110,15 @@ bool UpdateIfEqual(KernelCore& kernel, s32* out, KProcessAddress address, s32 va
 
 class ThreadQueueImplForKAddressArbiter final : public KThreadQueue {
 public:
-    explicit ThreadQueueImplForKAddressArbiter(KernelCore& kernel, KAddressArbiter::ThreadTree* t)
-        : KThreadQueue(kernel), m_tree(t) {}
+    explicit ThreadQueueImplForKAddressArbiter(KernelCore& kernel, KAddressArbiter::ThreadTree* t,
+                                               std::atomic<u32>* waiter_count)
+        : KThreadQueue(kernel), m_tree(t), m_waiter_count(waiter_count) {}
 
     void CancelWait(KThread* waiting_thread, Result wait_result, bool cancel_timer_task) override {
         // If the thread is waiting on an address arbiter, remove it from the tree.
         if (waiting_thread->IsWaitingForAddressArbiter()) {
             m_tree->erase(m_tree->iterator_to(*waiting_thread));
+            m_waiter_count->fetch_sub(1);
             waiting_thread->ClearAddressArbiter();
         }
 
@@ -125,11 +128,17 @@ public:
 
 private:
     KAddressArbiter::ThreadTree* m_tree{};
+    std::atomic<u32>* m_waiter_count{};
 };
 
 } // namespace
 
 Result KAddressArbiter::Signal(uint64_t addr, s32 count) {
+    // Without waiters there's nothing to signal. Waiters are counted before they read the value,
+    // so a waiter missed here reads the value stored before this signal and doesn't sleep.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    R_SUCCEED_IF(GetWaiterCount(addr).load(std::memory_order_relaxed) == 0);
+
     // Perform signaling.
     s32 num_waiters{};
     {
@@ -146,6 +155,7 @@ Result KAddressArbiter::Signal(uint64_t addr, s32 count) {
             target_thread->ClearAddressArbiter();
 
             it = m_tree.erase(it);
+            GetWaiterCount(addr).fetch_sub(1);
             ++num_waiters;
         }
     }
@@ -175,6 +185,7 @@ Result KAddressArbiter::SignalAndIncrementIfEqual(uint64_t addr, s32 value, s32
             target_thread->ClearAddressArbiter();
 
             it = m_tree.erase(it);
+            GetWaiterCount(addr).fetch_sub(1);
             ++num_waiters;
         }
     }
@@ -238,6 +249,7 @@ Result KAddressArbiter::SignalAndModifyByWaitingCountIfEqual(uint64_t addr, s32
             target_thread->ClearAddressArbiter();
 
             it = m_tree.erase(it);
+            GetWaiterCount(addr).fetch_sub(1);
             ++num_waiters;
         }
     }
@@ -245,10 +257,23 @@ Result KAddressArbiter::SignalAndModifyByWaitingCountIfEqual(uint64_t addr, s32
 }
 
 Result KAddressArbiter::WaitIfLessThan(uint64_t addr, s32 value, bool decrement, s64 timeout) {
-    // Prepare to wait.
     KThread* cur_thread = GetCurrentThreadPointer(m_kernel);
+
+    // Values that don't need a wait fail without taking the scheduler lock, decrements are only
+    // done under it.
+    if (!cur_thread->IsTerminationRequested()) {
+        s32 user_value{};
+        R_UNLESS(ReadFromUser(m_kernel, std::addressof(user_value), addr),
+                 ResultInvalidCurrentMemory);
+        R_UNLESS(user_value < value, ResultInvalidState);
+        R_UNLESS(timeout != 0 || decrement, ResultTimedOut);
+    }
+
+    // Prepare to wait.
     KHardwareTimer* timer{};
-    ThreadQueueImplForKAddressArbiter wait_queue(m_kernel, std::addressof(m_tree));
+    std::atomic<u32>& waiter_count = GetWaiterCount(addr);
+    ThreadQueueImplForKAddressArbiter wait_queue(m_kernel, std::addressof(m_tree),
+                                                 std::addressof(waiter_count));
 
     {
         KScopedSchedulerLockAndSleep slp{m_kernel, std::addressof(timer), cur_thread, timeout};
@@ -259,6 +284,12 @@ Result KAddressArbiter::WaitIfLessThan(uint64_t addr, s32 value, bool decrement,
             R_THROW(ResultTerminationRequested);
         }
 
+        // Count the waiter before reading the value, see Signal.
+        waiter_count.fetch_add(1);
+        auto count_guard = SCOPE_GUARD {
+            waiter_count.fetch_sub(1);
+        };
+
         // Read the value from userspace.
         s32 user_value{};
         bool succeeded{};
@@ -288,6 +319,7 @@ Result KAddressArbiter::WaitIfLessThan(uint64_t addr, s32 value, bool decrement,
         // Set the arbiter.
         cur_thread->SetAddressArbiter(std::addressof(m_tree), addr);
         m_tree.insert(*cur_thread);
+        count_guard.Cancel();
 
         // Wait for the thread to finish.
         wait_queue.SetHardwareTimer(timer);
@@ -300,10 +332,22 @@ Result KAddressArbiter::WaitIfLessThan(uint64_t addr, s32 value, bool decrement,
 }
 
 Result KAddressArbiter::WaitIfEqual(uint64_t addr, s32 value, s64 timeout) {
-    // Prepare to wait.
     KThread* cur_thread = GetCurrentThreadPointer(m_kernel);
+
+    // Values that don't need a wait fail without taking the scheduler lock.
+    if (!cur_thread->IsTerminationRequested()) {
+        s32 user_value{};
+        R_UNLESS(ReadFromUser(m_kernel, std::addressof(user_value), addr),
+                 ResultInvalidCurrentMemory);
+        R_UNLESS(user_value == value, ResultInvalidState);
+        R_UNLESS(timeout != 0, ResultTimedOut);
+    }
+
+    // Prepare to wait.
     KHardwareTimer* timer{};
-    ThreadQueueImplForKAddressArbiter wait_queue(m_kernel, std::addressof(m_tree));
+    std::atomic<u32>& waiter_count = GetWaiterCount(addr);
+    ThreadQueueImplForKAddressArbiter wait_queue(m_kernel, std::addressof(m_tree),
+                                                 std::addressof(waiter_count));
 
     {
         KScopedSchedulerLockAndSleep slp{m_kernel, std::addressof(timer), cur_thread, timeout};
@@ -314,6 +358,12 @@ Result KAddressArbiter::WaitIfEqual(uint64_t addr, s32 value, s64 timeout) {
             R_THROW(ResultTerminationRequested);
         }
 
+        // Count the waiter before reading the value, see Signal.
+        waiter_count.fetch_add(1);
+        auto count_guard = SCOPE_GUARD {
+            waiter_count.fetch_sub(1);
+        };
+
         // Read the value from userspace.
         s32 user_value{};
         if (!ReadFromUser(m_kernel, std::addressof(user_value), addr)) {
@@ -336,6 +386,7 @@ Result KAddressArbiter::WaitIfEqual(uint64_t addr, s32 value, s64 timeout) {
         // Set the arbiter.
         cur_thread->SetAddressArbiter(std::addressof(m_tree), addr);
         m_tree.insert(*cur_thread);
+        count_guard.Cancel();
 
         // Wait for the thread to finish.
         wait_queue.SetHardwareTimer(timer);
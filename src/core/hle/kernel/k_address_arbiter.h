@@ -3,6 +3,9 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
+
 #include "common/assert.h"
 #include "common/common_types.h"
 #include "core/hle/kernel/k_condition_variable.h"
@@ -58,8 +61,16 @@ private:
     Result WaitIfLessThan(uint64_t addr, s32 value, bool decrement, s64 timeout);
     Result WaitIfEqual(uint64_t addr, s32 value, s64 timeout);
 
+    std::atomic<u32>& GetWaiterCount(uint64_t addr) {
+        return m_waiter_counts[(addr / sizeof(u32)) % NumWaiterCounts];
+    }
+
 private:
+    static constexpr size_t NumWaiterCounts = 64;
+
     ThreadTree m_tree;
+    /// Threads in the tree hashed by address, signals of addresses without waiters skip the lock
+    std::array<std::atomic<u32>, NumWaiterCounts> m_waiter_counts{};
     Core::System& m_system;
     KernelCore& m_kernel;
 };
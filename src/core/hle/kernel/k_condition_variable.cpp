@@ -1,8 +1,10 @@
 // SPDX-FileCopyrightText: Copyright 2021 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include "common/spin_lock.h"
 #include "core/arm/exclusive_monitor.h"
 #include "core/core.h"
+#include "core/hardware_properties.h"
 #include "core/hle/kernel/k_condition_variable.h"
 #include "core/hle/kernel/k_process.h"
 #include "core/hle/kernel/k_scheduler.h"
@@ -23,6 +25,44 @@ bool ReadFromUser(KernelCore& kernel, u32* out, KProcessAddress address) {
     return true;
 }
 
+// Number of times the tag of a held lock is polled while its owner keeps running
+constexpr s32 LockSpinCount = 64;
+
+bool IsRunning(KernelCore& kernel, KThread* thread) {
+    const s32 core = thread->GetActiveCore();
+    return core >= 0 && core < static_cast<s32>(Core::Hardware::NUM_CPU_CORES) &&
+           kernel.Scheduler(core).GetSchedulerCurrentThread() == thread;
+}
+
+// Polls the tag of a lock while its owner runs on another core, returns true once it changed.
+bool SpinWhileOwnerRuns(KernelCore& kernel, Handle handle, KProcessAddress address) {
+    const u32 waiting_tag = handle | Svc::HandleWaitMask;
+    u32 tag{};
+    if (!ReadFromUser(kernel, std::addressof(tag), address)) {
+        return false;
+    }
+    if (tag != waiting_tag) {
+        return true;
+    }
+
+    // Without other host cores running the owner, it can't release the lock while we spin.
+    if (!kernel.IsMulticore()) {
+        return false;
+    }
+    KScopedAutoObject owner =
+        GetCurrentProcess(kernel).GetHandleTable().GetObjectWithoutPseudoHandle<KThread>(handle);
+    if (owner.IsNull()) {
+        return false;
+    }
+    for (s32 i = 0; i < LockSpinCount && IsRunning(kernel, owner.GetPointerUnsafe()); ++i) {
+        Common::ThreadPause();
+        if (ReadFromUser(kernel, std::addressof(tag), address) && tag != waiting_tag) {
+            return true;
+        }
+    }
+    return false;
+}
+
 bool WriteToUser(KernelCore& kernel, KProcessAddress address, const u32* p) {
     GetCurrentMemory(kernel).Write32(GetInteger(address), *p);
     return true;
@@ -153,6 +193,12 @@ Result KConditionVariable::WaitForAddress(KernelCore& kernel, Handle handle, KPr
     KThread* cur_thread = GetCurrentThreadPointer(kernel);
     ThreadQueueImplForKConditionVariableWaitForAddress wait_queue(kernel);
 
+    // Locks that were released, or are released shortly by an owner running on another core, are
+    // done without taking the scheduler lock. Terminating threads take the slow path to fail.
+    if (!cur_thread->IsTerminationRequested() && SpinWhileOwnerRuns(kernel, handle, addr)) {
+        R_SUCCEED();
+    }
+
     // Wait for the address.
     KThread* owner_thread{};
     {
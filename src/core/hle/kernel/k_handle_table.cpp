@@ -12,13 +12,14 @@ Result KHandleTable::Finalize() {
     {
         KScopedDisableDispatch dd{m_kernel};
         KScopedSpinLock lk(m_lock);
+        KScopedTableUpdate update(*this);
 
-        std::swap(m_table_size, saved_table_size);
+        saved_table_size = m_table_size.exchange(saved_table_size);
     }
 
     // Close and free all entries.
-    for (size_t i = 0; i < saved_table_size; i++) {
-        if (KAutoObject* obj = m_objects[i]; obj != nullptr) {
+    for (s32 i = 0; i < static_cast<s32>(saved_table_size); i++) {
+        if (KAutoObject* obj = this->LoadObject(i); obj != nullptr) {
             obj->Close();
         }
     }
@@ -46,8 +47,9 @@ bool KHandleTable::Remove(Handle handle) {
 
         if (this->IsValidHandle(handle)) [[likely]] {
             const auto index = handle_pack.index;
+            KScopedTableUpdate update(*this);
 
-            obj = m_objects[index];
+            obj = this->LoadObject(index);
             this->FreeEntry(index);
         } else {
             return false;
@@ -69,11 +71,12 @@ Result KHandleTable::Add(Handle* out_handle, KAutoObject* obj) {
 
     // Allocate entry, set output handle.
     {
+        KScopedTableUpdate update(*this);
         const auto linear_id = this->AllocateLinearId();
         const auto index = this->AllocateEntry();
 
-        m_entry_infos[index].linear_id = linear_id;
-        m_objects[index] = obj;
+        this->StoreLinearId(index, linear_id);
+        this->StoreObject(index, obj);
 
         obj->Open();
 
@@ -106,6 +109,7 @@ Result KHandleTable::Reserve(Handle* out_handle) {
     // Never exceed our capacity.
     R_UNLESS(m_count < m_table_size, ResultOutOfHandles);
 
+    KScopedTableUpdate update(*this);
     *out_handle = EncodeHandle(static_cast<u16>(this->AllocateEntry()), this->AllocateLinearId());
     R_SUCCEED();
 }
@@ -124,7 +128,8 @@ void KHandleTable::Unreserve(Handle handle) {
 
     if (index < m_table_size) [[likely]] {
         // NOTE: This code does not check the linear id.
-        ASSERT(m_objects[index] == nullptr);
+        ASSERT(this->LoadObject(index) == nullptr);
+        KScopedTableUpdate update(*this);
         this->FreeEntry(index);
     }
 }
@@ -143,10 +148,11 @@ void KHandleTable::Register(Handle handle, KAutoObject* obj) {
 
     if (index < m_table_size) [[likely]] {
         // Set the entry.
-        ASSERT(m_objects[index] == nullptr);
+        ASSERT(this->LoadObject(index) == nullptr);
+        KScopedTableUpdate update(*this);
 
-        m_entry_infos[index].linear_id = static_cast<u16>(linear_id);
-        m_objects[index] = obj;
+        this->StoreLinearId(index, static_cast<u16>(linear_id));
+        this->StoreObject(index, obj);
 
         obj->Open();
     }
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 
 #include "common/assert.h"
 #include "common/bit_field.h"
@@ -37,17 +38,18 @@ public:
         // Lock.
         KScopedDisableDispatch dd{m_kernel};
         KScopedSpinLock lk(m_lock);
+        KScopedTableUpdate update(*this);
 
         // Initialize all fields.
         m_max_count = 0;
-        m_table_size = static_cast<s16>((size <= 0) ? MaxTableSize : size);
+        m_table_size = static_cast<u16>((size <= 0) ? MaxTableSize : size);
         m_next_linear_id = MinLinearId;
         m_count = 0;
         m_free_head_index = -1;
 
         // Free all entries.
         for (s32 i = 0; i < static_cast<s32>(m_table_size); ++i) {
-            m_objects[i] = nullptr;
+            this->StoreObject(i, nullptr);
             m_entry_infos[i].next_free_index = static_cast<s16>(i - 1);
             m_free_head_index = i;
         }
@@ -70,6 +72,16 @@ public:
 
     template <typename T = KAutoObject>
     KScopedAutoObject<T> GetObjectWithoutPseudoHandle(Handle handle) const {
+        // Try to look up in table without taking the lock.
+        if (KAutoObject* obj; this->TryOpenObjectUnlocked(std::addressof(obj), handle))
+            [[likely]] {
+            if constexpr (std::is_same_v<T, KAutoObject>) {
+                return AdoptObject(obj);
+            } else {
+                return KScopedAutoObject<T>(AdoptObject(obj));
+            }
+        }
+
         // Lock and look up in table.
         KScopedDisableDispatch dd{m_kernel};
         KScopedSpinLock lk(m_lock);
@@ -106,6 +118,12 @@ public:
     }
 
     KScopedAutoObject<KAutoObject> GetObjectForIpcWithoutPseudoHandle(Handle handle) const {
+        // Try to look up in table without taking the lock.
+        if (KAutoObject* obj; this->TryOpenObjectUnlocked(std::addressof(obj), handle))
+            [[likely]] {
+            return AdoptObject(obj);
+        }
+
         // Lock and look up in table.
         KScopedDisableDispatch dd{m_kernel};
         KScopedSpinLock lk(m_lock);
@@ -130,9 +148,34 @@ public:
 
     template <typename T>
     bool GetMultipleObjects(T** out, const Handle* handles, size_t num_handles) const {
-        // Try to convert and open all the handles.
+        // Try to convert and open all the handles without taking the lock.
         size_t num_opened;
-        {
+        bool table_changed = false;
+        for (num_opened = 0; num_opened < num_handles; num_opened++) {
+            KAutoObject* cur_object;
+            if (!this->TryOpenObjectUnlocked(std::addressof(cur_object), handles[num_opened]))
+                [[unlikely]] {
+                table_changed = true;
+                break;
+            }
+            if (cur_object == nullptr) [[unlikely]] {
+                break;
+            }
+
+            T* cur_t = cur_object->DynamicCast<T*>();
+            if (cur_t == nullptr) [[unlikely]] {
+                cur_object->Close();
+                break;
+            }
+            out[num_opened] = cur_t;
+        }
+
+        // If the table was modified concurrently, start over with the table locked.
+        if (table_changed) [[unlikely]] {
+            for (size_t i = 0; i < num_opened; i++) {
+                out[i]->Close();
+            }
+
             // Lock the table.
             KScopedDisableDispatch dd{m_kernel};
             KScopedSpinLock lk(m_lock);
@@ -187,7 +230,7 @@ private:
     void FreeEntry(s32 index) {
         ASSERT(m_count > 0);
 
-        m_objects[index] = nullptr;
+        this->StoreObject(index, nullptr);
         m_entry_infos[index].next_free_index = static_cast<s16>(m_free_head_index);
 
         m_free_head_index = index;
@@ -224,10 +267,10 @@ private:
         }
 
         // Check that there's an object, and our serial id is correct.
-        if (m_objects[index] == nullptr) [[unlikely]] {
+        if (this->LoadObject(index) == nullptr) [[unlikely]] {
             return false;
         }
-        if (m_entry_infos[index].GetLinearId() != linear_id) [[unlikely]] {
+        if (this->LoadLinearId(index) != linear_id) [[unlikely]] {
             return false;
         }
 
@@ -242,12 +285,50 @@ private:
         }
 
         if (this->IsValidHandle(handle)) [[likely]] {
-            return m_objects[handle_pack.index];
+            return this->LoadObject(handle_pack.index);
         } else {
             return nullptr;
         }
     }
 
+    /// Looks up and opens the object of a handle without taking the lock. Returns false if the
+    /// table was modified during the lookup, in which case the locked lookup has to be used.
+    bool TryOpenObjectUnlocked(KAutoObject** out_obj, Handle handle) const {
+        const u32 sequence = m_sequence.load(std::memory_order_acquire);
+        if ((sequence & 1) != 0) [[unlikely]] {
+            return false;
+        }
+
+        // Objects referenced by the table always hold a reference. If opening fails, the entry
+        // was removed concurrently. Kernel objects live in slab heaps, so the reference count
+        // stays readable even after the object has been destroyed.
+        KAutoObject* obj = this->GetObjectImpl(handle);
+        if (obj != nullptr && !obj->Open()) [[unlikely]] {
+            return false;
+        }
+
+        // Check that the entry did not change while it was read.
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (m_sequence.load(std::memory_order_relaxed) != sequence) [[unlikely]] {
+            if (obj != nullptr) {
+                obj->Close();
+            }
+            return false;
+        }
+
+        *out_obj = obj;
+        return true;
+    }
+
+    /// Wraps an object opened by TryOpenObjectUnlocked, taking over its reference
+    static KScopedAutoObject<KAutoObject> AdoptObject(KAutoObject* obj) {
+        KScopedAutoObject<KAutoObject> scoped(obj);
+        if (obj != nullptr) {
+            obj->Close();
+        }
+        return scoped;
+    }
+
     KAutoObject* GetObjectByIndexImpl(Handle* out_handle, size_t index) const {
         // Index must be in bounds.
         if (index >= m_table_size) [[unlikely]] {
@@ -255,7 +336,7 @@ private:
         }
 
         // Ensure entry has an object.
-        if (KAutoObject* obj = m_objects[index]; obj != nullptr) {
+        if (KAutoObject* obj = this->LoadObject(static_cast<s32>(index)); obj != nullptr) {
             *out_handle = EncodeHandle(static_cast<u16>(index), m_entry_infos[index].GetLinearId());
             return obj;
         } else {
@@ -263,6 +344,43 @@ private:
         }
     }
 
+    KAutoObject* LoadObject(s32 index) const {
+        return m_objects[index].load(std::memory_order_relaxed);
+    }
+
+    void StoreObject(s32 index, KAutoObject* obj) {
+        m_objects[index].store(obj, std::memory_order_relaxed);
+    }
+
+    u16 LoadLinearId(s32 index) const {
+        // The unlocked lookup reads the linear id while it may be written under the lock.
+        return std::atomic_ref(const_cast<u16&>(m_entry_infos[index].linear_id))
+            .load(std::memory_order_relaxed);
+    }
+
+    void StoreLinearId(s32 index, u16 linear_id) {
+        std::atomic_ref(m_entry_infos[index].linear_id).store(linear_id, std::memory_order_relaxed);
+    }
+
+    /// Marks the table as being modified for the duration of its scope, which makes unlocked
+    /// lookups overlapping with the modification retry with the lock held
+    class KScopedTableUpdate {
+    public:
+        explicit KScopedTableUpdate(KHandleTable& table) : m_table(table) {
+            const u32 sequence = m_table.m_sequence.load(std::memory_order_relaxed);
+            m_table.m_sequence.store(sequence + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+        }
+
+        ~KScopedTableUpdate() {
+            const u32 sequence = m_table.m_sequence.load(std::memory_order_relaxed);
+            m_table.m_sequence.store(sequence + 1, std::memory_order_release);
+        }
+
+    private:
+        KHandleTable& m_table;
+    };
+
 private:
     union HandlePack {
         constexpr HandlePack() = default;
@@ -301,10 +419,11 @@ private:
 private:
     KernelCore& m_kernel;
     std::array<EntryInfo, MaxTableSize> m_entry_infos{};
-    std::array<KAutoObject*, MaxTableSize> m_objects{};
+    std::array<std::atomic<KAutoObject*>, MaxTableSize> m_objects{};
     mutable KSpinLock m_lock;
+    std::atomic<u32> m_sequence{};
     s32 m_free_head_index{};
-    u16 m_table_size{};
+    std::atomic<u16> m_table_size{};
     u16 m_max_count{};
     u16 m_next_linear_id{};
     u16 m_count{};
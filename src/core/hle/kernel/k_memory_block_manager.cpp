@@ -37,6 +37,7 @@ void KMemoryBlockManager::Finalize(KMemoryBlockSlabManager* slab_manager,
         block_callback(block->GetAddress(), block->GetSize());
         slab_manager->Free(block);
     }
+    m_find_hint = nullptr;
 
     ASSERT(m_memory_block_tree.empty());
 }
@@ -97,6 +98,9 @@ void KMemoryBlockManager::CoalesceForUpdate(KMemoryBlockManagerUpdateAllocator*
         if (prev->CanMergeWith(*it)) {
             KMemoryBlock* block = std::addressof(*it);
             m_memory_block_tree.erase(it);
+            if (block == m_find_hint) {
+                m_find_hint = std::addressof(*prev);
+            }
             prev->Add(*block);
             allocator->Free(block);
             it = prev;
@@ -122,8 +122,23 @@ public:
                          size_t num_pages, KMemoryAttribute mask, KMemoryAttribute attr);
 
     iterator FindIterator(KProcessAddress address) const {
-        return m_memory_block_tree.find(KMemoryBlock(
+        // State checks and queries mostly look up the block found last or the one following it.
+        if (m_find_hint != nullptr) {
+            auto& tree = const_cast<MemoryBlockTree&>(m_memory_block_tree);
+            iterator it = tree.iterator_to(*m_find_hint);
+            if (BlockContains(*it, address)) {
+                return it;
+            }
+            if (++it != tree.end() && BlockContains(*it, address)) {
+                m_find_hint = std::addressof(*it);
+                return it;
+            }
+        }
+
+        iterator it = m_memory_block_tree.find(KMemoryBlock(
             address, 1, KMemoryState::Free, KMemoryPermission::None, KMemoryAttribute::None));
+        m_find_hint = it != m_memory_block_tree.end() ? std::addressof(*it) : nullptr;
+        return it;
     }
 
     const KMemoryBlock* FindBlock(KProcessAddress address) const {
@@ -138,12 +153,17 @@ public:
     bool CheckState() const;
 
 private:
+    static bool BlockContains(const KMemoryBlock& block, KProcessAddress address) {
+        return block.GetAddress() <= address && address < block.GetEndAddress();
+    }
+
     void CoalesceForUpdate(KMemoryBlockManagerUpdateAllocator* allocator, KProcessAddress address,
                            size_t num_pages);
 
     MemoryBlockTree m_memory_block_tree;
     KProcessAddress m_start_address{};
     KProcessAddress m_end_address{};
+    mutable KMemoryBlock* m_find_hint{};
 };
 
 class KScopedMemoryBlockManagerAuditor {
@@ -3,7 +3,10 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <atomic>
+#include <mutex>
 
 #include "common/assert.h"
 #include "common/atomic_ops.h"
@@ -40,7 +43,7 @@ public:
     void* Allocate() {
         // KScopedInterruptDisable di;
 
-        m_lock.lock();
+        this->Lock();
 
         Node* ret = m_head;
         if (ret != nullptr) [[likely]] {
@@ -54,7 +57,7 @@ public:
     void Free(void* obj) {
         // KScopedInterruptDisable di;
 
-        m_lock.lock();
+        this->Lock();
 
         Node* node = static_cast<Node*>(obj);
         node->next = m_head;
@@ -63,9 +66,55 @@ public:
         m_lock.unlock();
     }
 
+    /// Pops up to count objects with a single acquisition of the lock, returns how many were popped
+    size_t AllocateBatch(void** objs, size_t count) {
+        this->Lock();
+
+        size_t num_allocated = 0;
+        Node* head = m_head;
+        while (num_allocated < count && head != nullptr) {
+            objs[num_allocated++] = head;
+            head = head->next;
+        }
+        m_head = head;
+
+        m_lock.unlock();
+        return num_allocated;
+    }
+
+    /// Pushes count objects with a single acquisition of the lock
+    void FreeBatch(void* const* objs, size_t count) {
+        this->Lock();
+
+        Node* head = m_head;
+        for (size_t i = 0; i < count; i++) {
+            Node* node = static_cast<Node*>(objs[i]);
+            node->next = head;
+            head = node;
+        }
+        m_head = head;
+
+        m_lock.unlock();
+    }
+
+    /// Number of times the lock was found held by another thread
+    u64 GetContendedCount() const {
+        return m_contended.load(std::memory_order_relaxed);
+    }
+
+private:
+    void Lock() {
+        if (m_lock.try_lock()) [[likely]] {
+            return;
+        }
+        m_contended.fetch_add(1, std::memory_order_relaxed);
+        m_lock.lock();
+    }
+
 private:
     std::atomic<Node*> m_head{};
     Common::SpinLock m_lock;
+    std::atomic<u64> m_contended{};
 };
 
 } // namespace impl
@@ -75,7 +124,29 @@ class KSlabHeapBase : protected impl::KSlabHeapImpl {
     YUZU_NON_COPYABLE(KSlabHeapBase);
     YUZU_NON_MOVEABLE(KSlabHeapBase);
 
+public:
+    struct Statistics {
+        u64 cache_hits;
+        u64 cache_misses;
+        u64 contended;
+    };
+
+private:
+    static constexpr size_t NumCaches = 4;
+    static constexpr size_t CacheCapacity = 32;
+    static constexpr size_t CacheBatchSize = CacheCapacity / 2;
+
+    /// Small stack of free objects in front of the shared free list, used by a subset of threads
+    struct alignas(64) Cache {
+        Common::SpinLock lock;
+        size_t count{};
+        std::array<void*, CacheCapacity> objs{};
+    };
+
 private:
+    std::array<Cache, NumCaches> m_caches{};
+    std::atomic<u64> m_cache_hits{};
+    std::atomic<u64> m_cache_misses{};
     size_t m_obj_size{};
     uintptr_t m_peak{};
     uintptr_t m_start{};
@@ -93,6 +164,25 @@ private:
             !Common::AtomicCompareAndSwap(std::addressof(m_peak), alloc_peak, cur_peak, cur_peak));
     }
 
+    static Cache& GetCache(std::array<Cache, NumCaches>& caches) {
+        // Each host thread sticks to one cache, so the emulated cores mostly use their own.
+        static std::atomic<size_t> s_next_index{};
+        thread_local const size_t index =
+            s_next_index.fetch_add(1, std::memory_order_relaxed) % NumCaches;
+        return caches[index];
+    }
+
+    void* StealFromCaches() {
+        // The shared list is exhausted, take back objects held by the other caches.
+        for (Cache& cache : m_caches) {
+            std::scoped_lock lk{cache.lock};
+            if (cache.count != 0) {
+                return cache.objs[--cache.count];
+            }
+        }
+        return KSlabHeapImpl::Allocate();
+    }
+
 public:
     constexpr KSlabHeapBase() = default;
 
@@ -134,16 +224,49 @@ public:
     }
 
     void* Allocate() {
-        void* obj = KSlabHeapImpl::Allocate();
+        Cache& cache = GetCache(m_caches);
+        {
+            std::scoped_lock lk{cache.lock};
+            if (cache.count != 0) [[likely]] {
+                m_cache_hits.fetch_add(1, std::memory_order_relaxed);
+                return cache.objs[--cache.count];
+            }
 
-        return obj;
+            // Refill half of the cache with a single acquisition of the shared list.
+            m_cache_misses.fetch_add(1, std::memory_order_relaxed);
+            const size_t num_allocated =
+                KSlabHeapImpl::AllocateBatch(cache.objs.data(), CacheBatchSize);
+            if (num_allocated != 0) [[likely]] {
+                cache.count = num_allocated - 1;
+                return cache.objs[cache.count];
+            }
+        }
+
+        return this->StealFromCaches();
     }
 
     void Free(void* obj) {
         // Don't allow freeing an object that wasn't allocated from this heap.
         const bool contained = this->Contains(reinterpret_cast<uintptr_t>(obj));
         ASSERT(contained);
-        KSlabHeapImpl::Free(obj);
+
+        Cache& cache = GetCache(m_caches);
+        std::scoped_lock lk{cache.lock};
+        if (cache.count == CacheCapacity) [[unlikely]] {
+            // Return the least recently freed half to the shared list.
+            KSlabHeapImpl::FreeBatch(cache.objs.data(), CacheBatchSize);
+            std::copy(cache.objs.begin() + CacheBatchSize, cache.objs.end(), cache.objs.begin());
+            cache.count -= CacheBatchSize;
+        }
+        cache.objs[cache.count++] = obj;
+    }
+
+    Statistics GetStatistics() const {
+        return {
+            .cache_hits = m_cache_hits.load(std::memory_order_relaxed),
+            .cache_misses = m_cache_misses.load(std::memory_order_relaxed),
+            .contended = KSlabHeapImpl::GetContendedCount(),
+        };
     }
 
     size_t GetObjectIndex(const void* obj) const {
@@ -1,20 +1,45 @@
 // SPDX-FileCopyrightText: Copyright 2021 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include "common/spin_lock.h"
 #include "core/hle/kernel/k_spin_lock.h"
 
 namespace Kernel {
 
+namespace {
+
+// Number of times a contended lock is polled before sleeping on it
+constexpr u32 SpinCount = 256;
+
+} // Anonymous namespace
+
 void KSpinLock::Lock() {
-    m_lock.lock();
+    if (this->TryLock()) {
+        return;
+    }
+
+    for (u32 i = 0; i < SpinCount; ++i) {
+        Common::ThreadPause();
+        if (m_state.load(std::memory_order_relaxed) == State::Unlocked && this->TryLock()) {
+            return;
+        }
+    }
+
+    // Mark the lock as contended so that the owner wakes us up when releasing it.
+    while (m_state.exchange(State::Contended, std::memory_order_acquire) != State::Unlocked) {
+        m_state.wait(State::Contended, std::memory_order_relaxed);
+    }
 }
 
 void KSpinLock::Unlock() {
-    m_lock.unlock();
+    if (m_state.exchange(State::Unlocked, std::memory_order_release) == State::Contended) {
+        m_state.notify_one();
+    }
 }
 
 bool KSpinLock::TryLock() {
-    return m_lock.try_lock();
+    State expected = State::Unlocked;
+    return m_state.compare_exchange_strong(expected, State::Locked, std::memory_order_acquire);
 }
 
 } // namespace Kernel
@@ -3,13 +3,20 @@
 
 #pragma once
 
+#include <atomic>
 #include <mutex>
 
 #include "common/common_funcs.h"
+#include "common/common_types.h"
 #include "core/hle/kernel/k_scoped_lock.h"
 
 namespace Kernel {
 
+/**
+ * Lock guarding short kernel critical sections, most notably the scheduler lock. Contended
+ * acquisitions spin for a while before sleeping, as the owner is usually about to release it and
+ * a sleep costs a host context switch on both sides.
+ */
 class KSpinLock {
 public:
     explicit KSpinLock() = default;
@@ -22,7 +29,14 @@ public:
     bool TryLock();
 
 private:
-    std::mutex m_lock;
+    enum class State : u32 {
+        Unlocked,
+        Locked,
+        /// Locked, and threads may be sleeping on it
+        Contended,
+    };
+
+    std::atomic<State> m_state{State::Unlocked};
 };
 
 // TODO(bunnei): Alias for now, in case we want to implement these accurately in the future.
@@ -861,6 +861,7 @@ void KernelCore::Initialize() {
 }
 
 void KernelCore::Shutdown() {
+    LogSlabHeapStatistics();
     impl->Shutdown();
 }
 
@@ -1346,6 +1347,21 @@ struct KernelCore::SlabHeapContainer {
     KSlabHeap<KDebug> debug;
 };
 
+void KernelCore::LogSlabHeapStatistics() const {
+    if (!slab_heap_container) {
+        return;
+    }
+    const auto log_statistics = [](const char* name, const auto& heap) {
+        const auto stats = heap.GetStatistics();
+        const u64 total = stats.cache_hits + stats.cache_misses;
+        LOG_DEBUG(Kernel, "{} slab heap: {} of {} allocations from cache, {} contended locks",
+                  name, stats.cache_hits, total, stats.contended);
+    };
+    log_statistics("KThread", slab_heap_container->thread);
+    log_statistics("KEvent", slab_heap_container->event);
+    log_statistics("KSession", slab_heap_container->session);
+}
+
 template <typename T>
 KSlabHeap<T>& KernelCore::SlabHeap() {
     if constexpr (std::is_same_v<T, KClientSession>) {
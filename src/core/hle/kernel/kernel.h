@@ -329,6 +329,9 @@ private:
     bool exception_exited{};
 
 private:
+    /// Logs the cache hit rate and lock contention of the most frequently used slab heaps
+    void LogSlabHeapStatistics() const;
+
     /// Helper to encapsulate all slab heaps in a single heap allocated container
     struct SlabHeapContainer;
 
@@ -1,8 +1,13 @@
 // SPDX-FileCopyrightText: Copyright 2020 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <chrono>
+#include <utility>
+
+#include "common/perf_metrics.h"
 #include "common/scope_exit.h"
 #include "common/settings.h"
+#include "common/tracing.h"
 #include "core/core.h"
 #include "core/debugger/debugger.h"
 #include "core/hle/kernel/k_process.h"
@@ -10,6 +15,7 @@
 #include "core/hle/kernel/kernel.h"
 #include "core/hle/kernel/physical_core.h"
 #include "core/hle/kernel/svc.h"
+#include "core/tools/guest_profiler.h"
 
 namespace Kernel {
 
@@ -26,6 +32,9 @@ void PhysicalCore::RunThread(Kernel::KThread* thread) {
 
     interface->Initialize();
 
+    // Profiler waiting for a sample of the guest context, taken once execution stops
+    Tools::GuestProfiler* sample_profiler{};
+
     const auto EnterContext = [&]() {
         system.EnterCPUProfile();
 
@@ -40,6 +49,7 @@ void PhysicalCore::RunThread(Kernel::KThread* thread) {
         // Mark that we are running.
         m_arm_interface = interface;
         m_current_thread = thread;
+        m_activity = CoreActivity::Guest;
 
         // Acquire the lock on the thread parameters.
         // This allows us to force synchronization with Interrupt.
@@ -58,6 +68,8 @@ void PhysicalCore::RunThread(Kernel::KThread* thread) {
         // On exit, we no longer are running.
         m_arm_interface = nullptr;
         m_current_thread = nullptr;
+        m_activity = CoreActivity::Host;
+        sample_profiler = std::exchange(m_sample_profiler, nullptr);
 
         system.ExitCPUProfile();
     };
@@ -83,6 +95,7 @@ void PhysicalCore::RunThread(Kernel::KThread* thread) {
             if (!EnterContext()) {
                 return;
             }
+            TRACE_ZONE("Guest");
 
             if (thread->GetStepState() == StepState::StepPending) {
                 hr = interface->StepThread(thread);
@@ -97,6 +110,14 @@ void PhysicalCore::RunThread(Kernel::KThread* thread) {
             ExitContext();
         }
 
+        // Take the sample requested while the guest was running.
+        const bool sampled = sample_profiler != nullptr;
+        if (sampled) {
+            Svc::ThreadContext ctx{};
+            interface->GetContext(ctx);
+            sample_profiler->RecordGuestSample(m_core_index, process, ctx);
+        }
+
         // Determine why we stopped.
         const bool supervisor_call = True(hr & Core::HaltReason::SupervisorCall);
         const bool prefetch_abort = True(hr & Core::HaltReason::PrefetchAbort);
@@ -134,10 +155,17 @@ void PhysicalCore::RunThread(Kernel::KThread* thread) {
         // Handle system calls.
         if (supervisor_call) {
             // Perform call.
+            m_activity = CoreActivity::SupervisorCall;
             Svc::Call(system, interface->GetSvcNumber());
+            m_activity = CoreActivity::Host;
             return;
         }
 
+        // Resume the guest if it was only stopped to take a sample.
+        if (interrupt && sampled && !m_is_single_core && !IsInterrupted()) {
+            continue;
+        }
+
         // Handle external interrupt sources.
         if (interrupt || m_is_single_core) {
             return;
@@ -160,8 +188,9 @@ void PhysicalCore::LoadContext(const KThread* thread) {
     }
 }
 
-void PhysicalCore::LoadSvcArguments(const KProcess& process, std::span<const uint64_t, 8> args) {
-    process.GetArmInterface(m_core_index)->SetSvcArguments(args);
+void PhysicalCore::LoadSvcArguments(const KProcess& process, std::span<const uint64_t, 8> args,
+                                    u32 mask) {
+    process.GetArmInterface(m_core_index)->SetSvcArguments(args, mask);
 }
 
 void PhysicalCore::SaveContext(KThread* thread) const {
@@ -177,8 +206,9 @@ void PhysicalCore::SaveContext(KThread* thread) const {
     }
 }
 
-void PhysicalCore::SaveSvcArguments(KProcess& process, std::span<uint64_t, 8> args) const {
-    process.GetArmInterface(m_core_index)->GetSvcArguments(args);
+void PhysicalCore::SaveSvcArguments(KProcess& process, std::span<uint64_t, 8> args,
+                                    u32 mask) const {
+    process.GetArmInterface(m_core_index)->GetSvcArguments(args, mask);
 }
 
 void PhysicalCore::CloneFpuStatus(KThread* dst) const {
@@ -204,8 +234,17 @@ void PhysicalCore::LogBacktrace() {
 }
 
 void PhysicalCore::Idle() {
+    TRACE_ZONE("Idle");
+    const auto idle_begin = std::chrono::steady_clock::now();
     std::unique_lock lk{m_guard};
+    m_activity = CoreActivity::Idle;
     m_on_interrupt.wait(lk, [this] { return m_is_interrupted; });
+    m_activity = CoreActivity::Host;
+
+    const auto idle_time = std::chrono::steady_clock::now() - idle_begin;
+    Common::PerfMetrics::Add(
+        Common::PerfMetrics::CoreIdleCounter(m_core_index),
+        static_cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(idle_time).count()));
 }
 
 bool PhysicalCore::IsInterrupted() const {
@@ -235,6 +274,21 @@ void PhysicalCore::Interrupt() {
     arm_interface->SignalInterrupt(thread);
 }
 
+void PhysicalCore::RequestSample(Tools::GuestProfiler& profiler) {
+    // Lock core context.
+    std::scoped_lock lk{m_guard};
+
+    // If there is no thread running, the core is idle or executing host code.
+    if (m_arm_interface == nullptr) {
+        profiler.RecordActivity(m_core_index, m_activity);
+        return;
+    }
+
+    // Halt the CPU, the context is sampled once it has stopped.
+    m_sample_profiler = &profiler;
+    m_arm_interface->SignalInterrupt(m_current_thread);
+}
+
 void PhysicalCore::ClearInterrupt() {
     std::scoped_lock lk{m_guard};
     m_is_interrupted = false;
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <condition_variable>
 #include <cstddef>
 #include <memory>
@@ -19,8 +20,20 @@ class ExclusiveMonitor;
 class System;
 } // namespace Core
 
+namespace Tools {
+class GuestProfiler;
+}
+
 namespace Kernel {
 
+/// What a core is doing, as seen by the guest profiler
+enum class CoreActivity : u8 {
+    Host,
+    Guest,
+    SupervisorCall,
+    Idle,
+};
+
 class PhysicalCore {
 public:
     PhysicalCore(KernelCore& kernel, std::size_t core_index);
@@ -34,11 +47,11 @@ public:
 
     // Copy context from thread to current core.
     void LoadContext(const KThread* thread);
-    void LoadSvcArguments(const KProcess& process, std::span<const uint64_t, 8> args);
+    void LoadSvcArguments(const KProcess& process, std::span<const uint64_t, 8> args, u32 mask);
 
     // Copy context from current core to thread.
     void SaveContext(KThread* thread) const;
-    void SaveSvcArguments(KProcess& process, std::span<uint64_t, 8> args) const;
+    void SaveSvcArguments(KProcess& process, std::span<uint64_t, 8> args, u32 mask) const;
 
     // Copy floating point status registers to the target thread.
     void CloneFpuStatus(KThread* dst) const;
@@ -58,6 +71,10 @@ public:
     // Check if this core is interrupted.
     bool IsInterrupted() const;
 
+    // Record what this core is doing into the profiler.
+    // Guest execution is briefly halted so its context can be read.
+    void RequestSample(Tools::GuestProfiler& profiler);
+
     std::size_t CoreIndex() const {
         return m_core_index;
     }
@@ -70,6 +87,8 @@ private:
     std::condition_variable m_on_interrupt;
     Core::ArmInterface* m_arm_interface{};
     KThread* m_current_thread{};
+    Tools::GuestProfiler* m_sample_profiler{};
+    std::atomic<CoreActivity> m_activity{CoreActivity::Host};
     bool m_is_interrupted{};
     bool m_is_single_core{};
 };
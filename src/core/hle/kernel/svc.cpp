@@ -44,6 +44,12 @@ static To Convert(const From& from) {
     return to;
 }
 
+// Registers read and written by the wrapper of an SVC, only these are copied from and to the guest.
+struct RegisterMasks {
+    u32 inputs;
+    u32 outputs;
+};
+
 // clang-format off
 static_assert(sizeof(ArbitrationType) == 4);
 static_assert(sizeof(BreakReason) == 4);
@@ -4420,24 +4426,532 @@ static void Call64(Core::System& system, u32 imm, std::span<uint64_t, 8> args) {
         break;
     }
 }
+
+static RegisterMasks GetRegisterMasks32(u32 imm) {
+    switch (static_cast<SvcId>(imm)) {
+    case SvcId::SetHeapSize:
+        return {0x02, 0x03};
+    case SvcId::SetMemoryPermission:
+        return {0x07, 0x01};
+    case SvcId::SetMemoryAttribute:
+        return {0x0f, 0x01};
+    case SvcId::MapMemory:
+        return {0x07, 0x01};
+    case SvcId::UnmapMemory:
+        return {0x07, 0x01};
+    case SvcId::QueryMemory:
+        return {0x05, 0x03};
+    case SvcId::ExitProcess:
+        return {0x00, 0x00};
+    case SvcId::CreateThread:
+        return {0x1f, 0x03};
+    case SvcId::StartThread:
+        return {0x01, 0x01};
+    case SvcId::ExitThread:
+        return {0x00, 0x00};
+    case SvcId::SleepThread:
+        return {0x03, 0x00};
+    case SvcId::GetThreadPriority:
+        return {0x02, 0x03};
+    case SvcId::SetThreadPriority:
+        return {0x03, 0x01};
+    case SvcId::GetThreadCoreMask:
+        return {0x04, 0x0f};
+    case SvcId::SetThreadCoreMask:
+        return {0x0f, 0x01};
+    case SvcId::GetCurrentProcessorNumber:
+        return {0x00, 0x01};
+    case SvcId::SignalEvent:
+        return {0x01, 0x01};
+    case SvcId::ClearEvent:
+        return {0x01, 0x01};
+    case SvcId::MapSharedMemory:
+        return {0x0f, 0x01};
+    case SvcId::UnmapSharedMemory:
+        return {0x07, 0x01};
+    case SvcId::CreateTransferMemory:
+        return {0x0e, 0x03};
+    case SvcId::CloseHandle:
+        return {0x01, 0x01};
+    case SvcId::ResetSignal:
+        return {0x01, 0x01};
+    case SvcId::WaitSynchronization:
+        return {0x0f, 0x03};
+    case SvcId::CancelSynchronization:
+        return {0x01, 0x01};
+    case SvcId::ArbitrateLock:
+        return {0x07, 0x01};
+    case SvcId::ArbitrateUnlock:
+        return {0x01, 0x01};
+    case SvcId::WaitProcessWideKeyAtomic:
+        return {0x1f, 0x01};
+    case SvcId::SignalProcessWideKey:
+        return {0x03, 0x00};
+    case SvcId::GetSystemTick:
+        return {0x00, 0x03};
+    case SvcId::ConnectToNamedPort:
+        return {0x02, 0x03};
+    case SvcId::SendSyncRequestLight:
+        return {0xff, 0xff};
+    case SvcId::SendSyncRequest:
+        return {0x01, 0x01};
+    case SvcId::SendSyncRequestWithUserBuffer:
+        return {0x07, 0x01};
+    case SvcId::SendAsyncRequestWithUserBuffer:
+        return {0x0e, 0x03};
+    case SvcId::GetProcessId:
+        return {0x02, 0x07};
+    case SvcId::GetThreadId:
+        return {0x02, 0x07};
+    case SvcId::Break:
+        return {0x07, 0x00};
+    case SvcId::OutputDebugString:
+        return {0x03, 0x01};
+    case SvcId::ReturnFromException:
+        return {0x01, 0x00};
+    case SvcId::GetInfo:
+        return {0x0f, 0x07};
+    case SvcId::FlushEntireDataCache:
+        return {0x00, 0x00};
+    case SvcId::FlushDataCache:
+        return {0x03, 0x01};
+    case SvcId::MapPhysicalMemory:
+        return {0x03, 0x01};
+    case SvcId::UnmapPhysicalMemory:
+        return {0x03, 0x01};
+    case SvcId::GetDebugFutureThreadInfo:
+        return {0x07, 0x7f};
+    case SvcId::GetLastThreadInfo:
+        return {0x00, 0x7f};
+    case SvcId::GetResourceLimitLimitValue:
+        return {0x06, 0x07};
+    case SvcId::GetResourceLimitCurrentValue:
+        return {0x06, 0x07};
+    case SvcId::SetThreadActivity:
+        return {0x03, 0x01};
+    case SvcId::GetThreadContext3:
+        return {0x03, 0x01};
+    case SvcId::WaitForAddress:
+        return {0x1f, 0x01};
+    case SvcId::SignalToAddress:
+        return {0x0f, 0x01};
+    case SvcId::SynchronizePreemptionState:
+        return {0x00, 0x00};
+    case SvcId::GetResourceLimitPeakValue:
+        return {0x06, 0x07};
+    case SvcId::CreateIoPool:
+        return {0x02, 0x03};
+    case SvcId::CreateIoRegion:
+        return {0x3f, 0x03};
+    case SvcId::KernelDebug:
+        return {0x7f, 0x00};
+    case SvcId::ChangeKernelTraceState:
+        return {0x01, 0x00};
+    case SvcId::CreateSession:
+        return {0x0c, 0x07};
+    case SvcId::AcceptSession:
+        return {0x02, 0x03};
+    case SvcId::ReplyAndReceiveLight:
+        return {0xff, 0xff};
+    case SvcId::ReplyAndReceive:
+        return {0x1f, 0x03};
+    case SvcId::ReplyAndReceiveWithUserBuffer:
+        return {0x7f, 0x03};
+    case SvcId::CreateEvent:
+        return {0x00, 0x07};
+    case SvcId::MapIoRegion:
+        return {0x0f, 0x01};
+    case SvcId::UnmapIoRegion:
+        return {0x07, 0x01};
+    case SvcId::MapPhysicalMemoryUnsafe:
+        return {0x03, 0x01};
+    case SvcId::UnmapPhysicalMemoryUnsafe:
+        return {0x03, 0x01};
+    case SvcId::SetUnsafeLimit:
+        return {0x01, 0x01};
+    case SvcId::CreateCodeMemory:
+        return {0x06, 0x03};
+    case SvcId::ControlCodeMemory:
+        return {0x7f, 0x01};
+    case SvcId::SleepSystem:
+        return {0x00, 0x00};
+    case SvcId::ReadWriteRegister:
+        return {0x0f, 0x03};
+    case SvcId::SetProcessActivity:
+        return {0x03, 0x01};
+    case SvcId::CreateSharedMemory:
+        return {0x0e, 0x03};
+    case SvcId::MapTransferMemory:
+        return {0x0f, 0x01};
+    case SvcId::UnmapTransferMemory:
+        return {0x07, 0x01};
+    case SvcId::CreateInterruptEvent:
+        return {0x06, 0x03};
+    case SvcId::QueryPhysicalAddress:
+        return {0x02, 0x1f};
+    case SvcId::QueryIoMapping:
+        return {0x0d, 0x07};
+    case SvcId::CreateDeviceAddressSpace:
+        return {0x0f, 0x03};
+    case SvcId::AttachDeviceAddressSpace:
+        return {0x03, 0x01};
+    case SvcId::DetachDeviceAddressSpace:
+        return {0x03, 0x01};
+    case SvcId::MapDeviceAddressSpaceByForce:
+        return {0xff, 0x01};
+    case SvcId::MapDeviceAddressSpaceAligned:
+        return {0xff, 0x01};
+    case SvcId::UnmapDeviceAddressSpace:
+        return {0x7f, 0x01};
+    case SvcId::InvalidateProcessDataCache:
+        return {0x1f, 0x01};
+    case SvcId::StoreProcessDataCache:
+        return {0x1f, 0x01};
+    case SvcId::FlushProcessDataCache:
+        return {0x1f, 0x01};
+    case SvcId::DebugActiveProcess:
+        return {0x0c, 0x03};
+    case SvcId::BreakDebugProcess:
+        return {0x01, 0x01};
+    case SvcId::TerminateDebugProcess:
+        return {0x01, 0x01};
+    case SvcId::GetDebugEvent:
+        return {0x03, 0x01};
+    case SvcId::ContinueDebugEvent:
+        return {0x0f, 0x01};
+    case SvcId::GetProcessList:
+        return {0x06, 0x03};
+    case SvcId::GetThreadList:
+        return {0x0e, 0x03};
+    case SvcId::GetDebugThreadContext:
+        return {0x1f, 0x01};
+    case SvcId::SetDebugThreadContext:
+        return {0x1f, 0x01};
+    case SvcId::QueryDebugProcessMemory:
+        return {0x0d, 0x03};
+    case SvcId::ReadDebugProcessMemory:
+        return {0x0f, 0x01};
+    case SvcId::WriteDebugProcessMemory:
+        return {0x0f, 0x01};
+    case SvcId::SetHardwareBreakPoint:
+        return {0x1f, 0x01};
+    case SvcId::GetDebugThreadParam:
+        return {0x0f, 0x0f};
+    case SvcId::GetSystemInfo:
+        return {0x0f, 0x07};
+    case SvcId::CreatePort:
+        return {0x0d, 0x07};
+    case SvcId::ManageNamedPort:
+        return {0x06, 0x03};
+    case SvcId::ConnectToPort:
+        return {0x02, 0x03};
+    case SvcId::SetProcessMemoryPermission:
+        return {0x3f, 0x01};
+    case SvcId::MapProcessMemory:
+        return {0x1f, 0x01};
+    case SvcId::UnmapProcessMemory:
+        return {0x1f, 0x01};
+    case SvcId::QueryProcessMemory:
+        return {0x0f, 0x03};
+    case SvcId::MapProcessCodeMemory:
+        return {0x7f, 0x01};
+    case SvcId::UnmapProcessCodeMemory:
+        return {0x7f, 0x01};
+    case SvcId::CreateProcess:
+        return {0x0e, 0x03};
+    case SvcId::StartProcess:
+        return {0x1f, 0x01};
+    case SvcId::TerminateProcess:
+        return {0x01, 0x01};
+    case SvcId::GetProcessInfo:
+        return {0x06, 0x07};
+    case SvcId::CreateResourceLimit:
+        return {0x00, 0x03};
+    case SvcId::SetResourceLimitLimitValue:
+        return {0x0f, 0x01};
+    case SvcId::CallSecureMonitor:
+        return {0xff, 0xff};
+    case SvcId::MapInsecureMemory:
+        return {0x03, 0x01};
+    case SvcId::UnmapInsecureMemory:
+        return {0x03, 0x01};
+    default:
+        return {};
+    }
+}
+
+static RegisterMasks GetRegisterMasks64(u32 imm) {
+    switch (static_cast<SvcId>(imm)) {
+    case SvcId::SetHeapSize:
+        return {0x02, 0x03};
+    case SvcId::SetMemoryPermission:
+        return {0x07, 0x01};
+    case SvcId::SetMemoryAttribute:
+        return {0x0f, 0x01};
+    case SvcId::MapMemory:
+        return {0x07, 0x01};
+    case SvcId::UnmapMemory:
+        return {0x07, 0x01};
+    case SvcId::QueryMemory:
+        return {0x05, 0x03};
+    case SvcId::ExitProcess:
+        return {0x00, 0x00};
+    case SvcId::CreateThread:
+        return {0x3e, 0x03};
+    case SvcId::StartThread:
+        return {0x01, 0x01};
+    case SvcId::ExitThread:
+        return {0x00, 0x00};
+    case SvcId::SleepThread:
+        return {0x01, 0x00};
+    case SvcId::GetThreadPriority:
+        return {0x02, 0x03};
+    case SvcId::SetThreadPriority:
+        return {0x03, 0x01};
+    case SvcId::GetThreadCoreMask:
+        return {0x04, 0x07};
+    case SvcId::SetThreadCoreMask:
+        return {0x07, 0x01};
+    case SvcId::GetCurrentProcessorNumber:
+        return {0x00, 0x01};
+    case SvcId::SignalEvent:
+        return {0x01, 0x01};
+    case SvcId::ClearEvent:
+        return {0x01, 0x01};
+    case SvcId::MapSharedMemory:
+        return {0x0f, 0x01};
+    case SvcId::UnmapSharedMemory:
+        return {0x07, 0x01};
+    case SvcId::CreateTransferMemory:
+        return {0x0e, 0x03};
+    case SvcId::CloseHandle:
+        return {0x01, 0x01};
+    case SvcId::ResetSignal:
+        return {0x01, 0x01};
+    case SvcId::WaitSynchronization:
+        return {0x0e, 0x03};
+    case SvcId::CancelSynchronization:
+        return {0x01, 0x01};
+    case SvcId::ArbitrateLock:
+        return {0x07, 0x01};
+    case SvcId::ArbitrateUnlock:
+        return {0x01, 0x01};
+    case SvcId::WaitProcessWideKeyAtomic:
+        return {0x0f, 0x01};
+    case SvcId::SignalProcessWideKey:
+        return {0x03, 0x00};
+    case SvcId::GetSystemTick:
+        return {0x00, 0x01};
+    case SvcId::ConnectToNamedPort:
+        return {0x02, 0x03};
+    case SvcId::SendSyncRequestLight:
+        return {0xff, 0xff};
+    case SvcId::SendSyncRequest:
+        return {0x01, 0x01};
+    case SvcId::SendSyncRequestWithUserBuffer:
+        return {0x07, 0x01};
+    case SvcId::SendAsyncRequestWithUserBuffer:
+        return {0x0e, 0x03};
+    case SvcId::GetProcessId:
+        return {0x02, 0x03};
+    case SvcId::GetThreadId:
+        return {0x02, 0x03};
+    case SvcId::Break:
+        return {0x07, 0x00};
+    case SvcId::OutputDebugString:
+        return {0x03, 0x01};
+    case SvcId::ReturnFromException:
+        return {0x01, 0x00};
+    case SvcId::GetInfo:
+        return {0x0e, 0x03};
+    case SvcId::FlushEntireDataCache:
+        return {0x00, 0x00};
+    case SvcId::FlushDataCache:
+        return {0x03, 0x01};
+    case SvcId::MapPhysicalMemory:
+        return {0x03, 0x01};
+    case SvcId::UnmapPhysicalMemory:
+        return {0x03, 0x01};
+    case SvcId::GetDebugFutureThreadInfo:
+        return {0x0c, 0x3f};
+    case SvcId::GetLastThreadInfo:
+        return {0x00, 0x7f};
+    case SvcId::GetResourceLimitLimitValue:
+        return {0x06, 0x03};
+    case SvcId::GetResourceLimitCurrentValue:
+        return {0x06, 0x03};
+    case SvcId::SetThreadActivity:
+        return {0x03, 0x01};
+    case SvcId::GetThreadContext3:
+        return {0x03, 0x01};
+    case SvcId::WaitForAddress:
+        return {0x0f, 0x01};
+    case SvcId::SignalToAddress:
+        return {0x0f, 0x01};
+    case SvcId::SynchronizePreemptionState:
+        return {0x00, 0x00};
+    case SvcId::GetResourceLimitPeakValue:
+        return {0x06, 0x03};
+    case SvcId::CreateIoPool:
+        return {0x02, 0x03};
+    case SvcId::CreateIoRegion:
+        return {0x3e, 0x03};
+    case SvcId::KernelDebug:
+        return {0x0f, 0x00};
+    case SvcId::ChangeKernelTraceState:
+        return {0x01, 0x00};
+    case SvcId::CreateSession:
+        return {0x0c, 0x07};
+    case SvcId::AcceptSession:
+        return {0x02, 0x03};
+    case SvcId::ReplyAndReceiveLight:
+        return {0xff, 0xff};
+    case SvcId::ReplyAndReceive:
+        return {0x1e, 0x03};
+    case SvcId::ReplyAndReceiveWithUserBuffer:
+        return {0x7e, 0x03};
+    case SvcId::CreateEvent:
+        return {0x00, 0x07};
+    case SvcId::MapIoRegion:
+        return {0x0f, 0x01};
+    case SvcId::UnmapIoRegion:
+        return {0x07, 0x01};
+    case SvcId::MapPhysicalMemoryUnsafe:
+        return {0x03, 0x01};
+    case SvcId::UnmapPhysicalMemoryUnsafe:
+        return {0x03, 0x01};
+    case SvcId::SetUnsafeLimit:
+        return {0x01, 0x01};
+    case SvcId::CreateCodeMemory:
+        return {0x06, 0x03};
+    case SvcId::ControlCodeMemory:
+        return {0x1f, 0x01};
+    case SvcId::SleepSystem:
+        return {0x00, 0x00};
+    case SvcId::ReadWriteRegister:
+        return {0x0e, 0x03};
+    case SvcId::SetProcessActivity:
+        return {0x03, 0x01};
+    case SvcId::CreateSharedMemory:
+        return {0x0e, 0x03};
+    case SvcId::MapTransferMemory:
+        return {0x0f, 0x01};
+    case SvcId::UnmapTransferMemory:
+        return {0x07, 0x01};
+    case SvcId::CreateInterruptEvent:
+        return {0x06, 0x03};
+    case SvcId::QueryPhysicalAddress:
+        return {0x02, 0x0f};
+    case SvcId::QueryIoMapping:
+        return {0x0c, 0x07};
+    case SvcId::CreateDeviceAddressSpace:
+        return {0x06, 0x03};
+    case SvcId::AttachDeviceAddressSpace:
+        return {0x03, 0x01};
+    case SvcId::DetachDeviceAddressSpace:
+        return {0x03, 0x01};
+    case SvcId::MapDeviceAddressSpaceByForce:
+        return {0x3f, 0x01};
+    case SvcId::MapDeviceAddressSpaceAligned:
+        return {0x3f, 0x01};
+    case SvcId::UnmapDeviceAddressSpace:
+        return {0x1f, 0x01};
+    case SvcId::InvalidateProcessDataCache:
+        return {0x07, 0x01};
+    case SvcId::StoreProcessDataCache:
+        return {0x07, 0x01};
+    case SvcId::FlushProcessDataCache:
+        return {0x07, 0x01};
+    case SvcId::DebugActiveProcess:
+        return {0x02, 0x03};
+    case SvcId::BreakDebugProcess:
+        return {0x01, 0x01};
+    case SvcId::TerminateDebugProcess:
+        return {0x01, 0x01};
+    case SvcId::GetDebugEvent:
+        return {0x03, 0x01};
+    case SvcId::ContinueDebugEvent:
+        return {0x0f, 0x01};
+    case SvcId::GetProcessList:
+        return {0x06, 0x03};
+    case SvcId::GetThreadList:
+        return {0x0e, 0x03};
+    case SvcId::GetDebugThreadContext:
+        return {0x0f, 0x01};
+    case SvcId::SetDebugThreadContext:
+        return {0x0f, 0x01};
+    case SvcId::QueryDebugProcessMemory:
+        return {0x0d, 0x03};
+    case SvcId::ReadDebugProcessMemory:
+        return {0x0f, 0x01};
+    case SvcId::WriteDebugProcessMemory:
+        return {0x0f, 0x01};
+    case SvcId::SetHardwareBreakPoint:
+        return {0x07, 0x01};
+    case SvcId::GetDebugThreadParam:
+        return {0x1c, 0x07};
+    case SvcId::GetSystemInfo:
+        return {0x0e, 0x03};
+    case SvcId::CreatePort:
+        return {0x1c, 0x07};
+    case SvcId::ManageNamedPort:
+        return {0x06, 0x03};
+    case SvcId::ConnectToPort:
+        return {0x02, 0x03};
+    case SvcId::SetProcessMemoryPermission:
+        return {0x0f, 0x01};
+    case SvcId::MapProcessMemory:
+        return {0x0f, 0x01};
+    case SvcId::UnmapProcessMemory:
+        return {0x0f, 0x01};
+    case SvcId::QueryProcessMemory:
+        return {0x0d, 0x03};
+    case SvcId::MapProcessCodeMemory:
+        return {0x0f, 0x01};
+    case SvcId::UnmapProcessCodeMemory:
+        return {0x0f, 0x01};
+    case SvcId::CreateProcess:
+        return {0x0e, 0x03};
+    case SvcId::StartProcess:
+        return {0x0f, 0x01};
+    case SvcId::TerminateProcess:
+        return {0x01, 0x01};
+    case SvcId::GetProcessInfo:
+        return {0x06, 0x03};
+    case SvcId::CreateResourceLimit:
+        return {0x00, 0x03};
+    case SvcId::SetResourceLimitLimitValue:
+        return {0x07, 0x01};
+    case SvcId::CallSecureMonitor:
+        return {0xff, 0xff};
+    case SvcId::MapInsecureMemory:
+        return {0x03, 0x01};
+    case SvcId::UnmapInsecureMemory:
+        return {0x03, 0x01};
+    default:
+        return {};
+    }
+}
 // clang-format on
 
 void Call(Core::System& system, u32 imm) {
     auto& kernel = system.Kernel();
     auto& process = GetCurrentProcess(kernel);
+    const bool is_64_bit = process.Is64Bit();
+    const RegisterMasks masks = is_64_bit ? GetRegisterMasks64(imm) : GetRegisterMasks32(imm);
 
-    std::array<uint64_t, 8> args;
-    kernel.CurrentPhysicalCore().SaveSvcArguments(process, args);
+    std::array<uint64_t, 8> args{};
+    kernel.CurrentPhysicalCore().SaveSvcArguments(process, args, masks.inputs);
     kernel.EnterSVCProfile();
 
-    if (process.Is64Bit()) {
+    if (is_64_bit) {
         Call64(system, imm, args);
     } else {
         Call32(system, imm, args);
     }
 
     kernel.ExitSVCProfile();
-    kernel.CurrentPhysicalCore().LoadSvcArguments(process, args);
+    kernel.CurrentPhysicalCore().LoadSvcArguments(process, args, masks.outputs);
 }
 
 } // namespace Kernel::Svc
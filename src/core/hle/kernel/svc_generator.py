@@ -429,6 +429,26 @@ def emit_lines(lines, indent='    '):
     return "\n".join(output_lines)
 
 
+# Computes the masks of the registers a wrapper reads and writes.
+def get_register_masks(register_info):
+    return_write, output_writes, input_reads = register_info
+
+    inputs = 0
+    for _, _, sources in input_reads:
+        for s in sources:
+            inputs |= 1 << s
+
+    outputs = 0
+    for _, destinations in return_write:
+        for d in destinations:
+            outputs |= 1 << d
+    for _, _, destinations, _ in output_writes:
+        for d in destinations:
+            outputs |= 1 << d
+
+    return (inputs, outputs)
+
+
 # Emit a C++ function to wrap a guest SVC.
 def emit_wrapper(wrapped_fn, suffix, register_info, arguments, byte_size):
     return_write, output_writes, input_reads = register_info
@@ -584,6 +604,12 @@ static To Convert(const From& from) {
     return to;
 }
 
+// Registers read and written by the wrapper of an SVC, only these are copied from and to the guest.
+struct RegisterMasks {
+    u32 inputs;
+    u32 outputs;
+};
+
 // clang-format off
 """
 
@@ -593,19 +619,21 @@ EPILOGUE_CPP = """
 void Call(Core::System& system, u32 imm) {
     auto& kernel = system.Kernel();
     auto& process = GetCurrentProcess(kernel);
+    const bool is_64_bit = process.Is64Bit();
+    const RegisterMasks masks = is_64_bit ? GetRegisterMasks64(imm) : GetRegisterMasks32(imm);
 
-    std::array<uint64_t, 8> args;
-    kernel.CurrentPhysicalCore().SaveSvcArguments(process, args);
+    std::array<uint64_t, 8> args{};
+    kernel.CurrentPhysicalCore().SaveSvcArguments(process, args, masks.inputs);
     kernel.EnterSVCProfile();
 
-    if (process.Is64Bit()) {
+    if (is_64_bit) {
         Call64(system, imm, args);
     } else {
         Call32(system, imm, args);
     }
 
     kernel.ExitSVCProfile();
-    kernel.CurrentPhysicalCore().LoadSvcArguments(process, args);
+    kernel.CurrentPhysicalCore().LoadSvcArguments(process, args, masks.outputs);
 }
 
 } // namespace Kernel::Svc
@@ -634,6 +662,27 @@ def emit_call(bitness, names, suffix):
     return "\n".join(lines)
 
 
+def emit_register_masks(bitness, names, masks):
+    bit_size = REG_SIZES[bitness]*8
+    indent = "    "
+    lines = [
+        f"static RegisterMasks GetRegisterMasks{bit_size}(u32 imm) {{",
+        f"{indent}switch (static_cast<SvcId>(imm)) {{"
+    ]
+
+    for imm, name in names:
+        inputs, outputs = masks[bitness][imm]
+        lines.append(f"{indent}case SvcId::{name}:")
+        lines.append(f"{indent*2}return {{{inputs:#04x}, {outputs:#04x}}};")
+
+    lines.append(f"{indent}default:")
+    lines.append(f"{indent*2}return {{}};")
+    lines.append(f"{indent}}}")
+    lines.append("}")
+
+    return "\n".join(lines)
+
+
 def build_fn_declaration(return_type, name, arguments):
     arg_list = ["Core::System& system"]
     for arg in arguments:
@@ -661,6 +710,7 @@ def main():
     svc_fw_declarations = []
     wrapper_fns = []
     names = []
+    masks = [{}, {}]
 
     for imm, decl in SVCS:
         return_type, name, arguments = parse_declaration(decl, BIT_64)
@@ -677,12 +727,15 @@ def main():
 
         for imm, decl in SVCS:
             if imm in SKIP_WRAPPERS:
+                # Custom ABI wrappers may use all of the registers
+                masks[bitness][imm] = (0xff, 0xff)
                 continue
 
             parse_result = parse_declaration(decl, bitness)
             return_type, name, arguments = parse_result
 
             register_info = get_registers(parse_result, bitness)
+            masks[bitness][imm] = get_register_masks(register_info)
             wrapper_fns.append(
                 emit_wrapper(name, suffix, register_info, arguments, byte_size))
             arch_fw_declarations[bitness].append(
@@ -690,6 +743,8 @@ def main():
 
     call_32 = emit_call(BIT_32, names, SUFFIX_NAMES[BIT_32])
     call_64 = emit_call(BIT_64, names, SUFFIX_NAMES[BIT_64])
+    masks_32 = emit_register_masks(BIT_32, names, masks)
+    masks_64 = emit_register_masks(BIT_64, names, masks)
     enum_decls = build_enum_declarations()
 
     with open("svc.h", "w") as f:
@@ -714,6 +769,10 @@ def main():
         f.write(call_32)
         f.write("\n\n")
         f.write(call_64)
+        f.write("\n\n")
+        f.write(masks_32)
+        f.write("\n\n")
+        f.write(masks_64)
         f.write(EPILOGUE_CPP)
 
     print(f"Done (emitted {len(names)} definitions)")
@@ -1,6 +1,7 @@
 // SPDX-FileCopyrightText: Copyright 2018 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include "audio_core/adsp/apps/opus/opus_decoder.h"
 #include "core/core.h"
 #include "core/hle/service/audio/audio.h"
 #include "core/hle/service/audio/audio_controller.h"
@@ -27,8 +28,17 @@ void LoopProcess(Core::System& system) {
                                          std::make_shared<IFinalOutputRecorderManager>(system));
     server_manager->RegisterNamedService("audren:u",
                                          std::make_shared<IAudioRendererManager>(system));
+    ServerManager::RunServer(std::move(server_manager));
+}
+
+void OpusLoopProcess(Core::System& system) {
+    auto server_manager = std::make_unique<ServerManager>(system);
+
     server_manager->RegisterNamedService("hwopus",
                                          std::make_shared<IHardwareOpusDecoderManager>(system));
+    // One thread per DSP decode lane, so sessions can decode concurrently
+    server_manager->StartAdditionalHostThreads("hwopus",
+                                               AudioCore::ADSP::OpusDecoder::DecodeLaneCount - 1);
     ServerManager::RunServer(std::move(server_manager));
 }
 
@@ -15,4 +15,7 @@ namespace Service::Audio {
 
 void LoopProcess(Core::System& system);
 
+/// Runs the hwopus service, separately from the other audio services so it can use more threads
+void OpusLoopProcess(Core::System& system);
+
 } // namespace Service::Audio
@@ -338,16 +338,32 @@ void ReadInArgument(bool is_domain, CallArguments& args, const u8* raw_data, HLE
         } else if constexpr (ArgumentTraits<ArgType>::Type == ArgumentType::OutBuffer) {
             using ElementType = typename ArgType::Type;
 
-            // Set up scratch buffer.
-            auto& buffer = temp[OutBufferIndex];
+            // Let the handler write straight into guest memory when it is plain memory.
+            std::span<u8> direct{};
             if (ctx.CanWriteBuffer(OutBufferIndex)) {
+                if constexpr (ArgType::Attr & BufferAttr_HipcAutoSelect) {
+                    direct = ctx.WriteBufferDirect(OutBufferIndex);
+                } else if constexpr (ArgType::Attr & BufferAttr_HipcMapAlias) {
+                    direct = ctx.WriteBufferDirectB(OutBufferIndex);
+                } else /* if (ArgType::Attr & BufferAttr_HipcPointer) */ {
+                    direct = ctx.WriteBufferDirectC(OutBufferIndex);
+                }
+                if (direct.size() != ctx.GetWriteBufferSize(OutBufferIndex) ||
+                    reinterpret_cast<uintptr_t>(direct.data()) % alignof(ElementType) != 0) {
+                    direct = {};
+                }
+            }
+
+            // Set up scratch buffer otherwise, an empty one is not written back.
+            auto& buffer = temp[OutBufferIndex];
+            if (direct.empty() && ctx.CanWriteBuffer(OutBufferIndex)) {
                 buffer.resize_destructive(ctx.GetWriteBufferSize(OutBufferIndex));
             } else {
                 buffer.resize_destructive(0);
             }
 
-            ElementType* ptr = (ElementType*) buffer.data();
-            size_t size = buffer.size() / sizeof(ElementType);
+            ElementType* ptr = (ElementType*) (direct.empty() ? buffer.data() : direct.data());
+            size_t size = (direct.empty() ? buffer.size() : direct.size()) / sizeof(ElementType);
 
             std::get<ArgIndex>(args) = std::span(ptr, size);
 
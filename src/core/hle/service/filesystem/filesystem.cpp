@@ -19,6 +19,7 @@
 #include "core/file_sys/sdmc_factory.h"
 #include "core/file_sys/vfs/vfs.h"
 #include "core/file_sys/vfs/vfs_offset.h"
+#include "core/file_sys/vfs/vfs_write_back.h"
 #include "core/hle/service/filesystem/filesystem.h"
 #include "core/hle/service/filesystem/fsp/fsp_ldr.h"
 #include "core/hle/service/filesystem/fsp/fsp_pr.h"
@@ -291,6 +292,14 @@ Result VfsDirectoryServiceWrapper::GetFileTimeStampRaw(
     return ResultSuccess;
 }
 
+Result VfsDirectoryServiceWrapper::Commit() const {
+    const auto write_back = std::dynamic_pointer_cast<FileSys::WriteBackVfsDirectory>(backing);
+    if (write_back != nullptr) {
+        write_back->Commit();
+    }
+    return ResultSuccess;
+}
+
 FileSystemController::FileSystemController(Core::System& system_) : system{system_} {}
 
 FileSystemController::~FileSystemController() = default;
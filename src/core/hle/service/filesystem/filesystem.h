@@ -253,6 +253,12 @@ public:
     Result GetFileTimeStampRaw(FileSys::FileTimeStampRaw* out_time_stamp_raw,
                                const std::string& path) const;
 
+    /**
+     * Commit the changes made to the archive, when it buffers them
+     * @return Result of the operation
+     */
+    Result Commit() const;
+
 private:
     FileSys::VirtualDir backing;
 };
@@ -4,12 +4,14 @@
 #pragma once
 
 #include <functional>
+#include <mutex>
 #include <string>
 
 #include "common/common_types.h"
 #include "core/file_sys/vfs/vfs_types.h"
 #include "core/hle/service/glue/time/file_timestamp_worker.h"
 #include "core/hle/service/glue/time/standard_steady_clock_resource.h"
+#include "core/hle/service/glue/time/time_zone_binary.h"
 #include "core/hle/service/glue/time/worker.h"
 #include "core/hle/service/service.h"
 
@@ -35,6 +37,12 @@ public:
     StandardSteadyClockResource m_steady_clock_resource;
     FileTimestampWorker m_file_timestamp_worker;
     TimeWorker m_worker;
+    TimeZoneBinary m_time_zone_binary;
+
+    /// Guards the time zone binary and the operation events of the time zone services
+    std::mutex m_time_zone_mutex;
+    /// Operation events of the time zone services, signaled when the device location changes
+    Service::PSC::Time::OperationEvent::OperationEventList m_time_zone_operation_events;
 
 private:
     Result SetupStandardSteadyClockCore();
@@ -27,6 +27,7 @@ class ServiceManager;
 
 namespace Service::Glue::Time {
 class FileTimestampWorker;
+class TimeManager;
 class StandardSteadyClockResource;
 
 class StaticService final : public ServiceFramework<StaticService> {
@@ -78,7 +79,7 @@ private:
     Service::PSC::Time::StaticServiceSetupInfo m_setup_info;
     std::shared_ptr<Service::PSC::Time::StaticService> m_time_sm;
     std::shared_ptr<Service::PSC::Time::TimeZoneService> m_time_zone;
-    FileTimestampWorker& m_file_timestamp_worker;
+    std::shared_ptr<TimeManager> m_time_manager;
     StandardSteadyClockResource& m_standard_steady_clock_resource;
 };
 } // namespace Service::Glue::Time
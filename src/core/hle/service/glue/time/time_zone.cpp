@@ -8,6 +8,7 @@
 #include "core/hle/kernel/svc.h"
 #include "core/hle/service/cmif_serialization.h"
 #include "core/hle/service/glue/time/file_timestamp_worker.h"
+#include "core/hle/service/glue/time/manager.h"
 #include "core/hle/service/glue/time/time_zone.h"
 #include "core/hle/service/glue/time/time_zone_binary.h"
 #include "core/hle/service/psc/time/time_zone_service.h"
@@ -15,19 +16,15 @@
 #include "core/hle/service/sm/sm.h"
 
 namespace Service::Glue::Time {
-namespace {
-static std::mutex g_list_mutex;
-static Common::IntrusiveListBaseTraits<Service::PSC::Time::OperationEvent>::ListType g_list_nodes{};
-} // namespace
 
 TimeZoneService::TimeZoneService(
-    Core::System& system_, FileTimestampWorker& file_timestamp_worker,
+    Core::System& system_, std::shared_ptr<TimeManager> time_manager,
     bool can_write_timezone_device_location,
     std::shared_ptr<Service::PSC::Time::TimeZoneService> time_zone_service)
     : ServiceFramework{system_, "ITimeZoneService"}, m_system{system},
       m_can_write_timezone_device_location{can_write_timezone_device_location},
-      m_file_timestamp_worker{file_timestamp_worker},
-      m_wrapped_service{std::move(time_zone_service)}, m_operation_event{m_system} {
+      m_time_manager{std::move(time_manager)}, m_wrapped_service{std::move(time_zone_service)},
+      m_operation_event{m_system} {
     // clang-format off
     static const FunctionInfo functions[] = {
         {0,   D<&TimeZoneService::GetDeviceLocationName>, "GetDeviceLocationName"},
@@ -48,12 +45,17 @@ TimeZoneService::TimeZoneService(
     // clang-format on
     RegisterHandlers(functions);
 
-    g_list_nodes.clear();
     m_set_sys =
         m_system.ServiceManager().GetService<Service::Set::ISystemSettingsServer>("set:sys", true);
 }
 
-TimeZoneService::~TimeZoneService() = default;
+TimeZoneService::~TimeZoneService() {
+    if (operation_event_initialized) {
+        std::scoped_lock l{m_time_manager->m_time_zone_mutex};
+        auto& events{m_time_manager->m_time_zone_operation_events};
+        events.erase(events.iterator_to(m_operation_event));
+    }
+}
 
 Result TimeZoneService::GetDeviceLocationName(
     Out<Service::PSC::Time::LocationName> out_location_name) {
@@ -69,17 +71,18 @@ Result TimeZoneService::SetDeviceLocationName(
     LOG_DEBUG(Service_Time, "called. location_name={}", location_name);
 
     R_UNLESS(m_can_write_timezone_device_location, Service::PSC::Time::ResultPermissionDenied);
-    R_UNLESS(IsTimeZoneBinaryValid(location_name), Service::PSC::Time::ResultTimeZoneNotFound);
 
-    std::scoped_lock l{m_mutex};
+    std::scoped_lock l{m_time_manager->m_time_zone_mutex};
+    auto& time_zone_binary{m_time_manager->m_time_zone_binary};
+    R_UNLESS(time_zone_binary.IsValid(location_name), Service::PSC::Time::ResultTimeZoneNotFound);
 
     std::span<const u8> binary{};
     size_t binary_size{};
-    R_TRY(GetTimeZoneRule(binary, binary_size, location_name))
+    R_TRY(time_zone_binary.GetRule(binary, binary_size, location_name))
 
     R_TRY(m_wrapped_service->SetDeviceLocationNameWithTimeZoneRule(location_name, binary));
 
-    m_file_timestamp_worker.SetFilesystemPosixTime();
+    m_time_manager->m_file_timestamp_worker.SetFilesystemPosixTime();
 
     Service::PSC::Time::SteadyClockTimePoint time_point{};
     Service::PSC::Time::LocationName name{};
@@ -88,8 +91,7 @@ Result TimeZoneService::SetDeviceLocationName(
     m_set_sys->SetDeviceTimeZoneLocationName(name);
     m_set_sys->SetDeviceTimeZoneLocationUpdatedTime(time_point);
 
-    std::scoped_lock m{g_list_mutex};
-    for (auto& operation_event : g_list_nodes) {
+    for (auto& operation_event : m_time_manager->m_time_zone_operation_events) {
         operation_event.m_event->Signal();
     }
     R_SUCCEED();
@@ -111,18 +113,19 @@ Result TimeZoneService::LoadLocationNameList(
                   index, *out_count, out_names[0], out_names[1]);
     };
 
-    std::scoped_lock l{m_mutex};
-    R_RETURN(GetTimeZoneLocationList(*out_count, out_names, out_names.size(), index));
+    std::scoped_lock l{m_time_manager->m_time_zone_mutex};
+    R_RETURN(m_time_manager->m_time_zone_binary.GetLocationList(*out_count, out_names,
+                                                                out_names.size(), index));
 }
 
 Result TimeZoneService::LoadTimeZoneRule(OutRule out_rule,
                                          const Service::PSC::Time::LocationName& name) {
     LOG_DEBUG(Service_Time, "called. name={}", name);
 
-    std::scoped_lock l{m_mutex};
+    std::scoped_lock l{m_time_manager->m_time_zone_mutex};
     std::span<const u8> binary{};
     size_t binary_size{};
-    R_TRY(GetTimeZoneRule(binary, binary_size, name))
+    R_TRY(m_time_manager->m_time_zone_binary.GetRule(binary, binary_size, name))
     R_RETURN(m_wrapped_service->ParseTimeZoneBinary(out_rule, binary));
 }
 
@@ -173,8 +176,8 @@ Result TimeZoneService::GetDeviceLocationNameOperationEventReadableHandle(
         m_operation_event.m_event =
             m_operation_event.m_ctx.CreateEvent("Psc:TimeZoneService:OperationEvent");
         operation_event_initialized = true;
-        std::scoped_lock l{m_mutex};
-        g_list_nodes.push_back(m_operation_event);
+        std::scoped_lock l{m_time_manager->m_time_zone_mutex};
+        m_time_manager->m_time_zone_operation_events.push_back(m_operation_event);
     }
 
     *out_event = &m_operation_event.m_event->GetReadableEvent();
@@ -4,7 +4,6 @@
 #pragma once
 
 #include <memory>
-#include <mutex>
 #include <span>
 #include <vector>
 
@@ -31,7 +30,7 @@ class TimeZoneService;
 }
 
 namespace Service::Glue::Time {
-class FileTimestampWorker;
+class TimeManager;
 
 class TimeZoneService final : public ServiceFramework<TimeZoneService> {
     using InRule = InLargeData<Tz::Rule, BufferAttr_HipcMapAlias>;
@@ -39,7 +38,7 @@ class TimeZoneService final : public ServiceFramework<TimeZoneService> {
 
 public:
     explicit TimeZoneService(
-        Core::System& system, FileTimestampWorker& file_timestamp_worker,
+        Core::System& system, std::shared_ptr<TimeManager> time_manager,
         bool can_write_timezone_device_location,
         std::shared_ptr<Service::PSC::Time::TimeZoneService> time_zone_service);
 
@@ -80,9 +79,8 @@ private:
     std::shared_ptr<Service::Set::ISystemSettingsServer> m_set_sys;
 
     bool m_can_write_timezone_device_location;
-    FileTimestampWorker& m_file_timestamp_worker;
+    std::shared_ptr<TimeManager> m_time_manager;
     std::shared_ptr<Service::PSC::Time::TimeZoneService> m_wrapped_service;
-    std::mutex m_mutex;
     bool operation_event_initialized{};
     Service::PSC::Time::OperationEvent m_operation_event;
 };
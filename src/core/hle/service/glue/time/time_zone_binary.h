@@ -6,7 +6,9 @@
 #include <span>
 #include <string>
 #include <string_view>
+#include <vector>
 
+#include "core/file_sys/vfs/vfs_types.h"
 #include "core/hle/service/psc/time/common.h"
 
 namespace Core {
@@ -15,18 +17,35 @@ class System;
 
 namespace Service::Glue::Time {
 
-void ResetTimeZoneBinary();
-Result MountTimeZoneBinary(Core::System& system);
-void GetTimeZoneBinaryListPath(std::string& out_path);
-void GetTimeZoneBinaryVersionPath(std::string& out_path);
-void GetTimeZoneZonePath(std::string& out_path, const Service::PSC::Time::LocationName& name);
-bool IsTimeZoneBinaryValid(const Service::PSC::Time::LocationName& name);
-u32 GetTimeZoneCount();
-Result GetTimeZoneVersion(Service::PSC::Time::RuleVersion& out_rule_version);
-Result GetTimeZoneRule(std::span<const u8>& out_rule, size_t& out_rule_size,
-                       const Service::PSC::Time::LocationName& name);
-Result GetTimeZoneLocationList(u32& out_count,
-                               std::span<Service::PSC::Time::LocationName> out_names,
-                               size_t max_names, u32 index);
+/**
+ * The time zone binary system archive, mounted by the time manager of each system. Rules read from
+ * it are returned in a scratch buffer owned by the binary.
+ */
+class TimeZoneBinary {
+public:
+    TimeZoneBinary();
+    ~TimeZoneBinary();
+
+    void Reset();
+    Result Mount(Core::System& system);
+    bool IsValid(const Service::PSC::Time::LocationName& name);
+    u32 GetCount();
+    Result GetVersion(Service::PSC::Time::RuleVersion& out_rule_version);
+    Result GetRule(std::span<const u8>& out_rule, size_t& out_rule_size,
+                   const Service::PSC::Time::LocationName& name);
+    Result GetLocationList(u32& out_count, std::span<Service::PSC::Time::LocationName> out_names,
+                           size_t max_names, u32 index);
+
+private:
+    Result ReadBinary(size_t& out_read_size, std::span<u8> out_buffer, size_t out_buffer_size,
+                      std::string_view path);
+    void GetListPath(std::string& out_path) const;
+    void GetVersionPath(std::string& out_path) const;
+    void GetZonePath(std::string& out_path, const Service::PSC::Time::LocationName& name) const;
+
+    FileSys::VirtualDir m_romfs{};
+    Result m_mount_result{ResultUnknown};
+    std::vector<u8> m_scratch_space;
+};
 
 } // namespace Service::Glue::Time
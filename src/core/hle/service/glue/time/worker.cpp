@@ -18,11 +18,6 @@
 namespace Service::Glue::Time {
 namespace {
 
-bool g_ig_report_network_clock_context_set{};
-Service::PSC::Time::SystemClockContext g_report_network_clock_context{};
-bool g_ig_report_ephemeral_clock_context_set{};
-Service::PSC::Time::SystemClockContext g_report_ephemeral_clock_context{};
-
 template <typename T>
 T GetSettingsItemValue(std::shared_ptr<Service::Set::ISystemSettingsServer>& set_sys,
                        const char* category, const char* name) {
@@ -43,11 +38,6 @@ TimeWorker::TimeWorker(Core::System& system, StandardSteadyClockResource& steady
                                                           "Glue:TimeWorker:SteadyClockTimerEvent")},
       m_timer_file_system{m_ctx.CreateEvent("Glue:TimeWorker:FileTimeTimerEvent")},
       m_alarm_worker{m_system, m_steady_clock_resource}, m_pm_state_change_handler{m_alarm_worker} {
-    g_ig_report_network_clock_context_set = false;
-    g_report_network_clock_context = {};
-    g_ig_report_ephemeral_clock_context_set = false;
-    g_report_ephemeral_clock_context = {};
-
     m_timer_steady_clock_timing_event = Core::Timing::CreateEvent(
         "Time::SteadyClockEvent",
         [this](s64 time,
@@ -218,14 +208,14 @@ void TimeWorker::ThreadFunc(std::stop_token stop_token) {
             }
 
             [[maybe_unused]] auto offset_before{
-                g_ig_report_network_clock_context_set ? g_report_network_clock_context.offset : 0};
+                m_report_network_clock_context_set ? m_report_network_clock_context.offset : 0};
             // TODO system report "standard_netclock_operation"
             //              "clock_time" = time
             //              "context_offset_before" = offset_before
             //              "context_offset_after"  = context.offset
-            g_report_network_clock_context = context;
-            if (!g_ig_report_network_clock_context_set) {
-                g_ig_report_network_clock_context_set = true;
+            m_report_network_clock_context = context;
+            if (!m_report_network_clock_context_set) {
+                m_report_network_clock_context_set = true;
             }
 
             m_file_timestamp_worker.SetFilesystemPosixTime();
@@ -247,16 +237,16 @@ void TimeWorker::ThreadFunc(std::stop_token stop_token) {
                 break;
             }
 
-            [[maybe_unused]] auto offset_before{g_ig_report_ephemeral_clock_context_set
-                                                    ? g_report_ephemeral_clock_context.offset
+            [[maybe_unused]] auto offset_before{m_report_ephemeral_clock_context_set
+                                                    ? m_report_ephemeral_clock_context.offset
                                                     : 0};
             // TODO system report "ephemeral_netclock_operation"
             //              "clock_time" = time
             //              "context_offset_before" = offset_before
             //              "context_offset_after"  = context.offset
-            g_report_ephemeral_clock_context = context;
-            if (!g_ig_report_ephemeral_clock_context_set) {
-                g_ig_report_ephemeral_clock_context_set = true;
+            m_report_ephemeral_clock_context = context;
+            if (!m_report_ephemeral_clock_context_set) {
+                m_report_ephemeral_clock_context_set = true;
             }
             break;
         }
@@ -450,6 +450,49 @@ std::size_t HLERequestContext::WriteBufferC(const void* buffer, std::size_t size
     return size;
 }
 
+std::span<u8> HLERequestContext::WriteBufferDirect(std::size_t buffer_index) const {
+    const bool is_buffer_b{BufferDescriptorB().size() > buffer_index &&
+                           BufferDescriptorB()[buffer_index].Size()};
+    if (is_buffer_b) {
+        return WriteBufferDirectB(buffer_index);
+    }
+    return WriteBufferDirectC(buffer_index);
+}
+
+std::span<u8> HLERequestContext::WriteBufferDirectB(std::size_t buffer_index) const {
+    if (buffer_index >= BufferDescriptorB().size()) {
+        return {};
+    }
+    return GetDirectWriteBuffer(BufferDescriptorB()[buffer_index].Address(),
+                                BufferDescriptorB()[buffer_index].Size());
+}
+
+std::span<u8> HLERequestContext::WriteBufferDirectC(std::size_t buffer_index) const {
+    if (buffer_index >= BufferDescriptorC().size()) {
+        return {};
+    }
+    return GetDirectWriteBuffer(BufferDescriptorC()[buffer_index].Address(),
+                                BufferDescriptorC()[buffer_index].Size());
+}
+
+std::span<u8> HLERequestContext::GetDirectWriteBuffer(VAddr address, std::size_t size) const {
+    if (size == 0) {
+        return {};
+    }
+    // Input spans may be read straight from guest memory as well, so aliasing buffers are
+    // written through a copy, once the handler is done reading its input.
+    const auto overlaps{[address, size](const auto& descriptors) {
+        return std::ranges::any_of(descriptors, [address, size](const auto& descriptor) {
+            return descriptor.Size() != 0 && descriptor.Address() < address + size &&
+                   address < descriptor.Address() + descriptor.Size();
+        });
+    }};
+    if (overlaps(BufferDescriptorA()) || overlaps(BufferDescriptorX())) {
+        return {};
+    }
+    return memory.GetPlainMemorySpan(address, size);
+}
+
 std::size_t HLERequestContext::GetReadBufferSize(std::size_t buffer_index) const {
     const bool is_buffer_a{BufferDescriptorA().size() > buffer_index &&
                            BufferDescriptorA()[buffer_index].Size()};
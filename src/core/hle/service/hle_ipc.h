@@ -73,8 +73,25 @@ public:
     virtual Result HandleSyncRequest(Kernel::KServerSession& session,
                                      HLERequestContext& context) = 0;
 
+    /// Whether requests of different sessions can be handled at the same time
+    bool IsConcurrentDispatchSafe() const {
+        return concurrent_dispatch_safe;
+    }
+
 protected:
+    /**
+     * Declares that the handler, and the objects it creates in its domain, may handle requests
+     * of different sessions at the same time on a server manager with additional host threads.
+     * Requests of one session are always handled in order.
+     */
+    void SetConcurrentDispatchSafe() {
+        concurrent_dispatch_safe = true;
+    }
+
     Kernel::KernelCore& kernel;
+
+private:
+    bool concurrent_dispatch_safe{};
 };
 
 using SessionRequestHandlerWeakPtr = std::weak_ptr<SessionRequestHandler>;
@@ -113,6 +130,10 @@ public:
         return session_handler != nullptr;
     }
 
+    bool IsConcurrentDispatchSafe() const {
+        return session_handler != nullptr && session_handler->IsConcurrentDispatchSafe();
+    }
+
     SessionRequestHandler& SessionHandler() {
         return *session_handler;
     }
@@ -281,6 +302,19 @@ public:
     std::size_t WriteBufferC(const void* buffer, std::size_t size,
                              std::size_t buffer_index = 0) const;
 
+    /**
+     * Helper function to get the output buffer as host memory that can be written in place, using
+     * the appropriate buffer descriptor. The span is empty when the buffer is not plain memory of a
+     * single guest mapping or overlaps an input buffer, WriteBuffer has to be used then.
+     */
+    [[nodiscard]] std::span<u8> WriteBufferDirect(std::size_t buffer_index = 0) const;
+
+    /// Helper function to get buffer B as host memory that can be written in place
+    [[nodiscard]] std::span<u8> WriteBufferDirectB(std::size_t buffer_index = 0) const;
+
+    /// Helper function to get buffer C as host memory that can be written in place
+    [[nodiscard]] std::span<u8> WriteBufferDirectC(std::size_t buffer_index = 0) const;
+
     /* Helper function to write a buffer using the appropriate buffer descriptor
      *
      * @tparam T an arbitrary container that satisfies the
@@ -394,6 +428,9 @@ private:
 
     void ParseCommandBuffer(u32_le* src_cmdbuf, bool incoming);
 
+    /// Gets the host memory of an output buffer, if it can be written in place
+    std::span<u8> GetDirectWriteBuffer(VAddr address, std::size_t size) const;
+
     std::array<u32, IPC::COMMAND_BUFFER_LENGTH> cmd_buf;
     Kernel::KServerSession* server_session{};
     Kernel::KHandleTable* client_handle_table{};
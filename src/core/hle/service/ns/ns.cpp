@@ -34,10 +34,11 @@ void LoopProcess(Core::System& system) {
                                          std::make_shared<IVulnerabilityManagerInterface>(system));
     server_manager->RegisterNamedService("pdm:qry", std::make_shared<IQueryService>(system));
 
-    server_manager->RegisterNamedService("pl:s",
-                                         std::make_shared<IPlatformServiceManager>(system, "pl:s"));
-    server_manager->RegisterNamedService("pl:u",
-                                         std::make_shared<IPlatformServiceManager>(system, "pl:u"));
+    // Loading the shared fonts is slow, and most titles only use one of these
+    server_manager->RegisterLazyNamedService(
+        "pl:s", [&system] { return std::make_shared<IPlatformServiceManager>(system, "pl:s"); });
+    server_manager->RegisterLazyNamedService(
+        "pl:u", [&system] { return std::make_shared<IPlatformServiceManager>(system, "pl:u"); });
     ServerManager::RunServer(std::move(server_manager));
 }
 
@@ -2,7 +2,11 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <algorithm>
+#include <array>
 #include <cstring>
+#include <map>
+#include <mutex>
+#include <string>
 #include <vector>
 
 #include "common/assert.h"
@@ -94,6 +98,12 @@ static u32 GetU32Swapped(const u8* data) {
     return Common::swap32(value);
 }
 
+/// Decrypted fonts built by a system, reused by the others of the process loading the same archives
+struct CachedSharedFonts {
+    std::weak_ptr<Kernel::PhysicalMemory> shared_font;
+    std::vector<FontRegion> shared_font_regions;
+};
+
 struct IPlatformServiceManager::Impl {
     const FontRegion& GetSharedFontRegion(std::size_t index) const {
         if (index >= shared_font_regions.size() || shared_font_regions.empty()) {
@@ -160,18 +170,39 @@ IPlatformServiceManager::IPlatformServiceManager(Core::System& system_, const ch
     std::size_t offset = 0;
     // Rebuild shared fonts from data ncas or synthesize
 
-    impl->shared_font = std::make_shared<Kernel::PhysicalMemory>(SHARED_FONT_MEM_SIZE);
-    for (auto font : SHARED_FONTS) {
-        FileSys::VirtualFile romfs;
-        const auto nca =
-            nand->GetEntry(static_cast<u64>(font.first), FileSys::ContentRecordType::Data);
+    // The fonts only depend on the archives they come from, identified by the path of the NCA
+    // (named after the hash of its content) or as synthesized
+    std::array<FileSys::VirtualFile, SHARED_FONTS.size()> romfs_files;
+    std::string cache_key;
+    for (std::size_t i = 0; i < SHARED_FONTS.size(); ++i) {
+        const auto title_id = static_cast<u64>(SHARED_FONTS[i].first);
+        const auto nca = nand->GetEntry(title_id, FileSys::ContentRecordType::Data);
         if (nca) {
-            romfs = nca->GetRomFS();
+            romfs_files[i] = nca->GetRomFS();
         }
-
-        if (!romfs) {
-            romfs = FileSys::SystemArchive::SynthesizeSystemArchive(static_cast<u64>(font.first));
+        if (romfs_files[i]) {
+            cache_key += nca->GetBaseFile()->GetFullPath();
+        } else {
+            romfs_files[i] = FileSys::SystemArchive::SynthesizeSystemArchive(title_id);
+            cache_key += fmt::format("synthesized:{:016X}", title_id);
         }
+        cache_key += ';';
+    }
+
+    static std::mutex cache_mutex;
+    static std::map<std::string, CachedSharedFonts> cache;
+    std::scoped_lock lock{cache_mutex};
+    auto& cached = cache[cache_key];
+    if (auto shared_font = cached.shared_font.lock()) {
+        impl->shared_font = std::move(shared_font);
+        impl->shared_font_regions = cached.shared_font_regions;
+        return;
+    }
+
+    impl->shared_font = std::make_shared<Kernel::PhysicalMemory>(SHARED_FONT_MEM_SIZE);
+    for (std::size_t i = 0; i < SHARED_FONTS.size(); ++i) {
+        const auto& font = SHARED_FONTS[i];
+        const auto& romfs = romfs_files[i];
 
         if (!romfs) {
             LOG_ERROR(Service_NS, "Failed to find or synthesize {:016X}! Skipping", font.first);
@@ -199,6 +230,8 @@ IPlatformServiceManager::IPlatformServiceManager(Core::System& system_, const ch
         DecryptSharedFont(font_data_u32, *impl->shared_font, offset);
         impl->shared_font_regions.push_back(region);
     }
+    cached.shared_font = impl->shared_font;
+    cached.shared_font_regions = impl->shared_font_regions;
 }
 
 IPlatformServiceManager::~IPlatformServiceManager() = default;
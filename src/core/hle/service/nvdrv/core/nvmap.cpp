@@ -2,8 +2,10 @@
 // SPDX-FileCopyrightText: 2022 Skyline Team and Contributors
 // SPDX-License-Identifier: GPL-3.0-or-later
 
+#include <algorithm>
 #include <functional>
 
+
 #include "common/alignment.h"
 #include "common/assert.h"
 #include "common/logging/log.h"
@@ -210,17 +212,20 @@ DAddr NvMap::PinHandle(NvMap::Handle::Id handle, bool low_area_pin) {
         } else {
             size_t aligned_up = Common::AlignUp(map_size, BIG_PAGE_SIZE);
             while ((address = smmu.Allocate(aligned_up)) == 0) {
-                // Free handles until the allocation succeeds
+                // Free the least recently unpinned handles until the allocation succeeds
                 std::scoped_lock queueLock(unmap_queue_lock);
-                if (auto freeHandleDesc{unmap_queue.front()}) {
-                    // Handles in the unmap queue are guaranteed not to be pinned so don't bother
-                    // checking if they are before unmapping
-                    std::scoped_lock freeLock(freeHandleDesc->mutex);
-                    if (handle_description->d_address)
-                        UnmapHandle(*freeHandleDesc);
-                } else {
+                const auto it = std::ranges::find_if(
+                    unmap_queue, [](const auto& queued) { return !queued->in_heap; });
+                if (it == unmap_queue.end()) {
                     LOG_CRITICAL(Service_NVDRV, "Ran out of SMMU address space!");
+                    return 0;
                 }
+                // Handles in the unmap queue are guaranteed not to be pinned so don't bother
+                // checking if they are before unmapping. Handles mapped in the preallocated area
+                // are skipped, unmapping them wouldn't free any SMMU space.
+                const auto free_handle_desc{*it};
+                std::scoped_lock freeLock(free_handle_desc->mutex);
+                UnmapHandle(*free_handle_desc);
             }
 
             handle_description->d_address = address;
@@ -73,6 +73,7 @@ void nvdisp_disp0::Composite(std::span<const Nvnflinger::HwcLayer> sorted_layers
             .transform_flags = layer.transform,
             .crop_rect = layer.crop_rect,
             .blending = ConvertBlending(layer.blending),
+            .is_updated = layer.is_updated,
         });
 
         for (size_t i = 0; i < layer.acquire_fence.num_fences; i++) {
@@ -4,6 +4,8 @@
 // Parts of this implementation were based on:
 // https://cs.android.com/android/platform/superproject/+/android-5.1.1_r38:frameworks/native/libs/gui/BufferQueueConsumer.cpp
 
+#include <bit>
+
 #include "common/assert.h"
 #include "common/logging/log.h"
 #include "core/hle/service/nvnflinger/buffer_item.h"
@@ -21,13 +23,8 @@ BufferQueueConsumer::~BufferQueueConsumer() = default;
 
 Status BufferQueueConsumer::AcquireBuffer(BufferItem* out_buffer,
                                           std::chrono::nanoseconds expected_present) {
-    std::scoped_lock lock{core->mutex};
-
     // Check that the consumer doesn't currently have the maximum number of buffers acquired.
-    const s32 num_acquired_buffers{
-        static_cast<s32>(std::count_if(slots.begin(), slots.end(), [](const auto& slot) {
-            return slot.buffer_state == BufferState::Acquired;
-        }))};
+    const s32 num_acquired_buffers{std::popcount(core->GetSlotMask(BufferState::Acquired))};
 
     if (num_acquired_buffers >= core->max_acquired_buffer_count + 1) {
         LOG_ERROR(Service_Nvnflinger, "max acquired buffer count reached: {} (max {})",
@@ -35,6 +32,14 @@ Status BufferQueueConsumer::AcquireBuffer(BufferItem* out_buffer,
         return Status::InvalidOperation;
     }
 
+    // The composer polls every layer on each vsync, don't contend with the producer for the lock
+    // when there is nothing to acquire.
+    if (core->queue_size.load(std::memory_order_acquire) == 0) {
+        return Status::NoBufferAvailable;
+    }
+
+    std::scoped_lock lock{core->mutex};
+
     // Check if the queue is empty.
     if (core->queue.empty()) {
         return Status::NoBufferAvailable;
@@ -66,10 +71,11 @@ Status BufferQueueConsumer::AcquireBuffer(BufferItem* out_buffer,
 
             if (core->StillTracking(*front)) {
                 // Front buffer is still in mSlots, so mark the slot as free
-                slots[front->slot].buffer_state = BufferState::Free;
+                core->SetBufferStateLocked(front->slot, BufferState::Free);
             }
 
             core->queue.erase(front);
+            core->UpdateQueueSizeLocked();
             front = core->queue.begin();
         }
 
@@ -95,7 +101,7 @@ Status BufferQueueConsumer::AcquireBuffer(BufferItem* out_buffer,
     if (core->StillTracking(*front)) {
         slots[slot].acquire_called = true;
         slots[slot].needs_cleanup_on_release = false;
-        slots[slot].buffer_state = BufferState::Acquired;
+        core->SetBufferStateLocked(slot, BufferState::Acquired);
 
         // TODO: for now, avoid resetting the fence, so that when we next return this
         // slot to the producer, it will wait for the fence to pass. We should fix this
@@ -110,6 +116,7 @@ Status BufferQueueConsumer::AcquireBuffer(BufferItem* out_buffer,
     }
 
     core->queue.erase(front);
+    core->UpdateQueueSizeLocked();
 
     // We might have freed a slot while dropping old buffers, or the producer  may be blocked
     // waiting for the number of buffers in the queue to decrease.
@@ -150,7 +157,7 @@ Status BufferQueueConsumer::ReleaseBuffer(s32 slot, u64 frame_number, const Fenc
             // slot to the producer, it can wait for its own fence to pass. We should fix this
             // by properly waiting for the fence in the BufferItemConsumer.
             // slots[slot].fence = release_fence;
-            slots[slot].buffer_state = BufferState::Free;
+            core->SetBufferStateLocked(slot, BufferState::Free);
 
             listener = core->connected_producer_listener;
 
@@ -214,6 +221,7 @@ Status BufferQueueConsumer::Disconnect() {
     core->is_abandoned = true;
     core->consumer_listener = nullptr;
     core->queue.clear();
+    core->UpdateQueueSizeLocked();
     core->FreeAllBuffersLocked();
     core->SignalDequeueCondition();
 
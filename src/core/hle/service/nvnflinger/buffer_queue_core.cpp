@@ -4,6 +4,8 @@
 // Parts of this implementation were based on:
 // https://cs.android.com/android/platform/superproject/+/android-5.1.1_r38:frameworks/native/libs/gui/BufferQueueCore.cpp
 
+#include <algorithm>
+
 #include "common/assert.h"
 
 #include "core/hle/service/nvnflinger/buffer_queue_core.h"
@@ -14,18 +16,60 @@ BufferQueueCore::BufferQueueCore() = default;
 
 BufferQueueCore::~BufferQueueCore() = default;
 
+ProducerWaitStats BufferQueueCore::GetProducerWaitStats() const {
+    std::scoped_lock lock{mutex};
+    return producer_wait_stats;
+}
+
 void BufferQueueCore::SignalDequeueCondition() {
     dequeue_possible.store(true);
-    dequeue_condition.notify_all();
+    // Most signals happen with no producer blocked, skip waking the condition variable then
+    if (num_dequeue_waiters > 0) {
+        dequeue_condition.notify_all();
+    }
 }
 
 bool BufferQueueCore::WaitForDequeueCondition(std::unique_lock<std::mutex>& lk) {
+    const auto wait_start = std::chrono::steady_clock::now();
+    ++num_dequeue_waiters;
     dequeue_condition.wait(lk, [&] { return dequeue_possible.load(); });
+    --num_dequeue_waiters;
     dequeue_possible.store(false);
+    frame_wait += std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - wait_start);
 
     return true;
 }
 
+void BufferQueueCore::CommitFrameWaitLocked() {
+    const auto wait_ns = static_cast<u64>(frame_wait.count());
+    frame_wait = {};
+
+    ++producer_wait_stats.num_frames;
+    if (wait_ns != 0) {
+        ++producer_wait_stats.num_waited_frames;
+    }
+    producer_wait_stats.total_wait_ns += wait_ns;
+    producer_wait_stats.max_wait_ns = std::max(producer_wait_stats.max_wait_ns, wait_ns);
+    producer_wait_stats.last_wait_ns = wait_ns;
+}
+
+void BufferQueueCore::SetBufferStateLocked(s32 slot, BufferState state) {
+    const u64 bit = 1ULL << slot;
+    slot_masks[static_cast<size_t>(slots[slot].buffer_state)].fetch_and(~bit,
+                                                                         std::memory_order_relaxed);
+    slot_masks[static_cast<size_t>(state)].fetch_or(bit, std::memory_order_release);
+    slots[slot].buffer_state = state;
+}
+
+void BufferQueueCore::UpdateQueueSizeLocked() {
+    queue_size.store(queue.size(), std::memory_order_release);
+}
+
+u64 BufferQueueCore::GetSlotMask(BufferState state) const {
+    return slot_masks[static_cast<size_t>(state)].load(std::memory_order_acquire);
+}
+
 s32 BufferQueueCore::GetMinUndequeuedBufferCountLocked(bool async) const {
     // If DequeueBuffer is allowed to error out, we don't have to add an extra buffer.
     if (!use_async_buffer) {
@@ -78,7 +122,7 @@ void BufferQueueCore::FreeBufferLocked(s32 slot) {
         slots[slot].needs_cleanup_on_release = true;
     }
 
-    slots[slot].buffer_state = BufferState::Free;
+    SetBufferStateLocked(slot, BufferState::Free);
     slots[slot].frame_number = UINT32_MAX;
     slots[slot].acquire_called = false;
     slots[slot].fence = Fence::NoFence();
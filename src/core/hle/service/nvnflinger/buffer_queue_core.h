@@ -6,6 +6,9 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <list>
 #include <memory>
@@ -24,6 +27,15 @@ namespace Service::android {
 class IConsumerListener;
 class IProducerListener;
 
+/// Time the producer spent blocked waiting for a free slot, accounted per queued frame
+struct ProducerWaitStats {
+    u64 num_frames{};        ///< Frames queued by the producer
+    u64 num_waited_frames{}; ///< Frames that had to wait for a slot to be released
+    u64 total_wait_ns{};
+    u64 max_wait_ns{};
+    u64 last_wait_ns{}; ///< Wait of the last queued frame
+};
+
 class BufferQueueCore final {
     friend class BufferQueueProducer;
     friend class BufferQueueConsumer;
@@ -34,9 +46,19 @@ public:
     BufferQueueCore();
     ~BufferQueueCore();
 
+    ProducerWaitStats GetProducerWaitStats() const;
+
 private:
     void SignalDequeueCondition();
     bool WaitForDequeueCondition(std::unique_lock<std::mutex>& lk);
+    void CommitFrameWaitLocked();
+
+    /// Changes the state of a slot, keeping the slot masks in sync
+    void SetBufferStateLocked(s32 slot, BufferState state);
+    void UpdateQueueSizeLocked();
+
+    /// Slots in the given state, readable without holding the mutex
+    u64 GetSlotMask(BufferState state) const;
 
     s32 GetMinUndequeuedBufferCountLocked(bool async) const;
     s32 GetMinMaxBufferCountLocked(bool async) const;
@@ -72,6 +94,14 @@ private:
     u32 transform_hint{};
     bool is_allocating{};
     mutable std::condition_variable_any is_allocating_condition;
+
+    // Mirrors of the slot states and queue size, so the consumer can poll without locking
+    std::array<std::atomic<u64>, 4> slot_masks{~0ULL, 0, 0, 0};
+    std::atomic<size_t> queue_size{};
+
+    s32 num_dequeue_waiters{};
+    std::chrono::nanoseconds frame_wait{};
+    ProducerWaitStats producer_wait_stats{};
 };
 
 } // namespace Service::android
@@ -4,6 +4,8 @@
 // Parts of this implementation were based on:
 // https://cs.android.com/android/platform/superproject/+/android-5.1.1_r38:frameworks/native/libs/gui/BufferQueueProducer.cpp
 
+#include <bit>
+
 #include "common/assert.h"
 #include "common/logging/log.h"
 #include "core/hle/kernel/k_event.h"
@@ -145,27 +147,22 @@ Status BufferQueueProducer::WaitForFreeSlotThenRelock(bool async, s32* found, St
         }
 
         // Look for a free buffer to give to the client
+        const u64 slot_limit = max_buffer_count < BufferQueueDefs::NUM_BUFFER_SLOTS
+                                   ? (1ULL << max_buffer_count) - 1
+                                   : ~0ULL;
+        const s32 dequeued_count =
+            std::popcount(core->GetSlotMask(BufferState::Dequeued) & slot_limit);
+        const s32 acquired_count =
+            std::popcount(core->GetSlotMask(BufferState::Acquired) & slot_limit);
         *found = BufferQueueCore::INVALID_BUFFER_SLOT;
-        s32 dequeued_count{};
-        s32 acquired_count{};
-        for (s32 s{}; s < max_buffer_count; ++s) {
-            switch (slots[s].buffer_state) {
-            case BufferState::Dequeued:
-                ++dequeued_count;
-                break;
-            case BufferState::Acquired:
-                ++acquired_count;
-                break;
-            case BufferState::Free:
-                // We return the oldest of the free buffers to avoid stalling the producer if
-                // possible, since the consumer may still have pending reads of in-flight buffers
-                if (*found == BufferQueueCore::INVALID_BUFFER_SLOT ||
-                    slots[s].frame_number < slots[*found].frame_number) {
-                    *found = s;
-                }
-                break;
-            default:
-                break;
+        for (u64 free_slots = core->GetSlotMask(BufferState::Free) & slot_limit; free_slots != 0;
+             free_slots &= free_slots - 1) {
+            const s32 s = std::countr_zero(free_slots);
+            // We return the oldest of the free buffers to avoid stalling the producer if
+            // possible, since the consumer may still have pending reads of in-flight buffers
+            if (*found == BufferQueueCore::INVALID_BUFFER_SLOT ||
+                slots[s].frame_number < slots[*found].frame_number) {
+                *found = s;
             }
         }
 
@@ -265,7 +262,7 @@ Status BufferQueueProducer::DequeueBuffer(s32* out_slot, Fence* out_fence, bool
             height = core->default_height;
         }
 
-        slots[found].buffer_state = BufferState::Dequeued;
+        core->SetBufferStateLocked(found, BufferState::Dequeued);
 
         const std::shared_ptr<GraphicBuffer>& buffer(slots[found].graphic_buffer);
         if ((buffer == nullptr) || (buffer->Width() != width) || (buffer->Height() != height) ||
@@ -418,7 +415,7 @@ Status BufferQueueProducer::AttachBuffer(s32* out_slot,
     LOG_DEBUG(Service_Nvnflinger, "Returning slot {} flags={}", *out_slot, return_flags);
 
     slots[*out_slot].graphic_buffer = buffer;
-    slots[*out_slot].buffer_state = BufferState::Dequeued;
+    core->SetBufferStateLocked(*out_slot, BufferState::Dequeued);
     slots[*out_slot].fence = Fence::NoFence();
     slots[*out_slot].request_buffer_called = true;
 
@@ -509,7 +506,7 @@ Status BufferQueueProducer::QueueBuffer(s32 slot, const QueueBufferInput& input,
         }
 
         slots[slot].fence = fence;
-        slots[slot].buffer_state = BufferState::Queued;
+        core->SetBufferStateLocked(slot, BufferState::Queued);
         ++core->frame_counter;
         slots[slot].frame_number = core->frame_counter;
 
@@ -543,7 +540,7 @@ Status BufferQueueProducer::QueueBuffer(s32 slot, const QueueBufferInput& input,
                 // If the front queued buffer is still being tracked, we first
                 // mark it as freed
                 if (core->StillTracking(*front)) {
-                    slots[front->slot].buffer_state = BufferState::Free;
+                    core->SetBufferStateLocked(front->slot, BufferState::Free);
                     // Reset the frame number of the freed buffer so that it is the first in line to
                     // be dequeued again
                     slots[front->slot].frame_number = 0;
@@ -557,6 +554,8 @@ Status BufferQueueProducer::QueueBuffer(s32 slot, const QueueBufferInput& input,
             }
         }
 
+        core->UpdateQueueSizeLocked();
+        core->CommitFrameWaitLocked();
         core->buffer_has_been_queued = true;
         core->SignalDequeueCondition();
         output->Inflate(core->default_width, core->default_height, core->transform_hint,
@@ -612,7 +611,7 @@ void BufferQueueProducer::CancelBuffer(s32 slot, const Fence& fence) {
         return;
     }
 
-    slots[slot].buffer_state = BufferState::Free;
+    core->SetBufferStateLocked(slot, BufferState::Free);
     slots[slot].frame_number = 0;
     slots[slot].fence = fence;
 
@@ -744,6 +743,7 @@ Status BufferQueueProducer::Disconnect(NativeWindowApi api) {
         case NativeWindowApi::Camera:
             if (core->connected_api == api) {
                 core->queue.clear();
+                core->UpdateQueueSizeLocked();
                 core->FreeAllBuffersLocked();
                 core->connected_producer_listener = nullptr;
                 core->connected_api = NativeWindowApi::NoConnectedApi;
@@ -781,6 +781,7 @@ Status BufferQueueProducer::SetPreallocatedBuffer(s32 slot,
 
     std::scoped_lock lock{core->mutex};
 
+    core->SetBufferStateLocked(slot, BufferState::Free);
     slots[slot] = {};
     slots[slot].fence = Fence::NoFence();
     slots[slot].graphic_buffer = std::make_shared<GraphicBuffer>(nvmap, buffer);
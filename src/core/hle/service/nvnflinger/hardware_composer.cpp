@@ -1,7 +1,7 @@
 // SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-3.0-or-later
 
-#include <boost/container/small_vector.hpp>
+#include <algorithm>
 
 #include "common/microprofile.h"
 #include "core/hle/service/nvdrv/devices/nvdisp_disp0.h"
@@ -45,6 +45,7 @@ HardwareComposer::~HardwareComposer() = default;
 u32 HardwareComposer::ComposeLocked(f32* out_speed_scale, Display& display,
                                     Nvidia::Devices::nvdisp_disp0& nvdisp) {
     boost::container::small_vector<HwcLayer, 2> composition_stack;
+    boost::container::small_vector<ComposedLayer, 2> composed_layers;
 
     // Set default speed limit to 100%.
     *out_speed_scale = 1.0f;
@@ -76,6 +77,15 @@ u32 HardwareComposer::ComposeLocked(f32* out_speed_scale, Display& display,
 
         // TODO: get proper Z-index from layer
         if (layer->visible) {
+            const ComposedLayer composed_layer{
+                .consumer_id = consumer_id,
+                .frame_number = item.frame_number,
+                .blending = layer->blending,
+            };
+            // Layers showing the same buffer item as in the last composition need no update.
+            const bool is_updated = std::ranges::find(m_composed_layers, composed_layer) ==
+                                    m_composed_layers.end();
+            composed_layers.push_back(composed_layer);
             composition_stack.emplace_back(HwcLayer{
                 .buffer_handle = igbp_buffer.BufferId(),
                 .offset = igbp_buffer.Offset(),
@@ -88,6 +98,7 @@ u32 HardwareComposer::ComposeLocked(f32* out_speed_scale, Display& display,
                 .transform = static_cast<android::BufferTransformFlags>(item.transform),
                 .crop_rect = item.crop,
                 .acquire_fence = item.fence,
+                .is_updated = is_updated,
             });
         }
 
@@ -105,14 +116,16 @@ u32 HardwareComposer::ComposeLocked(f32* out_speed_scale, Display& display,
         }
     }
 
-    // If any new buffers were acquired, we can present.
-    if (has_acquired_buffer) {
+    // If any new buffers were acquired or the set of visible layers changed, we can present.
+    // Otherwise the previous composition is still on screen and is left untouched.
+    if (has_acquired_buffer || composed_layers != m_composed_layers) {
         // Sort by Z-index.
         std::stable_sort(composition_stack.begin(), composition_stack.end(),
                          [&](auto& l, auto& r) { return l.z_index < r.z_index; });
 
         // Composite.
         nvdisp.Composite(composition_stack);
+        m_composed_layers = std::move(composed_layers);
     }
 
     // Render MicroProfile.
@@ -4,9 +4,11 @@
 #pragma once
 
 #include <boost/container/flat_map.hpp>
+#include <boost/container/small_vector.hpp>
 
 #include "core/hle/service/nvnflinger/buffer_item.h"
 #include "core/hle/service/nvnflinger/display.h"
+#include "core/hle/service/nvnflinger/hwc_layer.h"
 
 namespace Service::Nvidia::Devices {
 class nvdisp_disp0;
@@ -43,7 +45,17 @@ private:
         CachedBufferReused,
     };
 
+    /// State of a visible layer when the display was last composed
+    struct ComposedLayer {
+        ConsumerId consumer_id{};
+        u64 frame_number{};
+        LayerBlending blending{};
+
+        bool operator==(const ComposedLayer&) const = default;
+    };
+
     boost::container::flat_map<ConsumerId, Framebuffer> m_framebuffers{};
+    boost::container::small_vector<ComposedLayer, 2> m_composed_layers{};
 
 private:
     bool TryAcquireFramebufferLocked(Layer& layer, Framebuffer& framebuffer);
@@ -35,6 +35,7 @@ struct HwcLayer {
     android::BufferTransformFlags transform;
     Common::Rectangle<int> crop_rect;
     android::Fence acquire_fence;
+    bool is_updated;
 };
 
 } // namespace Service::Nvnflinger
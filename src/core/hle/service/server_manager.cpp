@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include "common/scope_exit.h"
+#include "common/tracing.h"
 
 #include "core/core.h"
 #include "core/hle/kernel/k_client_port.h"
@@ -172,6 +173,31 @@ Result ServerManager::RegisterNamedService(const std::string& service_name,
     R_RETURN(this->RegisterNamedService(service_name, std::move(HandlerFactory), max_sessions));
 }
 
+Result ServerManager::RegisterLazyNamedService(const std::string& service_name,
+                                               SessionRequestHandlerFactory&& create_handler,
+                                               u32 max_sessions) {
+    struct LazyHandler {
+        std::mutex mutex;
+        SessionRequestHandlerFactory create;
+        SessionRequestHandlerPtr handler;
+    };
+    auto lazy = std::make_shared<LazyHandler>();
+    lazy->create = std::move(create_handler);
+
+    // Make the factory. Host code may look the service up concurrently with guest sessions.
+    const auto HandlerFactory = [lazy]() {
+        std::scoped_lock lk{lazy->mutex};
+        if (!lazy->handler) {
+            lazy->handler = lazy->create();
+            lazy->create = nullptr;
+        }
+        return lazy->handler;
+    };
+
+    // Register the service with the new factory.
+    R_RETURN(this->RegisterNamedService(service_name, std::move(HandlerFactory), max_sessions));
+}
+
 Result ServerManager::ManageNamedPort(const std::string& service_name,
                                       SessionRequestHandlerFactory&& handler_factory,
                                       u32 max_sessions) {
@@ -360,16 +386,24 @@ Result ServerManager::OnSessionEvent(Session* session) {
 }
 
 Result ServerManager::CompleteSyncRequest(Session* session) {
+    TRACE_ZONE("Service request");
     Result res = ResultSuccess;
     Result service_res = ResultSuccess;
 
     // Mark the request as not deferred.
     session->GetContext()->SetIsDeferred(false);
 
-    // Complete the request. We have exclusive access to this session.
+    // Complete the request. We have exclusive access to this session, but other threads of the
+    // pool may be handling other sessions of the same service.
     auto* server_session = static_cast<Kernel::KServerSession*>(session->GetNativeHandle());
-    service_res =
-        session->GetManager()->CompleteSyncRequest(server_session, *session->GetContext());
+    {
+        std::unique_lock dispatch_lock{m_dispatch_mutex, std::defer_lock};
+        if (!m_threads.empty() && !session->GetManager()->IsConcurrentDispatchSafe()) {
+            dispatch_lock.lock();
+        }
+        service_res =
+            session->GetManager()->CompleteSyncRequest(server_session, *session->GetContext());
+    }
 
     // If we've been deferred, we're done.
     if (session->GetContext()->GetIsDeferred()) {
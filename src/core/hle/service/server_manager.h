@@ -43,6 +43,11 @@ public:
     Result RegisterNamedService(const std::string& service_name,
                                 std::shared_ptr<SessionRequestHandler>&& handler,
                                 u32 max_sessions = 64);
+    /// Registers a service whose handler is only constructed when it is first requested, and then
+    /// shared by all sessions. Keeps services with expensive constructors off the boot path.
+    Result RegisterLazyNamedService(const std::string& service_name,
+                                    SessionRequestHandlerFactory&& create_handler,
+                                    u32 max_sessions = 64);
     Result ManageNamedPort(const std::string& service_name,
                            SessionRequestHandlerFactory&& handler_factory, u32 max_sessions = 64);
     Result ManageDeferral(Kernel::KEvent** out_event);
@@ -92,6 +97,9 @@ private:
     Common::Event m_stopped{};
     std::vector<std::jthread> m_threads{};
     std::stop_source m_stop_source{};
+
+    // Serializes handlers not declared safe for concurrent dispatch
+    std::mutex m_dispatch_mutex{};
 };
 
 } // namespace Service
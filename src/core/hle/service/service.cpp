@@ -32,6 +32,34 @@ namespace Service {
     return function_string;
 }
 
+/// Builds a table for direct lookup of the handlers, if the command IDs leave few holes in it
+template <typename Map, typename Table>
+static void BuildHandlerTable(const Map& map, Table& table) {
+    table.clear();
+    if (map.empty()) {
+        return;
+    }
+    const size_t table_size = static_cast<size_t>(map.rbegin()->first) + 1;
+    if (table_size > map.size() * 4 + 64) {
+        return;
+    }
+    table.resize(table_size);
+    for (const auto& [command, info] : map) {
+        table[command] = &info;
+    }
+}
+
+/// Finds the handler of a command, or returns nullptr if the service does not know it
+template <typename Map, typename Table>
+static auto FindHandler(const Map& map, const Table& table, u32 command)
+    -> const typename Map::mapped_type* {
+    if (!table.empty()) {
+        return command < table.size() ? table[command] : nullptr;
+    }
+    const auto itr = map.find(command);
+    return itr == map.end() ? nullptr : &itr->second;
+}
+
 ServiceFrameworkBase::ServiceFrameworkBase(Core::System& system_, const char* service_name_,
                                            u32 max_sessions_, InvokerFn* handler_invoker_)
     : SessionRequestHandler(system_.Kernel(), service_name_), system{system_},
@@ -48,6 +76,7 @@ void ServiceFrameworkBase::RegisterHandlersBase(const FunctionInfoBase* function
         // Usually this array is sorted by id already, so hint to insert at the end
         handlers.emplace_hint(handlers.cend(), functions[i].expected_header, functions[i]);
     }
+    BuildHandlerTable(handlers, handler_table);
 }
 
 void ServiceFrameworkBase::RegisterHandlersBaseTipc(const FunctionInfoBase* functions,
@@ -58,6 +87,7 @@ void ServiceFrameworkBase::RegisterHandlersBaseTipc(const FunctionInfoBase* func
         handlers_tipc.emplace_hint(handlers_tipc.cend(), functions[i].expected_header,
                                    functions[i]);
     }
+    BuildHandlerTable(handlers_tipc, handler_table_tipc);
 }
 
 void ServiceFrameworkBase::ReportUnimplementedFunction(HLERequestContext& ctx,
@@ -84,8 +114,7 @@ void ServiceFrameworkBase::ReportUnimplementedFunction(HLERequestContext& ctx,
 }
 
 void ServiceFrameworkBase::InvokeRequest(HLERequestContext& ctx) {
-    auto itr = handlers.find(ctx.GetCommand());
-    const FunctionInfoBase* info = itr == handlers.end() ? nullptr : &itr->second;
+    const FunctionInfoBase* info = FindHandler(handlers, handler_table, ctx.GetCommand());
     if (info == nullptr || info->handler_callback == nullptr) {
         return ReportUnimplementedFunction(ctx, info);
     }
@@ -95,11 +124,8 @@ void ServiceFrameworkBase::InvokeRequest(HLERequestContext& ctx) {
 }
 
 void ServiceFrameworkBase::InvokeRequestTipc(HLERequestContext& ctx) {
-    boost::container::flat_map<u32, FunctionInfoBase>::iterator itr;
-
-    itr = handlers_tipc.find(ctx.GetCommand());
-
-    const FunctionInfoBase* info = itr == handlers_tipc.end() ? nullptr : &itr->second;
+    const FunctionInfoBase* info =
+        FindHandler(handlers_tipc, handler_table_tipc, ctx.GetCommand());
     if (info == nullptr || info->handler_callback == nullptr) {
         return ReportUnimplementedFunction(ctx, info);
     }
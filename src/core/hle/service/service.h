@@ -6,6 +6,7 @@
 #include <cstddef>
 #include <mutex>
 #include <string>
+#include <vector>
 #include <boost/container/flat_map.hpp>
 #include "common/common_types.h"
 #include "core/hle/service/hle_ipc.h"
@@ -117,6 +118,10 @@ private:
     boost::container::flat_map<u32, FunctionInfoBase> handlers;
     boost::container::flat_map<u32, FunctionInfoBase> handlers_tipc;
 
+    /// Handlers indexed by command ID, empty when the IDs of the service are too sparse
+    std::vector<const FunctionInfoBase*> handler_table;
+    std::vector<const FunctionInfoBase*> handler_table_tipc;
+
     /// Used to gain exclusive access to the service members, e.g. from CoreTiming thread.
     std::mutex lock_service;
 };
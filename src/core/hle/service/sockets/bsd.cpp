@@ -534,7 +534,8 @@ std::pair<s32, Errno> BSD::PollImpl(std::vector<u8>& write_buffer, std::span<con
         return {-1, Errno::INVAL};
     }
 
-    std::vector<PollFD> fds(nfds);
+    thread_local std::vector<PollFD> fds;
+    fds.resize(nfds);
     std::memcpy(fds.data(), read_buffer.data(), nfds * sizeof(PollFD));
 
     if (timeout >= 0) {
@@ -568,7 +569,8 @@ std::pair<s32, Errno> BSD::PollImpl(std::vector<u8>& write_buffer, std::span<con
         }
     }
 
-    std::vector<Network::PollFD> host_pollfds(fds.size());
+    thread_local std::vector<Network::PollFD> host_pollfds;
+    host_pollfds.resize(fds.size());
     std::transform(fds.begin(), fds.end(), host_pollfds.begin(), [this](PollFD pollfd) {
         Network::PollFD result;
         result.socket = file_descriptors[pollfd.fd]->socket.get();
@@ -1012,6 +1014,9 @@ BSD::BSD(Core::System& system_, const char* name)
 
     RegisterHandlers(functions);
 
+    // Blocking socket calls are handled on the server's additional host threads
+    SetConcurrentDispatchSafe();
+
     if (auto room_member = room_network.GetRoomMember().lock()) {
         proxy_packet_received = room_member->BindOnProxyPacketReceived(
             [this](const Network::ProxyPacket& packet) { OnProxyPacketReceived(packet); });
@@ -24,7 +24,7 @@ Conductor::Conductor(Core::System& system, Container& container, DisplayList& di
             "ScreenComposition",
             [this](s64 time,
                    std::chrono::nanoseconds ns_late) -> std::optional<std::chrono::nanoseconds> {
-                m_signal.Set();
+                this->OnVsyncDeadline();
                 return std::chrono::nanoseconds(this->GetNextTicks());
             });
 
@@ -53,20 +53,53 @@ Conductor::~Conductor() {
 }
 
 void Conductor::LinkVsyncEvent(u64 display_id, Event* event) {
+    std::scoped_lock lk{m_vsync_mutex};
     if (auto it = m_vsync_managers.find(display_id); it != m_vsync_managers.end()) {
         it->second.LinkVsyncEvent(event);
     }
 }
 
 void Conductor::UnlinkVsyncEvent(u64 display_id, Event* event) {
+    std::scoped_lock lk{m_vsync_mutex};
     if (auto it = m_vsync_managers.find(display_id); it != m_vsync_managers.end()) {
         it->second.UnlinkVsyncEvent(event);
     }
 }
 
 void Conductor::ProcessVsync() {
-    for (auto& [display_id, manager] : m_vsync_managers) {
+    const u64 vsync = ++m_vsync_count;
+    this->ComposeDisplays();
+    this->SignalVsync(vsync);
+}
+
+void Conductor::OnVsyncDeadline() {
+    const u64 vsync = ++m_vsync_count;
+
+    // The previous composition is still waiting on the host to present. Signal the guest on the
+    // deadline instead of when the host catches up, so titles pacing on vsync keep their timing.
+    if (m_is_composing.load()) {
+        this->SignalVsync(vsync);
+    }
+
+    m_signal.Set();
+}
+
+void Conductor::ComposeDisplays() {
+    for (const auto& [display_id, manager] : m_vsync_managers) {
         m_container.ComposeOnDisplay(&m_swap_interval, &m_compose_speed_scale, display_id);
+    }
+}
+
+void Conductor::SignalVsync(u64 vsync) {
+    std::scoped_lock lk{m_vsync_mutex};
+
+    // Deadlines signaled early, or elapsed while composing, are only signaled once
+    if (vsync <= m_signaled_vsync) {
+        return;
+    }
+    m_signaled_vsync = vsync;
+
+    for (auto& [display_id, manager] : m_vsync_managers) {
         manager.SignalVsync();
     }
 }
@@ -81,7 +114,11 @@ void Conductor::VsyncThread(std::stop_token token) {
             return;
         }
 
-        this->ProcessVsync();
+        const u64 vsync = m_vsync_count.load();
+        m_is_composing.store(true);
+        this->ComposeDisplays();
+        m_is_composing.store(false);
+        this->SignalVsync(vsync);
     }
 }
 
@@ -3,7 +3,9 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
 
 #include "common/common_types.h"
@@ -39,6 +41,9 @@ public:
 
 private:
     void ProcessVsync();
+    void OnVsyncDeadline();
+    void ComposeDisplays();
+    void SignalVsync(u64 vsync);
     void VsyncThread(std::stop_token token);
     s64 GetNextTicks() const;
 
@@ -50,6 +55,12 @@ private:
     Common::Event m_signal;
     std::jthread m_thread;
 
+    /// Guards the linked vsync events, which are signaled from both the timing and vsync threads
+    std::mutex m_vsync_mutex;
+    std::atomic<u64> m_vsync_count{};
+    std::atomic<bool> m_is_composing{};
+    u64 m_signaled_vsync{};
+
 private:
     s32 m_swap_interval = 1;
     f32 m_compose_speed_scale = 1.0f;
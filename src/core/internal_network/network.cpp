@@ -609,7 +609,9 @@ Common::Expected<std::vector<AddrInfo>, GetAddrInfoError> GetAddressInfo(
 std::pair<s32, Errno> Poll(std::vector<PollFD>& pollfds, s32 timeout) {
     const size_t num = pollfds.size();
 
-    std::vector<WSAPOLLFD> host_pollfds(pollfds.size());
+    // Polls are issued every frame by some titles, reuse the host list of each calling thread
+    thread_local std::vector<WSAPOLLFD> host_pollfds;
+    host_pollfds.resize(num);
     std::transform(pollfds.begin(), pollfds.end(), host_pollfds.begin(), [](PollFD fd) {
         WSAPOLLFD result;
         result.fd = fd.socket->GetFD();
@@ -618,16 +620,22 @@ std::pair<s32, Errno> Poll(std::vector<PollFD>& pollfds, s32 timeout) {
         return result;
     });
 
-    host_pollfds.push_back(WSAPOLLFD{
-        .fd = GetInterruptSocket(),
-        .events = POLLIN,
-        .revents = 0,
-    });
+    // Only waiting polls have to be woken up on shutdown
+    if (timeout != 0) {
+        host_pollfds.push_back(WSAPOLLFD{
+            .fd = GetInterruptSocket(),
+            .events = POLLIN,
+            .revents = 0,
+        });
+    }
 
-    const int result =
-        WSAPoll(host_pollfds.data(), static_cast<ULONG>(host_pollfds.size()), timeout);
+    int result = WSAPoll(host_pollfds.data(), static_cast<ULONG>(host_pollfds.size()), timeout);
+    if (result > 0 && host_pollfds.size() > num && host_pollfds[num].revents != 0) {
+        // The interrupt socket is not one of the guest's descriptors
+        --result;
+    }
     if (result == 0) {
-        ASSERT(std::all_of(host_pollfds.begin(), host_pollfds.end(),
+        ASSERT(std::all_of(host_pollfds.begin(), host_pollfds.begin() + num,
                            [](WSAPOLLFD fd) { return fd.revents == 0; }));
         return {0, Errno::SUCCESS};
     }
@@ -2,7 +2,6 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <chrono>
-#include <thread>
 
 #include "common/assert.h"
 #include "common/logging/log.h"
@@ -38,11 +37,19 @@ void ProxySocket::HandleProxyPacket(const ProxyPacket& packet) {
         return;
     }
 
-    auto decompressed = packet;
-    decompressed.data = Common::Compression::DecompressDataZSTD(packet.data);
-
-    std::lock_guard guard(packets_mutex);
-    received_packets.push(decompressed);
+    // Only the payload is decompressed, avoid copying the compressed one along
+    ProxyPacket decompressed{
+        .local_endpoint = packet.local_endpoint,
+        .remote_endpoint = packet.remote_endpoint,
+        .protocol = packet.protocol,
+        .broadcast = packet.broadcast,
+        .data = Common::Compression::DecompressDataZSTD(packet.data),
+    };
+    {
+        std::lock_guard guard(packets_mutex);
+        received_packets.push(std::move(decompressed));
+    }
+    packets_cv.notify_one();
 }
 
 template <typename T>
@@ -117,28 +124,20 @@ std::pair<s32, Errno> ProxySocket::RecvFrom(int flags, std::span<u8> message, So
     // packet arrives. In order to prevent lost packets from hanging the emulation thread, we set
     // the timeout to 5s instead
     const auto timeout = receive_timeout == 0 ? 5000 : receive_timeout;
-    while (true) {
-        {
-            std::lock_guard guard(packets_mutex);
-            if (received_packets.size() > 0) {
-                return ReceivePacket(flags, message, addr, message.size());
-            }
-        }
-
+    std::unique_lock lock(packets_mutex);
+    if (received_packets.empty()) {
         if (!blocking) {
             return {-1, Errno::AGAIN};
         }
-
-        std::this_thread::yield();
-
-        const auto time_diff = std::chrono::steady_clock::now() - timestamp;
-        const auto time_diff_ms =
-            std::chrono::duration_cast<std::chrono::milliseconds>(time_diff).count();
-
-        if (time_diff_ms > timeout) {
+        // Sleep until HandleProxyPacket queues a packet, instead of spinning on the queue
+        const bool has_packet =
+            packets_cv.wait_until(lock, timestamp + std::chrono::milliseconds(timeout),
+                                  [this] { return !received_packets.empty(); });
+        if (!has_packet) {
             return {-1, Errno::TIMEDOUT};
         }
     }
+    return ReceivePacket(flags, message, addr, message.size());
 }
 
 std::pair<s32, Errno> ProxySocket::ReceivePacket(int flags, std::span<u8> message, SockAddrIn* addr,
@@ -162,10 +161,8 @@ std::pair<s32, Errno> ProxySocket::ReceivePacket(int flags, std::span<u8> messag
             }
             return {-1, Errno::MSGSIZE};
         } else if (protocol == Protocol::TCP) {
-            std::vector<u8> numArray(packet.data.size() - max_length);
-            std::copy(packet.data.begin() + max_length, packet.data.end(),
-                      std::back_inserter(numArray));
-            packet.data = numArray;
+            // Keep the rest of the stream for the next read
+            packet.data.erase(packet.data.begin(), packet.data.begin() + max_length);
         }
     } else {
         read_bytes = packet.data.size();
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <condition_variable>
 #include <mutex>
 #include <span>
 #include <vector>
@@ -92,6 +93,7 @@ private:
     Protocol protocol;
 
     std::mutex packets_mutex;
+    std::condition_variable packets_cv; ///< Signaled when a packet is received
 
     RoomNetwork& room_network;
 };
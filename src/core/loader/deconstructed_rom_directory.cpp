@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <cstring>
+#include <future>
 #include "common/logging/log.h"
 #include "common/settings.h"
 #include "core/core.h"
@@ -185,6 +186,26 @@ AppLoader_DeconstructedRomDirectory::LoadResult AppLoader_DeconstructedRomDirect
                                        "subsdk3", "subsdk4", "subsdk5", "subsdk6", "subsdk7",
                                        "subsdk8", "subsdk9", "sdk"};
 
+    // Read every module once, for both passes below. The files are read on this thread, as they
+    // may share a decryption layer, while their segments are decompressed in parallel. This
+    // overlaps decompression with reading the next modules and with patching the previous ones.
+    std::array<std::future<NSOImage>, static_modules.size()> pending_images;
+    for (size_t i = 0; i < static_modules.size(); i++) {
+        const FileSys::VirtualFile module_file{dir->GetFile(static_modules[i])};
+        if (!module_file) {
+            continue;
+        }
+        auto image = AppLoader_NSO::ReadImage(*module_file);
+        if (!image) {
+            return {ResultStatus::ErrorLoadingNSO, {}};
+        }
+        pending_images[i] = std::async(std::launch::async, [image = std::move(*image)]() mutable {
+            AppLoader_NSO::DecompressImage(image);
+            return std::move(image);
+        });
+    }
+    std::array<std::optional<NSOImage>, static_modules.size()> images;
+
     std::size_t code_size{};
 
     // Define an nce patch context for each potential module.
@@ -193,14 +214,14 @@ AppLoader_DeconstructedRomDirectory::LoadResult AppLoader_DeconstructedRomDirect
     // Use the NSO module loader to figure out the code layout
     for (size_t i = 0; i < static_modules.size(); i++) {
         const auto& module = static_modules[i];
-        const FileSys::VirtualFile module_file{dir->GetFile(module)};
-        if (!module_file) {
+        if (!pending_images[i].valid()) {
             continue;
         }
+        images[i] = pending_images[i].get();
 
         const bool should_pass_arguments = std::strcmp(module, "rtld") == 0;
         const auto tentative_next_load_addr = AppLoader_NSO::LoadModule(
-            process, system, *module_file, code_size, should_pass_arguments, false, {},
+            process, system, *images[i], code_size, should_pass_arguments, false, {},
             patch_ctx.GetPatchers(), patch_ctx.GetLastIndex());
         if (!tentative_next_load_addr) {
             return {ResultStatus::ErrorLoadingNSO, {}};
@@ -236,16 +257,17 @@ AppLoader_DeconstructedRomDirectory::LoadResult AppLoader_DeconstructedRomDirect
                                    system.GetContentProvider()};
     for (size_t i = 0; i < static_modules.size(); i++) {
         const auto& module = static_modules[i];
-        const FileSys::VirtualFile module_file{dir->GetFile(module)};
-        if (!module_file) {
+        if (!images[i]) {
             continue;
         }
 
         const VAddr load_addr{next_load_addr};
         const bool should_pass_arguments = std::strcmp(module, "rtld") == 0;
         const auto tentative_next_load_addr = AppLoader_NSO::LoadModule(
-            process, system, *module_file, load_addr, should_pass_arguments, true, pm,
+            process, system, *images[i], load_addr, should_pass_arguments, true, pm,
             patch_ctx.GetPatchers(), patch_ctx.GetIndex(i));
+        // The image is no longer needed once copied into the process
+        images[i].reset();
         if (!tentative_next_load_addr) {
             return {ResultStatus::ErrorLoadingNSO, {}};
         }
@@ -73,24 +73,58 @@ FileType AppLoader_NSO::IdentifyType(const FileSys::VirtualFile& in_file) {
     return FileType::NSO;
 }
 
-std::optional<VAddr> AppLoader_NSO::LoadModule(Kernel::KProcess& process, Core::System& system,
-                                               const FileSys::VfsFile& nso_file, VAddr load_base,
-                                               bool should_pass_arguments, bool load_into_process,
-                                               std::optional<FileSys::PatchManager> pm,
-                                               std::vector<Core::NCE::Patcher>* patches,
-                                               s32 patch_index) {
+std::optional<NSOImage> AppLoader_NSO::ReadImage(const FileSys::VfsFile& nso_file) {
     if (nso_file.GetSize() < sizeof(NSOHeader)) {
         return std::nullopt;
     }
 
-    NSOHeader nso_header{};
-    if (sizeof(NSOHeader) != nso_file.ReadObject(&nso_header)) {
+    NSOImage image{};
+    if (sizeof(NSOHeader) != nso_file.ReadObject(&image.header)) {
         return std::nullopt;
     }
 
-    if (nso_header.magic != Common::MakeMagic('N', 'S', 'O', '0')) {
+    if (image.header.magic != Common::MakeMagic('N', 'S', 'O', '0')) {
+        return std::nullopt;
+    }
+
+    for (std::size_t i = 0; i < image.segments.size(); ++i) {
+        image.segments[i] = nso_file.ReadBytes(image.header.segments_compressed_size[i],
+                                               image.header.segments[i].offset);
+    }
+    image.name = nso_file.GetName();
+    return image;
+}
+
+void AppLoader_NSO::DecompressImage(NSOImage& image) {
+    for (std::size_t i = 0; i < image.segments.size(); ++i) {
+        if (image.header.IsSegmentCompressed(i)) {
+            image.segments[i] = DecompressSegment(image.segments[i], image.header.segments[i]);
+        }
+    }
+}
+
+std::optional<VAddr> AppLoader_NSO::LoadModule(Kernel::KProcess& process, Core::System& system,
+                                               const FileSys::VfsFile& nso_file, VAddr load_base,
+                                               bool should_pass_arguments, bool load_into_process,
+                                               std::optional<FileSys::PatchManager> pm,
+                                               std::vector<Core::NCE::Patcher>* patches,
+                                               s32 patch_index) {
+    auto image = ReadImage(nso_file);
+    if (!image) {
         return std::nullopt;
     }
+    DecompressImage(*image);
+    return LoadModule(process, system, *image, load_base, should_pass_arguments, load_into_process,
+                      std::move(pm), patches, patch_index);
+}
+
+std::optional<VAddr> AppLoader_NSO::LoadModule(Kernel::KProcess& process, Core::System& system,
+                                               const NSOImage& image, VAddr load_base,
+                                               bool should_pass_arguments, bool load_into_process,
+                                               std::optional<FileSys::PatchManager> pm,
+                                               std::vector<Core::NCE::Patcher>* patches,
+                                               s32 patch_index) {
+    const NSOHeader& nso_header = image.header;
 
     // Allocate some space at the beginning if we are patching in PreText mode.
     const size_t module_start = [&]() -> size_t {
@@ -109,11 +143,7 @@ std::optional<VAddr> AppLoader_NSO::LoadModule(Kernel::KProcess& process, Core::
     Kernel::CodeSet codeset;
     Kernel::PhysicalMemory program_image;
     for (std::size_t i = 0; i < nso_header.segments.size(); ++i) {
-        std::vector<u8> data = nso_file.ReadBytes(nso_header.segments_compressed_size[i],
-                                                  nso_header.segments[i].offset);
-        if (nso_header.IsSegmentCompressed(i)) {
-            data = DecompressSegment(data, nso_header.segments[i]);
-        }
+        const std::vector<u8>& data = image.segments[i];
         program_image.resize(module_start + nso_header.segments[i].location +
                              static_cast<u32>(data.size()));
         std::memcpy(program_image.data() + module_start + nso_header.segments[i].location,
@@ -147,7 +177,7 @@ std::optional<VAddr> AppLoader_NSO::LoadModule(Kernel::KProcess& process, Core::
     }
 
     // Apply patches if necessary
-    const auto name = nso_file.GetName();
+    const std::string& name = image.name;
     if (pm && (pm->HasNSOPatch(nso_header.build_id, name) || Settings::values.dump_nso)) {
         std::span<u8> patchable_section(program_image.data() + module_start,
                                         program_image.size() - module_start);
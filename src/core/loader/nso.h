@@ -5,7 +5,9 @@
 
 #include <array>
 #include <optional>
+#include <string>
 #include <type_traits>
+#include <vector>
 #include "common/common_types.h"
 #include "common/swap.h"
 #include "core/file_sys/patch_manager.h"
@@ -71,6 +73,13 @@ struct NSOArgumentHeader {
 };
 static_assert(sizeof(NSOArgumentHeader) == 0x20, "NSOArgumentHeader has incorrect size.");
 
+/// An NSO read into memory
+struct NSOImage {
+    NSOHeader header;
+    std::array<std::vector<u8>, 3> segments; ///< Compressed until DecompressImage is called
+    std::string name;
+};
+
 /// Loads an NSO file
 class AppLoader_NSO final : public AppLoader {
 public:
@@ -89,6 +98,12 @@ public:
         return IdentifyType(file);
     }
 
+    /// Reads the header and segments of an NSO, returns std::nullopt if it is not a valid NSO
+    static std::optional<NSOImage> ReadImage(const FileSys::VfsFile& nso_file);
+
+    /// Decompresses the segments of an image. Thread-safe, as it does not touch the file.
+    static void DecompressImage(NSOImage& image);
+
     static std::optional<VAddr> LoadModule(Kernel::KProcess& process, Core::System& system,
                                            const FileSys::VfsFile& nso_file, VAddr load_base,
                                            bool should_pass_arguments, bool load_into_process,
@@ -96,6 +111,14 @@ public:
                                            std::vector<Core::NCE::Patcher>* patches = nullptr,
                                            s32 patch_index = -1);
 
+    /// Loads a module from an image decompressed with DecompressImage
+    static std::optional<VAddr> LoadModule(Kernel::KProcess& process, Core::System& system,
+                                           const NSOImage& image, VAddr load_base,
+                                           bool should_pass_arguments, bool load_into_process,
+                                           std::optional<FileSys::PatchManager> pm = {},
+                                           std::vector<Core::NCE::Patcher>* patches = nullptr,
+                                           s32 patch_index = -1);
+
     LoadResult Load(Kernel::KProcess& process, Core::System& system) override;
 
     ResultStatus ReadNSOModules(Modules& out_modules) override;
@@ -128,7 +128,7 @@ struct Memory::Impl {
 
     [[nodiscard]] u8* GetPointerFromRasterizerCachedMemory(u64 vaddr) const {
         const Common::PhysicalAddress paddr{
-            current_page_table->backing_addr[vaddr >> YUZU_PAGEBITS]};
+            current_page_table->backing.Get(vaddr >> YUZU_PAGEBITS).backing_addr};
 
         if (!paddr) {
             return {};
@@ -139,7 +139,7 @@ struct Memory::Impl {
 
     [[nodiscard]] u8* GetPointerFromDebugMemory(u64 vaddr) const {
         const Common::PhysicalAddress paddr{
-            current_page_table->backing_addr[vaddr >> YUZU_PAGEBITS]};
+            current_page_table->backing.Get(vaddr >> YUZU_PAGEBITS).backing_addr};
 
         if (paddr == 0) {
             return {};
@@ -299,9 +299,41 @@ struct Memory::Impl {
         return user_accessible;
     }
 
+    /**
+     * Resolves a range backed by a single contiguous host mapping of plain memory in one walk.
+     * Pages of the same mapping store the same pointer, so the whole range is checked with one
+     * comparison per page.
+     *
+     * @returns The host memory of the range, or an empty span if the range has to be walked.
+     */
+    std::span<u8> GetPlainMemorySpan(const Common::ProcessAddress addr, const std::size_t size) {
+        const auto& page_table = *current_page_table;
+        if (size == 0 || !AddressSpaceContains(page_table, addr, size)) [[unlikely]] {
+            return {};
+        }
+        const std::size_t first_page = addr >> YUZU_PAGEBITS;
+        const std::size_t last_page = (addr + size - 1) >> YUZU_PAGEBITS;
+        const uintptr_t raw = page_table.pointers[first_page].Raw();
+        const uintptr_t pointer = Common::PageTable::PageInfo::ExtractPointer(raw);
+        if (pointer == 0 ||
+            Common::PageTable::PageInfo::ExtractType(raw) != Common::PageType::Memory) {
+            return {};
+        }
+        for (std::size_t page = first_page + 1; page <= last_page; ++page) {
+            if (page_table.pointers[page].Raw() != raw) {
+                return {};
+            }
+        }
+        return {reinterpret_cast<u8*>(pointer + GetInteger(addr)), size};
+    }
+
     template <bool UNSAFE>
     bool ReadBlockImpl(const Common::ProcessAddress src_addr, void* dest_buffer,
                        const std::size_t size) {
+        if (const std::span<u8> span = GetPlainMemorySpan(src_addr, size); !span.empty()) {
+            std::memcpy(dest_buffer, span.data(), size);
+            return true;
+        }
         return WalkBlock(
             src_addr, size,
             [src_addr, size, &dest_buffer](const std::size_t copy_amount,
@@ -337,16 +369,18 @@ struct Memory::Impl {
     }
 
     const u8* GetSpan(const VAddr src_addr, const std::size_t size) const {
-        if (current_page_table->blocks[src_addr >> YUZU_PAGEBITS] ==
-            current_page_table->blocks[(src_addr + size) >> YUZU_PAGEBITS]) {
+        const auto& backing = current_page_table->backing;
+        if (backing.Get(src_addr >> YUZU_PAGEBITS).block ==
+            backing.Get((src_addr + size) >> YUZU_PAGEBITS).block) {
             return GetPointerSilent(src_addr);
         }
         return nullptr;
     }
 
     u8* GetSpan(const VAddr src_addr, const std::size_t size) {
-        if (current_page_table->blocks[src_addr >> YUZU_PAGEBITS] ==
-            current_page_table->blocks[(src_addr + size) >> YUZU_PAGEBITS]) {
+        const auto& backing = current_page_table->backing;
+        if (backing.Get(src_addr >> YUZU_PAGEBITS).block ==
+            backing.Get((src_addr + size) >> YUZU_PAGEBITS).block) {
             return GetPointerSilent(src_addr);
         }
         return nullptr;
@@ -355,6 +389,10 @@ struct Memory::Impl {
     template <bool UNSAFE>
     bool WriteBlockImpl(const Common::ProcessAddress dest_addr, const void* src_buffer,
                         const std::size_t size) {
+        if (const std::span<u8> span = GetPlainMemorySpan(dest_addr, size); !span.empty()) {
+            std::memcpy(span.data(), src_buffer, size);
+            return true;
+        }
         return WalkBlock(
             dest_addr, size,
             [dest_addr, size](const std::size_t copy_amount,
@@ -389,6 +427,10 @@ struct Memory::Impl {
     }
 
     bool ZeroBlock(const Common::ProcessAddress dest_addr, const std::size_t size) {
+        if (const std::span<u8> span = GetPlainMemorySpan(dest_addr, size); !span.empty()) {
+            std::memset(span.data(), 0, size);
+            return true;
+        }
         return WalkBlock(
             dest_addr, size,
             [dest_addr, size](const std::size_t copy_amount,
@@ -550,16 +592,34 @@ struct Memory::Impl {
             return;
         }
 
-        if (current_page_table->fastmem_arena) {
-            Common::MemoryPermission perm{};
-            if (!Settings::values.use_reactive_flushing.GetValue() || !cached) {
-                perm |= Common::MemoryPermission::Read;
+        Common::MemoryPermission perm{};
+        if (!Settings::values.use_reactive_flushing.GetValue() || !cached) {
+            perm |= Common::MemoryPermission::Read;
+        }
+        if (!cached) {
+            perm |= Common::MemoryPermission::Write;
+        }
+
+        // Only pages changing state are reprotected, as several GPU regions can share a CPU page
+        // and most calls find the pages already in the requested state.
+        u64 protect_begin{};
+        u64 protect_bytes{};
+        const auto protect_pending = [&] {
+            if (protect_bytes > 0 && current_page_table->fastmem_arena) {
+                buffer->Protect(protect_begin, protect_bytes, perm);
             }
-            if (!cached) {
-                perm |= Common::MemoryPermission::Write;
+            protect_bytes = 0;
+        };
+        const auto mark_changed = [&](u64 page_vaddr) {
+            page_vaddr &= ~YUZU_PAGEMASK;
+            if (protect_bytes == 0) {
+                protect_begin = page_vaddr;
+            } else if (protect_begin + protect_bytes != page_vaddr) {
+                protect_pending();
+                protect_begin = page_vaddr;
             }
-            buffer->Protect(vaddr, size, perm);
-        }
+            protect_bytes += YUZU_PAGESIZE;
+        };
 
         // Iterate over a contiguous CPU address space, which corresponds to the specified GPU
         // address space, marking the region as un/cached. The region is marked un/cached at a
@@ -581,6 +641,7 @@ struct Memory::Impl {
                 case Common::PageType::Memory:
                     current_page_table->pointers[vaddr >> YUZU_PAGEBITS].Store(
                         0, Common::PageType::RasterizerCachedMemory);
+                    mark_changed(vaddr);
                     break;
                 case Common::PageType::RasterizerCachedMemory:
                     // There can be more than one GPU region mapped per CPU region, so it's common
@@ -613,6 +674,7 @@ struct Memory::Impl {
                         current_page_table->pointers[vaddr >> YUZU_PAGEBITS].Store(
                             reinterpret_cast<uintptr_t>(pointer) - (vaddr & ~YUZU_PAGEMASK),
                             Common::PageType::Memory);
+                        mark_changed(vaddr);
                     }
                     break;
                 }
@@ -621,6 +683,7 @@ struct Memory::Impl {
                 }
             }
         }
+        protect_pending();
     }
 
     /**
@@ -649,8 +712,7 @@ struct Memory::Impl {
 
             while (base != end) {
                 page_table.pointers[base].Store(0, type);
-                page_table.backing_addr[base] = 0;
-                page_table.blocks[base] = 0;
+                page_table.backing.Set(base, {});
                 base += 1;
             }
         } else {
@@ -661,8 +723,7 @@ struct Memory::Impl {
                     (base << YUZU_PAGEBITS);
                 auto backing = GetInteger(target) - (base << YUZU_PAGEBITS);
                 page_table.pointers[base].Store(host_ptr, type);
-                page_table.backing_addr[base] = backing;
-                page_table.blocks[base] = orig_base << YUZU_PAGEBITS;
+                page_table.backing.Set(base, {backing, orig_base << YUZU_PAGEBITS});
 
                 ASSERT_MSG(page_table.pointers[base].Pointer(),
                            "memory mapping base yield a nullptr within the table");
@@ -1034,6 +1095,10 @@ u8* Memory::GetSpan(const VAddr src_addr, const std::size_t size) {
     return impl->GetSpan(src_addr, size);
 }
 
+std::span<u8> Memory::GetPlainMemorySpan(Common::ProcessAddress vaddr, std::size_t size) {
+    return impl->GetPlainMemorySpan(vaddr, size);
+}
+
 bool Memory::WriteBlock(const Common::ProcessAddress dest_addr, const void* src_buffer,
                         const std::size_t size) {
     return impl->WriteBlock(dest_addr, src_buffer, size);
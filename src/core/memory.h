@@ -369,6 +369,19 @@ public:
     const u8* GetSpan(const VAddr src_addr, const std::size_t size) const;
     u8* GetSpan(const VAddr src_addr, const std::size_t size);
 
+    /**
+     * Gets the host memory backing a range of the current process' address space, when all of
+     * it is plain memory of a single contiguous mapping. Such memory is not tracked by the GPU,
+     * so it can be read and written in place without any cache maintenance.
+     *
+     * @param vaddr The virtual address of the range.
+     * @param size  The size of the range, in bytes.
+     *
+     * @returns The host memory of the range, or an empty span if it has to be accessed through
+     *          the block functions.
+     */
+    std::span<u8> GetPlainMemorySpan(Common::ProcessAddress vaddr, std::size_t size);
+
     /**
      * Writes a range of bytes into the current process' address space at the specified
      * virtual address.
@@ -221,6 +221,18 @@ void DmntCheatVm::LogOpcode(const CheatVmOpcode& opcode) {
 DmntCheatVm::Callbacks::~Callbacks() = default;
 
 bool DmntCheatVm::DecodeNextOpcode(CheatVmOpcode& out) {
+    // Opcodes are decoded once when the program is loaded, only decode failures are left
+    if (decode_success && instruction_ptr < decoded_program.size()) {
+        if (const auto& decoded = decoded_program[instruction_ptr]) {
+            out = decoded->opcode;
+            instruction_ptr = decoded->next_instruction_ptr;
+            return true;
+        }
+    }
+    return DecodeOpcode(out);
+}
+
+bool DmntCheatVm::DecodeOpcode(CheatVmOpcode& out) {
     // If we've ever seen a decode failure, return false.
     bool valid = decode_success;
     CheatVmOpcode opcode = {};
@@ -726,9 +738,28 @@ bool DmntCheatVm::LoadProgram(const std::vector<CheatEntry>& entries) {
         }
     }
 
+    PredecodeProgram();
     return true;
 }
 
+void DmntCheatVm::PredecodeProgram() {
+    // Jumps only ever land on the start of an opcode of the linear decode, so decode those once
+    decoded_program.assign(num_opcodes, std::nullopt);
+    instruction_ptr = 0;
+    decode_success = true;
+
+    CheatVmOpcode opcode{};
+    std::size_t opcode_start = instruction_ptr;
+    while (DecodeOpcode(opcode)) {
+        decoded_program[opcode_start] = DecodedOpcode{
+            .opcode = opcode,
+            .next_instruction_ptr = instruction_ptr,
+        };
+        opcode_start = instruction_ptr;
+    }
+    instruction_ptr = 0;
+}
+
 void DmntCheatVm::Execute(const CheatProcessMetadata& metadata) {
     CheatVmOpcode cur_opcode{};
 
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <optional>
 #include <variant>
 #include <vector>
 #include <fmt/printf.h>
@@ -308,7 +309,16 @@ private:
     std::array<u64, NumStaticRegisters> static_registers{};
     std::array<std::size_t, NumRegisters> loop_tops{};
 
+    struct DecodedOpcode {
+        CheatVmOpcode opcode;
+        std::size_t next_instruction_ptr;
+    };
+    /// Opcodes of the loaded program, indexed by the instruction pointer they start at
+    std::vector<std::optional<DecodedOpcode>> decoded_program;
+
     bool DecodeNextOpcode(CheatVmOpcode& out);
+    bool DecodeOpcode(CheatVmOpcode& out);
+    void PredecodeProgram();
     void SkipConditionalBlock(bool is_if);
     void ResetState();
 
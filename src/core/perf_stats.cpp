@@ -7,12 +7,12 @@
 #include <mutex>
 #include <numeric>
 #include <sstream>
-#include <thread>
 #include <fmt/chrono.h>
 #include <fmt/format.h>
 #include "common/fs/file.h"
 #include "common/fs/fs.h"
 #include "common/fs/path_util.h"
+#include "common/perf_metrics.h"
 #include "common/settings.h"
 #include "core/perf_stats.h"
 
@@ -21,10 +21,17 @@ using DoubleSecs = std::chrono::duration<double, std::chrono::seconds::period>;
 using std::chrono::duration_cast;
 using std::chrono::microseconds;
 
+namespace PerfMetrics = Common::PerfMetrics;
+
 // Purposefully ignore the first five frames, as there's a significant amount of overhead in
 // booting that we shouldn't account for
 constexpr std::size_t IgnoreFrames = 5;
 
+constexpr std::string_view METRICS_HEADER =
+    "seconds,game_fps,speed_percent,frametime_ms,input_latency_ms,system_fps,core0,core1,core2,"
+    "core3,gpu_thread,render_worker,pipelines_per_frame,staging_bytes_per_frame,"
+    "texture_evictions,adsp_margin_ms\n";
+
 namespace Core {
 
 PerfStats::PerfStats(u64 title_id_) : title_id(title_id_) {}
@@ -49,6 +56,15 @@ PerfStats::~PerfStats() {
                                 Common::FS::FileType::TextFile);
         void(file.WriteString(stream.str()));
     }
+
+    if (!metrics_report.empty()) {
+        const auto metrics_path =
+            path / fmt::format("{:%F-%H-%M}_{:016X}_metrics.csv", *std::localtime(&t), title_id);
+        Common::FS::IOFile file(metrics_path, Common::FS::FileAccessMode::Write,
+                                Common::FS::FileType::TextFile);
+        void(file.WriteString(METRICS_HEADER));
+        void(file.WriteString(metrics_report));
+    }
 }
 
 void PerfStats::BeginSystemFrame() {
@@ -77,6 +93,21 @@ void PerfStats::EndGameFrame() {
     game_frames.fetch_add(1, std::memory_order_relaxed);
 }
 
+void PerfStats::RecordPresentLatency(Clock::duration latency) {
+    std::scoped_lock lock{object_mutex};
+
+    accumulated_present_latency += latency;
+    presented_frames += 1;
+}
+
+void PerfStats::RecordAudioUnderrun() {
+    audio_underruns.fetch_add(1, std::memory_order_relaxed);
+}
+
+void PerfStats::RecordAudioOverrun() {
+    audio_overruns.fetch_add(1, std::memory_order_relaxed);
+}
+
 double PerfStats::GetMeanFrametime() const {
     std::scoped_lock lock{object_mutex};
 
@@ -99,13 +130,59 @@ PerfStatsResults PerfStats::GetAndResetStats(microseconds current_system_time_us
     const auto system_us_per_second = (current_system_time_us - reset_point_system_us) / interval;
     const auto current_frames = static_cast<double>(game_frames.load(std::memory_order_relaxed));
     const auto current_fps = current_frames / interval;
+    const auto frametime = duration_cast<DoubleSecs>(accumulated_frametime).count() /
+                           static_cast<double>(system_frames);
+    const auto present_latency =
+        presented_frames == 0 ? 0.0
+                              : duration_cast<DoubleSecs>(accumulated_present_latency).count() /
+                                    static_cast<double>(presented_frames);
+    const auto TakeShare = [interval](PerfMetrics::Counter counter) {
+        return static_cast<double>(PerfMetrics::Take(counter)) / (interval * 1'000'000'000.0);
+    };
+    const auto TakePerFrame = [current_frames](PerfMetrics::Counter counter) {
+        return static_cast<double>(PerfMetrics::Take(counter)) / std::max(current_frames, 1.0);
+    };
+    std::array<double, 4> core_utilization{};
+    for (size_t core = 0; core < core_utilization.size(); ++core) {
+        core_utilization[core] =
+            std::clamp(1.0 - TakeShare(PerfMetrics::CoreIdleCounter(core)), 0.0, 1.0);
+    }
+    const auto adsp_margin_us = PerfMetrics::Take(PerfMetrics::Minimum::AdspDeadlineMarginUs);
+    const std::array<u64, 3> cache_memory{
+        PerfMetrics::Get(PerfMetrics::Gauge::TextureCacheMemory),
+        PerfMetrics::Get(PerfMetrics::Gauge::BufferCacheMemory),
+        PerfMetrics::Get(PerfMetrics::Gauge::StagingPoolMemory),
+    };
+    const std::array<u64, 3> cache_budget{
+        PerfMetrics::Get(PerfMetrics::Gauge::TextureCacheBudget),
+        PerfMetrics::Get(PerfMetrics::Gauge::BufferCacheBudget),
+        PerfMetrics::Get(PerfMetrics::Gauge::StagingPoolBudget),
+    };
+
     const PerfStatsResults results{
         .system_fps = static_cast<double>(system_frames) / interval,
         .average_game_fps = (current_fps + previous_fps) / 2.0,
-        .frametime = duration_cast<DoubleSecs>(accumulated_frametime).count() /
-                     static_cast<double>(system_frames),
+        .frametime = frametime,
         .emulation_speed = system_us_per_second.count() / 1'000'000.0,
+        .input_latency = presented_frames == 0 ? 0.0 : frametime + present_latency,
+        .audio_underruns = audio_underruns.exchange(0, std::memory_order_relaxed),
+        .audio_overruns = audio_overruns.exchange(0, std::memory_order_relaxed),
+        .core_utilization = core_utilization,
+        .gpu_thread_busy = TakeShare(PerfMetrics::Counter::GpuThreadBusyNs),
+        .render_worker_busy = TakeShare(PerfMetrics::Counter::RenderWorkerBusyNs),
+        .pipelines_per_frame = TakePerFrame(PerfMetrics::Counter::PipelinesBuilt),
+        .staging_bytes_per_frame = TakePerFrame(PerfMetrics::Counter::StagingBytes),
+        .texture_evictions =
+            static_cast<u32>(PerfMetrics::Take(PerfMetrics::Counter::TextureEvictions)),
+        .cache_memory = cache_memory,
+        .cache_budget = cache_budget,
+        .adsp_deadline_margin =
+            adsp_margin_us ? std::make_optional(static_cast<double>(*adsp_margin_us) / 1e6)
+                           : std::nullopt,
     };
+    if (Settings::values.record_frame_times && title_id != 0) {
+        AppendMetricsRow(results, now);
+    }
 
     // Reset counters
     reset_point = now;
@@ -113,11 +190,30 @@ PerfStatsResults PerfStats::GetAndResetStats(microseconds current_system_time_us
     accumulated_frametime = Clock::duration::zero();
     system_frames = 0;
     game_frames.store(0, std::memory_order_relaxed);
+    accumulated_present_latency = Clock::duration::zero();
+    presented_frames = 0;
     previous_fps = current_fps;
 
     return results;
 }
 
+void PerfStats::AppendMetricsRow(const PerfStatsResults& results, Clock::time_point now) {
+    if (!metrics_begin) {
+        metrics_begin = now;
+    }
+    metrics_report += fmt::format(
+        "{:.3f},{:.2f},{:.2f},{:.3f},{:.4f},{:.1f},{:.3f},{:.3f},{:.3f},{:.3f},{:.3f},{:.3f},"
+        "{:.2f},{:.0f},{},{}\n",
+        duration_cast<DoubleSecs>(now - *metrics_begin).count(), results.average_game_fps,
+        results.emulation_speed * 100.0, results.frametime * 1000.0,
+        results.input_latency * 1000.0, results.system_fps, results.core_utilization[0],
+        results.core_utilization[1], results.core_utilization[2], results.core_utilization[3],
+        results.gpu_thread_busy, results.render_worker_busy, results.pipelines_per_frame,
+        results.staging_bytes_per_frame, results.texture_evictions,
+        results.adsp_deadline_margin ? fmt::format("{:.3f}", *results.adsp_deadline_margin * 1000.0)
+                                     : std::string{});
+}
+
 double PerfStats::GetLastFrameTimeScale() const {
     std::scoped_lock lock{object_mutex};
 
@@ -125,6 +221,34 @@ double PerfStats::GetLastFrameTimeScale() const {
     return duration_cast<DoubleSecs>(previous_frame_length).count() / FRAME_LENGTH;
 }
 
+std::string FormatPerfMetrics(const PerfStatsResults& results) {
+    std::string text;
+    if (Settings::values.use_multi_core.GetValue()) {
+        text = fmt::format("CPU {:.0f}/{:.0f}/{:.0f}/{:.0f}% | ",
+                           results.core_utilization[0] * 100.0,
+                           results.core_utilization[1] * 100.0,
+                           results.core_utilization[2] * 100.0,
+                           results.core_utilization[3] * 100.0);
+    }
+    text += fmt::format("GPU thread {:.0f}% | Render worker {:.0f}% | Pipelines {:.2f}/frame | "
+                        "Staging {:.2f} MiB/frame | Evictions {}",
+                        results.gpu_thread_busy * 100.0, results.render_worker_busy * 100.0,
+                        results.pipelines_per_frame,
+                        results.staging_bytes_per_frame / (1024.0 * 1024.0),
+                        results.texture_evictions);
+    if (results.cache_budget[0] != 0) {
+        const auto ToMiB = [](u64 bytes) { return bytes >> 20; };
+        text += fmt::format(" | VRAM tex {}/{} buf {}/{} staging {}/{} MiB",
+                            ToMiB(results.cache_memory[0]), ToMiB(results.cache_budget[0]),
+                            ToMiB(results.cache_memory[1]), ToMiB(results.cache_budget[1]),
+                            ToMiB(results.cache_memory[2]), ToMiB(results.cache_budget[2]));
+    }
+    if (results.adsp_deadline_margin) {
+        text += fmt::format(" | ADSP margin {:.2f} ms", *results.adsp_deadline_margin * 1000.0);
+    }
+    return text;
+}
+
 void SpeedLimiter::DoSpeedLimiting(microseconds current_system_time_us) {
     if (Settings::values.use_multi_core.GetValue() ||
         !Settings::values.use_speed_limit.GetValue()) {
@@ -149,7 +273,7 @@ void SpeedLimiter::DoSpeedLimiting(microseconds current_system_time_us) {
         std::clamp(speed_limiting_delta_err, -max_lag_time_us, max_lag_time_us);
 
     if (speed_limiting_delta_err > microseconds::zero()) {
-        std::this_thread::sleep_for(speed_limiting_delta_err);
+        waiter.WaitUntil(now + speed_limiting_delta_err);
         auto now_after_sleep = Clock::now();
         speed_limiting_delta_err -= duration_cast<microseconds>(now_after_sleep - now);
         now = now_after_sleep;
@@ -8,7 +8,10 @@
 #include <chrono>
 #include <cstddef>
 #include <mutex>
+#include <optional>
+#include <string>
 #include "common/common_types.h"
+#include "common/precise_wait.h"
 
 namespace Core {
 
@@ -21,12 +24,40 @@ struct PerfStatsResults {
     double frametime;
     /// Ratio of walltime / emulated time elapsed
     double emulation_speed;
+    /// Estimated input to photon latency in seconds, the walltime per system frame plus the time
+    /// taken to present it. Zero when the renderer does not measure presentation.
+    double input_latency;
+    /// Number of times the audio backend ran out of samples to play
+    u32 audio_underruns;
+    /// Number of times samples were dropped as the audio backend's buffer was full
+    u32 audio_overruns;
+    /// Share of walltime each emulated core was not idle. Only measured with multicore.
+    std::array<double, 4> core_utilization;
+    /// Share of walltime the GPU thread spent processing commands
+    double gpu_thread_busy;
+    /// Share of walltime the renderer's command recording worker was busy
+    double render_worker_busy;
+    /// Pipelines built per game frame
+    double pipelines_per_frame;
+    /// Bytes of staging memory requested per game frame
+    double staging_bytes_per_frame;
+    /// Number of images evicted from the texture cache
+    u32 texture_evictions;
+    /// Memory used by the texture, buffer and staging caches, and the share of the device memory
+    /// budget given to each, in bytes. Shares are zero when the renderer doesn't coordinate them.
+    std::array<u64, 3> cache_memory;
+    std::array<u64, 3> cache_budget;
+    /// Smallest time left to the audio renderer's deadline, in seconds, negative when missed
+    std::optional<double> adsp_deadline_margin;
 };
 
 /**
  * Class to manage and query performance/timing statistics. All public functions of this class are
  * thread-safe unless stated otherwise.
  */
+/// Formats the detailed metrics of the results on one line, for performance overlays
+[[nodiscard]] std::string FormatPerfMetrics(const PerfStatsResults& results);
+
 class PerfStats {
 public:
     explicit PerfStats(u64 title_id_);
@@ -38,6 +69,14 @@ public:
     void EndSystemFrame();
     void EndGameFrame();
 
+    /// Records the walltime between the renderer starting a frame and presenting it
+    void RecordPresentLatency(Clock::duration latency);
+
+    /// Records an audio underrun. Wait-free, so it may be called from realtime audio callbacks.
+    void RecordAudioUnderrun();
+    /// Records an audio overrun. Wait-free, so it may be called from realtime audio callbacks.
+    void RecordAudioOverrun();
+
     PerfStatsResults GetAndResetStats(std::chrono::microseconds current_system_time_us);
 
     /**
@@ -52,6 +91,8 @@ public:
     double GetLastFrameTimeScale() const;
 
 private:
+    void AppendMetricsRow(const PerfStatsResults& results, Clock::time_point now);
+
     mutable std::mutex object_mutex;
 
     /// Title ID for the game that is running. 0 if there is no game running yet
@@ -73,6 +114,14 @@ private:
     u32 system_frames = 0;
     /// Cumulative number of game frames (GSP frame submissions) since last reset
     std::atomic<u32> game_frames = 0;
+    /// Cumulative presentation latency of frames presented since last reset
+    Clock::duration accumulated_present_latency = Clock::duration::zero();
+    /// Cumulative number of frames with a measured presentation latency since last reset
+    u32 presented_frames = 0;
+    /// Cumulative number of audio underruns since last reset
+    std::atomic<u32> audio_underruns = 0;
+    /// Cumulative number of audio overruns since last reset
+    std::atomic<u32> audio_overruns = 0;
 
     /// Point when the previous system frame ended
     Clock::time_point previous_frame_end = reset_point;
@@ -82,6 +131,11 @@ private:
     Clock::duration previous_frame_length = Clock::duration::zero();
     /// Previously computed fps
     double previous_fps = 0;
+
+    /// Point when the stats were first read, the origin of the metrics report
+    std::optional<Clock::time_point> metrics_begin;
+    /// CSV rows of the stats read so far, written when frame times are recorded
+    std::string metrics_report;
 };
 
 class SpeedLimiter {
@@ -98,6 +152,8 @@ private:
 
     /// Accumulated difference between walltime and emulated time
     std::chrono::microseconds speed_limiting_delta_err{0};
+
+    Common::PreciseWaiter waiter{"SpeedLimiter"};
 };
 
 } // namespace Core
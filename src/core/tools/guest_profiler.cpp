@@ -0,0 +1,194 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include "common/fs/fs.h"
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
+#include "common/thread.h"
+#include "core/arm/debug.h"
+#include "core/core.h"
+#include "core/hle/kernel/kernel.h"
+#include "core/hle/kernel/physical_core.h"
+#include "core/tools/guest_profiler.h"
+
+namespace Tools {
+namespace {
+
+constexpr auto sample_period = std::chrono::milliseconds{1};
+constexpr std::size_t max_stack_depth = 64;
+
+std::string_view ActivityName(Kernel::CoreActivity activity) {
+    switch (activity) {
+    case Kernel::CoreActivity::Host:
+        return "host";
+    case Kernel::CoreActivity::Guest:
+        return "guest";
+    case Kernel::CoreActivity::SupervisorCall:
+        return "svc";
+    case Kernel::CoreActivity::Idle:
+        return "idle";
+    }
+    return "unknown";
+}
+
+std::string FrameName(const Core::BacktraceEntry& entry) {
+    if (entry.name.empty()) {
+        return fmt::format("{}+{:#x}", entry.module, entry.offset);
+    }
+    return fmt::format("{}!{}", entry.module, entry.name);
+}
+
+} // Anonymous namespace
+
+GuestProfiler::GuestProfiler(Core::System& system_)
+    : system{system_}, sampling_thread{[this](std::stop_token stop_token) {
+          SamplingLoop(stop_token);
+      }} {
+    LOG_INFO(Core, "Guest CPU profiler started");
+}
+
+GuestProfiler::~GuestProfiler() {
+    Stop();
+}
+
+void GuestProfiler::Stop() {
+    if (!sampling_thread.joinable()) {
+        return;
+    }
+    sampling_thread.request_stop();
+    sampling_thread.join();
+    WriteReport();
+}
+
+void GuestProfiler::RecordActivity(std::size_t core, Kernel::CoreActivity activity) {
+    std::scoped_lock lk{samples_mutex};
+    ++activity_samples[core][static_cast<std::size_t>(activity)];
+}
+
+void GuestProfiler::RecordGuestSample(std::size_t core, Kernel::KProcess* process,
+                                      const Kernel::Svc::ThreadContext& ctx) {
+    std::vector<u64> stack;
+    if (process == system.ApplicationProcess()) {
+        stack = Core::GetBacktraceAddresses(process, ctx, max_stack_depth);
+    }
+    std::scoped_lock lk{samples_mutex};
+    ++guest_samples[core][std::move(stack)];
+}
+
+void GuestProfiler::SamplingLoop(std::stop_token stop_token) {
+    Common::SetCurrentThreadName("GuestProfiler");
+    auto& kernel = system.Kernel();
+    while (!stop_token.stop_requested()) {
+        for (std::size_t core = 0; core < Core::Hardware::NUM_CPU_CORES; ++core) {
+            kernel.PhysicalCore(core).RequestSample(*this);
+        }
+        std::this_thread::sleep_for(sample_period);
+    }
+}
+
+void GuestProfiler::WriteReport() {
+    std::scoped_lock lk{samples_mutex};
+    Kernel::KProcess* const process = system.ApplicationProcess();
+    if (process == nullptr) {
+        return;
+    }
+
+    // Resolve every sampled address once.
+    std::vector<Core::BacktraceEntry> entries;
+    for (const auto& stacks : guest_samples) {
+        for (const auto& [stack, count] : stacks) {
+            for (const u64 address : stack) {
+                entries.push_back({"", 0, address, 0, ""});
+            }
+        }
+    }
+    std::ranges::sort(entries, {}, &Core::BacktraceEntry::original_address);
+    const auto [first, last] =
+        std::ranges::unique(entries, {}, &Core::BacktraceEntry::original_address);
+    entries.erase(first, last);
+    Core::SymbolicateBacktrace(process, entries);
+
+    std::unordered_map<u64, std::string> frame_names;
+    for (const auto& entry : entries) {
+        frame_names.emplace(entry.original_address, FrameName(entry));
+    }
+
+    std::string report;
+    std::array<u64, NUM_ACTIVITIES> activity_totals{};
+    std::map<std::string_view, u64> leaf_totals;
+    u64 total_samples{};
+    for (std::size_t core = 0; core < Core::Hardware::NUM_CPU_CORES; ++core) {
+        for (std::size_t activity = 0; activity < NUM_ACTIVITIES; ++activity) {
+            const u64 count = activity_samples[core][activity];
+            if (count == 0) {
+                continue;
+            }
+            const auto name = ActivityName(static_cast<Kernel::CoreActivity>(activity));
+            report += fmt::format("core{};{} {}\n", core, name, count);
+            activity_totals[activity] += count;
+            total_samples += count;
+        }
+        for (const auto& [stack, count] : guest_samples[core]) {
+            report += fmt::format("core{};guest", core);
+            if (stack.empty()) {
+                report += ";[other process]";
+            }
+            for (auto it = stack.rbegin(); it != stack.rend(); ++it) {
+                report += fmt::format(";{}", frame_names.at(*it));
+            }
+            report += fmt::format(" {}\n", count);
+
+            activity_totals[static_cast<std::size_t>(Kernel::CoreActivity::Guest)] += count;
+            total_samples += count;
+            if (!stack.empty()) {
+                leaf_totals[frame_names.at(stack.front())] += count;
+            }
+        }
+    }
+    if (total_samples == 0) {
+        return;
+    }
+
+    const auto percent = [total_samples](u64 count) {
+        return static_cast<double>(count) * 100.0 / static_cast<double>(total_samples);
+    };
+    LOG_INFO(Core, "Guest CPU profile of {} samples:", total_samples);
+    for (std::size_t activity = 0; activity < NUM_ACTIVITIES; ++activity) {
+        LOG_INFO(Core, "  {:<8} {:>6.2f}%",
+                 ActivityName(static_cast<Kernel::CoreActivity>(activity)),
+                 percent(activity_totals[activity]));
+    }
+    std::vector<std::pair<std::string_view, u64>> hottest(leaf_totals.begin(), leaf_totals.end());
+    std::ranges::sort(hottest, std::ranges::greater{}, &std::pair<std::string_view, u64>::second);
+    hottest.resize(std::min<std::size_t>(hottest.size(), 10));
+    for (const auto& [name, count] : hottest) {
+        LOG_INFO(Core, "  {:>6.2f}% {}", percent(count), name);
+    }
+
+    const auto dump_dir = Common::FS::GetYuzuPath(Common::FS::YuzuPath::DumpDir);
+    if (!Common::FS::CreateDir(dump_dir)) {
+        LOG_ERROR(Common_Filesystem, "Failed to create dump directory");
+        return;
+    }
+    const auto path = dump_dir / "cpu_profile.folded";
+    std::ofstream report_file(path, std::ios::out | std::ios::trunc);
+    if (!report_file) {
+        LOG_ERROR(Common_Filesystem, "Unable to open or create file at {}",
+                  Common::FS::PathToUTF8String(path));
+        return;
+    }
+    report_file << report;
+    LOG_INFO(Core, "Guest CPU profile written to {}", Common::FS::PathToUTF8String(path));
+}
+
+} // namespace Tools
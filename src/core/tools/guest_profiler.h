@@ -0,0 +1,67 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+#include "common/common_types.h"
+#include "core/hardware_properties.h"
+#include "core/hle/kernel/svc_types.h"
+
+namespace Core {
+class System;
+}
+
+namespace Kernel {
+enum class CoreActivity : u8;
+class KProcess;
+} // namespace Kernel
+
+namespace Tools {
+
+/**
+ * This class periodically samples what each emulated CPU core is doing. Cores running guest code
+ * are briefly halted to walk the frame records of the running thread, cores outside of guest code
+ * are attributed to supervisor calls, other host code or idling.
+ *
+ * When stopped, the samples are written as folded stacks, which can be turned into a flame graph.
+ */
+class GuestProfiler {
+public:
+    explicit GuestProfiler(Core::System& system_);
+    ~GuestProfiler();
+
+    // Stops sampling and writes the report. The application process must still be alive.
+    void Stop();
+
+    // Records a sample of a core outside of guest code.
+    void RecordActivity(std::size_t core, Kernel::CoreActivity activity);
+
+    // Records a sample of a core halted in guest code.
+    void RecordGuestSample(std::size_t core, Kernel::KProcess* process,
+                           const Kernel::Svc::ThreadContext& ctx);
+
+private:
+    static constexpr std::size_t NUM_ACTIVITIES = 4;
+
+    void SamplingLoop(std::stop_token stop_token);
+    void WriteReport();
+
+    Core::System& system;
+
+    std::mutex samples_mutex;
+    std::array<std::array<u64, NUM_ACTIVITIES>, Core::Hardware::NUM_CPU_CORES> activity_samples{};
+    // Guest stacks are stored leaf first, samples of other processes use an empty stack
+    std::array<std::map<std::vector<u64>, u64>, Core::Hardware::NUM_CPU_CORES> guest_samples;
+
+    std::jthread sampling_thread;
+};
+
+} // namespace Tools
@@ -140,20 +140,15 @@ inline InstallResult InstallNSP(Core::System& system, FileSys::VfsFilesystem& vf
         if (src == nullptr || dest == nullptr) {
             return false;
         }
-        if (!dest->Resize(src->GetSize())) {
-            return false;
-        }
 
+        // The source is read ahead while writing, the callback still runs on the calling thread
         using namespace Common::Literals;
-        std::vector<u8> buffer(1_MiB);
-
-        for (std::size_t i = 0; i < src->GetSize(); i += buffer.size()) {
-            if (callback(src->GetSize(), i)) {
-                dest->Resize(0);
-                return false;
-            }
-            const auto read = src->Read(buffer.data(), buffer.size(), i);
-            dest->Write(buffer.data(), read, i);
+        const auto on_block = [&](std::span<const u8>, std::size_t offset) {
+            return !callback(src->GetSize(), offset);
+        };
+        if (!FileSys::VfsPipelinedCopy(src, dest, 1_MiB, on_block)) {
+            dest->Resize(0);
+            return false;
         }
         return true;
     };
@@ -206,20 +201,15 @@ inline InstallResult InstallNCA(FileSys::VfsFilesystem& vfs, const std::string&
         if (src == nullptr || dest == nullptr) {
             return false;
         }
-        if (!dest->Resize(src->GetSize())) {
-            return false;
-        }
 
+        // The source is read ahead while writing, the callback still runs on the calling thread
         using namespace Common::Literals;
-        std::vector<u8> buffer(1_MiB);
-
-        for (std::size_t i = 0; i < src->GetSize(); i += buffer.size()) {
-            if (callback(src->GetSize(), i)) {
-                dest->Resize(0);
-                return false;
-            }
-            const auto read = src->Read(buffer.data(), buffer.size(), i);
-            dest->Write(buffer.data(), read, i);
+        const auto on_block = [&](std::span<const u8>, std::size_t offset) {
+            return !callback(src->GetSize(), offset);
+        };
+        if (!FileSys::VfsPipelinedCopy(src, dest, 1_MiB, on_block)) {
+            dest->Resize(0);
+            return false;
         }
         return true;
     };
@@ -1,12 +1,16 @@
 // SPDX-FileCopyrightText: Copyright 2023 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-3.0-or-later
 
+#include <algorithm>
+
 #include "common/logging/log.h"
+#include "common/settings.h"
 #include "core/core.h"
 #include "core/core_timing.h"
 #include "core/hle/service/ipc_helpers.h"
 #include "core/hle/service/set/system_settings_server.h"
 #include "core/hle/service/sm/sm.h"
+#include "hid_core/frontend/emulated_devices.h"
 #include "hid_core/hid_core.h"
 #include "hid_core/hid_util.h"
 #include "hid_core/resource_manager.h"
@@ -46,6 +50,10 @@ constexpr auto npad_update_ns = std::chrono::nanoseconds{1 * 1000 * 1000};    //
 constexpr auto default_update_ns = std::chrono::nanoseconds{4 * 1000 * 1000}; // (4ms, 1000Hz)
 constexpr auto mouse_keyboard_update_ns = std::chrono::nanoseconds{8 * 1000 * 1000}; // (8ms, 125Hz)
 constexpr auto motion_update_ns = std::chrono::nanoseconds{5 * 1000 * 1000};         // (5ms, 200Hz)
+// Minimum period between the updates triggered by input, matching the npad update rate
+constexpr auto input_update_ns = npad_update_ns;
+// Number of input triggered updates the reported latency is averaged over
+constexpr u64 input_latency_report_samples = 1000;
 
 ResourceManager::ResourceManager(Core::System& system_,
                                  std::shared_ptr<HidFirmwareSettings> settings)
@@ -80,6 +88,13 @@ ResourceManager::ResourceManager(Core::System& system_,
             UpdateMotion(ns_late);
             return std::nullopt;
         });
+    mouse_keyboard_input_event = Core::Timing::CreateEvent(
+        "HID::UpdateMouseKeyboardOnInputCallback",
+        [this](s64 time,
+               std::chrono::nanoseconds ns_late) -> std::optional<std::chrono::nanoseconds> {
+            UpdateMouseKeyboardOnInput();
+            return std::nullopt;
+        });
 }
 
 ResourceManager::~ResourceManager() {
@@ -88,6 +103,10 @@ ResourceManager::~ResourceManager() {
     system.CoreTiming().UnscheduleEvent(mouse_keyboard_update_event);
     system.CoreTiming().UnscheduleEvent(motion_update_event);
     system.CoreTiming().UnscheduleEvent(touch_update_event);
+    if (devices_callback_key != -1) {
+        system.HIDCore().GetEmulatedDevices()->DeleteCallback(devices_callback_key);
+    }
+    system.CoreTiming().UnscheduleEvent(mouse_keyboard_input_event);
     input_event->Finalize();
 };
 
@@ -255,6 +274,13 @@ void ResourceManager::InitializeHidCommonSampler() {
                                              mouse_keyboard_update_event);
     system.CoreTiming().ScheduleLoopingEvent(motion_update_ns, motion_update_ns,
                                              motion_update_event);
+
+    // Input arriving just after a mouse and keyboard update would otherwise wait a whole period
+    if (Settings::values.immediate_hid_updates.GetValue()) {
+        devices_callback_key = system.HIDCore().GetEmulatedDevices()->SetCallback({
+            .on_change = [this](Core::HID::DeviceTriggerType) { OnMouseKeyboardInput(); },
+        });
+    }
 }
 
 void ResourceManager::InitializeTouchScreenSampler() {
@@ -491,6 +517,43 @@ void ResourceManager::UpdateMouseKeyboard(std::chrono::nanoseconds ns_late) {
     mouse->OnUpdate(core_timing);
     debug_mouse->OnUpdate(core_timing);
     keyboard->OnUpdate(core_timing);
+    last_mouse_keyboard_update_ns.store(core_timing.GetGlobalTimeNs().count(),
+                                        std::memory_order_relaxed);
+}
+
+void ResourceManager::OnMouseKeyboardInput() {
+    if (is_input_update_pending.exchange(true, std::memory_order_acq_rel)) {
+        return;
+    }
+    const auto host_now = std::chrono::steady_clock::now().time_since_epoch();
+    pending_input_host_ns.store(std::chrono::nanoseconds{host_now}.count(),
+                                std::memory_order_relaxed);
+
+    // Don't update more often than the hardware would sample
+    auto& core_timing = system.CoreTiming();
+    const auto since_update =
+        core_timing.GetGlobalTimeNs() -
+        std::chrono::nanoseconds{last_mouse_keyboard_update_ns.load(std::memory_order_relaxed)};
+    const auto delay = std::max(std::chrono::nanoseconds{0}, input_update_ns - since_update);
+    core_timing.ScheduleEvent(delay, mouse_keyboard_input_event);
+}
+
+void ResourceManager::UpdateMouseKeyboardOnInput() {
+    is_input_update_pending.store(false, std::memory_order_release);
+    UpdateMouseKeyboard(std::chrono::nanoseconds{0});
+
+    const auto host_now = std::chrono::steady_clock::now().time_since_epoch();
+    const auto latency = std::chrono::nanoseconds{host_now} -
+                         std::chrono::nanoseconds{pending_input_host_ns.load(
+                             std::memory_order_relaxed)};
+    input_latency_total_us +=
+        std::chrono::duration_cast<std::chrono::microseconds>(latency).count();
+    if (++num_input_latency_samples == input_latency_report_samples) {
+        LOG_DEBUG(Service_HID, "Average input to shared memory latency: {} us",
+                  input_latency_total_us / num_input_latency_samples);
+        input_latency_total_us = 0;
+        num_input_latency_samples = 0;
+    }
 }
 
 void ResourceManager::UpdateMotion(std::chrono::nanoseconds ns_late) {
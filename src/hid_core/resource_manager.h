@@ -3,6 +3,9 @@
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
+
 #include "core/hle/service/kernel_helpers.h"
 #include "core/hle/service/service.h"
 
@@ -122,6 +125,10 @@ private:
     void InitializeConsoleSixAxisSampler();
     void InitializeAHidSampler();
 
+    /// Called by the input thread when the mouse or keyboard state changes
+    void OnMouseKeyboardInput();
+    void UpdateMouseKeyboardOnInput();
+
     bool is_initialized{false};
 
     mutable std::recursive_mutex shared_mutex;
@@ -152,6 +159,15 @@ private:
     std::shared_ptr<Core::Timing::EventType> mouse_keyboard_update_event;
     std::shared_ptr<Core::Timing::EventType> motion_update_event;
 
+    // Mouse and keyboard updates triggered by input, when immediate_hid_updates is enabled
+    std::shared_ptr<Core::Timing::EventType> mouse_keyboard_input_event;
+    std::atomic<s64> last_mouse_keyboard_update_ns{};
+    std::atomic<s64> pending_input_host_ns{};
+    std::atomic_bool is_input_update_pending{};
+    int devices_callback_key{-1};
+    u64 input_latency_total_us{};
+    u64 num_input_latency_samples{};
+
     // TODO: Create these resources
     // std::shared_ptr<AudioControl> audio_control{nullptr};
     // std::shared_ptr<ButtonConfig> button_config{nullptr};
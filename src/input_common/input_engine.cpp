@@ -256,7 +256,7 @@ void InputEngine::ResetAnalogState() {
 
 void InputEngine::TriggerOnButtonChange(const PadIdentifier& identifier, int button, bool value) {
     std::scoped_lock lock{mutex_callback};
-    for (const auto& poller_pair : callback_list) {
+    for (const auto& poller_pair : GetCallbacks(EngineInputType::Button)) {
         const InputIdentifier& poller = poller_pair.second;
         if (!IsInputIdentifierEqual(poller, identifier, EngineInputType::Button, button)) {
             continue;
@@ -284,7 +284,7 @@ void InputEngine::TriggerOnButtonChange(const PadIdentifier& identifier, int but
 
 void InputEngine::TriggerOnHatButtonChange(const PadIdentifier& identifier, int button, u8 value) {
     std::scoped_lock lock{mutex_callback};
-    for (const auto& poller_pair : callback_list) {
+    for (const auto& poller_pair : GetCallbacks(EngineInputType::HatButton)) {
         const InputIdentifier& poller = poller_pair.second;
         if (!IsInputIdentifierEqual(poller, identifier, EngineInputType::HatButton, button)) {
             continue;
@@ -313,7 +313,7 @@ void InputEngine::TriggerOnHatButtonChange(const PadIdentifier& identifier, int
 
 void InputEngine::TriggerOnAxisChange(const PadIdentifier& identifier, int axis, f32 value) {
     std::scoped_lock lock{mutex_callback};
-    for (const auto& poller_pair : callback_list) {
+    for (const auto& poller_pair : GetCallbacks(EngineInputType::Analog)) {
         const InputIdentifier& poller = poller_pair.second;
         if (!IsInputIdentifierEqual(poller, identifier, EngineInputType::Analog, axis)) {
             continue;
@@ -340,7 +340,7 @@ void InputEngine::TriggerOnAxisChange(const PadIdentifier& identifier, int axis,
 void InputEngine::TriggerOnBatteryChange(const PadIdentifier& identifier,
                                          [[maybe_unused]] Common::Input::BatteryLevel value) {
     std::scoped_lock lock{mutex_callback};
-    for (const auto& poller_pair : callback_list) {
+    for (const auto& poller_pair : GetCallbacks(EngineInputType::Battery)) {
         const InputIdentifier& poller = poller_pair.second;
         if (!IsInputIdentifierEqual(poller, identifier, EngineInputType::Battery, 0)) {
             continue;
@@ -354,7 +354,7 @@ void InputEngine::TriggerOnBatteryChange(const PadIdentifier& identifier,
 void InputEngine::TriggerOnColorChange(const PadIdentifier& identifier,
                                        [[maybe_unused]] Common::Input::BodyColorStatus value) {
     std::scoped_lock lock{mutex_callback};
-    for (const auto& poller_pair : callback_list) {
+    for (const auto& poller_pair : GetCallbacks(EngineInputType::Color)) {
         const InputIdentifier& poller = poller_pair.second;
         if (!IsInputIdentifierEqual(poller, identifier, EngineInputType::Color, 0)) {
             continue;
@@ -368,7 +368,7 @@ void InputEngine::TriggerOnColorChange(const PadIdentifier& identifier,
 void InputEngine::TriggerOnMotionChange(const PadIdentifier& identifier, int motion,
                                         const BasicMotion& value) {
     std::scoped_lock lock{mutex_callback};
-    for (const auto& poller_pair : callback_list) {
+    for (const auto& poller_pair : GetCallbacks(EngineInputType::Motion)) {
         const InputIdentifier& poller = poller_pair.second;
         if (!IsInputIdentifierEqual(poller, identifier, EngineInputType::Motion, motion)) {
             continue;
@@ -407,7 +407,7 @@ void InputEngine::TriggerOnMotionChange(const PadIdentifier& identifier, int mot
 void InputEngine::TriggerOnCameraChange(const PadIdentifier& identifier,
                                         [[maybe_unused]] const Common::Input::CameraStatus& value) {
     std::scoped_lock lock{mutex_callback};
-    for (const auto& poller_pair : callback_list) {
+    for (const auto& poller_pair : GetCallbacks(EngineInputType::Camera)) {
         const InputIdentifier& poller = poller_pair.second;
         if (!IsInputIdentifierEqual(poller, identifier, EngineInputType::Camera, 0)) {
             continue;
@@ -421,7 +421,7 @@ void InputEngine::TriggerOnCameraChange(const PadIdentifier& identifier,
 void InputEngine::TriggerOnNfcChange(const PadIdentifier& identifier,
                                      [[maybe_unused]] const Common::Input::NfcStatus& value) {
     std::scoped_lock lock{mutex_callback};
-    for (const auto& poller_pair : callback_list) {
+    for (const auto& poller_pair : GetCallbacks(EngineInputType::Nfc)) {
         const InputIdentifier& poller = poller_pair.second;
         if (!IsInputIdentifierEqual(poller, identifier, EngineInputType::Nfc, 0)) {
             continue;
@@ -461,7 +461,8 @@ const std::string& InputEngine::GetEngineName() const {
 
 int InputEngine::SetCallback(InputIdentifier input_identifier) {
     std::scoped_lock lock{mutex_callback};
-    callback_list.insert_or_assign(last_callback_key, std::move(input_identifier));
+    const auto type = static_cast<size_t>(input_identifier.type);
+    callback_list[type].insert_or_assign(last_callback_key, std::move(input_identifier));
     return last_callback_key++;
 }
 
@@ -472,12 +473,12 @@ void InputEngine::SetMappingCallback(MappingCallback callback) {
 
 void InputEngine::DeleteCallback(int key) {
     std::scoped_lock lock{mutex_callback};
-    const auto& iterator = callback_list.find(key);
-    if (iterator == callback_list.end()) {
-        LOG_ERROR(Input, "Tried to delete non-existent callback {}", key);
-        return;
+    for (auto& type_callbacks : callback_list) {
+        if (type_callbacks.erase(key) != 0) {
+            return;
+        }
     }
-    callback_list.erase(iterator);
+    LOG_ERROR(Input, "Tried to delete non-existent callback {}", key);
 }
 
 } // namespace InputCommon
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <array>
 #include <functional>
 #include <mutex>
 #include <unordered_map>
@@ -45,6 +46,7 @@ enum class EngineInputType {
     Motion,
     Nfc,
 };
+constexpr size_t NumEngineInputTypes = static_cast<size_t>(EngineInputType::Nfc) + 1;
 
 struct VibrationRequest {
     PadIdentifier identifier;
@@ -293,13 +295,18 @@ private:
                                 const PadIdentifier& identifier, EngineInputType type,
                                 int index) const;
 
+    const std::unordered_map<int, InputIdentifier>& GetCallbacks(EngineInputType type) const {
+        return callback_list[static_cast<size_t>(type)];
+    }
+
     mutable std::mutex mutex;
     mutable std::mutex mutex_callback;
     bool configuring{false};
     const std::string input_engine;
     int last_callback_key = 0;
     std::unordered_map<PadIdentifier, ControllerData> controller_list;
-    std::unordered_map<int, InputIdentifier> callback_list;
+    /// Callbacks indexed by input type, so high rate inputs like motion only walk their own pollers
+    std::array<std::unordered_map<int, InputIdentifier>, NumEngineInputTypes> callback_list;
     MappingCallback mapping_callback;
 };
 
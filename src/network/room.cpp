@@ -3,6 +3,7 @@
 
 #include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <iomanip>
 #include <mutex>
 #include <random>
@@ -56,10 +57,21 @@ public:
     /// Verification backend of the room
     std::unique_ptr<VerifyUser::Backend> verify_backend;
 
+    /// Number of packets and bytes relayed since the traffic was last logged
+    u64 relayed_packets = 0;
+    u64 relayed_bytes = 0;
+    std::chrono::steady_clock::time_point last_traffic_log;
+
     /// Thread function that will receive and dispatch messages until the room is destroyed.
     void ServerLoop();
     void StartLoop();
 
+    /// Dispatches a received event to its handler.
+    void HandleEvent(ENetEvent& event);
+
+    /// Logs the relayed traffic once per interval, if there has been any.
+    void LogTraffic();
+
     /**
      * Parses and answers a room join request from a client.
      * Validates the uniqueness of the username and assigns the MAC address
@@ -217,6 +229,15 @@ public:
      */
     void HandleLdnPacket(const ENetEvent* event);
 
+    /**
+     * Relays a received packet, serialized once and shared by all the recipients.
+     * @param event The ENet event containing the data
+     * @param destination_address Fake IP of the recipient, unused when broadcasting
+     * @param broadcast Whether to send it to all members except the sender
+     */
+    void RelayPacket(const ENetEvent* event, const IPv4Address& destination_address,
+                     bool broadcast);
+
     /**
      * Extracts a chat entry from a received ENet packet and adds it to the chat queue.
      * @param event The ENet event that was received.
@@ -238,56 +259,94 @@ public:
 
 // RoomImpl
 void Room::RoomImpl::ServerLoop() {
+    // Bounds the latency of the relayed packets when the room is flooded
+    constexpr int MaxEventsPerFlush = 256;
+
+    last_traffic_log = std::chrono::steady_clock::now();
     while (state != State::Closed) {
         ENetEvent event;
         if (enet_host_service(server, &event, 5) > 0) {
-            switch (event.type) {
-            case ENET_EVENT_TYPE_RECEIVE:
-                switch (event.packet->data[0]) {
-                case IdJoinRequest:
-                    HandleJoinRequest(&event);
-                    break;
-                case IdSetGameInfo:
-                    HandleGameInfoPacket(&event);
-                    break;
-                case IdProxyPacket:
-                    HandleProxyPacket(&event);
-                    break;
-                case IdLdnPacket:
-                    HandleLdnPacket(&event);
-                    break;
-                case IdChatMessage:
-                    HandleChatPacket(&event);
-                    break;
-                // Moderation
-                case IdModKick:
-                    HandleModKickPacket(&event);
-                    break;
-                case IdModBan:
-                    HandleModBanPacket(&event);
-                    break;
-                case IdModUnban:
-                    HandleModUnbanPacket(&event);
-                    break;
-                case IdModGetBanList:
-                    HandleModGetBanListPacket(&event);
-                    break;
-                }
-                enet_packet_destroy(event.packet);
-                break;
-            case ENET_EVENT_TYPE_DISCONNECT:
-                HandleClientDisconnection(event.peer);
-                break;
-            case ENET_EVENT_TYPE_NONE:
-            case ENET_EVENT_TYPE_CONNECT:
-                break;
-            }
+            // Handle everything that has already arrived, then send the relayed packets at once
+            int num_events = 0;
+            do {
+                HandleEvent(event);
+            } while (++num_events < MaxEventsPerFlush &&
+                     enet_host_check_events(server, &event) > 0);
+            enet_host_flush(server);
         }
+        LogTraffic();
     }
     // Close the connection to all members:
     SendCloseMessage();
 }
 
+void Room::RoomImpl::HandleEvent(ENetEvent& event) {
+    switch (event.type) {
+    case ENET_EVENT_TYPE_RECEIVE:
+        switch (event.packet->data[0]) {
+        case IdJoinRequest:
+            HandleJoinRequest(&event);
+            break;
+        case IdSetGameInfo:
+            HandleGameInfoPacket(&event);
+            break;
+        case IdProxyPacket:
+            HandleProxyPacket(&event);
+            break;
+        case IdLdnPacket:
+            HandleLdnPacket(&event);
+            break;
+        case IdChatMessage:
+            HandleChatPacket(&event);
+            break;
+        // Moderation
+        case IdModKick:
+            HandleModKickPacket(&event);
+            break;
+        case IdModBan:
+            HandleModBanPacket(&event);
+            break;
+        case IdModUnban:
+            HandleModUnbanPacket(&event);
+            break;
+        case IdModGetBanList:
+            HandleModGetBanListPacket(&event);
+            break;
+        }
+        enet_packet_destroy(event.packet);
+        break;
+    case ENET_EVENT_TYPE_DISCONNECT:
+        HandleClientDisconnection(event.peer);
+        break;
+    case ENET_EVENT_TYPE_NONE:
+    case ENET_EVENT_TYPE_CONNECT:
+        break;
+    }
+}
+
+void Room::RoomImpl::LogTraffic() {
+    constexpr auto TrafficLogInterval = std::chrono::minutes{1};
+
+    const auto now = std::chrono::steady_clock::now();
+    if (now - last_traffic_log < TrafficLogInterval) {
+        return;
+    }
+    last_traffic_log = now;
+    if (relayed_packets == 0) {
+        return;
+    }
+    size_t num_members;
+    {
+        std::shared_lock lock(member_mutex);
+        num_members = members.size();
+    }
+    const auto seconds = std::chrono::seconds{TrafficLogInterval}.count();
+    LOG_INFO(Network, "Relayed {} packets/s ({} KiB/s) between {} members",
+             relayed_packets / seconds, relayed_bytes / seconds / 1024, num_members);
+    relayed_packets = 0;
+    relayed_bytes = 0;
+}
+
 void Room::RoomImpl::StartLoop() {
     room_thread = std::make_unique<std::thread>(&Room::RoomImpl::ServerLoop, this);
 }
@@ -831,43 +890,7 @@ void Room::RoomImpl::HandleProxyPacket(const ENetEvent* event) {
     bool broadcast;
     in_packet.Read(broadcast); // Broadcast
 
-    Packet out_packet;
-    out_packet.Append(event->packet->data, event->packet->dataLength);
-    ENetPacket* enet_packet = enet_packet_create(out_packet.GetData(), out_packet.GetDataSize(),
-                                                 ENET_PACKET_FLAG_RELIABLE);
-
-    const auto& destination_address = remote_ip;
-    if (broadcast) { // Send the data to everyone except the sender
-        std::lock_guard lock(member_mutex);
-        bool sent_packet = false;
-        for (const auto& member : members) {
-            if (member.peer != event->peer) {
-                sent_packet = true;
-                enet_peer_send(member.peer, 0, enet_packet);
-            }
-        }
-
-        if (!sent_packet) {
-            enet_packet_destroy(enet_packet);
-        }
-    } else { // Send the data only to the destination client
-        std::lock_guard lock(member_mutex);
-        auto member = std::find_if(members.begin(), members.end(),
-                                   [destination_address](const Member& member_entry) -> bool {
-                                       return member_entry.fake_ip == destination_address;
-                                   });
-        if (member != members.end()) {
-            enet_peer_send(member->peer, 0, enet_packet);
-        } else {
-            LOG_ERROR(Network,
-                      "Attempting to send to unknown IP address: "
-                      "{}.{}.{}.{}",
-                      destination_address[0], destination_address[1], destination_address[2],
-                      destination_address[3]);
-            enet_packet_destroy(enet_packet);
-        }
-    }
-    enet_host_flush(server);
+    RelayPacket(event, remote_ip, broadcast);
 }
 
 void Room::RoomImpl::HandleLdnPacket(const ENetEvent* event) {
@@ -885,32 +908,30 @@ void Room::RoomImpl::HandleLdnPacket(const ENetEvent* event) {
     bool broadcast;
     in_packet.Read(broadcast); // Broadcast
 
-    Packet out_packet;
-    out_packet.Append(event->packet->data, event->packet->dataLength);
-    ENetPacket* enet_packet = enet_packet_create(out_packet.GetData(), out_packet.GetDataSize(),
-                                                 ENET_PACKET_FLAG_RELIABLE);
+    RelayPacket(event, remote_ip, broadcast);
+}
 
-    const auto& destination_address = remote_ip;
+void Room::RoomImpl::RelayPacket(const ENetEvent* event, const IPv4Address& destination_address,
+                                 bool broadcast) {
+    ENetPacket* enet_packet = enet_packet_create(event->packet->data, event->packet->dataLength,
+                                                 ENET_PACKET_FLAG_RELIABLE);
+    u64 num_recipients = 0;
     if (broadcast) { // Send the data to everyone except the sender
-        std::lock_guard lock(member_mutex);
-        bool sent_packet = false;
+        std::shared_lock lock(member_mutex);
         for (const auto& member : members) {
             if (member.peer != event->peer) {
-                sent_packet = true;
+                ++num_recipients;
                 enet_peer_send(member.peer, 0, enet_packet);
             }
         }
-
-        if (!sent_packet) {
-            enet_packet_destroy(enet_packet);
-        }
-    } else {
-        std::lock_guard lock(member_mutex);
+    } else { // Send the data only to the destination client
+        std::shared_lock lock(member_mutex);
         auto member = std::find_if(members.begin(), members.end(),
                                    [destination_address](const Member& member_entry) -> bool {
                                        return member_entry.fake_ip == destination_address;
                                    });
         if (member != members.end()) {
+            ++num_recipients;
             enet_peer_send(member->peer, 0, enet_packet);
         } else {
             LOG_ERROR(Network,
@@ -918,10 +939,14 @@ void Room::RoomImpl::HandleLdnPacket(const ENetEvent* event) {
                       "{}.{}.{}.{}",
                       destination_address[0], destination_address[1], destination_address[2],
                       destination_address[3]);
-            enet_packet_destroy(enet_packet);
         }
     }
-    enet_host_flush(server);
+    if (num_recipients == 0) {
+        enet_packet_destroy(enet_packet);
+    }
+    // Sent along with the rest of the batch by ServerLoop
+    relayed_packets += num_recipients;
+    relayed_bytes += num_recipients * event->packet->dataLength;
 }
 
 void Room::RoomImpl::HandleChatPacket(const ENetEvent* event) {
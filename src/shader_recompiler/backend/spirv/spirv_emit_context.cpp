@@ -5,6 +5,8 @@
 #include <array>
 #include <bit>
 #include <climits>
+#include <memory_resource>
+#include <vector>
 
 #include <boost/container/static_vector.hpp>
 
@@ -14,6 +16,7 @@
 #include "common/div_ceil.h"
 #include "shader_recompiler/backend/spirv/emit_spirv.h"
 #include "shader_recompiler/backend/spirv/spirv_emit_context.h"
+#include "shader_recompiler/scratch_arena.h"
 
 namespace Shader::Backend::SPIRV {
 namespace {
@@ -455,6 +458,22 @@ void VectorTypes::Define(Sirit::Module& sirit_ctx, Id base_type, std::string_vie
     }
 }
 
+void ConstantTable::Grow() {
+    std::vector<Slot> old_slots(std::max<size_t>(slots.size() * 2, 256));
+    old_slots.swap(slots);
+    const size_t mask{slots.size() - 1};
+    for (const Slot& slot : old_slots) {
+        if (!slot.used) {
+            continue;
+        }
+        size_t index{Hash(slot.kind, slot.bits) & mask};
+        while (slots[index].used) {
+            index = (index + 1) & mask;
+        }
+        slots[index] = slot;
+    }
+}
+
 EmitContext::EmitContext(const Profile& profile_, const RuntimeInfo& runtime_info_,
                          IR::Program& program, Bindings& bindings)
     : Sirit::Module(profile_.supported_spirv), profile{profile_}, runtime_info{runtime_info_},
@@ -502,11 +521,13 @@ Id EmitContext::Def(const IR::Value& value) {
     case IR::Type::U32:
         return Const(value.U32());
     case IR::Type::U64:
-        return Constant(U64, value.U64());
+        return constants.Get(ConstantTable::Kind::U64, value.U64(),
+                             [&] { return Constant(U64, value.U64()); });
     case IR::Type::F32:
         return Const(value.F32());
     case IR::Type::F64:
-        return Constant(F64[1], value.F64());
+        return constants.Get(ConstantTable::Kind::F64, Common::BitCast<u64>(value.F64()),
+                             [&] { return Constant(F64[1], value.F64()); });
     default:
         throw NotImplementedException("Immediate type {}", value.Type());
     }
@@ -710,8 +731,8 @@ void EmitContext::DefineAttributeMemAccess(const Info& info) {
         const Id base_index{OpShiftRightArithmetic(U32[1], offset, Const(2U))};
         const Id masked_index{OpBitwiseAnd(U32[1], base_index, Const(3U))};
         const Id compare_index{OpShiftRightArithmetic(U32[1], base_index, Const(2U))};
-        std::vector<Sirit::Literal> literals;
-        std::vector<Id> labels;
+        std::pmr::vector<Sirit::Literal> literals{ScratchResource()};
+        std::pmr::vector<Id> labels{ScratchResource()};
         if (info.loads.AnyComponent(IR::Attribute::PositionX)) {
             literals.push_back(static_cast<u32>(IR::Attribute::PositionX) >> 2);
             labels.push_back(OpLabel());
@@ -798,8 +819,8 @@ void EmitContext::DefineAttributeMemAccess(const Info& info) {
         const Id base_index{OpShiftRightArithmetic(U32[1], offset, Const(2U))};
         const Id masked_index{OpBitwiseAnd(U32[1], base_index, Const(3U))};
         const Id compare_index{OpShiftRightArithmetic(U32[1], base_index, Const(2U))};
-        std::vector<Sirit::Literal> literals;
-        std::vector<Id> labels;
+        std::pmr::vector<Sirit::Literal> literals{ScratchResource()};
+        std::pmr::vector<Id> labels{ScratchResource()};
         if (info.stores.AnyComponent(IR::Attribute::PositionX)) {
             literals.push_back(static_cast<u32>(IR::Attribute::PositionX) >> 2);
             labels.push_back(OpLabel());
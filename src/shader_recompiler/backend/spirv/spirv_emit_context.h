@@ -4,9 +4,11 @@
 #pragma once
 
 #include <array>
+#include <vector>
 
 #include <sirit/sirit.h>
 
+#include "common/bit_cast.h"
 #include "shader_recompiler/backend/bindings.h"
 #include "shader_recompiler/frontend/ir/program.h"
 #include "shader_recompiler/profile.h"
@@ -29,6 +31,57 @@ private:
     std::array<Id, 4> defs{};
 };
 
+/// Open addressing table interning scalar constants by their type and bit pattern. Immediates are
+/// used by most instructions, so this is cheaper than declaring them through the module lookups.
+class ConstantTable {
+public:
+    enum class Kind : u32 {
+        U32,
+        S32,
+        F32,
+        U64,
+        F64,
+    };
+
+    template <typename Func>
+    [[nodiscard]] Id Get(Kind kind, u64 bits, Func&& define) {
+        if ((num_used + 1) * 2 > slots.size()) {
+            Grow();
+        }
+        const size_t mask{slots.size() - 1};
+        size_t index{Hash(kind, bits) & mask};
+        while (slots[index].used) {
+            const Slot& slot{slots[index]};
+            if (slot.bits == bits && slot.kind == kind) {
+                return slot.id;
+            }
+            index = (index + 1) & mask;
+        }
+        const Id id{define()};
+        slots[index] = Slot{bits, id, kind, true};
+        ++num_used;
+        return id;
+    }
+
+private:
+    struct Slot {
+        u64 bits{};
+        Id id{};
+        Kind kind{};
+        bool used{};
+    };
+
+    [[nodiscard]] static size_t Hash(Kind kind, u64 bits) noexcept {
+        const u64 hash{(bits ^ (static_cast<u64>(kind) << 59)) * 0x9e3779b97f4a7c15ULL};
+        return static_cast<size_t>(hash ^ (hash >> 32));
+    }
+
+    void Grow();
+
+    std::vector<Slot> slots;
+    size_t num_used{};
+};
+
 struct TextureDefinition {
     Id id;
     Id sampled_type;
@@ -165,7 +218,8 @@ public:
     [[nodiscard]] Id BitOffset16(const IR::Value& offset);
 
     Id Const(u32 value) {
-        return Constant(U32[1], value);
+        return constants.Get(ConstantTable::Kind::U32, value,
+                             [&] { return Constant(U32[1], value); });
     }
 
     Id Const(u32 element_1, u32 element_2) {
@@ -182,7 +236,8 @@ public:
     }
 
     Id SConst(s32 value) {
-        return Constant(S32[1], value);
+        return constants.Get(ConstantTable::Kind::S32, static_cast<u32>(value),
+                             [&] { return Constant(S32[1], value); });
     }
 
     Id SConst(s32 element_1, s32 element_2) {
@@ -199,7 +254,8 @@ public:
     }
 
     Id Const(f32 value) {
-        return Constant(F32[1], value);
+        return constants.Get(ConstantTable::Kind::F32, Common::BitCast<u32>(value),
+                             [&] { return Constant(F32[1], value); });
     }
 
     const Profile& profile;
@@ -360,6 +416,8 @@ public:
     Id load_const_func_u32x4{};
 
 private:
+    ConstantTable constants;
+
     void DefineCommonTypes(const Info& info);
     void DefineCommonConstants();
     void DefineInterfaces(const IR::Program& program);
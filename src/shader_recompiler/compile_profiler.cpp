@@ -0,0 +1,50 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+
+#include "shader_recompiler/compile_profiler.h"
+
+namespace Shader {
+namespace {
+thread_local CompileProfiler* current_profiler{};
+} // Anonymous namespace
+
+CompileProfiler::Scope::Scope(CompileProfiler& profiler) noexcept : previous{current_profiler} {
+    current_profiler = &profiler;
+}
+
+CompileProfiler::Scope::~Scope() {
+    current_profiler = previous;
+}
+
+CompileProfiler::ScopedPhase::ScopedPhase(std::string_view name_) noexcept
+    : profiler{current_profiler}, name{name_} {
+    if (profiler) {
+        start = std::chrono::steady_clock::now();
+    }
+}
+
+CompileProfiler::ScopedPhase::~ScopedPhase() {
+    if (profiler) {
+        profiler->Add(name, std::chrono::steady_clock::now() - start);
+    }
+}
+
+void CompileProfiler::Add(std::string_view name, std::chrono::nanoseconds time) {
+    // Jobs have a few dozen phases at most, a linear search is enough
+    const auto it{std::ranges::find(phases, name, &Phase::name)};
+    if (it != phases.end()) {
+        it->time += time;
+    } else {
+        phases.push_back(Phase{name, time});
+    }
+}
+
+void CompileProfiler::Merge(const CompileProfiler& other) {
+    for (const Phase& phase : other.phases) {
+        Add(phase.name, phase.time);
+    }
+}
+
+} // namespace Shader
@@ -0,0 +1,62 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <chrono>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace Shader {
+
+/// Accumulates the time spent in each phase of a shader compilation job.
+/// Phase names must be string literals, they are stored as views.
+class CompileProfiler {
+public:
+    struct Phase {
+        std::string_view name;
+        std::chrono::nanoseconds time;
+    };
+
+    /// Binds a profiler to the calling thread while the scope is alive
+    class Scope {
+    public:
+        explicit Scope(CompileProfiler& profiler) noexcept;
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        CompileProfiler* previous;
+    };
+
+    /// Measures a phase into the profiler bound to the calling thread, if there is one
+    class ScopedPhase {
+    public:
+        explicit ScopedPhase(std::string_view name) noexcept;
+        ~ScopedPhase();
+
+        ScopedPhase(const ScopedPhase&) = delete;
+        ScopedPhase& operator=(const ScopedPhase&) = delete;
+
+    private:
+        CompileProfiler* profiler;
+        std::string_view name;
+        std::chrono::steady_clock::time_point start;
+    };
+
+    void Add(std::string_view name, std::chrono::nanoseconds time);
+
+    void Merge(const CompileProfiler& other);
+
+    [[nodiscard]] std::span<const Phase> Phases() const noexcept {
+        return phases;
+    }
+
+private:
+    std::vector<Phase> phases;
+};
+
+} // namespace Shader
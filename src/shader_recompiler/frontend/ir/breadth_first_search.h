@@ -3,13 +3,16 @@
 
 #pragma once
 
+#include <deque>
+#include <memory_resource>
 #include <optional>
-#include <type_traits>
 #include <queue>
+#include <type_traits>
 
 #include <boost/container/small_vector.hpp>
 
 #include "shader_recompiler/frontend/ir/value.h"
+#include "shader_recompiler/scratch_arena.h"
 
 namespace Shader::IR {
 
@@ -23,7 +26,8 @@ auto BreadthFirstSearch(const Value& value, Pred&& pred)
     // Breadth-first search visiting the right most arguments first
     // Small vector has been determined from shaders in Super Smash Bros. Ultimate
     boost::container::small_vector<const Inst*, 2> visited;
-    std::queue<const Inst*> queue;
+    std::queue<const Inst*, std::pmr::deque<const Inst*>> queue{
+        std::pmr::deque<const Inst*>{ScratchResource()}};
     queue.push(value.InstRecursive());
 
     while (!queue.empty()) {
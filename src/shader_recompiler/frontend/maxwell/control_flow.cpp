@@ -186,8 +186,8 @@ Function::Function(ObjectPool<Block>& block_pool, Location start_address)
 
 CFG::CFG(Environment& env_, ObjectPool<Block>& block_pool_, Location start_address,
          bool exits_to_dispatcher_)
-    : env{env_}, block_pool{block_pool_}, program_start{start_address}, exits_to_dispatcher{
-                                                                            exits_to_dispatcher_} {
+    : env{env_}, instructions{env_, start_address.Offset()}, block_pool{block_pool_},
+      program_start{start_address}, exits_to_dispatcher{exits_to_dispatcher_} {
     if (exits_to_dispatcher) {
         dispatch_block = block_pool.Create(Block{});
         dispatch_block->begin = {};
@@ -270,8 +270,9 @@ bool CFG::InspectVisitedBlocks(FunctionId function_id, const Label& label) {
 }
 
 CFG::AnalysisState CFG::AnalyzeInst(Block* block, FunctionId function_id, Location pc) {
-    const Instruction inst{env.ReadInstruction(pc.Offset())};
-    const Opcode opcode{Decode(inst.raw)};
+    const DecodedInstruction decoded{instructions.Get(pc.Offset())};
+    const Instruction inst{decoded.raw};
+    const Opcode opcode{decoded.opcode};
     switch (opcode) {
     case Opcode::BRA:
     case Opcode::JMP:
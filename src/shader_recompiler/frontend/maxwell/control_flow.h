@@ -14,6 +14,7 @@
 #include "shader_recompiler/environment.h"
 #include "shader_recompiler/frontend/ir/condition.h"
 #include "shader_recompiler/frontend/ir/reg.h"
+#include "shader_recompiler/frontend/maxwell/decode.h"
 #include "shader_recompiler/frontend/maxwell/instruction.h"
 #include "shader_recompiler/frontend/maxwell/location.h"
 #include "shader_recompiler/frontend/maxwell/opcodes.h"
@@ -132,6 +133,11 @@ public:
         return exits_to_dispatcher;
     }
 
+    /// Instructions decoded while analyzing the program
+    [[nodiscard]] DecodedProgram& Instructions() noexcept {
+        return instructions;
+    }
+
 private:
     void AnalyzeLabel(FunctionId function_id, Label& label);
 
@@ -158,6 +164,7 @@ private:
     Block* AddLabel(Block* block, Stack stack, Location pc, FunctionId function_id);
 
     Environment& env;
+    DecodedProgram instructions;
     ObjectPool<Block>& block_pool;
     boost::container::small_vector<Function, 1> functions;
     Location program_start;
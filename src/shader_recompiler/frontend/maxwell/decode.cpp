@@ -8,6 +8,7 @@
 
 #include "common/common_types.h"
 #include "common/polyfill_ranges.h"
+#include "shader_recompiler/environment.h"
 #include "shader_recompiler/exception.h"
 #include "shader_recompiler/frontend/maxwell/decode.h"
 #include "shader_recompiler/frontend/maxwell/opcodes.h"
@@ -145,4 +146,22 @@ Opcode Decode(u64 insn) {
     return it->opcode;
 }
 
+DecodedProgram::DecodedProgram(Environment& env_, u32 base_offset_)
+    : env{env_}, base_offset{base_offset_} {}
+
+DecodedInstruction DecodedProgram::DecodeSlow(u32 offset) {
+    const u64 raw{env.ReadInstruction(offset)};
+    const DecodedInstruction decoded{raw, Decode(raw)};
+    if (offset < base_offset) {
+        // Code before the entry point is rare, don't grow the table for it
+        return decoded;
+    }
+    const size_t index{(offset - base_offset) / sizeof(u64)};
+    if (index >= slots.size()) {
+        slots.resize(std::max(index + 1, slots.size() * 2));
+    }
+    slots[index] = Slot{raw, decoded.opcode, true};
+    return decoded;
+}
+
 } // namespace Shader::Maxwell
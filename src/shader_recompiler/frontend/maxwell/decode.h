@@ -3,11 +3,50 @@
 
 #pragma once
 
+#include <vector>
+
 #include "common/common_types.h"
 #include "shader_recompiler/frontend/maxwell/opcodes.h"
 
+namespace Shader {
+class Environment;
+}
+
 namespace Shader::Maxwell {
 
 [[nodiscard]] Opcode Decode(u64 insn);
 
+struct DecodedInstruction {
+    u64 raw;
+    Opcode opcode;
+};
+
+/// Instructions of a program, read from the environment and decoded once. The control flow
+/// analysis fills it and translation reads the same instructions back.
+class DecodedProgram {
+public:
+    explicit DecodedProgram(Environment& env, u32 base_offset);
+
+    [[nodiscard]] DecodedInstruction Get(u32 offset) {
+        const size_t index{(offset - base_offset) / sizeof(u64)};
+        if (offset >= base_offset && index < slots.size() && slots[index].is_decoded) {
+            return DecodedInstruction{slots[index].raw, slots[index].opcode};
+        }
+        return DecodeSlow(offset);
+    }
+
+private:
+    struct Slot {
+        u64 raw{};
+        Opcode opcode{};
+        bool is_decoded{};
+    };
+
+    DecodedInstruction DecodeSlow(u32 offset);
+
+    Environment& env;
+    u32 base_offset;
+    std::vector<Slot> slots;
+};
+
 } // namespace Shader::Maxwell
@@ -650,10 +650,11 @@ private:
 class TranslatePass {
 public:
     TranslatePass(ObjectPool<IR::Inst>& inst_pool_, ObjectPool<IR::Block>& block_pool_,
-                  ObjectPool<Statement>& stmt_pool_, Environment& env_, Statement& root_stmt,
+                  ObjectPool<Statement>& stmt_pool_, Environment& env_,
+                  DecodedProgram& instructions_, Statement& root_stmt,
                   IR::AbstractSyntaxList& syntax_list_, const HostTranslateInfo& host_info)
         : stmt_pool{stmt_pool_}, inst_pool{inst_pool_}, block_pool{block_pool_}, env{env_},
-          syntax_list{syntax_list_} {
+          instructions{instructions_}, syntax_list{syntax_list_} {
         Visit(root_stmt, nullptr, nullptr);
 
         IR::Block& first_block{*syntax_list.front().data.block};
@@ -685,7 +686,8 @@ private:
                 break;
             case StatementType::Code: {
                 ensure_block();
-                Translate(env, current_block, stmt.block->begin.Offset(), stmt.block->end.Offset());
+                Translate(env, instructions, current_block, stmt.block->begin.Offset(),
+                          stmt.block->end.Offset());
                 break;
             }
             case StatementType::SetVariable: {
@@ -974,6 +976,7 @@ private:
     ObjectPool<IR::Inst>& inst_pool;
     ObjectPool<IR::Block>& block_pool;
     Environment& env;
+    DecodedProgram& instructions;
     IR::AbstractSyntaxList& syntax_list;
     bool uses_demote_to_helper{};
     const Flow::Block dummy_flow_block;
@@ -987,7 +990,8 @@ IR::AbstractSyntaxList BuildASL(ObjectPool<IR::Inst>& inst_pool, ObjectPool<IR::
     GotoPass goto_pass{cfg, stmt_pool};
     Statement& root{goto_pass.RootStatement()};
     IR::AbstractSyntaxList syntax_list;
-    TranslatePass{inst_pool, block_pool, stmt_pool, env, root, syntax_list, host_info};
+    TranslatePass{inst_pool, block_pool, stmt_pool, env, cfg.Instructions(), root, syntax_list,
+                  host_info};
     return syntax_list;
 }
 
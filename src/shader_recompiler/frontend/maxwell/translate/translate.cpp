@@ -22,15 +22,15 @@ static void Invoke(TranslatorVisitor& visitor, Location pc, u64 insn) {
     }
 }
 
-void Translate(Environment& env, IR::Block* block, u32 location_begin, u32 location_end) {
+void Translate(Environment& env, DecodedProgram& instructions, IR::Block* block,
+               u32 location_begin, u32 location_end) {
     if (location_begin == location_end) {
         return;
     }
     TranslatorVisitor visitor{env, *block};
     for (Location pc = location_begin; pc != location_end; ++pc) {
-        const u64 insn{env.ReadInstruction(pc.Offset())};
+        const auto [insn, opcode]{instructions.Get(pc.Offset())};
         try {
-            const Opcode opcode{Decode(insn)};
             switch (opcode) {
 #define INST(name, cute, mask)                                                                     \
     case Opcode::name:                                                                             \
@@ -42,7 +42,7 @@ void Translate(Environment& env, IR::Block* block, u32 location_begin, u32 locat
                 throw LogicError("Invalid opcode {}", opcode);
             }
         } catch (Exception& exception) {
-            exception.Prepend(fmt::format("Translate {}: ", Decode(insn)));
+            exception.Prepend(fmt::format("Translate {}: ", opcode));
             throw;
         }
     }
@@ -5,9 +5,11 @@
 
 #include "shader_recompiler/environment.h"
 #include "shader_recompiler/frontend/ir/basic_block.h"
+#include "shader_recompiler/frontend/maxwell/decode.h"
 
 namespace Shader::Maxwell {
 
-void Translate(Environment& env, IR::Block* block, u32 location_begin, u32 location_end);
+void Translate(Environment& env, DecodedProgram& instructions, IR::Block* block,
+               u32 location_begin, u32 location_end);
 
 } // namespace Shader::Maxwell
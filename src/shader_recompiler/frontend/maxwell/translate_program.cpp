@@ -3,10 +3,13 @@
 
 #include <algorithm>
 #include <memory>
+#include <optional>
+#include <string_view>
 #include <vector>
 #include <queue>
 
 #include "common/settings.h"
+#include "shader_recompiler/compile_profiler.h"
 #include "shader_recompiler/exception.h"
 #include "shader_recompiler/frontend/ir/basic_block.h"
 #include "shader_recompiler/frontend/ir/ir_emitter.h"
@@ -239,7 +242,13 @@ void LowerGeometryPassthrough(const IR::Program& program, const HostTranslateInf
 
 IR::Program TranslateProgram(ObjectPool<IR::Inst>& inst_pool, ObjectPool<IR::Block>& block_pool,
                              Environment& env, Flow::CFG& cfg, const HostTranslateInfo& host_info) {
+    // Phases are only measured when a profiler is bound to the calling thread
+    const auto run_pass{[](std::string_view name, auto&& pass) {
+        const CompileProfiler::ScopedPhase phase{name};
+        pass();
+    }};
     IR::Program program;
+    std::optional<CompileProfiler::ScopedPhase> translate_phase{std::in_place, "translate"};
     program.syntax_list = BuildASL(inst_pool, block_pool, env, cfg, host_info);
     program.blocks = GenerateBlocks(program.syntax_list);
     program.post_order_blocks = PostOrder(program.syntax_list.front());
@@ -278,39 +287,53 @@ IR::Program TranslateProgram(ObjectPool<IR::Inst>& inst_pool, ObjectPool<IR::Blo
         break;
     }
     RemoveUnreachableBlocks(program);
+    translate_phase.reset();
 
     // Replace instructions before the SSA rewrite
     if (!host_info.support_float64) {
-        Optimization::LowerFp64ToFp32(program);
+        run_pass("lower_fp64", [&] { Optimization::LowerFp64ToFp32(program); });
     }
     if (!host_info.support_float16) {
-        Optimization::LowerFp16ToFp32(program);
+        run_pass("lower_fp16", [&] { Optimization::LowerFp16ToFp32(program); });
     }
     if (!host_info.support_int64) {
-        Optimization::LowerInt64ToInt32(program);
+        run_pass("lower_int64", [&] { Optimization::LowerInt64ToInt32(program); });
     }
     if (!host_info.support_conditional_barrier) {
-        Optimization::ConditionalBarrierPass(program);
+        run_pass("conditional_barrier", [&] { Optimization::ConditionalBarrierPass(program); });
     }
-    Optimization::SsaRewritePass(program);
+    run_pass("ssa_rewrite", [&] { Optimization::SsaRewritePass(program); });
 
-    Optimization::ConstantPropagationPass(env, program);
+    if (host_info.specialize_constant_buffers) {
+        run_pass("constant_buffer_specialization",
+                 [&] { Optimization::ConstantBufferSpecializationPass(env, program); });
+    }
+    run_pass("constant_propagation", [&] { Optimization::ConstantPropagationPass(env, program); });
 
-    Optimization::PositionPass(env, program);
+    run_pass("position", [&] { Optimization::PositionPass(env, program); });
 
-    Optimization::GlobalMemoryToStorageBufferPass(program, host_info);
-    Optimization::TexturePass(env, program, host_info);
+    run_pass("global_memory_to_storage_buffer",
+             [&] { Optimization::GlobalMemoryToStorageBufferPass(program, host_info); });
+    run_pass("texture", [&] { Optimization::TexturePass(env, program, host_info); });
 
     if (Settings::values.resolution_info.active) {
-        Optimization::RescalingPass(program);
+        run_pass("rescaling", [&] { Optimization::RescalingPass(program); });
+    }
+    if (!Settings::values.disable_shader_licm) {
+        run_pass("loop_invariant_code_motion",
+                 [&] { Optimization::LoopInvariantCodeMotionPass(program); });
     }
-    Optimization::DeadCodeEliminationPass(program);
+    if (!Settings::values.disable_shader_gvn) {
+        run_pass("global_value_numbering",
+                 [&] { Optimization::GlobalValueNumberingPass(program); });
+    }
+    run_pass("dead_code_elimination", [&] { Optimization::DeadCodeEliminationPass(program); });
     if (Settings::values.renderer_debug) {
-        Optimization::VerificationPass(program);
+        run_pass("verification", [&] { Optimization::VerificationPass(program); });
     }
-    Optimization::CollectShaderInfoPass(env, program);
-    Optimization::LayerPass(program, host_info);
-    Optimization::VendorWorkaroundPass(program);
+    run_pass("collect_shader_info", [&] { Optimization::CollectShaderInfoPass(env, program); });
+    run_pass("layer", [&] { Optimization::LayerPass(program, host_info); });
+    run_pass("vendor_workaround", [&] { Optimization::VendorWorkaroundPass(program); });
 
     CollectInterpolationInfo(env, program);
     AddNVNStorageBuffers(program);
@@ -342,6 +365,12 @@ IR::Program MergeDualVertexPrograms(IR::Program& vertex_a, IR::Program& vertex_b
 
     Optimization::JoinTextureInfo(result.info, vertex_b.info);
     Optimization::JoinStorageInfo(result.info, vertex_b.info);
+    for (const ConstantBufferGuard& guard : vertex_b.info.constant_buffer_guards) {
+        if (std::ranges::find(result.info.constant_buffer_guards, guard) ==
+            result.info.constant_buffer_guards.end()) {
+            result.info.constant_buffer_guards.push_back(guard);
+        }
+    }
     Optimization::DeadCodeEliminationPass(result);
     if (Settings::values.renderer_debug) {
         Optimization::VerificationPass(result);
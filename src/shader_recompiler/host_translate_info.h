@@ -21,6 +21,8 @@ struct HostTranslateInfo {
                                                 ///< passthrough shaders
     bool support_conditional_barrier{}; ///< True when the device supports barriers in conditional
                                         ///< control flow
+    bool specialize_constant_buffers{}; ///< True when programs can be specialized on the constant
+                                        ///< buffer words their control flow depends on
 };
 
 } // namespace Shader
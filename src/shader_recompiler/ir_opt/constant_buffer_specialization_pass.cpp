@@ -0,0 +1,125 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <unordered_set>
+#include <vector>
+
+#include "common/bit_cast.h"
+#include "common/common_types.h"
+#include "shader_recompiler/environment.h"
+#include "shader_recompiler/frontend/ir/basic_block.h"
+#include "shader_recompiler/frontend/ir/value.h"
+#include "shader_recompiler/ir_opt/passes.h"
+
+namespace Shader::Optimization {
+namespace {
+/// Words folded per program, each of them is compared before every draw using the program
+constexpr size_t MAX_GUARDS{8};
+
+/// Number of instructions walked back from a branch condition looking for loads
+constexpr u32 MAX_DEPTH{8};
+
+bool IsFoldableLoad(const IR::Inst& inst) {
+    switch (inst.GetOpcode()) {
+    case IR::Opcode::GetCbufU8:
+    case IR::Opcode::GetCbufS8:
+    case IR::Opcode::GetCbufU16:
+    case IR::Opcode::GetCbufS16:
+    case IR::Opcode::GetCbufU32:
+    case IR::Opcode::GetCbufF32:
+        return inst.Arg(0).IsImmediate() && inst.Arg(1).IsImmediate();
+    default:
+        return false;
+    }
+}
+
+void CollectLoads(IR::Inst* inst, u32 depth, std::unordered_set<IR::Inst*>& visited,
+                  std::vector<IR::Inst*>& loads) {
+    if (depth > MAX_DEPTH || !visited.insert(inst).second) {
+        return;
+    }
+    if (IsFoldableLoad(*inst)) {
+        loads.push_back(inst);
+        return;
+    }
+    // Values merged from other blocks are usually loop carried, they aren't uniform
+    if (inst->GetOpcode() == IR::Opcode::Phi) {
+        return;
+    }
+    for (size_t arg = 0; arg < inst->NumArgs(); ++arg) {
+        const IR::Value value{inst->Arg(arg)};
+        if (!value.IsImmediate()) {
+            CollectLoads(value.InstRecursive(), depth + 1, visited, loads);
+        }
+    }
+}
+
+IR::Value LoadedValue(const IR::Inst& inst, u32 word, u32 offset) {
+    const u32 shift{(offset % 4) * 8};
+    switch (inst.GetOpcode()) {
+    case IR::Opcode::GetCbufU8:
+        return IR::Value{(word >> shift) & 0xff};
+    case IR::Opcode::GetCbufS8:
+        return IR::Value{static_cast<u32>(static_cast<s32>(static_cast<s8>(word >> shift)))};
+    case IR::Opcode::GetCbufU16:
+        return IR::Value{(word >> shift) & 0xffff};
+    case IR::Opcode::GetCbufS16:
+        return IR::Value{static_cast<u32>(static_cast<s32>(static_cast<s16>(word >> shift)))};
+    case IR::Opcode::GetCbufF32:
+        return IR::Value{Common::BitCast<f32>(word)};
+    default:
+        return IR::Value{word};
+    }
+}
+} // Anonymous namespace
+
+void ConstantBufferSpecializationPass(Environment& env, IR::Program& program) {
+    // Only graphics pipelines compare their guards before being used
+    if (program.stage == Stage::Compute) {
+        return;
+    }
+    // Uniform values deciding the control flow are the ones worth folding, the dead side of the
+    // branch is stripped once the condition is constant
+    std::unordered_set<IR::Inst*> visited;
+    std::vector<IR::Inst*> loads;
+    for (IR::Block* const block : program.blocks) {
+        for (IR::Inst& inst : block->Instructions()) {
+            if (inst.GetOpcode() != IR::Opcode::ConditionRef || inst.Arg(0).IsImmediate()) {
+                continue;
+            }
+            CollectLoads(inst.Arg(0).InstRecursive(), 0, visited, loads);
+        }
+    }
+    ConstantBufferGuards& guards{program.info.constant_buffer_guards};
+    for (IR::Inst* const load : loads) {
+        const u32 index{load->Arg(0).U32()};
+        const u32 offset{load->Arg(1).U32()};
+        if (load->GetOpcode() == IR::Opcode::GetCbufU32 ||
+            load->GetOpcode() == IR::Opcode::GetCbufF32) {
+            if (offset % 4 != 0) {
+                continue;
+            }
+        } else if ((load->GetOpcode() == IR::Opcode::GetCbufU16 ||
+                    load->GetOpcode() == IR::Opcode::GetCbufS16) &&
+                   offset % 4 > 2) {
+            continue;
+        }
+        const u32 word_offset{offset & ~3U};
+        const auto it{std::ranges::find_if(guards, [&](const ConstantBufferGuard& guard) {
+            return guard.index == index && guard.offset == word_offset;
+        })};
+        u32 word{};
+        if (it != guards.end()) {
+            word = it->value;
+        } else if (guards.size() < MAX_GUARDS) {
+            word = env.ReadCbufValue(index, word_offset);
+            guards.push_back({.index = index, .offset = word_offset, .value = word});
+        } else {
+            continue;
+        }
+        load->ReplaceUsesWith(LoadedValue(*load, word, offset));
+    }
+}
+
+} // namespace Shader::Optimization
@@ -0,0 +1,178 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <functional>
+#include <memory_resource>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <boost/container/small_vector.hpp>
+
+#include "common/common_types.h"
+#include "shader_recompiler/frontend/ir/basic_block.h"
+#include "shader_recompiler/frontend/ir/value.h"
+#include "shader_recompiler/ir_opt/passes.h"
+#include "shader_recompiler/ir_opt/pure_operations.h"
+#include "shader_recompiler/scratch_arena.h"
+
+namespace Shader::Optimization {
+namespace {
+size_t HashValue(const IR::Value& value) {
+    if (!value.IsImmediate()) {
+        return std::hash<const IR::Inst*>{}(value.InstRecursive());
+    }
+    switch (value.Type()) {
+    case IR::Type::Attribute:
+        return static_cast<size_t>(value.Attribute());
+    case IR::Type::U1:
+        return value.U1() ? 1 : 0;
+    case IR::Type::U32:
+        return value.U32();
+    default:
+        // Other immediates are told apart when comparing
+        return static_cast<size_t>(value.Type());
+    }
+}
+
+size_t HashInst(const IR::Inst& inst) {
+    size_t hash{static_cast<size_t>(inst.GetOpcode()) ^ (size_t{inst.Flags<u32>()} << 16)};
+    const size_t num_args{inst.NumArgs()};
+    for (size_t i = 0; i < num_args; ++i) {
+        hash = hash * 0x9e3779b97f4a7c15ULL + HashValue(inst.Arg(i).Resolve());
+    }
+    return hash;
+}
+
+bool IsEquivalent(const IR::Inst& lhs, const IR::Inst& rhs) {
+    if (lhs.GetOpcode() != rhs.GetOpcode() || lhs.Flags<u32>() != rhs.Flags<u32>()) {
+        return false;
+    }
+    const size_t num_args{lhs.NumArgs()};
+    for (size_t i = 0; i < num_args; ++i) {
+        if (lhs.Arg(i).Resolve() != rhs.Arg(i).Resolve()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// Builds the immediate dominator of every block, using the algorithm from "A Simple, Fast
+/// Dominance Algorithm" by Cooper, Harvey and Kennedy
+std::unordered_map<IR::Block*, IR::Block*> ImmediateDominators(const IR::Program& program) {
+    const IR::BlockList& post_order{program.post_order_blocks};
+    std::unordered_map<IR::Block*, size_t> post_order_index;
+    for (size_t index = 0; index < post_order.size(); ++index) {
+        post_order_index.emplace(post_order[index], index);
+    }
+    std::unordered_map<IR::Block*, IR::Block*> idom;
+    IR::Block* const entry{post_order.back()};
+    idom.emplace(entry, entry);
+
+    const auto intersect{[&](IR::Block* lhs, IR::Block* rhs) {
+        while (lhs != rhs) {
+            while (post_order_index.at(lhs) < post_order_index.at(rhs)) {
+                lhs = idom.at(lhs);
+            }
+            while (post_order_index.at(rhs) < post_order_index.at(lhs)) {
+                rhs = idom.at(rhs);
+            }
+        }
+        return lhs;
+    }};
+    bool changed{true};
+    while (changed) {
+        changed = false;
+        for (auto it = post_order.rbegin() + 1; it != post_order.rend(); ++it) {
+            IR::Block* const block{*it};
+            IR::Block* new_idom{};
+            for (IR::Block* const pred : block->ImmPredecessors()) {
+                if (!idom.contains(pred)) {
+                    continue;
+                }
+                new_idom = new_idom ? intersect(pred, new_idom) : pred;
+            }
+            const auto [idom_it, inserted]{idom.try_emplace(block, new_idom)};
+            if (inserted || idom_it->second != new_idom) {
+                idom_it->second = new_idom;
+                changed = true;
+            }
+        }
+    }
+    return idom;
+}
+} // Anonymous namespace
+
+void GlobalValueNumberingPass(IR::Program& program) {
+    if (program.post_order_blocks.empty()) {
+        return;
+    }
+    std::pmr::unordered_map<IR::Block*, boost::container::small_vector<IR::Block*, 2>> children{
+        ScratchResource()};
+    for (const auto& [block, idom] : ImmediateDominators(program)) {
+        if (block != idom) {
+            children[idom].push_back(block);
+        }
+    }
+    // Values available in the current block, defined by the block itself or its dominators
+    std::pmr::unordered_map<size_t, boost::container::small_vector<IR::Inst*, 1>> available{
+        ScratchResource()};
+
+    struct Scope {
+        IR::Block* block;
+        std::vector<size_t> defined_hashes;
+        bool visited;
+    };
+    std::vector<Scope> stack;
+    stack.push_back(Scope{program.post_order_blocks.back(), {}, false});
+    while (!stack.empty()) {
+        Scope& scope{stack.back()};
+        if (scope.visited) {
+            // Leaving the dominator subtree, values defined in it are no longer available
+            for (const size_t hash : scope.defined_hashes) {
+                auto& candidates{available.at(hash)};
+                candidates.pop_back();
+                if (candidates.empty()) {
+                    available.erase(hash);
+                }
+            }
+            stack.pop_back();
+            continue;
+        }
+        scope.visited = true;
+        IR::Block* const block{scope.block};
+        std::vector<size_t> defined_hashes;
+        for (IR::Inst& inst : block->Instructions()) {
+            // Forward replaced values to their users, so the replaced instructions become dead
+            const size_t num_args{inst.NumArgs()};
+            for (size_t i = 0; i < num_args; ++i) {
+                if (const IR::Value arg{inst.Arg(i)}; arg.IsIdentity()) {
+                    inst.SetArg(i, arg.Resolve());
+                }
+            }
+            if (!IsPure(inst.GetOpcode(), program.stage) || inst.HasAssociatedPseudoOperation()) {
+                continue;
+            }
+            const size_t hash{HashInst(inst)};
+            auto& candidates{available[hash]};
+            const auto match{std::ranges::find_if(
+                candidates, [&inst](const IR::Inst* other) { return IsEquivalent(inst, *other); })};
+            if (match != candidates.end()) {
+                inst.ReplaceUsesWith(IR::Value{*match});
+                continue;
+            }
+            candidates.push_back(&inst);
+            defined_hashes.push_back(hash);
+        }
+        stack.back().defined_hashes = std::move(defined_hashes);
+
+        if (const auto it{children.find(block)}; it != children.end()) {
+            for (IR::Block* const child : it->second) {
+                stack.push_back(Scope{child, {}, false});
+            }
+        }
+    }
+}
+
+} // namespace Shader::Optimization
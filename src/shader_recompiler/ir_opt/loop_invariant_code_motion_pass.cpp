@@ -0,0 +1,310 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <iterator>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "common/logging/log.h"
+#include "shader_recompiler/frontend/ir/basic_block.h"
+#include "shader_recompiler/frontend/ir/value.h"
+#include "shader_recompiler/ir_opt/passes.h"
+#include "shader_recompiler/ir_opt/pure_operations.h"
+
+namespace Shader::Optimization {
+namespace {
+struct Loop {
+    IR::Block* header;
+    IR::Block* continue_block;
+    /// Blocks of the loop in syntax list order, starting with the header
+    std::vector<IR::Block*> blocks;
+};
+
+struct Statistics {
+    size_t num_hoisted{};
+    size_t num_reduced{};
+};
+
+/// Collects the loops of the program, inner loops are placed before the loops containing them
+std::vector<Loop> CollectLoops(const IR::Program& program) {
+    using Type = IR::AbstractSyntaxNode::Type;
+    const IR::AbstractSyntaxList& syntax_list{program.syntax_list};
+    std::vector<Loop> loops;
+    std::vector<Loop> open_loops;
+    for (size_t index = 0; index < syntax_list.size(); ++index) {
+        const IR::AbstractSyntaxNode& node{syntax_list[index]};
+        switch (node.type) {
+        case Type::Block:
+            for (Loop& loop : open_loops) {
+                loop.blocks.push_back(node.data.block);
+            }
+            break;
+        case Type::Loop: {
+            // The loop header is always emitted right before the loop node
+            IR::Block* const header{syntax_list.at(index - 1).data.block};
+            open_loops.push_back(Loop{
+                .header = header,
+                .continue_block = node.data.loop.continue_block,
+                .blocks{header},
+            });
+            break;
+        }
+        case Type::Repeat:
+            loops.push_back(std::move(open_loops.back()));
+            open_loops.pop_back();
+            break;
+        default:
+            break;
+        }
+    }
+    return loops;
+}
+
+/// Returns the only block entering the loop from outside, if there is one
+IR::Block* FindPreheader(const Loop& loop, const std::unordered_set<IR::Block*>& loop_blocks) {
+    IR::Block* preheader{};
+    for (IR::Block* const pred : loop.header->ImmPredecessors()) {
+        if (loop_blocks.contains(pred)) {
+            continue;
+        }
+        if (preheader) {
+            return nullptr;
+        }
+        preheader = pred;
+    }
+    return preheader;
+}
+
+bool IsInvariantValue(const IR::Value& value, const std::unordered_set<IR::Inst*>& loop_insts) {
+    return value.IsImmediate() || !loop_insts.contains(value.InstRecursive());
+}
+
+bool IsInvariant(const IR::Inst& inst, Stage stage,
+                 const std::unordered_set<IR::Inst*>& loop_insts) {
+    if (!IsPure(inst.GetOpcode(), stage) || inst.HasAssociatedPseudoOperation()) {
+        return false;
+    }
+    const size_t num_args{inst.NumArgs()};
+    for (size_t i = 0; i < num_args; ++i) {
+        if (!IsInvariantValue(inst.Arg(i), loop_insts)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// Moves the pure instructions with operands defined outside of the loop to the preheader
+void HoistInvariants(const Loop& loop, IR::Block& preheader, Stage stage, Statistics& stats) {
+    std::unordered_set<IR::Inst*> loop_insts;
+    for (IR::Block* const block : loop.blocks) {
+        for (IR::Inst& inst : block->Instructions()) {
+            loop_insts.insert(&inst);
+        }
+    }
+    // Definitions are visited before their uses, so chains of invariant code are hoisted at once
+    for (IR::Block* const block : loop.blocks) {
+        for (IR::Inst& inst : block->Instructions()) {
+            if (IR::IsPhi(inst)) {
+                continue;
+            }
+            const size_t num_args{inst.NumArgs()};
+            for (size_t i = 0; i < num_args; ++i) {
+                if (const IR::Value arg{inst.Arg(i)}; arg.IsIdentity()) {
+                    inst.SetArg(i, arg.Resolve());
+                }
+            }
+            if (!IsInvariant(inst, stage, loop_insts)) {
+                continue;
+            }
+            const auto hoisted{preheader.PrependNewInst(preheader.end(), inst)};
+            inst.ReplaceUsesWith(IR::Value{&*hoisted});
+            ++stats.num_hoisted;
+        }
+    }
+}
+
+/// Basic induction variable, incremented by an invariant step on every iteration
+struct InductionVariable {
+    IR::Inst* phi;
+    IR::Value init;
+    IR::Value step;
+    IR::Inst* next;
+};
+
+std::optional<InductionVariable> MatchInductionVariable(
+    IR::Inst& phi, const Loop& loop, IR::Block* preheader,
+    const std::unordered_set<IR::Inst*>& loop_insts) {
+    if (phi.Type() != IR::Type::U32 || phi.NumArgs() != 2) {
+        return std::nullopt;
+    }
+    IR::Value init;
+    IR::Value next_value;
+    for (size_t i = 0; i < 2; ++i) {
+        if (phi.PhiBlock(i) == preheader) {
+            init = phi.Arg(i).Resolve();
+        } else if (phi.PhiBlock(i) == loop.continue_block) {
+            next_value = phi.Arg(i).Resolve();
+        }
+    }
+    if (init.IsEmpty() || next_value.IsEmpty() || next_value.IsImmediate()) {
+        return std::nullopt;
+    }
+    IR::Inst* const next{next_value.InstRecursive()};
+    if (next->GetOpcode() != IR::Opcode::IAdd32 || next->HasAssociatedPseudoOperation() ||
+        !loop_insts.contains(next)) {
+        return std::nullopt;
+    }
+    for (size_t i = 0; i < 2; ++i) {
+        const IR::Value self{next->Arg(i).Resolve()};
+        const IR::Value step{next->Arg(1 - i).Resolve()};
+        if (!self.IsImmediate() && self.InstRecursive() == &phi &&
+            IsInvariantValue(step, loop_insts)) {
+            return InductionVariable{&phi, init, step, next};
+        }
+    }
+    return std::nullopt;
+}
+
+/// Returns the invariant factor an induction variable is multiplied with, if any
+std::optional<IR::Value> ScaleFactor(const IR::Inst& inst, const IR::Inst& phi,
+                                     const std::unordered_set<IR::Inst*>& loop_insts) {
+    const auto is_phi{[&phi](const IR::Value& value) {
+        return !value.IsImmediate() && value.InstRecursive() == &phi;
+    }};
+    const IR::Opcode opcode{inst.GetOpcode()};
+    if (opcode != IR::Opcode::IMul32 && opcode != IR::Opcode::ShiftLeftLogical32) {
+        return std::nullopt;
+    }
+    const IR::Value lhs{inst.Arg(0).Resolve()};
+    const IR::Value rhs{inst.Arg(1).Resolve()};
+    if (opcode == IR::Opcode::IMul32) {
+        if (is_phi(lhs) && IsInvariantValue(rhs, loop_insts)) {
+            return rhs;
+        }
+        if (is_phi(rhs) && IsInvariantValue(lhs, loop_insts)) {
+            return lhs;
+        }
+        return std::nullopt;
+    }
+    if (is_phi(lhs) && rhs.IsImmediate() && rhs.U32() < 32) {
+        return IR::Value{1U << rhs.U32()};
+    }
+    return std::nullopt;
+}
+
+IR::Value EmitMultiply(IR::Block& preheader, const IR::Value& lhs, const IR::Value& rhs) {
+    if (lhs.IsImmediate() && rhs.IsImmediate()) {
+        return IR::Value{lhs.U32() * rhs.U32()};
+    }
+    return IR::Value{&*preheader.PrependNewInst(preheader.end(), IR::Opcode::IMul32, {lhs, rhs})};
+}
+
+/// Replaces multiplications of induction variables with derived induction variables, that are
+/// incremented by a scaled step on every iteration
+void ReduceStrength(const Loop& loop, IR::Block& preheader, Statistics& stats) {
+    std::unordered_set<IR::Inst*> loop_insts;
+    std::unordered_map<IR::Inst*, IR::Block*> inst_blocks;
+    for (IR::Block* const block : loop.blocks) {
+        for (IR::Inst& inst : block->Instructions()) {
+            loop_insts.insert(&inst);
+            inst_blocks.emplace(&inst, block);
+        }
+    }
+    std::vector<InductionVariable> induction_variables;
+    for (IR::Inst& inst : loop.header->Instructions()) {
+        if (!IR::IsPhi(inst)) {
+            break;
+        }
+        if (const auto iv{MatchInductionVariable(inst, loop, &preheader, loop_insts)}) {
+            induction_variables.push_back(*iv);
+        }
+    }
+    for (const InductionVariable& iv : induction_variables) {
+        // Derived variables are shared by all multiplications with the same factor
+        std::vector<std::pair<IR::Value, IR::Inst*>> derived;
+        for (IR::Block* const block : loop.blocks) {
+            for (IR::Inst& inst : block->Instructions()) {
+                if (IR::IsPhi(inst) || inst.HasAssociatedPseudoOperation()) {
+                    continue;
+                }
+                const std::optional<IR::Value> factor{ScaleFactor(inst, *iv.phi, loop_insts)};
+                if (!factor) {
+                    continue;
+                }
+                const auto match{std::ranges::find(derived, *factor,
+                                                   &std::pair<IR::Value, IR::Inst*>::first)};
+                if (match != derived.end()) {
+                    inst.ReplaceUsesWith(IR::Value{match->second});
+                    ++stats.num_reduced;
+                    continue;
+                }
+                const IR::Value init{EmitMultiply(preheader, iv.init, *factor)};
+                const IR::Value step{EmitMultiply(preheader, iv.step, *factor)};
+
+                IR::Inst* const phi{
+                    &*loop.header->PrependNewInst(loop.header->begin(), IR::Opcode::Phi)};
+                phi->SetFlags(IR::Type::U32);
+                phi->AddPhiOperand(&preheader, init);
+
+                IR::Block* const next_block{inst_blocks.at(iv.next)};
+                const auto next_it{IR::Block::InstructionList::s_iterator_to(*iv.next)};
+                const auto next{next_block->PrependNewInst(std::next(next_it), IR::Opcode::IAdd32,
+                                                           {IR::Value{phi}, step})};
+                phi->AddPhiOperand(loop.continue_block, IR::Value{&*next});
+                phi->OrderPhiArgs();
+
+                inst.ReplaceUsesWith(IR::Value{phi});
+                derived.emplace_back(*factor, phi);
+                ++stats.num_reduced;
+            }
+        }
+    }
+}
+
+size_t CountLoopInstructions(const std::vector<Loop>& loops) {
+    std::unordered_set<IR::Block*> blocks;
+    for (const Loop& loop : loops) {
+        blocks.insert(loop.blocks.begin(), loop.blocks.end());
+    }
+    size_t count{};
+    for (IR::Block* const block : blocks) {
+        count += static_cast<size_t>(
+            std::ranges::count_if(block->Instructions(), [](const IR::Inst& inst) {
+                return inst.GetOpcode() != IR::Opcode::Identity &&
+                       inst.GetOpcode() != IR::Opcode::Void;
+            }));
+    }
+    return count;
+}
+} // Anonymous namespace
+
+void LoopInvariantCodeMotionPass(IR::Program& program) {
+    const std::vector<Loop> loops{CollectLoops(program)};
+    if (loops.empty()) {
+        return;
+    }
+    const size_t num_insts_before{CountLoopInstructions(loops)};
+    Statistics stats;
+    for (const Loop& loop : loops) {
+        const std::unordered_set<IR::Block*> loop_blocks(loop.blocks.begin(), loop.blocks.end());
+        IR::Block* const preheader{FindPreheader(loop, loop_blocks)};
+        if (!preheader) {
+            continue;
+        }
+        HoistInvariants(loop, *preheader, program.stage, stats);
+        ReduceStrength(loop, *preheader, stats);
+    }
+    if (stats.num_hoisted == 0 && stats.num_reduced == 0) {
+        return;
+    }
+    LOG_DEBUG(Shader,
+              "Hoisted {} instructions and reduced {} multiplications in {} loops, "
+              "loop instructions {} -> {}",
+              stats.num_hoisted, stats.num_reduced, loops.size(), num_insts_before,
+              CountLoopInstructions(loops));
+}
+
+} // namespace Shader::Optimization
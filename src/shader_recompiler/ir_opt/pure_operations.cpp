@@ -0,0 +1,277 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "shader_recompiler/ir_opt/pure_operations.h"
+
+namespace Shader::Optimization {
+
+bool IsPure(IR::Opcode opcode, Stage stage) {
+    switch (opcode) {
+    case IR::Opcode::GetCbufU8:
+    case IR::Opcode::GetCbufS8:
+    case IR::Opcode::GetCbufU16:
+    case IR::Opcode::GetCbufS16:
+    case IR::Opcode::GetCbufU32:
+    case IR::Opcode::GetCbufF32:
+    case IR::Opcode::GetCbufU32x2:
+        return true;
+    case IR::Opcode::GetAttribute:
+    case IR::Opcode::GetAttributeU32:
+        // Tessellation control shaders can read back the outputs they write
+        return stage != Stage::TessellationControl;
+    case IR::Opcode::WorkgroupId:
+    case IR::Opcode::LocalInvocationId:
+    case IR::Opcode::InvocationId:
+    case IR::Opcode::SampleId:
+    case IR::Opcode::YDirection:
+    case IR::Opcode::ResolutionDownFactor:
+    case IR::Opcode::RenderArea:
+    case IR::Opcode::IsTextureScaled:
+    case IR::Opcode::IsImageScaled:
+    case IR::Opcode::LaneId:
+    case IR::Opcode::CompositeConstructU32x2:
+    case IR::Opcode::CompositeConstructU32x3:
+    case IR::Opcode::CompositeConstructU32x4:
+    case IR::Opcode::CompositeExtractU32x2:
+    case IR::Opcode::CompositeExtractU32x3:
+    case IR::Opcode::CompositeExtractU32x4:
+    case IR::Opcode::CompositeInsertU32x2:
+    case IR::Opcode::CompositeInsertU32x3:
+    case IR::Opcode::CompositeInsertU32x4:
+    case IR::Opcode::CompositeConstructF16x2:
+    case IR::Opcode::CompositeConstructF16x3:
+    case IR::Opcode::CompositeConstructF16x4:
+    case IR::Opcode::CompositeExtractF16x2:
+    case IR::Opcode::CompositeExtractF16x3:
+    case IR::Opcode::CompositeExtractF16x4:
+    case IR::Opcode::CompositeInsertF16x2:
+    case IR::Opcode::CompositeInsertF16x3:
+    case IR::Opcode::CompositeInsertF16x4:
+    case IR::Opcode::CompositeConstructF32x2:
+    case IR::Opcode::CompositeConstructF32x3:
+    case IR::Opcode::CompositeConstructF32x4:
+    case IR::Opcode::CompositeExtractF32x2:
+    case IR::Opcode::CompositeExtractF32x3:
+    case IR::Opcode::CompositeExtractF32x4:
+    case IR::Opcode::CompositeInsertF32x2:
+    case IR::Opcode::CompositeInsertF32x3:
+    case IR::Opcode::CompositeInsertF32x4:
+    case IR::Opcode::CompositeConstructF64x2:
+    case IR::Opcode::CompositeConstructF64x3:
+    case IR::Opcode::CompositeConstructF64x4:
+    case IR::Opcode::CompositeExtractF64x2:
+    case IR::Opcode::CompositeExtractF64x3:
+    case IR::Opcode::CompositeExtractF64x4:
+    case IR::Opcode::CompositeInsertF64x2:
+    case IR::Opcode::CompositeInsertF64x3:
+    case IR::Opcode::CompositeInsertF64x4:
+    case IR::Opcode::SelectU1:
+    case IR::Opcode::SelectU8:
+    case IR::Opcode::SelectU16:
+    case IR::Opcode::SelectU32:
+    case IR::Opcode::SelectU64:
+    case IR::Opcode::SelectF16:
+    case IR::Opcode::SelectF32:
+    case IR::Opcode::SelectF64:
+    case IR::Opcode::BitCastU16F16:
+    case IR::Opcode::BitCastU32F32:
+    case IR::Opcode::BitCastU64F64:
+    case IR::Opcode::BitCastF16U16:
+    case IR::Opcode::BitCastF32U32:
+    case IR::Opcode::BitCastF64U64:
+    case IR::Opcode::PackUint2x32:
+    case IR::Opcode::UnpackUint2x32:
+    case IR::Opcode::PackFloat2x16:
+    case IR::Opcode::UnpackFloat2x16:
+    case IR::Opcode::PackHalf2x16:
+    case IR::Opcode::UnpackHalf2x16:
+    case IR::Opcode::PackDouble2x32:
+    case IR::Opcode::UnpackDouble2x32:
+    case IR::Opcode::FPAbs16:
+    case IR::Opcode::FPAbs32:
+    case IR::Opcode::FPAbs64:
+    case IR::Opcode::FPAdd16:
+    case IR::Opcode::FPAdd32:
+    case IR::Opcode::FPAdd64:
+    case IR::Opcode::FPFma16:
+    case IR::Opcode::FPFma32:
+    case IR::Opcode::FPFma64:
+    case IR::Opcode::FPMax32:
+    case IR::Opcode::FPMax64:
+    case IR::Opcode::FPMin32:
+    case IR::Opcode::FPMin64:
+    case IR::Opcode::FPMul16:
+    case IR::Opcode::FPMul32:
+    case IR::Opcode::FPMul64:
+    case IR::Opcode::FPNeg16:
+    case IR::Opcode::FPNeg32:
+    case IR::Opcode::FPNeg64:
+    case IR::Opcode::FPRecip32:
+    case IR::Opcode::FPRecip64:
+    case IR::Opcode::FPRecipSqrt32:
+    case IR::Opcode::FPRecipSqrt64:
+    case IR::Opcode::FPSqrt:
+    case IR::Opcode::FPSin:
+    case IR::Opcode::FPExp2:
+    case IR::Opcode::FPCos:
+    case IR::Opcode::FPLog2:
+    case IR::Opcode::FPSaturate16:
+    case IR::Opcode::FPSaturate32:
+    case IR::Opcode::FPSaturate64:
+    case IR::Opcode::FPClamp16:
+    case IR::Opcode::FPClamp32:
+    case IR::Opcode::FPClamp64:
+    case IR::Opcode::FPRoundEven16:
+    case IR::Opcode::FPRoundEven32:
+    case IR::Opcode::FPRoundEven64:
+    case IR::Opcode::FPFloor16:
+    case IR::Opcode::FPFloor32:
+    case IR::Opcode::FPFloor64:
+    case IR::Opcode::FPCeil16:
+    case IR::Opcode::FPCeil32:
+    case IR::Opcode::FPCeil64:
+    case IR::Opcode::FPTrunc16:
+    case IR::Opcode::FPTrunc32:
+    case IR::Opcode::FPTrunc64:
+    case IR::Opcode::FPOrdEqual16:
+    case IR::Opcode::FPOrdEqual32:
+    case IR::Opcode::FPOrdEqual64:
+    case IR::Opcode::FPUnordEqual16:
+    case IR::Opcode::FPUnordEqual32:
+    case IR::Opcode::FPUnordEqual64:
+    case IR::Opcode::FPOrdNotEqual16:
+    case IR::Opcode::FPOrdNotEqual32:
+    case IR::Opcode::FPOrdNotEqual64:
+    case IR::Opcode::FPUnordNotEqual16:
+    case IR::Opcode::FPUnordNotEqual32:
+    case IR::Opcode::FPUnordNotEqual64:
+    case IR::Opcode::FPOrdLessThan16:
+    case IR::Opcode::FPOrdLessThan32:
+    case IR::Opcode::FPOrdLessThan64:
+    case IR::Opcode::FPUnordLessThan16:
+    case IR::Opcode::FPUnordLessThan32:
+    case IR::Opcode::FPUnordLessThan64:
+    case IR::Opcode::FPOrdGreaterThan16:
+    case IR::Opcode::FPOrdGreaterThan32:
+    case IR::Opcode::FPOrdGreaterThan64:
+    case IR::Opcode::FPUnordGreaterThan16:
+    case IR::Opcode::FPUnordGreaterThan32:
+    case IR::Opcode::FPUnordGreaterThan64:
+    case IR::Opcode::FPOrdLessThanEqual16:
+    case IR::Opcode::FPOrdLessThanEqual32:
+    case IR::Opcode::FPOrdLessThanEqual64:
+    case IR::Opcode::FPUnordLessThanEqual16:
+    case IR::Opcode::FPUnordLessThanEqual32:
+    case IR::Opcode::FPUnordLessThanEqual64:
+    case IR::Opcode::FPOrdGreaterThanEqual16:
+    case IR::Opcode::FPOrdGreaterThanEqual32:
+    case IR::Opcode::FPOrdGreaterThanEqual64:
+    case IR::Opcode::FPUnordGreaterThanEqual16:
+    case IR::Opcode::FPUnordGreaterThanEqual32:
+    case IR::Opcode::FPUnordGreaterThanEqual64:
+    case IR::Opcode::FPIsNan16:
+    case IR::Opcode::FPIsNan32:
+    case IR::Opcode::FPIsNan64:
+    case IR::Opcode::IAdd32:
+    case IR::Opcode::IAdd64:
+    case IR::Opcode::ISub32:
+    case IR::Opcode::ISub64:
+    case IR::Opcode::IMul32:
+    case IR::Opcode::SDiv32:
+    case IR::Opcode::UDiv32:
+    case IR::Opcode::INeg32:
+    case IR::Opcode::INeg64:
+    case IR::Opcode::IAbs32:
+    case IR::Opcode::ShiftLeftLogical32:
+    case IR::Opcode::ShiftLeftLogical64:
+    case IR::Opcode::ShiftRightLogical32:
+    case IR::Opcode::ShiftRightLogical64:
+    case IR::Opcode::ShiftRightArithmetic32:
+    case IR::Opcode::ShiftRightArithmetic64:
+    case IR::Opcode::BitwiseAnd32:
+    case IR::Opcode::BitwiseOr32:
+    case IR::Opcode::BitwiseXor32:
+    case IR::Opcode::BitFieldInsert:
+    case IR::Opcode::BitFieldSExtract:
+    case IR::Opcode::BitFieldUExtract:
+    case IR::Opcode::BitReverse32:
+    case IR::Opcode::BitCount32:
+    case IR::Opcode::BitwiseNot32:
+    case IR::Opcode::FindSMsb32:
+    case IR::Opcode::FindUMsb32:
+    case IR::Opcode::SMin32:
+    case IR::Opcode::UMin32:
+    case IR::Opcode::SMax32:
+    case IR::Opcode::UMax32:
+    case IR::Opcode::SClamp32:
+    case IR::Opcode::UClamp32:
+    case IR::Opcode::SLessThan:
+    case IR::Opcode::ULessThan:
+    case IR::Opcode::IEqual:
+    case IR::Opcode::SLessThanEqual:
+    case IR::Opcode::ULessThanEqual:
+    case IR::Opcode::SGreaterThan:
+    case IR::Opcode::UGreaterThan:
+    case IR::Opcode::INotEqual:
+    case IR::Opcode::SGreaterThanEqual:
+    case IR::Opcode::UGreaterThanEqual:
+    case IR::Opcode::LogicalOr:
+    case IR::Opcode::LogicalAnd:
+    case IR::Opcode::LogicalXor:
+    case IR::Opcode::LogicalNot:
+    case IR::Opcode::ConvertS16F16:
+    case IR::Opcode::ConvertS16F32:
+    case IR::Opcode::ConvertS16F64:
+    case IR::Opcode::ConvertS32F16:
+    case IR::Opcode::ConvertS32F32:
+    case IR::Opcode::ConvertS32F64:
+    case IR::Opcode::ConvertS64F16:
+    case IR::Opcode::ConvertS64F32:
+    case IR::Opcode::ConvertS64F64:
+    case IR::Opcode::ConvertU16F16:
+    case IR::Opcode::ConvertU16F32:
+    case IR::Opcode::ConvertU16F64:
+    case IR::Opcode::ConvertU32F16:
+    case IR::Opcode::ConvertU32F32:
+    case IR::Opcode::ConvertU32F64:
+    case IR::Opcode::ConvertU64F16:
+    case IR::Opcode::ConvertU64F32:
+    case IR::Opcode::ConvertU64F64:
+    case IR::Opcode::ConvertU64U32:
+    case IR::Opcode::ConvertU32U64:
+    case IR::Opcode::ConvertF16F32:
+    case IR::Opcode::ConvertF32F16:
+    case IR::Opcode::ConvertF32F64:
+    case IR::Opcode::ConvertF64F32:
+    case IR::Opcode::ConvertF16S8:
+    case IR::Opcode::ConvertF16S16:
+    case IR::Opcode::ConvertF16S32:
+    case IR::Opcode::ConvertF16S64:
+    case IR::Opcode::ConvertF16U8:
+    case IR::Opcode::ConvertF16U16:
+    case IR::Opcode::ConvertF16U32:
+    case IR::Opcode::ConvertF16U64:
+    case IR::Opcode::ConvertF32S8:
+    case IR::Opcode::ConvertF32S16:
+    case IR::Opcode::ConvertF32S32:
+    case IR::Opcode::ConvertF32S64:
+    case IR::Opcode::ConvertF32U8:
+    case IR::Opcode::ConvertF32U16:
+    case IR::Opcode::ConvertF32U32:
+    case IR::Opcode::ConvertF32U64:
+    case IR::Opcode::ConvertF64S8:
+    case IR::Opcode::ConvertF64S16:
+    case IR::Opcode::ConvertF64S32:
+    case IR::Opcode::ConvertF64S64:
+    case IR::Opcode::ConvertF64U8:
+    case IR::Opcode::ConvertF64U16:
+    case IR::Opcode::ConvertF64U32:
+    case IR::Opcode::ConvertF64U64:
+        return true;
+    default:
+        // Memory, texture, subgroup and derivative operations depend on state or control flow
+        return false;
+    }
+}
+
+} // namespace Shader::Optimization
@@ -0,0 +1,15 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "shader_recompiler/frontend/ir/opcodes.h"
+#include "shader_recompiler/stage.h"
+
+namespace Shader::Optimization {
+
+/// Returns true when instructions with this opcode and equal arguments always produce the same
+/// value, regardless of where they are placed in the program
+[[nodiscard]] bool IsPure(IR::Opcode opcode, Stage stage);
+
+} // namespace Shader::Optimization
@@ -15,6 +15,7 @@
 
 #include <deque>
 #include <map>
+#include <memory_resource>
 #include <span>
 #include <unordered_map>
 #include <variant>
@@ -26,6 +27,7 @@
 #include "shader_recompiler/frontend/ir/reg.h"
 #include "shader_recompiler/frontend/ir/value.h"
 #include "shader_recompiler/ir_opt/passes.h"
+#include "shader_recompiler/scratch_arena.h"
 
 namespace Shader::Optimization {
 namespace {
@@ -52,9 +54,14 @@ struct IndirectBranchVariable {
 
 using Variant = std::variant<IR::Reg, IR::Pred, ZeroFlagTag, SignFlagTag, CarryFlagTag,
                              OverflowFlagTag, GotoVariable, IndirectBranchVariable>;
-using ValueMap = std::unordered_map<IR::Block*, IR::Value>;
+using ValueMap = std::pmr::unordered_map<IR::Block*, IR::Value>;
 
 struct DefTable {
+    explicit DefTable(std::pmr::memory_resource* resource)
+        : preds(IR::NUM_USER_PREDS, resource), goto_vars{resource},
+          indirect_branch_var{resource}, zero_flag{resource}, sign_flag{resource},
+          carry_flag{resource}, overflow_flag{resource} {}
+
     const IR::Value& Def(IR::Block* block, IR::Reg variable) {
         return block->SsaRegValue(variable);
     }
@@ -111,8 +118,8 @@ struct DefTable {
         overflow_flag.insert_or_assign(block, value);
     }
 
-    std::array<ValueMap, IR::NUM_USER_PREDS> preds;
-    std::unordered_map<u32, ValueMap> goto_vars;
+    std::pmr::vector<ValueMap> preds;
+    std::pmr::unordered_map<u32, ValueMap> goto_vars;
     ValueMap indirect_branch_var;
     ValueMap zero_flag;
     ValueMap sign_flag;
@@ -158,6 +165,9 @@ struct ReadState {
 
 class Pass {
 public:
+    explicit Pass(std::pmr::memory_resource* resource)
+        : incomplete_phis{resource}, current_def{resource} {}
+
     template <typename Type>
     void WriteVariable(Type variable, IR::Block* block, const IR::Value& value) {
         current_def.SetDef(block, variable, value);
@@ -295,7 +305,7 @@ private:
         return same;
     }
 
-    std::unordered_map<IR::Block*, std::map<Variant, IR::Inst*>> incomplete_phis;
+    std::pmr::unordered_map<IR::Block*, std::pmr::map<Variant, IR::Inst*>> incomplete_phis;
     DefTable current_def;
 };
 
@@ -370,7 +380,7 @@ void VisitBlock(Pass& pass, IR::Block* block) {
 }
 
 IR::Type GetConcreteType(IR::Inst* inst) {
-    std::deque<IR::Inst*> queue;
+    std::pmr::deque<IR::Inst*> queue{ScratchResource()};
     queue.push_back(inst);
     while (!queue.empty()) {
         IR::Inst* current = queue.front();
@@ -391,7 +401,7 @@ IR::Type GetConcreteType(IR::Inst* inst) {
 } // Anonymous namespace
 
 void SsaRewritePass(IR::Program& program) {
-    Pass pass;
+    Pass pass{ScratchResource()};
     const auto end{program.post_order_blocks.rend()};
     for (auto block = program.post_order_blocks.rbegin(); block != end; ++block) {
         VisitBlock(pass, *block);
@@ -3,9 +3,9 @@
 
 #include <algorithm>
 #include <bit>
+#include <memory_resource>
 #include <optional>
-
-#include <boost/container/small_vector.hpp>
+#include <vector>
 
 #include "shader_recompiler/environment.h"
 #include "shader_recompiler/frontend/ir/basic_block.h"
@@ -13,6 +13,7 @@
 #include "shader_recompiler/frontend/ir/ir_emitter.h"
 #include "shader_recompiler/host_translate_info.h"
 #include "shader_recompiler/ir_opt/passes.h"
+#include "shader_recompiler/scratch_arena.h"
 #include "shader_recompiler/shader_info.h"
 
 namespace Shader::Optimization {
@@ -35,7 +36,7 @@ struct TextureInst {
     IR::Block* block;
 };
 
-using TextureInstVector = boost::container::small_vector<TextureInst, 24>;
+using TextureInstVector = std::pmr::vector<TextureInst>;
 
 constexpr u32 DESCRIPTOR_SIZE = 8;
 constexpr u32 DESCRIPTOR_SIZE_SHIFT = static_cast<u32>(std::countr_zero(DESCRIPTOR_SIZE));
@@ -523,7 +524,7 @@ void PatchTexelFetch(IR::Block& block, IR::Inst& inst, TexturePixelFormat pixel_
 } // Anonymous namespace
 
 void TexturePass(Environment& env, IR::Program& program, const HostTranslateInfo& host_info) {
-    TextureInstVector to_replace;
+    TextureInstVector to_replace{ScratchResource()};
     for (IR::Block* const block : program.post_order_blocks) {
         for (IR::Inst& inst : block->Instructions()) {
             if (!IsTextureInstruction(inst)) {
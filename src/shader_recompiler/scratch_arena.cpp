@@ -0,0 +1,33 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "shader_recompiler/scratch_arena.h"
+
+namespace Shader {
+namespace {
+thread_local std::pmr::memory_resource* current_resource{};
+} // Anonymous namespace
+
+ScratchArena::Scope::Scope(ScratchArena& arena) noexcept : previous{current_resource} {
+    current_resource = arena.Resource();
+}
+
+ScratchArena::Scope::~Scope() {
+    current_resource = previous;
+}
+
+ScratchArena::ScratchArena(size_t initial_size)
+    : initial_buffer{std::make_unique_for_overwrite<std::byte[]>(initial_size)},
+      resource{initial_buffer.get(), initial_size} {}
+
+ScratchArena::~ScratchArena() = default;
+
+void ScratchArena::Release() {
+    resource.release();
+}
+
+std::pmr::memory_resource* ScratchResource() noexcept {
+    return current_resource ? current_resource : std::pmr::get_default_resource();
+}
+
+} // namespace Shader
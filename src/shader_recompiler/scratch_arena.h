@@ -0,0 +1,51 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+
+namespace Shader {
+
+/// Monotonic memory resource for the temporary containers of a shader compilation job.
+/// Deallocations are no-ops, the memory of the whole job is released at once.
+class ScratchArena {
+public:
+    /// Binds an arena to the calling thread while the scope is alive
+    class Scope {
+    public:
+        explicit Scope(ScratchArena& arena) noexcept;
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        std::pmr::memory_resource* previous;
+    };
+
+    explicit ScratchArena(size_t initial_size = 256 * 1024);
+    ~ScratchArena();
+
+    ScratchArena(const ScratchArena&) = delete;
+    ScratchArena& operator=(const ScratchArena&) = delete;
+
+    /// Releases every allocation, keeping the initial buffer for the next job
+    void Release();
+
+    [[nodiscard]] std::pmr::memory_resource* Resource() noexcept {
+        return &resource;
+    }
+
+private:
+    std::unique_ptr<std::byte[]> initial_buffer;
+    std::pmr::monotonic_buffer_resource resource;
+};
+
+/// Returns the scratch arena resource bound to the calling thread,
+/// or the default resource when no arena is bound
+[[nodiscard]] std::pmr::memory_resource* ScratchResource() noexcept;
+
+} // namespace Shader
@@ -235,6 +235,16 @@ struct ImageDescriptor {
 };
 using ImageDescriptors = boost::container::small_vector<ImageDescriptor, 4>;
 
+/// Constant buffer word folded into the program, which is only valid while the word holds value
+struct ConstantBufferGuard {
+    u32 index;
+    u32 offset;
+    u32 value;
+
+    auto operator<=>(const ConstantBufferGuard&) const = default;
+};
+using ConstantBufferGuards = boost::container::small_vector<ConstantBufferGuard, 4>;
+
 struct Info {
     static constexpr size_t MAX_INDIRECT_CBUFS{14};
     static constexpr size_t MAX_CBUFS{18};
@@ -333,6 +343,7 @@ struct Info {
     ImageBufferDescriptors image_buffer_descriptors;
     TextureDescriptors texture_descriptors;
     ImageDescriptors image_descriptors;
+    ConstantBufferGuards constant_buffer_guards;
 };
 
 template <typename Descriptors>
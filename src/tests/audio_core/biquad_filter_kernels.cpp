@@ -0,0 +1,168 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "audio_core/renderer/command/effect/biquad_filter_kernels.h"
+#include "common/bit_cast.h"
+#include "common/fixed_point.h"
+
+namespace {
+using namespace AudioCore;
+using namespace AudioCore::Renderer;
+
+constexpr u32 SampleCount{240};
+
+// Reference filters, as applied by the commands before using the kernels
+void FilterFloat(std::vector<s32>& samples, const VoiceInfo::BiquadFilterParameter& biquad,
+                 VoiceState::BiquadFilterState& state) {
+    constexpr f64 min{std::numeric_limits<s32>::min()};
+    constexpr f64 max{std::numeric_limits<s32>::max()};
+    const auto to_double = [](s16 value) {
+        return Common::FixedPoint<50, 14>::from_base(value).to_double();
+    };
+    const f64 b[3]{to_double(biquad.b[0]), to_double(biquad.b[1]), to_double(biquad.b[2])};
+    const f64 a[2]{to_double(biquad.a[0]), to_double(biquad.a[1])};
+    f64 s[4]{Common::BitCast<f64>(state.s0), Common::BitCast<f64>(state.s1),
+             Common::BitCast<f64>(state.s2), Common::BitCast<f64>(state.s3)};
+    for (s32& out : samples) {
+        const auto in_sample{static_cast<f64>(out)};
+        const f64 sample{in_sample * b[0] + s[0] * b[1] + s[1] * b[2] + s[2] * a[0] + s[3] * a[1]};
+        out = static_cast<s32>(std::clamp(sample, min, max));
+        s[1] = s[0];
+        s[0] = in_sample;
+        s[3] = s[2];
+        s[2] = sample;
+    }
+    state = {Common::BitCast<s64>(s[0]), Common::BitCast<s64>(s[1]), Common::BitCast<s64>(s[2]),
+             Common::BitCast<s64>(s[3])};
+}
+
+void FilterInt(std::vector<s32>& samples, const VoiceInfo::BiquadFilterParameter& biquad,
+               VoiceState::BiquadFilterState& state) {
+    constexpr s64 min{std::numeric_limits<s32>::min()};
+    constexpr s64 max{std::numeric_limits<s32>::max()};
+    const auto& b{biquad.b};
+    const auto& a{biquad.a};
+    for (s32& out : samples) {
+        const s64 in_sample{out};
+        const s64 sample{in_sample * b[0] + state.s0};
+        const s64 out_sample{std::clamp<s64>((sample + (1 << 13)) >> 14, min, max)};
+        out = static_cast<s32>(out_sample);
+        state.s0 = state.s1 + b[1] * in_sample + a[0] * out_sample;
+        state.s1 = b[2] * in_sample + a[1] * out_sample;
+    }
+}
+
+struct TestChannel {
+    std::vector<s32> input;
+    std::vector<s32> output;
+    std::array<VoiceInfo::BiquadFilterParameter, MaxBiquadFilters> biquads;
+    std::array<VoiceState::BiquadFilterState, MaxBiquadFilters> states;
+};
+
+TestChannel RandomChannel(std::mt19937& engine) {
+    // Loud enough for the filters to clip, with coefficients near the limits of stability
+    std::uniform_int_distribution<s32> samples{-0x1000000, 0x1000000};
+    std::uniform_int_distribution<s32> coefficients{-0x4000, 0x4000};
+    TestChannel channel{};
+    channel.input.resize(SampleCount);
+    for (s32& sample : channel.input) {
+        sample = samples(engine);
+    }
+    channel.output = channel.input;
+    for (auto& biquad : channel.biquads) {
+        biquad.enabled = true;
+        for (s16& b : biquad.b) {
+            b = static_cast<s16>(coefficients(engine));
+        }
+        biquad.a = {static_cast<s16>(coefficients(engine) / 4),
+                    static_cast<s16>(coefficients(engine) / 8)};
+    }
+    return channel;
+}
+
+void Check(std::mt19937& engine, size_t channel_count, u32 filter_count, bool use_float) {
+    std::vector<TestChannel> channels;
+    for (size_t i = 0; i < channel_count; i++) {
+        channels.push_back(RandomChannel(engine));
+    }
+
+    // Filter twice, so the states carried over between calls are checked too
+    std::vector<TestChannel> expected{channels};
+    for (auto& channel : expected) {
+        for (u32 call = 0; call < 2; call++) {
+            for (u32 filter = 0; filter < filter_count; filter++) {
+                if (use_float) {
+                    FilterFloat(channel.output, channel.biquads[filter], channel.states[filter]);
+                } else {
+                    FilterInt(channel.output, channel.biquads[filter], channel.states[filter]);
+                }
+            }
+        }
+    }
+
+    std::vector<BiquadFilterChannel> filter_channels;
+    for (size_t i = 0; i < channel_count; i++) {
+        // Odd channels filter in place, as effects writing back to their input do
+        auto& channel{channels[i]};
+        BiquadFilterChannel filter_channel{
+            .output{channel.output},
+            .input{i % 2 != 0 ? channel.output : channel.input},
+        };
+        for (u32 filter = 0; filter < MaxBiquadFilters; filter++) {
+            filter_channel.biquads[filter] = &channel.biquads[filter];
+            filter_channel.states[filter] = &channel.states[filter];
+        }
+        filter_channels.push_back(filter_channel);
+    }
+    for (u32 call = 0; call < 2; call++) {
+        if (use_float) {
+            ApplyBiquadFiltersFloat(filter_channels, filter_count, SampleCount);
+        } else {
+            ApplyBiquadFiltersInt(filter_channels, filter_count, SampleCount);
+        }
+        // Later calls filter the previous output, like the reference
+        for (size_t i = 0; i < channel_count; i++) {
+            channels[i].input = channels[i].output;
+        }
+    }
+
+    for (size_t i = 0; i < channel_count; i++) {
+        INFO("Channel " << i << " of " << channel_count << ", " << filter_count << " filters");
+        REQUIRE(channels[i].output == expected[i].output);
+        for (u32 filter = 0; filter < MaxBiquadFilters; filter++) {
+            const auto& state{channels[i].states[filter]};
+            const auto& expected_state{expected[i].states[filter]};
+            REQUIRE(state.s0 == expected_state.s0);
+            REQUIRE(state.s1 == expected_state.s1);
+            REQUIRE(state.s2 == expected_state.s2);
+            REQUIRE(state.s3 == expected_state.s3);
+        }
+    }
+}
+} // Anonymous namespace
+
+TEST_CASE("BiquadFilterKernels: Float results match filtering each channel", "[audio_core]") {
+    std::mt19937 engine{0x5eed};
+    for (size_t channel_count = 1; channel_count <= 7; channel_count++) {
+        for (u32 filter_count = 1; filter_count <= MaxBiquadFilters; filter_count++) {
+            Check(engine, channel_count, filter_count, true);
+        }
+    }
+}
+
+TEST_CASE("BiquadFilterKernels: Fixed point results match filtering each channel",
+          "[audio_core]") {
+    std::mt19937 engine{0x5eed};
+    for (size_t channel_count = 1; channel_count <= 7; channel_count++) {
+        for (u32 filter_count = 1; filter_count <= MaxBiquadFilters; filter_count++) {
+            Check(engine, channel_count, filter_count, false);
+        }
+    }
+}
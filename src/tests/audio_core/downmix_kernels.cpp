@@ -0,0 +1,80 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <random>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "audio_core/renderer/command/resample/downmix_kernels.h"
+#include "common/fixed_point.h"
+
+namespace {
+using namespace AudioCore::Renderer;
+using Coeffs = std::array<f32, 4>;
+
+// Includes coefficients too large for the 32-bit lanes of the vector kernels
+constexpr Coeffs CoeffSets[]{
+    {1.0f, 0.707f, 0.251f, 0.707f},
+    {0.5f, -0.25f, 0.0f, 1.0f},
+    {2.0f, 0.3333f, 0.75f, -0.5f},
+    {40000.0f, 0.5f, 0.5f, 0.5f},
+};
+
+std::vector<s32> RandomSamples(std::mt19937& engine, size_t count) {
+    std::uniform_int_distribution<s32> distribution{-0x800000, 0x7FFFFF};
+    std::vector<s32> samples(count);
+    for (s32& sample : samples) {
+        sample = distribution(engine);
+    }
+    return samples;
+}
+
+void Check(std::mt19937& engine, const Coeffs& coeff_values, u32 sample_count) {
+    std::array<Common::FixedPoint<48, 16>, 4> coeffs{};
+    for (size_t i = 0; i < coeffs.size(); i++) {
+        coeffs[i] = coeff_values[i];
+    }
+    std::array<std::vector<s32>, 6> channels;
+    for (auto& channel : channels) {
+        channel = RandomSamples(engine, sample_count);
+    }
+
+    // Reference results, as computed by DownMix6chTo2chCommand before using the kernels
+    std::vector<s32> expected_left(sample_count);
+    std::vector<s32> expected_right(sample_count);
+    for (u32 i = 0; i < sample_count; i++) {
+        expected_left[i] = (channels[0][i] * coeffs[0] + channels[2][i] * coeffs[1] +
+                            channels[3][i] * coeffs[2] + channels[4][i] * coeffs[3])
+                               .to_int();
+        expected_right[i] = (channels[1][i] * coeffs[0] + channels[2][i] * coeffs[1] +
+                             channels[3][i] * coeffs[2] + channels[5][i] * coeffs[3])
+                                .to_int();
+    }
+
+    const std::array<s64, 4> raw_coeffs{coeffs[0].to_raw(), coeffs[1].to_raw(),
+                                        coeffs[2].to_raw(), coeffs[3].to_raw()};
+    const std::array<std::span<const s32>, 6> inputs{channels[0], channels[1], channels[2],
+                                                     channels[3], channels[4], channels[5]};
+    std::vector<s32> left(sample_count);
+    std::vector<s32> right(sample_count);
+    DownMix6chTo2chSamples(left, right, inputs, raw_coeffs, sample_count);
+    REQUIRE(left == expected_left);
+    REQUIRE(right == expected_right);
+
+    // The command writes the front channels in place
+    DownMix6chTo2chSamples(channels[0], channels[1], inputs, raw_coeffs, sample_count);
+    REQUIRE(channels[0] == expected_left);
+    REQUIRE(channels[1] == expected_right);
+}
+} // Anonymous namespace
+
+TEST_CASE("DownmixKernels: Results match fixed point arithmetic", "[audio_core]") {
+    std::mt19937 engine{0x1234};
+    for (const Coeffs& coeffs : CoeffSets) {
+        for (const u32 sample_count : {0U, 1U, 3U, 7U, 160U, 240U, 253U}) {
+            Check(engine, coeffs, sample_count);
+        }
+    }
+}
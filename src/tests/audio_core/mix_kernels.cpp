@@ -0,0 +1,74 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <random>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "audio_core/renderer/command/mix/mix_kernels.h"
+#include "common/fixed_point.h"
+
+namespace {
+using namespace AudioCore::Renderer;
+
+struct Gain {
+    f32 volume;
+    f32 ramp;
+};
+
+// Includes gains too large for the 32-bit lanes of the vector kernels
+constexpr Gain Gains[]{
+    {0.5f, 0.0f},   {1.0f, 0.0f},     {0.3333f, 0.0f}, {-0.75f, 0.0f},  {2.0f, -0.01f},
+    {0.0f, 0.004f}, {1.0f, -0.0042f}, {255.0f, 0.0f},  {300.0f, -1.5f},
+};
+
+std::vector<s32> RandomSamples(std::mt19937& engine, size_t count) {
+    std::uniform_int_distribution<s32> distribution{-0x800000, 0x7FFFFF};
+    std::vector<s32> samples(count);
+    for (s32& sample : samples) {
+        sample = distribution(engine);
+    }
+    return samples;
+}
+
+template <size_t Q, bool Accumulate>
+void Check(std::mt19937& engine, const Gain& gain, u32 sample_count) {
+    const std::vector<s32> input{RandomSamples(engine, sample_count)};
+    const std::vector<s32> initial{RandomSamples(engine, sample_count)};
+
+    // Reference results, as computed by the commands before using the kernels
+    std::vector<s32> expected{initial};
+    Common::FixedPoint<64 - Q, Q> volume{gain.volume};
+    const Common::FixedPoint<64 - Q, Q> ramp{gain.ramp};
+    for (u32 i = 0; i < sample_count; i++) {
+        if constexpr (Accumulate) {
+            expected[i] = (expected[i] + input[i] * volume).to_int();
+        } else {
+            expected[i] = (input[i] * volume).to_int();
+        }
+        volume += ramp;
+    }
+
+    std::vector<s32> output{initial};
+    const Common::FixedPoint<64 - Q, Q> start{gain.volume};
+    if constexpr (Accumulate) {
+        MixSamples<Q>(output, input, start.to_raw(), ramp.to_raw(), sample_count);
+    } else {
+        ScaleSamples<Q>(output, input, start.to_raw(), ramp.to_raw(), sample_count);
+    }
+    REQUIRE(output == expected);
+}
+} // Anonymous namespace
+
+TEST_CASE("MixKernels: Results match fixed point arithmetic", "[audio_core]") {
+    std::mt19937 engine{0x1234};
+    for (const Gain& gain : Gains) {
+        for (const u32 sample_count : {0U, 1U, 3U, 7U, 160U, 240U, 253U}) {
+            Check<15, true>(engine, gain, sample_count);
+            Check<15, false>(engine, gain, sample_count);
+            Check<23, true>(engine, gain, sample_count);
+            Check<23, false>(engine, gain, sample_count);
+        }
+    }
+}
@@ -0,0 +1,65 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <random>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "audio_core/renderer/command/resample/resample.h"
+#include "common/cityhash.h"
+
+namespace {
+using namespace AudioCore;
+
+struct GoldenOutput {
+    SrcQuality quality;
+    f32 ratio;
+    u64 hash;
+};
+
+// Hashes of the output of the scalar resamplers, which the vectorized ones must reproduce
+constexpr GoldenOutput GoldenOutputs[]{
+    {SrcQuality::Low, 0.5f, 0xD7B9E204B3AB7625ULL},
+    {SrcQuality::Low, 1.0f, 0xD0BE7D7AC431165AULL},
+    {SrcQuality::Low, 1.5f, 0xE8050BEE60BBF58CULL},
+    {SrcQuality::Medium, 0.5f, 0xA9C52410F385EC08ULL},
+    {SrcQuality::Medium, 0.6666667f, 0x5E34AF6076EAEC8DULL},
+    {SrcQuality::Medium, 1.0f, 0x26BB5D6EAA69BD43ULL},
+    {SrcQuality::Medium, 1.1f, 0x4F05E3F54B6298EFULL},
+    {SrcQuality::Medium, 1.5f, 0x6016008C13D79684ULL},
+    {SrcQuality::Medium, 2.0f, 0x4ECF2FD15F680388ULL},
+    {SrcQuality::High, 0.5f, 0xAE3EA4EF3BA6CB32ULL},
+    {SrcQuality::High, 0.6666667f, 0x2F1DB417390D43E9ULL},
+    {SrcQuality::High, 1.0f, 0x721B313EAB173B36ULL},
+    {SrcQuality::High, 1.1f, 0x3A36B52358F8ED6BULL},
+    {SrcQuality::High, 1.5f, 0xF2710633402E3108ULL},
+    {SrcQuality::High, 2.0f, 0xFCC7DBDD27BDBFEDULL},
+};
+
+constexpr u32 SamplesToWrite{239};
+
+u64 HashResampledOutput(SrcQuality quality, f32 ratio) {
+    std::mt19937 engine{0x5eed};
+    std::vector<s16> input(SamplesToWrite * 2 + 16);
+    for (s16& sample : input) {
+        sample = static_cast<s16>(engine() >> 16);
+    }
+    std::vector<s32> output(SamplesToWrite);
+    const Common::FixedPoint<49, 15> sample_rate_ratio{ratio};
+    Common::FixedPoint<49, 15> fraction{0.25f};
+    Renderer::Resample(output, input, sample_rate_ratio, fraction, SamplesToWrite, quality);
+
+    // The fraction carries over to the next call, so it is part of the output
+    output.push_back(static_cast<s32>(fraction.to_raw()));
+    return Common::CityHash64(reinterpret_cast<const char*>(output.data()),
+                              output.size() * sizeof(s32));
+}
+} // Anonymous namespace
+
+TEST_CASE("Resample: Output matches the golden output", "[audio_core]") {
+    for (const GoldenOutput& golden : GoldenOutputs) {
+        INFO("Quality " << static_cast<u32>(golden.quality) << " ratio " << golden.ratio);
+        REQUIRE(HashResampledOutput(golden.quality, golden.ratio) == golden.hash);
+    }
+}
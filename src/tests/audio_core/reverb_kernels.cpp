@@ -0,0 +1,147 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <random>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "audio_core/renderer/command/effect/reverb_kernels.h"
+#include "common/fixed_point.h"
+
+namespace {
+using namespace AudioCore::Renderer;
+using Fixed = Common::FixedPoint<50, 14>;
+
+// Delay line samples grow well past 32 bits as the feedback builds up
+Fixed RandomSample(std::mt19937& engine) {
+    std::uniform_int_distribution<s64> raw{-(s64{1} << 40), s64{1} << 40};
+    return Fixed::from_base(raw(engine));
+}
+
+// Gains of at most 1.0, some too large for the 32-bit vector multiplies when allowed
+Fixed RandomGain(std::mt19937& engine, bool allow_large) {
+    std::uniform_int_distribution<s64> raw{-0x4000, 0x4000};
+    std::uniform_int_distribution<u32> large{0, 7};
+    const s64 gain{raw(engine)};
+    return Fixed::from_base(allow_large && large(engine) == 0 ? gain << 19 : gain);
+}
+
+std::vector<Fixed> RandomSamples(std::mt19937& engine, size_t count) {
+    std::vector<Fixed> samples(count);
+    for (auto& sample : samples) {
+        sample = RandomSample(engine);
+    }
+    return samples;
+}
+
+ReverbInfo::State RandomState(std::mt19937& engine) {
+    ReverbInfo::State state{};
+    for (u32 line = 0; line < ReverbInfo::MaxDelayLines; line++) {
+        state.hf_decay_gain[line] = RandomGain(engine, false);
+        state.hf_decay_prev_gain[line] = RandomGain(engine, false);
+        state.prev_feedback_output[line] = RandomSample(engine);
+        state.decay_delay_lines[line].decay = RandomGain(engine, false);
+    }
+    return state;
+}
+
+// Reference network, as the reverb command ticked it each sample before using the kernels
+void ProcessNetwork(ReverbInfo::State& state, std::span<const Fixed> late_samples,
+                    ReverbNetworkBlock& block) {
+    auto& feedback{state.prev_feedback_output};
+    for (size_t i = 0; i < late_samples.size(); i++) {
+        for (u32 line = 0; line < ReverbInfo::MaxDelayLines; line++) {
+            feedback[line] = feedback[line] * state.hf_decay_prev_gain[line] +
+                             block.fdn_outputs[line][i] * state.hf_decay_gain[line];
+        }
+        const std::array<Fixed, ReverbInfo::MaxDelayLines> mix_matrix{
+            feedback[2] + feedback[1] + late_samples[i],
+            -feedback[0] - feedback[3] + late_samples[i],
+            feedback[0] - feedback[3] + late_samples[i],
+            feedback[1] - feedback[2] + late_samples[i],
+        };
+        for (u32 line = 0; line < ReverbInfo::MaxDelayLines; line++) {
+            const auto decay{state.decay_delay_lines[line].decay};
+            const auto value{block.decay_outputs[line][i]};
+            const auto mixed{mix_matrix[line] - value * decay};
+            block.decay_inputs[line][i] = mixed;
+            block.fdn_inputs[line][i] = value + mixed * decay;
+        }
+    }
+}
+} // Anonymous namespace
+
+TEST_CASE("ReverbKernels: Delay tap gains match fixed point arithmetic", "[audio_core]") {
+    std::mt19937 engine{0x5eed};
+    for (size_t count = 1; count <= ReverbBlockSize; count++) {
+        const auto taps{RandomSamples(engine, count)};
+        const auto output{RandomSamples(engine, count)};
+        const Fixed gain{RandomGain(engine, true)};
+
+        auto mixed{output};
+        auto scaled{taps};
+        MixDelayTaps(mixed, taps, gain);
+        ScaleDelayTaps(scaled, gain);
+
+        for (size_t i = 0; i < count; i++) {
+            INFO("Sample " << i << " of " << count << ", gain " << gain.to_raw());
+            REQUIRE(mixed[i] == output[i] + taps[i] * gain);
+            REQUIRE(scaled[i] == taps[i] * gain);
+        }
+    }
+}
+
+TEST_CASE("ReverbKernels: Network matches ticking each sample", "[audio_core]") {
+    std::mt19937 engine{0x5eed};
+    for (size_t count = 1; count <= ReverbBlockSize; count++) {
+        auto state{RandomState(engine)};
+        auto expected_state{state};
+        const auto late_samples{RandomSamples(engine, count)};
+
+        ReverbNetworkBlock block{};
+        for (u32 line = 0; line < ReverbInfo::MaxDelayLines; line++) {
+            for (size_t i = 0; i < count; i++) {
+                block.fdn_outputs[line][i] = RandomSample(engine);
+                block.decay_outputs[line][i] = RandomSample(engine);
+            }
+        }
+        auto expected{block};
+
+        ProcessReverbNetwork(state, late_samples, block);
+        ProcessNetwork(expected_state, late_samples, expected);
+
+        for (u32 line = 0; line < ReverbInfo::MaxDelayLines; line++) {
+            INFO("Line " << line << ", " << count << " samples");
+            REQUIRE(state.prev_feedback_output[line] == expected_state.prev_feedback_output[line]);
+            for (size_t i = 0; i < count; i++) {
+                REQUIRE(block.fdn_inputs[line][i] == expected.fdn_inputs[line][i]);
+                REQUIRE(block.decay_inputs[line][i] == expected.decay_inputs[line][i]);
+            }
+        }
+    }
+}
+
+TEST_CASE("ReverbKernels: Output mix matches fixed point arithmetic", "[audio_core]") {
+    std::mt19937 engine{0x5eed};
+    std::uniform_int_distribution<s32> input_samples{-0x800000, 0x800000};
+    for (size_t count = 1; count <= ReverbBlockSize; count++) {
+        std::vector<s32> input(count);
+        for (auto& sample : input) {
+            sample = input_samples(engine);
+        }
+        const auto early{RandomSamples(engine, count)};
+        const auto late{RandomSamples(engine, count)};
+        const Fixed dry_gain{RandomGain(engine, true)};
+        const Fixed wet_gain{RandomGain(engine, true)};
+
+        std::vector<s32> output(count);
+        MixReverbOutput(output, input, early, late, dry_gain, wet_gain);
+
+        for (size_t i = 0; i < count; i++) {
+            INFO("Sample " << i << " of " << count);
+            auto expected{input[i] * dry_gain + ((early[i] + late[i]) * wet_gain) / 64};
+            REQUIRE(output[i] == expected.to_int());
+        }
+    }
+}
@@ -0,0 +1,96 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cmath>
+#include <numbers>
+#include <random>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "audio_core/sink/time_stretcher.h"
+
+namespace {
+using AudioCore::Sink::TimeStretcher;
+
+constexpr u32 Channels{2};
+constexpr size_t BufferFrames{240};
+
+/// Stretches the input in buffer sized calls, as the sink streams do
+std::vector<s16> Stretch(const std::vector<s16>& input, f64 ratio) {
+    TimeStretcher stretcher;
+    std::vector<s16> output;
+    for (size_t offset = 0; offset < input.size(); offset += BufferFrames * Channels) {
+        const size_t count{std::min(BufferFrames * Channels, input.size() - offset)};
+        stretcher.Process({input.data() + offset, count}, Channels, ratio, output);
+    }
+    return output;
+}
+
+std::vector<s16> Sine(f64 frequency, size_t frames) {
+    std::vector<s16> samples(frames * Channels);
+    for (size_t frame = 0; frame < frames; frame++) {
+        const f64 phase{2.0 * std::numbers::pi * frequency * static_cast<f64>(frame) / 48000.0};
+        for (u32 channel = 0; channel < Channels; channel++) {
+            samples[frame * Channels + channel] = static_cast<s16>(std::sin(phase) * 16000.0);
+        }
+    }
+    return samples;
+}
+
+/// Frequency of the first channel of a sine, from its rising zero crossings
+f64 Frequency(const std::vector<s16>& samples) {
+    const size_t frames{samples.size() / Channels};
+    size_t crossings{};
+    for (size_t frame = 1; frame < frames; frame++) {
+        if (samples[(frame - 1) * Channels] < 0 && samples[frame * Channels] >= 0) {
+            crossings++;
+        }
+    }
+    return static_cast<f64>(crossings) * 48000.0 / static_cast<f64>(frames);
+}
+} // Anonymous namespace
+
+TEST_CASE("TimeStretcher: A ratio of one keeps the input", "[audio_core]") {
+    std::mt19937 engine{0x5eed};
+    std::vector<s16> input(48000 * Channels);
+    for (s16& sample : input) {
+        sample = static_cast<s16>(engine() >> 16);
+    }
+    const std::vector<s16> output{Stretch(input, 1.0)};
+    REQUIRE(!output.empty());
+    REQUIRE(std::equal(output.begin(), output.end(), input.begin()));
+}
+
+TEST_CASE("TimeStretcher: Output duration follows the ratio", "[audio_core]") {
+    const std::vector<s16> input{Sine(440.0, 48000)};
+    for (const f64 ratio : {0.5, 0.8, 1.25, 2.0, 4.0}) {
+        INFO("Ratio " << ratio);
+        const std::vector<s16> output{Stretch(input, ratio)};
+        const f64 expected{static_cast<f64>(input.size()) * ratio};
+        // Up to a few segments stay buffered in the stretcher
+        constexpr size_t BufferedFrames{TimeStretcher::SearchFrames + TimeStretcher::HopFrames +
+                                        TimeStretcher::OverlapFrames};
+        const f64 buffered{static_cast<f64>(BufferedFrames * Channels) * ratio * 2.0};
+        REQUIRE(static_cast<f64>(output.size()) <= expected);
+        REQUIRE(static_cast<f64>(output.size()) >= expected - buffered);
+    }
+}
+
+TEST_CASE("TimeStretcher: Pitch is kept", "[audio_core]") {
+    const std::vector<s16> input{Sine(440.0, 48000)};
+    for (const f64 ratio : {0.5, 2.0}) {
+        INFO("Ratio " << ratio);
+        const f64 frequency{Frequency(Stretch(input, ratio))};
+        REQUIRE(std::abs(frequency - 440.0) < 10.0);
+    }
+}
+
+TEST_CASE("TimeStretcher: Flush carries on from the stretched output", "[audio_core]") {
+    const std::vector<s16> input{Sine(440.0, 4800)};
+    TimeStretcher stretcher;
+    std::vector<s16> output;
+    stretcher.Process(input, Channels, 1.0, output);
+    stretcher.Flush(output);
+    REQUIRE(output == input);
+}
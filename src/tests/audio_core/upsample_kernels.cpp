@@ -0,0 +1,166 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <random>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "audio_core/renderer/command/resample/upsample_kernels.h"
+#include "common/fixed_point.h"
+
+namespace {
+using namespace AudioCore::Renderer;
+using Sinc = std::array<Common::FixedPoint<17, 15>, 10>;
+
+constexpr Sinc WindowedSinc1{
+    0.95376587f,   -0.12872314f, 0.060028076f,  -0.032470703f, 0.017669678f,
+    -0.009124756f, 0.004272461f, -0.001739502f, 0.000579834f,  -0.000091552734f,
+};
+constexpr Sinc WindowedSinc2{
+    0.8230896f,    -0.19161987f,  0.093444824f,  -0.05090332f,   0.027557373f,
+    -0.014038086f, 0.0064697266f, -0.002532959f, 0.00079345703f, -0.00012207031f,
+};
+constexpr Sinc WindowedSinc3{
+    0.6298828f,    -0.19274902f, 0.09725952f,    -0.05319214f,  0.028625488f,
+    -0.014373779f, 0.006500244f, -0.0024719238f, 0.0007324219f, -0.000091552734f,
+};
+constexpr Sinc WindowedSinc4{
+    0.4057312f,    -0.1468811f,  0.07601929f,    -0.041656494f,  0.022216797f,
+    -0.011016846f, 0.004852295f, -0.0017700195f, 0.00048828125f, -0.000030517578f,
+};
+constexpr Sinc WindowedSinc5{
+    0.1854248f,    -0.075164795f, 0.03967285f,    -0.021728516f,  0.011474609f,
+    -0.005584717f, 0.0024108887f, -0.0008239746f, 0.00021362305f, 0.0f,
+};
+
+/// Reference results, as computed by UpsampleCommand before using the kernels
+void ReferenceUpsample(std::span<s32> output, std::span<const s32> input, u32 target_sample_count,
+                       UpsamplerState& state) {
+    u32 read_index{0};
+    const auto increment = [&] {
+        state.history[state.history_input_index] = input[read_index++];
+        state.history_input_index =
+            static_cast<u16>((state.history_input_index + 1) % UpsamplerState::HistorySize);
+        state.history_output_index =
+            static_cast<u16>((state.history_output_index + 1) % UpsamplerState::HistorySize);
+    };
+    const auto calculate_sample = [&state](const Sinc& coeffs1, const Sinc& coeffs2) {
+        auto output_index{state.history_output_index};
+        u64 result{0};
+        for (u32 coeff_index = 0; coeff_index < 10; coeff_index++) {
+            result += static_cast<u64>(state.history[output_index].to_raw()) *
+                      coeffs1[coeff_index].to_raw();
+            output_index = output_index == state.history_start_index ? state.history_end_index
+                                                                     : output_index - 1;
+        }
+        output_index =
+            static_cast<u16>((state.history_output_index + 1) % UpsamplerState::HistorySize);
+        for (u32 coeff_index = 0; coeff_index < 10; coeff_index++) {
+            result += static_cast<u64>(state.history[output_index].to_raw()) *
+                      coeffs2[coeff_index].to_raw();
+            output_index = output_index == state.history_end_index ? state.history_start_index
+                                                                   : output_index + 1;
+        }
+        return static_cast<s32>(result >> (8 + 15));
+    };
+    const auto copy_sample = [&state] {
+        return state.history[state.history_output_index].to_int_floor();
+    };
+
+    const u32 ratio{static_cast<u32>(state.ratio.to_int_floor())};
+    for (u32 write_index = 0; write_index < target_sample_count; write_index++) {
+        if (ratio == 6) {
+            constexpr std::array<std::pair<const Sinc*, const Sinc*>, 6> Sincs{{
+                {nullptr, nullptr},
+                {&WindowedSinc1, &WindowedSinc5},
+                {&WindowedSinc2, &WindowedSinc4},
+                {&WindowedSinc3, &WindowedSinc3},
+                {&WindowedSinc4, &WindowedSinc2},
+                {&WindowedSinc5, &WindowedSinc1},
+            }};
+            if (state.sample_index == 0) {
+                increment();
+                output[write_index] = copy_sample();
+            } else {
+                const auto [coeffs1, coeffs2] = Sincs[state.sample_index];
+                output[write_index] = calculate_sample(*coeffs1, *coeffs2);
+            }
+            state.sample_index = static_cast<u8>((state.sample_index + 1) % 6);
+            continue;
+        }
+        switch (state.sample_index) {
+        case 0:
+            increment();
+            output[write_index] = copy_sample();
+            break;
+        case 1:
+            output[write_index] = ratio == 3 ? calculate_sample(WindowedSinc2, WindowedSinc4)
+                                             : calculate_sample(WindowedSinc4, WindowedSinc2);
+            break;
+        case 2:
+            if (ratio == 3) {
+                output[write_index] = calculate_sample(WindowedSinc4, WindowedSinc2);
+            } else {
+                increment();
+                output[write_index] = calculate_sample(WindowedSinc2, WindowedSinc4);
+            }
+            break;
+        }
+        state.sample_index = static_cast<u8>((state.sample_index + 1) % 3);
+    }
+}
+
+UpsamplerState MakeState(f32 ratio) {
+    UpsamplerState state{};
+    state.ratio = ratio;
+    state.window_size = 10;
+    state.history.fill(0);
+    state.history_input_index = 0;
+    state.history_output_index = 9;
+    state.history_start_index = 0;
+    state.history_end_index = UpsamplerState::HistorySize - 1;
+    state.initialized = true;
+    return state;
+}
+
+std::vector<s32> RandomSamples(std::mt19937& engine, size_t count) {
+    std::uniform_int_distribution<s32> distribution{-0x800000, 0x7FFFFF};
+    std::vector<s32> samples(count);
+    for (s32& sample : samples) {
+        sample = distribution(engine);
+    }
+    return samples;
+}
+
+void RequireSameState(const UpsamplerState& lhs, const UpsamplerState& rhs) {
+    REQUIRE(lhs.history == rhs.history);
+    REQUIRE(lhs.history_input_index == rhs.history_input_index);
+    REQUIRE(lhs.history_output_index == rhs.history_output_index);
+    REQUIRE(lhs.sample_index == rhs.sample_index);
+}
+} // Anonymous namespace
+
+TEST_CASE("UpsampleKernels: Results match the circular history", "[audio_core]") {
+    std::mt19937 engine{0x1234};
+    // Larger counts go past the unrolled history capacity of the kernel
+    for (const u32 target_sample_count : {240U, 239U, 1U, 1200U}) {
+        for (const f32 ratio : {6.0f, 3.0f, 1.5f}) {
+            UpsamplerState expected_state{MakeState(ratio)};
+            UpsamplerState state{MakeState(ratio)};
+            // Several frames, so the history carries over between calls
+            for (int frame = 0; frame < 8; ++frame) {
+                const std::vector<s32> input{RandomSamples(engine, target_sample_count)};
+                std::vector<s32> expected(target_sample_count);
+                std::vector<s32> output(target_sample_count);
+                ReferenceUpsample(expected, input, target_sample_count, expected_state);
+                UpsampleSamples(output, input, target_sample_count, state);
+                REQUIRE(output == expected);
+                RequireSameState(state, expected_state);
+            }
+        }
+    }
+}
@@ -0,0 +1,60 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <cstddef>
+#include <thread>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include "common/bounded_threadsafe_queue.h"
+
+namespace Common {
+
+TEST_CASE("BoundedQueue: PopMany", "[common]") {
+    SPSCQueue<int, 8> queue;
+    std::array<int, 4> out{};
+    REQUIRE(queue.TryPopMany(out) == 0);
+
+    for (int i = 0; i < 6; ++i) {
+        REQUIRE(queue.TryEmplace(i));
+    }
+    REQUIRE(queue.TryPopMany(out) == 4);
+    REQUIRE(out == std::array<int, 4>{0, 1, 2, 3});
+
+    // Elements wrapping around the end of the ring are popped in order
+    for (int i = 6; i < 10; ++i) {
+        REQUIRE(queue.TryEmplace(i));
+    }
+    REQUIRE(queue.TryPopMany(out) == 4);
+    REQUIRE(out == std::array<int, 4>{4, 5, 6, 7});
+    REQUIRE(queue.TryPopMany(std::span(out).first(1)) == 1);
+    REQUIRE(out[0] == 8);
+
+    int value{};
+    REQUIRE(queue.TryPop(value));
+    REQUIRE(value == 9);
+    REQUIRE(!queue.TryPop(value));
+}
+
+TEST_CASE("BoundedQueue: PopWaitMany threaded", "[common]") {
+    static constexpr size_t count = 100'000;
+    SPSCQueue<size_t, 64> queue;
+    std::jthread producer([&queue] {
+        for (size_t i = 0; i < count; ++i) {
+            queue.EmplaceWait(i);
+        }
+    });
+
+    std::stop_source stop_source;
+    std::array<size_t, 16> out{};
+    size_t expected = 0;
+    while (expected < count) {
+        const size_t num_popped = queue.PopWaitMany(out, stop_source.get_token());
+        REQUIRE(num_popped > 0);
+        for (size_t i = 0; i < num_popped; ++i) {
+            REQUIRE(out[i] == expected++);
+        }
+    }
+}
+
+} // namespace Common
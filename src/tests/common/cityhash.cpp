@@ -1,6 +1,10 @@
 // SPDX-FileCopyrightText: Copyright 2021 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <string>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 
 #include "common/cityhash.h"
@@ -19,3 +23,19 @@ TEST_CASE("CityHash", "[common]") {
     REQUIRE(CityHash128WithSeed(msg, sizeof(msg), {0xdead, 0xbeef}) ==
             u128{0xf0307dba81199ebe, 0xd77764e0c4a9eb74});
 }
+
+TEST_CASE("CityHash: Benchmark", "[common][.benchmark]") {
+    // Sizes of a pipeline key and of a shader binary
+    for (const size_t size : {size_t{256}, size_t{0x4000}}) {
+        std::vector<u8> data(size);
+        for (size_t i = 0; i < size; ++i) {
+            data[i] = static_cast<u8>(i * 7);
+        }
+        BENCHMARK("CityHash64 " + std::to_string(size)) {
+            return CityHash64(reinterpret_cast<const char*>(data.data()), data.size());
+        };
+        BENCHMARK("CityHash128 " + std::to_string(size)) {
+            return CityHash128(reinterpret_cast<const char*>(data.data()), data.size());
+        };
+    }
+}
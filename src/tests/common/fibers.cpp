@@ -2,6 +2,8 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <atomic>
+#include <chrono>
+#include <cstdio>
 #include <cstdlib>
 #include <functional>
 #include <memory>
@@ -11,6 +13,7 @@
 #include <unordered_map>
 #include <vector>
 
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 
 #include "common/common_types.h"
@@ -310,4 +313,61 @@ TEST_CASE("Fibers::Rewind", "[common]") {
     REQUIRE(test_control.rewinded);
 }
 
+/** This test measures the cost of a switch between two fibers of the same thread, as done by the
+ *  kernel scheduler on every guest thread switch.
+ */
+TEST_CASE("Fibers::StackPool", "[common]") {
+    const size_t bytes_in_use = Fiber::GetStackMemoryStats().bytes_in_use;
+    auto thread_fiber = Fiber::ThreadToFiber();
+    REQUIRE(Fiber::GetStackMemoryStats().bytes_in_use == bytes_in_use);
+    {
+        auto work_fiber = std::make_shared<Fiber>([] {});
+        REQUIRE(Fiber::GetStackMemoryStats().bytes_in_use > bytes_in_use);
+    }
+    REQUIRE(Fiber::GetStackMemoryStats().bytes_in_use == bytes_in_use);
+    REQUIRE(Fiber::GetStackMemoryStats().bytes_pooled > 0);
+    thread_fiber->Exit();
+}
+
+TEST_CASE("Fibers::SwitchSpeed", "[common]") {
+    constexpr u32 num_round_trips = 1000000;
+    auto thread_fiber = Fiber::ThreadToFiber();
+    std::shared_ptr<Fiber> work_fiber;
+    u32 num_resumes = 0;
+    work_fiber = std::make_shared<Fiber>([&] {
+        while (true) {
+            ++num_resumes;
+            Fiber::YieldTo(work_fiber, *thread_fiber);
+        }
+    });
+
+    const auto start = std::chrono::steady_clock::now();
+    for (u32 i = 0; i < num_round_trips; i++) {
+        Fiber::YieldTo(thread_fiber, *work_fiber);
+    }
+    const auto end = std::chrono::steady_clock::now();
+    thread_fiber->Exit();
+    REQUIRE(num_resumes == num_round_trips);
+
+    const double ns = std::chrono::duration<double, std::nano>(end - start).count();
+    printf("Fiber Switch Time: %.1f ns\n", ns / (2.0 * num_round_trips));
+}
+
+TEST_CASE("Fibers: Benchmark", "[common][.benchmark]") {
+    auto thread_fiber = Fiber::ThreadToFiber();
+    std::shared_ptr<Fiber> work_fiber;
+    u64 num_resumes = 0;
+    work_fiber = std::make_shared<Fiber>([&] {
+        while (true) {
+            ++num_resumes;
+            Fiber::YieldTo(work_fiber, *thread_fiber);
+        }
+    });
+    BENCHMARK("Round trip") {
+        Fiber::YieldTo(thread_fiber, *work_fiber);
+        return num_resumes;
+    };
+    thread_fiber->Exit();
+}
+
 } // namespace Common
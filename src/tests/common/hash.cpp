@@ -0,0 +1,52 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/cityhash.h"
+#include "common/common_types.h"
+#include "common/hash.h"
+
+namespace Common {
+
+TEST_CASE("HashBytes: Distinct inputs", "[common]") {
+    std::vector<u8> data(200);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<u8>(i * 13);
+    }
+    std::unordered_set<u64> hashes;
+    for (size_t size = 0; size <= data.size(); ++size) {
+        REQUIRE(HashBytes(data.data(), size) == HashBytes(data.data(), size));
+        REQUIRE(hashes.insert(HashBytes(data.data(), size)).second);
+
+        // Flipping any bit changes the hash, including in the tail that isn't a full block
+        for (size_t bit = 0; bit < size * 8; bit += 7) {
+            data[bit / 8] ^= static_cast<u8>(1U << (bit % 8));
+            REQUIRE(hashes.insert(HashBytes(data.data(), size)).second);
+            data[bit / 8] ^= static_cast<u8>(1U << (bit % 8));
+        }
+    }
+}
+
+TEST_CASE("HashBytes: Benchmark", "[common][.benchmark]") {
+    // Sizes of a sampler descriptor, a pipeline key and a shader binary
+    for (const size_t size : {size_t{32}, size_t{256}, size_t{0x4000}}) {
+        std::vector<u8> data(size);
+        for (size_t i = 0; i < size; ++i) {
+            data[i] = static_cast<u8>(i * 7);
+        }
+        BENCHMARK("HashBytes " + std::to_string(size)) {
+            return HashBytes(data.data(), data.size());
+        };
+        BENCHMARK("CityHash64 " + std::to_string(size)) {
+            return CityHash64(reinterpret_cast<const char*>(data.data()), data.size());
+        };
+    }
+}
+
+} // namespace Common
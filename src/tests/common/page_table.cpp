@@ -0,0 +1,53 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/page_table.h"
+
+namespace {
+using BackingTable = Common::PageTable::BackingTable;
+} // Anonymous namespace
+
+TEST_CASE("PageTable: Backings read as unmapped until set", "[common]") {
+    BackingTable table;
+    table.Resize(BackingTable::CHUNK_SIZE * 4);
+    REQUIRE(table.size() == BackingTable::CHUNK_SIZE * 4);
+
+    const std::size_t page = BackingTable::CHUNK_SIZE * 2 + 3;
+    table.Set(page, {0x1000, 0x2000});
+    REQUIRE(table.Get(page).backing_addr == 0x1000);
+    REQUIRE(table.Get(page).block == 0x2000);
+
+    // Neighbours in the same chunk and pages of other chunks stay unmapped
+    REQUIRE(table.Get(page + 1).backing_addr == 0);
+    REQUIRE(table.Get(0).backing_addr == 0);
+    REQUIRE(table.Get(table.size()).backing_addr == 0);
+
+    table.Set(page, {});
+    REQUIRE(table.Get(page).backing_addr == 0);
+    REQUIRE(table.Get(page).block == 0);
+
+    table.Set(page, {0x1000, 0x2000});
+    table.Resize(BackingTable::CHUNK_SIZE * 4);
+    REQUIRE(table.Get(page).backing_addr == 0);
+}
+
+TEST_CASE("PageTable: Traversal reads sparse backings", "[common]") {
+    Common::PageTable page_table;
+    page_table.Resize(32, 12);
+    const std::size_t page = 0x12345;
+    const u64 address = page << 12;
+    // Backings are stored relative to the virtual address of the page
+    page_table.backing.Set(page, {0x80000000 - address, address});
+
+    Common::PageTable::TraversalEntry entry;
+    Common::PageTable::TraversalContext context;
+    REQUIRE(page_table.BeginTraversal(&entry, &context, Common::ProcessAddress{address}));
+    REQUIRE(entry.phys_addr == 0x80000000);
+    REQUIRE(!page_table.ContinueTraversal(&entry, &context));
+
+    Common::PhysicalAddress phys_addr;
+    REQUIRE(page_table.GetPhysicalAddress(&phys_addr, Common::ProcessAddress{address + 0x10}));
+    REQUIRE(GetInteger(phys_addr) == 0x80000010);
+}
@@ -3,6 +3,7 @@
 
 #include <stdexcept>
 
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 
 #include "common/range_map.h"
@@ -68,3 +69,28 @@ TEST_CASE("Range Map: Setup", "[video_core]") {
     REQUIRE(my_map.GetValueAt(5999) == MappedEnum::Valid_3);
     REQUIRE(my_map.GetValueAt(6000) == MappedEnum::Invalid);
 }
+
+TEST_CASE("Range Map: Benchmark", "[video_core][.benchmark]") {
+    // Maps one page out of two, like a fragmented GPU address space
+    static constexpr u64 page_size = 0x10000;
+    static constexpr u64 num_pages = 0x1000;
+    Common::RangeMap<u64, MappedEnum> my_map(MappedEnum::Invalid);
+    for (u64 page = 0; page < num_pages; page += 2) {
+        my_map.Map(page * page_size, (page + 1) * page_size, MappedEnum::Valid_1);
+    }
+    u64 address = 0;
+    BENCHMARK("GetValueAt") {
+        address = (address + page_size * 7 + 0x100) % (num_pages * page_size);
+        return my_map.GetValueAt(address);
+    };
+    BENCHMARK("GetContinuousSizeFrom") {
+        address = (address + page_size * 7 + 0x100) % (num_pages * page_size);
+        return my_map.GetContinuousSizeFrom(address);
+    };
+    BENCHMARK("Map and Unmap") {
+        address = (address + page_size * 7) % (num_pages * page_size);
+        my_map.Map(address, address + page_size * 3, MappedEnum::Valid_2);
+        my_map.Unmap(address, address + page_size * 3);
+        return address;
+    };
+}
@@ -0,0 +1,250 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <limits>
+#include <random>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <boost/icl/interval_set.hpp>
+#include <boost/icl/split_interval_map.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "common/range_sets.h"
+#include "common/range_sets.inc"
+
+namespace Common {
+namespace {
+using IclRangeSet = boost::icl::interval_set<u64>;
+using IclOverlapRangeSet =
+    boost::icl::split_interval_map<u64, s32, boost::icl::partial_enricher, std::less,
+                                   boost::icl::inplace_plus, boost::icl::inter_section>;
+
+std::vector<std::pair<u64, u64>> Ranges(const RangeSet<u64>& set) {
+    std::vector<std::pair<u64, u64>> ranges;
+    set.ForEach([&](u64 begin, u64 end) { ranges.emplace_back(begin, end); });
+    return ranges;
+}
+
+std::vector<std::pair<u64, u64>> Ranges(const IclRangeSet& set) {
+    std::vector<std::pair<u64, u64>> ranges;
+    for (const auto& interval : set) {
+        ranges.emplace_back(interval.lower(), interval.upper());
+    }
+    return ranges;
+}
+
+std::vector<std::tuple<u64, u64, s32>> Segments(const OverlapRangeSet<u64>& set) {
+    std::vector<std::tuple<u64, u64, s32>> segments;
+    set.ForEach([&](u64 begin, u64 end, s32 count) { segments.emplace_back(begin, end, count); });
+    return segments;
+}
+
+std::vector<std::tuple<u64, u64, s32>> Segments(const IclOverlapRangeSet& set) {
+    std::vector<std::tuple<u64, u64, s32>> segments;
+    for (const auto& [interval, count] : set) {
+        segments.emplace_back(interval.lower(), interval.upper(), count);
+    }
+    return segments;
+}
+
+// Mirrors the subtraction of the boost::icl implementation the flat sets replaced
+void IclSubtract(IclOverlapRangeSet& set, u64 begin, u64 end, s32 amount,
+                 std::vector<std::pair<u64, u64>>* deleted) {
+    const auto interval = boost::icl::interval<u64>::right_open(begin, end);
+    set += std::make_pair(interval, -amount);
+    for (auto it = set.lower_bound(interval); it != set.upper_bound(interval);) {
+        if (it->second > 0) {
+            ++it;
+            continue;
+        }
+        if (it->second == 0 && deleted) {
+            deleted->emplace_back(it->first.lower(), it->first.upper());
+        }
+        set.erase(it++);
+    }
+}
+} // Anonymous namespace
+
+TEST_CASE("RangeSet: Add and subtract", "[common]") {
+    RangeSet<u64> set;
+    REQUIRE(set.Empty());
+
+    set.Add(0x1000, 0x1000);
+    set.Add(0x2000, 0x1000);
+    set.Add(0x5000, 0x1000);
+    REQUIRE(Ranges(set) == std::vector<std::pair<u64, u64>>{{0x1000, 0x3000}, {0x5000, 0x6000}});
+
+    set.Subtract(0x1800, 0x100);
+    REQUIRE(Ranges(set) == std::vector<std::pair<u64, u64>>{
+                               {0x1000, 0x1800}, {0x1900, 0x3000}, {0x5000, 0x6000}});
+
+    std::vector<std::pair<u64, u64>> clipped;
+    set.ForEachInRange(0x2800, 0x3000,
+                       [&](u64 begin, u64 end) { clipped.emplace_back(begin, end); });
+    REQUIRE(clipped == std::vector<std::pair<u64, u64>>{{0x2800, 0x3000}, {0x5000, 0x5800}});
+
+    set.Clear();
+    REQUIRE(set.Empty());
+}
+
+TEST_CASE("RangeSet: Matches boost::icl", "[common]") {
+    std::mt19937 random{1234};
+    std::uniform_int_distribution<u64> page{0, 0x100};
+    std::uniform_int_distribution<u64> pages{1, 0x10};
+    RangeSet<u64> set;
+    IclRangeSet reference;
+    for (int i = 0; i < 5000; ++i) {
+        const u64 begin = page(random) * 0x100;
+        const u64 size = pages(random) * 0x100;
+        if (random() % 2 == 0) {
+            set.Add(begin, size);
+            reference.add(boost::icl::interval<u64>::right_open(begin, begin + size));
+        } else {
+            set.Subtract(begin, size);
+            reference.subtract(boost::icl::interval<u64>::right_open(begin, begin + size));
+        }
+        REQUIRE(Ranges(set) == Ranges(reference));
+    }
+}
+
+TEST_CASE("OverlapRangeSet: Matches boost::icl", "[common]") {
+    std::mt19937 random{1234};
+    std::uniform_int_distribution<u64> page{0, 0x100};
+    std::uniform_int_distribution<u64> pages{1, 0x10};
+    OverlapRangeSet<u64> set;
+    IclOverlapRangeSet reference;
+    for (int i = 0; i < 5000; ++i) {
+        const u64 begin = page(random) * 0x100;
+        const u64 size = pages(random) * 0x100;
+        const u32 operation = random() % 5;
+        if (operation < 2) {
+            set.Add(begin, size);
+            reference += std::make_pair(
+                boost::icl::interval<u64>::right_open(begin, begin + size), 1);
+        } else if (operation < 4) {
+            std::vector<std::pair<u64, u64>> deleted;
+            std::vector<std::pair<u64, u64>> reference_deleted;
+            set.Subtract(begin, size,
+                         [&](u64 start, u64 end) { deleted.emplace_back(start, end); });
+            IclSubtract(reference, begin, begin + size, 1, &reference_deleted);
+            REQUIRE(deleted == reference_deleted);
+        } else {
+            set.DeleteAll(begin, size);
+            IclSubtract(reference, begin, begin + size, std::numeric_limits<s32>::max(), nullptr);
+        }
+        REQUIRE(Segments(set) == Segments(reference));
+    }
+}
+
+TEST_CASE("RangeSet: Benchmark", "[common][.benchmark]") {
+    // Written ranges of a buffer cache, scattered over a large address space
+    static constexpr u64 page_size = 0x1000;
+    static constexpr u64 num_pages = 0x4000;
+    RangeSet<u64> set;
+    for (u64 page = 0; page < num_pages; page += 3) {
+        set.Add(page * page_size, page_size);
+    }
+    u64 gap = 0;
+    BENCHMARK("Add and subtract") {
+        // Fill a gap and clear it again, leaving the set as it was
+        gap = (gap + 31) % (num_pages / 3);
+        const u64 gap_address = (gap * 3 + 1) * page_size;
+        set.Add(gap_address, page_size);
+        set.Subtract(gap_address, page_size);
+        return gap_address;
+    };
+    u64 address = 0;
+    BENCHMARK("ForEachInRange") {
+        address = (address + page_size * 31) % (num_pages * page_size);
+        u64 total = 0;
+        set.ForEachInRange(address, page_size * 64,
+                           [&](u64 begin, u64 end) { total += end - begin; });
+        return total;
+    };
+}
+
+TEST_CASE("RangeSet: Buffer cache trace benchmark", "[common][.benchmark]") {
+    // Per draw, a buffer cache marks a few written ranges, checks others and commits the set
+    struct Operation {
+        bool add;
+        u64 address;
+        u64 size;
+    };
+    std::mt19937 random{1234};
+    std::uniform_int_distribution<u64> buffer{0, 0x200};
+    std::uniform_int_distribution<u64> size{0x10, 0x4000};
+    std::vector<Operation> trace(0x1000);
+    for (Operation& operation : trace) {
+        operation = Operation{
+            .add = random() % 4 != 0,
+            .address = buffer(random) * 0x10000,
+            .size = size(random),
+        };
+    }
+    BENCHMARK("Flat RangeSet") {
+        RangeSet<u64> set;
+        u64 total = 0;
+        for (const Operation& operation : trace) {
+            if (operation.add) {
+                set.Add(operation.address, operation.size);
+            } else {
+                set.ForEachInRange(operation.address, operation.size,
+                                   [&](u64 begin, u64 end) { total += end - begin; });
+                set.Subtract(operation.address, operation.size);
+            }
+        }
+        return total;
+    };
+    BENCHMARK("boost::icl interval_set") {
+        IclRangeSet set;
+        u64 total = 0;
+        for (const Operation& operation : trace) {
+            const auto interval = boost::icl::interval<u64>::right_open(
+                operation.address, operation.address + operation.size);
+            if (operation.add) {
+                set.add(interval);
+            } else {
+                for (auto it = set.lower_bound(interval); it != set.upper_bound(interval); ++it) {
+                    total += std::min(it->upper(), interval.upper()) -
+                             std::max(it->lower(), interval.lower());
+                }
+                set.subtract(interval);
+            }
+        }
+        return total;
+    };
+    BENCHMARK("Flat OverlapRangeSet") {
+        OverlapRangeSet<u64> set;
+        u64 total = 0;
+        for (const Operation& operation : trace) {
+            if (operation.add) {
+                set.Add(operation.address, operation.size);
+            } else {
+                set.Subtract(operation.address, operation.size,
+                             [&](u64 begin, u64 end) { total += end - begin; });
+            }
+        }
+        return total;
+    };
+    BENCHMARK("boost::icl split_interval_map") {
+        IclOverlapRangeSet set;
+        std::vector<std::pair<u64, u64>> deleted;
+        for (const Operation& operation : trace) {
+            if (operation.add) {
+                set += std::make_pair(boost::icl::interval<u64>::right_open(
+                                          operation.address, operation.address + operation.size),
+                                      1);
+            } else {
+                IclSubtract(set, operation.address, operation.address + operation.size, 1,
+                            &deleted);
+            }
+        }
+        return deleted.size();
+    };
+}
+
+} // namespace Common
@@ -7,7 +7,9 @@
 #include <numeric>
 #include <thread>
 #include <vector>
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include "common/common_types.h"
 #include "common/ring_buffer.h"
 
 namespace Common {
@@ -126,4 +128,20 @@ TEST_CASE("RingBuffer: Threaded Test", "[common]") {
     printf("RingBuffer: Threaded Test: full: %zu, empty: %zu\n", full, empty);
 }
 
+TEST_CASE("RingBuffer: Benchmark", "[common][.benchmark]") {
+    // Sized like the audio sink's sample ring, moving one audio frame of stereo samples at a time
+    RingBuffer<s16, 0x10000> buf;
+    std::array<s16, 480 * 2> frame{};
+    std::iota(frame.begin(), frame.end(), s16{0});
+    std::array<s16, 480 * 2> output{};
+    BENCHMARK("Push and pop one frame") {
+        buf.Push(frame);
+        return buf.Pop(output.data(), output.size());
+    };
+    BENCHMARK("Push and pop one frame to a vector") {
+        buf.Push(frame);
+        return buf.Pop(frame.size()).size();
+    };
+}
+
 } // namespace Common
@@ -5,6 +5,8 @@
 #include <array>
 #include <cstring>
 #include <span>
+#include <vector>
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include "common/common_types.h"
 #include "common/scratch_buffer.h"
@@ -197,4 +199,22 @@ TEST_CASE("ScratchBuffer: Span Writes", "[common]") {
     }
 }
 
+TEST_CASE("ScratchBuffer: Benchmark", "[common][.benchmark]") {
+    // Alternates between two sizes, as when reading buffers of varying sizes through one scratch
+    static constexpr size_t large_size = 0x10000;
+    static constexpr size_t small_size = 0x100;
+    ScratchBuffer<u8> buf;
+    BENCHMARK("ScratchBuffer resize_destructive") {
+        buf.resize_destructive(large_size);
+        buf.resize_destructive(small_size);
+        return buf.data();
+    };
+    std::vector<u8> vector;
+    BENCHMARK("std::vector resize") {
+        vector.resize(large_size);
+        vector.resize(small_size);
+        return vector.data();
+    };
+}
+
 } // namespace Common
@@ -0,0 +1,109 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "common/slot_vector.h"
+
+namespace Common {
+
+TEST_CASE("SlotVector: Insert, erase and iterate", "[common]") {
+    SlotVector<u64> slots;
+    std::vector<SlotId> ids;
+    for (u64 i = 0; i < 200; ++i) {
+        ids.push_back(slots.insert(i));
+    }
+    REQUIRE(slots.size() == 200U);
+    for (u64 i = 0; i < 200; ++i) {
+        REQUIRE(slots[ids[i]] == i);
+    }
+
+    // Empty the first words of the bitset so iteration has to skip them
+    for (u64 i = 0; i < 150; ++i) {
+        slots.erase(ids[i]);
+    }
+    REQUIRE(slots.size() == 50U);
+    u64 sum = 0;
+    size_t count = 0;
+    for (const auto [id, value] : slots) {
+        REQUIRE(slots[id] == *value);
+        sum += *value;
+        ++count;
+    }
+    REQUIRE(count == 50U);
+    REQUIRE(sum == (150U + 199U) * 50U / 2U);
+
+    // Freed slots are reused before the vector grows
+    const SlotId reused = slots.insert(1234U);
+    REQUIRE(slots[reused] == 1234U);
+    REQUIRE(slots.size() == 51U);
+}
+
+TEST_CASE("SlotVector: Generations and stable storage", "[common]") {
+    SlotVector<u64> slots;
+    const SlotId first = slots.insert(1U);
+    const u64* const first_address = &slots[first];
+
+    // Growing the vector doesn't move objects
+    std::vector<SlotId> ids;
+    for (u64 i = 0; i < 1000; ++i) {
+        ids.push_back(slots.insert(i));
+    }
+    REQUIRE(&slots[first] == first_address);
+
+    // A reused slot hands out a new id, so stale ids can be told apart
+    slots.erase(first);
+    const SlotId reused = slots.insert(2U);
+    REQUIRE(reused.Slot() == first.Slot());
+    REQUIRE(reused.Generation() == first.Generation() + 1);
+    REQUIRE(reused != first);
+
+    // Compacting releases empty chunks without touching live objects
+    for (size_t i = 100; i < ids.size(); ++i) {
+        slots.erase(ids[i]);
+    }
+    slots.Compact();
+    REQUIRE(slots.size() == 101U);
+    for (u64 i = 0; i < 100; ++i) {
+        REQUIRE(slots[ids[i]] == i);
+    }
+    for (u64 i = 0; i < 1000; ++i) {
+        ids.push_back(slots.insert(i));
+    }
+    REQUIRE(slots.size() == 1101U);
+    REQUIRE(slots[ids.back()] == 999U);
+}
+
+TEST_CASE("SlotVector: Benchmark", "[common][.benchmark]") {
+    // A cache with as many entries as a texture cache during gameplay
+    static constexpr size_t num_entries = 4096;
+    SlotVector<u64> slots;
+    std::vector<SlotId> ids;
+    for (size_t i = 0; i < num_entries; ++i) {
+        ids.push_back(slots.insert(i));
+    }
+    size_t next = 0;
+    BENCHMARK("Erase and insert") {
+        next = (next + 97) % num_entries;
+        slots.erase(ids[next]);
+        ids[next] = slots.insert(next);
+        return ids[next];
+    };
+    BENCHMARK("Lookup") {
+        next = (next + 97) % num_entries;
+        return slots[ids[next]];
+    };
+    BENCHMARK("Iterate") {
+        u64 sum = 0;
+        for (const auto [id, value] : slots) {
+            sum += *value;
+        }
+        return sum;
+    };
+}
+
+} // namespace Common
@@ -0,0 +1,69 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/task_scheduler.h"
+
+using Common::TaskGroup;
+using Common::TaskPriority;
+using Common::TaskScheduler;
+
+TEST_CASE("TaskScheduler: Groups wait for all their tasks", "[common]") {
+    TaskScheduler scheduler{4};
+    std::atomic<int> count{};
+    TaskGroup group{TaskPriority::Normal, scheduler};
+    for (int i = 0; i < 1000; ++i) {
+        group.Run([&count] { ++count; }, static_cast<size_t>(i % 3));
+    }
+    group.Wait();
+    REQUIRE(count == 1000);
+}
+
+TEST_CASE("TaskScheduler: Groups can be waited on from inside tasks", "[common]") {
+    // A single worker has to run the nested tasks itself while it waits on them
+    TaskScheduler scheduler{1};
+    std::atomic<int> count{};
+    TaskGroup outer{TaskPriority::Normal, scheduler};
+    for (int i = 0; i < 4; ++i) {
+        outer.Run([&scheduler, &count] {
+            TaskGroup inner{TaskPriority::Normal, scheduler};
+            for (int j = 0; j < 8; ++j) {
+                inner.Run([&count] { ++count; });
+            }
+            inner.Wait();
+        });
+    }
+    outer.Wait();
+    REQUIRE(count == 32);
+}
+
+TEST_CASE("TaskScheduler: Higher priority tasks start first", "[common]") {
+    TaskScheduler scheduler{1};
+    std::atomic<bool> released{};
+    std::mutex order_mutex;
+    std::vector<TaskPriority> order;
+    TaskGroup blocker{TaskPriority::High, scheduler};
+    blocker.Run([&released] {
+        while (!released) {
+            std::this_thread::yield();
+        }
+    });
+    {
+        TaskGroup low{TaskPriority::Low, scheduler};
+        TaskGroup high{TaskPriority::High, scheduler};
+        const auto record = [&](TaskPriority priority) {
+            std::scoped_lock lock{order_mutex};
+            order.push_back(priority);
+        };
+        low.Run([&record] { record(TaskPriority::Low); });
+        high.Run([&record] { record(TaskPriority::High); });
+        released = true;
+    }
+    blocker.Wait();
+    REQUIRE(order == std::vector{TaskPriority::High, TaskPriority::Low});
+}
@@ -4,6 +4,7 @@
 #include <catch2/catch_test_macros.hpp>
 
 #include <array>
+#include <atomic>
 #include <bitset>
 #include <chrono>
 #include <cstdlib>
@@ -40,6 +41,13 @@ struct ScopeInit final {
     Core::Timing::CoreTiming core_timing;
 };
 
+std::atomic<u64> stress_callbacks_ran{};
+
+std::optional<std::chrono::nanoseconds> StressCallback(s64 time, std::chrono::nanoseconds ns_late) {
+    ++stress_callbacks_ran;
+    return std::nullopt;
+}
+
 u64 TestTimerSpeed(Core::Timing::CoreTiming& core_timing) {
     const u64 start = core_timing.GetGlobalTimeNs().count();
     volatile u64 placebo = 0;
@@ -139,3 +147,48 @@ TEST_CASE("CoreTiming[BasicOrderNoPausing]", "[core]") {
     printf("HostTimer No Pausing Timer Time: %.3f %.6f\n", timer_time / 1000.f,
            timer_time / 1000000.f);
 }
+
+TEST_CASE("CoreTiming[Stress]", "[core]") {
+    ScopeInit guard;
+    auto& core_timing = guard.core_timing;
+    std::vector<std::shared_ptr<Core::Timing::EventType>> events;
+    for (std::size_t i = 0; i < 16; i++) {
+        events.push_back(Core::Timing::CreateEvent("stress", StressCallback));
+    }
+
+    core_timing.SyncPause(true);
+    core_timing.SyncPause(false);
+
+    const auto seconds_since{[&core_timing](u64 start) {
+        return static_cast<double>(core_timing.GetGlobalTimeNs().count() - start) / 1e9;
+    }};
+
+    // Timeouts that are moved before they expire, like the kernel hardware timer does
+    constexpr std::size_t num_reschedules = 200000;
+    stress_callbacks_ran = 0;
+    u64 start = core_timing.GetGlobalTimeNs().count();
+    for (std::size_t i = 0; i < num_reschedules; i++) {
+        const auto& event = events[i % events.size()];
+        core_timing.UnscheduleEvent(event, Core::Timing::UnscheduleEventType::NoWait);
+        core_timing.ScheduleEvent(std::chrono::seconds{10}, event);
+    }
+    const double reschedule_time = seconds_since(start);
+    for (const auto& event : events) {
+        core_timing.UnscheduleEvent(event);
+    }
+    REQUIRE(stress_callbacks_ran == 0);
+
+    constexpr std::size_t num_events = 100000;
+    start = core_timing.GetGlobalTimeNs().count();
+    for (std::size_t i = 0; i < num_events; i++) {
+        const auto future_ns = std::chrono::nanoseconds{static_cast<s64>((i % 1000) * 100)};
+        core_timing.ScheduleEvent(future_ns, events[i % events.size()]);
+    }
+    while (stress_callbacks_ran < num_events)
+        ;
+    const double events_time = seconds_since(start);
+    REQUIRE(stress_callbacks_ran == num_events);
+
+    printf("HostTimer Stress Reschedules: %.0f per second\n", num_reschedules / reschedule_time);
+    printf("HostTimer Stress Events: %.0f per second\n", num_events / events_time);
+}
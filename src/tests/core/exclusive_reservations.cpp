@@ -0,0 +1,115 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "core/arm/exclusive_reservations.h"
+
+namespace {
+constexpr std::size_t NUM_CORES = 4;
+constexpr VAddr address = 0x1000;
+
+bool CompareAndSwap(u64& word, u64 expected, u64 value) {
+    return std::atomic_ref<u64>{word}.compare_exchange_strong(expected, value);
+}
+
+u64 Load(u64& word) {
+    return std::atomic_ref<u64>{word}.load();
+}
+
+bool ExclusiveIncrement(Core::ExclusiveReservations& reservations, std::size_t core, u64& word) {
+    const u64 value = reservations.ReadAndMark<u64>(core, address, [&] { return Load(word); });
+    return reservations.DoExclusiveOperation<u64>(
+        core, address, [&](u64 expected) { return CompareAndSwap(word, expected, value + 1); });
+}
+
+/// Runs a thread per core, retrying each increment until it succeeds
+template <typename Function>
+void RunContendedIncrements(std::size_t num_cores, u64 increments_per_core, Function&& increment) {
+    std::vector<std::jthread> threads;
+    for (std::size_t core = 0; core < num_cores; ++core) {
+        threads.emplace_back([&, core] {
+            for (u64 i = 0; i < increments_per_core; ++i) {
+                while (!increment(core)) {
+                }
+            }
+        });
+    }
+}
+} // Anonymous namespace
+
+TEST_CASE("ExclusiveReservations: Stores require a matching reservation", "[core]") {
+    Core::ExclusiveReservations reservations{2};
+    u64 word = 5;
+    const auto store{[&](std::size_t core, VAddr addr, u64 value) {
+        return reservations.DoExclusiveOperation<u64>(
+            core, addr, [&](u64 expected) { return CompareAndSwap(word, expected, value); });
+    }};
+
+    // Nothing has been reserved yet
+    REQUIRE(!store(0, address, 1));
+
+    REQUIRE(reservations.ReadAndMark<u64>(0, address, [&] { return Load(word); }) == 5);
+    REQUIRE(!store(1, address, 1));
+    REQUIRE(!store(0, address + 8, 1));
+
+    // A failed store clears the reservation
+    REQUIRE(!store(0, address, 1));
+
+    (void)reservations.ReadAndMark<u64>(0, address, [&] { return Load(word); });
+    REQUIRE(!reservations.DoExclusiveOperation<u32>(0, address, [](u32) { return true; }));
+
+    (void)reservations.ReadAndMark<u64>(0, address, [&] { return Load(word); });
+    reservations.ClearProcessor(0);
+    REQUIRE(!store(0, address, 1));
+
+    (void)reservations.ReadAndMark<u64>(0, address, [&] { return Load(word); });
+    REQUIRE(store(0, address, 1));
+    REQUIRE(word == 1);
+
+    // The value changed since it was reserved
+    (void)reservations.ReadAndMark<u64>(1, address, [&] { return Load(word); });
+    word = 2;
+    REQUIRE(!store(1, address, 3));
+    REQUIRE(word == 2);
+}
+
+TEST_CASE("ExclusiveReservations: Contended increments are not lost", "[core]") {
+    Core::ExclusiveReservations reservations{NUM_CORES};
+    u64 counter = 0;
+    RunContendedIncrements(NUM_CORES, 100000, [&](std::size_t core) {
+        return ExclusiveIncrement(reservations, core, counter);
+    });
+    REQUIRE(counter == NUM_CORES * 100000);
+}
+
+TEST_CASE("ExclusiveReservations: Benchmark", "[core][.benchmark]") {
+    constexpr u64 increments_per_core = 20000;
+    Core::ExclusiveReservations reservations{NUM_CORES};
+    u64 counter = 0;
+    std::mutex global_lock;
+
+    // Baseline, every exclusive access pair serialized behind one lock like the global monitor
+    BENCHMARK("Global lock") {
+        RunContendedIncrements(NUM_CORES, increments_per_core, [&](std::size_t) {
+            std::scoped_lock lock{global_lock};
+            ++counter;
+            return true;
+        });
+        return counter;
+    };
+    BENCHMARK("Per core reservations") {
+        RunContendedIncrements(NUM_CORES, increments_per_core, [&](std::size_t core) {
+            return ExclusiveIncrement(reservations, core, counter);
+        });
+        return counter;
+    };
+}
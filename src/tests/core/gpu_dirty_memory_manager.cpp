@@ -0,0 +1,133 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "core/gpu_dirty_memory_manager.h"
+
+namespace {
+constexpr std::size_t NUM_CORES = 4;
+constexpr std::size_t GRANULE_SIZE = 64;
+constexpr std::size_t GRANULES_PER_CORE = 0x4000;
+
+PAddr CoreBase(std::size_t core) {
+    return static_cast<PAddr>(core) << 24;
+}
+
+/// Runs a thread per core, each one collecting into its own manager
+template <typename Function>
+void RunPerCore(std::array<Core::GPUDirtyMemoryManager, NUM_CORES>& managers, Function&& write) {
+    std::vector<std::jthread> threads;
+    for (std::size_t core = 0; core < NUM_CORES; ++core) {
+        threads.emplace_back([&, core] { write(managers[core], core); });
+    }
+}
+} // Anonymous namespace
+
+TEST_CASE("GPUDirtyMemoryManager: Merges adjacent writes", "[core]") {
+    Core::GPUDirtyMemoryManager manager;
+    manager.Collect(0x1000, 0x40);
+    manager.Collect(0x1040, 0x40);
+    manager.Collect(0x1040, 0x10);
+    manager.Collect(0x10000, 0x10);
+
+    std::vector<std::pair<PAddr, std::size_t>> ranges;
+    std::function<void(PAddr, std::size_t)> callback{
+        [&](PAddr address, std::size_t size) { ranges.emplace_back(address, size); }};
+    manager.Gather(callback);
+    REQUIRE(ranges.size() == 2);
+    REQUIRE(ranges[0] == std::pair<PAddr, std::size_t>{0x1000, 0x80});
+    REQUIRE(ranges[1] == std::pair<PAddr, std::size_t>{0x10000, 0x40});
+
+    ranges.clear();
+    manager.Gather(callback);
+    REQUIRE(ranges.empty());
+}
+
+TEST_CASE("GPUDirtyMemoryManager: Concurrent writes are not lost", "[core]") {
+    std::array<Core::GPUDirtyMemoryManager, NUM_CORES> managers;
+    std::array<std::vector<bool>, NUM_CORES> gathered;
+    for (auto& granules : gathered) {
+        granules.resize(GRANULES_PER_CORE);
+    }
+    std::function<void(PAddr, std::size_t)> callback{[&](PAddr address, std::size_t size) {
+        const std::size_t core = address >> 24;
+        const std::size_t first = (address - CoreBase(core)) / GRANULE_SIZE;
+        for (std::size_t i = 0; i < size / GRANULE_SIZE; ++i) {
+            gathered[core][first + i] = true;
+        }
+    }};
+
+    // Gather like the GPU thread does, while the cores keep writing
+    std::atomic_bool done{false};
+    std::jthread gpu_thread([&] {
+        while (!done.load()) {
+            for (auto& manager : managers) {
+                manager.Gather(callback);
+            }
+        }
+    });
+    RunPerCore(managers, [](Core::GPUDirtyMemoryManager& manager, std::size_t core) {
+        for (std::size_t i = 0; i < GRANULES_PER_CORE; ++i) {
+            manager.Collect(CoreBase(core) + i * GRANULE_SIZE, GRANULE_SIZE);
+        }
+    });
+    done = true;
+    gpu_thread.join();
+    for (auto& manager : managers) {
+        manager.Gather(callback);
+    }
+    for (const auto& granules : gathered) {
+        for (const bool granule : granules) {
+            REQUIRE(granule);
+        }
+    }
+}
+
+TEST_CASE("GPUDirtyMemoryManager: Benchmark", "[core][.benchmark]") {
+    std::array<Core::GPUDirtyMemoryManager, NUM_CORES> managers;
+    std::size_t num_ranges = 0;
+    std::function<void(PAddr, std::size_t)> callback{
+        [&](PAddr, std::size_t) { ++num_ranges; }};
+    const auto gather{[&] {
+        for (auto& manager : managers) {
+            manager.Gather(callback);
+        }
+        return num_ranges;
+    }};
+
+    BENCHMARK("Sequential writes") {
+        RunPerCore(managers, [](Core::GPUDirtyMemoryManager& manager, std::size_t core) {
+            for (std::size_t i = 0; i < GRANULES_PER_CORE; ++i) {
+                manager.Collect(CoreBase(core) + i * GRANULE_SIZE, GRANULE_SIZE);
+            }
+        });
+        return gather();
+    };
+    BENCHMARK("Repeated writes") {
+        RunPerCore(managers, [](Core::GPUDirtyMemoryManager& manager, std::size_t core) {
+            for (std::size_t i = 0; i < GRANULES_PER_CORE; ++i) {
+                manager.Collect(CoreBase(core) + (i % 4) * GRANULE_SIZE, 8);
+            }
+        });
+        return gather();
+    };
+    BENCHMARK("Scattered writes") {
+        RunPerCore(managers, [](Core::GPUDirtyMemoryManager& manager, std::size_t core) {
+            for (std::size_t i = 0; i < GRANULES_PER_CORE; ++i) {
+                manager.Collect(CoreBase(core) + ((i * 0x9E37) % 0x2000) * 0x800, 8);
+            }
+        });
+        return gather();
+    };
+}
@@ -0,0 +1,66 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "core/hle/kernel/k_spin_lock.h"
+
+namespace {
+constexpr std::size_t NUM_THREADS = 8;
+constexpr u64 INCREMENTS_PER_THREAD = 100'000;
+} // Anonymous namespace
+
+TEST_CASE("KSpinLock: Mutual exclusion under contention", "[core]") {
+    // More threads than emulated cores, so that owners also get preempted while holding the lock
+    Kernel::KSpinLock lock;
+    u64 counter = 0;
+    std::atomic<u32> num_inside = 0;
+    std::atomic<bool> overlapped = false;
+    {
+        std::vector<std::jthread> threads;
+        for (std::size_t thread = 0; thread < NUM_THREADS; ++thread) {
+            threads.emplace_back([&] {
+                for (u64 i = 0; i < INCREMENTS_PER_THREAD; ++i) {
+                    Kernel::KScopedSpinLock lk{lock};
+                    if (num_inside.fetch_add(1) != 0) {
+                        overlapped = true;
+                    }
+                    ++counter;
+                    num_inside.fetch_sub(1);
+                }
+            });
+        }
+    }
+    REQUIRE(!overlapped);
+    REQUIRE(counter == NUM_THREADS * INCREMENTS_PER_THREAD);
+}
+
+TEST_CASE("KSpinLock: Sleeping waiters are woken on unlock", "[core]") {
+    using namespace std::chrono_literals;
+    Kernel::KSpinLock lock;
+    lock.Lock();
+    REQUIRE(!lock.TryLock());
+
+    std::atomic<bool> acquired = false;
+    std::jthread waiter([&] {
+        lock.Lock();
+        acquired = true;
+        lock.Unlock();
+    });
+    // Long enough for the waiter to stop spinning and go to sleep
+    std::this_thread::sleep_for(50ms);
+    REQUIRE(!acquired);
+
+    lock.Unlock();
+    waiter.join();
+    REQUIRE(acquired);
+    REQUIRE(lock.TryLock());
+    lock.Unlock();
+}
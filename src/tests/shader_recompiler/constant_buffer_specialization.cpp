@@ -0,0 +1,178 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <map>
+#include <utility>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "shader_recompiler/environment.h"
+#include "shader_recompiler/frontend/ir/basic_block.h"
+#include "shader_recompiler/frontend/ir/ir_emitter.h"
+#include "shader_recompiler/frontend/ir/program.h"
+#include "shader_recompiler/ir_opt/passes.h"
+#include "shader_recompiler/object_pool.h"
+
+namespace {
+using namespace Shader;
+
+/// Answers constant buffer reads from a map, counting them
+class CbufEnvironment final : public Environment {
+public:
+    explicit CbufEnvironment(std::map<std::pair<u32, u32>, u32> values_)
+        : values{std::move(values_)} {}
+
+    u64 ReadInstruction(u32) override {
+        return 0;
+    }
+
+    u32 ReadCbufValue(u32 cbuf_index, u32 cbuf_offset) override {
+        ++num_reads;
+        const auto it{values.find({cbuf_index, cbuf_offset})};
+        return it != values.end() ? it->second : 0;
+    }
+
+    TextureType ReadTextureType(u32) override {
+        return TextureType::Color2D;
+    }
+
+    TexturePixelFormat ReadTexturePixelFormat(u32) override {
+        return TexturePixelFormat::A8B8G8R8_UNORM;
+    }
+
+    bool IsTexturePixelFormatInteger(u32) override {
+        return false;
+    }
+
+    u32 ReadViewportTransformState() override {
+        return 1;
+    }
+
+    u32 TextureBoundBuffer() const override {
+        return 0;
+    }
+
+    u32 LocalMemorySize() const override {
+        return 0;
+    }
+
+    u32 SharedMemorySize() const override {
+        return 0;
+    }
+
+    std::array<u32, 3> WorkgroupSize() const override {
+        return {};
+    }
+
+    bool HasHLEMacroState() const override {
+        return false;
+    }
+
+    std::optional<ReplaceConstant> GetReplaceConstBuffer(u32, u32) override {
+        return std::nullopt;
+    }
+
+    void Dump(u64, u64) override {}
+
+    u32 num_reads{};
+
+private:
+    std::map<std::pair<u32, u32>, u32> values;
+};
+
+IR::Program MakeProgram(IR::Block& block, Stage stage) {
+    IR::Program program;
+    program.blocks = {&block};
+    program.post_order_blocks = {&block};
+    program.stage = stage;
+    return program;
+}
+} // Anonymous namespace
+
+TEST_CASE("ConstantBufferSpecialization: Branch conditions are folded", "[shader]") {
+    ObjectPool<IR::Inst> inst_pool;
+    IR::Block block{inst_pool};
+    IR::IREmitter ir{block};
+    const IR::U32 flags{ir.GetCbuf(ir.Imm32(3), ir.Imm32(16))};
+    const IR::U1 cond{ir.INotEqual(ir.BitwiseAnd(flags, ir.Imm32(4)), ir.Imm32(0))};
+    ir.ConditionRef(cond);
+    const IR::F32 scale{ir.GetFloatCbuf(ir.Imm32(3), ir.Imm32(20))};
+    ir.ConditionRef(ir.FPGreaterThan(scale, ir.Imm32(0.5f)));
+    const IR::U32 color{ir.GetCbuf(ir.Imm32(3), ir.Imm32(32))};
+    const IR::U32 sum{ir.IAdd(color, ir.Imm32(1))};
+
+    CbufEnvironment env{{{{3, 16}, 6}, {{3, 20}, 0x3f800000}, {{3, 32}, 9}}};
+    IR::Program program{MakeProgram(block, Stage::Fragment)};
+    Optimization::ConstantBufferSpecializationPass(env, program);
+
+    const auto& guards{program.info.constant_buffer_guards};
+    REQUIRE(guards.size() == 2);
+    REQUIRE(guards[0] == ConstantBufferGuard{.index = 3, .offset = 16, .value = 6});
+    REQUIRE(guards[1] == ConstantBufferGuard{.index = 3, .offset = 20, .value = 0x3f800000});
+    REQUIRE(flags.IsImmediate());
+    REQUIRE(flags.U32() == 6);
+    REQUIRE(scale.IsImmediate());
+    REQUIRE(scale.F32() == 1.0f);
+
+    // Values not deciding any branch keep reading the constant buffer
+    REQUIRE(!color.IsImmediate());
+    REQUIRE(sum.InstRecursive()->Arg(0).InstRecursive()->GetOpcode() == IR::Opcode::GetCbufU32);
+}
+
+TEST_CASE("ConstantBufferSpecialization: Narrow loads guard their word", "[shader]") {
+    ObjectPool<IR::Inst> inst_pool;
+    IR::Block block{inst_pool};
+    IR::IREmitter ir{block};
+    const IR::U32 byte{ir.GetCbuf(ir.Imm32(1), ir.Imm32(17), 8, true)};
+    const IR::U32 half{ir.GetCbuf(ir.Imm32(1), ir.Imm32(18), 16, false)};
+    ir.ConditionRef(ir.ILessThan(byte, half, true));
+
+    CbufEnvironment env{{{{1, 16}, 0x1234'ff00}}};
+    IR::Program program{MakeProgram(block, Stage::VertexB)};
+    Optimization::ConstantBufferSpecializationPass(env, program);
+
+    // Both loads share the word they are read from
+    const auto& guards{program.info.constant_buffer_guards};
+    REQUIRE(guards.size() == 1);
+    REQUIRE(guards[0] == ConstantBufferGuard{.index = 1, .offset = 16, .value = 0x1234'ff00});
+    REQUIRE(env.num_reads == 1);
+    REQUIRE(byte.U32() == static_cast<u32>(-1));
+    REQUIRE(half.U32() == 0x1234);
+}
+
+TEST_CASE("ConstantBufferSpecialization: Guards are limited", "[shader]") {
+    ObjectPool<IR::Inst> inst_pool;
+    IR::Block block{inst_pool};
+    IR::IREmitter ir{block};
+    std::vector<IR::U32> loads;
+    for (u32 word = 0; word < 12; ++word) {
+        loads.push_back(ir.GetCbuf(ir.Imm32(2), ir.Imm32(word * 4)));
+        ir.ConditionRef(ir.IEqual(loads.back(), ir.Imm32(0)));
+    }
+
+    CbufEnvironment env{{}};
+    IR::Program program{MakeProgram(block, Stage::Fragment)};
+    Optimization::ConstantBufferSpecializationPass(env, program);
+
+    REQUIRE(program.info.constant_buffer_guards.size() == 8);
+    for (size_t index = 0; index < loads.size(); ++index) {
+        REQUIRE(loads[index].IsImmediate() == (index < 8));
+    }
+}
+
+TEST_CASE("ConstantBufferSpecialization: Compute programs are not specialized", "[shader]") {
+    ObjectPool<IR::Inst> inst_pool;
+    IR::Block block{inst_pool};
+    IR::IREmitter ir{block};
+    const IR::U32 flags{ir.GetCbuf(ir.Imm32(0), ir.Imm32(0))};
+    ir.ConditionRef(ir.IEqual(flags, ir.Imm32(0)));
+
+    CbufEnvironment env{{}};
+    IR::Program program{MakeProgram(block, Stage::Compute)};
+    Optimization::ConstantBufferSpecializationPass(env, program);
+
+    REQUIRE(program.info.constant_buffer_guards.empty());
+    REQUIRE(!flags.IsImmediate());
+    REQUIRE(env.num_reads == 0);
+}
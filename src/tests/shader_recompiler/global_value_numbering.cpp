@@ -0,0 +1,89 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "shader_recompiler/frontend/ir/basic_block.h"
+#include "shader_recompiler/frontend/ir/ir_emitter.h"
+#include "shader_recompiler/frontend/ir/program.h"
+#include "shader_recompiler/ir_opt/passes.h"
+#include "shader_recompiler/object_pool.h"
+
+namespace {
+using namespace Shader;
+
+IR::U32 ReadCbuf(IR::IREmitter& ir) {
+    return ir.GetCbuf(ir.Imm32(0), ir.Imm32(16));
+}
+
+/// Returns the instruction defining a value after replacements
+IR::Inst* Resolve(const IR::Value& value) {
+    return value.InstRecursive();
+}
+} // Anonymous namespace
+
+TEST_CASE("GlobalValueNumbering: Dominated duplicates are replaced", "[shader]") {
+    // entry -> left -> merge
+    //       -> right -> merge
+    ObjectPool<IR::Inst> inst_pool;
+    IR::Block entry{inst_pool};
+    IR::Block left{inst_pool};
+    IR::Block right{inst_pool};
+    IR::Block merge{inst_pool};
+    entry.AddBranch(&left);
+    entry.AddBranch(&right);
+    left.AddBranch(&merge);
+    right.AddBranch(&merge);
+
+    IR::IREmitter entry_ir{entry};
+    const IR::U32 entry_cbuf{ReadCbuf(entry_ir)};
+    const IR::U32 entry_sum{entry_ir.IAdd(entry_cbuf, entry_ir.Imm32(3))};
+
+    IR::IREmitter left_ir{left};
+    const IR::U32 left_cbuf{ReadCbuf(left_ir)};
+    const IR::U32 left_sum{left_ir.IAdd(left_cbuf, left_ir.Imm32(3))};
+    const IR::U32 left_only{left_ir.IAdd(left_cbuf, left_ir.Imm32(5))};
+
+    IR::IREmitter right_ir{right};
+    const IR::U32 right_only{right_ir.IAdd(ReadCbuf(right_ir), right_ir.Imm32(5))};
+
+    IR::IREmitter merge_ir{merge};
+    const IR::U32 merge_only{merge_ir.IAdd(ReadCbuf(merge_ir), merge_ir.Imm32(5))};
+    const IR::U32 merge_sum{merge_ir.IAdd(ReadCbuf(merge_ir), merge_ir.Imm32(3))};
+
+    IR::Program program;
+    program.blocks = {&entry, &left, &right, &merge};
+    program.post_order_blocks = {&merge, &right, &left, &entry};
+    program.stage = Stage::Fragment;
+    Optimization::GlobalValueNumberingPass(program);
+
+    // Values computed in the entry block are reused everywhere
+    REQUIRE(Resolve(left_cbuf) == Resolve(entry_cbuf));
+    REQUIRE(Resolve(left_sum) == Resolve(entry_sum));
+    REQUIRE(Resolve(merge_sum) == Resolve(entry_sum));
+
+    // Values computed in sibling branches do not dominate each other or the merge block
+    REQUIRE(Resolve(right_only) != Resolve(left_only));
+    REQUIRE(Resolve(merge_only) != Resolve(left_only));
+    REQUIRE(Resolve(merge_only) != Resolve(right_only));
+}
+
+TEST_CASE("GlobalValueNumbering: Side effects are not merged", "[shader]") {
+    ObjectPool<IR::Inst> inst_pool;
+    IR::Block block{inst_pool};
+    IR::IREmitter ir{block};
+    const IR::U32 offset{ir.Imm32(0)};
+    const IR::Value first{ir.LoadShared(32, false, offset)};
+    ir.WriteShared(32, offset, ir.Imm32(1));
+    const IR::Value second{ir.LoadShared(32, false, offset)};
+
+    IR::Program program;
+    program.blocks = {&block};
+    program.post_order_blocks = {&block};
+    program.stage = Stage::Compute;
+    Optimization::GlobalValueNumberingPass(program);
+
+    REQUIRE(Resolve(first) != Resolve(second));
+}
@@ -0,0 +1,140 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "shader_recompiler/frontend/ir/basic_block.h"
+#include "shader_recompiler/frontend/ir/ir_emitter.h"
+#include "shader_recompiler/frontend/ir/program.h"
+#include "shader_recompiler/ir_opt/passes.h"
+#include "shader_recompiler/object_pool.h"
+
+namespace {
+using namespace Shader;
+
+/// Single loop in the layout produced by the structured control flow pass
+struct LoopProgram {
+    explicit LoopProgram(ObjectPool<IR::Inst>& inst_pool)
+        : preheader{inst_pool}, header{inst_pool}, body{inst_pool}, continue_block{inst_pool},
+          merge{inst_pool} {
+        preheader.AddBranch(&header);
+        header.AddBranch(&body);
+        body.AddBranch(&continue_block);
+        continue_block.AddBranch(&header);
+        continue_block.AddBranch(&merge);
+    }
+
+    IR::Program Build(const IR::U1& cond) {
+        using Type = IR::AbstractSyntaxNode::Type;
+        IR::Program program;
+        program.blocks = {&preheader, &header, &body, &continue_block, &merge};
+        program.post_order_blocks = {&merge, &continue_block, &body, &header, &preheader};
+        program.stage = Stage::Compute;
+
+        const auto push_block{[&](IR::Block* block) {
+            auto& node{program.syntax_list.emplace_back()};
+            node.type = Type::Block;
+            node.data.block = block;
+        }};
+        push_block(&preheader);
+        push_block(&header);
+        auto& loop{program.syntax_list.emplace_back()};
+        loop.type = Type::Loop;
+        loop.data.loop.body = &body;
+        loop.data.loop.continue_block = &continue_block;
+        loop.data.loop.merge = &merge;
+        push_block(&body);
+        push_block(&continue_block);
+        auto& repeat{program.syntax_list.emplace_back()};
+        repeat.type = Type::Repeat;
+        repeat.data.repeat.cond = cond;
+        repeat.data.repeat.loop_header = &header;
+        repeat.data.repeat.merge = &merge;
+        push_block(&merge);
+        program.syntax_list.emplace_back().type = Type::Return;
+        return program;
+    }
+
+    IR::Block preheader;
+    IR::Block header;
+    IR::Block body;
+    IR::Block continue_block;
+    IR::Block merge;
+};
+
+bool Contains(IR::Block& block, const IR::Value& value) {
+    const IR::Inst* const inst{value.InstRecursive()};
+    return std::ranges::any_of(block.Instructions(),
+                               [inst](const IR::Inst& other) { return &other == inst; });
+}
+} // Anonymous namespace
+
+TEST_CASE("LoopInvariantCodeMotion: Invariant code is hoisted", "[shader]") {
+    ObjectPool<IR::Inst> inst_pool;
+    LoopProgram loop{inst_pool};
+
+    IR::IREmitter body_ir{loop.body};
+    const IR::U32 cbuf{body_ir.GetCbuf(body_ir.Imm32(0), body_ir.Imm32(16))};
+    const IR::U32 address{body_ir.IAdd(cbuf, body_ir.Imm32(64))};
+    const IR::U32 local_id{body_ir.LocalInvocationIdX()};
+    const IR::U32 shared{body_ir.LoadShared(32, false, local_id)};
+    const IR::U32 varying{body_ir.IAdd(address, shared)};
+    body_ir.WriteShared(32, local_id, varying);
+
+    IR::IREmitter continue_ir{loop.continue_block};
+    const IR::U1 cond{continue_ir.ConditionRef(continue_ir.Imm1(false))};
+    IR::Program program{loop.Build(cond)};
+    Optimization::LoopInvariantCodeMotionPass(program);
+
+    REQUIRE(Contains(loop.preheader, cbuf));
+    REQUIRE(Contains(loop.preheader, address));
+    REQUIRE(Contains(loop.preheader, local_id));
+    REQUIRE(Contains(loop.body, varying));
+}
+
+TEST_CASE("LoopInvariantCodeMotion: Induction variable multiplications are reduced", "[shader]") {
+    ObjectPool<IR::Inst> inst_pool;
+    LoopProgram loop{inst_pool};
+
+    IR::Inst* const phi{&*loop.header.PrependNewInst(loop.header.begin(), IR::Opcode::Phi)};
+    phi->SetFlags(IR::Type::U32);
+    const IR::U32 index{IR::Value{phi}};
+
+    IR::IREmitter body_ir{loop.body};
+    const IR::U32 offset{body_ir.IMul(index, body_ir.Imm32(12))};
+    body_ir.WriteShared(32, offset, body_ir.Imm32(1));
+    const IR::U32 shifted{IR::U32{body_ir.ShiftLeftLogical(index, body_ir.Imm32(2))}};
+    body_ir.WriteShared(32, shifted, body_ir.Imm32(2));
+    const IR::U32 next{body_ir.IAdd(index, body_ir.Imm32(3))};
+
+    IR::IREmitter continue_ir{loop.continue_block};
+    const IR::U1 less{continue_ir.ILessThan(next, continue_ir.Imm32(30), false)};
+    const IR::U1 cond{continue_ir.ConditionRef(less)};
+    phi->AddPhiOperand(&loop.preheader, IR::Value{5U});
+    phi->AddPhiOperand(&loop.continue_block, next);
+
+    IR::Program program{loop.Build(cond)};
+    Optimization::LoopInvariantCodeMotionPass(program);
+
+    // Both multiplications become phis incrementing by the scaled step
+    for (const auto& [value, scale] : {std::pair{offset, 12U}, std::pair{shifted, 4U}}) {
+        IR::Inst* const derived{value.InstRecursive()};
+        REQUIRE(derived->GetOpcode() == IR::Opcode::Phi);
+        REQUIRE(derived->NumArgs() == 2);
+        for (size_t i = 0; i < 2; ++i) {
+            const IR::Value arg{derived->Arg(i).Resolve()};
+            if (derived->PhiBlock(i) == &loop.preheader) {
+                REQUIRE(arg.U32() == 5 * scale);
+                continue;
+            }
+            IR::Inst* const increment{arg.InstRecursive()};
+            REQUIRE(increment->GetOpcode() == IR::Opcode::IAdd32);
+            REQUIRE(increment->Arg(0).InstRecursive() == derived);
+            REQUIRE(increment->Arg(1).U32() == 3 * scale);
+        }
+    }
+}
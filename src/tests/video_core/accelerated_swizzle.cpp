@@ -0,0 +1,157 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "video_core/surface.h"
+#include "video_core/texture_cache/accelerated_swizzle.h"
+#include "video_core/texture_cache/image_info.h"
+#include "video_core/texture_cache/util.h"
+#include "video_core/textures/decoders.h"
+
+namespace {
+using namespace VideoCommon;
+using namespace VideoCommon::Accelerated;
+using VideoCore::Surface::BytesPerBlock;
+using VideoCore::Surface::PixelFormat;
+
+/// Runs the invocations of block_linear_unswizzle_buffer.comp on the CPU
+std::vector<u8> RunUnswizzlePass(std::span<const BlockLinearUnswizzleLevel> levels,
+                                 const BlockLinearUnswizzleParams& params,
+                                 std::span<const u8> swizzled) {
+    const auto gob_offset = [](u32 x, u32 y) {
+        return (x & 15) | ((x & 16) << 1) | ((x & 32) << 3) | ((y & 1) << 4) | ((y & 6) << 5);
+    };
+    const auto swizzled_offset = [&](u32 host_offset) {
+        u32 index = 0;
+        while (index + 1 < params.num_levels && host_offset >= levels[index + 1].host_offset) {
+            ++index;
+        }
+        const BlockLinearUnswizzleLevel& level = levels[index];
+        u32 offset = host_offset - level.host_offset;
+        const u32 layer = offset / level.layer_size;
+        offset -= layer * level.layer_size;
+        const u32 row = offset / level.row_size;
+        const u32 x = offset - row * level.row_size;
+        const u32 z = row / level.height;
+        const u32 y = row - z * level.height;
+        const u32 block_y = y >> 3;
+        u32 result = level.guest_offset + layer * params.layer_stride;
+        result += (z >> level.block_depth) * level.slice_size;
+        result += (z & ((1U << level.block_depth) - 1)) << (9 + level.block_height);
+        result += (block_y >> level.block_height) * level.block_size;
+        result += (block_y & ((1U << level.block_height) - 1)) << 9;
+        result += (x >> 6) << level.x_shift;
+        return result + gob_offset(x, y);
+    };
+    std::vector<u8> linear(params.total_size);
+    const u32 unit_size = 1U << std::max(params.unit_log2, 2U);
+    for (u32 host_offset = 0; host_offset < params.total_size; host_offset += unit_size) {
+        if (params.unit_log2 >= 2) {
+            std::memcpy(&linear[host_offset], &swizzled[swizzled_offset(host_offset)], unit_size);
+            continue;
+        }
+        for (u32 byte = 0; byte < 4 && host_offset + byte < params.total_size; ++byte) {
+            linear[host_offset + byte] = swizzled[swizzled_offset(host_offset + byte)];
+        }
+    }
+    return linear;
+}
+
+/// Unswizzles each level and layer like the CPU upload path
+std::vector<u8> ReferenceUnswizzle(const ImageInfo& info, std::span<const u8> swizzled) {
+    const auto swizzles = FullUploadSwizzles(info);
+    const auto copies = FullUploadCopies(info);
+    const u32 bytes_per_block = BytesPerBlock(info.format);
+    const BufferImageCopy& last = copies.back();
+    std::vector<u8> linear(last.buffer_offset + last.buffer_size);
+    for (const SwizzleParameters& swizzle : swizzles) {
+        const BufferImageCopy& copy = copies[swizzle.level];
+        const Extent3D num_tiles = swizzle.num_tiles;
+        const size_t layer_size = copy.buffer_size / info.resources.layers;
+        for (s32 layer = 0; layer < info.resources.layers; ++layer) {
+            Tegra::Texture::UnswizzleTexture(
+                std::span(linear).subspan(copy.buffer_offset + layer * layer_size),
+                swizzled.subspan(swizzle.buffer_offset + layer * info.layer_stride),
+                bytes_per_block, num_tiles.width, num_tiles.height, num_tiles.depth,
+                swizzle.block.height, swizzle.block.depth,
+                CalculateLevelStrideAlignment(info, swizzle.level));
+        }
+    }
+    return linear;
+}
+
+ImageInfo MakeInfo(PixelFormat format, ImageType type, Extent3D size, s32 levels, s32 layers,
+                   Extent3D block) {
+    ImageInfo info;
+    info.format = format;
+    info.type = type;
+    info.size = size;
+    info.resources.levels = levels;
+    info.resources.layers = layers;
+    info.block = block;
+    info.layer_stride = CalculateLayerStride(info);
+    return info;
+}
+
+struct UnswizzlePass {
+    boost::container::small_vector<BlockLinearUnswizzleLevel, 16> levels;
+    BlockLinearUnswizzleParams params;
+};
+
+UnswizzlePass MakePass(const ImageInfo& info) {
+    const auto swizzles = FullUploadSwizzles(info);
+    auto levels = MakeBlockLinearUnswizzleLevels(swizzles, info);
+    const auto params = MakeBlockLinearUnswizzleParams(levels, info);
+    return {std::move(levels), params};
+}
+
+void CheckUnswizzle(const ImageInfo& info) {
+    std::mt19937 rng{1234};
+    std::vector<u8> swizzled(CalculateGuestSizeInBytes(info));
+    for (u8& byte : swizzled) {
+        byte = static_cast<u8>(rng());
+    }
+    const UnswizzlePass pass = MakePass(info);
+    REQUIRE(pass.params.num_levels == static_cast<u32>(info.resources.levels));
+    REQUIRE(RunUnswizzlePass(pass.levels, pass.params, swizzled) ==
+            ReferenceUnswizzle(info, swizzled));
+}
+} // Anonymous namespace
+
+TEST_CASE("AcceleratedSwizzle: Mip chains of arrays copy whole rows", "[video_core]") {
+    const ImageInfo info =
+        MakeInfo(PixelFormat::A8B8G8R8_UNORM, ImageType::e2D, {256, 128, 1}, 8, 3, {0, 4, 0});
+    CheckUnswizzle(info);
+    // The smallest level is 2 texels wide, rows of 8 bytes
+    REQUIRE(MakePass(info).params.unit_log2 == 3);
+}
+
+TEST_CASE("AcceleratedSwizzle: Wide blocks copy whole sectors", "[video_core]") {
+    const ImageInfo info =
+        MakeInfo(PixelFormat::R32G32B32A32_FLOAT, ImageType::e2D, {64, 48, 1}, 1, 2, {0, 3, 0});
+    CheckUnswizzle(info);
+    REQUIRE(MakePass(info).params.unit_log2 == 4);
+}
+
+TEST_CASE("AcceleratedSwizzle: Unaligned rows gather bytes", "[video_core]") {
+    const ImageInfo info =
+        MakeInfo(PixelFormat::R8_UNORM, ImageType::e2D, {301, 77, 1}, 9, 2, {0, 4, 0});
+    CheckUnswizzle(info);
+    REQUIRE(MakePass(info).params.unit_log2 == 0);
+}
+
+TEST_CASE("AcceleratedSwizzle: Volumes and compressed formats", "[video_core]") {
+    CheckUnswizzle(
+        MakeInfo(PixelFormat::R16G16B16A16_FLOAT, ImageType::e3D, {64, 32, 16}, 5, 1, {0, 2, 2}));
+    CheckUnswizzle(MakeInfo(PixelFormat::BC1_RGBA_UNORM, ImageType::e2D, {512, 256, 1}, 10, 6,
+                            {0, 4, 0}));
+}
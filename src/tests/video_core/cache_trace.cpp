@@ -0,0 +1,52 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <filesystem>
+#include <fstream>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "video_core/cache_trace.h"
+
+using namespace VideoCommon;
+
+TEST_CASE("CacheTrace[RoundTrip]", "[video_core]") {
+    const auto filename{std::filesystem::temp_directory_path() / "yuzu_cache_trace_test.bin"};
+    // Enough records for the recorder to flush some of them before it is destroyed
+    constexpr u32 num_records = 10000;
+    {
+        CacheTraceRecorder recorder{filename};
+        for (u32 i = 0; i < num_records; ++i) {
+            recorder.Record(i % 2 == 0 ? CacheTraceOp::TextureWriteMemory
+                                       : CacheTraceOp::BufferBindHostStageBuffers,
+                            u64{i} << 12, 0x1000, i % 5);
+        }
+    }
+    const auto records{LoadCacheTrace(filename)};
+    REQUIRE(records.has_value());
+    REQUIRE(records->size() == num_records);
+    for (u32 i = 0; i < num_records; ++i) {
+        const CacheTraceRecord& record{(*records)[i]};
+        REQUIRE(record.op == (i % 2 == 0 ? CacheTraceOp::TextureWriteMemory
+                                         : CacheTraceOp::BufferBindHostStageBuffers));
+        REQUIRE(record.addr == u64{i} << 12);
+        REQUIRE(record.size == 0x1000);
+        REQUIRE(record.arg == i % 5);
+        if (i > 0) {
+            REQUIRE(record.timestamp_ns >= (*records)[i - 1].timestamp_ns);
+        }
+    }
+
+    // Traces cut short keep their complete records
+    {
+        std::ofstream file{filename, std::ios::binary | std::ios::app};
+        file.write("partial", 7);
+    }
+    const auto truncated{LoadCacheTrace(filename)};
+    REQUIRE(truncated.has_value());
+    REQUIRE(truncated->size() == num_records);
+
+    std::filesystem::remove(filename);
+    REQUIRE(!LoadCacheTrace(filename).has_value());
+}
@@ -0,0 +1,263 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "core/core.h"
+#include "video_core/engines/maxwell_3d.h"
+#include "video_core/host1x/host1x.h"
+#include "video_core/macro/macro.h"
+#include "video_core/macro/macro_interpreter.h"
+#include "video_core/memory_manager.h"
+
+namespace {
+using namespace Tegra::Macro;
+using Tegra::Engines::Maxwell3D;
+
+/// Sends land in the shadow scratch registers, which have no side effects
+constexpr u32 SCRATCH_METHOD = 0xD00;
+constexpr u32 SCRATCH_WITH_INCREMENT = SCRATCH_METHOD | (1U << 12);
+
+/// Register reserved for shift amounts, so shifts stay in range in the interpreter
+constexpr u32 SHIFT_REGISTER = 7;
+
+u32 AddImmediate(ResultOperation result, u32 dst, u32 src_a, s32 immediate) {
+    Opcode op{};
+    op.operation.Assign(Operation::AddImmediate);
+    op.result_operation.Assign(result);
+    op.dst.Assign(dst);
+    op.src_a.Assign(src_a);
+    op.immediate.Assign(immediate);
+    return op.raw;
+}
+
+u32 Alu(ALUOperation operation, ResultOperation result, u32 dst, u32 src_a, u32 src_b) {
+    Opcode op{};
+    op.operation.Assign(Operation::ALU);
+    op.alu_operation.Assign(operation);
+    op.result_operation.Assign(result);
+    op.dst.Assign(dst);
+    op.src_a.Assign(src_a);
+    op.src_b.Assign(src_b);
+    return op.raw;
+}
+
+u32 Bitfield(Operation operation, u32 dst, u32 src_a, u32 src_b, u32 src_bit, u32 size,
+             u32 dst_bit) {
+    Opcode op{};
+    op.operation.Assign(operation);
+    op.result_operation.Assign(ResultOperation::Move);
+    op.dst.Assign(dst);
+    op.src_a.Assign(src_a);
+    op.src_b.Assign(src_b);
+    op.bf_src_bit.Assign(src_bit);
+    op.bf_size.Assign(size);
+    op.bf_dst_bit.Assign(dst_bit);
+    return op.raw;
+}
+
+u32 Read(u32 dst, s32 method) {
+    Opcode op{};
+    op.operation.Assign(Operation::Read);
+    op.result_operation.Assign(ResultOperation::Move);
+    op.dst.Assign(dst);
+    op.immediate.Assign(method);
+    return op.raw;
+}
+
+u32 Branch(BranchCondition condition, bool annul, u32 src_a, s32 offset) {
+    Opcode op{};
+    op.operation.Assign(Operation::Branch);
+    op.branch_condition.Assign(condition);
+    op.branch_annul.Assign(annul ? 1 : 0);
+    op.src_a.Assign(src_a);
+    op.immediate.Assign(offset);
+    return op.raw;
+}
+
+u32 Exit(u32 raw) {
+    Opcode op{raw};
+    op.is_exit.Assign(1);
+    return op.raw;
+}
+
+constexpr u32 NOP = 0x00000011; // AddImmediate $r0 = $r0 + 0
+
+/// Appends the sends of every general purpose register followed by the exit sequence
+void AppendEpilogue(std::vector<u32>& code) {
+    for (u32 reg = 1; reg < NUM_MACRO_REGISTERS; ++reg) {
+        code.push_back(AddImmediate(ResultOperation::MoveAndSend, 0, reg, 0));
+    }
+    code.push_back(Exit(NOP));
+    code.push_back(NOP);
+}
+
+/// Generates straight line code exercising every operation; returns the number of fetches
+u32 MakeRandomProgram(std::mt19937& rng, std::vector<u32>& code) {
+    const auto random = [&rng](u32 min, u32 max) {
+        return std::uniform_int_distribution<u32>{min, max}(rng);
+    };
+    u32 num_fetches = 0;
+    code.push_back(AddImmediate(ResultOperation::MoveAndSetMethod, 0, 0, SCRATCH_WITH_INCREMENT));
+    code.push_back(AddImmediate(ResultOperation::Move, SHIFT_REGISTER, 0, 3));
+
+    // Carry consumers only follow producers of the same kind, subtraction borrows are stored
+    // inverted by some backends and only guaranteed to chain into another subtraction.
+    enum class CarryKind { None, Add, Subtract };
+    CarryKind carry = CarryKind::None;
+
+    static constexpr std::array alu_operations{
+        ALUOperation::Add, ALUOperation::AddWithCarry, ALUOperation::Subtract,
+        ALUOperation::SubtractWithBorrow, ALUOperation::Xor, ALUOperation::Or,
+        ALUOperation::And, ALUOperation::AndNot, ALUOperation::Nand,
+    };
+    for (u32 i = 0; i < 64; ++i) {
+        const u32 dst = random(1, SHIFT_REGISTER - 1);
+        switch (random(0, 7)) {
+        case 0:
+        case 1: {
+            const u32 num_operations = static_cast<u32>(alu_operations.size());
+            ALUOperation operation = alu_operations[random(0, num_operations - 1)];
+            if (operation == ALUOperation::AddWithCarry && carry != CarryKind::Add) {
+                operation = ALUOperation::Add;
+            }
+            if (operation == ALUOperation::SubtractWithBorrow && carry != CarryKind::Subtract) {
+                operation = ALUOperation::Subtract;
+            }
+            if (operation == ALUOperation::Add || operation == ALUOperation::AddWithCarry) {
+                carry = CarryKind::Add;
+            } else if (operation == ALUOperation::Subtract ||
+                       operation == ALUOperation::SubtractWithBorrow) {
+                carry = CarryKind::Subtract;
+            }
+            code.push_back(Alu(operation, ResultOperation::Move, dst, random(1, 7), random(1, 7)));
+            break;
+        }
+        case 2: {
+            const s32 immediate = static_cast<s32>(random(0, (1U << 18) - 1)) - (1 << 17);
+            code.push_back(AddImmediate(ResultOperation::Move, dst, random(0, 7), immediate));
+            break;
+        }
+        case 3:
+            code.push_back(Bitfield(Operation::ExtractInsert, dst, random(0, 7), random(0, 7),
+                                    random(0, 31), random(0, 31), random(0, 31)));
+            break;
+        case 4:
+            code.push_back(Bitfield(Operation::ExtractShiftLeftImmediate, dst, SHIFT_REGISTER,
+                                    random(0, 7), 0, random(0, 31), random(0, 31)));
+            break;
+        case 5:
+            code.push_back(Bitfield(Operation::ExtractShiftLeftRegister, dst, SHIFT_REGISTER,
+                                    random(0, 7), random(0, 31), random(0, 31), 0));
+            break;
+        case 6:
+            code.push_back(AddImmediate(ResultOperation::IgnoreAndFetch, dst, 0, 0));
+            ++num_fetches;
+            break;
+        case 7:
+            code.push_back(AddImmediate(ResultOperation::MoveAndSend, 0, dst, 0));
+            code.push_back(Read(dst, static_cast<s32>(SCRATCH_METHOD + random(0, 16))));
+            code.push_back(AddImmediate(ResultOperation::Move, SHIFT_REGISTER, 0,
+                                        static_cast<s32>(random(0, 31))));
+            break;
+        }
+    }
+    AppendEpilogue(code);
+    return num_fetches;
+}
+
+class MacroTester {
+public:
+    MacroTester() {
+        system.Initialize();
+        host1x = std::make_unique<Tegra::Host1x::Host1x>(system);
+        memory_manager = std::make_unique<Tegra::MemoryManager>(system, host1x->MemoryManager());
+        maxwell3d = std::make_unique<Maxwell3D>(system, *memory_manager);
+    }
+
+    /// Runs the code in the interpreter and in the host JIT, requiring the same engine writes
+    void Run(const std::vector<u32>& code, const std::vector<u32>& parameters) {
+        Tegra::MacroInterpreter interpreter{*maxwell3d};
+        const std::unique_ptr<Tegra::MacroEngine> jit = Tegra::GetMacroEngine(*maxwell3d);
+        REQUIRE(RunEngine(interpreter, code, parameters) == RunEngine(*jit, code, parameters));
+    }
+
+private:
+    std::vector<u32> RunEngine(Tegra::MacroEngine& engine, const std::vector<u32>& code,
+                               const std::vector<u32>& parameters) {
+        auto& scratch = maxwell3d->regs.shadow_scratch;
+        std::ranges::fill(scratch, 0);
+        for (const u32 word : code) {
+            engine.AddCode(0, word);
+        }
+        engine.Execute(0, parameters);
+        return std::vector<u32>(scratch.begin(), scratch.end());
+    }
+
+    Core::System system;
+    std::unique_ptr<Tegra::Host1x::Host1x> host1x;
+    std::unique_ptr<Tegra::MemoryManager> memory_manager;
+    std::unique_ptr<Maxwell3D> maxwell3d;
+};
+} // Anonymous namespace
+
+TEST_CASE("MacroJIT: Random programs", "[video_core]") {
+    MacroTester tester;
+    std::mt19937 rng{0x6d616372};
+    for (int program = 0; program < 200; ++program) {
+        std::vector<u32> code;
+        const u32 num_fetches = MakeRandomProgram(rng, code);
+        std::vector<u32> parameters(num_fetches + 1);
+        std::ranges::generate(parameters, [&rng] { return static_cast<u32>(rng()); });
+        tester.Run(code, parameters);
+    }
+}
+
+TEST_CASE("MacroJIT: Delay slot loop", "[video_core]") {
+    // Sends every parameter after the first, which holds the count. The send is in the delay slot
+    // of the loop branch, like macros found in games.
+    const std::vector<u32> code{
+        AddImmediate(ResultOperation::MoveAndSetMethod, 0, 0, SCRATCH_WITH_INCREMENT),
+        AddImmediate(ResultOperation::IgnoreAndFetch, 2, 0, 0),
+        AddImmediate(ResultOperation::Move, 1, 1, -1),
+        Branch(BranchCondition::NotZero, false, 1, -2),
+        AddImmediate(ResultOperation::MoveAndSend, 0, 2, 0),
+        Exit(NOP),
+        NOP,
+    };
+    MacroTester tester;
+    for (const u32 count : {1U, 2U, 17U, 100U}) {
+        std::vector<u32> parameters{count};
+        for (u32 i = 0; i < count; ++i) {
+            parameters.push_back(i * 0x01010101U + 7);
+        }
+        tester.Run(code, parameters);
+    }
+}
+
+TEST_CASE("MacroJIT: Annulled branches and carry", "[video_core]") {
+    // Parameters: a, b. Sends a + b as a 64-bit value and skips a send when the low word is zero.
+    const std::vector<u32> code{
+        AddImmediate(ResultOperation::MoveAndSetMethod, 0, 0, SCRATCH_WITH_INCREMENT),
+        AddImmediate(ResultOperation::IgnoreAndFetch, 2, 0, 0),
+        Alu(ALUOperation::Add, ResultOperation::MoveAndSend, 3, 1, 2),
+        Alu(ALUOperation::AddWithCarry, ResultOperation::MoveAndSend, 4, 0, 0),
+        Branch(BranchCondition::Zero, true, 3, 3),
+        Alu(ALUOperation::Subtract, ResultOperation::MoveAndSend, 5, 1, 2),
+        Alu(ALUOperation::SubtractWithBorrow, ResultOperation::MoveAndSend, 6, 1, 2),
+        Exit(AddImmediate(ResultOperation::MoveAndSend, 0, 1, 0)),
+        AddImmediate(ResultOperation::MoveAndSend, 0, 2, 0),
+    };
+    MacroTester tester;
+    for (const auto& parameters : std::vector<std::vector<u32>>{
+             {0xffffffffU, 1}, {1, 0xffffffffU}, {0x80000000U, 0x80000000U}, {5, 7}, {7, 5}}) {
+        tester.Run(code, parameters);
+    }
+}
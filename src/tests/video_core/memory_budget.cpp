@@ -0,0 +1,76 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <optional>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "common/literals.h"
+#include "video_core/memory_budget.h"
+
+using namespace Common::Literals;
+using namespace VideoCommon;
+
+TEST_CASE("MemoryBudget: Shares follow weights", "[video_core]") {
+    MemoryBudget budget{10_GiB};
+    budget.Tick();
+    // A tenth of the budget is kept as headroom
+    const u64 pool = 9_GiB;
+    const u64 texture = budget.GetShare(MemoryBudgetClient::TextureCache).critical;
+    const u64 buffer = budget.GetShare(MemoryBudgetClient::BufferCache).critical;
+    const u64 staging = budget.GetShare(MemoryBudgetClient::StagingPool).critical;
+    REQUIRE(texture == pool * 6 / 10);
+    REQUIRE(buffer == pool * 3 / 10);
+    REQUIRE(staging == pool / 10);
+
+    const MemoryBudgetShare& share = budget.GetShare(MemoryBudgetClient::TextureCache);
+    REQUIRE(share.minimum < share.expected);
+    REQUIRE(share.expected < share.critical);
+}
+
+TEST_CASE("MemoryBudget: Unused shares are lent", "[video_core]") {
+    MemoryBudget budget{10_GiB};
+    budget.ReportUsage(MemoryBudgetClient::TextureCache, 7_GiB);
+    budget.ReportUsage(MemoryBudgetClient::BufferCache, 128_MiB);
+    budget.Tick();
+    const u64 texture = budget.GetShare(MemoryBudgetClient::TextureCache).critical;
+    const u64 buffer = budget.GetShare(MemoryBudgetClient::BufferCache).critical;
+    const u64 staging = budget.GetShare(MemoryBudgetClient::StagingPool).critical;
+    REQUIRE(texture > 9_GiB * 6 / 10);
+    REQUIRE(buffer > 128_MiB);
+    REQUIRE(buffer < 9_GiB * 3 / 10);
+    REQUIRE(staging < 9_GiB / 10);
+    REQUIRE(texture + buffer + staging <= 9_GiB);
+}
+
+TEST_CASE("MemoryBudget: Untracked usage shrinks shares", "[video_core]") {
+    std::optional<MemoryBudget::HeapStatus> status{MemoryBudget::HeapStatus{
+        .budget = 10_GiB,
+        .usage = 0,
+    }};
+    MemoryBudget budget{10_GiB, [&status] { return status; }};
+    budget.ReportUsage(MemoryBudgetClient::TextureCache, 4_GiB);
+    budget.Tick();
+    const u64 initial = budget.GetShare(MemoryBudgetClient::TextureCache).critical;
+
+    // Another 6 GiB is used outside of the caches, going over the budget. The driver reports it on
+    // the next poll, and the caches have to evict.
+    status->usage = 10_GiB;
+    for (int frame = 0; frame < 16; ++frame) {
+        budget.Tick();
+    }
+    const u64 texture = budget.GetShare(MemoryBudgetClient::TextureCache).critical;
+    const u64 buffer = budget.GetShare(MemoryBudgetClient::BufferCache).critical;
+    const u64 staging = budget.GetShare(MemoryBudgetClient::StagingPool).critical;
+    REQUIRE(texture < initial);
+    REQUIRE(texture < 4_GiB);
+    REQUIRE(texture + buffer + staging <= 9_GiB - 6_GiB);
+
+    // Shares aren't lost when the driver stops reporting
+    status.reset();
+    for (int frame = 0; frame < 16; ++frame) {
+        budget.Tick();
+    }
+    REQUIRE(budget.GetShare(MemoryBudgetClient::TextureCache).critical == texture);
+}
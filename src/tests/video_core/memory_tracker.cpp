@@ -4,7 +4,9 @@
 #include <memory>
 #include <stdexcept>
 #include <unordered_map>
+#include <vector>
 
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 
 #include "common/alignment.h"
@@ -546,3 +548,56 @@ TEST_CASE("MemoryTracker: Cached write downloads") {
     memory_track->MarkRegionAsCpuModified(c, WORD);
     REQUIRE(rasterizer.Count() == 0);
 }
+
+TEST_CASE("MemoryTracker: Sparse pages in large span", "[video_core]") {
+    RasterizerInterface rasterizer;
+    std::unique_ptr<MemoryTracker> memory_track(std::make_unique<MemoryTracker>(rasterizer));
+    memory_track->UnmarkRegionAsCpuModified(c, HIGH_PAGE_SIZE * 4);
+    memory_track->MarkRegionAsCpuModified(c + WORD * 3 + PAGE * 5, PAGE);
+    memory_track->MarkRegionAsCpuModified(c + WORD * 27, PAGE * 64);
+    memory_track->MarkRegionAsCpuModified(c + WORD * 28, PAGE);
+    memory_track->MarkRegionAsCpuModified(c + HIGH_PAGE_SIZE * 3 + WORD * 15 + PAGE * 63, PAGE);
+    REQUIRE(!memory_track->IsRegionCpuModified(c + WORD * 4, WORD * 23));
+    REQUIRE(memory_track->IsRegionCpuModified(c + WORD * 4, WORD * 24));
+
+    std::vector<Range> ranges;
+    memory_track->ForEachUploadRange(c, HIGH_PAGE_SIZE * 4, [&](u64 offset, u64 size) {
+        ranges.emplace_back(offset, offset + size);
+    });
+    REQUIRE(ranges == std::vector<Range>{
+                          {c + WORD * 3 + PAGE * 5, c + WORD * 3 + PAGE * 6},
+                          {c + WORD * 27, c + WORD * 28 + PAGE},
+                          {c + HIGH_PAGE_SIZE * 4 - PAGE, c + HIGH_PAGE_SIZE * 4},
+                      });
+    REQUIRE(!memory_track->IsRegionCpuModified(c, HIGH_PAGE_SIZE * 4));
+    REQUIRE(rasterizer.Count() == HIGH_PAGE_SIZE * 4 / PAGE);
+}
+
+TEST_CASE("MemoryTracker: Benchmark", "[video_core][.benchmark]") {
+    static constexpr u64 span = HIGH_PAGE_SIZE * 64;
+    RasterizerInterface rasterizer;
+    std::unique_ptr<MemoryTracker> memory_track(std::make_unique<MemoryTracker>(rasterizer));
+    memory_track->UnmarkRegionAsCpuModified(c, span);
+    for (u64 offset = 0; offset < span; offset += HIGH_PAGE_SIZE / 2) {
+        memory_track->MarkRegionAsGpuModified(c + offset + PAGE * 3, PAGE);
+    }
+    BENCHMARK("IsRegionCpuModified clean span") {
+        return memory_track->IsRegionCpuModified(c, span);
+    };
+    BENCHMARK("ModifiedGpuRegion sparse span") {
+        return memory_track->ModifiedGpuRegion(c, span);
+    };
+    BENCHMARK("ForEachUploadRange clean span") {
+        u64 total = 0;
+        memory_track->ForEachUploadRange(c, span, [&](u64, u64 size) { total += size; });
+        return total;
+    };
+    BENCHMARK("ForEachUploadRange fragmented span") {
+        for (u64 offset = 0; offset < span; offset += PAGE * 2) {
+            memory_track->MarkRegionAsCpuModified(c + offset, PAGE);
+        }
+        u64 total = 0;
+        memory_track->ForEachUploadRange(c, span, [&](u64, u64 size) { total += size; });
+        return total;
+    };
+}
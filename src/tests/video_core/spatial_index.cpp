@@ -0,0 +1,166 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "common/hash.h"
+#include "video_core/texture_cache/spatial_index.h"
+
+namespace {
+using VideoCommon::SpatialIndex;
+
+struct Range {
+    u64 addr;
+    u64 size;
+
+    bool Overlaps(u64 other_addr, u64 other_size) const {
+        return addr < other_addr + other_size && other_addr < addr + size;
+    }
+};
+
+/// Reference index, as the texture cache kept its images in 1 MiB pages
+class PageTable {
+public:
+    static constexpr u64 PAGE_BITS = 20;
+
+    void Insert(const Range& range, u32 id) {
+        for (u64 page = range.addr >> PAGE_BITS; page <= Last(range) >> PAGE_BITS; ++page) {
+            pages[page].push_back(id);
+        }
+    }
+
+    template <typename Func>
+    void ForEach(u64 addr, u64 size, Func&& func) const {
+        for (u64 page = addr >> PAGE_BITS; page <= (addr + size - 1) >> PAGE_BITS; ++page) {
+            const auto it = pages.find(page);
+            if (it == pages.end()) {
+                continue;
+            }
+            for (const u32 id : it->second) {
+                func(id);
+            }
+        }
+    }
+
+private:
+    static u64 Last(const Range& range) {
+        return range.addr + range.size - 1;
+    }
+
+    std::unordered_map<u64, std::vector<u32>, Common::IdentityHash<u64>> pages;
+};
+
+/// Atlas-like layout, a few render targets and hundreds of small textures packed in some pages
+std::vector<Range> RandomRanges(std::mt19937& engine, size_t count) {
+    std::uniform_int_distribution<u64> small_size{256, 64 * 1024};
+    std::uniform_int_distribution<u64> large_size{1 << 20, 16 << 20};
+    std::uniform_int_distribution<u32> kind{0, 63};
+    std::uniform_int_distribution<u64> address{0, 1ULL << 30};
+    std::uniform_int_distribution<u64> atlas_page{0, 31};
+    std::uniform_int_distribution<u64> atlas_offset{0, (1 << 20) - 1};
+    std::vector<Range> ranges;
+    for (size_t i = 0; i < count; ++i) {
+        if (kind(engine) == 0) {
+            ranges.push_back({address(engine), large_size(engine)});
+        } else {
+            const u64 atlas_addr = (512ULL << 20) + (atlas_page(engine) << 20);
+            ranges.push_back({atlas_addr + atlas_offset(engine), small_size(engine)});
+        }
+    }
+    return ranges;
+}
+
+std::vector<u32> Overlapping(const SpatialIndex<u32>& index, const std::vector<Range>& ranges,
+                             u64 addr, u64 size) {
+    std::vector<u32> ids;
+    index.ForEach(addr, size, [&](u32 id) {
+        REQUIRE(ranges[id].Overlaps(addr, size));
+        ids.push_back(id);
+    });
+    // Ranges must be reported once, even when they span multiple buckets
+    std::ranges::sort(ids);
+    return ids;
+}
+
+std::vector<u32> BruteForce(const std::vector<Range>& ranges, const std::vector<bool>& alive,
+                            u64 addr, u64 size) {
+    std::vector<u32> ids;
+    for (u32 id = 0; id < ranges.size(); ++id) {
+        if (alive[id] && ranges[id].Overlaps(addr, size)) {
+            ids.push_back(id);
+        }
+    }
+    return ids;
+}
+} // Anonymous namespace
+
+TEST_CASE("SpatialIndex[MatchesBruteForce]", "[video_core]") {
+    std::mt19937 engine{0x5eed};
+    const std::vector<Range> ranges = RandomRanges(engine, 4096);
+    std::vector<bool> alive(ranges.size(), true);
+    SpatialIndex<u32> index;
+    for (u32 id = 0; id < ranges.size(); ++id) {
+        index.Insert(ranges[id].addr, ranges[id].size, id);
+    }
+    // Remove every third range, leaving holes in the buckets
+    for (u32 id = 0; id < ranges.size(); id += 3) {
+        REQUIRE(index.Erase(ranges[id].addr, ranges[id].size, id));
+        alive[id] = false;
+    }
+    REQUIRE(!index.Erase(ranges[0].addr, ranges[0].size, 0));
+
+    std::uniform_int_distribution<u64> address{0, 1100ULL << 20};
+    std::uniform_int_distribution<u64> size_bits{0, 28};
+    for (int query = 0; query < 2000; ++query) {
+        const u64 addr = address(engine);
+        std::uniform_int_distribution<u64> size_distribution{1, u64{1} << size_bits(engine)};
+        const u64 size = size_distribution(engine);
+        INFO("Query 0x" << std::hex << addr << " size 0x" << size);
+        REQUIRE(Overlapping(index, ranges, addr, size) == BruteForce(ranges, alive, addr, size));
+    }
+}
+
+TEST_CASE("SpatialIndex[StopsWhenRequested]", "[video_core]") {
+    SpatialIndex<u32> index;
+    for (u32 id = 0; id < 16; ++id) {
+        index.Insert(id * 4096, 4096, id);
+    }
+    u32 visited = 0;
+    index.ForEach(0, 16 * 4096, [&](u32) { return ++visited == 4; });
+    REQUIRE(visited == 4);
+}
+
+TEST_CASE("SpatialIndex[Benchmark]", "[video_core][.benchmark]") {
+    std::mt19937 engine{0x5eed};
+    const std::vector<Range> ranges = RandomRanges(engine, 16384);
+    SpatialIndex<u32> index;
+    PageTable page_table;
+    for (u32 id = 0; id < ranges.size(); ++id) {
+        index.Insert(ranges[id].addr, ranges[id].size, id);
+        page_table.Insert(ranges[id], id);
+    }
+    // Lookups of texture sized regions, as FindImage and JoinImages do
+    std::vector<Range> queries = RandomRanges(engine, 1024);
+    const auto count = [&](auto& table) {
+        size_t hits = 0;
+        for (const Range& query : queries) {
+            table.ForEach(query.addr, query.size, [&](u32 id) {
+                hits += ranges[id].Overlaps(query.addr, query.size) ? 1 : 0;
+            });
+        }
+        return hits;
+    };
+    BENCHMARK("PageTable") {
+        return count(page_table);
+    };
+    BENCHMARK("SpatialIndex") {
+        return count(index);
+    };
+}
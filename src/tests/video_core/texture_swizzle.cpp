@@ -0,0 +1,175 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <cstring>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/alignment.h"
+#include "common/common_types.h"
+#include "common/div_ceil.h"
+#include "video_core/textures/decoders.h"
+
+namespace {
+using namespace Tegra::Texture;
+
+constexpr SwizzleTable SWIZZLE_TABLE = MakeSwizzleTable();
+
+/// Scalar reference unswizzle, one pixel at a time through the GOB swizzle table
+void ReferenceUnswizzle(std::span<u8> output, std::span<const u8> input, u32 bytes_per_pixel,
+                        u32 width, u32 height, u32 depth, u32 block_height, u32 block_depth) {
+    const u32 stride = width * bytes_per_pixel;
+    const u32 gobs_in_x = Common::DivCeilLog2(stride, GOB_SIZE_X_SHIFT);
+    const u32 block_size = gobs_in_x << (GOB_SIZE_SHIFT + block_height + block_depth);
+    const u32 slice_size =
+        Common::DivCeilLog2(height, block_height + GOB_SIZE_Y_SHIFT) * block_size;
+    const u32 block_height_mask = (1U << block_height) - 1;
+    const u32 block_depth_mask = (1U << block_depth) - 1;
+    const u32 x_shift = GOB_SIZE_SHIFT + block_height + block_depth;
+
+    for (u32 z = 0; z < depth; ++z) {
+        const u32 offset_z = (z >> block_depth) * slice_size +
+                             ((z & block_depth_mask) << (GOB_SIZE_SHIFT + block_height));
+        for (u32 y = 0; y < height; ++y) {
+            const u32 block_y = y >> GOB_SIZE_Y_SHIFT;
+            const u32 offset_y = (block_y >> block_height) * block_size +
+                                 ((block_y & block_height_mask) << GOB_SIZE_SHIFT);
+            for (u32 x = 0; x < stride; x += bytes_per_pixel) {
+                const u32 offset_x = (x >> GOB_SIZE_X_SHIFT) << x_shift;
+                const u32 swizzled = offset_z + offset_y + offset_x +
+                                     SWIZZLE_TABLE[y % GOB_SIZE_Y][x % GOB_SIZE_X];
+                const u32 linear = (z * height + y) * stride + x;
+                std::memcpy(&output[linear], &input[swizzled], bytes_per_pixel);
+            }
+        }
+    }
+}
+
+std::vector<u8> RandomBytes(size_t size) {
+    std::mt19937 rng{1234};
+    std::vector<u8> bytes(size);
+    for (u8& byte : bytes) {
+        byte = static_cast<u8>(rng());
+    }
+    return bytes;
+}
+} // Anonymous namespace
+
+TEST_CASE("Swizzle[UnswizzleMatchesReference]", "[video_core]") {
+    static constexpr std::array<u32, 5> bytes_per_pixels{1, 2, 4, 8, 16};
+    static constexpr std::array<u32, 4> widths{1, 13, 64, 213};
+    for (const u32 bytes_per_pixel : bytes_per_pixels) {
+        for (const u32 width : widths) {
+            static constexpr u32 height = 37;
+            static constexpr u32 depth = 2;
+            static constexpr u32 block_height = 2;
+            static constexpr u32 block_depth = 1;
+            const size_t size =
+                CalculateSize(true, bytes_per_pixel, width, height, depth, block_height,
+                              block_depth);
+            const std::vector<u8> swizzled = RandomBytes(size);
+            std::vector<u8> expected(size);
+            std::vector<u8> result(size);
+            ReferenceUnswizzle(expected, swizzled, bytes_per_pixel, width, height, depth,
+                               block_height, block_depth);
+            UnswizzleTexture(result, swizzled, bytes_per_pixel, width, height, depth, block_height,
+                             block_depth);
+            REQUIRE(result == expected);
+        }
+    }
+}
+
+TEST_CASE("Swizzle[SubrectRoundTrip]", "[video_core]") {
+    static constexpr u32 bytes_per_pixel = 4;
+    static constexpr u32 width = 200;
+    static constexpr u32 height = 64;
+    static constexpr u32 block_height = 3;
+    static constexpr u32 pitch = width * bytes_per_pixel;
+    const size_t size = CalculateSize(true, bytes_per_pixel, width, height, 1, block_height, 0);
+    const std::vector<u8> linear = RandomBytes(size);
+
+    std::vector<u8> swizzled(size);
+    std::vector<u8> full(size);
+    SwizzleTexture(swizzled, linear, bytes_per_pixel, width, height, 1, block_height, 0);
+    UnswizzleTexture(full, swizzled, bytes_per_pixel, width, height, 1, block_height, 0);
+    REQUIRE(std::memcmp(full.data(), linear.data(), pitch * height) == 0);
+
+    // Unaligned origins take the per pixel path before and after the GOB row copies
+    static constexpr u32 origin_x = 5;
+    static constexpr u32 origin_y = 3;
+    static constexpr u32 extent_x = 150;
+    static constexpr u32 extent_y = 40;
+    std::vector<u8> subrect(size);
+    UnswizzleSubrect(subrect, swizzled, bytes_per_pixel, width, height, 1, origin_x, origin_y,
+                     extent_x, extent_y, block_height, 0, pitch);
+    for (u32 y = 0; y < extent_y; ++y) {
+        const u8* const expected = &linear[(origin_y + y) * pitch + origin_x * bytes_per_pixel];
+        REQUIRE(std::memcmp(&subrect[y * pitch], expected, extent_x * bytes_per_pixel) == 0);
+    }
+}
+
+TEST_CASE("Swizzle[SubrectBlockRowRange]", "[video_core]") {
+    static constexpr u32 bytes_per_pixel = 4;
+    static constexpr u32 width = 100;
+    static constexpr u32 height = 150;
+    static constexpr u32 depth = 2;
+    static constexpr u32 block_height = 2;
+    static constexpr u32 block_depth = 1;
+    static constexpr u32 origin_x = 3;
+    static constexpr u32 extent_x = 90;
+    static constexpr u32 pitch = extent_x * bytes_per_pixel;
+    const size_t size =
+        CalculateSize(true, bytes_per_pixel, width, height, depth, block_height, block_depth);
+    const std::vector<u8> linear = RandomBytes(pitch * height);
+    const std::vector<u8> surface = RandomBytes(size);
+
+    // Swizzling into the range alone must match swizzling into the whole surface
+    for (const auto [origin_y, num_lines] : {std::pair{0U, 1U}, std::pair{31U, 2U},
+                                             std::pair{33U, 70U}, std::pair{149U, 1U}}) {
+        std::vector<u8> expected = surface;
+        SwizzleSubrect(expected, linear, bytes_per_pixel, width, height, depth, origin_x, origin_y,
+                       extent_x, num_lines, block_height, block_depth, pitch);
+
+        const BlockRowRange range = CalculateBlockRowRange(bytes_per_pixel, width, origin_y,
+                                                           num_lines, block_height, block_depth);
+        REQUIRE(range.first_line <= origin_y);
+        REQUIRE(range.offset + range.size <= size);
+        std::vector<u8> result = surface;
+        const std::span<u8> window(result.data() + range.offset, range.size);
+        SwizzleSubrect(window, linear, bytes_per_pixel, width, height - range.first_line, depth,
+                       origin_x, origin_y - range.first_line, extent_x, num_lines, block_height,
+                       block_depth, pitch);
+        REQUIRE(result == expected);
+    }
+}
+
+TEST_CASE("Swizzle[Benchmark]", "[video_core][.benchmark]") {
+    static constexpr u32 width = 1024;
+    static constexpr u32 height = 1024;
+    static constexpr u32 block_height = 4;
+    for (const u32 bytes_per_pixel : {1U, 4U, 16U}) {
+        const size_t size = CalculateSize(true, bytes_per_pixel, width, height, 1, block_height, 0);
+        const std::vector<u8> swizzled = RandomBytes(size);
+        std::vector<u8> linear(size);
+        BENCHMARK("Reference " + std::to_string(bytes_per_pixel)) {
+            ReferenceUnswizzle(linear, swizzled, bytes_per_pixel, width, height, 1, block_height,
+                               0);
+            return linear[0];
+        };
+        BENCHMARK("Unswizzle " + std::to_string(bytes_per_pixel)) {
+            UnswizzleTexture(linear, swizzled, bytes_per_pixel, width, height, 1, block_height, 0);
+            return linear[0];
+        };
+        BENCHMARK("UnswizzleSubrect " + std::to_string(bytes_per_pixel)) {
+            UnswizzleSubrect(linear, swizzled, bytes_per_pixel, width, height, 1, 1, 0, width - 1,
+                             height, block_height, 0, width * bytes_per_pixel);
+            return linear[0];
+        };
+    }
+}
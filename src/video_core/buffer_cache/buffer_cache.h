@@ -4,6 +4,7 @@
 #pragma once
 
 #include <algorithm>
+#include <chrono>
 #include <memory>
 #include <numeric>
 
@@ -18,7 +19,8 @@ using Core::DEVICE_PAGESIZE;
 
 template <class P>
 BufferCache<P>::BufferCache(Tegra::MaxwellDeviceMemoryManager& device_memory_, Runtime& runtime_)
-    : runtime{runtime_}, device_memory{device_memory_}, memory_tracker{device_memory} {
+    : runtime{runtime_}, device_memory{device_memory_}, memory_tracker{device_memory},
+      trace_recorder{CacheTraceRecorder::CreateIfEnabled("buffer_cache")} {
     // Ensure the first slot is used for the null buffer
     void(slot_buffers.insert(runtime, NullBufferParams{}));
     gpu_modified_ranges.Clear();
@@ -52,17 +54,43 @@ void BufferCache<P>::RunGarbageCollector() {
     const bool aggressive_gc = total_used_memory >= critical_memory;
     const u64 ticks_to_destroy = aggressive_gc ? 60 : 120;
     int num_iterations = aggressive_gc ? 64 : 32;
-    const auto clean_up = [this, &num_iterations](BufferId buffer_id) {
-        if (num_iterations == 0) {
+
+    // Collection is incremental, whatever doesn't fit in this frame's budget is left for the next
+    const auto start_time = std::chrono::steady_clock::now();
+    const auto deadline = start_time + (aggressive_gc ? std::chrono::microseconds{2000}
+                                                      : std::chrono::microseconds{500});
+    const u64 start_memory = total_used_memory;
+    size_t num_collected = 0;
+
+    // Buffers written by the GPU are downloaded before they are deleted, so they are only
+    // collected after the buffers that can be dropped right away.
+    const auto clean_up = [&](BufferId buffer_id, bool collect_gpu_modified) {
+        if (num_iterations == 0 || std::chrono::steady_clock::now() >= deadline) {
             return true;
         }
-        --num_iterations;
         auto& buffer = slot_buffers[buffer_id];
+        if (!collect_gpu_modified &&
+            memory_tracker.IsRegionGpuModified(buffer.CpuAddr(), buffer.SizeBytes())) {
+            return false;
+        }
+        --num_iterations;
         DownloadBufferMemory(buffer);
         DeleteBuffer(buffer_id);
+        ++num_collected;
         return false;
     };
-    lru_cache.ForEachItemBelow(frame_tick - ticks_to_destroy, clean_up);
+    lru_cache.ForEachItemBelow(frame_tick - ticks_to_destroy,
+                               [&](BufferId buffer_id) { return clean_up(buffer_id, false); });
+    lru_cache.ForEachItemBelow(frame_tick - ticks_to_destroy,
+                               [&](BufferId buffer_id) { return clean_up(buffer_id, true); });
+
+    if (num_collected > 0) {
+        const auto elapsed = std::chrono::steady_clock::now() - start_time;
+        const u64 collected_bytes = start_memory - std::min(start_memory, total_used_memory);
+        LOG_DEBUG(HW_GPU, "Collected {} buffers ({} KiB) in {} us", num_collected,
+                  collected_bytes / 1024,
+                  std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+    }
 }
 
 template <class P>
@@ -90,12 +118,19 @@ void BufferCache<P>::TickFrame() {
     const bool skip_preferred = hits * 256 < shots * 251;
     channel_state->uniform_buffer_skip_cache_size = skip_preferred ? DEFAULT_SKIP_CACHE_SIZE : 0;
 
-    // If we can obtain the memory info, use it instead of the estimate.
-    if (runtime.CanReportMemoryUsage()) {
+    if (memory_budget) {
+        // Thresholds are this cache's share of the budget, measured against its own usage
+        memory_budget->ReportUsage(MemoryBudgetClient::BufferCache, total_used_memory);
+        const MemoryBudgetShare& share = memory_budget->GetShare(MemoryBudgetClient::BufferCache);
+        minimum_memory = share.expected;
+        critical_memory = share.critical;
+    } else if (runtime.CanReportMemoryUsage()) {
+        // If we can obtain the memory info, use it instead of the estimate.
         total_used_memory = runtime.GetDeviceMemoryUsage();
     }
     if (total_used_memory >= minimum_memory) {
         RunGarbageCollector();
+        slot_buffers.Compact();
     }
     ++frame_tick;
     delayed_destruction_ring.Tick();
@@ -108,6 +143,9 @@ void BufferCache<P>::TickFrame() {
 
 template <class P>
 void BufferCache<P>::WriteMemory(DAddr device_addr, u64 size) {
+    if (trace_recorder) {
+        trace_recorder->Record(CacheTraceOp::BufferWriteMemory, device_addr, size);
+    }
     if (memory_tracker.IsRegionGpuModified(device_addr, size)) {
         ClearDownload(device_addr, size);
         gpu_modified_ranges.Subtract(device_addr, size);
@@ -128,6 +166,9 @@ void BufferCache<P>::CachedWriteMemory(DAddr device_addr, u64 size) {
         return;
     }
 
+    if (trace_recorder) {
+        trace_recorder->Record(CacheTraceOp::BufferCachedWriteMemory, device_addr, size);
+    }
     tmp_buffer.resize_destructive(size);
     device_memory.ReadBlockUnsafe(device_addr, tmp_buffer.data(), size);
 
@@ -169,6 +210,9 @@ std::optional<VideoCore::RasterizerDownloadArea> BufferCache<P>::GetFlushArea(DA
 
 template <class P>
 void BufferCache<P>::DownloadMemory(DAddr device_addr, u64 size) {
+    if (trace_recorder) {
+        trace_recorder->Record(CacheTraceOp::BufferDownloadMemory, device_addr, size);
+    }
     ForEachBufferInRange(device_addr, size, [&](BufferId, Buffer& buffer) {
         DownloadBufferMemory(buffer, device_addr, size);
     });
@@ -183,6 +227,12 @@ void BufferCache<P>::ClearDownload(DAddr device_addr, u64 size) {
     }
 }
 
+template <class P>
+bool BufferCache<P>::DMAIsRegionRegistered(GPUVAddr address, u64 amount) {
+    const std::optional<DAddr> cpu_address = gpu_memory->GpuToCpuAddress(address);
+    return cpu_address && IsRegionRegistered(*cpu_address, amount);
+}
+
 template <class P>
 bool BufferCache<P>::DMACopy(GPUVAddr src_address, GPUVAddr dest_address, u64 amount) {
     const std::optional<DAddr> cpu_src_address = gpu_memory->GpuToCpuAddress(src_address);
@@ -283,6 +333,7 @@ std::pair<typename P::Buffer*, u32> BufferCache<P>::ObtainCPUBuffer(
     DAddr device_addr, u32 size, ObtainBufferSynchronize sync_info, ObtainBufferOperation post_op) {
     const BufferId buffer_id = FindBuffer(device_addr, size);
     Buffer& buffer = slot_buffers[buffer_id];
+    buffer.MarkUsage(buffer.Offset(device_addr), size);
 
     // synchronize op
     switch (sync_info) {
@@ -332,6 +383,9 @@ void BufferCache<P>::DisableGraphicsUniformBuffer(size_t stage, u32 index) {
 template <class P>
 void BufferCache<P>::UpdateGraphicsBuffers(bool is_indexed) {
     MICROPROFILE_SCOPE(GPU_PrepareBuffers);
+    if (trace_recorder) {
+        trace_recorder->Record(CacheTraceOp::BufferUpdateGraphicsBuffers, 0, 0, is_indexed ? 1 : 0);
+    }
     do {
         channel_state->has_deleted_buffers = false;
         DoUpdateGraphicsBuffers(is_indexed);
@@ -341,6 +395,9 @@ void BufferCache<P>::UpdateGraphicsBuffers(bool is_indexed) {
 template <class P>
 void BufferCache<P>::UpdateComputeBuffers() {
     MICROPROFILE_SCOPE(GPU_PrepareBuffers);
+    if (trace_recorder) {
+        trace_recorder->Record(CacheTraceOp::BufferUpdateComputeBuffers);
+    }
     do {
         channel_state->has_deleted_buffers = false;
         DoUpdateComputeBuffers();
@@ -350,6 +407,10 @@ void BufferCache<P>::UpdateComputeBuffers() {
 template <class P>
 void BufferCache<P>::BindHostGeometryBuffers(bool is_indexed) {
     MICROPROFILE_SCOPE(GPU_BindUploadBuffers);
+    if (trace_recorder) {
+        trace_recorder->Record(CacheTraceOp::BufferBindHostGeometryBuffers, 0, 0,
+                               is_indexed ? 1 : 0);
+    }
     if (is_indexed) {
         BindHostIndexBuffer();
     } else if constexpr (!HAS_FULL_INDEX_AND_PRIMITIVE_SUPPORT) {
@@ -370,6 +431,10 @@ void BufferCache<P>::BindHostGeometryBuffers(bool is_indexed) {
 template <class P>
 void BufferCache<P>::BindHostStageBuffers(size_t stage) {
     MICROPROFILE_SCOPE(GPU_BindUploadBuffers);
+    if (trace_recorder) {
+        trace_recorder->Record(CacheTraceOp::BufferBindHostStageBuffers, 0, 0,
+                               static_cast<u32>(stage));
+    }
     BindHostGraphicsUniformBuffers(stage);
     BindHostGraphicsStorageBuffers(stage);
     BindHostGraphicsTextureBuffers(stage);
@@ -760,6 +825,7 @@ void BufferCache<P>::BindHostDrawIndirectBuffers() {
         Buffer& buffer = slot_buffers[binding.buffer_id];
         TouchBuffer(buffer, binding.buffer_id);
         SynchronizeBuffer(buffer, binding.device_addr, binding.size);
+        buffer.MarkUsage(buffer.Offset(binding.device_addr), binding.size);
     };
     if (current_draw_indirect->include_count) {
         bind_buffer(channel_state->count_buffer_binding);
@@ -917,6 +983,10 @@ void BufferCache<P>::BindHostTransformFeedbackBuffers() {
     if (maxwell3d->regs.transform_feedback_enabled == 0) {
         return;
     }
+    // Bindings are kept across draws, they are only recorded again when they change
+    auto& flags = maxwell3d->dirty.flags;
+    const bool needs_bind = flags[Dirty::TransformFeedbackBuffers];
+    flags[Dirty::TransformFeedbackBuffers] = false;
     HostBindings<typename P::Buffer> host_bindings;
     for (u32 index = 0; index < NUM_TRANSFORM_FEEDBACK_BUFFERS; ++index) {
         const Binding& binding = channel_state->transform_feedback_buffers[index];
@@ -937,7 +1007,7 @@ void BufferCache<P>::BindHostTransformFeedbackBuffers() {
         host_bindings.offsets.push_back(offset);
         host_bindings.sizes.push_back(size);
     }
-    if (host_bindings.buffers.size() > 0) {
+    if (needs_bind && host_bindings.buffers.size() > 0) {
         runtime.BindTransformFeedbackBuffers(host_bindings);
     }
 }
@@ -1029,6 +1099,7 @@ void BufferCache<P>::BindHostComputeTextureBuffers() {
 template <class P>
 void BufferCache<P>::DoUpdateGraphicsBuffers(bool is_indexed) {
     BufferOperations([&]() {
+        is_batching_uploads = true;
         if (is_indexed) {
             UpdateIndexBuffer();
         }
@@ -1042,15 +1113,20 @@ void BufferCache<P>::DoUpdateGraphicsBuffers(bool is_indexed) {
         if (current_draw_indirect) {
             UpdateDrawIndirect();
         }
+        is_batching_uploads = false;
+        CommitBatchedUploads();
     });
 }
 
 template <class P>
 void BufferCache<P>::DoUpdateComputeBuffers() {
     BufferOperations([&]() {
+        is_batching_uploads = true;
         UpdateComputeUniformBuffers();
         UpdateComputeStorageBuffers();
         UpdateComputeTextureBuffers();
+        is_batching_uploads = false;
+        CommitBatchedUploads();
     });
 }
 
@@ -1215,11 +1291,19 @@ void BufferCache<P>::UpdateTransformFeedbackBuffer(u32 index) {
     const u32 size = binding.size;
     const std::optional<DAddr> device_addr = gpu_memory->GpuToCpuAddress(gpu_addr);
     if (binding.enable == 0 || size == 0 || !device_addr) {
+        if (channel_state->transform_feedback_buffers[index].buffer_id != NULL_BUFFER_ID) {
+            maxwell3d->dirty.flags[Dirty::TransformFeedbackBuffers] = true;
+        }
         channel_state->transform_feedback_buffers[index] = NULL_BINDING;
         return;
     }
     const BufferId buffer_id = FindBuffer(*device_addr, size);
-    channel_state->transform_feedback_buffers[index] = Binding{
+    Binding& current = channel_state->transform_feedback_buffers[index];
+    if (current.device_addr != *device_addr || current.size != size ||
+        current.buffer_id != buffer_id) {
+        maxwell3d->dirty.flags[Dirty::TransformFeedbackBuffers] = true;
+    }
+    current = Binding{
         .device_addr = *device_addr,
         .size = size,
         .buffer_id = buffer_id,
@@ -1385,6 +1469,8 @@ void BufferCache<P>::JoinOverlap(BufferId new_buffer_id, BufferId overlap_id,
 
 template <class P>
 BufferId BufferCache<P>::CreateBuffer(DAddr device_addr, u32 wanted_size) {
+    // Overlaps are copied into the new buffer, they must hold their pending uploads first
+    CommitBatchedUploads();
     DAddr device_addr_end = Common::AlignUp(device_addr + wanted_size, CACHING_PAGESIZE);
     device_addr = Common::AlignDown(device_addr, CACHING_PAGESIZE);
     wanted_size = static_cast<u32>(device_addr_end - device_addr);
@@ -1463,6 +1549,17 @@ bool BufferCache<P>::SynchronizeBuffer(Buffer& buffer, DAddr device_addr, u32 si
     if (total_size_bytes == 0) {
         return true;
     }
+    if constexpr (USE_MEMORY_MAPS_FOR_UPLOADS) {
+        if (is_batching_uploads) {
+            for (const BufferCopy& copy : copies) {
+                batched_uploads.push_back(BatchedUpload{
+                    .buffer = &buffer,
+                    .copy = copy,
+                });
+            }
+            return false;
+        }
+    }
     const std::span<BufferCopy> copies_span(copies.data(), copies.size());
     UploadMemory(buffer, total_size_bytes, largest_copy, copies_span);
     return false;
@@ -1509,6 +1606,9 @@ void BufferCache<P>::MappedUploadMemory([[maybe_unused]] Buffer& buffer,
                                         [[maybe_unused]] u64 total_size_bytes,
                                         [[maybe_unused]] std::span<BufferCopy> copies) {
     if constexpr (USE_MEMORY_MAPS) {
+        if (DirectUploadMemory(buffer, copies)) {
+            return;
+        }
         auto upload_staging = runtime.UploadStagingBuffer(total_size_bytes);
         const std::span<u8> staging_pointer = upload_staging.mapped_span;
         for (BufferCopy& copy : copies) {
@@ -1524,6 +1624,96 @@ void BufferCache<P>::MappedUploadMemory([[maybe_unused]] Buffer& buffer,
     }
 }
 
+template <class P>
+bool BufferCache<P>::DirectUploadMemory([[maybe_unused]] Buffer& buffer,
+                                        [[maybe_unused]] std::span<const BufferCopy> copies) {
+    if constexpr (USE_MEMORY_MAPS_FOR_UPLOADS) {
+        const std::span<u8> mapped_span = runtime.DirectUploadSpan(buffer);
+        if (mapped_span.empty()) {
+            return false;
+        }
+        for (const BufferCopy& copy : copies) {
+            const DAddr device_addr = buffer.CpuAddr() + copy.dst_offset;
+            device_memory.ReadBlockUnsafe(device_addr, mapped_span.data() + copy.dst_offset,
+                                          copy.size);
+        }
+        return true;
+    }
+    return false;
+}
+
+template <class P>
+void BufferCache<P>::CommitBatchedUploads() {
+    if constexpr (USE_MEMORY_MAPS_FOR_UPLOADS) {
+        if (batched_uploads.empty()) {
+            return;
+        }
+        upload_batch_stats.num_ranges += batched_uploads.size();
+
+        // Buffers never overlap, sorting by address groups ranges by buffer and offset
+        const auto device_addr = [](const BatchedUpload& upload) {
+            return upload.buffer->CpuAddr() + upload.copy.dst_offset;
+        };
+        std::ranges::sort(batched_uploads, {}, device_addr);
+        size_t last = 0;
+        for (size_t index = 1; index < batched_uploads.size(); ++index) {
+            BatchedUpload& previous = batched_uploads[last];
+            const BatchedUpload& current = batched_uploads[index];
+            if (previous.buffer == current.buffer &&
+                previous.copy.dst_offset + previous.copy.size == current.copy.dst_offset) {
+                previous.copy.size += current.copy.size;
+                ++upload_batch_stats.num_merged_ranges;
+            } else {
+                batched_uploads[++last] = current;
+            }
+        }
+        batched_uploads.resize(last + 1);
+
+        // Ranges of buffers the host can write skip the staging buffer
+        last = 0;
+        for (const BatchedUpload& upload : batched_uploads) {
+            if (DirectUploadMemory(*upload.buffer, std::span(&upload.copy, 1))) {
+                ++upload_batch_stats.num_direct_ranges;
+            } else {
+                batched_uploads[last++] = upload;
+            }
+        }
+        batched_uploads.resize(last);
+        if (batched_uploads.empty()) {
+            return;
+        }
+
+        u64 total_size_bytes = 0;
+        for (BatchedUpload& upload : batched_uploads) {
+            upload.copy.src_offset = total_size_bytes;
+            total_size_bytes += upload.copy.size;
+        }
+        auto upload_staging = runtime.UploadStagingBuffer(total_size_bytes);
+        const std::span<u8> staging_pointer = upload_staging.mapped_span;
+        for (BatchedUpload& upload : batched_uploads) {
+            u8* const src_pointer = staging_pointer.data() + upload.copy.src_offset;
+            device_memory.ReadBlockUnsafe(device_addr(upload), src_pointer, upload.copy.size);
+
+            // Apply the staging offset
+            upload.copy.src_offset += upload_staging.offset;
+        }
+        // Record a single copy with many regions for each destination buffer
+        for (auto it = batched_uploads.begin(); it != batched_uploads.end();) {
+            Buffer& buffer = *it->buffer;
+            batched_copies.clear();
+            for (; it != batched_uploads.end() && it->buffer == &buffer; ++it) {
+                batched_copies.push_back(it->copy);
+            }
+            const bool can_reorder = runtime.CanReorderUpload(buffer, batched_copies);
+            runtime.CopyBuffer(buffer, upload_staging.buffer, batched_copies, true, can_reorder);
+            ++upload_batch_stats.num_copies;
+        }
+        ++upload_batch_stats.num_batches;
+        upload_batch_stats.num_bytes += total_size_bytes;
+        batched_uploads.clear();
+    }
+}
+
 template <class P>
 bool BufferCache<P>::InlineMemory(DAddr dest_address, size_t copy_size,
                                   std::span<const u8> inlined_buffer) {
@@ -1553,6 +1743,12 @@ void BufferCache<P>::InlineMemoryImplementation(DAddr dest_address, size_t copy_
     SynchronizeBuffer(buffer, dest_address, static_cast<u32>(copy_size));
 
     if constexpr (USE_MEMORY_MAPS_FOR_UPLOADS) {
+        if (const std::span<u8> mapped_span = runtime.DirectUploadSpan(buffer);
+            !mapped_span.empty()) {
+            std::memcpy(mapped_span.data() + buffer.Offset(dest_address), inlined_buffer.data(),
+                        copy_size);
+            return;
+        }
         auto upload_staging = runtime.UploadStagingBuffer(copy_size);
         std::array copies{BufferCopy{
             .src_offset = upload_staging.offset,
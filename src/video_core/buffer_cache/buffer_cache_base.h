@@ -23,12 +23,14 @@
 #include "common/settings.h"
 #include "common/slot_vector.h"
 #include "video_core/buffer_cache/buffer_base.h"
+#include "video_core/cache_trace.h"
 #include "video_core/control/channel_state_cache.h"
 #include "video_core/delayed_destruction_ring.h"
 #include "video_core/dirty_flags.h"
 #include "video_core/engines/draw_manager.h"
 #include "video_core/engines/kepler_compute.h"
 #include "video_core/engines/maxwell_3d.h"
+#include "video_core/memory_budget.h"
 #include "video_core/memory_manager.h"
 #include "video_core/surface.h"
 #include "video_core/texture_cache/types.h"
@@ -91,6 +93,21 @@ static constexpr Binding NULL_BINDING{
     .buffer_id = NULL_BUFFER_ID,
 };
 
+/// Counters of the uploads batched while updating the buffers of draws and dispatches
+struct UploadBatchStats {
+    u64 num_batches{};       ///< Number of batches that uploaded at least one range.
+    u64 num_ranges{};        ///< Number of dirty ranges gathered into batches.
+    u64 num_merged_ranges{}; ///< Number of ranges merged into an adjacent range.
+    u64 num_copies{};        ///< Number of buffer copy commands recorded by batches.
+    u64 num_bytes{};         ///< Number of bytes uploaded by batches.
+    u64 num_direct_ranges{}; ///< Number of ranges written straight into mapped buffers.
+
+    /// Returns the average number of bytes uploaded by each copy command
+    [[nodiscard]] u64 BytesPerCopy() const noexcept {
+        return num_copies != 0 ? num_bytes / num_copies : 0;
+    }
+};
+
 template <typename Buffer>
 struct HostBindings {
     boost::container::small_vector<Buffer*, NUM_VERTEX_BUFFERS> buffers;
@@ -192,6 +209,11 @@ class BufferCache : public VideoCommon::ChannelSetupCaches<BufferCacheChannelInf
         bool has_stream_leap = false;
     };
 
+    struct BatchedUpload {
+        Buffer* buffer;
+        BufferCopy copy;
+    };
+
 public:
     explicit BufferCache(Tegra::MaxwellDeviceMemoryManager& device_memory_, Runtime& runtime_);
 
@@ -199,6 +221,12 @@ public:
 
     void TickFrame();
 
+    /// Collects buffers against a share of a budget shared with other caches, instead of
+    /// thresholds derived from the device memory
+    void SetMemoryBudget(MemoryBudget* memory_budget_) noexcept {
+        memory_budget = memory_budget_;
+    }
+
     void WriteMemory(DAddr device_addr, u64 size);
 
     void CachedWriteMemory(DAddr device_addr, u64 size);
@@ -279,6 +307,9 @@ public:
 
     bool DMAClear(GPUVAddr src_address, u64 amount, u32 value);
 
+    /// Return true when a GPU region used by a DMA copy is registered on the cache
+    [[nodiscard]] bool DMAIsRegionRegistered(GPUVAddr address, u64 amount);
+
     /// Return true when a CPU region is modified from the GPU
     [[nodiscard]] bool IsRegionGpuModified(DAddr addr, size_t size);
 
@@ -297,6 +328,11 @@ public:
 
     [[nodiscard]] std::pair<Buffer*, u32> GetDrawIndirectBuffer();
 
+    /// Returns the counters of the uploads batched so far
+    [[nodiscard]] const UploadBatchStats& GetUploadBatchStats() const noexcept {
+        return upload_batch_stats;
+    }
+
     template <typename Func>
     void BufferOperations(Func&& func) {
         do {
@@ -422,6 +458,13 @@ private:
 
     void MappedUploadMemory(Buffer& buffer, u64 total_size_bytes, std::span<BufferCopy> copies);
 
+    /// Writes the ranges straight into the buffer's host mapping, skipping the staging copy.
+    /// Returns false when the buffer can't be written from the host right now.
+    bool DirectUploadMemory(Buffer& buffer, std::span<const BufferCopy> copies);
+
+    /// Uploads every range gathered since the batch started with a single staging allocation
+    void CommitBatchedUploads();
+
     void DownloadBufferMemory(Buffer& buffer_id);
 
     void DownloadBufferMemory(Buffer& buffer_id, DAddr device_addr, u64 size);
@@ -455,6 +498,8 @@ private:
     u32 last_index_count = 0;
 
     MemoryTracker memory_tracker;
+    std::unique_ptr<CacheTraceRecorder> trace_recorder;
+    MemoryBudget* memory_budget = nullptr;
     Common::RangeSet<DAddr> uncommitted_gpu_modified_ranges;
     Common::RangeSet<DAddr> gpu_modified_ranges;
     std::deque<Common::RangeSet<DAddr>> committed_gpu_modified_ranges;
@@ -470,6 +515,13 @@ private:
     size_t immediate_buffer_capacity = 0;
     Common::ScratchBuffer<u8> immediate_buffer_alloc;
 
+    // Batched uploads, buffers can't be created while there are pending uploads as that may
+    // invalidate the pointers
+    bool is_batching_uploads = false;
+    std::vector<BatchedUpload> batched_uploads;
+    std::vector<BufferCopy> batched_copies;
+    UploadBatchStats upload_batch_stats;
+
     struct LRUItemParams {
         using ObjectType = BufferId;
         using TickType = u64;
@@ -196,6 +196,21 @@ public:
 
     template <typename Func>
     void IterateWords(size_t offset, size_t size, Func&& func) const {
+        IterateWords(offset, size, std::forward<Func>(func),
+                     [](size_t begin, size_t) { return begin; });
+    }
+
+    /**
+     * Iterate the words overlapping a range, calling func with each word index and its mask
+     *
+     * @param offset Offset in bytes from the start of the buffer
+     * @param size   Size in bytes of the range to iterate
+     * @param func   Function to call for each word
+     * @param skip   Called with a range of words fully inside the range, returns the first word
+     *               of the range func has to be called on. Skipped words are never visited.
+     */
+    template <typename Func, typename Skip>
+    void IterateWords(size_t offset, size_t size, Func&& func, Skip&& skip) const {
         using FuncReturn = std::invoke_result_t<Func, std::size_t, u64>;
         static constexpr bool BOOL_BREAK = std::is_same_v<FuncReturn, bool>;
         const size_t start = static_cast<size_t>(std::max<s64>(static_cast<s64>(offset), 0LL));
@@ -214,6 +229,15 @@ public:
         end_page += diff * PAGES_PER_WORD;
         constexpr u64 base_mask{~0ULL};
         for (size_t word_index = start_word; word_index < end_word; word_index++) {
+            if (start_page == 0 && end_page >= PAGES_PER_WORD) {
+                const size_t full_end = std::min(end_word, word_index + end_page / PAGES_PER_WORD);
+                const size_t next_word = skip(word_index, full_end);
+                end_page -= (next_word - word_index) * PAGES_PER_WORD;
+                word_index = next_word;
+                if (word_index >= end_word) {
+                    return;
+                }
+            }
             const u64 mask = ExtractBits(base_mask, start_page, end_page);
             start_page = 0;
             end_page -= PAGES_PER_WORD;
@@ -301,7 +325,11 @@ public:
             func(cpu_addr + pending_offset * BYTES_PER_PAGE,
                  (pending_pointer - pending_offset) * BYTES_PER_PAGE);
         };
-        IterateWords(offset, size, [&](size_t index, u64 mask) {
+        const auto skip = [&](size_t begin, size_t end) {
+            return FindActiveWord<type, clear>(state_words.data(), untracked_words.data(), begin,
+                                               end);
+        };
+        const auto visit_word = [&](size_t index, u64 mask) {
             if constexpr (type == Type::GPU) {
                 mask &= ~untracked_words[index];
             }
@@ -336,7 +364,8 @@ public:
                 release();
                 reset();
             });
-        });
+        };
+        IterateWords(offset, size, visit_word, skip);
         if (pending) {
             release();
         }
@@ -355,8 +384,12 @@ public:
         const std::span<const u64> state_words = words.template Span<type>();
         [[maybe_unused]] const std::span<const u64> untracked_words =
             words.template Span<Type::Untracked>();
+        const auto skip = [&](size_t begin, size_t end) {
+            return FindActiveWord<type, false>(state_words.data(), untracked_words.data(), begin,
+                                               end);
+        };
         bool result = false;
-        IterateWords(offset, size, [&](size_t index, u64 mask) {
+        const auto visit_word = [&](size_t index, u64 mask) {
             if constexpr (type == Type::GPU) {
                 mask &= ~untracked_words[index];
             }
@@ -366,7 +399,8 @@ public:
                 return true;
             }
             return false;
-        });
+        };
+        IterateWords(offset, size, visit_word, skip);
         return result;
     }
 
@@ -382,9 +416,13 @@ public:
         const std::span<const u64> state_words = words.template Span<type>();
         [[maybe_unused]] const std::span<const u64> untracked_words =
             words.template Span<Type::Untracked>();
+        const auto skip = [&](size_t begin_word, size_t end_word) {
+            return FindActiveWord<type, false>(state_words.data(), untracked_words.data(),
+                                               begin_word, end_word);
+        };
         u64 begin = std::numeric_limits<u64>::max();
         u64 end = 0;
-        IterateWords(offset, size, [&](size_t index, u64 mask) {
+        const auto visit_word = [&](size_t index, u64 mask) {
             if constexpr (type == Type::GPU) {
                 mask &= ~untracked_words[index];
             }
@@ -397,7 +435,8 @@ public:
             const u64 page_index = index * PAGES_PER_WORD;
             begin = std::min(begin, page_index + local_page_begin);
             end = page_index + local_page_end;
-        });
+        };
+        IterateWords(offset, size, visit_word, skip);
         static constexpr std::pair<u64, u64> EMPTY{0, 0};
         return begin < end ? std::make_pair(begin * BYTES_PER_PAGE, end * BYTES_PER_PAGE) : EMPTY;
     }
@@ -432,6 +471,48 @@ public:
     }
 
 private:
+    /**
+     * Returns the first word in a range where an operation over the given type has any effect
+     *
+     * @param state_words     Words of the queried type
+     * @param untracked_words Untracked words
+     * @param begin           First word of the range to scan
+     * @param end             Word past the end of the range to scan
+     *
+     * @tparam clear True when the operation also clears the state of the pages
+     *
+     * @returns The index of the first word with an effect, or end when there is none
+     */
+    template <Type type, bool clear>
+    static size_t FindActiveWord(const u64* state_words, const u64* untracked_words, size_t begin,
+                                 size_t end) noexcept {
+        const auto active_bits = [&](size_t index) -> u64 {
+            if constexpr (type == Type::GPU) {
+                return state_words[index] & ~untracked_words[index];
+            } else if constexpr (clear && (type == Type::CPU || type == Type::CachedCPU)) {
+                // Clearing CPU pages also has to notify the tracker about untracked pages
+                return state_words[index] | untracked_words[index];
+            } else {
+                return state_words[index];
+            }
+        };
+        // Test whole blocks at once, this loop is vectorized by the compiler (SSE2/NEON)
+        static constexpr size_t BLOCK_WORDS = 8;
+        for (; begin + BLOCK_WORDS <= end; begin += BLOCK_WORDS) {
+            u64 bits = 0;
+            for (size_t index = 0; index < BLOCK_WORDS; ++index) {
+                bits |= active_bits(begin + index);
+            }
+            if (bits != 0) {
+                break;
+            }
+        }
+        while (begin < end && active_bits(begin) == 0) {
+            ++begin;
+        }
+        return begin;
+    }
+
     template <Type type>
     u64* Array() noexcept {
         if constexpr (type == Type::CPU) {
@@ -0,0 +1,115 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <chrono>
+
+#include <fmt/format.h>
+
+#include "common/fs/fs.h"
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
+#include "common/settings.h"
+#include "video_core/cache_trace.h"
+
+namespace VideoCommon {
+namespace {
+constexpr std::array<char, 8> MAGIC_NUMBER{'y', 'u', 'z', 'u', 't', 'r', 'c', 'e'};
+constexpr u32 TRACE_VERSION = 1;
+
+// Records are written in batches, keeping file writes out of the cache hot paths
+constexpr size_t RECORDS_PER_FLUSH = 4096;
+
+const auto trace_epoch = std::chrono::steady_clock::now();
+} // Anonymous namespace
+
+CacheTraceRecorder::CacheTraceRecorder(const std::filesystem::path& filename)
+    : file{filename, std::ios::binary | std::ios::trunc} {
+    if (!file.is_open()) {
+        LOG_ERROR(Common_Filesystem, "Failed to open cache trace file {}",
+                  Common::FS::PathToUTF8String(filename));
+        return;
+    }
+    file.write(MAGIC_NUMBER.data(), MAGIC_NUMBER.size())
+        .write(reinterpret_cast<const char*>(&TRACE_VERSION), sizeof(TRACE_VERSION));
+    records.reserve(RECORDS_PER_FLUSH);
+    LOG_INFO(Render, "Recording cache trace to {}", Common::FS::PathToUTF8String(filename));
+}
+
+CacheTraceRecorder::~CacheTraceRecorder() {
+    std::scoped_lock lock{mutex};
+    Flush();
+}
+
+std::unique_ptr<CacheTraceRecorder> CacheTraceRecorder::CreateIfEnabled(std::string_view name) {
+    if (!Settings::values.record_cache_traces.GetValue()) {
+        return nullptr;
+    }
+    const auto log_dir{Common::FS::GetYuzuPath(Common::FS::YuzuPath::LogDir)};
+    if (!Common::FS::CreateDir(log_dir)) {
+        LOG_ERROR(Common_Filesystem, "Failed to create log directory for cache traces");
+        return nullptr;
+    }
+    return std::make_unique<CacheTraceRecorder>(log_dir / fmt::format("{}_trace.bin", name));
+}
+
+void CacheTraceRecorder::Record(CacheTraceOp op, u64 addr, u64 size, u32 arg) {
+    const auto elapsed{std::chrono::steady_clock::now() - trace_epoch};
+    const u64 timestamp_ns{static_cast<u64>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count())};
+    std::scoped_lock lock{mutex};
+    records.push_back({
+        .timestamp_ns = timestamp_ns,
+        .addr = addr,
+        .size = size,
+        .op = op,
+        .arg = arg,
+    });
+    if (records.size() >= RECORDS_PER_FLUSH) {
+        Flush();
+    }
+}
+
+void CacheTraceRecorder::Flush() {
+    if (file.is_open() && !records.empty()) {
+        file.write(reinterpret_cast<const char*>(records.data()),
+                   static_cast<std::streamsize>(records.size() * sizeof(CacheTraceRecord)));
+    }
+    records.clear();
+}
+
+std::optional<std::vector<CacheTraceRecord>> LoadCacheTrace(
+    const std::filesystem::path& filename) try {
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        return std::nullopt;
+    }
+    file.exceptions(std::ifstream::failbit);
+    const size_t file_size{static_cast<size_t>(file.tellg())};
+    file.seekg(0, std::ios::beg);
+
+    constexpr size_t header_size{MAGIC_NUMBER.size() + sizeof(TRACE_VERSION)};
+    if (file_size < header_size) {
+        return std::nullopt;
+    }
+    std::array<char, 8> magic_number;
+    u32 trace_version;
+    file.read(magic_number.data(), magic_number.size())
+        .read(reinterpret_cast<char*>(&trace_version), sizeof(trace_version));
+    if (magic_number != MAGIC_NUMBER || trace_version != TRACE_VERSION) {
+        LOG_ERROR(Common_Filesystem, "Invalid cache trace file {}",
+                  Common::FS::PathToUTF8String(filename));
+        return std::nullopt;
+    }
+    // Traces of sessions that didn't shut down cleanly may end with a partial record
+    std::vector<CacheTraceRecord> records((file_size - header_size) / sizeof(CacheTraceRecord));
+    file.read(reinterpret_cast<char*>(records.data()),
+              static_cast<std::streamsize>(records.size() * sizeof(CacheTraceRecord)));
+    return records;
+
+} catch (const std::ios_base::failure& e) {
+    LOG_ERROR(Common_Filesystem, "{}", e.what());
+    return std::nullopt;
+}
+
+} // namespace VideoCommon
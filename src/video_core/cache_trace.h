@@ -0,0 +1,78 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "common/common_types.h"
+
+namespace VideoCommon {
+
+/// Cache operations recorded in a trace
+enum class CacheTraceOp : u32 {
+    TextureWriteMemory,
+    TextureDownloadMemory,
+    TextureUnmapMemory,
+    TextureUnmapGPUMemory,
+    TextureUpdateRenderTargets,
+    TextureFillGraphicsImageViews,
+    TextureFillComputeImageViews,
+    BufferWriteMemory,
+    BufferCachedWriteMemory,
+    BufferDownloadMemory,
+    BufferUpdateGraphicsBuffers,
+    BufferUpdateComputeBuffers,
+    BufferBindHostGeometryBuffers,
+    BufferBindHostStageBuffers,
+};
+
+/// Single recorded call, addresses and sizes are left as zero for calls without them
+struct CacheTraceRecord {
+    u64 timestamp_ns;
+    u64 addr;
+    u64 size;
+    CacheTraceOp op;
+    u32 arg;
+};
+static_assert(sizeof(CacheTraceRecord) == 32);
+
+/**
+ * Records the calls made to a cache to a file, so their sequence can be analyzed or replayed to
+ * benchmark the cache away from the games that produced it. Timestamps are shared by every
+ * recorder in the process, so the traces of the texture and buffer caches can be merged.
+ */
+class CacheTraceRecorder {
+public:
+    explicit CacheTraceRecorder(const std::filesystem::path& filename);
+    ~CacheTraceRecorder();
+
+    CacheTraceRecorder(const CacheTraceRecorder&) = delete;
+    CacheTraceRecorder& operator=(const CacheTraceRecorder&) = delete;
+
+    /// Creates a recorder writing to the log directory when traces are enabled in the settings
+    [[nodiscard]] static std::unique_ptr<CacheTraceRecorder> CreateIfEnabled(
+        std::string_view name);
+
+    /// Records a call, may be called from any thread
+    void Record(CacheTraceOp op, u64 addr = 0, u64 size = 0, u32 arg = 0);
+
+private:
+    void Flush();
+
+    std::mutex mutex;
+    std::ofstream file;
+    std::vector<CacheTraceRecord> records;
+};
+
+/// Loads the records of a trace file, returns nullopt when it is invalid
+[[nodiscard]] std::optional<std::vector<CacheTraceRecord>> LoadCacheTrace(
+    const std::filesystem::path& filename);
+
+} // namespace VideoCommon
@@ -13,11 +13,11 @@
 #include "video_core/memory_manager.h"
 
 namespace Tegra {
-CDmaPusher::CDmaPusher(Host1x::Host1x& host1x_)
-    : host1x{host1x_}, nvdec_processor(std::make_shared<Host1x::Nvdec>(host1x)),
-      vic_processor(std::make_unique<Host1x::Vic>(host1x, nvdec_processor)),
-      host1x_processor(std::make_unique<Host1x::Control>(host1x)),
-      sync_manager(std::make_unique<Host1x::SyncptIncrManager>(host1x)) {}
+CDmaPusher::CDmaPusher(GPU& gpu, Host1x::Host1x& host1x_)
+    : host1x{host1x_}, sync_manager(std::make_unique<Host1x::SyncptIncrManager>(host1x)),
+      nvdec_processor(std::make_shared<Host1x::Nvdec>(host1x)),
+      vic_processor(std::make_unique<Host1x::Vic>(gpu, host1x, nvdec_processor)),
+      host1x_processor(std::make_unique<Host1x::Control>(host1x)) {}
 
 CDmaPusher::~CDmaPusher() = default;
 
@@ -79,8 +79,11 @@ void CDmaPusher::ExecuteCommand(u32 state_offset, u32 data) {
             if (cond == 0) {
                 sync_manager->Increment(syncpoint_id);
             } else {
-                sync_manager->SignalDone(
-                    sync_manager->IncrementWhenDone(static_cast<u32>(current_class), syncpoint_id));
+                // Frames decode asynchronously, signal once the ones executed so far are done
+                const u32 handle =
+                    sync_manager->IncrementWhenDone(static_cast<u32>(current_class), syncpoint_id);
+                nvdec_processor->SignalWhenDecoded(
+                    [sync = sync_manager.get(), handle] { sync->SignalDone(handle); });
             }
             break;
         }
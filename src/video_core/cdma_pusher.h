@@ -12,6 +12,8 @@
 
 namespace Tegra {
 
+class GPU;
+
 namespace Host1x {
 class Control;
 class Host1x;
@@ -89,7 +91,7 @@ enum class ThiMethod : u32 {
 
 class CDmaPusher {
 public:
-    explicit CDmaPusher(Host1x::Host1x& host1x);
+    explicit CDmaPusher(GPU& gpu, Host1x::Host1x& host1x);
     ~CDmaPusher();
 
     /// Process the command entry
@@ -103,10 +105,11 @@ private:
     void ThiStateWrite(ThiRegisters& state, u32 offset, u32 argument);
 
     Host1x::Host1x& host1x;
+    /// Outlives the NVDEC, whose decode worker signals increments until it is destroyed
+    std::unique_ptr<Host1x::SyncptIncrManager> sync_manager;
     std::shared_ptr<Tegra::Host1x::Nvdec> nvdec_processor;
     std::unique_ptr<Tegra::Host1x::Vic> vic_processor;
     std::unique_ptr<Tegra::Host1x::Control> host1x_processor;
-    std::unique_ptr<Host1x::SyncptIncrManager> sync_manager;
     ChClassId current_class{};
     ThiRegisters vic_thi_state{};
     ThiRegisters nvdec_thi_state{};
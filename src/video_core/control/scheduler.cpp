@@ -15,9 +15,13 @@ Scheduler::~Scheduler() = default;
 
 void Scheduler::Push(s32 channel, CommandList&& entries) {
     std::unique_lock lk(scheduling_guard);
-    auto it = channels.find(channel);
-    ASSERT(it != channels.end());
-    auto channel_state = it->second;
+    // Submissions usually come in runs from the same channel, skip the lookup for those
+    if (!last_channel || last_channel->bind_id != channel) {
+        auto it = channels.find(channel);
+        ASSERT(it != channels.end());
+        last_channel = it->second.get();
+    }
+    ChannelState* const channel_state = last_channel;
     gpu.BindChannel(channel_state->bind_id);
     channel_state->dma_pusher->Push(std::move(entries));
     channel_state->dma_pusher->DispatchCalls();
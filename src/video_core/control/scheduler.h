@@ -28,6 +28,7 @@ public:
 
 private:
     std::unordered_map<s32, std::shared_ptr<ChannelState>> channels;
+    ChannelState* last_channel{};
     std::mutex scheduling_guard;
     GPU& gpu;
 };
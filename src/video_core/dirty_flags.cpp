@@ -31,6 +31,12 @@ void SetupIndexBuffer(Maxwell3D::DirtyState::Tables& tables) {
     FillBlock(tables[0], OFF(index_buffer), NUM(index_buffer), IndexBuffer);
 }
 
+void SetupDirtyTransformFeedbackBuffers(Maxwell3D::DirtyState::Tables& tables) {
+    // The controls decide how many buffers are bound
+    FillBlock(tables[0], OFF(transform_feedback), NUM(transform_feedback),
+              TransformFeedbackBuffers);
+}
+
 void SetupDirtyDescriptors(Maxwell3D::DirtyState::Tables& tables) {
     FillBlock(tables[0], OFF(tex_header), NUM(tex_header), Descriptors);
     FillBlock(tables[0], OFF(tex_sampler), NUM(tex_sampler), Descriptors);
@@ -69,6 +75,7 @@ void SetupDirtyShaders(Maxwell3D::DirtyState::Tables& tables) {
 void SetupDirtyFlags(Maxwell3D::DirtyState::Tables& tables) {
     SetupDirtyVertexBuffers(tables);
     SetupIndexBuffer(tables);
+    SetupDirtyTransformFeedbackBuffers(tables);
     SetupDirtyDescriptors(tables);
     SetupDirtyRenderTargets(tables);
     SetupDirtyShaders(tables);
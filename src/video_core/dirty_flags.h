@@ -37,6 +37,8 @@ enum : u8 {
 
     IndexBuffer,
 
+    TransformFeedbackBuffers,
+
     Shaders,
 
     // Special entries
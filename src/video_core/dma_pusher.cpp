@@ -131,6 +131,15 @@ void DmaPusher::ProcessCommands(std::span<const CommandHeader> commands) {
                 dma_state.is_last_call = true;
                 index += max_write;
                 continue;
+            } else if (const u32 num_writes = CountRegisterWrites(commands.size() - index);
+                       num_writes > 1) {
+                // Consecutive registers without side effects are written as a single range
+                subchannels[dma_state.subchannel]->CallMethodRange(
+                    dma_state.method, &command_header.argument, num_writes);
+                dma_state.method += num_writes;
+                dma_state.method_count -= num_writes;
+                index += num_writes;
+                continue;
             } else {
                 dma_state.is_last_call = dma_state.method_count <= 1;
                 CallMethod(command_header.argument);
@@ -219,6 +228,20 @@ void DmaPusher::CallMultiMethod(const u32* base_start, u32 num_methods) const {
     }
 }
 
+u32 DmaPusher::CountRegisterWrites(size_t num_available) const {
+    if (dma_increment_once || dma_state.method < non_puller_methods) {
+        return 0;
+    }
+    const auto& execution_mask = subchannels[dma_state.subchannel]->execution_mask;
+    const u32 max_writes =
+        static_cast<u32>(std::min<size_t>(dma_state.method_count, num_available));
+    u32 num_writes = 0;
+    while (num_writes < max_writes && !execution_mask[dma_state.method + num_writes]) {
+        ++num_writes;
+    }
+    return num_writes;
+}
+
 void DmaPusher::BindRasterizer(VideoCore::RasterizerInterface* rasterizer) {
     puller.BindRasterizer(rasterizer);
 }
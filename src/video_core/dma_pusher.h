@@ -149,6 +149,9 @@ private:
     void CallMethod(u32 argument) const;
     void CallMultiMethod(const u32* base_start, u32 num_methods) const;
 
+    /// Returns how many of the next incrementing writes hit engine registers without side effects
+    u32 CountRegisterWrites(size_t num_available) const;
+
     Common::ScratchBuffer<CommandHeader>
         command_headers; ///< Buffer for list of commands fetched at once
 
@@ -1,6 +1,8 @@
 // SPDX-FileCopyrightText: Copyright 2022 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <utility>
+
 #include "common/settings.h"
 #include "video_core/dirty_flags.h"
 #include "video_core/engines/draw_manager.h"
@@ -153,6 +155,8 @@ void DrawManager::DrawBegin() {
         draw_state.instance_count = 0;
         draw_state.draw_mode = DrawMode::General;
     } else if (increment_instance_count) {
+        // Instanced draws are deferred separately, the held back draw has to come before them
+        FlushPendingDraw();
         draw_state.instance_count++;
         draw_state.draw_mode = DrawMode::Instance;
     }
@@ -168,18 +172,23 @@ void DrawManager::DrawEnd(u32 instance_count, bool force_draw) {
             break;
         }
         [[fallthrough]];
-    case DrawMode::General:
+    case DrawMode::General: {
         draw_state.base_instance = regs.global_base_instance_index;
         draw_state.base_index = regs.global_base_vertex_index;
-        if (draw_state.draw_indexed) {
+        const bool draw_indexed = draw_state.draw_indexed;
+        if (draw_indexed) {
             draw_state.index_buffer = regs.index_buffer;
-            ProcessDraw(true, instance_count);
         } else {
             draw_state.vertex_buffer = regs.vertex_buffer;
-            ProcessDraw(false, instance_count);
+        }
+        if (coalesce_draws && draw_state.draw_mode == DrawMode::General && instance_count == 1) {
+            CoalesceDraw(draw_indexed);
+        } else {
+            ProcessDraw(draw_indexed, instance_count);
         }
         draw_state.draw_indexed = false;
         break;
+    }
     case DrawMode::InlineIndex:
         draw_state.base_instance = regs.global_base_instance_index;
         draw_state.base_index = regs.global_base_vertex_index;
@@ -271,6 +280,93 @@ void DrawManager::ProcessDraw(bool draw_indexed, u32 instance_count) {
     }
 }
 
+void DrawManager::BeginDrawCoalescing() {
+    coalesce_draws = true;
+}
+
+void DrawManager::EndDrawCoalescing() {
+    FlushPendingDraw();
+    coalesce_draws = false;
+}
+
+void DrawManager::FlushPendingDraw() {
+    if (!has_pending_draw) {
+        return;
+    }
+    has_pending_draw = false;
+    std::swap(draw_state, pending_draw_state);
+    ProcessDraw(pending_draw_indexed, 1);
+    std::swap(draw_state, pending_draw_state);
+}
+
+bool DrawManager::IsDrawParameterMethod(u32 method) {
+    switch (method) {
+    case MAXWELL3D_REG_INDEX(draw.begin):
+    case MAXWELL3D_REG_INDEX(draw.end):
+    case MAXWELL3D_REG_INDEX(vertex_buffer.first):
+    case MAXWELL3D_REG_INDEX(vertex_buffer.count):
+    case MAXWELL3D_REG_INDEX(index_buffer.first):
+    case MAXWELL3D_REG_INDEX(index_buffer.count):
+        return true;
+    default:
+        return false;
+    }
+}
+
+void DrawManager::CoalesceDraw(bool draw_indexed) {
+    UpdateTopology();
+    if (has_pending_draw && CanMergeDraw(draw_indexed)) {
+        if (draw_indexed) {
+            pending_draw_state.index_buffer.count += draw_state.index_buffer.count;
+        } else {
+            pending_draw_state.vertex_buffer.count += draw_state.vertex_buffer.count;
+        }
+        return;
+    }
+    FlushPendingDraw();
+    switch (draw_state.topology) {
+    case PrimitiveTopology::Points:
+    case PrimitiveTopology::Lines:
+    case PrimitiveTopology::Triangles:
+        // Only lists of independent primitives keep their meaning when ranges are concatenated
+        pending_draw_state = draw_state;
+        pending_draw_indexed = draw_indexed;
+        has_pending_draw = true;
+        break;
+    default:
+        ProcessDraw(draw_indexed, 1);
+        break;
+    }
+}
+
+bool DrawManager::CanMergeDraw(bool draw_indexed) const {
+    const State& pending = pending_draw_state;
+    if (pending_draw_indexed != draw_indexed || pending.topology != draw_state.topology ||
+        pending.base_instance != draw_state.base_instance ||
+        pending.base_index != draw_state.base_index) {
+        return false;
+    }
+    const u32 vertices_per_primitive = [&] {
+        switch (pending.topology) {
+        case PrimitiveTopology::Lines:
+            return 2U;
+        case PrimitiveTopology::Triangles:
+            return 3U;
+        default:
+            return 1U;
+        }
+    }();
+    // Trailing vertices of an incomplete primitive would form a primitive with the next range
+    if (draw_indexed) {
+        return pending.index_buffer.count % vertices_per_primitive == 0 &&
+               pending.index_buffer.first + pending.index_buffer.count ==
+                   draw_state.index_buffer.first;
+    }
+    return pending.vertex_buffer.count % vertices_per_primitive == 0 &&
+           pending.vertex_buffer.first + pending.vertex_buffer.count ==
+               draw_state.vertex_buffer.first;
+}
+
 void DrawManager::ProcessDrawIndirect() {
     LOG_TRACE(
         HW_GPU,
@@ -76,6 +76,22 @@ public:
 
     void DrawIndexedIndirect(PrimitiveTopology topology, u32 index_first, u32 index_count);
 
+    /// Holds back draws so consecutive draws of adjacent ranges can be merged into one
+    void BeginDrawCoalescing();
+
+    /// Issues the draw held back and stops holding back new ones
+    void EndDrawCoalescing();
+
+    /// Issues the draw held back, if any. Must be called before any state it depends on changes
+    void FlushPendingDraw();
+
+    [[nodiscard]] bool HasPendingDraw() const noexcept {
+        return has_pending_draw;
+    }
+
+    /// Returns true when writing the method can't change the result of a draw held back
+    [[nodiscard]] static bool IsDrawParameterMethod(u32 method);
+
     const State& GetDrawState() const {
         return draw_state;
     }
@@ -107,11 +123,20 @@ private:
 
     void ProcessDraw(bool draw_indexed, u32 instance_count);
 
+    void CoalesceDraw(bool draw_indexed);
+
+    [[nodiscard]] bool CanMergeDraw(bool draw_indexed) const;
+
     void ProcessDrawIndirect();
 
     Maxwell3D* maxwell3d{};
     State draw_state{};
     DrawTextureState draw_texture_state{};
     IndirectParams indirect_state{};
+
+    bool coalesce_draws{};
+    bool has_pending_draw{};
+    bool pending_draw_indexed{};
+    State pending_draw_state{};
 };
 } // namespace Tegra::Engines
@@ -47,6 +47,12 @@ void State::ProcessData(const u32* data, size_t num_data) {
 void State::ProcessData(std::span<const u8> read_buffer) {
     const GPUVAddr address{regs.dest.Address()};
     if (is_linear) {
+        if (regs.line_count == 1 || regs.dest.pitch == regs.line_length_in) {
+            // The lines are contiguous, upload them at once instead of one call per line
+            const size_t size = size_t{regs.line_length_in} * regs.line_count;
+            rasterizer->AccelerateInlineToMemory(address, size, read_buffer.first(size));
+            return;
+        }
         for (size_t line = 0; line < regs.line_count; ++line) {
             const GPUVAddr dest_line = address + line * regs.dest.pitch;
             std::span<const u8> buffer(read_buffer.data() + line * regs.line_length_in,
@@ -68,12 +74,28 @@ void State::ProcessData(std::span<const u8> read_buffer) {
             true, bytes_per_pixel, width, regs.dest.height, regs.dest.depth,
             regs.dest.BlockHeight(), regs.dest.BlockDepth());
 
+        // When the lines fit in the first slice, only read and write back the rows of blocks
+        // holding them. Small uploads then don't invalidate the caches of the whole surface.
+        Tegra::Texture::BlockRowRange range{
+            .first_line = 0,
+            .offset = 0,
+            .size = dst_size,
+        };
+        if (regs.dest.y + regs.line_count <= regs.dest.height) {
+            range = Tegra::Texture::CalculateBlockRowRange(bytes_per_pixel, width, regs.dest.y,
+                                                           regs.line_count,
+                                                           regs.dest.BlockHeight(),
+                                                           regs.dest.BlockDepth());
+            range.size = std::min(range.size, dst_size - range.offset);
+        }
+
         Tegra::Memory::GpuGuestMemoryScoped<u8,
                                             Tegra::Memory::GuestMemoryFlags::SafeReadCachedWrite>
-            tmp(memory_manager, address, dst_size, &tmp_buffer);
+            tmp(memory_manager, address + range.offset, range.size, &tmp_buffer);
 
-        Tegra::Texture::SwizzleSubrect(tmp, read_buffer, bytes_per_pixel, width, regs.dest.height,
-                                       regs.dest.depth, x_offset, regs.dest.y, x_elements,
+        Tegra::Texture::SwizzleSubrect(tmp, read_buffer, bytes_per_pixel, width,
+                                       regs.dest.height - range.first_line, regs.dest.depth,
+                                       x_offset, regs.dest.y - range.first_line, x_elements,
                                        regs.line_count, regs.dest.BlockHeight(),
                                        regs.dest.BlockDepth(), regs.line_length_in);
     }
@@ -5,6 +5,7 @@
 #include <optional>
 #include "common/assert.h"
 #include "common/bit_util.h"
+#include "common/literals.h"
 #include "common/scope_exit.h"
 #include "common/settings.h"
 #include "core/core.h"
@@ -13,6 +14,7 @@
 #include "video_core/engines/draw_manager.h"
 #include "video_core/engines/maxwell_3d.h"
 #include "video_core/gpu.h"
+#include "video_core/macro/macro_profiler.h"
 #include "video_core/memory_manager.h"
 #include "video_core/rasterizer_interface.h"
 #include "video_core/textures/texture.h"
@@ -260,20 +262,20 @@ u32 Maxwell3D::GetMaxCurrentVertices() {
 }
 
 size_t Maxwell3D::EstimateIndexBufferSize() {
-    GPUVAddr start_address = regs.index_buffer.StartAddress();
-    GPUVAddr end_address = regs.index_buffer.EndAddress();
-    static constexpr std::array<size_t, 3> max_sizes = {std::numeric_limits<u8>::max(),
-                                                        std::numeric_limits<u16>::max(),
-                                                        std::numeric_limits<u32>::max()};
+    // Indirect draws choose their index range on the GPU, so the whole index buffer range is
+    // bound instead of guessing how much of it they use. Only its mapped memory is considered,
+    // and limits far beyond any real index buffer are clamped.
+    using namespace Common::Literals;
+    static constexpr size_t MAX_INDEX_BUFFER_SIZE = 64_MiB;
+    const GPUVAddr start_address = regs.index_buffer.StartAddress();
+    const GPUVAddr end_address = regs.index_buffer.EndAddress();
+    if (end_address <= start_address) {
+        return 0;
+    }
+    const size_t limit_size =
+        std::min<size_t>(static_cast<size_t>(end_address - start_address), MAX_INDEX_BUFFER_SIZE);
     const size_t byte_size = regs.index_buffer.FormatSizeInBytes();
-    const size_t log2_byte_size = Common::Log2Ceil64(byte_size);
-    const size_t cap{GetMaxCurrentVertices() * 4 * byte_size};
-    const size_t lower_cap =
-        std::min<size_t>(static_cast<size_t>(end_address - start_address), cap);
-    return std::min<size_t>(
-        memory_manager.GetMemoryLayoutSize(start_address, byte_size * max_sizes[log2_byte_size]) /
-            byte_size,
-        lower_cap);
+    return memory_manager.GetMemoryLayoutSize(start_address, limit_size) / byte_size;
 }
 
 u32 Maxwell3D::ProcessShadowRam(u32 method, u32 argument) {
@@ -326,6 +328,21 @@ void Maxwell3D::ProcessDirtyRegisters(u32 method, u32 argument) {
     }
 }
 
+void Maxwell3D::ProcessDirtyRegisterRange(u32 method, const u32* arguments, u32 amount) {
+    u32* const registers = &regs.reg_array[method];
+    if (std::memcmp(registers, arguments, amount * sizeof(u32)) == 0) {
+        return;
+    }
+    for (const auto& table : dirty.tables) {
+        for (u32 i = 0; i < amount; ++i) {
+            if (registers[i] != arguments[i]) {
+                dirty.flags[table[method + i]] = true;
+            }
+        }
+    }
+    std::memcpy(registers, arguments, amount * sizeof(u32));
+}
+
 void Maxwell3D::ProcessMethodCall(u32 method, u32 argument, u32 nonshadow_argument,
                                   bool is_last_call) {
     switch (method) {
@@ -404,13 +421,20 @@ void Maxwell3D::CallMacroMethod(u32 method, const std::vector<u32>& parameters)
     const u32 entry =
         ((method - MacroRegistersStart) >> 1) % static_cast<u32>(macro_positions.size());
 
-    // Execute the current macro.
+    // Execute the current macro. Every register write of the macro goes through CallMethod, so
+    // draws can be held back until a write that could change their result.
+    draw_manager->BeginDrawCoalescing();
     macro_engine->Execute(macro_positions[entry], parameters);
+    draw_manager->EndDrawCoalescing();
 
     draw_manager->DrawDeferred();
 }
 
 void Maxwell3D::CallMethod(u32 method, u32 method_argument, bool is_last_call) {
+    if (macro_profiler) [[unlikely]] {
+        macro_profiler->RecordMethodWrite(method);
+    }
+
     // It is an error to write to a register other than the current macro's ARG register before
     // it has finished execution.
     if (executing_macro != 0) {
@@ -427,6 +451,9 @@ void Maxwell3D::CallMethod(u32 method, u32 method_argument, bool is_last_call) {
     ASSERT_MSG(method < Regs::NUM_REGS,
                "Invalid Maxwell3D register, increase the size of the Regs structure");
 
+    if (draw_manager->HasPendingDraw() && !DrawManager::IsDrawParameterMethod(method)) {
+        draw_manager->FlushPendingDraw();
+    }
     const u32 argument = ProcessShadowRam(method, method_argument);
     ProcessDirtyRegisters(method, argument);
     ProcessMethodCall(method, argument, method_argument, is_last_call);
@@ -465,6 +492,11 @@ void Maxwell3D::CallMultiMethod(u32 method, const u32* base_start, u32 amount,
         return;
     }
     default:
+        if (!execution_mask[method]) {
+            // Only the last value written to a register without side effects is observable
+            CallMethodRange(method, base_start + amount - 1, 1);
+            break;
+        }
         for (u32 i = 0; i < amount; i++) {
             CallMethod(method, base_start[i], methods_pending - i <= 1);
         }
@@ -472,6 +504,23 @@ void Maxwell3D::CallMultiMethod(u32 method, const u32* base_start, u32 amount,
     }
 }
 
+void Maxwell3D::CallMethodRange(u32 method, const u32* arguments, u32 amount) {
+    ASSERT_MSG(method + amount <= Regs::NUM_REGS,
+               "Invalid Maxwell3D register, increase the size of the Regs structure");
+
+    // Writes still pending in the sink have to land first to keep the submission order
+    ConsumeSink();
+
+    const auto control = shadow_state.shadow_ram_control;
+    if (control == Regs::ShadowRamControl::Track ||
+        control == Regs::ShadowRamControl::TrackWithFilter) {
+        std::memcpy(&shadow_state.reg_array[method], arguments, amount * sizeof(u32));
+    } else if (control == Regs::ShadowRamControl::Replay) {
+        arguments = &shadow_state.reg_array[method];
+    }
+    ProcessDirtyRegisterRange(method, arguments, amount);
+}
+
 void Maxwell3D::ProcessMacroUpload(u32 data) {
     macro_engine->AddCode(regs.load_mme.instruction_ptr++, data);
 }
@@ -28,6 +28,7 @@ class System;
 }
 
 namespace Tegra {
+class MacroProfiler;
 class MemoryManager;
 }
 
@@ -3078,6 +3079,9 @@ public:
     void CallMultiMethod(u32 method, const u32* base_start, u32 amount,
                          u32 methods_pending) override;
 
+    /// Write consecutive values to registers without side effects, bypassing the method sink.
+    void CallMethodRange(u32 method, const u32* arguments, u32 amount) override;
+
     bool ShouldExecute() const {
         return execute_on;
     }
@@ -3117,8 +3121,14 @@ public:
         return current_macro_dirty;
     }
 
+    /// Sets the profiler recording the methods written, nullptr disables recording
+    void SetMacroProfiler(MacroProfiler* profiler) {
+        macro_profiler = profiler;
+    }
+
     u32 GetMaxCurrentVertices();
 
+    /// Returns the number of indices in the bound index buffer range, for indirect draws
     size_t EstimateIndexBufferSize();
 
     /// Handles a write to the CLEAR_BUFFERS register.
@@ -3140,6 +3150,9 @@ private:
 
     void ProcessDirtyRegisters(u32 method, u32 argument);
 
+    /// Writes a range of registers, marking the dirty flags of the ones that changed.
+    void ProcessDirtyRegisterRange(u32 method, const u32* arguments, u32 amount);
+
     void ConsumeSinkImpl() override;
 
     void ProcessMethodCall(u32 method, u32 argument, u32 nonshadow_argument, bool is_last_call);
@@ -3202,6 +3215,9 @@ private:
     /// Interpreter for the macro codes uploaded to the GPU.
     std::unique_ptr<MacroEngine> macro_engine;
 
+    /// Profiler of the macro being executed, when macro profiling is enabled.
+    MacroProfiler* macro_profiler{};
+
     Upload::State upload_state;
 
     bool execute_on{true};
@@ -1,6 +1,9 @@
 // SPDX-FileCopyrightText: Copyright 2018 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+#include <cstring>
+
 #include "common/algorithm.h"
 #include "common/assert.h"
 #include "common/logging/log.h"
@@ -28,6 +31,28 @@ namespace Tegra::Engines {
 
 using namespace Texture;
 
+namespace {
+/// Copies between two lists of host spans covering the same number of bytes
+void CopySpans(const MemoryManager::HostSpans& src, const MemoryManager::HostSpans& dst) {
+    auto src_it = src.begin();
+    size_t src_offset = 0;
+    for (const std::span<u8> dst_span : dst) {
+        size_t dst_offset = 0;
+        while (dst_offset < dst_span.size()) {
+            const size_t amount =
+                std::min(src_it->size() - src_offset, dst_span.size() - dst_offset);
+            std::memcpy(dst_span.data() + dst_offset, src_it->data() + src_offset, amount);
+            dst_offset += amount;
+            src_offset += amount;
+            if (src_offset == src_it->size()) {
+                ++src_it;
+                src_offset = 0;
+            }
+        }
+    }
+}
+} // Anonymous namespace
+
 MaxwellDMA::MaxwellDMA(Core::System& system_, MemoryManager& memory_manager_)
     : system{system_}, memory_manager{memory_manager_} {
     execution_mask.reset();
@@ -153,7 +178,8 @@ void MaxwellDMA::Launch() {
                         convert_linear_2_blocklinear_addr(regs.offset_out + offset), 16);
                 }
             } else {
-                if (!accelerate.BufferCopy(regs.offset_in, regs.offset_out, regs.line_length_in)) {
+                if (!accelerate.BufferCopy(regs.offset_in, regs.offset_out, regs.line_length_in) &&
+                    !CopyPitchToPitchSpans()) {
                     Tegra::Memory::GpuGuestMemoryScoped<
                         u8, Tegra::Memory::GuestMemoryFlags::SafeReadCachedWrite>
                         tmp_write_buffer(memory_manager, regs.offset_in, regs.line_length_in,
@@ -167,6 +193,28 @@ void MaxwellDMA::Launch() {
     ReleaseSemaphore();
 }
 
+bool MaxwellDMA::CopyPitchToPitchSpans() {
+    const u64 length = regs.line_length_in;
+    const bool overlaps =
+        regs.offset_in < regs.offset_out + length && regs.offset_out < regs.offset_in + length;
+    if (overlaps) {
+        return false;
+    }
+    // Copy straight between the host pages, instead of gathering the source into a buffer
+    const auto src_spans = memory_manager.GetSpans(regs.offset_in, length);
+    if (!src_spans) {
+        return false;
+    }
+    const auto dst_spans = memory_manager.GetSpans(regs.offset_out, length);
+    if (!dst_spans) {
+        return false;
+    }
+    memory_manager.FlushRegion(regs.offset_in, length);
+    memory_manager.InvalidateRegion(regs.offset_out, length);
+    CopySpans(*src_spans, *dst_spans);
+    return true;
+}
+
 void MaxwellDMA::CopyBlockLinearToPitch() {
     UNIMPLEMENTED_IF(regs.launch_dma.remap_enable != 0);
 
@@ -253,6 +253,9 @@ private:
     /// registers.
     void Launch();
 
+    /// Copies a linear range through host memory spans, returns false when it can't be done
+    bool CopyPitchToPitchSpans();
+
     void CopyBlockLinearToPitch();
 
     void CopyPitchToBlockLinear();
@@ -3,9 +3,13 @@
 
 #include <algorithm>
 #include <cmath>
+#include <memory>
+#include <span>
 #include <vector>
 
+#include "common/div_ceil.h"
 #include "common/scratch_buffer.h"
+#include "common/task_scheduler.h"
 #include "video_core/engines/sw_blitter/blitter.h"
 #include "video_core/engines/sw_blitter/converter.h"
 #include "video_core/guest_memory.h"
@@ -28,12 +32,15 @@ namespace {
 
 constexpr size_t ir_components = 4;
 
+/// Number of pixels below which splitting the work across threads costs more than it saves
+constexpr size_t min_parallel_pixels = 256 * 256;
+
 void NearestNeighbor(std::span<const u8> input, std::span<u8> output, u32 src_width, u32 src_height,
-                     u32 dst_width, u32 dst_height, size_t bpp) {
+                     u32 dst_width, u32 dst_height, size_t bpp, u32 y_begin, u32 y_end) {
     const size_t dx_du = std::llround((static_cast<f64>(src_width) / dst_width) * (1ULL << 32));
     const size_t dy_dv = std::llround((static_cast<f64>(src_height) / dst_height) * (1ULL << 32));
-    size_t src_y = 0;
-    for (u32 y = 0; y < dst_height; y++) {
+    size_t src_y = y_begin * dy_dv;
+    for (u32 y = y_begin; y < y_end; y++) {
         size_t src_x = 0;
         for (u32 x = 0; x < dst_width; x++) {
             const size_t read_from = ((src_y * src_width + src_x) >> 32) * bpp;
@@ -47,11 +54,11 @@ void NearestNeighbor(std::span<const u8> input, std::span<u8> output, u32 src_wi
 }
 
 void NearestNeighborFast(std::span<const f32> input, std::span<f32> output, u32 src_width,
-                         u32 src_height, u32 dst_width, u32 dst_height) {
+                         u32 src_height, u32 dst_width, u32 dst_height, u32 y_begin, u32 y_end) {
     const size_t dx_du = std::llround((static_cast<f64>(src_width) / dst_width) * (1ULL << 32));
     const size_t dy_dv = std::llround((static_cast<f64>(src_height) / dst_height) * (1ULL << 32));
-    size_t src_y = 0;
-    for (u32 y = 0; y < dst_height; y++) {
+    size_t src_y = y_begin * dy_dv;
+    for (u32 y = y_begin; y < y_end; y++) {
         size_t src_x = 0;
         for (u32 x = 0; x < dst_width; x++) {
             const size_t read_from = ((src_y * src_width + src_x) >> 32) * ir_components;
@@ -65,7 +72,7 @@ void NearestNeighborFast(std::span<const f32> input, std::span<f32> output, u32
 }
 
 void Bilinear(std::span<const f32> input, std::span<f32> output, size_t src_width,
-              size_t src_height, size_t dst_width, size_t dst_height) {
+              size_t src_height, size_t dst_width, size_t dst_height, u32 y_begin, u32 y_end) {
     const auto bilinear_sample = [](std::span<const f32> x0_y0, std::span<const f32> x1_y0,
                                     std::span<const f32> x0_y1, std::span<const f32> x1_y1,
                                     f32 weight_x, f32 weight_y) {
@@ -81,7 +88,7 @@ void Bilinear(std::span<const f32> input, std::span<f32> output, size_t src_widt
         dst_width > 1 ? static_cast<f32>(src_width - 1) / static_cast<f32>(dst_width - 1) : 0.f;
     const f32 dy_dv =
         dst_height > 1 ? static_cast<f32>(src_height - 1) / static_cast<f32>(dst_height - 1) : 0.f;
-    for (u32 y = 0; y < dst_height; y++) {
+    for (u32 y = y_begin; y < y_end; y++) {
         for (u32 x = 0; x < dst_width; x++) {
             const f32 x_low = std::floor(static_cast<f32>(x) * dx_du);
             const f32 y_low = std::floor(static_cast<f32>(y) * dy_dv);
@@ -92,7 +99,7 @@ void Bilinear(std::span<const f32> input, std::span<f32> output, size_t src_widt
 
             const auto read_src = [&](f32 in_x, f32 in_y) {
                 const size_t read_from =
-                    ((static_cast<size_t>(in_x) * src_width + static_cast<size_t>(in_y)) >> 32) *
+                    (static_cast<size_t>(in_y) * src_width + static_cast<size_t>(in_x)) *
                     ir_components;
                 return std::span<const f32>(&input[read_from], ir_components);
             };
@@ -128,6 +135,28 @@ void ProcessPitchLinear(std::span<const u8> input, std::span<u8> output, size_t
 } // namespace
 
 struct SoftwareBlitEngine::BlitEngineImpl {
+    /// Calls func(row_begin, row_end) over the given rows, splitting large jobs across threads
+    template <typename Func>
+    void ForEachRowRange(u32 num_rows, size_t row_size, Func&& func) {
+        const size_t num_chunks = std::min<size_t>(num_rows, NumWorkers());
+        if (num_chunks <= 1 || num_rows * row_size < min_parallel_pixels) {
+            func(0U, num_rows);
+            return;
+        }
+        const u32 rows_per_chunk = static_cast<u32>(Common::DivCeil<size_t>(num_rows, num_chunks));
+        Common::TaskGroup workers;
+        for (u32 row = 0; row < num_rows; row += rows_per_chunk) {
+            const u32 row_end = std::min(row + rows_per_chunk, num_rows);
+            workers.Run([&func, row, row_end] { func(row, row_end); });
+        }
+        workers.Wait();
+    }
+
+    static size_t NumWorkers() {
+        static constexpr size_t max_workers = 8;
+        return std::min(Common::TaskScheduler::Instance().NumWorkers(), max_workers);
+    }
+
     Common::ScratchBuffer<u8> tmp_buffer;
     Common::ScratchBuffer<u8> src_buffer;
     Common::ScratchBuffer<u8> dst_buffer;
@@ -174,8 +203,10 @@ bool SoftwareBlitEngine::Blit(Fermi2D::Surface& src, Fermi2D::Surface& dst,
         src.format != dst.format || src_extent_x != dst_extent_x || src_extent_y != dst_extent_y;
 
     const auto conversion_phase_same_format = [&]() {
-        NearestNeighbor(impl->src_buffer, impl->dst_buffer, src_extent_x, src_extent_y,
-                        dst_extent_x, dst_extent_y, dst_bytes_per_pixel);
+        impl->ForEachRowRange(dst_extent_y, dst_extent_x, [&](u32 row_begin, u32 row_end) {
+            NearestNeighbor(impl->src_buffer, impl->dst_buffer, src_extent_x, src_extent_y,
+                            dst_extent_x, dst_extent_y, dst_bytes_per_pixel, row_begin, row_end);
+        });
     };
 
     const auto conversion_phase_ir = [&]() {
@@ -184,18 +215,39 @@ bool SoftwareBlitEngine::Blit(Fermi2D::Surface& src, Fermi2D::Surface& dst,
                                                   ir_components);
         impl->intermediate_dst.resize_destructive((dst_copy_size / dst_bytes_per_pixel) *
                                                   ir_components);
-        input_converter->ConvertTo(impl->src_buffer, impl->intermediate_src);
-
-        if (config.filter != Fermi2D::Filter::Bilinear) {
-            NearestNeighborFast(impl->intermediate_src, impl->intermediate_dst, src_extent_x,
-                                src_extent_y, dst_extent_x, dst_extent_y);
-        } else {
-            Bilinear(impl->intermediate_src, impl->intermediate_dst, src_extent_x, src_extent_y,
-                     dst_extent_x, dst_extent_y);
-        }
+        // Pixels are converted independently, so each phase can be split in rows
+        const size_t src_row_size = src_extent_x * src_bytes_per_pixel;
+        const size_t src_row_components = src_extent_x * ir_components;
+        impl->ForEachRowRange(src_extent_y, src_extent_x, [&](u32 row_begin, u32 row_end) {
+            const u32 num_rows = row_end - row_begin;
+            input_converter->ConvertTo(
+                std::span<const u8>(impl->src_buffer).subspan(row_begin * src_row_size,
+                                                              num_rows * src_row_size),
+                std::span<f32>(impl->intermediate_src)
+                    .subspan(row_begin * src_row_components, num_rows * src_row_components));
+        });
+
+        impl->ForEachRowRange(dst_extent_y, dst_extent_x, [&](u32 row_begin, u32 row_end) {
+            if (config.filter != Fermi2D::Filter::Bilinear) {
+                NearestNeighborFast(impl->intermediate_src, impl->intermediate_dst, src_extent_x,
+                                    src_extent_y, dst_extent_x, dst_extent_y, row_begin, row_end);
+            } else {
+                Bilinear(impl->intermediate_src, impl->intermediate_dst, src_extent_x,
+                         src_extent_y, dst_extent_x, dst_extent_y, row_begin, row_end);
+            }
+        });
 
         auto* output_converter = impl->converter_factory.GetFormatConverter(dst.format);
-        output_converter->ConvertFrom(impl->intermediate_dst, impl->dst_buffer);
+        const size_t dst_row_size = dst_extent_x * dst_bytes_per_pixel;
+        const size_t dst_row_components = dst_extent_x * ir_components;
+        impl->ForEachRowRange(dst_extent_y, dst_extent_x, [&](u32 row_begin, u32 row_end) {
+            const u32 num_rows = row_end - row_begin;
+            output_converter->ConvertFrom(
+                std::span<const f32>(impl->intermediate_dst)
+                    .subspan(row_begin * dst_row_components, num_rows * dst_row_components),
+                std::span<u8>(impl->dst_buffer)
+                    .subspan(row_begin * dst_row_size, num_rows * dst_row_size));
+        });
     };
 
     // Do actual Blit
@@ -1,8 +1,10 @@
 // SPDX-FileCopyrightText: Copyright 2022 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-3.0-or-later
 
+#include <algorithm>
 #include <array>
 #include <cmath>
+#include <cstring>
 #include <span>
 #include <unordered_map>
 
@@ -740,7 +742,7 @@ private:
                 out_component = Common::BitCast<f32>(value);
             } else if constexpr (component_sizes[which_component] == 16) {
                 static constexpr u32 sign_mask = 0x8000;
-                static constexpr u32 mantissa_mask = 0x8000;
+                static constexpr u32 mantissa_mask = 0x03ff;
                 out_component = Common::BitCast<f32>(((value & sign_mask) << 16) |
                                                      (((value & 0x7c00) + 0x1C000) << 13) |
                                                      ((value & mantissa_mask) << 13));
@@ -920,6 +922,112 @@ public:
     ~ConverterImpl() override = default;
 };
 
+/*
+ * Converters for the most common formats. They produce the same results as ConverterImpl, but
+ * they are written as plain loops over whole pixels so the compiler can vectorize them.
+ */
+
+template <class ConverterTraits>
+class Unorm8x4Converter final : public Converter {
+    static constexpr auto component_swizzle = ConverterTraits::component_swizzle;
+    static_assert(ConverterTraits::num_components == 4);
+    static_assert(std::ranges::all_of(ConverterTraits::component_sizes,
+                                      [](size_t size) { return size == 8; }));
+    static_assert(std::ranges::all_of(ConverterTraits::component_types, [](ComponentType type) {
+        return type == ComponentType::UNORM;
+    }));
+    static_assert(std::ranges::none_of(component_swizzle,
+                                       [](Swizzle swizzle) { return swizzle == Swizzle::None; }));
+
+    static constexpr size_t R = static_cast<size_t>(component_swizzle[0]);
+    static constexpr size_t G = static_cast<size_t>(component_swizzle[1]);
+    static constexpr size_t B = static_cast<size_t>(component_swizzle[2]);
+    static constexpr size_t A = static_cast<size_t>(component_swizzle[3]);
+
+public:
+    void ConvertTo(std::span<const u8> input, std::span<f32> output) override {
+        const size_t num_pixels = output.size() / 4;
+        const u8* const src = input.data();
+        f32* const dst = output.data();
+        for (size_t pixel = 0; pixel < num_pixels; pixel++) {
+            const u8* const in = src + pixel * 4;
+            f32* const out = dst + pixel * 4;
+            out[R] = static_cast<f32>(in[0]) / 255.0f;
+            out[G] = static_cast<f32>(in[1]) / 255.0f;
+            out[B] = static_cast<f32>(in[2]) / 255.0f;
+            out[A] = static_cast<f32>(in[3]) / 255.0f;
+        }
+    }
+
+    void ConvertFrom(std::span<const f32> input, std::span<u8> output) override {
+        const size_t num_pixels = output.size() / 4;
+        const f32* const src = input.data();
+        u8* const dst = output.data();
+        for (size_t pixel = 0; pixel < num_pixels; pixel++) {
+            const f32* const in = src + pixel * 4;
+            u8* const out = dst + pixel * 4;
+            out[0] = static_cast<u8>(static_cast<u32>(in[R] * 255.0f));
+            out[1] = static_cast<u8>(static_cast<u32>(in[G] * 255.0f));
+            out[2] = static_cast<u8>(static_cast<u32>(in[B] * 255.0f));
+            out[3] = static_cast<u8>(static_cast<u32>(in[A] * 255.0f));
+        }
+    }
+};
+
+class R16G16B16A16FloatConverter final : public Converter {
+public:
+    void ConvertTo(std::span<const u8> input, std::span<f32> output) override {
+        const size_t num_values = output.size();
+        const u8* const src = input.data();
+        f32* const dst = output.data();
+        for (size_t i = 0; i < num_values; i++) {
+            u16 half;
+            std::memcpy(&half, src + i * sizeof(u16), sizeof(u16));
+            const u32 value = half;
+            dst[i] = Common::BitCast<f32>(((value & 0x8000) << 16) |
+                                          (((value & 0x7c00) + 0x1C000) << 13) |
+                                          ((value & 0x03ff) << 13));
+        }
+    }
+
+    void ConvertFrom(std::span<const f32> input, std::span<u8> output) override {
+        const size_t num_values = output.size() / sizeof(u16);
+        const f32* const src = input.data();
+        u8* const dst = output.data();
+        for (size_t i = 0; i < num_values; i++) {
+            const u32 word = Common::BitCast<u32>(src[i]);
+            const u32 exponent = (((word & 0x7f800000) - 0x38000000) >> 13) & 0x7c00;
+            const u16 half =
+                static_cast<u16>(((word >> 16) & 0x8000) | exponent | ((word >> 13) & 0x03ff));
+            std::memcpy(dst + i * sizeof(u16), &half, sizeof(u16));
+        }
+    }
+};
+
+class R32FloatConverter final : public Converter {
+public:
+    void ConvertTo(std::span<const u8> input, std::span<f32> output) override {
+        const size_t num_pixels = output.size() / 4;
+        const u8* const src = input.data();
+        f32* const dst = output.data();
+        for (size_t pixel = 0; pixel < num_pixels; pixel++) {
+            std::memcpy(&dst[pixel * 4], src + pixel * sizeof(f32), sizeof(f32));
+            dst[pixel * 4 + 1] = 0.0f;
+            dst[pixel * 4 + 2] = 0.0f;
+            dst[pixel * 4 + 3] = 0.0f;
+        }
+    }
+
+    void ConvertFrom(std::span<const f32> input, std::span<u8> output) override {
+        const size_t num_pixels = output.size() / sizeof(f32);
+        const f32* const src = input.data();
+        u8* const dst = output.data();
+        for (size_t pixel = 0; pixel < num_pixels; pixel++) {
+            std::memcpy(dst + pixel * sizeof(f32), &src[pixel * 4], sizeof(f32));
+        }
+    }
+};
+
 struct ConverterFactory::ConverterFactoryImpl {
     std::unordered_map<RenderTargetFormat, std::unique_ptr<Converter>> converters_cache;
 };
@@ -1005,7 +1113,7 @@ Converter* ConverterFactory::BuildConverter(RenderTargetFormat format) {
         break;
     case RenderTargetFormat::R16G16B16A16_FLOAT:
         return impl->converters_cache
-            .emplace(format, std::make_unique<ConverterImpl<R16G16B16A16_FLOATTraits>>())
+            .emplace(format, std::make_unique<R16G16B16A16FloatConverter>())
             .first->second.get();
         break;
     case RenderTargetFormat::R32G32_FLOAT:
@@ -1030,7 +1138,7 @@ Converter* ConverterFactory::BuildConverter(RenderTargetFormat format) {
         break;
     case RenderTargetFormat::A8R8G8B8_UNORM:
         return impl->converters_cache
-            .emplace(format, std::make_unique<ConverterImpl<A8R8G8B8_UNORMTraits>>())
+            .emplace(format, std::make_unique<Unorm8x4Converter<A8R8G8B8_UNORMTraits>>())
             .first->second.get();
         break;
     case RenderTargetFormat::A8R8G8B8_SRGB:
@@ -1055,7 +1163,7 @@ Converter* ConverterFactory::BuildConverter(RenderTargetFormat format) {
         break;
     case RenderTargetFormat::A8B8G8R8_UNORM:
         return impl->converters_cache
-            .emplace(format, std::make_unique<ConverterImpl<A8B8G8R8_UNORMTraits>>())
+            .emplace(format, std::make_unique<Unorm8x4Converter<A8B8G8R8_UNORMTraits>>())
             .first->second.get();
         break;
     case RenderTargetFormat::A8B8G8R8_SRGB:
@@ -1120,7 +1228,7 @@ Converter* ConverterFactory::BuildConverter(RenderTargetFormat format) {
         break;
     case RenderTargetFormat::R32_FLOAT:
         return impl->converters_cache
-            .emplace(format, std::make_unique<ConverterImpl<R32_FLOATTraits>>())
+            .emplace(format, std::make_unique<R32FloatConverter>())
             .first->second.get();
         break;
     case RenderTargetFormat::X8R8G8B8_UNORM:
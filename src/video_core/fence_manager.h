@@ -204,8 +204,11 @@ private:
         Common::SetCurrentThreadName(name.c_str());
         Common::SetCurrentThreadPriority(Common::ThreadPriority::High);
 
-        TFence current_fence;
-        std::deque<std::function<void()>> current_operations;
+        // Take every queued fence at once, so signaling many fences in a row doesn't wake the
+        // thread for each one. Waiting for the first unsignaled fence refreshes the known GPU
+        // tick, releasing the fences it already passed together without waiting on them.
+        std::queue<TFence> current_fences;
+        std::deque<std::deque<std::function<void()>>> current_operations;
         while (!stop_token.stop_requested()) {
             {
                 std::unique_lock lock(guard);
@@ -213,21 +216,24 @@ private:
                 if (stop_token.stop_requested()) [[unlikely]] {
                     return;
                 }
-                current_fence = std::move(fences.front());
-                current_operations = std::move(pending_operations.front());
-                fences.pop();
-                pending_operations.pop_front();
+                std::swap(current_fences, fences);
+                std::swap(current_operations, pending_operations);
             }
-            if (!current_fence->IsStubbed()) {
-                WaitFence(current_fence);
-            }
-            PopAsyncFlushes();
-            for (auto& operation : current_operations) {
-                operation();
-            }
-            {
-                std::unique_lock lock(ring_guard);
-                delayed_destruction_ring.Push(std::move(current_fence));
+            while (!current_fences.empty()) {
+                TFence& current_fence = current_fences.front();
+                if (!current_fence->IsStubbed() && !IsFenceSignaled(current_fence)) {
+                    WaitFence(current_fence);
+                }
+                PopAsyncFlushes();
+                for (auto& operation : current_operations.front()) {
+                    operation();
+                }
+                current_operations.pop_front();
+                {
+                    std::unique_lock lock(ring_guard);
+                    delayed_destruction_ring.Push(std::move(current_fence));
+                }
+                current_fences.pop();
             }
         }
     }
@@ -33,14 +33,16 @@
 #include "video_core/memory_manager.h"
 #include "video_core/renderer_base.h"
 #include "video_core/shader_notify.h"
+#include "video_core/video_frame_surface.h"
 
 namespace Tegra {
 
 struct GPU::Impl {
     explicit Impl(GPU& gpu_, Core::System& system_, bool is_async_, bool use_nvdec_)
-        : gpu{gpu_}, system{system_}, host1x{system.Host1x()}, use_nvdec{use_nvdec_},
-          shader_notify{std::make_unique<VideoCore::ShaderNotify>()}, is_async{is_async_},
-          gpu_thread{system_, is_async_}, scheduler{std::make_unique<Control::Scheduler>(gpu)} {}
+        : gpu{gpu_}, system{system_}, host1x{system.Host1x()},
+          shader_notify{std::make_unique<VideoCore::ShaderNotify>()}, use_nvdec{use_nvdec_},
+          is_async{is_async_}, gpu_thread{system_, is_async_},
+          scheduler{std::make_unique<Control::Scheduler>(gpu)} {}
 
     ~Impl() = default;
 
@@ -218,6 +220,10 @@ struct GPU::Impl {
         system.GetPerfStats().EndGameFrame();
     }
 
+    void RendererPresentNotify(std::chrono::nanoseconds latency) {
+        system.GetPerfStats().RecordPresentLatency(latency);
+    }
+
     /// Performs any additional setup necessary in order to begin GPU emulation.
     /// This can be used to launch any necessary threads and register any necessary
     /// core timing events.
@@ -250,6 +256,10 @@ struct GPU::Impl {
         gpu_thread.SubmitList(channel, std::move(entries));
     }
 
+    void PushGPUEntries(s32 channel, std::span<Tegra::CommandList> entries) {
+        gpu_thread.SubmitLists(channel, entries);
+    }
+
     /// Push GPU command buffer entries to be processed
     void PushCommandBuffer(u32 id, Tegra::ChCommandHeaderList& entries) {
         if (!use_nvdec) {
@@ -257,7 +267,7 @@ struct GPU::Impl {
         }
 
         if (!cdma_pushers.contains(id)) {
-            cdma_pushers.insert_or_assign(id, std::make_unique<Tegra::CDmaPusher>(host1x));
+            cdma_pushers.insert_or_assign(id, std::make_unique<Tegra::CDmaPusher>(gpu, host1x));
         }
 
         // SubmitCommandBuffer would make the nvdec operations async, this is not currently working
@@ -358,18 +368,36 @@ struct GPU::Impl {
         return out;
     }
 
+    bool CanAccelerateVideoFrame(const VideoCore::VideoFrameSurface& surface) {
+        return rasterizer->CanAccelerateVideoFrame(surface);
+    }
+
+    void AccelerateVideoFrame(const VideoCore::VideoFrameSurface& surface,
+                              Common::ScratchBuffer<u8>&& pixels) {
+        // Sync operations are copyable functions, so they share the frame's pixels
+        auto frame = std::make_shared<Common::ScratchBuffer<u8>>(std::move(pixels));
+        [[maybe_unused]] const u64 fence = RequestSyncOperation([this, surface, frame] {
+            if (!rasterizer->AccelerateVideoFrame(surface, {frame->data(), frame->size()})) {
+                LOG_DEBUG(HW_GPU, "Image of video frame surface 0x{:X} removed before writing",
+                          surface.address);
+            }
+        });
+        gpu_thread.TickGPU();
+    }
+
     GPU& gpu;
     Core::System& system;
     Host1x::Host1x& host1x;
 
+    /// Shader build notifier, outlives the renderer as its shader workers report to it
+    std::unique_ptr<VideoCore::ShaderNotify> shader_notify;
+
     std::map<u32, std::unique_ptr<Tegra::CDmaPusher>> cdma_pushers;
     std::unique_ptr<VideoCore::RendererBase> renderer;
     VideoCore::RasterizerInterface* rasterizer = nullptr;
     const bool use_nvdec;
 
     s32 new_channel_id{1};
-    /// Shader build notifier
-    std::unique_ptr<VideoCore::ShaderNotify> shader_notify;
     /// When true, we are about to shut down emulation session, so terminate outstanding tasks
     std::atomic_bool shutting_down{};
 
@@ -520,6 +548,15 @@ std::vector<u8> GPU::GetAppletCaptureBuffer() {
     return impl->GetAppletCaptureBuffer();
 }
 
+bool GPU::CanAccelerateVideoFrame(const VideoCore::VideoFrameSurface& surface) {
+    return impl->CanAccelerateVideoFrame(surface);
+}
+
+void GPU::AccelerateVideoFrame(const VideoCore::VideoFrameSurface& surface,
+                               Common::ScratchBuffer<u8>&& pixels) {
+    impl->AccelerateVideoFrame(surface, std::move(pixels));
+}
+
 u64 GPU::GetTicks() const {
     return impl->GetTicks();
 }
@@ -536,6 +573,10 @@ void GPU::RendererFrameEndNotify() {
     impl->RendererFrameEndNotify();
 }
 
+void GPU::RendererPresentNotify(std::chrono::nanoseconds latency) {
+    impl->RendererPresentNotify(latency);
+}
+
 void GPU::Start() {
     impl->Start();
 }
@@ -556,6 +597,10 @@ void GPU::PushGPUEntries(s32 channel, Tegra::CommandList&& entries) {
     impl->PushGPUEntries(channel, std::move(entries));
 }
 
+void GPU::PushGPUEntries(s32 channel, std::span<Tegra::CommandList> entries) {
+    impl->PushGPUEntries(channel, entries);
+}
+
 void GPU::PushCommandBuffer(u32 id, Tegra::ChCommandHeaderList& entries) {
     impl->PushCommandBuffer(id, entries);
 }
@@ -3,10 +3,13 @@
 
 #pragma once
 
+#include <chrono>
 #include <memory>
+#include <span>
 
 #include "common/bit_field.h"
 #include "common/common_types.h"
+#include "common/scratch_buffer.h"
 #include "core/hle/service/nvdrv/nvdata.h"
 #include "video_core/cdma_pusher.h"
 #include "video_core/framebuffer_config.h"
@@ -19,6 +22,7 @@ class System;
 namespace VideoCore {
 class RendererBase;
 class ShaderNotify;
+struct VideoFrameSurface;
 } // namespace VideoCore
 
 namespace Tegra {
@@ -212,11 +216,22 @@ public:
 
     void RendererFrameEndNotify();
 
+    /// Reports the walltime between the renderer starting a frame and presenting it
+    void RendererPresentNotify(std::chrono::nanoseconds latency);
+
     void RequestComposite(std::vector<Tegra::FramebufferConfig>&& layers,
                           std::vector<Service::Nvidia::NvFence>&& fences);
 
     std::vector<u8> GetAppletCaptureBuffer();
 
+    /// Returns true when a video frame written to the surface can be written to its cached image.
+    [[nodiscard]] bool CanAccelerateVideoFrame(const VideoCore::VideoFrameSurface& surface);
+
+    /// Writes the linear pixels of a video frame to the cached image of its surface, from the GPU
+    /// thread ahead of any command list submitted later.
+    void AccelerateVideoFrame(const VideoCore::VideoFrameSurface& surface,
+                              Common::ScratchBuffer<u8>&& pixels);
+
     /// Performs any additional setup necessary in order to begin GPU emulation.
     /// This can be used to launch any necessary threads and register any necessary
     /// core timing events.
@@ -234,6 +249,9 @@ public:
     /// Push GPU command entries to be processed
     void PushGPUEntries(s32 channel, Tegra::CommandList&& entries);
 
+    /// Push several GPU command lists of a channel at once, they are consumed
+    void PushGPUEntries(s32 channel, std::span<Tegra::CommandList> entries);
+
     /// Push GPU command buffer entries to be processed
     void PushCommandBuffer(u32 id, Tegra::ChCommandHeaderList& entries);
 
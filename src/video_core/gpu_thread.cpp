@@ -1,11 +1,18 @@
 // SPDX-FileCopyrightText: Copyright 2019 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+#include <chrono>
+#include <span>
+#include <vector>
+
 #include "common/assert.h"
 #include "common/microprofile.h"
+#include "common/perf_metrics.h"
 #include "common/scope_exit.h"
 #include "common/settings.h"
 #include "common/thread.h"
+#include "common/tracing.h"
 #include "core/core.h"
 #include "core/frontend/graphics_context.h"
 #include "video_core/control/scheduler.h"
@@ -16,6 +23,9 @@
 
 namespace VideoCommon::GPUThread {
 
+/// Maximum number of commands the GPU thread takes from the queue at once
+constexpr size_t MAX_COMMAND_BATCH = 64;
+
 /// Runs the GPU thread
 static void RunThread(std::stop_token stop_token, Core::System& system,
                       VideoCore::RendererBase& renderer, Core::Frontend::GraphicsContext& context,
@@ -28,36 +38,79 @@ static void RunThread(std::stop_token stop_token, Core::System& system,
 
     Common::SetCurrentThreadName(name.c_str());
     Common::SetCurrentThreadPriority(Common::ThreadPriority::Critical);
+    Common::SetCurrentThreadRole(Common::ThreadRole::GpuCommands);
     system.RegisterHostThread();
 
     auto current_context = context.Acquire();
     VideoCore::RasterizerInterface* const rasterizer = renderer.ReadRasterizer();
 
-    CommandDataContainer next;
+    std::vector<CommandDataContainer> batch(MAX_COMMAND_BATCH);
+
+    // Consecutive invalidations of adjacent or overlapping ranges are merged into one
+    DAddr invalidate_begin{};
+    DAddr invalidate_end{};
+    const auto flush_invalidation = [&] {
+        if (invalidate_begin != invalidate_end) {
+            rasterizer->OnCacheInvalidation(invalidate_begin, invalidate_end - invalidate_begin);
+            invalidate_begin = invalidate_end = 0;
+        }
+    };
 
     while (!stop_token.stop_requested()) {
-        state.queue.PopWait(next, stop_token);
+        const size_t num_commands = state.queue.PopWaitMany(batch, stop_token);
         if (stop_token.stop_requested()) {
             break;
         }
-        if (auto* submit_list = std::get_if<SubmitListCommand>(&next.data)) {
-            scheduler.Push(submit_list->channel, std::move(submit_list->entries));
-        } else if (std::holds_alternative<GPUTickCommand>(next.data)) {
-            system.GPU().TickWork();
-        } else if (const auto* flush = std::get_if<FlushRegionCommand>(&next.data)) {
-            rasterizer->FlushRegion(flush->addr, flush->size);
-        } else if (const auto* invalidate = std::get_if<InvalidateRegionCommand>(&next.data)) {
-            rasterizer->OnCacheInvalidation(invalidate->addr, invalidate->size);
-        } else {
-            ASSERT(false);
-        }
-        state.signaled_fence.store(next.fence);
-        if (next.block) {
-            // We have to lock the write_lock to ensure that the condition_variable wait not get a
-            // race between the check and the lock itself.
-            std::scoped_lock lk{state.write_lock};
-            state.cv.notify_all();
+        Common::Tracing::Counter("GPU commands per batch", static_cast<s64>(num_commands));
+        const auto batch_begin = std::chrono::steady_clock::now();
+        for (CommandDataContainer& next : std::span(batch).first(num_commands)) {
+            if (const auto* invalidate = std::get_if<InvalidateRegionCommand>(&next.data)) {
+                const DAddr begin = invalidate->addr;
+                const DAddr end = invalidate->addr + invalidate->size;
+                if (invalidate_begin != invalidate_end && begin <= invalidate_end &&
+                    end >= invalidate_begin) {
+                    invalidate_begin = std::min(invalidate_begin, begin);
+                    invalidate_end = std::max(invalidate_end, end);
+                } else {
+                    flush_invalidation();
+                    invalidate_begin = begin;
+                    invalidate_end = end;
+                }
+            } else {
+                flush_invalidation();
+                if (auto* submit_list = std::get_if<SubmitListCommand>(&next.data)) {
+                    TRACE_ZONE("GPU command list");
+                    Common::Tracing::FlowEnd("GPU submit", next.fence);
+                    scheduler.Push(submit_list->channel, std::move(submit_list->entries));
+                } else if (std::holds_alternative<GPUTickCommand>(next.data)) {
+                    TRACE_ZONE("GPU tick");
+                    system.GPU().TickWork();
+                } else if (const auto* flush = std::get_if<FlushRegionCommand>(&next.data)) {
+                    TRACE_ZONE("GPU flush");
+                    rasterizer->FlushRegion(flush->addr, flush->size);
+                } else {
+                    ASSERT(false);
+                }
+            }
+            if (next.block) {
+                // Wake up blocked callers as soon as their command executed, not with the batch
+                flush_invalidation();
+                state.signaled_fence.store(next.fence);
+
+                // We have to lock the write_lock to ensure that the condition_variable wait not get
+                // a race between the check and the lock itself.
+                std::scoped_lock lk{state.write_lock};
+                state.cv.notify_all();
+            }
         }
+        flush_invalidation();
+        state.signaled_fence.store(batch[num_commands - 1].fence);
+
+        const auto busy_time = std::chrono::steady_clock::now() - batch_begin;
+        Common::PerfMetrics::Add(
+            Common::PerfMetrics::Counter::GpuThreadBusyNs,
+            static_cast<u64>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(busy_time).count()));
     }
 }
 
@@ -78,6 +131,28 @@ void ThreadManager::SubmitList(s32 channel, Tegra::CommandList&& entries) {
     PushCommand(SubmitListCommand(channel, std::move(entries)));
 }
 
+void ThreadManager::SubmitLists(s32 channel, std::span<Tegra::CommandList> entries) {
+    if (entries.empty()) {
+        return;
+    }
+    TRACE_ZONE("GPU submit");
+    // The lists are queued back to back, so the GPU thread pops them in the same batch
+    std::unique_lock lk(state.write_lock);
+    u64 fence{};
+    for (Tegra::CommandList& list : entries) {
+        fence = ++state.last_fence;
+        Common::Tracing::FlowBegin("GPU submit", fence);
+        const bool block = !is_async && &list == &entries.back();
+        state.queue.EmplaceWait(SubmitListCommand(channel, std::move(list)), fence, block);
+    }
+    if (!is_async) {
+        // In synchronous GPU mode, block the caller until the last list has executed
+        Common::CondvarWait(state.cv, lk, thread.get_stop_token(), [this, fence] {
+            return fence <= state.signaled_fence.load(std::memory_order_relaxed);
+        });
+    }
+}
+
 void ThreadManager::FlushRegion(DAddr addr, u64 size) {
     if (!is_async) {
         // Always flush with synchronous GPU mode
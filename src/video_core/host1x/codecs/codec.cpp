@@ -59,13 +59,26 @@ void Codec::Decode() {
         }
     }();
 
+    // The assembled bitstream is reused by the next frame, copy it for the decode worker.
+    decode_worker.QueueWork([this, packet = std::vector<u8>(packet_data.begin(), packet_data.end()),
+                             configuration_size, vp9_hidden_frame] {
+        DecodePacket(packet, configuration_size, vp9_hidden_frame);
+    });
+}
+
+void Codec::SignalWhenDecoded(Common::UniqueFunction<void> callback) {
+    decode_worker.QueueWork(std::move(callback));
+}
+
+void Codec::DecodePacket(std::span<const u8> packet_data, size_t configuration_size,
+                         bool hidden_frame) {
     // Send assembled bitstream to decoder.
     if (!decode_api.SendPacket(packet_data, configuration_size)) {
         return;
     }
 
     // Only receive/store visible frames.
-    if (vp9_hidden_frame) {
+    if (hidden_frame) {
         return;
     }
 
@@ -79,6 +92,8 @@ void Codec::Decode() {
 }
 
 std::unique_ptr<FFmpeg::Frame> Codec::GetCurrentFrame() {
+    decode_worker.WaitForRequests();
+
     // Sometimes VIC will request more frames than have been decoded.
     // in this case, return a blank frame and don't overwrite previous data.
     if (frames.empty()) {
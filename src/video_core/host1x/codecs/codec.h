@@ -7,7 +7,10 @@
 #include <optional>
 #include <string_view>
 #include <queue>
+#include <vector>
 #include "common/common_types.h"
+#include "common/thread_worker.h"
+#include "common/unique_function.h"
 #include "video_core/host1x/ffmpeg/ffmpeg.h"
 #include "video_core/host1x/nvdec_common.h"
 
@@ -34,10 +37,13 @@ public:
     /// Sets NVDEC video stream codec
     void SetTargetCodec(Host1x::NvdecCommon::VideoCodec codec);
 
-    /// Call decoders to construct headers, decode AVFrame with ffmpeg
+    /// Call decoders to construct headers, queue the frame to be decoded with ffmpeg
     void Decode();
 
-    /// Returns next decoded frame
+    /// Runs the callback once every frame queued before it has been decoded
+    void SignalWhenDecoded(Common::UniqueFunction<void> callback);
+
+    /// Returns next decoded frame, waiting for the queued frames to be decoded
     [[nodiscard]] std::unique_ptr<FFmpeg::Frame> GetCurrentFrame();
 
     /// Returns the value of current_codec
@@ -47,6 +53,10 @@ public:
     [[nodiscard]] std::string_view GetCurrentCodecName() const;
 
 private:
+    /// Decode an assembled bitstream and receive its frames, on the decode worker
+    void DecodePacket(std::span<const u8> packet_data, size_t configuration_size,
+                      bool hidden_frame);
+
     bool initialized{};
     Host1x::NvdecCommon::VideoCodec current_codec{Host1x::NvdecCommon::VideoCodec::None};
     FFmpeg::DecodeApi decode_api;
@@ -58,6 +68,9 @@ private:
     std::unique_ptr<Decoder::VP9> vp9_decoder;
 
     std::queue<std::unique_ptr<FFmpeg::Frame>> frames{};
+
+    /// Decodes the queued bitstreams in submission order, so submits don't wait on ffmpeg
+    Common::ThreadWorker decode_worker{1, "NvdecDecoder"};
 };
 
 } // namespace Tegra
@@ -8,6 +8,7 @@
 #include "video_core/host1x/ffmpeg/ffmpeg.h"
 
 extern "C" {
+#include <libavutil/imgutils.h>
 #ifdef LIBVA_FOUND
 // for querying VAAPI driver information
 #include <libavutil/hwcontext_vaapi.h>
@@ -193,6 +194,7 @@ DecoderContext::DecoderContext(const Decoder& decoder) {
 DecoderContext::~DecoderContext() {
     av_buffer_unref(&m_codec_context->hw_device_ctx);
     avcodec_free_context(&m_codec_context);
+    av_buffer_pool_uninit(&m_transfer_pool);
 }
 
 void DecoderContext::InitializeHardwareDecoder(const HardwareContext& context,
@@ -251,7 +253,12 @@ std::unique_ptr<Frame> DecoderContext::ReceiveFrame(bool* out_is_interlaced) {
             return {};
         }
 
-        dst_frame->SetFormat(PreferredGpuFormat);
+        // Download into a pooled buffer, rather than allocating and faulting in new planes for
+        // every frame.
+        if (!AllocateTransferFrame(*dst_frame, intermediate_frame.GetWidth(),
+                                   intermediate_frame.GetHeight())) {
+            return {};
+        }
         if (const int ret =
                 av_hwframe_transfer_data(dst_frame->GetFrame(), intermediate_frame.GetFrame(), 0);
             ret < 0) {
@@ -268,6 +275,47 @@ std::unique_ptr<Frame> DecoderContext::ReceiveFrame(bool* out_is_interlaced) {
     return dst_frame;
 }
 
+bool DecoderContext::AllocateTransferFrame(Frame& frame, int width, int height) {
+    constexpr int Alignment = 32;
+    const int size = av_image_get_buffer_size(PreferredGpuFormat, width, height, Alignment);
+    if (size < 0) {
+        LOG_ERROR(HW_GPU, "av_image_get_buffer_size error: {}", AVError(size));
+        return false;
+    }
+
+    // Frames are downloaded at the same size for the whole stream, so the pool only needs to be
+    // recreated when it changes. Buffers still in use keep the old pool alive until released.
+    if (!m_transfer_pool || m_transfer_pool_size != size) {
+        av_buffer_pool_uninit(&m_transfer_pool);
+        m_transfer_pool = av_buffer_pool_init(size + AV_INPUT_BUFFER_PADDING_SIZE, nullptr);
+        m_transfer_pool_size = size;
+        if (!m_transfer_pool) {
+            LOG_ERROR(HW_GPU, "av_buffer_pool_init failed");
+            return false;
+        }
+    }
+
+    AVFrame* const av_frame = frame.GetFrame();
+    av_frame->buf[0] = av_buffer_pool_get(m_transfer_pool);
+    if (!av_frame->buf[0]) {
+        LOG_ERROR(HW_GPU, "av_buffer_pool_get failed");
+        return false;
+    }
+
+    av_frame->format = PreferredGpuFormat;
+    av_frame->width = width;
+    av_frame->height = height;
+    if (const int ret = av_image_fill_arrays(av_frame->data, av_frame->linesize,
+                                             av_frame->buf[0]->data, PreferredGpuFormat, width,
+                                             height, Alignment);
+        ret < 0) {
+        LOG_ERROR(HW_GPU, "av_image_fill_arrays error: {}", AVError(ret));
+        return false;
+    }
+
+    return true;
+}
+
 DeinterlaceFilter::DeinterlaceFilter(const Frame& frame) {
     const AVFilter* buffer_src = avfilter_get_by_name("buffer");
     const AVFilter* buffer_sink = avfilter_get_by_name("buffersink");
@@ -167,7 +167,11 @@ public:
     }
 
 private:
+    bool AllocateTransferFrame(Frame& frame, int width, int height);
+
     AVCodecContext* m_codec_context{};
+    AVBufferPool* m_transfer_pool{};
+    int m_transfer_pool_size{};
 };
 
 // Wraps an AVFilterGraph.
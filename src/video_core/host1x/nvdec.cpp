@@ -28,6 +28,10 @@ void Nvdec::ProcessMethod(u32 method, u32 argument) {
     }
 }
 
+void Nvdec::SignalWhenDecoded(Common::UniqueFunction<void> callback) {
+    codec->SignalWhenDecoded(std::move(callback));
+}
+
 std::unique_ptr<FFmpeg::Frame> Nvdec::GetFrame() {
     return codec->GetCurrentFrame();
 }
@@ -6,6 +6,7 @@
 #include <memory>
 #include <vector>
 #include "common/common_types.h"
+#include "common/unique_function.h"
 #include "video_core/host1x/codecs/codec.h"
 
 namespace Tegra {
@@ -22,6 +23,9 @@ public:
     /// Writes the method into the state, Invoke Execute() if encountered
     void ProcessMethod(u32 method, u32 argument);
 
+    /// Runs the callback once every frame executed before it has been decoded
+    void SignalWhenDecoded(Common::UniqueFunction<void> callback);
+
     /// Return most recently decoded frame
     [[nodiscard]] std::unique_ptr<FFmpeg::Frame> GetFrame();
 
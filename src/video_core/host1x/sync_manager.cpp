@@ -13,27 +13,35 @@ SyncptIncrManager::SyncptIncrManager(Host1x& host1x_) : host1x(host1x_) {}
 SyncptIncrManager::~SyncptIncrManager() = default;
 
 void SyncptIncrManager::Increment(u32 id) {
+    std::scoped_lock lock{increment_lock};
     increments.emplace_back(0, 0, id, true);
-    IncrementAllDone();
+    IncrementAllDoneLocked();
 }
 
 u32 SyncptIncrManager::IncrementWhenDone(u32 class_id, u32 id) {
+    std::scoped_lock lock{increment_lock};
     const u32 handle = current_id++;
     increments.emplace_back(handle, class_id, id);
     return handle;
 }
 
 void SyncptIncrManager::SignalDone(u32 handle) {
+    std::scoped_lock lock{increment_lock};
     const auto done_incr =
         std::find_if(increments.begin(), increments.end(),
                      [handle](const SyncptIncr& incr) { return incr.id == handle; });
     if (done_incr != increments.cend()) {
         done_incr->complete = true;
     }
-    IncrementAllDone();
+    IncrementAllDoneLocked();
 }
 
 void SyncptIncrManager::IncrementAllDone() {
+    std::scoped_lock lock{increment_lock};
+    IncrementAllDoneLocked();
+}
+
+void SyncptIncrManager::IncrementAllDoneLocked() {
     std::size_t done_count = 0;
     for (; done_count < increments.size(); ++done_count) {
         if (!increments[done_count].complete) {
@@ -11,7 +11,7 @@ namespace Host1x {
 MICROPROFILE_DEFINE(GPU_wait, "GPU", "Wait for the GPU", MP_RGB(128, 128, 192));
 
 SyncpointManager::ActionHandle SyncpointManager::RegisterAction(
-    std::atomic<u32>& syncpoint, std::list<RegisteredAction>& action_storage, u32 expected_value,
+    std::atomic<u32>& syncpoint, ActionStorage& action_storage, u32 expected_value,
     std::function<void()>&& action) {
     if (syncpoint.load(std::memory_order_acquire) >= expected_value) {
         action();
@@ -23,30 +23,17 @@ SyncpointManager::ActionHandle SyncpointManager::RegisterAction(
         action();
         return {};
     }
-    auto it = action_storage.begin();
-    while (it != action_storage.end()) {
-        if (it->expected_value >= expected_value) {
-            break;
-        }
-        ++it;
-    }
-    return action_storage.emplace(it, expected_value, std::move(action));
+    const ActionHandle handle{expected_value, next_action_id++};
+    action_storage.emplace(handle, std::move(action));
+    return handle;
 }
 
-void SyncpointManager::DeregisterAction(std::list<RegisteredAction>& action_storage,
+void SyncpointManager::DeregisterAction(ActionStorage& action_storage,
                                         const ActionHandle& handle) {
     std::unique_lock lk(guard);
 
-    // We want to ensure the iterator still exists prior to erasing it
-    // Otherwise, if an invalid iterator was passed in then it could lead to UB
-    // It is important to avoid UB in that case since the deregister isn't called from a locked
-    // context
-    for (auto it = action_storage.begin(); it != action_storage.end(); it++) {
-        if (it == handle) {
-            action_storage.erase(it);
-            return;
-        }
-    }
+    // Handles of actions that already ran, or the default handle, are simply not found
+    action_storage.erase(handle);
 }
 
 void SyncpointManager::DeregisterGuestAction(u32 syncpoint_id, const ActionHandle& handle) {
@@ -58,47 +45,45 @@ void SyncpointManager::DeregisterHostAction(u32 syncpoint_id, const ActionHandle
 }
 
 void SyncpointManager::IncrementGuest(u32 syncpoint_id) {
-    Increment(syncpoints_guest[syncpoint_id], wait_guest_cv, guest_action_storage[syncpoint_id]);
+    Increment(syncpoints_guest[syncpoint_id], guest_action_storage[syncpoint_id]);
 }
 
 void SyncpointManager::IncrementHost(u32 syncpoint_id) {
-    Increment(syncpoints_host[syncpoint_id], wait_host_cv, host_action_storage[syncpoint_id]);
+    Increment(syncpoints_host[syncpoint_id], host_action_storage[syncpoint_id]);
 }
 
 void SyncpointManager::WaitGuest(u32 syncpoint_id, u32 expected_value) {
-    Wait(syncpoints_guest[syncpoint_id], wait_guest_cv, expected_value);
+    Wait(syncpoints_guest[syncpoint_id], expected_value);
 }
 
 void SyncpointManager::WaitHost(u32 syncpoint_id, u32 expected_value) {
     MICROPROFILE_SCOPE(GPU_wait);
-    Wait(syncpoints_host[syncpoint_id], wait_host_cv, expected_value);
+    Wait(syncpoints_host[syncpoint_id], expected_value);
 }
 
-void SyncpointManager::Increment(std::atomic<u32>& syncpoint, std::condition_variable& wait_cv,
-                                 std::list<RegisteredAction>& action_storage) {
+void SyncpointManager::Increment(std::atomic<u32>& syncpoint, ActionStorage& action_storage) {
     auto new_value{syncpoint.fetch_add(1, std::memory_order_acq_rel) + 1};
 
+    // Actions are sorted by the value they wait for, only the ones now reached are visited
     std::unique_lock lk(guard);
-    auto it = action_storage.begin();
-    while (it != action_storage.end()) {
-        if (it->expected_value > new_value) {
+    while (!action_storage.empty()) {
+        const auto it = action_storage.begin();
+        if (it->first.expected_value > new_value) {
             break;
         }
-        it->action();
-        it = action_storage.erase(it);
+        it->second();
+        action_storage.erase(it);
     }
-    wait_cv.notify_all();
+    syncpoint.notify_all();
 }
 
-void SyncpointManager::Wait(std::atomic<u32>& syncpoint, std::condition_variable& wait_cv,
-                            u32 expected_value) {
-    const auto pred = [&]() { return syncpoint.load(std::memory_order_acquire) >= expected_value; };
-    if (pred()) {
-        return;
+void SyncpointManager::Wait(std::atomic<u32>& syncpoint, u32 expected_value) {
+    // Waiters sleep on the syncpoint itself, so they are only woken by its own increments
+    u32 value{syncpoint.load(std::memory_order_acquire)};
+    while (value < expected_value) {
+        syncpoint.wait(value, std::memory_order_acquire);
+        value = syncpoint.load(std::memory_order_acquire);
     }
-
-    std::unique_lock lk(guard);
-    wait_cv.wait(lk, pred);
 }
 
 } // namespace Host1x
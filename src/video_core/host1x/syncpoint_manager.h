@@ -5,9 +5,9 @@
 
 #include <array>
 #include <atomic>
-#include <condition_variable>
+#include <compare>
 #include <functional>
-#include <list>
+#include <map>
 #include <mutex>
 
 #include "common/common_types.h"
@@ -26,13 +26,14 @@ public:
         return syncpoints_host[id].load(std::memory_order_acquire);
     }
 
-    struct RegisteredAction {
-        explicit RegisteredAction(u32 expected_value_, std::function<void()>&& action_)
-            : expected_value{expected_value_}, action{std::move(action_)} {}
-        u32 expected_value;
-        std::function<void()> action;
+    /// Identifies a registered action, ordered by the value it waits for and then by registration
+    struct ActionHandle {
+        u32 expected_value{};
+        u64 id{};
+
+        auto operator<=>(const ActionHandle&) const = default;
     };
-    using ActionHandle = std::list<RegisteredAction>::iterator;
+    using ActionStorage = std::map<ActionHandle, std::function<void()>>;
 
     template <typename Func>
     ActionHandle RegisterGuestAction(u32 syncpoint_id, u32 expected_value, Func&& action) {
@@ -67,28 +68,25 @@ public:
     }
 
 private:
-    void Increment(std::atomic<u32>& syncpoint, std::condition_variable& wait_cv,
-                   std::list<RegisteredAction>& action_storage);
+    void Increment(std::atomic<u32>& syncpoint, ActionStorage& action_storage);
 
-    ActionHandle RegisterAction(std::atomic<u32>& syncpoint,
-                                std::list<RegisteredAction>& action_storage, u32 expected_value,
-                                std::function<void()>&& action);
+    ActionHandle RegisterAction(std::atomic<u32>& syncpoint, ActionStorage& action_storage,
+                                u32 expected_value, std::function<void()>&& action);
 
-    void DeregisterAction(std::list<RegisteredAction>& action_storage, const ActionHandle& handle);
+    void DeregisterAction(ActionStorage& action_storage, const ActionHandle& handle);
 
-    void Wait(std::atomic<u32>& syncpoint, std::condition_variable& wait_cv, u32 expected_value);
+    void Wait(std::atomic<u32>& syncpoint, u32 expected_value);
 
     static constexpr size_t NUM_MAX_SYNCPOINTS = 192;
 
     std::array<std::atomic<u32>, NUM_MAX_SYNCPOINTS> syncpoints_guest{};
     std::array<std::atomic<u32>, NUM_MAX_SYNCPOINTS> syncpoints_host{};
 
-    std::array<std::list<RegisteredAction>, NUM_MAX_SYNCPOINTS> guest_action_storage;
-    std::array<std::list<RegisteredAction>, NUM_MAX_SYNCPOINTS> host_action_storage;
+    std::array<ActionStorage, NUM_MAX_SYNCPOINTS> guest_action_storage;
+    std::array<ActionStorage, NUM_MAX_SYNCPOINTS> host_action_storage;
 
     std::mutex guard;
-    std::condition_variable wait_guest_cv;
-    std::condition_variable wait_host_cv;
+    u64 next_action_id{1};
 };
 
 } // namespace Host1x
@@ -19,6 +19,7 @@ extern "C" {
 #include "common/logging/log.h"
 
 #include "video_core/engines/maxwell_3d.h"
+#include "video_core/gpu.h"
 #include "video_core/host1x/host1x.h"
 #include "video_core/host1x/nvdec.h"
 #include "video_core/host1x/vic.h"
@@ -49,8 +50,8 @@ union VicConfig {
     BitField<46, 14, u64_le> surface_height_minus1;
 };
 
-Vic::Vic(Host1x& host1x_, std::shared_ptr<Nvdec> nvdec_processor_)
-    : host1x(host1x_),
+Vic::Vic(GPU& gpu_, Host1x& host1x_, std::shared_ptr<Nvdec> nvdec_processor_)
+    : gpu(gpu_), host1x(host1x_),
       nvdec_processor(std::move(nvdec_processor_)), converted_frame_buffer{nullptr, av_free} {}
 
 Vic::~Vic() = default;
@@ -138,11 +139,26 @@ void Vic::WriteRGBFrame(std::unique_ptr<FFmpeg::Frame> frame, const VicConfig& c
         scaler_height = frame_height;
         converted_frame_buffer.reset();
     }
+    const std::array<int, 4> converted_stride{frame_width * 4, frame_height * 4, 0, 0};
+
+    if (const auto surface = FindCachedRGBSurface(config);
+        surface && static_cast<s32>(surface->width) == frame_width &&
+        static_cast<s32>(surface->height) == frame_height) {
+        // The surface is sampled by the GPU, skip swizzling the frame into guest memory for the
+        // image to be uploaded from it again
+        const size_t frame_size = static_cast<size_t>(frame_width) * frame_height * 4;
+        Common::ScratchBuffer<u8> pixels(frame_size);
+        u8* const pixels_addr{pixels.data()};
+        sws_scale(scaler_ctx, frame->GetPlanes(), frame->GetStrides(), 0, frame_height,
+                  &pixels_addr, converted_stride.data());
+        gpu.AccelerateVideoFrame(*surface, std::move(pixels));
+        return;
+    }
+
     if (!converted_frame_buffer) {
         const size_t frame_size = frame_width * frame_height * 4;
         converted_frame_buffer = AVMallocPtr{static_cast<u8*>(av_malloc(frame_size)), av_free};
     }
-    const std::array<int, 4> converted_stride{frame_width * 4, frame_height * 4, 0, 0};
     u8* const converted_frame_buf_addr{converted_frame_buffer.get()};
     sws_scale(scaler_ctx, frame->GetPlanes(), frame->GetStrides(), 0, frame_height,
               &converted_frame_buf_addr, converted_stride.data());
@@ -171,6 +187,30 @@ void Vic::WriteRGBFrame(std::unique_ptr<FFmpeg::Frame> frame, const VicConfig& c
     }
 }
 
+std::optional<VideoCore::VideoFrameSurface> Vic::FindCachedRGBSurface(
+    const VicConfig& config) const {
+    const auto address = host1x.GMMU().GpuToCpuAddress(output_surface_luma_address);
+    if (!address) {
+        return std::nullopt;
+    }
+    // RGBX8 frames keep the unused byte where RGBA8 frames have their alpha
+    const auto format = config.pixel_format == VideoPixelFormat::BGRA8
+                            ? VideoCore::Surface::PixelFormat::B8G8R8A8_UNORM
+                            : VideoCore::Surface::PixelFormat::A8B8G8R8_UNORM;
+    const VideoCore::VideoFrameSurface surface{
+        .address = *address,
+        .format = format,
+        .width = static_cast<u32>(config.surface_width_minus1) + 1,
+        .height = static_cast<u32>(config.surface_height_minus1) + 1,
+        .block_height = static_cast<u32>(config.block_linear_height_log2),
+        .is_block_linear = config.block_linear_kind != 0,
+    };
+    if (!gpu.CanAccelerateVideoFrame(surface)) {
+        return std::nullopt;
+    }
+    return surface;
+}
+
 void Vic::WriteYUVFrame(std::unique_ptr<FFmpeg::Frame> frame, const VicConfig& config) {
     LOG_TRACE(Service_NVDRV, "Writing YUV420 Frame");
 
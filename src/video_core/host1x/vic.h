@@ -4,14 +4,18 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 
 #include "common/common_types.h"
 #include "common/scratch_buffer.h"
+#include "video_core/video_frame_surface.h"
 
 struct SwsContext;
 
 namespace Tegra {
 
+class GPU;
+
 namespace Host1x {
 
 class Host1x;
@@ -29,7 +33,7 @@ public:
         SetOutputSurfaceChromaUnusedOffset = 0x1ca
     };
 
-    explicit Vic(Host1x& host1x, std::shared_ptr<Nvdec> nvdec_processor);
+    explicit Vic(GPU& gpu, Host1x& host1x, std::shared_ptr<Nvdec> nvdec_processor);
 
     ~Vic();
 
@@ -43,6 +47,10 @@ private:
 
     void WriteYUVFrame(std::unique_ptr<FFmpeg::Frame> frame, const VicConfig& config);
 
+    /// Returns the output surface when a cached image of it can be written instead of memory
+    std::optional<VideoCore::VideoFrameSurface> FindCachedRGBSurface(const VicConfig& config) const;
+
+    GPU& gpu;
     Host1x& host1x;
     std::shared_ptr<Tegra::Host1x::Nvdec> nvdec_processor;
 
@@ -1,10 +1,13 @@
 // SPDX-FileCopyrightText: Copyright 2020 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include <cstring>
 #include <fstream>
 #include <optional>
 #include <span>
+#include <string>
+#include <string_view>
 
 #include "common/container_hash.h"
 
@@ -18,9 +21,12 @@
 #include "video_core/macro/macro.h"
 #include "video_core/macro/macro_hle.h"
 #include "video_core/macro/macro_interpreter.h"
+#include "video_core/macro/macro_profiler.h"
 
 #ifdef ARCHITECTURE_x86_64
 #include "video_core/macro/macro_jit_x64.h"
+#elif defined(ARCHITECTURE_arm64)
+#include "video_core/macro/macro_jit_arm64.h"
 #endif
 
 MICROPROFILE_DEFINE(MacroHLE, "GPU", "Execute macro HLE", MP_RGB(128, 192, 192));
@@ -55,9 +61,17 @@ static void Dump(u64 hash, std::span<const u32> code, bool decompiled = false) {
 }
 
 MacroEngine::MacroEngine(Engines::Maxwell3D& maxwell3d_)
-    : hle_macros{std::make_unique<Tegra::HLEMacro>(maxwell3d_)}, maxwell3d{maxwell3d_} {}
+    : hle_macros{std::make_unique<Tegra::HLEMacro>(maxwell3d_)}, maxwell3d{maxwell3d_} {
+    if (Settings::values.profile_macros) {
+        profiler = std::make_unique<MacroProfiler>();
+    }
+}
 
-MacroEngine::~MacroEngine() = default;
+MacroEngine::~MacroEngine() {
+    if (profiler) {
+        WriteProfileReport();
+    }
+}
 
 void MacroEngine::AddCode(u32 method, u32 data) {
     uploaded_macro_code[method].push_back(data);
@@ -76,8 +90,7 @@ void MacroEngine::Execute(u32 method, const std::vector<u32>& parameters) {
             MICROPROFILE_SCOPE(MacroHLE);
             cache_info.hle_program->Execute(parameters, method);
         } else {
-            maxwell3d.RefreshParameters();
-            cache_info.lle_program->Execute(parameters, method);
+            ExecuteLLE(cache_info, parameters, method);
         }
     } else {
         // Macro not compiled, check if it's uploaded and if so, compile it
@@ -100,6 +113,7 @@ void MacroEngine::Execute(u32 method, const std::vector<u32>& parameters) {
         if (!mid_method.has_value()) {
             cache_info.lle_program = Compile(macro_code->second);
             cache_info.hash = Common::HashValue(macro_code->second);
+            cache_info.code_size = macro_code->second.size();
         } else {
             const auto& macro_cached = uploaded_macro_code[mid_method.value()];
             const auto rebased_method = method - mid_method.value();
@@ -108,13 +122,13 @@ void MacroEngine::Execute(u32 method, const std::vector<u32>& parameters) {
             std::memcpy(code.data(), macro_cached.data() + rebased_method,
                         code.size() * sizeof(u32));
             cache_info.hash = Common::HashValue(code);
+            cache_info.code_size = code.size();
             cache_info.lle_program = Compile(code);
         }
 
         auto hle_program = hle_macros->GetHLEProgram(cache_info.hash);
         if (!hle_program || Settings::values.disable_macro_hle) {
-            maxwell3d.RefreshParameters();
-            cache_info.lle_program->Execute(parameters, method);
+            ExecuteLLE(cache_info, parameters, method);
         } else {
             cache_info.has_hle_program = true;
             cache_info.hle_program = std::move(hle_program);
@@ -128,12 +142,56 @@ void MacroEngine::Execute(u32 method, const std::vector<u32>& parameters) {
     }
 }
 
+void MacroEngine::ExecuteLLE(const CacheInfo& cache_info, const std::vector<u32>& parameters,
+                             u32 method) {
+    maxwell3d.RefreshParameters();
+    if (!profiler) [[likely]] {
+        cache_info.lle_program->Execute(parameters, method);
+        return;
+    }
+    maxwell3d.SetMacroProfiler(profiler.get());
+    profiler->BeginRun(cache_info.hash, cache_info.code_size);
+    cache_info.lle_program->Execute(parameters, method);
+    profiler->EndRun();
+    maxwell3d.SetMacroProfiler(nullptr);
+}
+
+void MacroEngine::WriteProfileReport() const {
+    static constexpr size_t MAX_REPORT_ENTRIES = 64;
+    static constexpr size_t MAX_LOGGED_LINES = 12;
+
+    const std::string report = profiler->MakeReport(MAX_REPORT_ENTRIES);
+    size_t line_begin = 0;
+    for (size_t line = 0; line < MAX_LOGGED_LINES && line_begin < report.size(); ++line) {
+        const size_t line_end = std::min(report.find('\n', line_begin), report.size());
+        LOG_INFO(HW_GPU, "{}", std::string_view{report}.substr(line_begin, line_end - line_begin));
+        line_begin = line_end + 1;
+    }
+
+    const auto base_dir{Common::FS::GetYuzuPath(Common::FS::YuzuPath::DumpDir)};
+    const auto macro_dir{base_dir / "macros"};
+    if (!Common::FS::CreateDir(base_dir) || !Common::FS::CreateDir(macro_dir)) {
+        LOG_ERROR(Common_Filesystem, "Failed to create macro dump directories");
+        return;
+    }
+    const auto name{macro_dir / "profile.txt"};
+    std::ofstream report_file(name, std::ios::out | std::ios::trunc);
+    if (!report_file) {
+        LOG_ERROR(Common_Filesystem, "Unable to open or create file at {}",
+                  Common::FS::PathToUTF8String(name));
+        return;
+    }
+    report_file << report;
+}
+
 std::unique_ptr<MacroEngine> GetMacroEngine(Engines::Maxwell3D& maxwell3d) {
     if (Settings::values.disable_macro_jit) {
         return std::make_unique<MacroInterpreter>(maxwell3d);
     }
 #ifdef ARCHITECTURE_x86_64
     return std::make_unique<MacroJITx64>(maxwell3d);
+#elif defined(ARCHITECTURE_arm64)
+    return std::make_unique<MacroJITArm64>(maxwell3d);
 #else
     return std::make_unique<MacroInterpreter>(maxwell3d);
 #endif
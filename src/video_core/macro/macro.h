@@ -96,6 +96,7 @@ union MethodAddress {
 } // namespace Macro
 
 class HLEMacro;
+class MacroProfiler;
 
 class CachedMacro {
 public:
@@ -131,12 +132,20 @@ private:
         std::unique_ptr<CachedMacro> lle_program{};
         std::unique_ptr<CachedMacro> hle_program{};
         u64 hash{};
+        size_t code_size{};
         bool has_hle_program{};
     };
 
+    /// Executes the low level emulated program of a macro, profiling it when enabled
+    void ExecuteLLE(const CacheInfo& cache_info, const std::vector<u32>& parameters, u32 method);
+
+    /// Writes the macro profiler report to the dump directory and the log
+    void WriteProfileReport() const;
+
     std::unordered_map<u32, CacheInfo> macro_cache;
     std::unordered_map<u32, std::vector<u32>> uploaded_macro_code;
     std::unique_ptr<HLEMacro> hle_macros;
+    std::unique_ptr<MacroProfiler> profiler;
     Engines::Maxwell3D& maxwell3d;
 };
 
@@ -0,0 +1,493 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include <oaknut/code_block.hpp>
+#include <oaknut/oaknut.hpp>
+
+#include "common/assert.h"
+#include "common/logging/log.h"
+#include "common/microprofile.h"
+#include "video_core/engines/maxwell_3d.h"
+#include "video_core/macro/macro_jit_arm64.h"
+
+MICROPROFILE_DEFINE(MacroJitCompile, "GPU", "Compile macro JIT", MP_RGB(173, 255, 47));
+MICROPROFILE_DEFINE(MacroJitExecute, "GPU", "Execute macro JIT", MP_RGB(255, 255, 0));
+
+namespace Tegra {
+namespace {
+using namespace oaknut::util;
+using oaknut::Cond;
+using oaknut::Label;
+using oaknut::WReg;
+using oaknut::XReg;
+
+// Every persistent value lives in a callee saved register, so calls into the engine don't have to
+// spill anything. Macro register 0 is hardwired to zero, which maps to WZR.
+constexpr XReg PARAMETERS = X19;
+constexpr WReg METHOD_ADDRESS = W20;
+constexpr WReg CARRY = W21;
+const std::array<WReg, Macro::NUM_MACRO_REGISTERS> REGISTERS{
+    WZR, W22, W23, W24, W25, W26, W27, W28,
+};
+
+// Result of the current instruction, clobbered by calls into the engine
+constexpr WReg RESULT = W9;
+constexpr XReg RESULT_64 = X9;
+
+// Stack frame: frame record, callee saved registers and the values that don't fit in registers
+constexpr s64 FRAME_SIZE = 128;
+constexpr s64 MAXWELL3D_OFFSET = 96;
+constexpr s64 REG_ARRAY_OFFSET = 104;
+constexpr s64 MAX_PARAMETER_OFFSET = 112;
+
+void Send(Engines::Maxwell3D* maxwell3d, u32 raw_method_address, u32 value) {
+    Macro::MethodAddress method_address{};
+    method_address.raw = raw_method_address;
+    maxwell3d->CallMethod(method_address.address, value, true);
+}
+
+void WarnInvalidParameter(uintptr_t parameter, uintptr_t max_parameter) {
+    LOG_CRITICAL(HW_GPU,
+                 "Macro JIT: invalid parameter access 0x{:x} (0x{:x} is the last parameter)",
+                 parameter, max_parameter - sizeof(u32));
+}
+
+class MacroJITArm64Impl final : public CachedMacro {
+public:
+    explicit MacroJITArm64Impl(Engines::Maxwell3D& maxwell3d_, const std::vector<u32>& code_)
+        : code{code_}, maxwell3d{maxwell3d_} {
+        Compile();
+    }
+
+    void Execute(const std::vector<u32>& parameters, u32 method) override;
+
+private:
+    using ProgramType = void (*)(Engines::Maxwell3D*, const u32* parameters,
+                                 const u32* max_parameter, u32* reg_array);
+
+    void Compile();
+
+    /**
+     * Compiles the instruction at the given index.
+     * Delay slots are resolved at compile time: taken branches and exits compile a copy of the
+     * following instruction before leaving, so there is no delayed program counter at run time.
+     *
+     * @param is_delay_slot Whether the instruction is compiled as the delay slot of the previous
+     *                      instruction.
+     */
+    void Compile_Instruction(oaknut::VectorCodeGenerator& c, u32 index, bool is_delay_slot);
+
+    void Compile_ALU(oaknut::VectorCodeGenerator& c, Macro::Opcode opcode);
+    void Compile_AddImmediate(oaknut::VectorCodeGenerator& c, Macro::Opcode opcode);
+    void Compile_ExtractInsert(oaknut::VectorCodeGenerator& c, Macro::Opcode opcode);
+    void Compile_ExtractShiftLeftImmediate(oaknut::VectorCodeGenerator& c, Macro::Opcode opcode);
+    void Compile_ExtractShiftLeftRegister(oaknut::VectorCodeGenerator& c, Macro::Opcode opcode);
+    void Compile_Read(oaknut::VectorCodeGenerator& c, Macro::Opcode opcode);
+    void Compile_Branch(oaknut::VectorCodeGenerator& c, Macro::Opcode opcode, u32 index);
+
+    /// Writes the value of a macro register plus a signed immediate to RESULT
+    void Compile_AddRegisterImmediate(oaknut::VectorCodeGenerator& c, u32 reg, s32 immediate);
+
+    /// Writes (src >> lsb) & ((1 << size) - 1) to dst
+    void Compile_ExtractBits(oaknut::VectorCodeGenerator& c, WReg dst, WReg src, u32 lsb,
+                             u32 size);
+
+    WReg Compile_FetchParameter(oaknut::VectorCodeGenerator& c);
+    void Compile_ProcessResult(oaknut::VectorCodeGenerator& c, Macro::ResultOperation operation,
+                               u32 reg);
+    void Compile_Send(oaknut::VectorCodeGenerator& c, WReg value);
+
+    Macro::Opcode GetOpCode(u32 index) const;
+
+    /// Carry is only tracked when an instruction of the macro consumes it
+    bool can_skip_carry{};
+
+    std::vector<Label> labels;
+    Label end_of_code;
+
+    std::unique_ptr<oaknut::CodeBlock> block;
+    ProgramType program{nullptr};
+
+    const std::vector<u32>& code;
+    Engines::Maxwell3D& maxwell3d;
+};
+
+void MacroJITArm64Impl::Execute(const std::vector<u32>& parameters, u32 method) {
+    MICROPROFILE_SCOPE(MacroJitExecute);
+    ASSERT_OR_EXECUTE(program != nullptr, { return; });
+    program(&maxwell3d, parameters.data(), parameters.data() + parameters.size(),
+            maxwell3d.regs.reg_array.data());
+}
+
+void MacroJITArm64Impl::Compile() {
+    MICROPROFILE_SCOPE(MacroJitCompile);
+    can_skip_carry = std::ranges::none_of(code, [](u32 raw) {
+        const Macro::Opcode op{raw};
+        return op.operation == Macro::Operation::ALU &&
+               (op.alu_operation == Macro::ALUOperation::AddWithCarry ||
+                op.alu_operation == Macro::ALUOperation::SubtractWithBorrow);
+    });
+
+    const u32 op_count = static_cast<u32>(code.size());
+    labels = std::vector<Label>(op_count);
+
+    std::vector<u32> buffer;
+    oaknut::VectorCodeGenerator c{buffer};
+
+    c.STP(X29, X30, SP, PRE_INDEXED, -FRAME_SIZE);
+    c.STP(X19, X20, SP, 16);
+    c.STP(X21, X22, SP, 32);
+    c.STP(X23, X24, SP, 48);
+    c.STP(X25, X26, SP, 64);
+    c.STP(X27, X28, SP, 80);
+    c.STR(X0, SP, MAXWELL3D_OFFSET);
+    c.STR(X2, SP, MAX_PARAMETER_OFFSET);
+    c.STR(X3, SP, REG_ARRAY_OFFSET);
+    c.MOV(PARAMETERS, X1);
+    c.MOV(METHOD_ADDRESS, WZR);
+    c.MOV(CARRY, WZR);
+    for (size_t reg = 2; reg < REGISTERS.size(); ++reg) {
+        c.MOV(REGISTERS[reg], WZR);
+    }
+    // The first parameter is always loaded to register 1
+    c.MOV(REGISTERS[1], Compile_FetchParameter(c));
+
+    for (u32 index = 0; index < op_count; ++index) {
+        c.l(labels[index]);
+        Compile_Instruction(c, index, false);
+    }
+
+    c.l(end_of_code);
+    c.LDP(X19, X20, SP, 16);
+    c.LDP(X21, X22, SP, 32);
+    c.LDP(X23, X24, SP, 48);
+    c.LDP(X25, X26, SP, 64);
+    c.LDP(X27, X28, SP, 80);
+    c.LDP(X29, X30, SP, POST_INDEXED, FRAME_SIZE);
+    c.RET();
+
+    // The generated code is position independent, copy it to executable memory of the right size
+    const size_t code_size = buffer.size() * sizeof(u32);
+    block = std::make_unique<oaknut::CodeBlock>(code_size);
+    block->unprotect();
+    std::memcpy(block->ptr(), buffer.data(), code_size);
+    block->protect();
+    block->invalidate_all();
+    program = reinterpret_cast<ProgramType>(block->ptr());
+}
+
+void MacroJITArm64Impl::Compile_Instruction(oaknut::VectorCodeGenerator& c, u32 index,
+                                            bool is_delay_slot) {
+    const Macro::Opcode opcode = GetOpCode(index);
+    switch (opcode.operation) {
+    case Macro::Operation::ALU:
+        Compile_ALU(c, opcode);
+        break;
+    case Macro::Operation::AddImmediate:
+        Compile_AddImmediate(c, opcode);
+        break;
+    case Macro::Operation::ExtractInsert:
+        Compile_ExtractInsert(c, opcode);
+        break;
+    case Macro::Operation::ExtractShiftLeftImmediate:
+        Compile_ExtractShiftLeftImmediate(c, opcode);
+        break;
+    case Macro::Operation::ExtractShiftLeftRegister:
+        Compile_ExtractShiftLeftRegister(c, opcode);
+        break;
+    case Macro::Operation::Read:
+        Compile_Read(c, opcode);
+        break;
+    case Macro::Operation::Branch:
+        ASSERT_MSG(!is_delay_slot, "Executing a branch in a delay slot is not valid");
+        if (!is_delay_slot) {
+            Compile_Branch(c, opcode, index);
+        }
+        break;
+    default:
+        UNIMPLEMENTED_MSG("Unimplemented opcode {}", opcode.operation.Value());
+        break;
+    }
+
+    // An instruction with the exit flag doesn't exit when it's executed inside a delay slot
+    if (opcode.is_exit && !is_delay_slot) {
+        // Exit has a delay slot, execute the next instruction
+        if (index + 1 < code.size()) {
+            Compile_Instruction(c, index + 1, true);
+        }
+        c.B(end_of_code);
+    }
+}
+
+void MacroJITArm64Impl::Compile_ALU(oaknut::VectorCodeGenerator& c, Macro::Opcode opcode) {
+    const WReg src_a = REGISTERS[opcode.src_a];
+    const WReg src_b = REGISTERS[opcode.src_b];
+
+    // The carry flag of the host matches the macro carry, including the inverted borrow of
+    // subtractions, so it can be stored and restored as is.
+    const auto load_carry = [&] { c.CMP(CARRY, 1); };
+    const auto store_carry = [&] { c.CSET(CARRY, Cond::CS); };
+
+    switch (opcode.alu_operation) {
+    case Macro::ALUOperation::Add:
+        if (can_skip_carry) {
+            c.ADD(RESULT, src_a, src_b);
+        } else {
+            c.ADDS(RESULT, src_a, src_b);
+            store_carry();
+        }
+        break;
+    case Macro::ALUOperation::AddWithCarry:
+        load_carry();
+        c.ADCS(RESULT, src_a, src_b);
+        store_carry();
+        break;
+    case Macro::ALUOperation::Subtract:
+        if (can_skip_carry) {
+            c.SUB(RESULT, src_a, src_b);
+        } else {
+            c.SUBS(RESULT, src_a, src_b);
+            store_carry();
+        }
+        break;
+    case Macro::ALUOperation::SubtractWithBorrow:
+        load_carry();
+        c.SBCS(RESULT, src_a, src_b);
+        store_carry();
+        break;
+    case Macro::ALUOperation::Xor:
+        c.EOR(RESULT, src_a, src_b);
+        break;
+    case Macro::ALUOperation::Or:
+        c.ORR(RESULT, src_a, src_b);
+        break;
+    case Macro::ALUOperation::And:
+        c.AND(RESULT, src_a, src_b);
+        break;
+    case Macro::ALUOperation::AndNot:
+        c.BIC(RESULT, src_a, src_b);
+        break;
+    case Macro::ALUOperation::Nand:
+        c.AND(RESULT, src_a, src_b);
+        c.MVN(RESULT, RESULT);
+        break;
+    default:
+        UNIMPLEMENTED_MSG("Unimplemented ALU operation {}", opcode.alu_operation.Value());
+        break;
+    }
+    Compile_ProcessResult(c, opcode.result_operation, opcode.dst);
+}
+
+void MacroJITArm64Impl::Compile_AddImmediate(oaknut::VectorCodeGenerator& c,
+                                             Macro::Opcode opcode) {
+    Compile_AddRegisterImmediate(c, opcode.src_a, opcode.immediate);
+    Compile_ProcessResult(c, opcode.result_operation, opcode.dst);
+}
+
+void MacroJITArm64Impl::Compile_ExtractInsert(oaknut::VectorCodeGenerator& c,
+                                              Macro::Opcode opcode) {
+    const u32 size = opcode.bf_size;
+    const u32 dst_bit = opcode.bf_dst_bit;
+    c.MOV(RESULT, REGISTERS[opcode.src_a]);
+    if (size != 0) {
+        // Bits inserted past the top of the register are discarded
+        Compile_ExtractBits(c, W0, REGISTERS[opcode.src_b], opcode.bf_src_bit, size);
+        c.BFI(RESULT, W0, dst_bit, std::min(size, 32 - dst_bit));
+    }
+    Compile_ProcessResult(c, opcode.result_operation, opcode.dst);
+}
+
+void MacroJITArm64Impl::Compile_ExtractShiftLeftImmediate(oaknut::VectorCodeGenerator& c,
+                                                          Macro::Opcode opcode) {
+    const u32 size = opcode.bf_size;
+    const u32 dst_bit = opcode.bf_dst_bit;
+    if (size == 0) {
+        c.MOV(RESULT, WZR);
+    } else {
+        c.LSRV(W0, REGISTERS[opcode.src_b], REGISTERS[opcode.src_a]);
+        c.UBFIZ(RESULT, W0, dst_bit, std::min(size, 32 - dst_bit));
+    }
+    Compile_ProcessResult(c, opcode.result_operation, opcode.dst);
+}
+
+void MacroJITArm64Impl::Compile_ExtractShiftLeftRegister(oaknut::VectorCodeGenerator& c,
+                                                         Macro::Opcode opcode) {
+    Compile_ExtractBits(c, W0, REGISTERS[opcode.src_b], opcode.bf_src_bit, opcode.bf_size);
+    c.LSLV(RESULT, W0, REGISTERS[opcode.src_a]);
+    Compile_ProcessResult(c, opcode.result_operation, opcode.dst);
+}
+
+void MacroJITArm64Impl::Compile_Read(oaknut::VectorCodeGenerator& c, Macro::Opcode opcode) {
+    Compile_AddRegisterImmediate(c, opcode.src_a, opcode.immediate);
+
+    // Equivalent to Engines::Maxwell3D::GetRegisterValue, writes to W9 zero the top of X9
+    c.LDR(X0, SP, REG_ARRAY_OFFSET);
+    c.LSL(X1, RESULT_64, 2);
+    c.ADD(X0, X0, X1);
+    c.LDR(RESULT, X0);
+
+    Compile_ProcessResult(c, opcode.result_operation, opcode.dst);
+}
+
+void MacroJITArm64Impl::Compile_Branch(oaknut::VectorCodeGenerator& c, Macro::Opcode opcode,
+                                       u32 index) {
+    const s64 target = static_cast<s64>(index) + opcode.immediate;
+    ASSERT_MSG(target >= 0 && static_cast<size_t>(target) < code.size(),
+               "Macro branch target {} is out of bounds", target);
+    Label& target_label = target >= 0 && static_cast<size_t>(target) < code.size()
+                              ? labels[static_cast<size_t>(target)]
+                              : end_of_code;
+
+    const WReg value = REGISTERS[opcode.src_a];
+    Label not_taken;
+    switch (opcode.branch_condition) {
+    case Macro::BranchCondition::Zero:
+        c.CBNZ(value, not_taken);
+        break;
+    case Macro::BranchCondition::NotZero:
+        c.CBZ(value, not_taken);
+        break;
+    }
+    // Branches without the annul bit execute the next instruction before jumping
+    if (!opcode.branch_annul && index + 1 < code.size()) {
+        Compile_Instruction(c, index + 1, true);
+    }
+    c.B(target_label);
+    c.l(not_taken);
+}
+
+void MacroJITArm64Impl::Compile_AddRegisterImmediate(oaknut::VectorCodeGenerator& c, u32 reg,
+                                                     s32 immediate) {
+    if (reg == 0) {
+        c.MOV(RESULT, static_cast<u32>(immediate));
+        return;
+    }
+    const WReg src = REGISTERS[reg];
+    if (immediate == 0) {
+        c.MOV(RESULT, src);
+    } else if (immediate > 0 && immediate < 0x1000) {
+        c.ADD(RESULT, src, static_cast<u32>(immediate));
+    } else if (immediate < 0 && immediate > -0x1000) {
+        c.SUB(RESULT, src, static_cast<u32>(-immediate));
+    } else {
+        c.MOV(W17, static_cast<u32>(immediate));
+        c.ADD(RESULT, src, W17);
+    }
+}
+
+void MacroJITArm64Impl::Compile_ExtractBits(oaknut::VectorCodeGenerator& c, WReg dst, WReg src,
+                                            u32 lsb, u32 size) {
+    if (size == 0) {
+        c.MOV(dst, WZR);
+    } else if (lsb + size <= 32) {
+        c.UBFX(dst, src, lsb, size);
+    } else {
+        // The field goes past the top of the register, the shift already clears the upper bits
+        c.LSR(dst, src, lsb);
+    }
+}
+
+WReg MacroJITArm64Impl::Compile_FetchParameter(oaknut::VectorCodeGenerator& c) {
+    Label parameter_ok;
+    c.LDR(X1, SP, MAX_PARAMETER_OFFSET);
+    c.CMP(PARAMETERS, X1);
+    c.B(Cond::LO, parameter_ok);
+    c.MOV(X0, PARAMETERS);
+    c.STR(RESULT_64, SP, PRE_INDEXED, -16);
+    c.MOV(X16, reinterpret_cast<u64>(&WarnInvalidParameter));
+    c.BLR(X16);
+    c.LDR(RESULT_64, SP, POST_INDEXED, 16);
+    c.l(parameter_ok);
+    c.LDR(W0, PARAMETERS, POST_INDEXED, static_cast<int>(sizeof(u32)));
+    return W0;
+}
+
+void MacroJITArm64Impl::Compile_Send(oaknut::VectorCodeGenerator& c, WReg value) {
+    c.MOV(W2, value);
+    c.MOV(W1, METHOD_ADDRESS);
+    c.LDR(X0, SP, MAXWELL3D_OFFSET);
+    c.MOV(X16, reinterpret_cast<u64>(&Send));
+    c.BLR(X16);
+
+    // Increment the method address by the method increment
+    c.UBFX(W0, METHOD_ADDRESS, 12, 6);
+    c.ADD(W0, METHOD_ADDRESS, W0);
+    c.BFI(METHOD_ADDRESS, W0, 0, 12);
+}
+
+void MacroJITArm64Impl::Compile_ProcessResult(oaknut::VectorCodeGenerator& c,
+                                              Macro::ResultOperation operation, u32 reg) {
+    const auto SetRegister = [&c](u32 reg_index, WReg result) {
+        // Register 0 is supposed to always return 0. NOP is implemented as a store to the zero
+        // register.
+        if (reg_index == 0) {
+            return;
+        }
+        c.MOV(REGISTERS[reg_index], result);
+    };
+    const auto SetMethodAddress = [&c](WReg result) { c.MOV(METHOD_ADDRESS, result); };
+
+    switch (operation) {
+    case Macro::ResultOperation::IgnoreAndFetch:
+        SetRegister(reg, Compile_FetchParameter(c));
+        break;
+    case Macro::ResultOperation::Move:
+        SetRegister(reg, RESULT);
+        break;
+    case Macro::ResultOperation::MoveAndSetMethod:
+        SetRegister(reg, RESULT);
+        SetMethodAddress(RESULT);
+        break;
+    case Macro::ResultOperation::FetchAndSend:
+        // Fetch parameter and send result.
+        SetRegister(reg, Compile_FetchParameter(c));
+        Compile_Send(c, RESULT);
+        break;
+    case Macro::ResultOperation::MoveAndSend:
+        // Move and send result.
+        SetRegister(reg, RESULT);
+        Compile_Send(c, RESULT);
+        break;
+    case Macro::ResultOperation::FetchAndSetMethod:
+        // Fetch parameter and use result as Method Address.
+        SetRegister(reg, Compile_FetchParameter(c));
+        SetMethodAddress(RESULT);
+        break;
+    case Macro::ResultOperation::MoveAndSetMethodFetchAndSend:
+        // Move result and use as Method Address, then fetch and send parameter.
+        SetRegister(reg, RESULT);
+        SetMethodAddress(RESULT);
+        Compile_Send(c, Compile_FetchParameter(c));
+        break;
+    case Macro::ResultOperation::MoveAndSetMethodSend:
+        // Move result and use as Method Address, then send bits 12:17 of result.
+        SetRegister(reg, RESULT);
+        SetMethodAddress(RESULT);
+        c.UBFX(RESULT, RESULT, 12, 6);
+        Compile_Send(c, RESULT);
+        break;
+    default:
+        UNIMPLEMENTED_MSG("Unimplemented macro operation {}", operation);
+        break;
+    }
+}
+
+Macro::Opcode MacroJITArm64Impl::GetOpCode(u32 index) const {
+    ASSERT(index < code.size());
+    return {code[index]};
+}
+} // Anonymous namespace
+
+MacroJITArm64::MacroJITArm64(Engines::Maxwell3D& maxwell3d_)
+    : MacroEngine{maxwell3d_}, maxwell3d{maxwell3d_} {}
+
+std::unique_ptr<CachedMacro> MacroJITArm64::Compile(const std::vector<u32>& code) {
+    return std::make_unique<MacroJITArm64Impl>(maxwell3d, code);
+}
+} // namespace Tegra
@@ -0,0 +1,101 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "common/assert.h"
+#include "video_core/macro/macro_profiler.h"
+
+namespace Tegra {
+
+namespace {
+constexpr u64 PATTERN_HASH_SEED = 0xcbf29ce484222325ULL;
+constexpr size_t MAX_REPORTED_METHODS = 8;
+} // Anonymous namespace
+
+void MacroProfiler::BeginRun(u64 hash, size_t code_size) {
+    ASSERT(current == nullptr);
+    current = &stats[hash];
+    current->code_size = code_size;
+    current_writes.clear();
+    pattern_hash = PATTERN_HASH_SEED;
+    num_current_writes = 0;
+    begin_time = std::chrono::steady_clock::now();
+}
+
+void MacroProfiler::EndRun() {
+    const auto elapsed = std::chrono::steady_clock::now() - begin_time;
+    ASSERT(current != nullptr);
+    MacroStats& macro = *current;
+    current = nullptr;
+
+    ++macro.num_runs;
+    macro.num_writes += num_current_writes;
+    macro.total_time += elapsed;
+    macro.max_time = std::max<std::chrono::nanoseconds>(macro.max_time, elapsed);
+    for (const auto& [method, count] : current_writes) {
+        macro.method_writes[method] += count;
+    }
+    if (macro.patterns.size() < MAX_PATTERNS) {
+        macro.patterns.insert(pattern_hash);
+    }
+}
+
+std::string MacroProfiler::MakeReport(size_t max_entries) const {
+    std::vector<std::pair<u64, const MacroStats*>> ranked;
+    ranked.reserve(stats.size());
+    for (const auto& [hash, macro] : stats) {
+        ranked.emplace_back(hash, &macro);
+    }
+    // Macros costing the most host time overall are the best HLE candidates
+    std::ranges::sort(ranked, [](const auto& lhs, const auto& rhs) {
+        return lhs.second->total_time > rhs.second->total_time;
+    });
+    ranked.resize(std::min(ranked.size(), max_entries));
+
+    std::chrono::nanoseconds total_time{};
+    for (const auto& [hash, macro] : stats) {
+        total_time += macro.total_time;
+    }
+
+    std::string report;
+    auto out = std::back_inserter(report);
+    fmt::format_to(out, "{} macros executed without HLE, {:.3f} ms in total\n", stats.size(),
+                   std::chrono::duration<double, std::milli>(total_time).count());
+    fmt::format_to(out, "{:>4} {:>16} {:>6} {:>10} {:>10} {:>8} {:>8} {:>10} {:>8}  {}\n", "rank",
+                   "hash", "size", "runs", "total ms", "avg us", "max us", "writes/run", "patterns",
+                   "most written methods");
+    for (size_t rank = 0; rank < ranked.size(); ++rank) {
+        const auto& [hash, macro] = ranked[rank];
+        std::vector<std::pair<u32, u64>> methods(macro->method_writes.begin(),
+                                                 macro->method_writes.end());
+        std::ranges::sort(methods, [](const auto& lhs, const auto& rhs) {
+            return lhs.second != rhs.second ? lhs.second > rhs.second : lhs.first < rhs.first;
+        });
+        methods.resize(std::min(methods.size(), MAX_REPORTED_METHODS));
+
+        std::string method_list;
+        for (const auto& [method, count] : methods) {
+            fmt::format_to(std::back_inserter(method_list), " 0x{:03x}x{}", method, count);
+        }
+        const double runs = static_cast<double>(macro->num_runs);
+        const double total_us =
+            std::chrono::duration<double, std::micro>(macro->total_time).count();
+        fmt::format_to(out,
+                       "{:>4} {:016x} {:>6} {:>10} {:>10.3f} {:>8.2f} {:>8.2f} {:>10.1f} {:>7}{} "
+                       "{}\n",
+                       rank + 1, hash, macro->code_size, macro->num_runs, total_us / 1000.0,
+                       total_us / runs,
+                       std::chrono::duration<double, std::micro>(macro->max_time).count(),
+                       static_cast<double>(macro->num_writes) / runs, macro->patterns.size(),
+                       macro->patterns.size() >= MAX_PATTERNS ? "+" : " ", method_list);
+    }
+    return report;
+}
+
+} // namespace Tegra
@@ -0,0 +1,60 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "common/common_types.h"
+
+namespace Tegra {
+
+/**
+ * Records how often each low level emulated macro runs, the host time spent executing it and the
+ * methods it writes. The ranked report tells which macros are worth implementing as HLE.
+ */
+class MacroProfiler {
+public:
+    /// Begins a run of the macro with the given hash
+    void BeginRun(u64 hash, size_t code_size);
+
+    /// Ends the current run, accumulating its time and write pattern
+    void EndRun();
+
+    /// Records a method written by the current run
+    void RecordMethodWrite(u32 method) {
+        ++current_writes[method];
+        pattern_hash = (pattern_hash ^ method) * 0x100000001b3ULL;
+        ++num_current_writes;
+    }
+
+    /// Returns the ranked report of the macros that ran with the given number of entries
+    [[nodiscard]] std::string MakeReport(size_t max_entries) const;
+
+private:
+    struct MacroStats {
+        size_t code_size{};
+        u64 num_runs{};
+        u64 num_writes{};
+        std::chrono::nanoseconds total_time{};
+        std::chrono::nanoseconds max_time{};
+        std::unordered_map<u32, u64> method_writes;
+        std::unordered_set<u64> patterns;
+    };
+
+    /// Limit of distinct write patterns tracked per macro
+    static constexpr size_t MAX_PATTERNS = 256;
+
+    std::unordered_map<u64, MacroStats> stats;
+
+    MacroStats* current{};
+    std::chrono::steady_clock::time_point begin_time;
+    std::unordered_map<u32, u64> current_writes;
+    u64 pattern_hash{};
+    u64 num_current_writes{};
+};
+
+} // namespace Tegra
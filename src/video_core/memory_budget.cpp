@@ -0,0 +1,118 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <numeric>
+#include <utility>
+
+#include "common/literals.h"
+#include "common/perf_metrics.h"
+#include "video_core/memory_budget.h"
+
+namespace VideoCommon {
+
+using namespace Common::Literals;
+
+namespace {
+/// Relative size of the share of each client, indexed by MemoryBudgetClient
+constexpr std::array<u64, static_cast<size_t>(MemoryBudgetClient::Count)> WEIGHTS{6, 3, 1};
+constexpr u64 TOTAL_WEIGHT = std::reduce(WEIGHTS.begin(), WEIGHTS.end());
+
+/// Querying the budget isn't free on every driver, it is polled once every few frames
+constexpr u64 POLL_INTERVAL = 8;
+
+/// Memory shared by the caches even when the budget is already taken by other allocations
+constexpr u64 MINIMUM_POOL = 256_MiB;
+
+constexpr std::array<std::pair<Common::PerfMetrics::Gauge, Common::PerfMetrics::Gauge>,
+                     static_cast<size_t>(MemoryBudgetClient::Count)>
+    CLIENT_GAUGES{{
+        {Common::PerfMetrics::Gauge::TextureCacheMemory,
+         Common::PerfMetrics::Gauge::TextureCacheBudget},
+        {Common::PerfMetrics::Gauge::BufferCacheMemory,
+         Common::PerfMetrics::Gauge::BufferCacheBudget},
+        {Common::PerfMetrics::Gauge::StagingPoolMemory,
+         Common::PerfMetrics::Gauge::StagingPoolBudget},
+    }};
+} // Anonymous namespace
+
+MemoryBudget::MemoryBudget(u64 device_local_memory, QueryFunction query_)
+    : query{std::move(query_)}, heap{.budget = device_local_memory, .usage = 0} {
+    Poll();
+    Distribute();
+}
+
+MemoryBudget::~MemoryBudget() = default;
+
+void MemoryBudget::Tick() {
+    if (++frame % POLL_INTERVAL == 0) {
+        Poll();
+    }
+    Distribute();
+    Publish();
+}
+
+void MemoryBudget::Poll() {
+    if (!query) {
+        return;
+    }
+    const std::optional<HeapStatus> status = query();
+    if (!status) {
+        return;
+    }
+    heap = *status;
+
+    // Anything the caches don't account for (swapchain, descriptors, pipelines, other renderers)
+    // is taken off the top, it can't be evicted
+    const u64 tracked = std::reduce(usage.begin(), usage.end());
+    untracked_usage = heap.usage - std::min(heap.usage, tracked);
+}
+
+void MemoryBudget::Distribute() {
+    // Leave headroom for what is allocated between polls, the driver pages past the budget
+    const u64 limit = heap.budget - heap.budget / 10;
+    const u64 pool = std::max(limit - std::min(limit, untracked_usage), MINIMUM_POOL);
+
+    std::array<u64, NUM_CLIENTS> fair;
+    u64 slack = 0;
+    u64 borrower_weight = 0;
+    for (size_t client = 0; client < NUM_CLIENTS; ++client) {
+        fair[client] = pool * WEIGHTS[client] / TOTAL_WEIGHT;
+        // Unused memory is lent, keeping some room for the lender to grow without evicting
+        const u64 kept = usage[client] + fair[client] / 4;
+        if (kept < fair[client]) {
+            slack += fair[client] - kept;
+        } else if (usage[client] > fair[client]) {
+            borrower_weight += WEIGHTS[client];
+        }
+    }
+    for (size_t client = 0; client < NUM_CLIENTS; ++client) {
+        u64 allotted = fair[client];
+        if (borrower_weight > 0) {
+            const u64 kept = usage[client] + fair[client] / 4;
+            if (kept < fair[client]) {
+                allotted = kept;
+            } else if (usage[client] > fair[client]) {
+                allotted += slack * WEIGHTS[client] / borrower_weight;
+            }
+        }
+        shares[client] = MemoryBudgetShare{
+            .minimum = allotted / 2,
+            .expected = allotted - allotted / 5,
+            .critical = allotted,
+        };
+    }
+}
+
+void MemoryBudget::Publish() const {
+    using Common::PerfMetrics::Gauge;
+    Common::PerfMetrics::Set(Gauge::DeviceMemoryBudget, heap.budget);
+    Common::PerfMetrics::Set(Gauge::DeviceMemoryUsage, heap.usage);
+    for (size_t client = 0; client < NUM_CLIENTS; ++client) {
+        const auto [memory_gauge, budget_gauge] = CLIENT_GAUGES[client];
+        Common::PerfMetrics::Set(memory_gauge, usage[client]);
+        Common::PerfMetrics::Set(budget_gauge, shares[client].critical);
+    }
+}
+
+} // namespace VideoCommon
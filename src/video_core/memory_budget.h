@@ -0,0 +1,82 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <functional>
+#include <optional>
+
+#include "common/common_types.h"
+
+namespace VideoCommon {
+
+/// Caches sharing the device memory budget
+enum class MemoryBudgetClient : u32 {
+    TextureCache,
+    BufferCache,
+    StagingPool,
+    Count,
+};
+
+/// Thresholds a cache collects its objects against, in bytes of its own usage
+struct MemoryBudgetShare {
+    u64 minimum;  ///< Old objects are collected above this usage
+    u64 expected; ///< Collection prioritizes freeing memory above this usage
+    u64 critical; ///< Collection is aggressive above this usage
+};
+
+/**
+ * Splits the device memory budget between the caches of a renderer. Each cache reports its usage
+ * and receives a share of what is left once memory not owned by any cache is accounted for. The
+ * budget is polled from the driver at runtime, so usage growing outside of the caches (or other
+ * processes taking memory away) shrinks the shares and every cache evicts incrementally before the
+ * driver has to page. Shares a cache doesn't use are lent to the caches over theirs.
+ *
+ * Not thread-safe, it is expected to be used from the GPU thread.
+ */
+class MemoryBudget {
+public:
+    /// Budget and usage of the device local heaps, as reported by the driver
+    struct HeapStatus {
+        u64 budget;
+        u64 usage;
+    };
+
+    /// Polls the driver, returns nothing when the driver can't report the budget
+    using QueryFunction = std::function<std::optional<HeapStatus>()>;
+
+    explicit MemoryBudget(u64 device_local_memory, QueryFunction query_ = {});
+    ~MemoryBudget();
+
+    /// Reports the memory currently used by a cache
+    void ReportUsage(MemoryBudgetClient client, u64 bytes) noexcept {
+        usage[static_cast<size_t>(client)] = bytes;
+    }
+
+    /// Returns the thresholds of a cache computed on the last tick
+    [[nodiscard]] const MemoryBudgetShare& GetShare(MemoryBudgetClient client) const noexcept {
+        return shares[static_cast<size_t>(client)];
+    }
+
+    /// Polls the driver when due and recomputes the shares, call once per frame
+    void Tick();
+
+private:
+    static constexpr size_t NUM_CLIENTS = static_cast<size_t>(MemoryBudgetClient::Count);
+
+    void Poll();
+
+    void Distribute();
+
+    void Publish() const;
+
+    QueryFunction query;
+    HeapStatus heap;
+    u64 untracked_usage = 0;
+    u64 frame = 0;
+    std::array<u64, NUM_CLIENTS> usage{};
+    std::array<MemoryBudgetShare, NUM_CLIENTS> shares{};
+};
+
+} // namespace VideoCommon
@@ -2,6 +2,8 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <algorithm>
+#include <array>
+#include <limits>
 
 #include "common/alignment.h"
 #include "common/assert.h"
@@ -19,6 +21,25 @@
 namespace Tegra {
 using Tegra::Memory::GuestMemoryFlags;
 
+namespace {
+// Translations are cached per thread in a direct mapped table of small pages
+constexpr size_t TLB_SIZE = 256;
+
+struct TlbEntry {
+    size_t manager_id = std::numeric_limits<size_t>::max();
+    u64 generation = 0;
+    GPUVAddr gpu_page = 0;
+    DAddr dev_page = 0;
+};
+
+thread_local std::array<TlbEntry, TLB_SIZE> tlb{};
+
+// Statistics only, a plain increment avoids a locked instruction on every translation
+void Increment(std::atomic<u64>& counter) {
+    counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+} // Anonymous namespace
+
 std::atomic<size_t> MemoryManager::unique_identifier_generator{};
 
 MemoryManager::MemoryManager(Core::System& system_, MaxwellDeviceMemoryManager& memory_,
@@ -54,7 +75,14 @@ MemoryManager::MemoryManager(Core::System& system_, u64 address_space_bits_,
     : MemoryManager(system_, system_.Host1x().MemoryManager(), address_space_bits_, split_address_,
                     big_page_bits_, page_bits_) {}
 
-MemoryManager::~MemoryManager() = default;
+MemoryManager::~MemoryManager() {
+    const TlbStats stats = GetTlbStats();
+    if (const u64 total = stats.hits + stats.misses; total != 0) {
+        LOG_DEBUG(HW_GPU, "Address space {} translation cache hit rate {:.2f}% ({} of {})",
+                  unique_identifier, static_cast<double>(stats.hits) * 100.0 / total, stats.hits,
+                  total);
+    }
+}
 
 template <bool is_big_page>
 MemoryManager::EntryType MemoryManager::GetEntry(size_t position) const {
@@ -129,6 +157,7 @@ GPUVAddr MemoryManager::PageTableOp(GPUVAddr gpu_addr, [[maybe_unused]] DAddr de
         remaining_size -= page_size;
     }
     kind_map.Map(gpu_addr, gpu_addr + size, kind);
+    tlb_generation.fetch_add(1, std::memory_order_release);
     return gpu_addr;
 }
 
@@ -172,6 +201,7 @@ GPUVAddr MemoryManager::BigPageTableOp(GPUVAddr gpu_addr, [[maybe_unused]] DAddr
         std::unique_lock<std::mutex> lock(guard);
         kind_map.Map(gpu_addr, gpu_addr + size, kind);
     }
+    tlb_generation.fetch_add(1, std::memory_order_release);
     return gpu_addr;
 }
 
@@ -213,6 +243,29 @@ std::optional<DAddr> MemoryManager::GpuToCpuAddress(GPUVAddr gpu_addr) const {
     if (!IsWithinGPUAddressRange(gpu_addr)) [[unlikely]] {
         return std::nullopt;
     }
+    const u64 generation = tlb_generation.load(std::memory_order_acquire);
+    const GPUVAddr gpu_page = gpu_addr >> page_bits;
+    TlbEntry& entry = tlb[gpu_page % TLB_SIZE];
+    if (entry.manager_id == unique_identifier && entry.generation == generation &&
+        entry.gpu_page == gpu_page) [[likely]] {
+        Increment(tlb_hits);
+        return entry.dev_page + (gpu_addr & page_mask);
+    }
+    Increment(tlb_misses);
+    const std::optional<DAddr> dev_addr = TranslateAddress(gpu_addr);
+    if (dev_addr) {
+        // Pages of big pages are contiguous, so small page granularity works for both
+        entry = {
+            .manager_id = unique_identifier,
+            .generation = generation,
+            .gpu_page = gpu_page,
+            .dev_page = *dev_addr - (gpu_addr & page_mask),
+        };
+    }
+    return dev_addr;
+}
+
+std::optional<DAddr> MemoryManager::TranslateAddress(GPUVAddr gpu_addr) const {
     if (GetEntry<true>(gpu_addr) != EntryType::Mapped) [[unlikely]] {
         if (GetEntry<false>(gpu_addr) != EntryType::Mapped) {
             return std::nullopt;
@@ -784,4 +837,63 @@ u8* MemoryManager::GetSpan(const GPUVAddr src_addr, const std::size_t size) {
     return nullptr;
 }
 
+std::optional<MemoryManager::HostSpans> MemoryManager::GetSpans(GPUVAddr gpu_addr,
+                                                                std::size_t size) {
+    HostSpans spans;
+    bool is_mapped = true;
+    const auto append = [&](u8* ptr, std::size_t amount) {
+        if (!ptr) {
+            is_mapped = false;
+            return;
+        }
+        if (!spans.empty() && spans.back().data() + spans.back().size() == ptr) {
+            spans.back() = std::span<u8>(spans.back().data(), spans.back().size() + amount);
+            return;
+        }
+        spans.emplace_back(ptr, amount);
+    };
+    const auto append_device = [&](DAddr dev_addr, std::size_t amount) {
+        if (u8* const ptr = memory.GetSpan(dev_addr, amount); ptr) {
+            append(ptr, amount);
+            return !is_mapped;
+        }
+        // Split at device pages, they are not backed by continuous host memory
+        while (amount > 0 && is_mapped) {
+            const std::size_t page_amount{
+                std::min<std::size_t>(amount, cpu_page_size - (dev_addr & cpu_page_mask))};
+            append(memory.GetPointer<u8>(dev_addr), page_amount);
+            dev_addr += page_amount;
+            amount -= page_amount;
+        }
+        return !is_mapped;
+    };
+    auto not_mapped = [&]([[maybe_unused]] std::size_t page_index,
+                          [[maybe_unused]] std::size_t offset,
+                          [[maybe_unused]] std::size_t copy_amount) {
+        is_mapped = false;
+        return true;
+    };
+    auto mapped_normal = [&](std::size_t page_index, std::size_t offset, std::size_t copy_amount) {
+        const DAddr dev_addr_base =
+            (static_cast<DAddr>(page_table[page_index]) << cpu_page_bits) + offset;
+        return append_device(dev_addr_base, copy_amount);
+    };
+    auto mapped_big = [&](std::size_t page_index, std::size_t offset, std::size_t copy_amount) {
+        const DAddr dev_addr_base =
+            (static_cast<DAddr>(big_page_table_dev[page_index]) << cpu_page_bits) + offset;
+        return append_device(dev_addr_base, copy_amount);
+    };
+    auto get_short_pages = [&](std::size_t page_index, std::size_t offset,
+                               std::size_t copy_amount) {
+        GPUVAddr base = (page_index << big_page_bits) + offset;
+        MemoryOperation<false>(base, copy_amount, mapped_normal, not_mapped, not_mapped);
+        return !is_mapped;
+    };
+    MemoryOperation<true>(gpu_addr, size, mapped_big, not_mapped, get_short_pages);
+    if (!is_mapped) {
+        return std::nullopt;
+    }
+    return spans;
+}
+
 } // namespace Tegra
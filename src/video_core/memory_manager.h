@@ -7,6 +7,7 @@
 #include <map>
 #include <mutex>
 #include <optional>
+#include <span>
 #include <vector>
 #include <boost/container/small_vector.hpp>
 
@@ -54,6 +55,18 @@ public:
 
     [[nodiscard]] std::optional<DAddr> GpuToCpuAddress(GPUVAddr addr, std::size_t size) const;
 
+    struct TlbStats {
+        u64 hits;
+        u64 misses;
+    };
+
+    /// Returns the number of address translations served by the translation cache. Counters are
+    /// not synchronized between threads and may miss a few translations.
+    [[nodiscard]] TlbStats GetTlbStats() const noexcept {
+        return {tlb_hits.load(std::memory_order_relaxed),
+                tlb_misses.load(std::memory_order_relaxed)};
+    }
+
     template <typename T>
     [[nodiscard]] T Read(GPUVAddr addr) const;
 
@@ -157,6 +170,16 @@ public:
     const u8* GetSpan(const GPUVAddr src_addr, const std::size_t size) const;
     u8* GetSpan(const GPUVAddr src_addr, const std::size_t size);
 
+    using HostSpans = boost::container::small_vector<std::span<u8>, 16>;
+
+    /**
+     * Returns the host memory backing a gpu region as a list of spans, merging the pages that are
+     * adjacent in host memory. Unlike GetSpan, the region doesn't have to be continuous.
+     * Returns std::nullopt when any part of the region is not mapped. Like GetSpan, caches are
+     * neither flushed nor invalidated.
+     */
+    std::optional<HostSpans> GetSpans(GPUVAddr gpu_addr, std::size_t size);
+
 private:
     template <bool is_big_pages, typename FuncMapped, typename FuncReserved, typename FuncUnmapped>
     inline void MemoryOperation(GPUVAddr gpu_src_addr, std::size_t size, FuncMapped&& func_mapped,
@@ -200,6 +223,8 @@ private:
     u64 page_mask;
     u64 page_table_mask;
     static constexpr u64 cpu_page_bits{12};
+    static constexpr u64 cpu_page_size{1ULL << cpu_page_bits};
+    static constexpr u64 cpu_page_mask{cpu_page_size - 1};
 
     const u64 big_page_bits;
     u64 big_page_size;
@@ -231,6 +256,9 @@ private:
     template <bool is_big_page>
     inline void SetEntry(size_t position, EntryType entry);
 
+    /// Walks the page tables to translate an address
+    [[nodiscard]] std::optional<DAddr> TranslateAddress(GPUVAddr gpu_addr) const;
+
     Common::MultiLevelPageTable<u32> page_table;
     Common::RangeMap<GPUVAddr, PTEKind> kind_map;
     Common::VirtualBuffer<u32> big_page_table_dev;
@@ -246,6 +274,11 @@ private:
     const size_t unique_identifier;
     std::unique_ptr<VideoCommon::InvalidationAccumulator> accumulator;
 
+    /// Bumped on every page table change, translations cached before are discarded
+    std::atomic<u64> tlb_generation{1};
+    mutable std::atomic<u64> tlb_hits{};
+    mutable std::atomic<u64> tlb_misses{};
+
     static std::atomic<size_t> unique_identifier_generator;
 
     Common::ScratchBuffer<u8> tmp_buffer;
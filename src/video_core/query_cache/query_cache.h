@@ -5,10 +5,12 @@
 
 #include <array>
 #include <deque>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "common/assert.h"
 #include "common/common_types.h"
@@ -148,6 +150,46 @@ struct QueryCacheBase<Traits>::QueryCacheBaseImpl {
         ForEachStreamerIn(streamer_mask, func);
     }
 
+    struct DeferredGuestWrite {
+        u64 value;
+        u64 timestamp;
+        bool has_timestamp;
+
+        size_t Size() const {
+            return has_timestamp ? 16 : 4;
+        }
+    };
+
+    void DeferGuestWrite(DAddr address, const DeferredGuestWrite& write) {
+        std::optional<size_t> old_size;
+        {
+            std::scoped_lock lk(deferred_guard);
+            const auto [it, is_new] = deferred_guest_writes.try_emplace(address, write);
+            if (!is_new) {
+                old_size = it->second.Size();
+                it->second = write;
+            }
+        }
+        // Keep the pages cached, so CPU reads reach the rasterizer and flush the value
+        if (old_size) {
+            device_memory.UpdatePagesCachedCount(address, *old_size, -1);
+        }
+        device_memory.UpdatePagesCachedCount(address, write.Size(), 1);
+    }
+
+    template <typename Func>
+    void ForEachDeferredGuestWrite(DAddr addr, size_t size, Func&& func) {
+        // Writes are at most 16 bytes long, earlier ones can't overlap the region
+        auto it = deferred_guest_writes.lower_bound(addr > 16 ? addr - 16 : 0);
+        while (it != deferred_guest_writes.end() && it->first < addr + size) {
+            if (it->first + it->second.Size() <= addr) {
+                ++it;
+                continue;
+            }
+            it = func(it);
+        }
+    }
+
     QueryBase* ObtainQuery(QueryCacheBase<Traits>::QueryLocation location) {
         size_t which_stream = location.stream_id.Value();
         auto* streamer = streamers[which_stream];
@@ -167,6 +209,8 @@ struct QueryCacheBase<Traits>::QueryCacheBaseImpl {
     std::mutex flush_guard;
     std::deque<u64> flushes_pending;
     std::vector<QueryCacheBase<Traits>::QueryLocation> pending_unregister;
+    std::mutex deferred_guard;
+    std::map<DAddr, DeferredGuestWrite> deferred_guest_writes;
 };
 
 template <typename Traits>
@@ -243,6 +287,8 @@ void QueryCacheBase<Traits>::CounterReport(GPUVAddr addr, QueryType counter_type
         return;
     }
     DAddr cpu_addr = *cpu_addr_opt;
+    // The new report replaces any value still waiting to be written
+    FlushDeferredGuestWrites(cpu_addr, has_timestamp ? 16 : 4, false);
     const size_t new_query_id = streamer->WriteCounter(cpu_addr, has_timestamp, payload, subreport);
     auto* query = streamer->GetQuery(new_query_id);
     if (is_fence) {
@@ -258,8 +304,13 @@ void QueryCacheBase<Traits>::CounterReport(GPUVAddr addr, QueryType counter_type
     u8* pointer = impl->device_memory.template GetPointer<u8>(cpu_addr);
     u8* pointer_timestamp = impl->device_memory.template GetPointer<u8>(cpu_addr + 8);
     bool is_synced = !Settings::IsGPULevelHigh() && is_fence;
-    std::function<void()> operation([this, is_synced, streamer, query_base = query, query_location,
-                                     pointer, pointer_timestamp] {
+    // Host query results copied to GPU memory only reach guest memory once the CPU reads them,
+    // conditional rendering and other GPU reads use the copy in GPU memory.
+    const bool defer_guest_write = !Settings::IsGPULevelHigh() && !is_fence &&
+                                   True(query->flags & QueryFlagBits::IsHostManaged);
+    std::function<void()> operation([this, is_synced, defer_guest_write, streamer,
+                                     query_base = query, query_location, pointer,
+                                     pointer_timestamp] {
         if (True(query_base->flags & QueryFlagBits::IsInvalidated)) {
             if (!is_synced) [[likely]] {
                 impl->pending_unregister.push_back(query_location);
@@ -272,7 +323,16 @@ void QueryCacheBase<Traits>::CounterReport(GPUVAddr addr, QueryType counter_type
         }
         query_base->value += streamer->GetAmendValue();
         streamer->SetAccumulationValue(query_base->value);
-        if (True(query_base->flags & QueryFlagBits::HasTimestamp)) {
+        if (defer_guest_write && True(query_base->flags & QueryFlagBits::IsHostSynced) &&
+            False(query_base->flags & QueryFlagBits::IsRewritten)) {
+            const bool is_long = True(query_base->flags & QueryFlagBits::HasTimestamp);
+            impl->DeferGuestWrite(query_base->guest_address,
+                                  {
+                                      .value = query_base->value,
+                                      .timestamp = is_long ? impl->gpu.GetTicks() : 0,
+                                      .has_timestamp = is_long,
+                                  });
+        } else if (True(query_base->flags & QueryFlagBits::HasTimestamp)) {
             u64 timestamp = impl->gpu.GetTicks();
             std::memcpy(pointer_timestamp, &timestamp, sizeof(timestamp));
             std::memcpy(pointer, &query_base->value, sizeof(query_base->value));
@@ -350,6 +410,50 @@ void QueryCacheBase<Traits>::UnregisterPending() {
     impl->pending_unregister.clear();
 }
 
+template <typename Traits>
+bool QueryCacheBase<Traits>::HasDeferredGuestWrites(VAddr addr, size_t size) {
+    bool result = false;
+    std::scoped_lock lk(impl->deferred_guard);
+    impl->ForEachDeferredGuestWrite(addr, size, [&result](auto it) {
+        result = true;
+        return ++it;
+    });
+    return result;
+}
+
+template <typename Traits>
+void QueryCacheBase<Traits>::FlushDeferredGuestWrites(VAddr addr, size_t size,
+                                                      bool write_to_guest) {
+    std::vector<std::pair<DAddr, size_t>> uncached;
+    {
+        std::scoped_lock lk(impl->deferred_guard);
+        if (impl->deferred_guest_writes.empty()) [[likely]] {
+            return;
+        }
+        impl->ForEachDeferredGuestWrite(addr, size, [&](auto it) {
+            const DAddr address = it->first;
+            const auto& write = it->second;
+            if (write_to_guest) {
+                u8* pointer = impl->device_memory.template GetPointer<u8>(address);
+                if (write.has_timestamp) {
+                    u8* pointer_timestamp =
+                        impl->device_memory.template GetPointer<u8>(address + 8);
+                    std::memcpy(pointer_timestamp, &write.timestamp, sizeof(write.timestamp));
+                    std::memcpy(pointer, &write.value, sizeof(write.value));
+                } else {
+                    u32 value = static_cast<u32>(write.value);
+                    std::memcpy(pointer, &value, sizeof(value));
+                }
+            }
+            uncached.emplace_back(address, write.Size());
+            return impl->deferred_guest_writes.erase(it);
+        });
+    }
+    for (const auto& [address, write_size] : uncached) {
+        impl->device_memory.UpdatePagesCachedCount(address, write_size, -1);
+    }
+}
+
 template <typename Traits>
 void QueryCacheBase<Traits>::NotifyWFI() {
     bool should_sync = false;
@@ -388,6 +492,8 @@ bool QueryCacheBase<Traits>::AccelerateHostConditionalRendering() {
             };
         }
         VAddr cpu_addr = *cpu_addr_opt;
+        // Guest evaluated conditions read the values from guest memory
+        FlushDeferredGuestWrites(cpu_addr, 16, true);
         std::scoped_lock lock(cache_mutex);
         auto it1 = cached_queries.find(cpu_addr >> Core::DEVICE_PAGEBITS);
         if (it1 == cached_queries.end()) {
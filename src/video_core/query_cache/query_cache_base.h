@@ -55,11 +55,13 @@ public:
     ~QueryCacheBase();
 
     void InvalidateRegion(VAddr addr, std::size_t size) {
+        FlushDeferredGuestWrites(addr, size, false);
         IterateCache<true>(addr, size,
                            [this](QueryLocation location) { InvalidateQuery(location); });
     }
 
     void FlushRegion(VAddr addr, std::size_t size) {
+        FlushDeferredGuestWrites(addr, size, true);
         bool result = false;
         IterateCache<false>(addr, size, [this, &result](QueryLocation location) {
             result |= SemiFlushQueryDirty(location);
@@ -88,6 +90,9 @@ public:
         return result;
     }
 
+    /// Return true when query results in a CPU region are only written in host GPU memory
+    [[nodiscard]] bool HasDeferredGuestWrites(VAddr addr, size_t size);
+
     void CounterEnable(QueryType counter_type, bool is_enabled);
 
     void CounterReset(QueryType counter_type);
@@ -164,6 +169,7 @@ protected:
     bool SemiFlushQueryDirty(QueryLocation location);
     void RequestGuestHostSync();
     void UnregisterPending();
+    void FlushDeferredGuestWrites(VAddr addr, size_t size, bool write_to_guest);
 
     std::unordered_map<u64, std::unordered_map<u32, QueryLocation>> cached_queries;
     std::mutex cache_mutex;
@@ -14,6 +14,7 @@
 #include "video_core/gpu.h"
 #include "video_core/query_cache/types.h"
 #include "video_core/rasterizer_download_area.h"
+#include "video_core/video_frame_surface.h"
 
 namespace Tegra {
 class MemoryManager;
@@ -155,6 +156,18 @@ public:
     virtual void AccelerateInlineToMemory(GPUVAddr address, size_t copy_size,
                                           std::span<const u8> memory) = 0;
 
+    /// Return true when a video frame written to the surface can be written to its cached image
+    [[nodiscard]] virtual bool CanAccelerateVideoFrame(const VideoFrameSurface& surface) {
+        return false;
+    }
+
+    /// Attempt to write the linear pixels of a video frame to the cached image of its surface,
+    /// instead of the image uploading them from guest memory
+    [[nodiscard]] virtual bool AccelerateVideoFrame(const VideoFrameSurface& surface,
+                                                    std::span<const u8> pixels) {
+        return false;
+    }
+
     /// Initialize disk cached resources for the game being emulated
     virtual void LoadDiskResources(u64 title_id, std::stop_token stop_loading,
                                    const DiskResourceLoadCallback& callback) {}
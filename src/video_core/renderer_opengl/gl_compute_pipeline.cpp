@@ -3,9 +3,10 @@
 
 #include <cstring>
 
-#include "common/cityhash.h"
+#include "common/hash.h"
 #include "common/settings.h" // for enum class Settings::ShaderBackend
 #include "video_core/renderer_opengl/gl_compute_pipeline.h"
+#include "video_core/renderer_opengl/gl_program_binary_cache.h"
 #include "video_core/renderer_opengl/gl_shader_manager.h"
 #include "video_core/renderer_opengl/gl_shader_util.h"
 
@@ -19,8 +20,7 @@ constexpr u32 MAX_TEXTURES = 64;
 constexpr u32 MAX_IMAGES = 16;
 
 size_t ComputePipelineKey::Hash() const noexcept {
-    return static_cast<size_t>(
-        Common::CityHash64(reinterpret_cast<const char*>(this), sizeof *this));
+    return static_cast<size_t>(Common::HashBytes(this, sizeof *this));
 }
 
 bool ComputePipelineKey::operator==(const ComputePipelineKey& rhs) const noexcept {
@@ -29,19 +29,32 @@ bool ComputePipelineKey::operator==(const ComputePipelineKey& rhs) const noexcep
 
 ComputePipeline::ComputePipeline(const Device& device, TextureCache& texture_cache_,
                                  BufferCache& buffer_cache_, ProgramManager& program_manager_,
-                                 const Shader::Info& info_, std::string code,
-                                 std::vector<u32> code_v, bool force_context_flush)
+                                 ProgramBinaryCache* binary_cache, const Shader::Info& info_,
+                                 std::string code, std::vector<u32> code_v,
+                                 bool force_context_flush)
     : texture_cache{texture_cache_}, buffer_cache{buffer_cache_},
       program_manager{program_manager_}, info{info_} {
+    const auto create_program{[&](const auto& source) {
+        if (!binary_cache) {
+            source_program = CreateProgram(source, GL_COMPUTE_SHADER);
+            return;
+        }
+        const u64 hash{ProgramBinaryCache::Hash(source)};
+        source_program = binary_cache->TryCreate(hash);
+        if (source_program.handle == 0) {
+            source_program = CreateProgram(source, GL_COMPUTE_SHADER, true);
+            binary_cache->Store(hash, source_program.handle);
+        }
+    }};
     switch (device.GetShaderBackend()) {
     case Settings::ShaderBackend::Glsl:
-        source_program = CreateProgram(code, GL_COMPUTE_SHADER);
+        create_program(std::string_view{code});
         break;
     case Settings::ShaderBackend::Glasm:
         assembly_program = CompileProgram(code, GL_COMPUTE_PROGRAM_NV);
         break;
     case Settings::ShaderBackend::SpirV:
-        source_program = CreateProgram(code_v, GL_COMPUTE_SHADER);
+        create_program(std::span<const u32>{code_v});
         break;
     }
     std::copy_n(info.constant_buffer_used_sizes.begin(), uniform_buffer_sizes.size(),
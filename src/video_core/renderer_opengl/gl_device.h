@@ -196,6 +196,10 @@ public:
         return has_lmem_perf_bug;
     }
 
+    bool HasParallelShaderCompile() const {
+        return has_parallel_shader_compile;
+    }
+
 private:
     static bool TestVariableAoffi();
     static bool TestPreciseBug();
@@ -243,6 +247,7 @@ private:
     bool strict_context_required{};
     bool supports_conditional_barriers{};
     bool has_lmem_perf_bug{};
+    bool has_parallel_shader_compile{};
 
     std::string vendor_name;
 };
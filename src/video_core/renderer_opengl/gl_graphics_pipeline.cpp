@@ -10,6 +10,7 @@
 #include "common/thread_worker.h"
 #include "shader_recompiler/shader_info.h"
 #include "video_core/renderer_opengl/gl_graphics_pipeline.h"
+#include "video_core/renderer_opengl/gl_program_binary_cache.h"
 #include "video_core/renderer_opengl/gl_shader_manager.h"
 #include "video_core/renderer_opengl/gl_shader_util.h"
 #include "video_core/renderer_opengl/gl_state_tracker.h"
@@ -171,14 +172,15 @@ ConfigureFuncPtr ConfigureFunc(const std::array<Shader::Info, 5>& infos, u32 ena
 
 GraphicsPipeline::GraphicsPipeline(const Device& device, TextureCache& texture_cache_,
                                    BufferCache& buffer_cache_, ProgramManager& program_manager_,
-                                   StateTracker& state_tracker_, ShaderWorker* thread_worker,
+                                   StateTracker& state_tracker_, ShaderWorker* thread_worker_,
+                                   ProgramBinaryCache* binary_cache,
                                    VideoCore::ShaderNotify* shader_notify,
                                    std::array<std::string, 5> sources,
                                    std::array<std::vector<u32>, 5> sources_spirv,
                                    const std::array<const Shader::Info*, 5>& infos,
                                    const GraphicsPipelineKey& key_, bool force_context_flush)
     : texture_cache{texture_cache_}, buffer_cache{buffer_cache_}, program_manager{program_manager_},
-      state_tracker{state_tracker_}, key{key_} {
+      state_tracker{state_tracker_}, thread_worker{thread_worker_}, key{key_} {
     if (shader_notify) {
         shader_notify->MarkShaderBuilding();
     }
@@ -231,14 +233,31 @@ GraphicsPipeline::GraphicsPipeline(const Device& device, TextureCache& texture_c
         GenerateTransformFeedbackState();
     }
     const bool in_parallel = thread_worker != nullptr;
+    poll_completion = in_parallel && !assembly_shaders && device.HasParallelShaderCompile();
+    if (assembly_shaders) {
+        binary_cache = nullptr;
+    }
     auto func{[this, sources_ = std::move(sources), sources_spirv_ = std::move(sources_spirv),
-               shader_notify, backend, in_parallel,
+               shader_notify, backend, in_parallel, binary_cache,
                force_context_flush](ShaderContext::Context*) mutable {
+        std::array<u64, 5> binary_hashes{};
+        u32 uncached_stages_mask{};
+        const auto create_program{[&](size_t stage, const auto& code) {
+            if (binary_cache) {
+                binary_hashes[stage] = ProgramBinaryCache::Hash(code);
+                source_programs[stage] = binary_cache->TryCreate(binary_hashes[stage]);
+                if (source_programs[stage].handle != 0) {
+                    return;
+                }
+                uncached_stages_mask |= 1u << stage;
+            }
+            source_programs[stage] = CreateProgram(code, Stage(stage), binary_cache != nullptr);
+        }};
         for (size_t stage = 0; stage < 5; ++stage) {
             switch (backend) {
             case Settings::ShaderBackend::Glsl:
                 if (!sources_[stage].empty()) {
-                    source_programs[stage] = CreateProgram(sources_[stage], Stage(stage));
+                    create_program(stage, std::string_view{sources_[stage]});
                 }
                 break;
             case Settings::ShaderBackend::Glasm:
@@ -249,11 +268,17 @@ GraphicsPipeline::GraphicsPipeline(const Device& device, TextureCache& texture_c
                 break;
             case Settings::ShaderBackend::SpirV:
                 if (!sources_spirv_[stage].empty()) {
-                    source_programs[stage] = CreateProgram(sources_spirv_[stage], Stage(stage));
+                    create_program(stage, std::span<const u32>{sources_spirv_[stage]});
                 }
                 break;
             }
         }
+        // Retrieve binaries once every stage has been issued, so they can compile in parallel
+        for (size_t stage = 0; stage < 5; ++stage) {
+            if ((uncached_stages_mask & (1u << stage)) != 0) {
+                binary_cache->Store(binary_hashes[stage], source_programs[stage].handle);
+            }
+        }
         if (force_context_flush || in_parallel) {
             std::scoped_lock lock{built_mutex};
             built_fence.Create();
@@ -550,11 +575,11 @@ void GraphicsPipeline::ConfigureImpl(bool is_indexed) {
     }
     if (texture_binding != 0) {
         ASSERT(texture_binding == sampler_binding);
-        glBindTextures(0, texture_binding, textures.data());
-        glBindSamplers(0, sampler_binding, gl_samplers.data());
+        program_manager.BindGraphicsTextures(std::span(textures).first(texture_binding),
+                                             std::span(gl_samplers).first(sampler_binding));
     }
     if (image_binding != 0) {
-        glBindImageTextures(0, image_binding, images.data());
+        program_manager.BindGraphicsImages(std::span(images).first(image_binding));
     }
 }
 
@@ -616,8 +641,13 @@ void GraphicsPipeline::GenerateTransformFeedbackState() {
 
 void GraphicsPipeline::WaitForBuild() {
     if (built_fence.handle == 0) {
-        std::unique_lock lock{built_mutex};
-        built_condvar.wait(lock, [this] { return built_fence.handle != 0; });
+        // Hold back background precompilation until this pipeline is ready
+        thread_worker->BeginForegroundWait();
+        {
+            std::unique_lock lock{built_mutex};
+            built_condvar.wait(lock, [this] { return built_fence.handle != 0; });
+        }
+        thread_worker->EndForegroundWait();
     }
     ASSERT(glClientWaitSync(built_fence.handle, 0, GL_TIMEOUT_IGNORED) != GL_WAIT_FAILED);
     is_built = true;
@@ -630,8 +660,22 @@ bool GraphicsPipeline::IsBuilt() noexcept {
     if (built_fence.handle == 0) {
         return false;
     }
-    is_built = built_fence.IsSignaled();
+    is_built = built_fence.IsSignaled() && (!poll_completion || IsCompilationComplete());
     return is_built;
 }
 
+bool GraphicsPipeline::IsCompilationComplete() const noexcept {
+    for (const OGLProgram& program : source_programs) {
+        if (program.handle == 0) {
+            continue;
+        }
+        GLint is_complete{};
+        glGetProgramiv(program.handle, GL_COMPLETION_STATUS_KHR, &is_complete);
+        if (is_complete == GL_FALSE) {
+            return false;
+        }
+    }
+    return true;
+}
+
 } // namespace OpenGL
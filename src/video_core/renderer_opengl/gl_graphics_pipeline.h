@@ -9,8 +9,8 @@
 #include <utility>
 
 #include "common/bit_field.h"
-#include "common/cityhash.h"
 #include "common/common_types.h"
+#include "common/hash.h"
 #include "shader_recompiler/shader_info.h"
 #include "video_core/engines/maxwell_3d.h"
 #include "video_core/renderer_opengl/gl_buffer_cache.h"
@@ -25,6 +25,7 @@ struct Context;
 }
 
 class Device;
+class ProgramBinaryCache;
 class ProgramManager;
 
 using Maxwell = Tegra::Engines::Maxwell3D::Regs;
@@ -46,7 +47,7 @@ struct GraphicsPipelineKey {
     VideoCommon::TransformFeedbackState xfb_state;
 
     size_t Hash() const noexcept {
-        return static_cast<size_t>(Common::CityHash64(reinterpret_cast<const char*>(this), Size()));
+        return static_cast<size_t>(Common::HashBytes(this, Size()));
     }
 
     bool operator==(const GraphicsPipelineKey& rhs) const noexcept {
@@ -74,6 +75,7 @@ public:
     explicit GraphicsPipeline(const Device& device, TextureCache& texture_cache_,
                               BufferCache& buffer_cache_, ProgramManager& program_manager_,
                               StateTracker& state_tracker_, ShaderWorker* thread_worker,
+                              ProgramBinaryCache* binary_cache,
                               VideoCore::ShaderNotify* shader_notify,
                               std::array<std::string, 5> sources,
                               std::array<std::vector<u32>, 5> sources_spirv,
@@ -126,12 +128,16 @@ private:
 
     void WaitForBuild();
 
+    /// Returns true when the driver has finished compiling the programs in the background
+    [[nodiscard]] bool IsCompilationComplete() const noexcept;
+
     TextureCache& texture_cache;
     BufferCache& buffer_cache;
     Tegra::MemoryManager* gpu_memory;
     Tegra::Engines::Maxwell3D* maxwell3d;
     ProgramManager& program_manager;
     StateTracker& state_tracker;
+    ShaderWorker* thread_worker;
     const GraphicsPipelineKey key;
 
     void (*configure_func)(GraphicsPipeline*, bool){};
@@ -161,6 +167,7 @@ private:
     std::condition_variable built_condvar;
     OGLSync built_fence{};
     bool is_built{false};
+    bool poll_completion{false};
 };
 
 } // namespace OpenGL
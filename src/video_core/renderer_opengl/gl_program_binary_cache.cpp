@@ -0,0 +1,165 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <fstream>
+#include <string>
+
+#include "common/cityhash.h"
+#include "common/fs/fs.h"
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
+#include "video_core/renderer_opengl/gl_program_binary_cache.h"
+
+namespace OpenGL {
+namespace {
+constexpr std::array<char, 8> MAGIC_NUMBER{'y', 'u', 'z', 'u', 'b', 'i', 'n', 's'};
+constexpr u32 CACHE_VERSION = 1;
+
+std::string_view GetString(GLenum name) {
+    const auto* const string = reinterpret_cast<const char*>(glGetString(name));
+    return string ? string : "";
+}
+} // Anonymous namespace
+
+ProgramBinaryCache::ProgramBinaryCache() {
+    std::string driver{GetString(GL_VENDOR)};
+    driver += GetString(GL_RENDERER);
+    driver += GetString(GL_VERSION);
+    driver_hash = Common::CityHash64(driver.data(), driver.size());
+}
+
+void ProgramBinaryCache::Load(const std::filesystem::path& filename_) try {
+    std::scoped_lock lock{mutex};
+    filename = filename_;
+    binaries.clear();
+
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        return;
+    }
+    file.exceptions(std::ifstream::failbit);
+    const auto end{file.tellg()};
+    file.seekg(0, std::ios::beg);
+
+    std::array<char, 8> magic_number;
+    u32 cache_version;
+    u64 file_driver_hash;
+    file.read(magic_number.data(), magic_number.size())
+        .read(reinterpret_cast<char*>(&cache_version), sizeof(cache_version))
+        .read(reinterpret_cast<char*>(&file_driver_hash), sizeof(file_driver_hash));
+    if (magic_number != MAGIC_NUMBER || cache_version != CACHE_VERSION ||
+        file_driver_hash != driver_hash) {
+        file.close();
+        LOG_INFO(Render_OpenGL, "Deleting program binaries of a different driver or version");
+        if (!Common::FS::RemoveFile(filename)) {
+            LOG_ERROR(Common_Filesystem, "Failed to delete program binary cache file {}",
+                      Common::FS::PathToUTF8String(filename));
+        }
+        return;
+    }
+    while (file.tellg() != end) {
+        u64 hash;
+        Binary binary;
+        u32 size;
+        file.read(reinterpret_cast<char*>(&hash), sizeof(hash))
+            .read(reinterpret_cast<char*>(&binary.format), sizeof(binary.format))
+            .read(reinterpret_cast<char*>(&size), sizeof(size));
+        binary.data.resize(size);
+        file.read(reinterpret_cast<char*>(binary.data.data()), size);
+        binaries.insert_or_assign(hash, std::move(binary));
+    }
+    LOG_INFO(Render_OpenGL, "Loaded {} program binaries", binaries.size());
+
+} catch (const std::ios_base::failure& e) {
+    LOG_ERROR(Common_Filesystem, "{}", e.what());
+    binaries.clear();
+    if (!Common::FS::RemoveFile(filename)) {
+        LOG_ERROR(Common_Filesystem, "Failed to delete program binary cache file {}",
+                  Common::FS::PathToUTF8String(filename));
+    }
+}
+
+OGLProgram ProgramBinaryCache::TryCreate(u64 hash) {
+    OGLProgram program;
+    {
+        std::scoped_lock lock{mutex};
+        const auto it{binaries.find(hash)};
+        if (it == binaries.end()) {
+            return program;
+        }
+        program.handle = glCreateProgram();
+        glProgramBinary(program.handle, it->second.format, it->second.data.data(),
+                        static_cast<GLsizei>(it->second.data.size()));
+    }
+    GLint link_status{};
+    glGetProgramiv(program.handle, GL_LINK_STATUS, &link_status);
+    if (link_status == GL_FALSE) {
+        // The driver rejected the binary, build the program from its code again
+        program.Release();
+        std::scoped_lock lock{mutex};
+        binaries.erase(hash);
+    }
+    return program;
+}
+
+void ProgramBinaryCache::Store(u64 hash, GLuint program) {
+    {
+        std::scoped_lock lock{mutex};
+        if (filename.empty() || binaries.contains(hash)) {
+            return;
+        }
+    }
+    GLint link_status{};
+    glGetProgramiv(program, GL_LINK_STATUS, &link_status);
+    GLint length{};
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (link_status == GL_FALSE || length <= 0) {
+        return;
+    }
+    Binary binary{.format = 0, .data = std::vector<u8>(static_cast<size_t>(length))};
+    glGetProgramBinary(program, length, nullptr, &binary.format, binary.data.data());
+
+    std::scoped_lock lock{mutex};
+    const auto [it, is_new]{binaries.try_emplace(hash, std::move(binary))};
+    if (is_new) {
+        Append(hash, it->second);
+    }
+}
+
+u64 ProgramBinaryCache::Hash(std::string_view code) {
+    return Common::CityHash64(code.data(), code.size());
+}
+
+u64 ProgramBinaryCache::Hash(std::span<const u32> code) {
+    return Common::CityHash64(reinterpret_cast<const char*>(code.data()), code.size_bytes());
+}
+
+void ProgramBinaryCache::Append(u64 hash, const Binary& binary) try {
+    std::ofstream file(filename, std::ios::binary | std::ios::ate | std::ios::app);
+    file.exceptions(std::ifstream::failbit);
+    if (!file.is_open()) {
+        LOG_ERROR(Common_Filesystem, "Failed to open program binary cache file {}",
+                  Common::FS::PathToUTF8String(filename));
+        return;
+    }
+    if (file.tellp() == 0) {
+        file.write(MAGIC_NUMBER.data(), MAGIC_NUMBER.size())
+            .write(reinterpret_cast<const char*>(&CACHE_VERSION), sizeof(CACHE_VERSION))
+            .write(reinterpret_cast<const char*>(&driver_hash), sizeof(driver_hash));
+    }
+    const u32 size{static_cast<u32>(binary.data.size())};
+    file.write(reinterpret_cast<const char*>(&hash), sizeof(hash))
+        .write(reinterpret_cast<const char*>(&binary.format), sizeof(binary.format))
+        .write(reinterpret_cast<const char*>(&size), sizeof(size))
+        .write(reinterpret_cast<const char*>(binary.data.data()), size);
+
+} catch (const std::ios_base::failure& e) {
+    LOG_ERROR(Common_Filesystem, "{}", e.what());
+    if (!Common::FS::RemoveFile(filename)) {
+        LOG_ERROR(Common_Filesystem, "Failed to delete program binary cache file {}",
+                  Common::FS::PathToUTF8String(filename));
+    }
+}
+
+} // namespace OpenGL
@@ -0,0 +1,58 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <filesystem>
+#include <mutex>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include "common/common_types.h"
+#include "video_core/renderer_opengl/gl_resource_manager.h"
+
+namespace OpenGL {
+
+/**
+ * Disk cache of linked program binaries, keyed by a hash of the code they were built from.
+ * Binaries are only valid for the driver that produced them, the cache is discarded when the
+ * driver changes. Lives next to the transferable pipeline cache of each title.
+ */
+class ProgramBinaryCache {
+public:
+    /// Must be created with a context current, it identifies the driver from it
+    ProgramBinaryCache();
+
+    /// Load the binaries stored in a file, new binaries are appended to it
+    void Load(const std::filesystem::path& filename);
+
+    /// Create a program from a cached binary, returns an empty program on a miss
+    [[nodiscard]] OGLProgram TryCreate(u64 hash);
+
+    /// Store the binary of a program, blocking until it has linked
+    void Store(u64 hash, GLuint program);
+
+    [[nodiscard]] static u64 Hash(std::string_view code);
+
+    [[nodiscard]] static u64 Hash(std::span<const u32> code);
+
+private:
+    struct Binary {
+        GLenum format;
+        std::vector<u8> data;
+    };
+
+    void Append(u64 hash, const Binary& binary);
+
+    u64 driver_hash{};
+
+    std::mutex mutex;
+    std::filesystem::path filename;
+    std::unordered_map<u64, Binary> binaries;
+};
+
+} // namespace OpenGL
@@ -696,6 +696,8 @@ void RasterizerOpenGL::TickFrame() {
         std::scoped_lock lock{buffer_cache.mutex};
         buffer_cache.TickFrame();
     }
+    // Deleted textures are unbound by the driver, and their names can be reused
+    program_manager.InvalidateTextureBindings();
 }
 
 bool RasterizerOpenGL::AccelerateConditionalRendering() {
@@ -748,6 +750,17 @@ void RasterizerOpenGL::AccelerateInlineToMemory(GPUVAddr address, size_t copy_si
     query_cache.InvalidateRegion(*cpu_addr, copy_size);
 }
 
+bool RasterizerOpenGL::CanAccelerateVideoFrame(const VideoCore::VideoFrameSurface& surface) {
+    std::scoped_lock lock{texture_cache.mutex};
+    return texture_cache.IsVideoFrameCached(surface);
+}
+
+bool RasterizerOpenGL::AccelerateVideoFrame(const VideoCore::VideoFrameSurface& surface,
+                                            std::span<const u8> pixels) {
+    std::scoped_lock lock{texture_cache.mutex};
+    return texture_cache.WriteVideoFrame(surface, pixels);
+}
+
 std::optional<FramebufferTextureInfo> RasterizerOpenGL::AccelerateDisplay(
     const Tegra::FramebufferConfig& config, DAddr framebuffer_addr, u32 pixel_stride) {
     if (framebuffer_addr == 0) {
@@ -1392,6 +1405,8 @@ void RasterizerOpenGL::ReleaseChannel(s32 channel_id) {
 
 void RasterizerOpenGL::RegisterTransformFeedback(GPUVAddr tfb_object_addr) {
     buffer_cache_runtime.BindTransformFeedbackObject(tfb_object_addr);
+    // Buffer bindings are part of the transform feedback object
+    maxwell3d->dirty.flags[VideoCommon::Dirty::TransformFeedbackBuffers] = true;
 }
 
 AccelerateDMA::AccelerateDMA(BufferCache& buffer_cache_, TextureCache& texture_cache_)
@@ -1412,11 +1427,14 @@ bool AccelerateDMA::DmaBufferImageCopy(const Tegra::DMA::ImageCopy& copy_info,
                                        const Tegra::DMA::BufferOperand& buffer_operand,
                                        const Tegra::DMA::ImageOperand& image_operand) {
     std::scoped_lock lock{buffer_cache.mutex, texture_cache.mutex};
-    const auto image_id = texture_cache.DmaImageId(image_operand, IS_IMAGE_UPLOAD);
+    const u32 buffer_size = static_cast<u32>(buffer_operand.pitch * buffer_operand.height);
+    const bool is_buffer_resident =
+        buffer_cache.DMAIsRegionRegistered(buffer_operand.address, buffer_size);
+    const auto image_id =
+        texture_cache.DmaImageId(image_operand, IS_IMAGE_UPLOAD, is_buffer_resident);
     if (image_id == VideoCommon::NULL_IMAGE_ID) {
         return false;
     }
-    const u32 buffer_size = static_cast<u32>(buffer_operand.pitch * buffer_operand.height);
     static constexpr auto sync_info = VideoCommon::ObtainBufferSynchronize::FullSynchronize;
     const auto post_op = IS_IMAGE_UPLOAD ? VideoCommon::ObtainBufferOperation::DoNothing
                                          : VideoCommon::ObtainBufferOperation::MarkAsWritten;
@@ -123,6 +123,9 @@ public:
     Tegra::Engines::AccelerateDMAInterface& AccessAccelerateDMA() override;
     void AccelerateInlineToMemory(GPUVAddr address, size_t copy_size,
                                   std::span<const u8> memory) override;
+    bool CanAccelerateVideoFrame(const VideoCore::VideoFrameSurface& surface) override;
+    bool AccelerateVideoFrame(const VideoCore::VideoFrameSurface& surface,
+                              std::span<const u8> pixels) override;
     void LoadDiskResources(u64 title_id, std::stop_token stop_loading,
                            const VideoCore::DiskResourceLoadCallback& callback) override;
 
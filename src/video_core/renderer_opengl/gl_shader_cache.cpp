@@ -248,6 +248,10 @@ ShaderCache::ShaderCache(Tegra::MaxwellDeviceMemoryManager& device_memory_,
           .support_geometry_shader_passthrough = device.HasGeometryShaderPassthrough(),
           .support_conditional_barrier = device.SupportsConditionalBarriers(),
       } {
+    if (device.HasParallelShaderCompile()) {
+        // Let the driver spread the compilation of programs across as many threads as it likes
+        glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+    }
     if (use_asynchronous_shaders) {
         workers = CreateWorkers();
     }
@@ -267,6 +271,9 @@ void ShaderCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading,
         return;
     }
     shader_cache_filename = base_dir / "opengl.bin";
+    if (BinaryCache()) {
+        program_binary_cache.Load(base_dir / "opengl_binaries.bin");
+    }
 
     if (!workers && !strict_context_required) {
         workers = CreateWorkers();
@@ -287,10 +294,10 @@ void ShaderCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading,
         if (strict_context_required) {
             work(&strict_context.value());
         } else {
-            workers->QueueWork(std::move(work));
+            workers->QueueWork(std::move(work), Common::WorkLane::Background);
         }
     }};
-    const auto load_compute{[&](std::ifstream& file, FileEnvironment env) {
+    const auto load_compute{[&](std::istream& file, FileEnvironment env) {
         ComputePipelineKey key;
         file.read(reinterpret_cast<char*>(&key), sizeof(key));
         queue_work([this, key, env_ = std::move(env), &state, &callback](Context* ctx) mutable {
@@ -307,7 +314,7 @@ void ShaderCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading,
         });
         ++state.total;
     }};
-    const auto load_graphics{[&](std::ifstream& file, std::vector<FileEnvironment> envs) {
+    const auto load_graphics{[&](std::istream& file, std::vector<FileEnvironment> envs) {
         GraphicsPipelineKey key;
         file.read(reinterpret_cast<char*>(&key), sizeof(key));
         queue_work([this, key, envs_ = std::move(envs), &state, &callback](Context* ctx) mutable {
@@ -341,6 +348,7 @@ void ShaderCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading,
         return;
     }
     workers->WaitForRequests(stop_loading);
+    VideoCommon::LogWorkerStatistics(*workers);
     if (!use_asynchronous_shaders) {
         workers.reset();
     }
@@ -450,6 +458,7 @@ std::unique_ptr<GraphicsPipeline> ShaderCache::CreateGraphicsPipeline(
     ShaderContext::ShaderPools& pools, const GraphicsPipelineKey& key,
     std::span<Shader::Environment* const> envs, bool use_shader_workers,
     bool force_context_flush) try {
+    const Shader::ScratchArena::Scope scratch_scope{pools.arena};
     auto hash = key.Hash();
     LOG_INFO(Render_OpenGL, "0x{:016x}", hash);
     size_t env_index{};
@@ -544,8 +553,9 @@ std::unique_ptr<GraphicsPipeline> ShaderCache::CreateGraphicsPipeline(
     }
     auto* const thread_worker{use_shader_workers ? workers.get() : nullptr};
     return std::make_unique<GraphicsPipeline>(device, texture_cache, buffer_cache, program_manager,
-                                              state_tracker, thread_worker, &shader_notify, sources,
-                                              sources_spirv, infos, key, force_context_flush);
+                                              state_tracker, thread_worker, BinaryCache(),
+                                              &shader_notify, sources, sources_spirv, infos, key,
+                                              force_context_flush);
 
 } catch (Shader::Exception& exception) {
     LOG_ERROR(Render_OpenGL, "{}", exception.what());
@@ -572,6 +582,7 @@ std::unique_ptr<ComputePipeline> ShaderCache::CreateComputePipeline(
 std::unique_ptr<ComputePipeline> ShaderCache::CreateComputePipeline(
     ShaderContext::ShaderPools& pools, const ComputePipelineKey& key, Shader::Environment& env,
     bool force_context_flush) try {
+    const Shader::ScratchArena::Scope scratch_scope{pools.arena};
     auto hash = key.Hash();
     LOG_INFO(Render_OpenGL, "0x{:016x}", hash);
 
@@ -601,7 +612,8 @@ std::unique_ptr<ComputePipeline> ShaderCache::CreateComputePipeline(
     }
 
     return std::make_unique<ComputePipeline>(device, texture_cache, buffer_cache, program_manager,
-                                             program.info, code, code_spirv, force_context_flush);
+                                             BinaryCache(), program.info, code, code_spirv,
+                                             force_context_flush);
 } catch (Shader::Exception& exception) {
     LOG_ERROR(Render_OpenGL, "{}", exception.what());
     return nullptr;
@@ -613,4 +625,11 @@ std::unique_ptr<ShaderWorker> ShaderCache::CreateWorkers() const {
                                           [this] { return Context{emu_window}; });
 }
 
+ProgramBinaryCache* ShaderCache::BinaryCache() {
+    if (device.GetShaderBackend() == Settings::ShaderBackend::Glasm) {
+        return nullptr;
+    }
+    return &program_binary_cache;
+}
+
 } // namespace OpenGL
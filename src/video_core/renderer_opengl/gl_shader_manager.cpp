@@ -1,8 +1,12 @@
 // SPDX-FileCopyrightText: Copyright 2018 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+
 #include <glad/glad.h>
 
+#include "common/assert.h"
+
 #include "video_core/host_shaders/opengl_lmem_warmup_comp.h"
 #include "video_core/renderer_opengl/gl_shader_manager.h"
 #include "video_core/renderer_opengl/gl_shader_util.h"
@@ -28,9 +32,12 @@ ProgramManager::ProgramManager(const Device& device) {
 void ProgramManager::BindComputeProgram(GLuint program) {
     glUseProgram(program);
     is_compute_bound = true;
+    // Compute passes bind their own textures
+    InvalidateTextureBindings();
 }
 
 void ProgramManager::BindComputeAssemblyProgram(GLuint program) {
+    InvalidateTextureBindings();
     if (current_assembly_compute_program != program) {
         current_assembly_compute_program = program;
         glBindProgramARB(GL_COMPUTE_PROGRAM_NV, program);
@@ -53,6 +60,8 @@ void ProgramManager::BindSourcePrograms(std::span<const OGLProgram, NUM_STAGES>
 }
 
 void ProgramManager::BindPresentPrograms(GLuint vertex, GLuint fragment) {
+    // Blits and presentation bind their own textures
+    InvalidateTextureBindings();
     if (current_programs[0] != vertex) {
         current_programs[0] = vertex;
         glUseProgramStages(pipeline.handle, GL_VERTEX_SHADER_BIT, vertex);
@@ -102,6 +111,39 @@ void ProgramManager::BindAssemblyPrograms(std::span<const OGLAssemblyProgram, NU
     UnbindPipeline();
 }
 
+void ProgramManager::BindGraphicsTextures(std::span<const GLuint> textures,
+                                          std::span<const GLuint> samplers) {
+    ASSERT(textures.size() == samplers.size() && textures.size() <= MAX_GRAPHICS_TEXTURES);
+    const size_t count = textures.size();
+    if (count == num_bound_textures &&
+        std::ranges::equal(textures, std::span(bound_textures).first(count)) &&
+        std::ranges::equal(samplers, std::span(bound_samplers).first(count))) {
+        return;
+    }
+    std::ranges::copy(textures, bound_textures.begin());
+    std::ranges::copy(samplers, bound_samplers.begin());
+    num_bound_textures = count;
+    glBindTextures(0, static_cast<GLsizei>(count), textures.data());
+    glBindSamplers(0, static_cast<GLsizei>(count), samplers.data());
+}
+
+void ProgramManager::BindGraphicsImages(std::span<const GLuint> images) {
+    ASSERT(images.size() <= MAX_GRAPHICS_IMAGES);
+    const size_t count = images.size();
+    if (count == num_bound_images &&
+        std::ranges::equal(images, std::span(bound_images).first(count))) {
+        return;
+    }
+    std::ranges::copy(images, bound_images.begin());
+    num_bound_images = count;
+    glBindImageTextures(0, static_cast<GLsizei>(count), images.data());
+}
+
+void ProgramManager::InvalidateTextureBindings() {
+    num_bound_textures = 0;
+    num_bound_images = 0;
+}
+
 void ProgramManager::RestoreGuestCompute() {}
 
 void ProgramManager::LocalMemoryWarmup() {
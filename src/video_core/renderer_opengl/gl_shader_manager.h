@@ -13,6 +13,8 @@ namespace OpenGL {
 
 class ProgramManager {
     static constexpr size_t NUM_STAGES = 5;
+    static constexpr size_t MAX_GRAPHICS_TEXTURES = 64;
+    static constexpr size_t MAX_GRAPHICS_IMAGES = 8;
 
 public:
     explicit ProgramManager(const Device& device);
@@ -28,6 +30,15 @@ public:
     void BindAssemblyPrograms(std::span<const OGLAssemblyProgram, NUM_STAGES> programs,
                               u32 stage_mask);
 
+    /// Binds the textures and samplers of a graphics pipeline, skipped when they are still bound
+    void BindGraphicsTextures(std::span<const GLuint> textures, std::span<const GLuint> samplers);
+
+    /// Binds the images of a graphics pipeline, skipped when they are still bound
+    void BindGraphicsImages(std::span<const GLuint> images);
+
+    /// Forgets the bound textures, call when the objects they may name have been deleted
+    void InvalidateTextureBindings();
+
     void RestoreGuestCompute();
 
     void LocalMemoryWarmup();
@@ -47,6 +58,12 @@ private:
     std::array<GLuint, NUM_STAGES> current_programs{};
     GLuint current_assembly_compute_program = 0;
     OGLProgram lmem_warmup_program;
+
+    std::array<GLuint, MAX_GRAPHICS_TEXTURES> bound_textures{};
+    std::array<GLuint, MAX_GRAPHICS_TEXTURES> bound_samplers{};
+    std::array<GLuint, MAX_GRAPHICS_IMAGES> bound_images{};
+    size_t num_bound_textures = 0;
+    size_t num_bound_images = 0;
 };
 
 } // namespace OpenGL
@@ -12,9 +12,10 @@
 
 namespace OpenGL {
 
-OGLProgram CreateProgram(std::string_view code, GLenum stage);
+/// Compile and link a separable program, a retrievable one can have its binary cached
+OGLProgram CreateProgram(std::string_view code, GLenum stage, bool retrievable = false);
 
-OGLProgram CreateProgram(std::span<const u32> code, GLenum stage);
+OGLProgram CreateProgram(std::span<const u32> code, GLenum stage, bool retrievable = false);
 
 OGLAssemblyProgram CompileProgram(std::string_view code, GLenum target);
 
@@ -11,6 +11,7 @@
 #include "common/assert.h"
 #include "common/bit_util.h"
 #include "common/microprofile.h"
+#include "common/perf_metrics.h"
 #include "video_core/renderer_opengl/gl_staging_buffer_pool.h"
 
 MICROPROFILE_DEFINE(OpenGL_BufferRequest, "OpenGL", "BufferRequest", MP_RGB(128, 128, 192));
@@ -146,10 +147,12 @@ std::pair<std::span<u8>, size_t> StreamBuffer::Request(size_t size) noexcept {
 }
 
 StagingBufferMap StagingBufferPool::RequestUploadBuffer(size_t size) {
+    Common::PerfMetrics::Add(Common::PerfMetrics::Counter::StagingBytes, size);
     return upload_buffers.RequestMap(size, true);
 }
 
 StagingBufferMap StagingBufferPool::RequestDownloadBuffer(size_t size, bool deferred) {
+    Common::PerfMetrics::Add(Common::PerfMetrics::Counter::StagingBytes, size);
     return download_buffers.RequestMap(size, false, deferred);
 }
 
@@ -279,6 +279,15 @@ FormatInfo SurfaceFormat(const Device& device, FormatType format_type, bool with
         } else {
             tuple.format = VK_FORMAT_A8B8G8R8_UNORM_PACK32;
         }
+        // BC1 to BC5 can be decoded on the GPU into storage images
+        const bool is_gpu_decodable =
+            pixel_format != PixelFormat::BC6H_SFLOAT && pixel_format != PixelFormat::BC6H_UFLOAT &&
+            pixel_format != PixelFormat::BC7_UNORM && pixel_format != PixelFormat::BC7_SRGB;
+        if (is_gpu_decodable && !is_srgb &&
+            device.IsFormatSupported(tuple.format, VK_FORMAT_FEATURE_STORAGE_IMAGE_BIT,
+                                     FormatType::Optimal)) {
+            tuple.usage |= Storage;
+        }
     }
     const bool attachable = (tuple.usage & Attachable) != 0;
     const bool storage = (tuple.usage & Storage) != 0;
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <cstddef>
+#include <vector>
 
 #include <boost/container/small_vector.hpp>
 
@@ -28,6 +29,36 @@ public:
                num_descriptors <= device->MaxPushDescriptors();
     }
 
+    bool CanUseDynamicUniformBuffers() const noexcept {
+        return num_uniform_buffers > 0 &&
+               num_uniform_buffers <= device->GetMaxDescriptorSetUniformBuffersDynamic();
+    }
+
+    /// Turns the uniform buffers into dynamic descriptors, their offsets are then given on bind
+    void UseDynamicUniformBuffers() {
+        for (VkDescriptorSetLayoutBinding& layout_binding : bindings) {
+            if (layout_binding.descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER) {
+                layout_binding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+            }
+        }
+        for (VkDescriptorUpdateTemplateEntry& entry : entries) {
+            if (entry.descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER) {
+                entry.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+            }
+        }
+    }
+
+    /// Returns the type of each descriptor, in the order they are pushed to the descriptor queue
+    std::vector<VkDescriptorType> DescriptorTypes() const {
+        std::vector<VkDescriptorType> types;
+        types.reserve(num_descriptors);
+        for (const VkDescriptorSetLayoutBinding& layout_binding : bindings) {
+            types.insert(types.end(), layout_binding.descriptorCount,
+                         layout_binding.descriptorType);
+        }
+        return types;
+    }
+
     vk::DescriptorSetLayout CreateDescriptorSetLayout(bool use_push_descriptor) const {
         if (bindings.empty()) {
             return nullptr;
@@ -60,7 +91,8 @@ public:
             .pDescriptorUpdateEntries = entries.data(),
             .templateType = type,
             .descriptorSetLayout = descriptor_set_layout,
-            .pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS,
+            .pipelineBindPoint =
+                is_compute ? VK_PIPELINE_BIND_POINT_COMPUTE : VK_PIPELINE_BIND_POINT_GRAPHICS,
             .pipelineLayout = pipeline_layout,
             .set = 0,
         });
@@ -121,6 +153,9 @@ private:
             });
             ++binding;
             num_descriptors += descriptors[i].count;
+            if (type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER) {
+                num_uniform_buffers += descriptors[i].count;
+            }
             offset += sizeof(DescriptorUpdateEntry);
         }
     }
@@ -131,6 +166,7 @@ private:
     boost::container::small_vector<VkDescriptorUpdateTemplateEntry, 32> entries;
     u32 binding{};
     u32 num_descriptors{};
+    u32 num_uniform_buffers{};
     size_t offset{};
 };
 
@@ -22,7 +22,6 @@ public:
 
 private:
     void CreateImages();
-    void CreateRenderPasses();
     void CreateSampler();
     void CreateShaders();
     void CreateDescriptorPool();
@@ -39,28 +38,18 @@ private:
     const size_t m_image_count;
     const VkExtent2D m_extent;
 
-    enum FsrStage {
-        Easu,
-        Rcas,
-        MaxFsrStage,
-    };
-
     vk::DescriptorPool m_descriptor_pool;
     vk::DescriptorSetLayout m_descriptor_set_layout;
     vk::PipelineLayout m_pipeline_layout;
-    vk::ShaderModule m_vert_shader;
-    vk::ShaderModule m_easu_shader;
-    vk::ShaderModule m_rcas_shader;
-    vk::Pipeline m_easu_pipeline;
-    vk::Pipeline m_rcas_pipeline;
-    vk::RenderPass m_renderpass;
+    vk::ShaderModule m_shader;
+    vk::Pipeline m_pipeline;
     vk::Sampler m_sampler;
 
+    // EASU and RCAS run in one compute dispatch, only the sharpened output is stored
     struct Images {
         vk::DescriptorSets descriptor_sets;
-        std::array<vk::Image, MaxFsrStage> images;
-        std::array<vk::ImageView, MaxFsrStage> image_views;
-        std::array<vk::Framebuffer, MaxFsrStage> framebuffers;
+        vk::Image image;
+        vk::ImageView image_view;
     };
     std::vector<Images> m_dynamic_images;
     bool m_images_ready{};
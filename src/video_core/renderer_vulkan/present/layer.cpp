@@ -4,6 +4,7 @@
 #include "video_core/present.h"
 #include "video_core/renderer_vulkan/vk_rasterizer.h"
 
+#include "common/cityhash.h"
 #include "common/settings.h"
 #include "video_core/framebuffer_config.h"
 #include "video_core/renderer_vulkan/present/fsr.h"
@@ -145,6 +146,7 @@ void Layer::CreateRawImages(const Tegra::FramebufferConfig& framebuffer) {
     resource_ticks.resize(image_count);
     raw_images.resize(image_count);
     raw_image_views.resize(image_count);
+    raw_image_hashes.assign(image_count, std::nullopt);
 
     for (size_t i = 0; i < image_count; ++i) {
         raw_images[i] =
@@ -274,6 +276,23 @@ void Layer::UpdateRawImage(const Tegra::FramebufferConfig& framebuffer, size_t i
     const u64 tiled_size{Tegra::Texture::CalculateSize(
         true, bytes_per_pixel, framebuffer.stride, framebuffer.height, 1, block_height_log2, 0)};
     if (host_ptr) {
+        // CPU rendered layers are often presented unchanged for several frames (paused video,
+        // static menus, games presenting faster than they render), skip the unswizzle and the
+        // upload when the raw image already holds the guest contents.
+        // Layers the compositor reports as unchanged are not read again to find their hash.
+        const bool is_same_buffer = last_guest_hash && last_guest_address == framebuffer_addr &&
+                                    last_guest_stride == framebuffer.stride;
+        const u64 hash = !framebuffer.is_updated && is_same_buffer
+                             ? *last_guest_hash
+                             : Common::CityHash64WithSeed(reinterpret_cast<const char*>(host_ptr),
+                                                          tiled_size, framebuffer.stride);
+        last_guest_hash = hash;
+        last_guest_address = framebuffer_addr;
+        last_guest_stride = framebuffer.stride;
+        if (raw_image_hashes[image_index] == hash) {
+            return;
+        }
+        raw_image_hashes[image_index] = hash;
         Tegra::Texture::UnswizzleTexture(
             mapped_span.subspan(image_offset, linear_size), std::span(host_ptr, tiled_size),
             bytes_per_pixel, framebuffer.width, framebuffer.height, 1, block_height_log2, 0);
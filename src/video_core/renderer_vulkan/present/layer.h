@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <optional>
+
 #include "common/math_util.h"
 #include "video_core/host1x/gpu_device_memory_manager.h"
 #include "video_core/vulkan_common/vulkan_wrapper.h"
@@ -82,6 +84,10 @@ private:
     vk::Buffer buffer{};
     std::vector<vk::Image> raw_images{};
     std::vector<vk::ImageView> raw_image_views{};
+    std::vector<std::optional<u64>> raw_image_hashes{};
+    std::optional<u64> last_guest_hash{};
+    DAddr last_guest_address{};
+    u32 last_guest_stride{};
     u32 raw_width{};
     u32 raw_height{};
     Service::android::PixelFormat pixel_format{};
@@ -7,6 +7,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include <fmt/format.h>
@@ -114,7 +115,7 @@ RendererVulkan::RendererVulkan(Core::TelemetrySession& telemetry_session_,
       swapchain(*surface, device, scheduler, render_window.GetFramebufferLayout().width,
                 render_window.GetFramebufferLayout().height),
       present_manager(instance, render_window, device, memory_allocator, scheduler, swapchain,
-                      surface),
+                      surface, gpu),
       blit_swapchain(device_memory, device, memory_allocator, present_manager, scheduler,
                      PresentFiltersForDisplay),
       blit_capture(device_memory, device, memory_allocator, present_manager, scheduler,
@@ -159,11 +160,18 @@ void RendererVulkan::Composite(std::span<const Tegra::FramebufferConfig> framebu
     blit_swapchain.DrawToFrame(rasterizer, frame, framebuffers,
                                render_window.GetFramebufferLayout(), swapchain.GetImageCount(),
                                swapchain.GetImageViewFormat());
-    scheduler.Flush(*frame->render_ready);
+    const u64 frame_tick = scheduler.Flush(*frame->render_ready);
     present_manager.Present(frame);
 
     gpu.RendererFrameEndNotify();
     rasterizer.TickFrame();
+
+    if (Settings::values.low_latency_mode.GetValue()) {
+        // Hold the guest until just before the GPU runs out of work, so input for the next frame
+        // is read as late as possible instead of the frame waiting in the GPU queue.
+        const auto frame_delay = scheduler.LimitFramesInFlight(frame_tick);
+        std::this_thread::sleep_for(frame_delay);
+    }
 }
 
 void RendererVulkan::Report() const {
@@ -74,7 +74,11 @@ vk::Buffer CreateBuffer(const Device& device, const MemoryAllocator& memory_allo
         .queueFamilyIndexCount = 0,
         .pQueueFamilyIndices = nullptr,
     };
-    return memory_allocator.CreateBuffer(buffer_ci, MemoryUsage::DeviceLocal);
+    // Device local memory is host visible on unified memory devices, map guest buffers so uploads
+    // can be written into them without staging copies
+    const MemoryUsage usage =
+        device.IsIntegrated() ? MemoryUsage::Stream : MemoryUsage::DeviceLocal;
+    return memory_allocator.CreateBuffer(buffer_ci, usage);
 }
 } // Anonymous namespace
 
@@ -90,6 +94,7 @@ Buffer::Buffer(BufferCacheRuntime& runtime, VideoCommon::NullBufferParams null_p
 
 Buffer::Buffer(BufferCacheRuntime& runtime, DAddr cpu_addr_, u64 size_bytes_)
     : VideoCommon::BufferBase(cpu_addr_, size_bytes_), device{&runtime.device},
+      scheduler{&runtime.scheduler},
       buffer{CreateBuffer(*device, runtime.memory_allocator, SizeBytes())}, tracker{SizeBytes()} {
     if (runtime.device.HasDebuggingToolAttached()) {
         buffer.SetObjectNameEXT(fmt::format("Buffer 0x{:x}", CpuAddr()).c_str());
@@ -376,6 +381,7 @@ void BufferCacheRuntime::TickFrame(Common::SlotVector<Buffer>& slot_buffers) noe
 
 void BufferCacheRuntime::Finish() {
     scheduler.Finish();
+    staging_pool.InvalidateDownloads();
 }
 
 bool BufferCacheRuntime::CanReorderUpload(const Buffer& buffer,
@@ -390,6 +396,13 @@ bool BufferCacheRuntime::CanReorderUpload(const Buffer& buffer,
     return can_use_upload_cmdbuf;
 }
 
+std::span<u8> BufferCacheRuntime::DirectUploadSpan(Buffer& buffer) const {
+    if (!scheduler.IsFree(buffer.LastUseTick())) {
+        return {};
+    }
+    return buffer.Mapped();
+}
+
 void BufferCacheRuntime::CopyBuffer(VkBuffer dst_buffer, VkBuffer src_buffer,
                                     std::span<const VideoCommon::BufferCopy> copies, bool barrier,
                                     bool can_reorder_upload) {
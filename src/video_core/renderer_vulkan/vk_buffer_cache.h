@@ -8,6 +8,7 @@
 #include "video_core/buffer_cache/usage_tracker.h"
 #include "video_core/engines/maxwell_3d.h"
 #include "video_core/renderer_vulkan/vk_compute_pass.h"
+#include "video_core/renderer_vulkan/vk_scheduler.h"
 #include "video_core/renderer_vulkan/vk_staging_buffer_pool.h"
 #include "video_core/renderer_vulkan/vk_update_descriptor.h"
 #include "video_core/surface.h"
@@ -18,7 +19,6 @@ namespace Vulkan {
 
 class Device;
 class DescriptorPool;
-class Scheduler;
 struct HostVertexBinding;
 
 class BufferCacheRuntime;
@@ -34,12 +34,25 @@ public:
         return *buffer;
     }
 
+    /// Returns the host mapping of the buffer, empty when it is not host visible
+    [[nodiscard]] std::span<u8> Mapped() noexcept {
+        return buffer.Mapped();
+    }
+
     [[nodiscard]] bool IsRegionUsed(u64 offset, u64 size) const noexcept {
         return tracker.IsUsed(offset, size);
     }
 
+    /// Returns the tick of the last submission that may access the buffer
+    [[nodiscard]] u64 LastUseTick() const noexcept {
+        return last_use_tick;
+    }
+
     void MarkUsage(u64 offset, u64 size) noexcept {
         tracker.Track(offset, size);
+        if (scheduler) {
+            last_use_tick = scheduler->CurrentTick();
+        }
     }
 
     void ResetUsageTracking() noexcept {
@@ -59,9 +72,11 @@ private:
     };
 
     const Device* device{};
+    const Scheduler* scheduler{};
     vk::Buffer buffer;
     std::vector<BufferView> views;
     VideoCommon::UsageTracker tracker;
+    u64 last_use_tick{};
     bool is_null{};
 };
 
@@ -99,6 +114,10 @@ public:
 
     bool CanReorderUpload(const Buffer& buffer, std::span<const VideoCommon::BufferCopy> copies);
 
+    /// Returns the host mapping of a buffer when uploads can be written straight into it, that is
+    /// when it lives in host visible memory and no pending GPU work accesses it
+    [[nodiscard]] std::span<u8> DirectUploadSpan(Buffer& buffer) const;
+
     void FreeDeferredStagingBuffer(StagingBufferRef& ref);
 
     void PreCopyBarrier();
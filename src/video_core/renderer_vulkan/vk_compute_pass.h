@@ -38,6 +38,9 @@ public:
     ~ComputePass();
 
 protected:
+    /// Push the descriptors when the layout fits, otherwise commit a new set and bind it
+    void BindDescriptors(vk::CommandBuffer cmdbuf, const void* descriptor_data);
+
     const Device& device;
     vk::DescriptorUpdateTemplate descriptor_template;
     vk::PipelineLayout layout;
@@ -47,6 +50,7 @@ protected:
 
 private:
     vk::ShaderModule module;
+    bool uses_push_descriptor{false};
 };
 
 class Uint8Pass final : public ComputePass {
@@ -131,6 +135,40 @@ private:
     MemoryAllocator& memory_allocator;
 };
 
+class BCnDecoderPass final : public ComputePass {
+public:
+    explicit BCnDecoderPass(const Device& device_, Scheduler& scheduler_,
+                            DescriptorPool& descriptor_pool_,
+                            ComputePassDescriptorQueue& compute_pass_descriptor_queue_);
+    ~BCnDecoderPass();
+
+    void Assemble(Image& image, const StagingBufferRef& map,
+                  std::span<const VideoCommon::SwizzleParameters> swizzles);
+
+private:
+    Scheduler& scheduler;
+    ComputePassDescriptorQueue& compute_pass_descriptor_queue;
+};
+
+class BlockLinearUnswizzlePass final : public ComputePass {
+public:
+    explicit BlockLinearUnswizzlePass(const Device& device_, Scheduler& scheduler_,
+                                      DescriptorPool& descriptor_pool_,
+                                      StagingBufferPool& staging_buffer_pool_,
+                                      ComputePassDescriptorQueue& compute_pass_descriptor_queue_);
+    ~BlockLinearUnswizzlePass();
+
+    /// Unswizzles all the levels of an image into a buffer laid out as FullUploadCopies describes
+    std::pair<VkBuffer, VkDeviceSize> Assemble(
+        Image& image, const StagingBufferRef& map,
+        std::span<const VideoCommon::SwizzleParameters> swizzles);
+
+private:
+    Scheduler& scheduler;
+    StagingBufferPool& staging_buffer_pool;
+    ComputePassDescriptorQueue& compute_pass_descriptor_queue;
+};
+
 class MSAACopyPass final : public ComputePass {
 public:
     explicit MSAACopyPass(const Device& device_, Scheduler& scheduler_,
@@ -28,7 +28,8 @@ struct DescriptorBank {
 bool DescriptorBankInfo::IsSuperset(const DescriptorBankInfo& subset) const noexcept {
     return uniform_buffers >= subset.uniform_buffers && storage_buffers >= subset.storage_buffers &&
            texture_buffers >= subset.texture_buffers && image_buffers >= subset.image_buffers &&
-           textures >= subset.textures && images >= subset.image_buffers;
+           textures >= subset.textures && images >= subset.image_buffers &&
+           dynamic_uniform_buffers >= subset.dynamic_uniform_buffers;
 }
 
 template <typename Descriptors>
@@ -40,10 +41,16 @@ static u32 Accumulate(const Descriptors& descriptors) {
     return count;
 }
 
-static DescriptorBankInfo MakeBankInfo(std::span<const Shader::Info> infos) {
+static DescriptorBankInfo MakeBankInfo(std::span<const Shader::Info> infos,
+                                       bool dynamic_uniform_buffers = false) {
     DescriptorBankInfo bank;
     for (const Shader::Info& info : infos) {
-        bank.uniform_buffers += Accumulate(info.constant_buffer_descriptors);
+        const u32 uniform_buffers = Accumulate(info.constant_buffer_descriptors);
+        if (dynamic_uniform_buffers) {
+            bank.dynamic_uniform_buffers += uniform_buffers;
+        } else {
+            bank.uniform_buffers += uniform_buffers;
+        }
         bank.storage_buffers += Accumulate(info.storage_buffers_descriptors);
         bank.texture_buffers += Accumulate(info.texture_buffer_descriptors);
         bank.image_buffers += Accumulate(info.image_buffer_descriptors);
@@ -51,12 +58,12 @@ static DescriptorBankInfo MakeBankInfo(std::span<const Shader::Info> infos) {
         bank.images += Accumulate(info.image_descriptors);
     }
     bank.score = bank.uniform_buffers + bank.storage_buffers + bank.texture_buffers +
-                 bank.image_buffers + bank.textures + bank.images;
+                 bank.image_buffers + bank.textures + bank.images + bank.dynamic_uniform_buffers;
     return bank;
 }
 
 static void AllocatePool(const Device& device, DescriptorBank& bank) {
-    std::array<VkDescriptorPoolSize, 6> pool_sizes;
+    std::array<VkDescriptorPoolSize, 7> pool_sizes;
     size_t pool_cursor{};
     const u32 sets_per_pool = device.GetSetsPerPool();
     const auto add = [&](VkDescriptorType type, u32 count) {
@@ -74,6 +81,7 @@ static void AllocatePool(const Device& device, DescriptorBank& bank) {
     add(VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER, info.image_buffers);
     add(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, info.textures);
     add(VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, info.images);
+    add(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, info.dynamic_uniform_buffers);
     bank.pools.push_back(device.GetLogical().CreateDescriptorPool({
         .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
         .pNext = nullptr,
@@ -128,8 +136,9 @@ DescriptorPool::DescriptorPool(const Device& device_, Scheduler& scheduler)
 DescriptorPool::~DescriptorPool() = default;
 
 DescriptorAllocator DescriptorPool::Allocator(VkDescriptorSetLayout layout,
-                                              std::span<const Shader::Info> infos) {
-    return Allocator(layout, MakeBankInfo(infos));
+                                              std::span<const Shader::Info> infos,
+                                              bool dynamic_uniform_buffers) {
+    return Allocator(layout, MakeBankInfo(infos, dynamic_uniform_buffers));
 }
 
 DescriptorAllocator DescriptorPool::Allocator(VkDescriptorSetLayout layout,
@@ -21,13 +21,14 @@ struct DescriptorBank;
 struct DescriptorBankInfo {
     [[nodiscard]] bool IsSuperset(const DescriptorBankInfo& subset) const noexcept;
 
-    u32 uniform_buffers{}; ///< Number of uniform buffer descriptors
-    u32 storage_buffers{}; ///< Number of storage buffer descriptors
-    u32 texture_buffers{}; ///< Number of texture buffer descriptors
-    u32 image_buffers{};   ///< Number of image buffer descriptors
-    u32 textures{};        ///< Number of texture descriptors
-    u32 images{};          ///< Number of image descriptors
-    s32 score{};           ///< Number of descriptors in total
+    u32 uniform_buffers{};         ///< Number of uniform buffer descriptors
+    u32 storage_buffers{};         ///< Number of storage buffer descriptors
+    u32 texture_buffers{};         ///< Number of texture buffer descriptors
+    u32 image_buffers{};           ///< Number of image buffer descriptors
+    u32 textures{};                ///< Number of texture descriptors
+    u32 images{};                  ///< Number of image descriptors
+    u32 dynamic_uniform_buffers{}; ///< Number of dynamic uniform buffer descriptors
+    s32 score{};                   ///< Number of descriptors in total
 };
 
 class DescriptorAllocator final : public ResourcePool {
@@ -68,8 +69,8 @@ public:
     DescriptorPool& operator=(const DescriptorPool&) = delete;
     DescriptorPool(const DescriptorPool&) = delete;
 
-    DescriptorAllocator Allocator(VkDescriptorSetLayout layout,
-                                  std::span<const Shader::Info> infos);
+    DescriptorAllocator Allocator(VkDescriptorSetLayout layout, std::span<const Shader::Info> infos,
+                                  bool dynamic_uniform_buffers = false);
     DescriptorAllocator Allocator(VkDescriptorSetLayout layout, const Shader::Info& info);
     DescriptorAllocator Allocator(VkDescriptorSetLayout layout, const DescriptorBankInfo& info);
 
@@ -0,0 +1,225 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <ios>
+#include <span>
+#include <string>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include "common/fs/fs.h"
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
+#include "common/tracing.h"
+#include "video_core/renderer_vulkan/vk_gpu_profiler.h"
+#include "video_core/renderer_vulkan/vk_master_semaphore.h"
+#include "video_core/texture_cache/formatter.h"
+#include "video_core/vulkan_common/vulkan_device.h"
+
+namespace Vulkan {
+namespace {
+using VideoCore::Surface::PixelFormat;
+
+// Prints a summary every this many frames, about ten seconds at 60 FPS
+constexpr u64 FRAMES_PER_SUMMARY = 600;
+
+// Number of scopes shown in summaries
+constexpr size_t SUMMARY_SCOPES = 5;
+
+constexpr std::array<const char*, 3> SCOPE_TYPE_NAMES{"render_pass", "graphics", "compute"};
+
+struct ScopeTotal {
+    GpuProfiler::ScopeType type;
+    u64 label;
+    u64 count;
+    double milliseconds;
+};
+
+std::string FormatRenderPass(const RenderPassKey& key) {
+    std::string name;
+    for (const PixelFormat format : key.color_formats) {
+        if (format != PixelFormat::Invalid) {
+            name += fmt::format("{}{}", name.empty() ? "" : "+", format);
+        }
+    }
+    if (key.depth_format != PixelFormat::Invalid) {
+        name += fmt::format("{}{}", name.empty() ? "" : "+", key.depth_format);
+    }
+    if (key.samples != VK_SAMPLE_COUNT_1_BIT) {
+        name += fmt::format(" x{}", static_cast<u32>(key.samples));
+    }
+    return name;
+}
+} // Anonymous namespace
+
+GpuProfiler::GpuProfiler(const Device& device_)
+    : device{device_}, milliseconds_per_tick{device.GetTimestampPeriod() / 1'000'000.0},
+      scopes(NUM_SCOPES) {
+    query_pool = device.GetLogical().CreateQueryPool({
+        .sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,
+        .pNext = nullptr,
+        .flags = 0,
+        .queryType = VK_QUERY_TYPE_TIMESTAMP,
+        .queryCount = static_cast<u32>(NUM_SCOPES * 2),
+        .pipelineStatistics = 0,
+    });
+    LOG_INFO(Render_Vulkan, "GPU timestamp profiling enabled");
+}
+
+GpuProfiler::~GpuProfiler() {
+    WriteReport();
+}
+
+bool GpuProfiler::IsSupported(const Device& device) {
+    return device.SupportsTimestampQueries() && device.GetTimestampPeriod() > 0.0f;
+}
+
+u32 GpuProfiler::BeginScope(ScopeType type, u64 label) {
+    if (scope_head - scope_tail >= NUM_SCOPES) {
+        return INVALID_SCOPE;
+    }
+    const u32 scope{static_cast<u32>(scope_head % NUM_SCOPES)};
+    ++scope_head;
+
+    // The previous queries of this scope have been read, so they can be reset from the host
+    device.GetLogical().ResetQueryPool(*query_pool, BeginQuery(scope), 2);
+    scopes[scope] = Scope{
+        .type = type,
+        .label = label,
+        .frame = current_frame,
+        .tick = 0,
+        .ended = false,
+    };
+    return scope;
+}
+
+void GpuProfiler::EndScope(u32 scope, u64 tick) {
+    scopes[scope].tick = tick;
+    scopes[scope].ended = true;
+}
+
+void GpuProfiler::NameRenderPass(u64 label, const RenderPassKey& key) {
+    render_pass_names.try_emplace(label, key);
+}
+
+void GpuProfiler::EndFrame(const MasterSemaphore& master_semaphore) {
+    Resolve(master_semaphore);
+    ++current_frame;
+}
+
+void GpuProfiler::Resolve(const MasterSemaphore& master_semaphore) {
+    // Scopes are allocated in submission order, so they finish in the same order
+    while (scope_tail != scope_head) {
+        const u32 index{static_cast<u32>(scope_tail % NUM_SCOPES)};
+        const Scope& scope{scopes[index]};
+        if (!scope.ended || !master_semaphore.IsFree(scope.tick)) {
+            break;
+        }
+        std::array<u64, 2> timestamps{};
+        const VkResult result{device.GetLogical().GetQueryResults(
+            *query_pool, BeginQuery(index), 2, sizeof(timestamps), timestamps.data(),
+            sizeof(u64), VK_QUERY_RESULT_64_BIT)};
+        if (result == VK_NOT_READY) {
+            break;
+        }
+        ++scope_tail;
+        if (result != VK_SUCCESS || timestamps[1] < timestamps[0]) {
+            continue;
+        }
+        if (scope.frame != resolving_frame) {
+            FinishFrame();
+            resolving_frame = scope.frame;
+        }
+        const double milliseconds{static_cast<double>(timestamps[1] - timestamps[0]) *
+                                  milliseconds_per_tick};
+        Totals& scope_totals{totals[static_cast<size_t>(scope.type)][scope.label]};
+        ++scope_totals.count;
+        scope_totals.milliseconds += milliseconds;
+
+        // Graphics pipelines are nested in render passes, don't count their time twice
+        if (scope.type != ScopeType::GraphicsPipeline) {
+            resolving_frame_milliseconds += milliseconds;
+        }
+    }
+}
+
+void GpuProfiler::FinishFrame() {
+    if (resolving_frame_milliseconds == 0.0) {
+        return;
+    }
+    Common::Tracing::Counter("GPU frame time (us)",
+                             static_cast<s64>(resolving_frame_milliseconds * 1000.0));
+    ++num_frames;
+    total_frame_milliseconds += std::exchange(resolving_frame_milliseconds, 0.0);
+    if (num_frames % FRAMES_PER_SUMMARY == 0) {
+        LogSummary();
+    }
+}
+
+void GpuProfiler::LogSummary() const {
+    if (num_frames == 0) {
+        return;
+    }
+    std::vector<ScopeTotal> top;
+    for (size_t type = 0; type < NUM_SCOPE_TYPES; ++type) {
+        for (const auto& [label, scope_totals] : totals[type]) {
+            top.push_back({static_cast<ScopeType>(type), label, scope_totals.count,
+                           scope_totals.milliseconds});
+        }
+    }
+    const size_t num_shown{std::min(top.size(), SUMMARY_SCOPES)};
+    std::ranges::partial_sort(top, top.begin() + num_shown, std::ranges::greater{},
+                              &ScopeTotal::milliseconds);
+    LOG_INFO(Render_Vulkan, "Measured {:.3f} ms of GPU work per frame over {} frames",
+             total_frame_milliseconds / static_cast<double>(num_frames), num_frames);
+    for (const ScopeTotal& scope : std::span(top).first(num_shown)) {
+        std::string name{fmt::format("{:016x}", scope.label)};
+        if (const auto it{render_pass_names.find(scope.label)};
+            scope.type == ScopeType::RenderPass && it != render_pass_names.end()) {
+            name = FormatRenderPass(it->second);
+        }
+        LOG_INFO(Render_Vulkan, "  {:<12} {:<40} {:>10.3f} ms per frame",
+                 SCOPE_TYPE_NAMES[static_cast<size_t>(scope.type)], name,
+                 scope.milliseconds / static_cast<double>(num_frames));
+    }
+}
+
+void GpuProfiler::WriteReport() const {
+    if (num_frames == 0) {
+        return;
+    }
+    LogSummary();
+
+    const auto dump_dir{Common::FS::GetYuzuPath(Common::FS::YuzuPath::DumpDir)};
+    if (!Common::FS::CreateDir(dump_dir)) {
+        LOG_ERROR(Common_Filesystem, "Failed to create dump directory");
+        return;
+    }
+    const auto name{dump_dir / "gpu_profile.csv"};
+    std::ofstream report_file(name, std::ios::out | std::ios::trunc);
+    if (!report_file) {
+        LOG_ERROR(Common_Filesystem, "Unable to open or create file at {}",
+                  Common::FS::PathToUTF8String(name));
+        return;
+    }
+    report_file << "type,label,formats,count,total_ms,ms_per_frame\n";
+    for (size_t type = 0; type < NUM_SCOPE_TYPES; ++type) {
+        for (const auto& [label, scope_totals] : totals[type]) {
+            const auto it{render_pass_names.find(label)};
+            const bool has_formats{static_cast<ScopeType>(type) == ScopeType::RenderPass &&
+                                   it != render_pass_names.end()};
+            report_file << fmt::format("{},{:016x},{},{},{:.3f},{:.4f}\n", SCOPE_TYPE_NAMES[type],
+                                       label, has_formats ? FormatRenderPass(it->second) : "",
+                                       scope_totals.count, scope_totals.milliseconds,
+                                       scope_totals.milliseconds /
+                                           static_cast<double>(num_frames));
+        }
+    }
+    LOG_INFO(Render_Vulkan, "GPU profile written to {}", Common::FS::PathToUTF8String(name));
+}
+
+} // namespace Vulkan
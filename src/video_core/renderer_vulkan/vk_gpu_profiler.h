@@ -0,0 +1,106 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <unordered_map>
+#include <vector>
+
+#include "common/common_types.h"
+#include "video_core/renderer_vulkan/vk_render_pass_cache.h"
+#include "video_core/vulkan_common/vulkan_wrapper.h"
+
+namespace Vulkan {
+
+class Device;
+class MasterSemaphore;
+
+/// Measures the GPU time of render passes, graphics pipelines and compute dispatches with
+/// timestamp queries. Results are resolved once their submission has finished on the GPU.
+class GpuProfiler {
+public:
+    enum class ScopeType : u32 {
+        RenderPass,       ///< Labelled by the hash of the render target formats
+        GraphicsPipeline, ///< Labelled by the pipeline key hash, nested in render passes
+        ComputePipeline,  ///< Labelled by the pipeline hash
+    };
+
+    static constexpr u32 INVALID_SCOPE = ~0U;
+
+    explicit GpuProfiler(const Device& device);
+    ~GpuProfiler();
+
+    /// Returns true when the device can write timestamps on the graphics queue
+    [[nodiscard]] static bool IsSupported(const Device& device);
+
+    /// Allocates a scope, returns INVALID_SCOPE when all queries are still in flight
+    [[nodiscard]] u32 BeginScope(ScopeType type, u64 label);
+
+    /// Marks the scope as complete once the given tick has been executed
+    void EndScope(u32 scope, u64 tick);
+
+    /// Remembers the formats of a render pass label for reports
+    void NameRenderPass(u64 label, const RenderPassKey& key);
+
+    /// Resolves finished scopes and starts attributing new scopes to the next frame
+    void EndFrame(const MasterSemaphore& master_semaphore);
+
+    [[nodiscard]] VkQueryPool QueryPool() const noexcept {
+        return *query_pool;
+    }
+
+    /// Returns the timestamp query written at the beginning of a scope
+    [[nodiscard]] static u32 BeginQuery(u32 scope) noexcept {
+        return scope * 2;
+    }
+
+    /// Returns the timestamp query written at the end of a scope
+    [[nodiscard]] static u32 EndQuery(u32 scope) noexcept {
+        return scope * 2 + 1;
+    }
+
+private:
+    static constexpr size_t NUM_SCOPES = 4096;
+    static constexpr size_t NUM_SCOPE_TYPES = 3;
+
+    struct Scope {
+        ScopeType type;
+        u64 label;
+        u64 frame;
+        u64 tick;
+        bool ended;
+    };
+
+    struct Totals {
+        u64 count;
+        double milliseconds;
+    };
+
+    void Resolve(const MasterSemaphore& master_semaphore);
+
+    void FinishFrame();
+
+    void LogSummary() const;
+
+    void WriteReport() const;
+
+    const Device& device;
+    vk::QueryPool query_pool;
+    double milliseconds_per_tick;
+
+    std::vector<Scope> scopes;
+    u64 scope_head = 0; ///< Next scope to allocate
+    u64 scope_tail = 0; ///< Oldest unresolved scope
+
+    u64 current_frame = 0;
+    u64 resolving_frame = 0;
+    double resolving_frame_milliseconds = 0.0;
+    u64 num_frames = 0;
+    double total_frame_milliseconds = 0.0;
+
+    std::array<std::unordered_map<u64, Totals>, NUM_SCOPE_TYPES> totals;
+    std::unordered_map<u64, RenderPassKey> render_pass_names;
+};
+
+} // namespace Vulkan
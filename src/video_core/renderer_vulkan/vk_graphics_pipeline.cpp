@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <algorithm>
+#include <chrono>
 #include <span>
 
 #include <boost/container/small_vector.hpp>
@@ -72,6 +73,55 @@ VkStencilOpState GetStencilFaceState(const StencilFace& face) {
     };
 }
 
+/// Creates a pipeline library with the state of the create info included in the library flags
+vk::Pipeline MakeLibrary(const Device& device, const vk::PipelineCache& pipeline_cache,
+                         VkGraphicsPipelineCreateInfo ci, VkGraphicsPipelineLibraryFlagsEXT flags,
+                         std::span<const VkPipelineShaderStageCreateInfo> stages) {
+    const VkGraphicsPipelineLibraryCreateInfoEXT library_ci{
+        .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_LIBRARY_CREATE_INFO_EXT,
+        .pNext = nullptr,
+        .flags = flags,
+    };
+    const bool has_vertex_input =
+        (flags & VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT) != 0;
+    const bool has_pre_rasterization =
+        (flags & VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT) != 0;
+    const bool has_fragment_shader =
+        (flags & VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT) != 0;
+    const bool has_fragment_output =
+        (flags & VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT_INTERFACE_BIT_EXT) != 0;
+    ci.pNext = &library_ci;
+    ci.flags |= VK_PIPELINE_CREATE_LIBRARY_BIT_KHR |
+                VK_PIPELINE_CREATE_RETAIN_LINK_TIME_OPTIMIZATION_INFO_BIT_EXT;
+    ci.stageCount = static_cast<u32>(stages.size());
+    ci.pStages = stages.data();
+    if (!has_vertex_input) {
+        ci.pVertexInputState = nullptr;
+        ci.pInputAssemblyState = nullptr;
+    }
+    if (!has_pre_rasterization) {
+        ci.pTessellationState = nullptr;
+        ci.pViewportState = nullptr;
+        ci.pRasterizationState = nullptr;
+    }
+    if (!has_fragment_shader) {
+        ci.pDepthStencilState = nullptr;
+    }
+    if (!has_fragment_shader && !has_fragment_output) {
+        ci.pMultisampleState = nullptr;
+    }
+    if (!has_fragment_output) {
+        ci.pColorBlendState = nullptr;
+    }
+    if (!has_pre_rasterization && !has_fragment_shader) {
+        ci.layout = VK_NULL_HANDLE;
+    }
+    if (has_vertex_input) {
+        ci.renderPass = VK_NULL_HANDLE;
+    }
+    return device.GetLogical().CreateGraphicsPipeline(ci, *pipeline_cache);
+}
+
 bool SupportsPrimitiveRestart(VkPrimitiveTopology topology) {
     static constexpr std::array unsupported_topologies{
         VK_PRIMITIVE_TOPOLOGY_POINT_LIST,
@@ -238,13 +288,14 @@ GraphicsPipeline::GraphicsPipeline(
     Scheduler& scheduler_, BufferCache& buffer_cache_, TextureCache& texture_cache_,
     vk::PipelineCache& pipeline_cache_, VideoCore::ShaderNotify* shader_notify,
     const Device& device_, DescriptorPool& descriptor_pool,
-    GuestDescriptorQueue& guest_descriptor_queue_, Common::ThreadWorker* worker_thread,
+    GuestDescriptorQueue& guest_descriptor_queue_, Common::ThreadWorker* worker_thread_,
     PipelineStatistics* pipeline_statistics, RenderPassCache& render_pass_cache,
     const GraphicsPipelineCacheKey& key_, std::array<vk::ShaderModule, NUM_STAGES> stages,
     const std::array<const Shader::Info*, NUM_STAGES>& infos)
     : key{key_}, device{device_}, texture_cache{texture_cache_}, buffer_cache{buffer_cache_},
       pipeline_cache(pipeline_cache_), scheduler{scheduler_},
-      guest_descriptor_queue{guest_descriptor_queue_}, spv_modules{std::move(stages)} {
+      guest_descriptor_queue{guest_descriptor_queue_}, worker_thread{worker_thread_},
+      spv_modules{std::move(stages)} {
     if (shader_notify) {
         shader_notify->MarkShaderBuilding();
     }
@@ -257,13 +308,24 @@ GraphicsPipeline::GraphicsPipeline(
         enabled_uniform_buffer_masks[stage] = info->constant_buffer_mask;
         std::ranges::copy(info->constant_buffer_used_sizes, uniform_buffer_sizes[stage].begin());
         num_textures += Shader::NumDescriptors(info->texture_descriptors);
+        has_constant_buffer_guards |= !info->constant_buffer_guards.empty();
     }
     auto func{[this, shader_notify, &render_pass_cache, &descriptor_pool, pipeline_statistics] {
         DescriptorLayoutBuilder builder{MakeBuilder(device, stage_infos)};
         uses_push_descriptor = builder.CanUsePushDescriptor();
+        // Sets are reused across draws by a single recording thread, so they can't be shared
+        // between parallel recorders
+        uses_dynamic_uniform_buffers = !uses_push_descriptor &&
+                                       !scheduler.IsRecordingInParallel() &&
+                                       builder.CanUseDynamicUniformBuffers();
+        if (uses_dynamic_uniform_buffers) {
+            builder.UseDynamicUniformBuffers();
+            descriptor_types = builder.DescriptorTypes();
+        }
         descriptor_set_layout = builder.CreateDescriptorSetLayout(uses_push_descriptor);
         if (!uses_push_descriptor) {
-            descriptor_allocator = descriptor_pool.Allocator(*descriptor_set_layout, stage_infos);
+            descriptor_allocator = descriptor_pool.Allocator(*descriptor_set_layout, stage_infos,
+                                                             uses_dynamic_uniform_buffers);
         }
         const VkDescriptorSetLayout set_layout{*descriptor_set_layout};
         pipeline_layout = builder.CreatePipelineLayout(set_layout);
@@ -272,10 +334,23 @@ GraphicsPipeline::GraphicsPipeline(
 
         const VkRenderPass render_pass{render_pass_cache.Get(MakeRenderPassKey(key.state))};
         Validate();
+        const auto compile_start{std::chrono::steady_clock::now()};
         MakePipeline(render_pass);
+        if (shader_notify && shader_notify->IsProfiling()) {
+            shader_notify->RecordPhase(key.Hash(), "driver_compile",
+                                       std::chrono::steady_clock::now() - compile_start);
+        }
         if (pipeline_statistics) {
             pipeline_statistics->Collect(*pipeline);
         }
+        bound_pipeline.store(*pipeline, std::memory_order::release);
+        if (libraries[0]) {
+            // Draws use the fast linked pipeline until the optimized one replaces it
+            worker_thread->QueueWork([this] {
+                optimized_pipeline = LinkLibraries(true);
+                bound_pipeline.store(*optimized_pipeline, std::memory_order::release);
+            });
+        }
 
         std::scoped_lock lock{build_mutex};
         is_built = true;
@@ -495,8 +570,14 @@ void GraphicsPipeline::ConfigureDraw(const RescalingPushConstant& rescaling,
     if (!is_built.load(std::memory_order::relaxed)) {
         // Wait for the pipeline to be built
         scheduler.Record([this](vk::CommandBuffer) {
-            std::unique_lock lock{build_mutex};
-            build_condvar.wait(lock, [this] { return is_built.load(std::memory_order::relaxed); });
+            // Hold back background precompilation until this pipeline is ready
+            worker_thread->BeginForegroundWait();
+            {
+                std::unique_lock lock{build_mutex};
+                build_condvar.wait(lock,
+                                   [this] { return is_built.load(std::memory_order::relaxed); });
+            }
+            worker_thread->EndForegroundWait();
         });
     }
     const bool is_rescaling{texture_cache.IsRescaling()};
@@ -508,7 +589,8 @@ void GraphicsPipeline::ConfigureDraw(const RescalingPushConstant& rescaling,
                       uses_render_area = render_area.uses_render_area,
                       render_area_data = render_area.words](vk::CommandBuffer cmdbuf) {
         if (bind_pipeline) {
-            cmdbuf.BindPipeline(VK_PIPELINE_BIND_POINT_GRAPHICS, *pipeline);
+            cmdbuf.BindPipeline(VK_PIPELINE_BIND_POINT_GRAPHICS,
+                                bound_pipeline.load(std::memory_order::acquire));
         }
         cmdbuf.PushConstants(*pipeline_layout, VK_SHADER_STAGE_ALL_GRAPHICS,
                              RESCALING_LAYOUT_WORDS_OFFSET, sizeof(rescaling_data),
@@ -531,6 +613,12 @@ void GraphicsPipeline::ConfigureDraw(const RescalingPushConstant& rescaling,
         if (uses_push_descriptor) {
             cmdbuf.PushDescriptorSetWithTemplateKHR(*descriptor_update_template, *pipeline_layout,
                                                     0, descriptor_data);
+        } else if (uses_dynamic_uniform_buffers) {
+            DynamicOffsets dynamic_offsets;
+            const VkDescriptorSet descriptor_set{CommitDynamicDescriptorSet(
+                static_cast<const DescriptorUpdateEntry*>(descriptor_data), dynamic_offsets)};
+            cmdbuf.BindDescriptorSets(VK_PIPELINE_BIND_POINT_GRAPHICS, *pipeline_layout, 0,
+                                      descriptor_set, dynamic_offsets);
         } else {
             const VkDescriptorSet descriptor_set{descriptor_allocator.Commit()};
             const vk::Device& dev{device.GetLogical()};
@@ -541,6 +629,49 @@ void GraphicsPipeline::ConfigureDraw(const RescalingPushConstant& rescaling,
     });
 }
 
+VkDescriptorSet GraphicsPipeline::CommitDynamicDescriptorSet(const DescriptorUpdateEntry* data,
+                                                             DynamicOffsets& dynamic_offsets) {
+    // Uniform buffers are written at offset zero, their offsets on the stream buffer are given on
+    // bind. Draws that only move their uniform buffers can then keep the same set.
+    bool is_equal = last_descriptors.size() == descriptor_types.size();
+    last_descriptors.resize(descriptor_types.size());
+    for (size_t index = 0; index < descriptor_types.size(); ++index) {
+        DescriptorUpdateEntry& last{last_descriptors[index]};
+        DescriptorUpdateEntry entry{data[index]};
+        switch (descriptor_types[index]) {
+        case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC:
+            dynamic_offsets.push_back(static_cast<u32>(entry.buffer.offset));
+            entry.buffer.offset = 0;
+            [[fallthrough]];
+        case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+            is_equal &= last.buffer.buffer == entry.buffer.buffer &&
+                        last.buffer.offset == entry.buffer.offset &&
+                        last.buffer.range == entry.buffer.range;
+            break;
+        case VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER:
+        case VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER:
+            is_equal &= last.texel_buffer == entry.texel_buffer;
+            break;
+        default:
+            is_equal &= last.image.sampler == entry.image.sampler &&
+                        last.image.imageView == entry.image.imageView &&
+                        last.image.imageLayout == entry.image.imageLayout;
+            break;
+        }
+        last = entry;
+    }
+    // The set can be reused as long as it hasn't been released back to the allocator, which
+    // can't happen before its tick has been submitted
+    if (is_equal && last_descriptor_set && last_descriptor_tick == scheduler.CurrentTick()) {
+        return last_descriptor_set;
+    }
+    last_descriptor_set = descriptor_allocator.Commit();
+    last_descriptor_tick = scheduler.CurrentTick();
+    device.GetLogical().UpdateDescriptorSet(last_descriptor_set, *descriptor_update_template,
+                                            last_descriptors.data());
+    return last_descriptor_set;
+}
+
 void GraphicsPipeline::MakePipeline(VkRenderPass render_pass) {
     FixedPipelineState::DynamicState dynamic{};
     if (!key.state.extended_dynamic_state) {
@@ -840,6 +971,13 @@ void GraphicsPipeline::MakePipeline(VkRenderPass render_pass) {
             };
             dynamic_states.insert(dynamic_states.end(), extended3.begin(), extended3.end());
         }
+        if (key.state.extended_dynamic_state_3_rasterization) {
+            static constexpr std::array extended3{
+                VK_DYNAMIC_STATE_POLYGON_MODE_EXT,
+                VK_DYNAMIC_STATE_ALPHA_TO_COVERAGE_ENABLE_EXT,
+            };
+            dynamic_states.insert(dynamic_states.end(), extended3.begin(), extended3.end());
+        }
     }
     const VkPipelineDynamicStateCreateInfo dynamic_state_ci{
         .sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO,
@@ -878,24 +1016,86 @@ void GraphicsPipeline::MakePipeline(VkRenderPass render_pass) {
     if (device.IsKhrPipelineExecutablePropertiesEnabled()) {
         flags |= VK_PIPELINE_CREATE_CAPTURE_STATISTICS_BIT_KHR;
     }
-    pipeline = device.GetLogical().CreateGraphicsPipeline(
+    const VkGraphicsPipelineCreateInfo pipeline_ci{
+        .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
+        .pNext = nullptr,
+        .flags = flags,
+        .stageCount = static_cast<u32>(shader_stages.size()),
+        .pStages = shader_stages.data(),
+        .pVertexInputState = &vertex_input_ci,
+        .pInputAssemblyState = &input_assembly_ci,
+        .pTessellationState = &tessellation_ci,
+        .pViewportState = &viewport_ci,
+        .pRasterizationState = &rasterization_ci,
+        .pMultisampleState = &multisample_ci,
+        .pDepthStencilState = &depth_stencil_ci,
+        .pColorBlendState = &color_blend_ci,
+        .pDynamicState = &dynamic_state_ci,
+        .layout = *pipeline_layout,
+        .renderPass = render_pass,
+        .subpass = 0,
+        .basePipelineHandle = nullptr,
+        .basePipelineIndex = 0,
+    };
+    // Pipelines built on a worker are linked from libraries when the driver links them fast.
+    // Fragment libraries can't be linked with a static rasterizer discard, build those fully.
+    const bool has_dynamic_discard =
+        key.state.extended_dynamic_state != 0 && key.state.extended_dynamic_state_2 != 0;
+    const bool use_libraries = worker_thread && device.IsExtGraphicsPipelineLibrarySupported() &&
+                               !device.IsKhrPipelineExecutablePropertiesEnabled() &&
+                               (has_dynamic_discard || dynamic.rasterize_enable != 0);
+    if (!use_libraries) {
+        pipeline = device.GetLogical().CreateGraphicsPipeline(pipeline_ci, *pipeline_cache);
+        return;
+    }
+    // The fragment stage, when there is one, is the last stage
+    const std::span<const VkPipelineShaderStageCreateInfo> stages{shader_stages};
+    const size_t num_fragment_stages = spv_modules[4] ? 1 : 0;
+    const auto pre_rasterization_stages = stages.first(stages.size() - num_fragment_stages);
+    const auto fragment_stages = stages.last(num_fragment_stages);
+    libraries = {
+        MakeLibrary(device, pipeline_cache, pipeline_ci,
+                    VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT, {}),
+        MakeLibrary(device, pipeline_cache, pipeline_ci,
+                    VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT,
+                    pre_rasterization_stages),
+        MakeLibrary(device, pipeline_cache, pipeline_ci,
+                    VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT, fragment_stages),
+        MakeLibrary(device, pipeline_cache, pipeline_ci,
+                    VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT_INTERFACE_BIT_EXT, {}),
+    };
+    pipeline = LinkLibraries(false);
+}
+
+vk::Pipeline GraphicsPipeline::LinkLibraries(bool optimized) const {
+    std::array<VkPipeline, 4> handles;
+    std::ranges::transform(libraries, handles.begin(),
+                           [](const vk::Pipeline& library) { return *library; });
+    const VkPipelineLibraryCreateInfoKHR library_ci{
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_LIBRARY_CREATE_INFO_KHR,
+        .pNext = nullptr,
+        .libraryCount = static_cast<u32>(handles.size()),
+        .pLibraries = handles.data(),
+    };
+    return device.GetLogical().CreateGraphicsPipeline(
         {
             .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
-            .pNext = nullptr,
-            .flags = flags,
-            .stageCount = static_cast<u32>(shader_stages.size()),
-            .pStages = shader_stages.data(),
-            .pVertexInputState = &vertex_input_ci,
-            .pInputAssemblyState = &input_assembly_ci,
-            .pTessellationState = &tessellation_ci,
-            .pViewportState = &viewport_ci,
-            .pRasterizationState = &rasterization_ci,
-            .pMultisampleState = &multisample_ci,
-            .pDepthStencilState = &depth_stencil_ci,
-            .pColorBlendState = &color_blend_ci,
-            .pDynamicState = &dynamic_state_ci,
+            .pNext = &library_ci,
+            .flags = static_cast<VkPipelineCreateFlags>(
+                optimized ? VK_PIPELINE_CREATE_LINK_TIME_OPTIMIZATION_BIT_EXT : 0),
+            .stageCount = 0,
+            .pStages = nullptr,
+            .pVertexInputState = nullptr,
+            .pInputAssemblyState = nullptr,
+            .pTessellationState = nullptr,
+            .pViewportState = nullptr,
+            .pRasterizationState = nullptr,
+            .pMultisampleState = nullptr,
+            .pDepthStencilState = nullptr,
+            .pColorBlendState = nullptr,
+            .pDynamicState = nullptr,
             .layout = *pipeline_layout,
-            .renderPass = render_pass,
+            .renderPass = VK_NULL_HANDLE,
             .subpass = 0,
             .basePipelineHandle = nullptr,
             .basePipelineIndex = 0,
@@ -903,6 +1103,27 @@ void GraphicsPipeline::MakePipeline(VkRenderPass render_pass) {
         *pipeline_cache);
 }
 
+bool GraphicsPipeline::CheckConstantBufferGuards(Tegra::Engines::Maxwell3D& maxwell3d_,
+                                                 Tegra::MemoryManager& gpu_memory_) const {
+    for (size_t stage = 0; stage < NUM_STAGES; ++stage) {
+        const auto& cbufs{maxwell3d_.state.shader_stages[stage].const_buffers};
+        for (const Shader::ConstantBufferGuard& guard : stage_infos[stage].constant_buffer_guards) {
+            const auto& cbuf{cbufs[guard.index]};
+            if (!cbuf.enabled) {
+                return false;
+            }
+            // Words past the end of the buffer read as zero, like they did when translating
+            const u32 value{guard.offset < cbuf.size
+                                ? gpu_memory_.Read<u32>(cbuf.address + guard.offset)
+                                : 0U};
+            if (value != guard.value) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
 void GraphicsPipeline::Validate() {
     size_t num_images{};
     for (const auto& info : stage_infos) {
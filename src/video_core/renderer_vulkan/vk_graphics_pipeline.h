@@ -9,6 +9,9 @@
 #include <condition_variable>
 #include <mutex>
 #include <type_traits>
+#include <vector>
+
+#include <boost/container/static_vector.hpp>
 
 #include "common/thread_worker.h"
 #include "shader_recompiler/shader_info.h"
@@ -99,10 +102,20 @@ public:
                                            : nullptr;
     }
 
+    [[nodiscard]] const GraphicsPipelineCacheKey& Key() const noexcept {
+        return key;
+    }
+
     [[nodiscard]] bool IsBuilt() const noexcept {
         return is_built.load(std::memory_order::relaxed);
     }
 
+    /// Returns true when the bound constant buffers hold the words the shaders were specialized on
+    [[nodiscard]] bool MatchesConstantBufferGuards(Tegra::Engines::Maxwell3D& maxwell3d_,
+                                                   Tegra::MemoryManager& gpu_memory_) const {
+        return !has_constant_buffer_guards || CheckConstantBufferGuards(maxwell3d_, gpu_memory_);
+    }
+
     template <typename Spec>
     static auto MakeConfigureSpecFunc() {
         return [](GraphicsPipeline* pl, bool is_indexed) { pl->ConfigureImpl<Spec>(is_indexed); };
@@ -120,10 +133,24 @@ private:
     void ConfigureDraw(const RescalingPushConstant& rescaling,
                        const RenderAreaPushConstant& render_are);
 
+    using DynamicOffsets = boost::container::static_vector<
+        u32, VideoCommon::NUM_STAGES * VideoCommon::NUM_GRAPHICS_UNIFORM_BUFFERS>;
+
+    /// Returns a descriptor set holding the given descriptors, reusing the last one when only
+    /// the offsets of uniform buffers have changed
+    VkDescriptorSet CommitDynamicDescriptorSet(const DescriptorUpdateEntry* data,
+                                               DynamicOffsets& dynamic_offsets);
+
     void MakePipeline(VkRenderPass render_pass);
 
+    /// Links the pipeline libraries, with link time optimizations when optimized is true
+    vk::Pipeline LinkLibraries(bool optimized) const;
+
     void Validate();
 
+    bool CheckConstantBufferGuards(Tegra::Engines::Maxwell3D& maxwell3d_,
+                                   Tegra::MemoryManager& gpu_memory_) const;
+
     const GraphicsPipelineCacheKey key;
     Tegra::Engines::Maxwell3D* maxwell3d;
     Tegra::MemoryManager* gpu_memory;
@@ -133,6 +160,7 @@ private:
     vk::PipelineCache& pipeline_cache;
     Scheduler& scheduler;
     GuestDescriptorQueue& guest_descriptor_queue;
+    Common::ThreadWorker* worker_thread;
 
     void (*configure_func)(GraphicsPipeline*, bool){};
 
@@ -145,17 +173,30 @@ private:
     std::array<u32, 5> enabled_uniform_buffer_masks{};
     VideoCommon::UniformBufferSizes uniform_buffer_sizes{};
     u32 num_textures{};
+    bool has_constant_buffer_guards{};
 
     vk::DescriptorSetLayout descriptor_set_layout;
     DescriptorAllocator descriptor_allocator;
     vk::PipelineLayout pipeline_layout;
     vk::DescriptorUpdateTemplate descriptor_update_template;
     vk::Pipeline pipeline;
+    /// Vertex input, pre-rasterization, fragment shader and fragment output libraries
+    std::array<vk::Pipeline, 4> libraries;
+    vk::Pipeline optimized_pipeline;
+    /// Pipeline bound on draws, the fast linked one is replaced when the optimized one is ready
+    std::atomic<VkPipeline> bound_pipeline{};
 
     std::condition_variable build_condvar;
     std::mutex build_mutex;
     std::atomic_bool is_built{false};
     bool uses_push_descriptor{false};
+
+    /// Uniform buffers use dynamic descriptors and descriptor sets are reused across draws
+    bool uses_dynamic_uniform_buffers{false};
+    std::vector<VkDescriptorType> descriptor_types;
+    std::vector<DescriptorUpdateEntry> last_descriptors;
+    VkDescriptorSet last_descriptor_set{};
+    u64 last_descriptor_tick{};
 };
 
 } // namespace Vulkan
@@ -3,6 +3,7 @@
 
 #include <thread>
 
+#include "common/assert.h"
 #include "common/polyfill_ranges.h"
 #include "common/settings.h"
 #include "video_core/renderer_vulkan/vk_master_semaphore.h"
@@ -102,11 +103,14 @@ void MasterSemaphore::Wait(u64 tick) {
 
 VkResult MasterSemaphore::SubmitQueue(vk::CommandBuffer& cmdbuf, vk::CommandBuffer& upload_cmdbuf,
                                       VkSemaphore signal_semaphore, VkSemaphore wait_semaphore,
-                                      u64 host_tick) {
+                                      u64 host_tick, VkSemaphore timeline_wait_semaphore,
+                                      u64 timeline_wait_value) {
     if (semaphore) {
         return SubmitQueueTimeline(cmdbuf, upload_cmdbuf, signal_semaphore, wait_semaphore,
-                                   host_tick);
+                                   host_tick, timeline_wait_semaphore, timeline_wait_value);
     } else {
+        // Timeline waits come from other queues, which are only used with timeline semaphores
+        ASSERT(timeline_wait_value == 0);
         return SubmitQueueFence(cmdbuf, upload_cmdbuf, signal_semaphore, wait_semaphore, host_tick);
     }
 }
@@ -119,7 +123,13 @@ static constexpr std::array<VkPipelineStageFlags, 2> wait_stage_masks{
 VkResult MasterSemaphore::SubmitQueueTimeline(vk::CommandBuffer& cmdbuf,
                                               vk::CommandBuffer& upload_cmdbuf,
                                               VkSemaphore signal_semaphore,
-                                              VkSemaphore wait_semaphore, u64 host_tick) {
+                                              VkSemaphore wait_semaphore, u64 host_tick,
+                                              VkSemaphore timeline_wait_semaphore,
+                                              u64 timeline_wait_value) {
+    static constexpr std::array<VkPipelineStageFlags, 2> timeline_wait_stage_masks{
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+    };
     const VkSemaphore timeline_semaphore = *semaphore;
 
     const u32 num_signal_semaphores = signal_semaphore ? 2 : 1;
@@ -128,12 +138,22 @@ VkResult MasterSemaphore::SubmitQueueTimeline(vk::CommandBuffer& cmdbuf,
 
     const std::array cmdbuffers{*upload_cmdbuf, *cmdbuf};
 
-    const u32 num_wait_semaphores = wait_semaphore ? 1 : 0;
+    // Values are ignored for the binary wait semaphore
+    std::array<VkSemaphore, 2> wait_semaphores{};
+    std::array<u64, 2> wait_values{};
+    u32 num_wait_semaphores = 0;
+    if (wait_semaphore) {
+        wait_semaphores[num_wait_semaphores++] = wait_semaphore;
+    }
+    if (timeline_wait_value != 0) {
+        wait_semaphores[num_wait_semaphores] = timeline_wait_semaphore;
+        wait_values[num_wait_semaphores++] = timeline_wait_value;
+    }
     const VkTimelineSemaphoreSubmitInfo timeline_si{
         .sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO,
         .pNext = nullptr,
-        .waitSemaphoreValueCount = 0,
-        .pWaitSemaphoreValues = nullptr,
+        .waitSemaphoreValueCount = num_wait_semaphores,
+        .pWaitSemaphoreValues = wait_values.data(),
         .signalSemaphoreValueCount = num_signal_semaphores,
         .pSignalSemaphoreValues = signal_values.data(),
     };
@@ -141,8 +161,8 @@ VkResult MasterSemaphore::SubmitQueueTimeline(vk::CommandBuffer& cmdbuf,
         .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
         .pNext = &timeline_si,
         .waitSemaphoreCount = num_wait_semaphores,
-        .pWaitSemaphores = &wait_semaphore,
-        .pWaitDstStageMask = wait_stage_masks.data(),
+        .pWaitSemaphores = wait_semaphores.data(),
+        .pWaitDstStageMask = timeline_wait_stage_masks.data(),
         .commandBufferCount = static_cast<u32>(cmdbuffers.size()),
         .pCommandBuffers = cmdbuffers.data(),
         .signalSemaphoreCount = num_signal_semaphores,
@@ -0,0 +1,77 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <memory>
+#include <stdexcept>
+
+#include <fmt/format.h>
+
+#include "common/dynamic_library.h"
+#include "common/logging/log.h"
+#include "core/device_memory.h"
+#include "video_core/host1x/gpu_device_memory_manager.h"
+#include "video_core/renderer_vulkan/blit_image.h"
+#include "video_core/renderer_vulkan/renderer_vulkan.h"
+#include "video_core/renderer_vulkan/vk_buffer_cache.h"
+#include "video_core/renderer_vulkan/vk_descriptor_pool.h"
+#include "video_core/renderer_vulkan/vk_offline_pipeline_builder.h"
+#include "video_core/renderer_vulkan/vk_pipeline_cache.h"
+#include "video_core/renderer_vulkan/vk_render_pass_cache.h"
+#include "video_core/renderer_vulkan/vk_scheduler.h"
+#include "video_core/renderer_vulkan/vk_staging_buffer_pool.h"
+#include "video_core/renderer_vulkan/vk_state_tracker.h"
+#include "video_core/renderer_vulkan/vk_texture_cache.h"
+#include "video_core/renderer_vulkan/vk_update_descriptor.h"
+#include "video_core/shader_notify.h"
+#include "video_core/vulkan_common/vulkan_device.h"
+#include "video_core/vulkan_common/vulkan_instance.h"
+#include "video_core/vulkan_common/vulkan_library.h"
+#include "video_core/vulkan_common/vulkan_memory_allocator.h"
+#include "video_core/vulkan_common/vulkan_wrapper.h"
+
+namespace Vulkan {
+
+void BuildOfflinePipelineCaches(u64 title_id, std::stop_token stop_loading,
+                                const VideoCore::DiskResourceLoadCallback& callback) try {
+    // Guest memory is never read while loading, but the caches are tied to a memory manager
+    const auto physical_memory{std::make_unique<Core::DeviceMemory>()};
+    Tegra::MaxwellDeviceMemoryManager device_memory{*physical_memory};
+
+    const std::shared_ptr<Common::DynamicLibrary> library{OpenLibrary()};
+    vk::InstanceDispatch dld;
+    const vk::Instance instance{CreateInstance(*library, dld, VK_API_VERSION_1_1)};
+    const Device device{CreateDevice(instance, dld, VK_NULL_HANDLE)};
+    LOG_INFO(Render_Vulkan, "Building pipelines of {:016x} for {} ({})", title_id,
+             device.GetModelName(), device.GetDriverName());
+
+    MemoryAllocator memory_allocator(device);
+    StateTracker state_tracker;
+    Scheduler scheduler(device, state_tracker);
+    StagingBufferPool staging_pool(device, memory_allocator, scheduler);
+    DescriptorPool descriptor_pool(device, scheduler);
+    GuestDescriptorQueue guest_descriptor_queue(device, scheduler);
+    ComputePassDescriptorQueue compute_pass_descriptor_queue(device, scheduler);
+    BlitImageHelper blit_image(device, scheduler, state_tracker, descriptor_pool);
+    RenderPassCache render_pass_cache(device);
+    TextureCacheRuntime texture_cache_runtime{
+        device,     scheduler,         memory_allocator, staging_pool,
+        blit_image, render_pass_cache, descriptor_pool,  compute_pass_descriptor_queue};
+    TextureCache texture_cache(texture_cache_runtime, device_memory);
+    BufferCacheRuntime buffer_cache_runtime(device, memory_allocator, scheduler, staging_pool,
+                                            guest_descriptor_queue, compute_pass_descriptor_queue,
+                                            descriptor_pool);
+    BufferCache buffer_cache(device_memory, buffer_cache_runtime);
+    VideoCore::ShaderNotify shader_notify;
+
+    PipelineCache pipeline_cache(device_memory, device, scheduler, descriptor_pool,
+                                 guest_descriptor_queue, render_pass_cache, buffer_cache,
+                                 texture_cache, shader_notify);
+    pipeline_cache.LoadDiskResources(title_id, stop_loading, callback);
+    device.GetLogical().WaitIdle();
+
+} catch (const vk::Exception& exception) {
+    LOG_ERROR(Render_Vulkan, "Vulkan initialization failed with error: {}", exception.what());
+    throw std::runtime_error{fmt::format("Vulkan initialization error {}", exception.what())};
+}
+
+} // namespace Vulkan
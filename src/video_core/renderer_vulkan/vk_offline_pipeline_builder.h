@@ -0,0 +1,23 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "common/common_types.h"
+#include "common/polyfill_thread.h"
+#include "video_core/rasterizer_interface.h"
+
+namespace Vulkan {
+
+/**
+ * Builds every pipeline of a title's transferable cache without running the guest, so caches can
+ * be pre-warmed ahead of time. The transferable cache is read from the shader directory, and the
+ * driver pipeline cache and pipeline binaries for the Vulkan device selected in the settings are
+ * written next to it.
+ *
+ * @throws std::runtime_error when the Vulkan device can't be initialized
+ */
+void BuildOfflinePipelineCaches(u64 title_id, std::stop_token stop_loading,
+                                const VideoCore::DiskResourceLoadCallback& callback);
+
+} // namespace Vulkan
@@ -0,0 +1,285 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <type_traits>
+
+#include "common/cityhash.h"
+#include "common/fs/fs.h"
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
+#include "common/settings.h"
+#include "video_core/renderer_vulkan/vk_pipeline_binary_cache.h"
+#include "video_core/vulkan_common/vulkan_device.h"
+
+namespace Vulkan {
+namespace {
+constexpr std::array<char, 8> BINARY_CACHE_MAGIC_NUMBER{'y', 'u', 'z', 'u', 'v', 'k', 'b', 'n'};
+constexpr std::array<char, 8> SHARED_CACHE_MAGIC_NUMBER{'y', 'u', 'z', 'u', 'v', 'k', 's', 'h'};
+
+using EntryMap = std::unordered_map<GraphicsPipelineCacheKey, PipelineBinaryCache::Entry>;
+
+/// Entries loaded by any cache of the process, keyed by file and header
+std::mutex loaded_mutex;
+std::map<std::string, std::weak_ptr<const EntryMap>> loaded_entries;
+
+/// Serializes appends, systems running side by side may share a cache file
+std::mutex append_mutex;
+
+template <typename T>
+struct IsMap : std::false_type {};
+
+template <typename Key, typename Value, typename Compare, typename Allocator>
+struct IsMap<std::map<Key, Value, Compare, Allocator>> : std::true_type {};
+
+template <typename T>
+concept Container = requires(T& container) {
+    container.data();
+    container.resize(size_t{});
+};
+
+template <typename T>
+void Write(std::ofstream& file, const T& value) {
+    if constexpr (IsMap<T>::value) {
+        const u32 size{static_cast<u32>(value.size())};
+        file.write(reinterpret_cast<const char*>(&size), sizeof(size));
+        for (const auto& [key, mapped] : value) {
+            Write(file, key);
+            Write(file, mapped);
+        }
+    } else if constexpr (Container<T>) {
+        static_assert(std::is_trivially_copyable_v<typename T::value_type>);
+        const u32 size{static_cast<u32>(value.size())};
+        file.write(reinterpret_cast<const char*>(&size), sizeof(size))
+            .write(reinterpret_cast<const char*>(value.data()),
+                   size * sizeof(typename T::value_type));
+    } else {
+        static_assert(std::is_trivially_copyable_v<T>);
+        file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+}
+
+template <typename T>
+void Read(std::ifstream& file, T& value) {
+    if constexpr (IsMap<T>::value) {
+        u32 size{};
+        file.read(reinterpret_cast<char*>(&size), sizeof(size));
+        value.clear();
+        for (u32 index = 0; index < size; ++index) {
+            typename T::key_type key;
+            typename T::mapped_type mapped;
+            Read(file, key);
+            Read(file, mapped);
+            value.emplace(key, mapped);
+        }
+    } else if constexpr (Container<T>) {
+        u32 size{};
+        file.read(reinterpret_cast<char*>(&size), sizeof(size));
+        if (size > value.max_size()) {
+            throw std::ios_base::failure("Invalid pipeline binary container size");
+        }
+        value.resize(size);
+        file.read(reinterpret_cast<char*>(value.data()), size * sizeof(typename T::value_type));
+    } else {
+        file.read(reinterpret_cast<char*>(&value), sizeof(value));
+    }
+}
+
+/// Calls func with every member of Shader::Info, bump CACHE_VERSION when this list changes
+template <typename InfoType, typename Func>
+void VisitInfo(InfoType& info, Func&& func) {
+    func(info.uses_workgroup_id, info.uses_local_invocation_id, info.uses_invocation_id,
+         info.uses_invocation_info, info.uses_sample_id, info.uses_is_helper_invocation,
+         info.uses_subgroup_invocation_id, info.uses_subgroup_shuffles, info.uses_patches,
+         info.interpolation, info.loads, info.stores, info.passthrough,
+         info.legacy_stores_mapping, info.loads_indexed_attributes, info.stores_frag_color,
+         info.stores_sample_mask, info.stores_frag_depth, info.stores_tess_level_outer,
+         info.stores_tess_level_inner, info.stores_indexed_attributes, info.stores_global_memory,
+         info.uses_local_memory);
+    func(info.uses_fp16, info.uses_fp64, info.uses_fp16_denorms_flush,
+         info.uses_fp16_denorms_preserve, info.uses_fp32_denorms_flush,
+         info.uses_fp32_denorms_preserve, info.uses_int8, info.uses_int16, info.uses_int64,
+         info.uses_image_1d, info.uses_sampled_1d, info.uses_sparse_residency,
+         info.uses_demote_to_helper_invocation, info.uses_subgroup_vote, info.uses_subgroup_mask,
+         info.uses_fswzadd, info.uses_derivatives, info.uses_typeless_image_reads,
+         info.uses_typeless_image_writes, info.uses_image_buffers, info.uses_shared_increment,
+         info.uses_shared_decrement, info.uses_global_increment, info.uses_global_decrement);
+    func(info.uses_atomic_f32_add, info.uses_atomic_f16x2_add, info.uses_atomic_f16x2_min,
+         info.uses_atomic_f16x2_max, info.uses_atomic_f32x2_add, info.uses_atomic_f32x2_min,
+         info.uses_atomic_f32x2_max, info.uses_atomic_s32_min, info.uses_atomic_s32_max,
+         info.uses_int64_bit_atomics, info.uses_global_memory, info.uses_atomic_image_u32,
+         info.uses_shadow_lod, info.uses_rescaling_uniform, info.uses_cbuf_indirect,
+         info.uses_render_area);
+    func(info.used_constant_buffer_types, info.used_storage_buffer_types,
+         info.used_indirect_cbuf_types, info.constant_buffer_mask,
+         info.constant_buffer_used_sizes, info.nvn_buffer_base, info.nvn_buffer_used,
+         info.requires_layer_emulation, info.emulated_layer, info.used_clip_distances);
+    func(info.constant_buffer_descriptors, info.storage_buffers_descriptors,
+         info.texture_buffer_descriptors, info.image_buffer_descriptors, info.texture_descriptors,
+         info.image_descriptors, info.constant_buffer_guards);
+}
+
+/// Calls func with every member of VideoCommon::EnvironmentQueries
+template <typename QueriesType, typename Func>
+void VisitQueries(QueriesType& queries, Func&& func) {
+    func(queries.cbuf_values, queries.texture_types, queries.texture_pixel_formats,
+         queries.texture_pixel_format_integers, queries.viewport_transform_state,
+         queries.local_memory_size, queries.texture_bound);
+}
+
+/// Hashes the settings that change the output of the shader recompiler
+u64 TranslationSettingsHash() {
+    const auto& resolution{Settings::values.resolution_info};
+    const std::array<u32, 8> settings{
+        resolution.active ? 1U : 0U,
+        resolution.up_scale,
+        resolution.down_shift,
+        Settings::values.renderer_debug.GetValue() ? 1U : 0U,
+        Settings::values.disable_shader_loop_safety_checks.GetValue() ? 1U : 0U,
+        Settings::values.disable_shader_gvn.GetValue() ? 1U : 0U,
+        Settings::values.disable_shader_licm.GetValue() ? 1U : 0U,
+        Settings::values.use_shader_cbuf_specialization.GetValue() ? 1U : 0U,
+    };
+    return Common::CityHash64(reinterpret_cast<const char*>(settings.data()),
+                              settings.size() * sizeof(u32));
+}
+} // Anonymous namespace
+
+PipelineBinaryCache::PipelineBinaryCache(const Device& device_, bool is_shared_)
+    : device{device_}, is_shared{is_shared_} {}
+
+PipelineBinaryCache::~PipelineBinaryCache() = default;
+
+PipelineBinaryCache::Header PipelineBinaryCache::MakeHeader(u32 version) const {
+    Header header{
+        .magic = is_shared ? SHARED_CACHE_MAGIC_NUMBER : BINARY_CACHE_MAGIC_NUMBER,
+        .cache_version = version,
+        .driver_version = device.GetDriverVersion(),
+        .pipeline_cache_uuid{},
+        .settings_hash = TranslationSettingsHash(),
+    };
+    std::ranges::copy(device.GetPipelineCacheUUID(), header.pipeline_cache_uuid.begin());
+    return header;
+}
+
+void PipelineBinaryCache::Load(const std::filesystem::path& filename_,
+                               u32 expected_cache_version) try {
+    filename = filename_;
+    cache_version = expected_cache_version;
+
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        return;
+    }
+    file.exceptions(std::ifstream::failbit);
+    const auto end{file.tellg()};
+    file.seekg(0, std::ios::beg);
+
+    static_assert(std::has_unique_object_representations_v<Header>);
+    const Header expected_header{MakeHeader(expected_cache_version)};
+
+    std::string loaded_key{Common::FS::PathToUTF8String(filename)};
+    loaded_key.append(reinterpret_cast<const char*>(&expected_header), sizeof(Header));
+    std::scoped_lock lock{loaded_mutex};
+    if (auto loaded = loaded_entries[loaded_key].lock()) {
+        entries = std::move(loaded);
+        return;
+    }
+
+    Header header;
+    Read(file, header);
+    if (std::memcmp(&header, &expected_header, sizeof(Header)) != 0) {
+        file.close();
+        if (Common::FS::RemoveFile(filename)) {
+            LOG_INFO(Common_Filesystem, "Deleting pipeline binary cache built for another host");
+        } else {
+            LOG_ERROR(Common_Filesystem,
+                      "Outdated pipeline binary cache file and failed to delete it in \"{}\"",
+                      Common::FS::PathToUTF8String(filename));
+        }
+        return;
+    }
+    auto new_entries{std::make_shared<EntryMap>()};
+    while (file.tellg() != end) {
+        GraphicsPipelineCacheKey key;
+        Read(file, key);
+        Entry entry;
+        for (size_t stage = 0; stage < NUM_STAGES; ++stage) {
+            VisitInfo(entry.infos[stage], [&](auto&... fields) { (Read(file, fields), ...); });
+            Read(file, entry.codes[stage]);
+        }
+        if (is_shared) {
+            for (VideoCommon::EnvironmentQueries& queries : entry.queries) {
+                VisitQueries(queries, [&](auto&... fields) { (Read(file, fields), ...); });
+            }
+        }
+        new_entries->insert_or_assign(key, std::move(entry));
+    }
+    LOG_INFO(Render_Vulkan, "Loaded {} {}pipeline binaries", new_entries->size(),
+             is_shared ? "shared " : "");
+    entries = new_entries;
+    loaded_entries[loaded_key] = entries;
+
+} catch (const std::ios_base::failure& e) {
+    LOG_ERROR(Common_Filesystem, "{}", e.what());
+    entries.reset();
+    if (!Common::FS::RemoveFile(filename)) {
+        LOG_ERROR(Common_Filesystem, "Failed to delete pipeline binary cache file {}",
+                  Common::FS::PathToUTF8String(filename));
+    }
+}
+
+void PipelineBinaryCache::Append(const GraphicsPipelineCacheKey& key,
+                                 const Entry& entry) const try {
+    if (filename.empty()) {
+        return;
+    }
+    std::scoped_lock lock{append_mutex};
+    std::ofstream file(filename, std::ios::binary | std::ios::ate | std::ios::app);
+    file.exceptions(std::ifstream::failbit);
+    if (!file.is_open()) {
+        LOG_ERROR(Common_Filesystem, "Failed to open pipeline binary cache file {}",
+                  Common::FS::PathToUTF8String(filename));
+        return;
+    }
+    if (file.tellp() == 0) {
+        Write(file, MakeHeader(cache_version));
+    }
+    Write(file, key);
+    for (size_t stage = 0; stage < NUM_STAGES; ++stage) {
+        VisitInfo(entry.infos[stage], [&](const auto&... fields) { (Write(file, fields), ...); });
+        Write(file, entry.codes[stage]);
+    }
+    if (is_shared) {
+        for (const VideoCommon::EnvironmentQueries& queries : entry.queries) {
+            VisitQueries(queries, [&](const auto&... fields) { (Write(file, fields), ...); });
+        }
+    }
+
+} catch (const std::ios_base::failure& e) {
+    LOG_ERROR(Common_Filesystem, "{}", e.what());
+    if (!Common::FS::RemoveFile(filename)) {
+        LOG_ERROR(Common_Filesystem, "Failed to delete pipeline binary cache file {}",
+                  Common::FS::PathToUTF8String(filename));
+    }
+}
+
+const PipelineBinaryCache::Entry* PipelineBinaryCache::Find(
+    const GraphicsPipelineCacheKey& key) const {
+    if (!entries) {
+        return nullptr;
+    }
+    const auto it{entries->find(key)};
+    return it != entries->end() ? &it->second : nullptr;
+}
+
+void PipelineBinaryCache::ReleaseEntries() {
+    entries.reset();
+}
+
+} // namespace Vulkan
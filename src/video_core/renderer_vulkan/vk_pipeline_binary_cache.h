@@ -0,0 +1,87 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <filesystem>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "common/common_types.h"
+#include "shader_recompiler/shader_info.h"
+#include "video_core/engines/maxwell_3d.h"
+#include "video_core/renderer_vulkan/vk_graphics_pipeline.h"
+#include "video_core/shader_environment.h"
+
+namespace Vulkan {
+
+class Device;
+
+/**
+ * Second tier of the pipeline disk cache. While the guest environment cache has to run the shader
+ * recompiler on every boot, this stores the host SPIR-V and shader info of each graphics pipeline
+ * keyed by its GraphicsPipelineCacheKey, so warm boots can skip translation entirely and hand the
+ * modules straight to the driver pipeline cache.
+ *
+ * Entries are only valid for the device, driver and translation settings they were built with.
+ *
+ * A shared cache is kept across titles, as many of them are built with the same engine shaders.
+ * Its entries also store the environment queries of each program, so they are only used when the
+ * guest state read during translation matches the environments of the pipeline being built.
+ *
+ * Loaded entries are immutable and shared by every cache of the process that loads the same file
+ * for the same host, so systems emulated side by side don't each keep a copy of them.
+ */
+class PipelineBinaryCache {
+public:
+    static constexpr size_t NUM_STAGES = Tegra::Engines::Maxwell3D::Regs::MaxShaderStage;
+    static constexpr size_t NUM_PROGRAMS = Tegra::Engines::Maxwell3D::Regs::MaxShaderProgram;
+
+    struct Entry {
+        std::array<Shader::Info, NUM_STAGES> infos;
+        std::array<std::vector<u32>, NUM_STAGES> codes;
+        /// Only stored in shared caches
+        std::array<VideoCommon::EnvironmentQueries, NUM_PROGRAMS> queries;
+    };
+
+    explicit PipelineBinaryCache(const Device& device, bool is_shared = false);
+    ~PipelineBinaryCache();
+
+    /// Loads every entry from the given file, discarding it when it was built for another host
+    void Load(const std::filesystem::path& filename, u32 expected_cache_version);
+
+    /// Appends an entry to the cache file, must be called from the serialization thread
+    void Append(const GraphicsPipelineCacheKey& key, const Entry& entry) const;
+
+    /// Returns the loaded entry for the given key, or nullptr when there is none
+    [[nodiscard]] const Entry* Find(const GraphicsPipelineCacheKey& key) const;
+
+    /// Frees the loaded entries once all cached pipelines have been built
+    void ReleaseEntries();
+
+    /// Returns true when a cache file has been assigned
+    [[nodiscard]] bool IsEnabled() const noexcept {
+        return !filename.empty();
+    }
+
+private:
+    struct Header {
+        std::array<char, 8> magic;
+        u32 cache_version;
+        u32 driver_version;
+        std::array<u8, 16> pipeline_cache_uuid;
+        u64 settings_hash;
+    };
+
+    [[nodiscard]] Header MakeHeader(u32 cache_version) const;
+
+    const Device& device;
+    bool is_shared{};
+    std::filesystem::path filename;
+    u32 cache_version{};
+    std::shared_ptr<const std::unordered_map<GraphicsPipelineCacheKey, Entry>> entries;
+};
+
+} // namespace Vulkan
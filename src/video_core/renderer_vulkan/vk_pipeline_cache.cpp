@@ -3,19 +3,22 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <exception>
 #include <fstream>
 #include <memory>
+#include <optional>
 #include <thread>
 #include <vector>
 
 #include "common/bit_cast.h"
-#include "common/cityhash.h"
 #include "common/fs/fs.h"
 #include "common/fs/path_util.h"
+#include "common/hash.h"
 #include "common/microprofile.h"
 #include "common/thread_worker.h"
 #include "core/core.h"
 #include "shader_recompiler/backend/spirv/emit_spirv.h"
+#include "shader_recompiler/compile_profiler.h"
 #include "shader_recompiler/environment.h"
 #include "shader_recompiler/frontend/maxwell/control_flow.h"
 #include "shader_recompiler/frontend/maxwell/translate_program.h"
@@ -53,7 +56,7 @@ using VideoCommon::FileEnvironment;
 using VideoCommon::GenericEnvironment;
 using VideoCommon::GraphicsEnvironment;
 
-constexpr u32 CACHE_VERSION = 11;
+constexpr u32 CACHE_VERSION = 12;
 constexpr std::array<char, 8> VULKAN_CACHE_MAGIC_NUMBER{'y', 'u', 'z', 'u', 'v', 'k', 'c', 'h'};
 
 template <typename Container>
@@ -278,10 +281,38 @@ size_t GetTotalPipelineWorkers() {
 #endif
 }
 
+u64 ShaderHash(const GraphicsPipelineCacheKey& key) {
+    return Common::HashBytes(key.unique_hashes.data(), sizeof(key.unique_hashes));
+}
+
+/// Returns true when a pipeline built for fallback can be used to draw with key, both pipelines
+/// must use the same shaders, render pass and vertex fetching and only differ in fixed state
+bool IsFallbackCompatible(const GraphicsPipelineCacheKey& fallback,
+                          const GraphicsPipelineCacheKey& key) {
+    const FixedPipelineState& lhs{fallback.state};
+    const FixedPipelineState& rhs{key.state};
+    if (fallback.unique_hashes != key.unique_hashes || lhs.raw1 != rhs.raw1 ||
+        lhs.raw2 != rhs.raw2 || lhs.color_formats != rhs.color_formats ||
+        lhs.alpha_test_ref != rhs.alpha_test_ref || lhs.point_size != rhs.point_size ||
+        lhs.attribute_types != rhs.attribute_types) {
+        return false;
+    }
+    if (!rhs.dynamic_vertex_input &&
+        (std::memcmp(&lhs.attributes, &rhs.attributes, sizeof(lhs.attributes)) != 0 ||
+         lhs.binding_divisors != rhs.binding_divisors)) {
+        return false;
+    }
+    if (!rhs.extended_dynamic_state && lhs.vertex_strides != rhs.vertex_strides) {
+        return false;
+    }
+    return !rhs.xfb_enabled ||
+           std::memcmp(&lhs.xfb_state, &rhs.xfb_state, sizeof(lhs.xfb_state)) == 0;
+}
+
 } // Anonymous namespace
 
 size_t ComputePipelineCacheKey::Hash() const noexcept {
-    const u64 hash = Common::CityHash64(reinterpret_cast<const char*>(this), sizeof *this);
+    const u64 hash = Common::HashBytes(this, sizeof *this);
     return static_cast<size_t>(hash);
 }
 
@@ -290,7 +321,7 @@ bool ComputePipelineCacheKey::operator==(const ComputePipelineCacheKey& rhs) con
 }
 
 size_t GraphicsPipelineCacheKey::Hash() const noexcept {
-    const u64 hash = Common::CityHash64(reinterpret_cast<const char*>(this), Size());
+    const u64 hash = Common::HashBytes(this, Size());
     return static_cast<size_t>(hash);
 }
 
@@ -309,10 +340,15 @@ PipelineCache::PipelineCache(Tegra::MaxwellDeviceMemoryManager& device_memory_,
       render_pass_cache{render_pass_cache_}, buffer_cache{buffer_cache_},
       texture_cache{texture_cache_}, shader_notify{shader_notify_},
       use_asynchronous_shaders{Settings::values.use_asynchronous_shaders.GetValue()},
+      use_fallback_pipelines{Settings::values.use_async_fallback_pipelines.GetValue()},
       use_vulkan_pipeline_cache{Settings::values.use_vulkan_driver_pipeline_cache.GetValue()},
+      pipeline_binary_cache{device_}, shared_binary_cache{device_, true},
       workers(device.HasBrokenParallelShaderCompiling() ? 1ULL : GetTotalPipelineWorkers(),
               "VkPipelineBuilder"),
-      serialization_thread(1, "VkPipelineSerialization") {
+      serialization_thread(1, "VkPipelineSerialization"),
+      translation_workers(
+          std::min<size_t>(GetTotalPipelineWorkers(), Maxwell::MaxShaderProgram - 1),
+          "VkShaderTranslator") {
     const auto& float_control{device.FloatControlProperties()};
     const VkDriverId driver_id{device.GetDriverID()};
     profile = Shader::Profile{
@@ -390,7 +426,10 @@ PipelineCache::PipelineCache(Tegra::MaxwellDeviceMemoryManager& device_memory_,
         .min_ssbo_alignment = static_cast<u32>(device.GetStorageBufferAlignment()),
         .support_geometry_shader_passthrough = device.IsNvGeometryShaderPassthroughSupported(),
         .support_conditional_barrier = device.SupportsConditionalBarriers(),
+        .specialize_constant_buffers = Settings::values.use_shader_cbuf_specialization.GetValue(),
     };
+    generic_host_info = host_info;
+    generic_host_info.specialize_constant_buffers = false;
 
     if (device.GetMaxVertexInputAttributes() < Maxwell::NumVertexAttributes) {
         LOG_WARNING(Render_Vulkan, "maxVertexInputAttributes is too low: {} < {}",
@@ -407,6 +446,8 @@ PipelineCache::PipelineCache(Tegra::MaxwellDeviceMemoryManager& device_memory_,
         .has_extended_dynamic_state_2_extra = device.IsExtExtendedDynamicState2ExtrasSupported(),
         .has_extended_dynamic_state_3_blend = device.IsExtExtendedDynamicState3BlendingSupported(),
         .has_extended_dynamic_state_3_enables = device.IsExtExtendedDynamicState3EnablesSupported(),
+        .has_extended_dynamic_state_3_rasterization =
+            device.IsExtExtendedDynamicState3RasterizationSupported(),
         .has_dynamic_vertex_input = device.IsExtVertexInputDynamicStateSupported(),
     };
 }
@@ -431,7 +472,7 @@ GraphicsPipeline* PipelineCache::CurrentGraphicsPipeline() {
         GraphicsPipeline* const next{current_pipeline->Next(graphics_key)};
         if (next) {
             current_pipeline = next;
-            return BuiltPipeline(current_pipeline);
+            return DrawPipeline(current_pipeline);
         }
     }
     return CurrentGraphicsPipelineSlowPath();
@@ -473,9 +514,22 @@ void PipelineCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading
     pipeline_cache_filename = base_dir / "vulkan.bin";
 
     if (use_vulkan_pipeline_cache) {
-        vulkan_pipeline_cache_filename = base_dir / "vulkan_pipelines.bin";
+#ifdef ANDROID
+        // Custom drivers can be switched between boots, keep the driver dependent caches of each
+        // one apart instead of discarding them on every switch
+        const std::string driver_suffix = fmt::format("_{:016x}", device.GetDriverFingerprint());
+#else
+        const std::string driver_suffix;
+#endif
+        const auto driver_file = [&driver_suffix](std::string_view name) {
+            return fmt::format("{}{}.bin", name, driver_suffix);
+        };
+        vulkan_pipeline_cache_filename = base_dir / driver_file("vulkan_pipelines");
         vulkan_pipeline_cache =
             LoadVulkanPipelineCache(vulkan_pipeline_cache_filename, CACHE_VERSION);
+        pipeline_binary_cache.Load(base_dir / driver_file("vulkan_binaries"), CACHE_VERSION);
+        shared_binary_cache.Load(shader_dir / driver_file("vulkan_shared_binaries"),
+                                 CACHE_VERSION);
     }
 
     struct {
@@ -489,25 +543,28 @@ void PipelineCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading
     if (device.IsKhrPipelineExecutablePropertiesEnabled()) {
         state.statistics = std::make_unique<PipelineStatistics>(device);
     }
-    const auto load_compute{[&](std::ifstream& file, FileEnvironment env) {
+    const auto load_compute{[&](std::istream& file, FileEnvironment env) {
         ComputePipelineCacheKey key;
         file.read(reinterpret_cast<char*>(&key), sizeof(key));
 
-        workers.QueueWork([this, key, env_ = std::move(env), &state, &callback]() mutable {
-            ShaderPools pools;
-            auto pipeline{CreateComputePipeline(pools, key, env_, state.statistics.get(), false)};
-            std::scoped_lock lock{state.mutex};
-            if (pipeline) {
-                compute_cache.emplace(key, std::move(pipeline));
-            }
-            ++state.built;
-            if (state.has_loaded) {
-                callback(VideoCore::LoadCallbackStage::Build, state.built, state.total);
-            }
-        });
+        workers.QueueWork(
+            [this, key, env_ = std::move(env), &state, &callback]() mutable {
+                ShaderPools pools;
+                auto pipeline{
+                    CreateComputePipeline(pools, key, env_, state.statistics.get(), false)};
+                std::scoped_lock lock{state.mutex};
+                if (pipeline) {
+                    compute_cache.emplace(key, std::move(pipeline));
+                }
+                ++state.built;
+                if (state.has_loaded) {
+                    callback(VideoCore::LoadCallbackStage::Build, state.built, state.total);
+                }
+            },
+            Common::WorkLane::Background);
         ++state.total;
     }};
-    const auto load_graphics{[&](std::ifstream& file, std::vector<FileEnvironment> envs) {
+    const auto load_graphics{[&](std::istream& file, std::vector<FileEnvironment> envs) {
         GraphicsPipelineCacheKey key;
         file.read(reinterpret_cast<char*>(&key), sizeof(key));
 
@@ -521,27 +578,32 @@ void PipelineCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading
                 dynamic_features.has_extended_dynamic_state_3_blend ||
             (key.state.extended_dynamic_state_3_enables != 0) !=
                 dynamic_features.has_extended_dynamic_state_3_enables ||
+            (key.state.extended_dynamic_state_3_rasterization != 0) !=
+                dynamic_features.has_extended_dynamic_state_3_rasterization ||
             (key.state.dynamic_vertex_input != 0) != dynamic_features.has_dynamic_vertex_input) {
             return;
         }
-        workers.QueueWork([this, key, envs_ = std::move(envs), &state, &callback]() mutable {
-            ShaderPools pools;
-            boost::container::static_vector<Shader::Environment*, 5> env_ptrs;
-            for (auto& env : envs_) {
-                env_ptrs.push_back(&env);
-            }
-            auto pipeline{CreateGraphicsPipeline(pools, key, MakeSpan(env_ptrs),
-                                                 state.statistics.get(), false)};
+        workers.QueueWork(
+            [this, key, envs_ = std::move(envs), &state, &callback]() mutable {
+                ShaderPools pools;
+                boost::container::static_vector<Shader::Environment*, 5> env_ptrs;
+                for (auto& env : envs_) {
+                    env_ptrs.push_back(&env);
+                }
+                auto pipeline{CreateGraphicsPipeline(pools, key, MakeSpan(env_ptrs),
+                                                     state.statistics.get(), false, true)};
 
-            std::scoped_lock lock{state.mutex};
-            if (pipeline) {
-                graphics_cache.emplace(key, std::move(pipeline));
-            }
-            ++state.built;
-            if (state.has_loaded) {
-                callback(VideoCore::LoadCallbackStage::Build, state.built, state.total);
-            }
-        });
+                std::scoped_lock lock{state.mutex};
+                if (pipeline) {
+                    RegisterFallbackPipeline(pipeline.get());
+                    graphics_cache.emplace(key, std::move(pipeline));
+                }
+                ++state.built;
+                if (state.has_loaded) {
+                    callback(VideoCore::LoadCallbackStage::Build, state.built, state.total);
+                }
+            },
+            Common::WorkLane::Background);
         ++state.total;
     }};
     VideoCommon::LoadPipelines(stop_loading, pipeline_cache_filename, CACHE_VERSION, load_compute,
@@ -555,6 +617,8 @@ void PipelineCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading
     lock.unlock();
 
     workers.WaitForRequests(stop_loading);
+    VideoCommon::LogWorkerStatistics(workers);
+    pipeline_binary_cache.ReleaseEntries();
 
     if (use_vulkan_pipeline_cache) {
         SerializeVulkanPipelineCache(vulkan_pipeline_cache_filename, vulkan_pipeline_cache,
@@ -571,6 +635,9 @@ GraphicsPipeline* PipelineCache::CurrentGraphicsPipelineSlowPath() {
     auto& pipeline{pair->second};
     if (is_new) {
         pipeline = CreateGraphicsPipeline();
+        if (pipeline) {
+            RegisterFallbackPipeline(pipeline.get());
+        }
     }
     if (!pipeline) {
         return nullptr;
@@ -579,7 +646,26 @@ GraphicsPipeline* PipelineCache::CurrentGraphicsPipelineSlowPath() {
         current_pipeline->AddTransition(pipeline.get());
     }
     current_pipeline = pipeline.get();
-    return BuiltPipeline(current_pipeline);
+    return DrawPipeline(current_pipeline);
+}
+
+GraphicsPipeline* PipelineCache::DrawPipeline(GraphicsPipeline* pipeline) {
+    if (!pipeline->MatchesConstantBufferGuards(*maxwell3d, *gpu_memory)) {
+        // The shaders were specialized on other values, draw with a variant reading them
+        const auto [pair, is_new]{generic_graphics_cache.try_emplace(pipeline->Key())};
+        auto& generic{pair->second};
+        if (is_new) {
+            generic = CreateGenericGraphicsPipeline();
+            if (generic) {
+                RegisterFallbackPipeline(generic.get());
+            }
+        }
+        if (!generic) {
+            return nullptr;
+        }
+        pipeline = generic.get();
+    }
+    return BuiltPipeline(pipeline);
 }
 
 GraphicsPipeline* PipelineCache::BuiltPipeline(GraphicsPipeline* pipeline) const noexcept {
@@ -592,7 +678,7 @@ GraphicsPipeline* PipelineCache::BuiltPipeline(GraphicsPipeline* pipeline) const
     // If something is using depth, we can assume that games are not rendering anything which
     // will be used one time.
     if (maxwell3d->regs.zeta_enable) {
-        return nullptr;
+        return FallbackPipeline(*pipeline);
     }
     // If games are using a small index count, we can assume these are full screen quads.
     // Usually these shaders are only used once for building textures so we can assume they
@@ -601,20 +687,141 @@ GraphicsPipeline* PipelineCache::BuiltPipeline(GraphicsPipeline* pipeline) const
     if (draw_state.index_buffer.count <= 6 || draw_state.vertex_buffer.count <= 6) {
         return pipeline;
     }
+    return FallbackPipeline(*pipeline);
+}
+
+GraphicsPipeline* PipelineCache::FallbackPipeline(const GraphicsPipeline& pipeline) const noexcept {
+    if (!use_fallback_pipelines) {
+        return nullptr;
+    }
+    const auto it{fallback_pipelines.find(ShaderHash(pipeline.Key()))};
+    if (it == fallback_pipelines.end()) {
+        return nullptr;
+    }
+    for (GraphicsPipeline* const candidate : it->second) {
+        if (candidate->IsBuilt() && IsFallbackCompatible(candidate->Key(), pipeline.Key()) &&
+            candidate->MatchesConstantBufferGuards(*maxwell3d, *gpu_memory)) {
+            return candidate;
+        }
+    }
     return nullptr;
 }
 
+void PipelineCache::RegisterFallbackPipeline(GraphicsPipeline* pipeline) {
+    fallback_pipelines[ShaderHash(pipeline->Key())].push_back(pipeline);
+}
+
 std::unique_ptr<GraphicsPipeline> PipelineCache::CreateGraphicsPipeline(
     ShaderPools& pools, const GraphicsPipelineCacheKey& key,
     std::span<Shader::Environment* const> envs, PipelineStatistics* statistics,
-    bool build_in_parallel) try {
+    bool build_in_parallel, bool specialize) try {
+    // Binaries are only stored for the pipelines the key selects, specialized when enabled
+    const PipelineBinaryCache::Entry* const entry{specialize ? pipeline_binary_cache.Find(key)
+                                                             : nullptr};
+    if (entry) {
+        return CreateCachedGraphicsPipeline(key, *entry, statistics, build_in_parallel);
+    }
+    if (const PipelineBinaryCache::Entry* const shared_entry{
+            specialize ? FindSharedBinary(key, envs) : nullptr}) {
+        // Fill the title cache, so the next boot doesn't have to validate the environments
+        if (pipeline_binary_cache.IsEnabled()) {
+            serialization_thread.QueueWork(
+                [this, key, shared_entry] { pipeline_binary_cache.Append(key, *shared_entry); });
+        }
+        return CreateCachedGraphicsPipeline(key, *shared_entry, statistics, build_in_parallel);
+    }
+    const Shader::ScratchArena::Scope scratch_scope{pools.arena};
     auto hash = key.Hash();
     LOG_INFO(Render_Vulkan, "0x{:016x}", hash);
-    size_t env_index{0};
     std::array<Shader::IR::Program, Maxwell::MaxShaderProgram> programs;
     const bool uses_vertex_a{key.unique_hashes[0] != 0};
     const bool uses_vertex_b{key.unique_hashes[1] != 0};
 
+    std::array<Shader::Environment*, Maxwell::MaxShaderProgram> stage_envs{};
+    for (size_t index = 0, env_index = 0; index < Maxwell::MaxShaderProgram; ++index) {
+        if (key.unique_hashes[index] != 0) {
+            stage_envs[index] = envs[env_index++];
+        }
+    }
+    // Record the guest state read by the recompiler, so other titles can validate shared binaries
+    const bool store_shared{specialize && shared_binary_cache.IsEnabled() &&
+                            std::ranges::none_of(envs, &Shader::Environment::HasHLEMacroState)};
+    std::array<std::optional<VideoCommon::RecordingEnvironment>, Maxwell::MaxShaderProgram>
+        recorders;
+    if (store_shared) {
+        for (size_t index = 0; index < Maxwell::MaxShaderProgram; ++index) {
+            if (stage_envs[index]) {
+                stage_envs[index] = &recorders[index].emplace(*stage_envs[index]);
+            }
+        }
+    }
+    // Stages can be translated on different threads, each of them is profiled separately
+    const bool profiling{shader_notify.IsProfiling()};
+    std::array<Shader::CompileProfiler, Maxwell::MaxShaderProgram> stage_profilers;
+    const auto translate{[&](size_t index, ShaderPools& stage_pools) {
+        const Shader::ScratchArena::Scope stage_scratch_scope{stage_pools.arena};
+        std::optional<Shader::CompileProfiler::Scope> profiler_scope;
+        if (profiling) {
+            profiler_scope.emplace(stage_profilers[index]);
+        }
+        Shader::Environment& env{*stage_envs[index]};
+        const u32 cfg_offset{static_cast<u32>(env.StartAddress() + sizeof(Shader::ProgramHeader))};
+        std::optional<Shader::CompileProfiler::ScopedPhase> cfg_phase{std::in_place,
+                                                                      "control_flow"};
+        Shader::Maxwell::Flow::CFG cfg(env, stage_pools.flow_block, cfg_offset, index == 0);
+        cfg_phase.reset();
+        programs[index] = TranslateProgram(stage_pools.inst, stage_pools.block, env, cfg,
+                                           specialize ? host_info : generic_host_info);
+    }};
+    if (build_in_parallel) {
+        // The pipeline is on the critical path, translate the guest stages concurrently.
+        // The first stage is translated on this thread, the rest on the translation workers.
+        std::array<std::exception_ptr, Maxwell::MaxShaderProgram> exceptions{};
+        std::optional<size_t> first_stage;
+        for (size_t index = 0; index < Maxwell::MaxShaderProgram; ++index) {
+            if (!stage_envs[index]) {
+                continue;
+            }
+            if (!first_stage) {
+                first_stage = index;
+                continue;
+            }
+            translation_workers.QueueWork([&, index] {
+                ShaderPools& stage_pools{translation_pools[index]};
+                stage_pools.ReleaseContents();
+                try {
+                    translate(index, stage_pools);
+                } catch (...) {
+                    exceptions[index] = std::current_exception();
+                }
+            });
+        }
+        if (first_stage) {
+            try {
+                translate(*first_stage, pools);
+            } catch (...) {
+                exceptions[*first_stage] = std::current_exception();
+            }
+        }
+        translation_workers.WaitForRequests();
+        for (const std::exception_ptr& exception : exceptions) {
+            if (exception) {
+                std::rethrow_exception(exception);
+            }
+        }
+    } else {
+        for (size_t index = 0; index < Maxwell::MaxShaderProgram; ++index) {
+            if (stage_envs[index]) {
+                translate(index, pools);
+            }
+        }
+    }
+
+    Shader::CompileProfiler profiler;
+    std::optional<Shader::CompileProfiler::Scope> profiler_scope;
+    if (profiling) {
+        profiler_scope.emplace(profiler);
+    }
     // Layer passthrough generation for devices without VK_EXT_shader_viewport_index_layer
     Shader::IR::Program* layer_source_program{};
 
@@ -630,19 +837,10 @@ std::unique_ptr<GraphicsPipeline> PipelineCache::CreateGraphicsPipeline(
         if (key.unique_hashes[index] == 0) {
             continue;
         }
-        Shader::Environment& env{*envs[env_index]};
-        ++env_index;
-
-        const u32 cfg_offset{static_cast<u32>(env.StartAddress() + sizeof(Shader::ProgramHeader))};
-        Shader::Maxwell::Flow::CFG cfg(env, pools.flow_block, cfg_offset, index == 0);
-        if (!uses_vertex_a || index != 1) {
-            // Normal path
-            programs[index] = TranslateProgram(pools.inst, pools.block, env, cfg, host_info);
-        } else {
-            // VertexB path when VertexA is present.
-            auto& program_va{programs[0]};
-            auto program_vb{TranslateProgram(pools.inst, pools.block, env, cfg, host_info)};
-            programs[index] = MergeDualVertexPrograms(program_va, program_vb, env);
+        Shader::Environment& env{*stage_envs[index]};
+        if (uses_vertex_a && index == 1) {
+            // VertexB path when VertexA is present, join both translated programs.
+            programs[index] = MergeDualVertexPrograms(programs[0], programs[index], env);
         }
 
         if (Settings::values.dump_shaders) {
@@ -655,6 +853,8 @@ std::unique_ptr<GraphicsPipeline> PipelineCache::CreateGraphicsPipeline(
     }
     std::array<const Shader::Info*, Maxwell::MaxShaderStage> infos{};
     std::array<vk::ShaderModule, Maxwell::MaxShaderStage> modules;
+    const bool store_binaries{specialize && (pipeline_binary_cache.IsEnabled() || store_shared)};
+    auto binary_entry{store_binaries ? std::make_unique<PipelineBinaryCache::Entry>() : nullptr};
 
     const Shader::IR::Program* previous_stage{};
     Shader::Backend::Bindings binding;
@@ -673,15 +873,44 @@ std::unique_ptr<GraphicsPipeline> PipelineCache::CreateGraphicsPipeline(
 
         const auto runtime_info{MakeRuntimeInfo(programs, key, program, previous_stage)};
         ConvertLegacyToGeneric(program, runtime_info);
+        std::optional<Shader::CompileProfiler::ScopedPhase> emit_phase{std::in_place,
+                                                                       "emit_spirv"};
         const std::vector<u32> code{EmitSPIRV(profile, runtime_info, program, binding)};
+        emit_phase.reset();
         device.SaveShader(code);
-        modules[stage_index] = BuildShader(device, code);
+        {
+            const Shader::CompileProfiler::ScopedPhase module_phase{"shader_module"};
+            modules[stage_index] = BuildShader(device, code);
+        }
         if (device.HasDebuggingToolAttached()) {
             const std::string name{fmt::format("Shader {:016x}", key.unique_hashes[index])};
             modules[stage_index].SetObjectNameEXT(name.c_str());
         }
+        if (binary_entry) {
+            binary_entry->infos[stage_index] = program.info;
+            binary_entry->codes[stage_index] = code;
+        }
         previous_stage = &program;
     }
+    if (binary_entry) {
+        for (size_t index = 0; index < Maxwell::MaxShaderProgram; ++index) {
+            if (recorders[index]) {
+                binary_entry->queries[index] = recorders[index]->Queries();
+            }
+        }
+        serialization_thread.QueueWork([this, key, store_shared, entry = std::move(binary_entry)] {
+            pipeline_binary_cache.Append(key, *entry);
+            if (store_shared) {
+                shared_binary_cache.Append(key, *entry);
+            }
+        });
+    }
+    if (profiling) {
+        for (const Shader::CompileProfiler& stage_profiler : stage_profilers) {
+            profiler.Merge(stage_profiler);
+        }
+        shader_notify.RecordPhases(hash, profiler.Phases());
+    }
     Common::ThreadWorker* const thread_worker{build_in_parallel ? &workers : nullptr};
     return std::make_unique<GraphicsPipeline>(
         scheduler, buffer_cache, texture_cache, vulkan_pipeline_cache, &shader_notify, device,
@@ -706,13 +935,56 @@ std::unique_ptr<GraphicsPipeline> PipelineCache::CreateGraphicsPipeline(
     return nullptr;
 }
 
+const PipelineBinaryCache::Entry* PipelineCache::FindSharedBinary(
+    const GraphicsPipelineCacheKey& key, std::span<Shader::Environment* const> envs) const {
+    const PipelineBinaryCache::Entry* const entry{shared_binary_cache.Find(key)};
+    if (!entry) {
+        return nullptr;
+    }
+    for (size_t index = 0, env_index = 0; index < Maxwell::MaxShaderProgram; ++index) {
+        if (key.unique_hashes[index] == 0) {
+            continue;
+        }
+        if (!VideoCommon::MatchesQueries(*envs[env_index++], entry->queries[index])) {
+            return nullptr;
+        }
+    }
+    return entry;
+}
+
+std::unique_ptr<GraphicsPipeline> PipelineCache::CreateCachedGraphicsPipeline(
+    const GraphicsPipelineCacheKey& key, const PipelineBinaryCache::Entry& entry,
+    PipelineStatistics* statistics, bool build_in_parallel) {
+    LOG_INFO(Render_Vulkan, "0x{:016x} (cached binary)", key.Hash());
+
+    std::array<const Shader::Info*, Maxwell::MaxShaderStage> infos{};
+    std::array<vk::ShaderModule, Maxwell::MaxShaderStage> modules;
+    for (size_t stage = 0; stage < Maxwell::MaxShaderStage; ++stage) {
+        const std::vector<u32>& code{entry.codes[stage]};
+        if (code.empty()) {
+            continue;
+        }
+        infos[stage] = &entry.infos[stage];
+        modules[stage] = BuildShader(device, code);
+        if (device.HasDebuggingToolAttached()) {
+            const std::string name{fmt::format("Shader {:016x}", key.unique_hashes[stage + 1])};
+            modules[stage].SetObjectNameEXT(name.c_str());
+        }
+    }
+    Common::ThreadWorker* const thread_worker{build_in_parallel ? &workers : nullptr};
+    return std::make_unique<GraphicsPipeline>(
+        scheduler, buffer_cache, texture_cache, vulkan_pipeline_cache, &shader_notify, device,
+        descriptor_pool, guest_descriptor_queue, thread_worker, statistics, render_pass_cache, key,
+        std::move(modules), infos);
+}
+
 std::unique_ptr<GraphicsPipeline> PipelineCache::CreateGraphicsPipeline() {
     GraphicsEnvironments environments;
     GetGraphicsEnvironments(environments, graphics_key.unique_hashes);
 
     main_pools.ReleaseContents();
     auto pipeline{
-        CreateGraphicsPipeline(main_pools, graphics_key, environments.Span(), nullptr, true)};
+        CreateGraphicsPipeline(main_pools, graphics_key, environments.Span(), nullptr, true, true)};
     if (!pipeline || pipeline_cache_filename.empty()) {
         return pipeline;
     }
@@ -729,6 +1001,15 @@ std::unique_ptr<GraphicsPipeline> PipelineCache::CreateGraphicsPipeline() {
     return pipeline;
 }
 
+std::unique_ptr<GraphicsPipeline> PipelineCache::CreateGenericGraphicsPipeline() {
+    GraphicsEnvironments environments;
+    GetGraphicsEnvironments(environments, graphics_key.unique_hashes);
+
+    main_pools.ReleaseContents();
+    return CreateGraphicsPipeline(main_pools, graphics_key, environments.Span(), nullptr, true,
+                                  false);
+}
+
 std::unique_ptr<ComputePipeline> PipelineCache::CreateComputePipeline(
     const ComputePipelineCacheKey& key, const ShaderInfo* shader) {
     const GPUVAddr program_base{kepler_compute->regs.code_loc.Address()};
@@ -751,6 +1032,7 @@ std::unique_ptr<ComputePipeline> PipelineCache::CreateComputePipeline(
 std::unique_ptr<ComputePipeline> PipelineCache::CreateComputePipeline(
     ShaderPools& pools, const ComputePipelineCacheKey& key, Shader::Environment& env,
     PipelineStatistics* statistics, bool build_in_parallel) try {
+    const Shader::ScratchArena::Scope scratch_scope{pools.arena};
     auto hash = key.Hash();
     if (device.HasBrokenCompute()) {
         LOG_ERROR(Render_Vulkan, "Skipping 0x{:016x}", hash);
@@ -759,7 +1041,14 @@ std::unique_ptr<ComputePipeline> PipelineCache::CreateComputePipeline(
 
     LOG_INFO(Render_Vulkan, "0x{:016x}", hash);
 
+    Shader::CompileProfiler profiler;
+    std::optional<Shader::CompileProfiler::Scope> profiler_scope;
+    if (shader_notify.IsProfiling()) {
+        profiler_scope.emplace(profiler);
+    }
+    std::optional<Shader::CompileProfiler::ScopedPhase> cfg_phase{std::in_place, "control_flow"};
     Shader::Maxwell::Flow::CFG cfg{env, pools.flow_block, env.StartAddress()};
+    cfg_phase.reset();
 
     // Dump it before error.
     if (Settings::values.dump_shaders) {
@@ -767,17 +1056,26 @@ std::unique_ptr<ComputePipeline> PipelineCache::CreateComputePipeline(
     }
 
     auto program{TranslateProgram(pools.inst, pools.block, env, cfg, host_info)};
+    std::optional<Shader::CompileProfiler::ScopedPhase> emit_phase{std::in_place, "emit_spirv"};
     const std::vector<u32> code{EmitSPIRV(profile, program)};
+    emit_phase.reset();
     device.SaveShader(code);
+    std::optional<Shader::CompileProfiler::ScopedPhase> module_phase{std::in_place,
+                                                                     "shader_module"};
     vk::ShaderModule spv_module{BuildShader(device, code)};
+    module_phase.reset();
     if (device.HasDebuggingToolAttached()) {
         const auto name{fmt::format("Shader {:016x}", key.unique_hash)};
         spv_module.SetObjectNameEXT(name.c_str());
     }
     Common::ThreadWorker* const thread_worker{build_in_parallel ? &workers : nullptr};
+    if (profiler_scope) {
+        shader_notify.RecordPhases(hash, profiler.Phases());
+    }
     return std::make_unique<ComputePipeline>(device, vulkan_pipeline_cache, descriptor_pool,
                                              guest_descriptor_queue, thread_worker, statistics,
-                                             &shader_notify, program.info, std::move(spv_module));
+                                             &shader_notify, hash, program.info,
+                                             std::move(spv_module));
 
 } catch (const Shader::Exception& exception) {
     LOG_ERROR(Render_Vulkan, "{}", exception.what());
@@ -19,12 +19,14 @@
 #include "shader_recompiler/host_translate_info.h"
 #include "shader_recompiler/object_pool.h"
 #include "shader_recompiler/profile.h"
+#include "shader_recompiler/scratch_arena.h"
 #include "video_core/engines/maxwell_3d.h"
 #include "video_core/host1x/gpu_device_memory_manager.h"
 #include "video_core/renderer_vulkan/fixed_pipeline_state.h"
 #include "video_core/renderer_vulkan/vk_buffer_cache.h"
 #include "video_core/renderer_vulkan/vk_compute_pipeline.h"
 #include "video_core/renderer_vulkan/vk_graphics_pipeline.h"
+#include "video_core/renderer_vulkan/vk_pipeline_binary_cache.h"
 #include "video_core/renderer_vulkan/vk_texture_cache.h"
 #include "video_core/shader_cache.h"
 
@@ -90,11 +92,13 @@ struct ShaderPools {
         flow_block.ReleaseContents();
         block.ReleaseContents();
         inst.ReleaseContents();
+        arena.Release();
     }
 
     Shader::ObjectPool<Shader::IR::Inst> inst{8192};
     Shader::ObjectPool<Shader::IR::Block> block{32};
     Shader::ObjectPool<Shader::Maxwell::Flow::Block> flow_block{32};
+    Shader::ScratchArena arena;
 };
 
 class PipelineCache : public VideoCommon::ShaderCache {
@@ -118,12 +122,33 @@ private:
 
     [[nodiscard]] GraphicsPipeline* BuiltPipeline(GraphicsPipeline* pipeline) const noexcept;
 
+    /// Returns the pipeline to draw with, replacing the given one when its constant buffer
+    /// guards don't match the bound constant buffers
+    [[nodiscard]] GraphicsPipeline* DrawPipeline(GraphicsPipeline* pipeline);
+
+    /// Returns a built pipeline with the same shaders that can draw in place of the given one
+    [[nodiscard]] GraphicsPipeline* FallbackPipeline(
+        const GraphicsPipeline& pipeline) const noexcept;
+
+    void RegisterFallbackPipeline(GraphicsPipeline* pipeline);
+
     std::unique_ptr<GraphicsPipeline> CreateGraphicsPipeline();
 
+    /// Builds the current pipeline without specializing its shaders on constant buffers
+    std::unique_ptr<GraphicsPipeline> CreateGenericGraphicsPipeline();
+
     std::unique_ptr<GraphicsPipeline> CreateGraphicsPipeline(
         ShaderPools& pools, const GraphicsPipelineCacheKey& key,
         std::span<Shader::Environment* const> envs, PipelineStatistics* statistics,
-        bool build_in_parallel);
+        bool build_in_parallel, bool specialize);
+
+    /// Returns the shared binary for the given key if it was built for equivalent environments
+    [[nodiscard]] const PipelineBinaryCache::Entry* FindSharedBinary(
+        const GraphicsPipelineCacheKey& key, std::span<Shader::Environment* const> envs) const;
+
+    std::unique_ptr<GraphicsPipeline> CreateCachedGraphicsPipeline(
+        const GraphicsPipelineCacheKey& key, const PipelineBinaryCache::Entry& entry,
+        PipelineStatistics* statistics, bool build_in_parallel);
 
     std::unique_ptr<ComputePipeline> CreateComputePipeline(const ComputePipelineCacheKey& key,
                                                            const ShaderInfo* shader);
@@ -149,6 +174,7 @@ private:
     TextureCache& texture_cache;
     VideoCore::ShaderNotify& shader_notify;
     bool use_asynchronous_shaders{};
+    bool use_fallback_pipelines{};
     bool use_vulkan_pipeline_cache{};
 
     GraphicsPipelineCacheKey graphics_key{};
@@ -156,19 +182,31 @@ private:
 
     std::unordered_map<ComputePipelineCacheKey, std::unique_ptr<ComputePipeline>> compute_cache;
     std::unordered_map<GraphicsPipelineCacheKey, std::unique_ptr<GraphicsPipeline>> graphics_cache;
+    /// Pipelines drawing in place of the ones whose constant buffer guards failed, they are
+    /// rebuilt on demand instead of being stored in the disk caches
+    std::unordered_map<GraphicsPipelineCacheKey, std::unique_ptr<GraphicsPipeline>>
+        generic_graphics_cache;
+    /// Graphics pipelines grouped by the hash of their shaders
+    std::unordered_map<u64, std::vector<GraphicsPipeline*>> fallback_pipelines;
 
     ShaderPools main_pools;
+    std::array<ShaderPools, Maxwell::MaxShaderProgram> translation_pools;
 
     Shader::Profile profile;
     Shader::HostTranslateInfo host_info;
+    Shader::HostTranslateInfo generic_host_info;
 
     std::filesystem::path pipeline_cache_filename;
 
     std::filesystem::path vulkan_pipeline_cache_filename;
     vk::PipelineCache vulkan_pipeline_cache;
 
+    PipelineBinaryCache pipeline_binary_cache;
+    PipelineBinaryCache shared_binary_cache;
+
     Common::ThreadWorker workers;
     Common::ThreadWorker serialization_thread;
+    Common::ThreadWorker translation_workers;
     DynamicFeatures dynamic_features;
 };
 
@@ -1,10 +1,13 @@
 // SPDX-FileCopyrightText: Copyright 2023 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <thread>
+
 #include "common/microprofile.h"
 #include "common/settings.h"
 #include "common/thread.h"
 #include "core/frontend/emu_window.h"
+#include "video_core/gpu.h"
 #include "video_core/renderer_vulkan/vk_present_manager.h"
 #include "video_core/renderer_vulkan/vk_scheduler.h"
 #include "video_core/renderer_vulkan/vk_swapchain.h"
@@ -97,12 +100,13 @@ bool CanBlitToSwapchain(const vk::PhysicalDevice& physical_device, VkFormat form
 PresentManager::PresentManager(const vk::Instance& instance_,
                                Core::Frontend::EmuWindow& render_window_, const Device& device_,
                                MemoryAllocator& memory_allocator_, Scheduler& scheduler_,
-                               Swapchain& swapchain_, vk::SurfaceKHR& surface_)
+                               Swapchain& swapchain_, vk::SurfaceKHR& surface_, Tegra::GPU& gpu_)
     : instance{instance_}, render_window{render_window_}, device{device_},
       memory_allocator{memory_allocator_}, scheduler{scheduler_}, swapchain{swapchain_},
-      surface{surface_}, blit_supported{CanBlitToSwapchain(device.GetPhysical(),
-                                                           swapchain.GetImageViewFormat())},
-      use_present_thread{Settings::values.async_presentation.GetValue()} {
+      surface{surface_}, gpu{gpu_}, blit_supported{CanBlitToSwapchain(
+                                         device.GetPhysical(), swapchain.GetImageViewFormat())},
+      use_present_thread{Settings::values.async_presentation.GetValue()},
+      use_frame_pacing{use_present_thread && Settings::values.frame_pacing.GetValue()} {
     SetImageCount();
 
     auto& dld = device.GetLogical();
@@ -141,6 +145,7 @@ PresentManager::~PresentManager() = default;
 
 Frame* PresentManager::GetRenderFrame() {
     MICROPROFILE_SCOPE(Vulkan_WaitPresent);
+    const auto render_begin = std::chrono::steady_clock::now();
 
     // Wait for free presentation frames
     std::unique_lock lock{free_mutex};
@@ -154,6 +159,7 @@ Frame* PresentManager::GetRenderFrame() {
     frame->present_done.Wait();
     frame->present_done.Reset();
 
+    frame->render_begin = render_begin;
     return frame;
 }
 
@@ -271,6 +277,7 @@ void PresentManager::PresentThread(std::stop_token token) {
         // Take the frame and notify anyone waiting
         Frame* frame = present_queue.front();
         present_queue.pop();
+        const bool has_backlog = !present_queue.empty();
         frame_cv.notify_one();
 
         // By exchanging the lock ownership we take the swapchain lock
@@ -278,6 +285,9 @@ void PresentManager::PresentThread(std::stop_token token) {
         // lock in WaitPresent is guaranteed to occur after here.
         std::exchange(lock, std::unique_lock{swapchain_mutex});
 
+        if (use_frame_pacing) {
+            PaceFrame(frame, has_backlog);
+        }
         CopyToSwapchain(frame);
 
         // Free the frame for reuse
@@ -287,6 +297,34 @@ void PresentManager::PresentThread(std::stop_token token) {
     }
 }
 
+void PresentManager::PaceFrame(const Frame* frame, bool has_backlog) {
+    using Clock = std::chrono::steady_clock;
+    const bool is_first_frame = last_render_begin == Clock::time_point{};
+    const auto frame_interval = frame->render_begin - last_render_begin;
+    last_render_begin = frame->render_begin;
+    if (is_first_frame) {
+        return;
+    }
+    if (average_frame_interval == Clock::duration::zero()) {
+        average_frame_interval = frame_interval;
+        return;
+    }
+    if (frame_interval > average_frame_interval * 4) {
+        // Long stalls (loading screens, shader compilation) restart the measurement
+        average_frame_interval = Clock::duration::zero();
+        return;
+    }
+    // Follow the rate frames are started at, smoothed over a few frames
+    average_frame_interval += (frame_interval - average_frame_interval) / 8;
+
+    // Late frames are presented right away to let the queue drain. Early frames are held back so
+    // consecutive presents are one average interval apart.
+    const auto target = last_present + average_frame_interval;
+    if (!has_backlog && target > Clock::now()) {
+        std::this_thread::sleep_until(target);
+    }
+}
+
 void PresentManager::RecreateSwapchain(Frame* frame) {
     swapchain.Create(*surface, frame->width, frame->height);
     SetImageCount();
@@ -483,6 +521,9 @@ void PresentManager::CopyToSwapchainImpl(Frame* frame) {
 
     // Present
     swapchain.Present(render_semaphore);
+
+    last_present = std::chrono::steady_clock::now();
+    gpu.RendererPresentNotify(last_present - frame->render_begin);
 }
 
 } // namespace Vulkan
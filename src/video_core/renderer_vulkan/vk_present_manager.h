@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <condition_variable>
 #include <mutex>
 #include <queue>
@@ -16,6 +17,10 @@ namespace Core::Frontend {
 class EmuWindow;
 } // namespace Core::Frontend
 
+namespace Tegra {
+class GPU;
+}
+
 namespace Vulkan {
 
 class Device;
@@ -31,13 +36,14 @@ struct Frame {
     vk::CommandBuffer cmdbuf;
     vk::Semaphore render_ready;
     vk::Fence present_done;
+    std::chrono::steady_clock::time_point render_begin;
 };
 
 class PresentManager {
 public:
     PresentManager(const vk::Instance& instance, Core::Frontend::EmuWindow& render_window,
                    const Device& device, MemoryAllocator& memory_allocator, Scheduler& scheduler,
-                   Swapchain& swapchain, vk::SurfaceKHR& surface);
+                   Swapchain& swapchain, vk::SurfaceKHR& surface, Tegra::GPU& gpu);
     ~PresentManager();
 
     /// Returns the last used presentation frame
@@ -56,6 +62,8 @@ public:
 private:
     void PresentThread(std::stop_token token);
 
+    void PaceFrame(const Frame* frame, bool has_backlog);
+
     void CopyToSwapchain(Frame* frame);
 
     void CopyToSwapchainImpl(Frame* frame);
@@ -72,6 +80,7 @@ private:
     Scheduler& scheduler;
     Swapchain& swapchain;
     vk::SurfaceKHR& surface;
+    Tegra::GPU& gpu;
     vk::CommandPool cmdpool;
     std::vector<Frame> frames;
     std::queue<Frame*> present_queue;
@@ -84,7 +93,11 @@ private:
     std::jthread present_thread;
     bool blit_supported;
     bool use_present_thread;
+    bool use_frame_pacing;
     std::size_t image_count{};
+    std::chrono::steady_clock::time_point last_render_begin{};
+    std::chrono::steady_clock::time_point last_present{};
+    std::chrono::steady_clock::duration average_frame_interval{};
 };
 
 } // namespace Vulkan
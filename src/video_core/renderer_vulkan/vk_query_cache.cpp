@@ -1286,6 +1286,10 @@ void QueryCacheRuntime::ResumeHostConditionalRendering() {
     impl->is_hcr_running = true;
 }
 
+bool QueryCacheRuntime::IsHostConditionalRenderingSet() const {
+    return impl->hcr_is_set;
+}
+
 void QueryCacheRuntime::HostConditionalRenderingCompareValueImpl(VideoCommon::LookupData object,
                                                                  bool is_equal) {
     {
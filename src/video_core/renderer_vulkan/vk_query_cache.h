@@ -46,6 +46,9 @@ public:
 
     void ResumeHostConditionalRendering();
 
+    /// Returns true when host conditional rendering is set up, it may be resumed at any time
+    [[nodiscard]] bool IsHostConditionalRenderingSet() const;
+
     bool HostConditionalRenderingCompareValue(VideoCommon::LookupData object_1, bool qc_dirty);
 
     bool HostConditionalRenderingCompareValues(VideoCommon::LookupData object_1,
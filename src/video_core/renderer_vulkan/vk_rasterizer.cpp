@@ -5,6 +5,7 @@
 #include <array>
 #include <memory>
 #include <mutex>
+#include <optional>
 
 #include "video_core/renderer_vulkan/renderer_vulkan.h"
 
@@ -151,6 +152,31 @@ VkRect2D GetScissorState(const Maxwell& regs, size_t index, u32 up_scale = 1, u3
     return scissor;
 }
 
+VkClearValue MakeClearColorValue(const Maxwell& regs, u32 color_attachment) {
+    const auto format =
+        VideoCore::Surface::PixelFormatFromRenderTargetFormat(regs.rt[color_attachment].format);
+    bool is_integer = IsPixelFormatInteger(format);
+    bool is_signed = IsPixelFormatSignedInteger(format);
+    size_t int_size = PixelComponentSizeBitsInteger(format);
+    VkClearValue clear_value{};
+    if (!is_integer) {
+        std::memcpy(clear_value.color.float32, regs.clear_color.data(),
+                    regs.clear_color.size() * sizeof(f32));
+    } else if (!is_signed) {
+        for (size_t i = 0; i < 4; i++) {
+            clear_value.color.uint32[i] = static_cast<u32>(
+                static_cast<f32>(static_cast<u64>(int_size) << 1U) * regs.clear_color[i]);
+        }
+    } else {
+        for (size_t i = 0; i < 4; i++) {
+            clear_value.color.int32[i] =
+                static_cast<s32>(static_cast<f32>(static_cast<s64>(int_size - 1) << 1) *
+                                 (regs.clear_color[i] - 0.5f));
+        }
+    }
+    return clear_value;
+}
+
 DrawParams MakeDrawParams(const MaxwellDrawState& draw_state, u32 num_instances, bool is_indexed) {
     DrawParams params{
         .base_instance = draw_state.base_instance,
@@ -181,6 +207,16 @@ RasterizerVulkan::RasterizerVulkan(Core::Frontend::EmuWindow& emu_window_, Tegra
                                    StateTracker& state_tracker_, Scheduler& scheduler_)
     : gpu{gpu_}, device_memory{device_memory_}, device{device_},
       memory_allocator{memory_allocator_}, state_tracker{state_tracker_}, scheduler{scheduler_},
+      memory_budget(device.GetDeviceLocalMemory(),
+                    [this]() -> std::optional<VideoCommon::MemoryBudget::HeapStatus> {
+                        if (!device.CanReportMemoryUsage()) {
+                            return std::nullopt;
+                        }
+                        return VideoCommon::MemoryBudget::HeapStatus{
+                            .budget = device.GetDeviceMemoryBudget(),
+                            .usage = device.GetDeviceMemoryUsage(),
+                        };
+                    }),
       staging_pool(device, memory_allocator, scheduler), descriptor_pool(device, scheduler),
       guest_descriptor_queue(device, scheduler), compute_pass_descriptor_queue(device, scheduler),
       blit_image(device, scheduler, state_tracker, descriptor_pool), render_pass_cache(device),
@@ -200,6 +236,9 @@ RasterizerVulkan::RasterizerVulkan(Core::Frontend::EmuWindow& emu_window_, Tegra
       fence_manager(*this, gpu, texture_cache, buffer_cache, query_cache, device, scheduler),
       wfi_event(device.GetLogical().CreateEvent()) {
     scheduler.SetQueryCache(query_cache);
+    staging_pool.SetMemoryBudget(&memory_budget);
+    texture_cache.SetMemoryBudget(&memory_budget);
+    buffer_cache.SetMemoryBudget(&memory_budget);
 }
 
 RasterizerVulkan::~RasterizerVulkan() = default;
@@ -372,7 +411,6 @@ void RasterizerVulkan::Clear(u32 layer_count) {
     texture_cache.UpdateRenderTargets(true);
     const Framebuffer* const framebuffer = texture_cache.GetFramebuffer();
     const VkExtent2D render_area = framebuffer->RenderArea();
-    scheduler.RequestRenderpass(framebuffer);
 
     u32 up_scale = 1;
     u32 down_shift = 0;
@@ -395,6 +433,7 @@ void RasterizerVulkan::Clear(u32 layer_count) {
         .layerCount = layer_count,
     };
     if (clear_rect.rect.extent.width == 0 || clear_rect.rect.extent.height == 0) {
+        scheduler.RequestRenderpass(framebuffer);
         return;
     }
     clear_rect.rect.extent = VkExtent2D{
@@ -403,36 +442,66 @@ void RasterizerVulkan::Clear(u32 layer_count) {
     };
 
     const u32 color_attachment = regs.clear_surface.RT;
-    if (use_color && framebuffer->HasAspectColorBit(color_attachment)) {
-        const auto format =
-            VideoCore::Surface::PixelFormatFromRenderTargetFormat(regs.rt[color_attachment].format);
-        bool is_integer = IsPixelFormatInteger(format);
-        bool is_signed = IsPixelFormatSignedInteger(format);
-        size_t int_size = PixelComponentSizeBitsInteger(format);
-        VkClearValue clear_value{};
-        if (!is_integer) {
-            std::memcpy(clear_value.color.float32, regs.clear_color.data(),
-                        regs.clear_color.size() * sizeof(f32));
-        } else if (!is_signed) {
-            for (size_t i = 0; i < 4; i++) {
-                clear_value.color.uint32[i] = static_cast<u32>(
-                    static_cast<f32>(static_cast<u64>(int_size) << 1U) * regs.clear_color[i]);
-            }
-        } else {
-            for (size_t i = 0; i < 4; i++) {
-                clear_value.color.int32[i] =
-                    static_cast<s32>(static_cast<f32>(static_cast<s64>(int_size - 1) << 1) *
-                                     (regs.clear_color[i] - 0.5f));
-            }
+    const bool clear_color = use_color && framebuffer->HasAspectColorBit(color_attachment);
+    const bool clear_all_channels = regs.clear_surface.R && regs.clear_surface.G &&
+                                    regs.clear_surface.B && regs.clear_surface.A;
+    VkImageAspectFlags aspect_flags = 0;
+    if (use_depth && framebuffer->HasAspectDepthBit()) {
+        aspect_flags |= VK_IMAGE_ASPECT_DEPTH_BIT;
+    }
+    if (use_stencil && framebuffer->HasAspectStencilBit()) {
+        aspect_flags |= VK_IMAGE_ASPECT_STENCIL_BIT;
+    }
+    const bool use_stencil_blit = use_stencil && framebuffer->HasAspectStencilBit() &&
+                                  regs.stencil_front_mask != 0xFF && regs.stencil_front_mask != 0;
+
+    // Clears of the whole framebuffer starting a renderpass are done with its load ops, so tilers
+    // don't load the previous contents from memory. Load ops ignore conditional rendering.
+    const bool is_full_clear =
+        clear_rect.rect.offset.x == 0 && clear_rect.rect.offset.y == 0 &&
+        clear_rect.rect.extent.width == render_area.width &&
+        clear_rect.rect.extent.height == render_area.height && clear_rect.baseArrayLayer == 0 &&
+        clear_rect.layerCount >= framebuffer->NumLayers() &&
+        !query_cache_runtime.IsHostConditionalRenderingSet();
+    RenderPassKey clear_key = framebuffer->RenderPassFormats();
+    std::array<VkClearValue, 9> clear_values{};
+    VkClearValue color_clear_value{};
+    if (clear_color) {
+        color_clear_value = MakeClearColorValue(regs, color_attachment);
+        if (is_full_clear && clear_all_channels) {
+            clear_key.clear_mask |= 1U << color_attachment;
+            clear_values[framebuffer->ColorAttachmentIndex(color_attachment)] = color_clear_value;
+        }
+    }
+    if (is_full_clear && aspect_flags != 0 && !use_stencil_blit) {
+        if ((aspect_flags & VK_IMAGE_ASPECT_DEPTH_BIT) != 0) {
+            clear_key.clear_mask |= RenderPassKey::CLEAR_DEPTH;
+        }
+        if ((aspect_flags & VK_IMAGE_ASPECT_STENCIL_BIT) != 0) {
+            clear_key.clear_mask |= RenderPassKey::CLEAR_STENCIL;
         }
+        clear_values[framebuffer->NumColorBuffers()].depthStencil = {
+            .depth = regs.clear_depth,
+            .stencil = regs.clear_stencil,
+        };
+    }
+    u32 load_clear_mask = 0;
+    if (clear_key.clear_mask != 0 &&
+        scheduler.RequestClearRenderpass(framebuffer, render_pass_cache.Get(clear_key),
+                                         std::span(clear_values).first(framebuffer->NumImages()))) {
+        load_clear_mask = clear_key.clear_mask;
+    } else {
+        scheduler.RequestRenderpass(framebuffer);
+    }
 
-        if (regs.clear_surface.R && regs.clear_surface.G && regs.clear_surface.B &&
-            regs.clear_surface.A) {
-            scheduler.Record([color_attachment, clear_value, clear_rect](vk::CommandBuffer cmdbuf) {
+    if (clear_color && (load_clear_mask & (1U << color_attachment)) == 0) {
+        if (clear_all_channels) {
+            scheduler.Record([color_attachment, color_clear_value,
+                              clear_rect](vk::CommandBuffer cmdbuf) {
                 const VkClearAttachment attachment{
                     .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
                     .colorAttachment = color_attachment,
-                    .clearValue = clear_value,
+                    .clearValue = color_clear_value,
                 };
                 cmdbuf.ClearAttachments(attachment, clear_rect);
             });
@@ -449,22 +518,17 @@ void RasterizerVulkan::Clear(u32 layer_count) {
         }
     }
 
-    if (!use_depth && !use_stencil) {
-        return;
-    }
-    VkImageAspectFlags aspect_flags = 0;
-    if (use_depth && framebuffer->HasAspectDepthBit()) {
-        aspect_flags |= VK_IMAGE_ASPECT_DEPTH_BIT;
+    if ((load_clear_mask & RenderPassKey::CLEAR_DEPTH) != 0) {
+        aspect_flags &= ~VK_IMAGE_ASPECT_DEPTH_BIT;
     }
-    if (use_stencil && framebuffer->HasAspectStencilBit()) {
-        aspect_flags |= VK_IMAGE_ASPECT_STENCIL_BIT;
+    if ((load_clear_mask & RenderPassKey::CLEAR_STENCIL) != 0) {
+        aspect_flags &= ~VK_IMAGE_ASPECT_STENCIL_BIT;
     }
     if (aspect_flags == 0) {
         return;
     }
 
-    if (use_stencil && framebuffer->HasAspectStencilBit() && regs.stencil_front_mask != 0xFF &&
-        regs.stencil_front_mask != 0) {
+    if (use_stencil_blit) {
         Region2D dst_region = {
             Offset2D{.x = clear_rect.rect.offset.x, .y = clear_rect.rect.offset.y},
             Offset2D{.x = clear_rect.rect.offset.x + static_cast<s32>(clear_rect.rect.extent.width),
@@ -506,15 +570,21 @@ void RasterizerVulkan::DispatchCompute() {
         const auto [buffer, offset] =
             buffer_cache.ObtainBuffer(*indirect_address, 12, sync_info, post_op);
         scheduler.RequestOutsideRenderPassOperationContext();
+        const u32 scope =
+            scheduler.BeginGpuScope(GpuProfiler::ScopeType::ComputePipeline, pipeline->Hash());
         scheduler.Record([indirect_buffer = buffer->Handle(),
                           indirect_offset = offset](vk::CommandBuffer cmdbuf) {
             cmdbuf.DispatchIndirect(indirect_buffer, indirect_offset);
         });
+        scheduler.EndGpuScope(scope);
         return;
     }
     const std::array<u32, 3> dim{qmd.grid_dim_x, qmd.grid_dim_y, qmd.grid_dim_z};
     scheduler.RequestOutsideRenderPassOperationContext();
+    const u32 scope =
+        scheduler.BeginGpuScope(GpuProfiler::ScopeType::ComputePipeline, pipeline->Hash());
     scheduler.Record([dim](vk::CommandBuffer cmdbuf) { cmdbuf.Dispatch(dim[0], dim[1], dim[2]); });
+    scheduler.EndGpuScope(scope);
 }
 
 void RasterizerVulkan::ResetCounter(VideoCommon::QueryType type) {
@@ -576,17 +646,20 @@ bool RasterizerVulkan::MustFlushRegion(DAddr addr, u64 size, VideoCommon::CacheT
 }
 
 VideoCore::RasterizerDownloadArea RasterizerVulkan::GetFlushArea(DAddr addr, u64 size) {
+    // Query results left in GPU memory have to be flushed before the CPU reads them
+    const bool has_query_writes = query_cache.HasDeferredGuestWrites(addr, size);
     {
         std::scoped_lock lock{texture_cache.mutex};
         auto area = texture_cache.GetFlushArea(addr, size);
         if (area) {
+            area->preemtive &= !has_query_writes;
             return *area;
         }
     }
     VideoCore::RasterizerDownloadArea new_area{
         .start_address = Common::AlignDown(addr, Core::DEVICE_PAGESIZE),
         .end_address = Common::AlignUp(addr + size, Core::DEVICE_PAGESIZE),
-        .preemtive = true,
+        .preemtive = !has_query_writes,
     };
     return new_area;
 }
@@ -735,11 +808,16 @@ void RasterizerVulkan::WaitForIdle() {
 
     query_cache.NotifyWFI();
 
-    scheduler.RequestOutsideRenderPassOperationContext();
-    scheduler.Record([event = *wfi_event, flags](vk::CommandBuffer cmdbuf) {
-        cmdbuf.SetEvent(event, flags);
-        cmdbuf.WaitEvents(event, flags, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, {}, {}, {});
-    });
+    // Back to back waits are common between compute dispatches, a wait with nothing recorded
+    // since the previous one would have nothing left to wait for
+    if (scheduler.NumRecordedCommands() != wfi_recorded_commands) {
+        scheduler.RequestOutsideRenderPassOperationContext();
+        scheduler.Record([event = *wfi_event, flags](vk::CommandBuffer cmdbuf) {
+            cmdbuf.SetEvent(event, flags);
+            cmdbuf.WaitEvents(event, flags, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, {}, {}, {});
+        });
+        wfi_recorded_commands = scheduler.NumRecordedCommands();
+    }
     fence_manager.SignalOrdering();
 }
 
@@ -762,9 +840,13 @@ void RasterizerVulkan::FlushCommands() {
 
 void RasterizerVulkan::TickFrame() {
     draw_counter = 0;
+    if (const size_t redundant_states = state_tracker.ResetRedundantDynamicStates()) {
+        LOG_TRACE(Render_Vulkan, "Skipped {} redundant dynamic state updates", redundant_states);
+    }
     guest_descriptor_queue.TickFrame();
     compute_pass_descriptor_queue.TickFrame();
     fence_manager.TickFrame();
+    memory_budget.Tick();
     staging_pool.TickFrame();
     {
         std::scoped_lock lock{texture_cache.mutex};
@@ -814,6 +896,17 @@ void RasterizerVulkan::AccelerateInlineToMemory(GPUVAddr address, size_t copy_si
     query_cache.InvalidateRegion(*cpu_addr, copy_size);
 }
 
+bool RasterizerVulkan::CanAccelerateVideoFrame(const VideoCore::VideoFrameSurface& surface) {
+    std::scoped_lock lock{texture_cache.mutex};
+    return texture_cache.IsVideoFrameCached(surface);
+}
+
+bool RasterizerVulkan::AccelerateVideoFrame(const VideoCore::VideoFrameSurface& surface,
+                                            std::span<const u8> pixels) {
+    std::scoped_lock lock{texture_cache.mutex};
+    return texture_cache.WriteVideoFrame(surface, pixels);
+}
+
 std::optional<FramebufferTextureInfo> RasterizerVulkan::AccelerateDisplay(
     const Tegra::FramebufferConfig& config, DAddr framebuffer_addr, u32 pixel_stride) {
     if (!framebuffer_addr) {
@@ -886,11 +979,14 @@ bool AccelerateDMA::DmaBufferImageCopy(const Tegra::DMA::ImageCopy& copy_info,
                                        const Tegra::DMA::BufferOperand& buffer_operand,
                                        const Tegra::DMA::ImageOperand& image_operand) {
     std::scoped_lock lock{buffer_cache.mutex, texture_cache.mutex};
-    const auto image_id = texture_cache.DmaImageId(image_operand, IS_IMAGE_UPLOAD);
+    const u32 buffer_size = static_cast<u32>(buffer_operand.pitch * buffer_operand.height);
+    const bool is_buffer_resident =
+        buffer_cache.DMAIsRegionRegistered(buffer_operand.address, buffer_size);
+    const auto image_id =
+        texture_cache.DmaImageId(image_operand, IS_IMAGE_UPLOAD, is_buffer_resident);
     if (image_id == VideoCommon::NULL_IMAGE_ID) {
         return false;
     }
-    const u32 buffer_size = static_cast<u32>(buffer_operand.pitch * buffer_operand.height);
     static constexpr auto sync_info = VideoCommon::ObtainBufferSynchronize::FullSynchronize;
     const auto post_op = IS_IMAGE_UPLOAD ? VideoCommon::ObtainBufferOperation::DoNothing
                                          : VideoCommon::ObtainBufferOperation::MarkAsWritten;
@@ -959,6 +1055,10 @@ void RasterizerVulkan::UpdateDynamicStates() {
         if (device.IsExtExtendedDynamicState2ExtrasSupported()) {
             UpdateLogicOp(regs);
         }
+        if (device.IsExtExtendedDynamicState3RasterizationSupported()) {
+            UpdatePolygonMode(regs);
+            UpdateAlphaToCoverageEnable(regs);
+        }
         if (device.IsExtExtendedDynamicState3Supported()) {
             UpdateBlending(regs);
         }
@@ -1090,6 +1190,10 @@ void RasterizerVulkan::UpdateDepthBias(Tegra::Engines::Maxwell3D::Regs& regs) {
             static_cast<double>(1ULL << (32 - 24)) / (static_cast<double>(0x1.ep+127));
         units = static_cast<float>(static_cast<double>(units) * rescale_factor);
     }
+    const std::array depth_bias{units, regs.depth_bias_clamp, regs.slope_scale_depth_bias};
+    if (!state_tracker.ChangeDynamicState(DynamicState::DepthBias, depth_bias)) {
+        return;
+    }
     scheduler.Record([constant = units, clamp = regs.depth_bias_clamp,
                       factor = regs.slope_scale_depth_bias](vk::CommandBuffer cmdbuf) {
         cmdbuf.SetDepthBias(constant, clamp, factor);
@@ -1102,6 +1206,9 @@ void RasterizerVulkan::UpdateBlendConstants(Tegra::Engines::Maxwell3D::Regs& reg
     }
     const std::array blend_color = {regs.blend_color.r, regs.blend_color.g, regs.blend_color.b,
                                     regs.blend_color.a};
+    if (!state_tracker.ChangeDynamicState(DynamicState::BlendConstants, blend_color)) {
+        return;
+    }
     scheduler.Record(
         [blend_color](vk::CommandBuffer cmdbuf) { cmdbuf.SetBlendConstants(blend_color.data()); });
 }
@@ -1110,6 +1217,9 @@ void RasterizerVulkan::UpdateDepthBounds(Tegra::Engines::Maxwell3D::Regs& regs)
     if (!state_tracker.TouchDepthBounds()) {
         return;
     }
+    if (!state_tracker.ChangeDynamicState(DynamicState::DepthBounds, regs.depth_bounds)) {
+        return;
+    }
     scheduler.Record([min = regs.depth_bounds[0], max = regs.depth_bounds[1]](
                          vk::CommandBuffer cmdbuf) { cmdbuf.SetDepthBounds(min, max); });
 }
@@ -1212,6 +1322,9 @@ void RasterizerVulkan::UpdateLineWidth(Tegra::Engines::Maxwell3D::Regs& regs) {
     }
     const float width =
         regs.line_anti_alias_enable ? regs.line_width_smooth : regs.line_width_aliased;
+    if (!state_tracker.ChangeDynamicState(DynamicState::LineWidth, width)) {
+        return;
+    }
     scheduler.Record([width](vk::CommandBuffer cmdbuf) { cmdbuf.SetLineWidth(width); });
 }
 
@@ -1219,10 +1332,12 @@ void RasterizerVulkan::UpdateCullMode(Tegra::Engines::Maxwell3D::Regs& regs) {
     if (!state_tracker.TouchCullMode()) {
         return;
     }
-    scheduler.Record([enabled = regs.gl_cull_test_enabled,
-                      cull_face = regs.gl_cull_face](vk::CommandBuffer cmdbuf) {
-        cmdbuf.SetCullModeEXT(enabled ? MaxwellToVK::CullFace(cull_face) : VK_CULL_MODE_NONE);
-    });
+    const VkCullModeFlags cull_mode =
+        regs.gl_cull_test_enabled ? MaxwellToVK::CullFace(regs.gl_cull_face) : VK_CULL_MODE_NONE;
+    if (!state_tracker.ChangeDynamicState(DynamicState::CullMode, cull_mode)) {
+        return;
+    }
+    scheduler.Record([cull_mode](vk::CommandBuffer cmdbuf) { cmdbuf.SetCullModeEXT(cull_mode); });
 }
 
 void RasterizerVulkan::UpdateDepthBoundsTestEnable(Tegra::Engines::Maxwell3D::Regs& regs) {
@@ -1234,6 +1349,9 @@ void RasterizerVulkan::UpdateDepthBoundsTestEnable(Tegra::Engines::Maxwell3D::Re
         LOG_WARNING(Render_Vulkan, "Depth bounds is enabled but not supported");
         enabled = false;
     }
+    if (!state_tracker.ChangeDynamicState(DynamicState::DepthBoundsTestEnable, enabled)) {
+        return;
+    }
     scheduler.Record([enable = enabled](vk::CommandBuffer cmdbuf) {
         cmdbuf.SetDepthBoundsTestEnableEXT(enable);
     });
@@ -1243,6 +1361,9 @@ void RasterizerVulkan::UpdateDepthTestEnable(Tegra::Engines::Maxwell3D::Regs& re
     if (!state_tracker.TouchDepthTestEnable()) {
         return;
     }
+    if (!state_tracker.ChangeDynamicState(DynamicState::DepthTestEnable, regs.depth_test_enable)) {
+        return;
+    }
     scheduler.Record([enable = regs.depth_test_enable](vk::CommandBuffer cmdbuf) {
         cmdbuf.SetDepthTestEnableEXT(enable);
     });
@@ -1252,6 +1373,10 @@ void RasterizerVulkan::UpdateDepthWriteEnable(Tegra::Engines::Maxwell3D::Regs& r
     if (!state_tracker.TouchDepthWriteEnable()) {
         return;
     }
+    if (!state_tracker.ChangeDynamicState(DynamicState::DepthWriteEnable,
+                                          regs.depth_write_enabled)) {
+        return;
+    }
     scheduler.Record([enable = regs.depth_write_enabled](vk::CommandBuffer cmdbuf) {
         cmdbuf.SetDepthWriteEnableEXT(enable);
     });
@@ -1261,6 +1386,10 @@ void RasterizerVulkan::UpdatePrimitiveRestartEnable(Tegra::Engines::Maxwell3D::R
     if (!state_tracker.TouchPrimitiveRestartEnable()) {
         return;
     }
+    if (!state_tracker.ChangeDynamicState(DynamicState::PrimitiveRestartEnable,
+                                          regs.primitive_restart.enabled)) {
+        return;
+    }
     scheduler.Record([enable = regs.primitive_restart.enabled](vk::CommandBuffer cmdbuf) {
         cmdbuf.SetPrimitiveRestartEnableEXT(enable);
     });
@@ -1270,6 +1399,10 @@ void RasterizerVulkan::UpdateRasterizerDiscardEnable(Tegra::Engines::Maxwell3D::
     if (!state_tracker.TouchRasterizerDiscardEnable()) {
         return;
     }
+    if (!state_tracker.ChangeDynamicState(DynamicState::RasterizerDiscardEnable,
+                                          regs.rasterize_enable)) {
+        return;
+    }
     scheduler.Record([disable = regs.rasterize_enable](vk::CommandBuffer cmdbuf) {
         cmdbuf.SetRasterizerDiscardEnableEXT(disable == 0);
     });
@@ -1306,6 +1439,9 @@ void RasterizerVulkan::UpdateDepthBiasEnable(Tegra::Engines::Maxwell3D::Regs& re
     };
     const u32 topology_index = static_cast<u32>(maxwell3d->draw_manager->GetDrawState().topology);
     const u32 enable = enabled_lut[POLYGON_OFFSET_ENABLE_LUT[topology_index]];
+    if (!state_tracker.ChangeDynamicState(DynamicState::DepthBiasEnable, enable)) {
+        return;
+    }
     scheduler.Record(
         [enable](vk::CommandBuffer cmdbuf) { cmdbuf.SetDepthBiasEnableEXT(enable != 0); });
 }
@@ -1314,6 +1450,9 @@ void RasterizerVulkan::UpdateLogicOpEnable(Tegra::Engines::Maxwell3D::Regs& regs
     if (!state_tracker.TouchLogicOpEnable()) {
         return;
     }
+    if (!state_tracker.ChangeDynamicState(DynamicState::LogicOpEnable, regs.logic_op.enable)) {
+        return;
+    }
     scheduler.Record([enable = regs.logic_op.enable](vk::CommandBuffer cmdbuf) {
         cmdbuf.SetLogicOpEnableEXT(enable != 0);
     });
@@ -1329,14 +1468,45 @@ void RasterizerVulkan::UpdateDepthClampEnable(Tegra::Engines::Maxwell3D::Regs& r
                             Maxwell::ViewportClipControl::GeometryClip::FrustumXYZ ||
                         regs.viewport_clip_control.geometry_clip ==
                             Maxwell::ViewportClipControl::GeometryClip::FrustumZ);
+    if (!state_tracker.ChangeDynamicState(DynamicState::DepthClampEnable, is_enabled)) {
+        return;
+    }
     scheduler.Record(
         [is_enabled](vk::CommandBuffer cmdbuf) { cmdbuf.SetDepthClampEnableEXT(is_enabled); });
 }
 
+void RasterizerVulkan::UpdatePolygonMode(Tegra::Engines::Maxwell3D::Regs& regs) {
+    if (!state_tracker.TouchPolygonMode()) {
+        return;
+    }
+    const VkPolygonMode polygon_mode = MaxwellToVK::PolygonMode(regs.polygon_mode_front);
+    if (!state_tracker.ChangeDynamicState(DynamicState::PolygonMode, polygon_mode)) {
+        return;
+    }
+    scheduler.Record(
+        [polygon_mode](vk::CommandBuffer cmdbuf) { cmdbuf.SetPolygonModeEXT(polygon_mode); });
+}
+
+void RasterizerVulkan::UpdateAlphaToCoverageEnable(Tegra::Engines::Maxwell3D::Regs& regs) {
+    if (!state_tracker.TouchAlphaToCoverageEnable()) {
+        return;
+    }
+    const bool is_enabled = regs.anti_alias_alpha_control.alpha_to_coverage != 0;
+    if (!state_tracker.ChangeDynamicState(DynamicState::AlphaToCoverageEnable, is_enabled)) {
+        return;
+    }
+    scheduler.Record([is_enabled](vk::CommandBuffer cmdbuf) {
+        cmdbuf.SetAlphaToCoverageEnableEXT(is_enabled);
+    });
+}
+
 void RasterizerVulkan::UpdateDepthCompareOp(Tegra::Engines::Maxwell3D::Regs& regs) {
     if (!state_tracker.TouchDepthCompareOp()) {
         return;
     }
+    if (!state_tracker.ChangeDynamicState(DynamicState::DepthCompareOp, regs.depth_test_func)) {
+        return;
+    }
     scheduler.Record([func = regs.depth_test_func](vk::CommandBuffer cmdbuf) {
         cmdbuf.SetDepthCompareOpEXT(MaxwellToVK::ComparisonOp(func));
     });
@@ -1352,6 +1522,9 @@ void RasterizerVulkan::UpdateFrontFace(Tegra::Engines::Maxwell3D::Regs& regs) {
         front_face = front_face == VK_FRONT_FACE_CLOCKWISE ? VK_FRONT_FACE_COUNTER_CLOCKWISE
                                                            : VK_FRONT_FACE_CLOCKWISE;
     }
+    if (!state_tracker.ChangeDynamicState(DynamicState::FrontFace, front_face)) {
+        return;
+    }
     scheduler.Record(
         [front_face](vk::CommandBuffer cmdbuf) { cmdbuf.SetFrontFaceEXT(front_face); });
 }
@@ -1397,6 +1570,9 @@ void RasterizerVulkan::UpdateLogicOp(Tegra::Engines::Maxwell3D::Regs& regs) {
     const auto op_value = static_cast<u32>(regs.logic_op.op);
     auto op = op_value >= 0x1500 && op_value < 0x1510 ? static_cast<VkLogicOp>(op_value - 0x1500)
                                                       : VK_LOGIC_OP_NO_OP;
+    if (!state_tracker.ChangeDynamicState(DynamicState::LogicOp, op)) {
+        return;
+    }
     scheduler.Record([op](vk::CommandBuffer cmdbuf) { cmdbuf.SetLogicOpEXT(op); });
 }
 
@@ -1423,9 +1599,11 @@ void RasterizerVulkan::UpdateBlending(Tegra::Engines::Maxwell3D::Regs& regs) {
                 current |= VK_COLOR_COMPONENT_A_BIT;
             }
         }
-        scheduler.Record([setup_masks](vk::CommandBuffer cmdbuf) {
-            cmdbuf.SetColorWriteMaskEXT(0, setup_masks);
-        });
+        if (state_tracker.ChangeDynamicState(DynamicState::ColorMask, setup_masks)) {
+            scheduler.Record([setup_masks](vk::CommandBuffer cmdbuf) {
+                cmdbuf.SetColorWriteMaskEXT(0, setup_masks);
+            });
+        }
     }
 
     if (state_tracker.TouchBlendEnable()) {
@@ -1433,9 +1611,11 @@ void RasterizerVulkan::UpdateBlending(Tegra::Engines::Maxwell3D::Regs& regs) {
         std::ranges::transform(
             regs.blend.enable, setup_enables.begin(),
             [&](const auto& is_enabled) { return is_enabled != 0 ? VK_TRUE : VK_FALSE; });
-        scheduler.Record([setup_enables](vk::CommandBuffer cmdbuf) {
-            cmdbuf.SetColorBlendEnableEXT(0, setup_enables);
-        });
+        if (state_tracker.ChangeDynamicState(DynamicState::BlendEnable, setup_enables)) {
+            scheduler.Record([setup_enables](vk::CommandBuffer cmdbuf) {
+                cmdbuf.SetColorBlendEnableEXT(0, setup_enables);
+            });
+        }
     }
 
     if (state_tracker.TouchBlendEquations()) {
@@ -1466,6 +1646,9 @@ void RasterizerVulkan::UpdateStencilTestEnable(Tegra::Engines::Maxwell3D::Regs&
     if (!state_tracker.TouchStencilTestEnable()) {
         return;
     }
+    if (!state_tracker.ChangeDynamicState(DynamicState::StencilTestEnable, regs.stencil_enable)) {
+        return;
+    }
     scheduler.Record([enable = regs.stencil_enable](vk::CommandBuffer cmdbuf) {
         cmdbuf.SetStencilTestEnableEXT(enable);
     });
@@ -12,11 +12,18 @@
 namespace Vulkan {
 
 struct RenderPassKey {
+    /// Bits of clear_mask, color attachments use the bit of their render target index
+    static constexpr u32 CLEAR_DEPTH = 1U << 8;
+    static constexpr u32 CLEAR_STENCIL = 1U << 9;
+
     bool operator==(const RenderPassKey&) const noexcept = default;
 
     std::array<VideoCore::Surface::PixelFormat, 8> color_formats;
     VideoCore::Surface::PixelFormat depth_format;
     VkSampleCountFlagBits samples;
+    /// Attachments cleared by the load op instead of loaded. Render passes only differing in
+    /// this are compatible, so they can be used with the same framebuffers and pipelines.
+    u32 clear_mask{};
 };
 
 } // namespace Vulkan
@@ -27,6 +34,7 @@ struct hash<Vulkan::RenderPassKey> {
     [[nodiscard]] size_t operator()(const Vulkan::RenderPassKey& key) const noexcept {
         size_t value = static_cast<size_t>(key.depth_format) << 48;
         value ^= static_cast<size_t>(key.samples) << 52;
+        value ^= static_cast<size_t>(key.clear_mask) << 54;
         for (size_t i = 0; i < key.color_formats.size(); ++i) {
             value ^= static_cast<size_t>(key.color_formats[i]) << (i * 6);
         }
@@ -1,16 +1,23 @@
 // SPDX-FileCopyrightText: Copyright 2019 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+#include <iterator>
 #include <memory>
 #include <mutex>
 #include <thread>
+#include <type_traits>
 #include <utility>
 
 #include "video_core/renderer_vulkan/vk_query_cache.h"
 
 #include "common/microprofile.h"
+#include "common/perf_metrics.h"
+#include "common/settings.h"
 #include "common/thread.h"
+#include "common/tracing.h"
 #include "video_core/renderer_vulkan/vk_command_pool.h"
+#include "video_core/renderer_vulkan/vk_graphics_pipeline.h"
 #include "video_core/renderer_vulkan/vk_master_semaphore.h"
 #include "video_core/renderer_vulkan/vk_scheduler.h"
 #include "video_core/renderer_vulkan/vk_state_tracker.h"
@@ -21,6 +28,14 @@
 namespace Vulkan {
 
 MICROPROFILE_DECLARE(Vulkan_WaitForWorker);
+MICROPROFILE_DEFINE(Vulkan_WaitForFrame, "Vulkan", "Wait for frame in flight",
+                    MP_RGB(255, 160, 160));
+
+namespace {
+size_t GetNumRecordingWorkers() {
+    return std::clamp<size_t>(std::thread::hardware_concurrency() / 4, 1, 4);
+}
+} // Anonymous namespace
 
 void Scheduler::CommandChunk::ExecuteAll(vk::CommandBuffer cmdbuf,
                                          vk::CommandBuffer upload_cmdbuf) {
@@ -40,9 +55,29 @@ void Scheduler::CommandChunk::ExecuteAll(vk::CommandBuffer cmdbuf,
 Scheduler::Scheduler(const Device& device_, StateTracker& state_tracker_)
     : device{device_}, state_tracker{state_tracker_},
       master_semaphore{std::make_unique<MasterSemaphore>(device)},
-      command_pool{std::make_unique<CommandPool>(*master_semaphore, device)} {
+      command_pool{std::make_unique<CommandPool>(*master_semaphore, device)},
+      parallel_recording{Settings::values.use_parallel_command_recording.GetValue()} {
+    if (Settings::values.profile_gpu_timestamps.GetValue()) {
+        if (GpuProfiler::IsSupported(device)) {
+            gpu_profiler = std::make_unique<GpuProfiler>(device);
+        } else {
+            LOG_WARNING(Render_Vulkan, "Device doesn't support timestamps, GPU profiling disabled");
+        }
+    }
     AcquireNewChunk();
     AllocateWorkerCommandBuffer();
+    if (parallel_recording) {
+        if (device.IsExtNestedCommandBufferSupported()) {
+            renderpass_contents = VK_SUBPASS_CONTENTS_INLINE_AND_SECONDARY_COMMAND_BUFFERS_EXT;
+        }
+        recording_workers =
+            std::make_unique<Common::StatefulThreadWorker<std::unique_ptr<CommandPool>>>(
+                GetNumRecordingWorkers(), "VulkanRecorder", [this] {
+                    return std::make_unique<CommandPool>(*master_semaphore, device,
+                                                         VK_COMMAND_BUFFER_LEVEL_SECONDARY);
+                });
+        AcquireNewSegment();
+    }
     worker_thread = std::jthread([this](std::stop_token token) { WorkerThread(token); });
 }
 
@@ -65,19 +100,54 @@ void Scheduler::Finish(VkSemaphore signal_semaphore, VkSemaphore wait_semaphore)
 
 void Scheduler::WaitWorker() {
     MICROPROFILE_SCOPE(Vulkan_WaitForWorker);
-    DispatchWork();
+    if (parallel_recording) {
+        // This might be called in the middle of a draw, so keep recording on the primary command
+        // buffer until the next split point to preserve the bound state.
+        RequestInlineSegment();
+        QueueSegment();
+        RequestInlineSegment();
+    } else {
+        DispatchWork();
+    }
 
     // Ensure the queue is drained.
     {
         std::unique_lock ql{queue_mutex};
-        event_cv.wait(ql, [this] { return work_queue.empty(); });
+        event_cv.wait(ql, [this] { return work_queue.empty() && segment_queue.empty(); });
     }
 
     // Now wait for execution to finish.
     std::scoped_lock el{execution_mutex};
 }
 
+std::chrono::nanoseconds Scheduler::LimitFramesInFlight(u64 frame_tick) {
+    MICROPROFILE_SCOPE(Vulkan_WaitForFrame);
+    const u64 previous_frame_tick = std::exchange(last_frame_tick, frame_tick);
+    const auto wait_begin = std::chrono::steady_clock::now();
+    Wait(previous_frame_tick);
+    const auto wait_time = std::chrono::steady_clock::now() - wait_begin;
+
+    // The GPU was still busy for the waited time plus the delay applied to this frame, which is
+    // how much sooner than the GPU the CPU finishes a frame. Delay by a bit less than that so the
+    // next submission arrives just before the GPU goes idle.
+    const auto slack =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(wait_time) + frame_delay;
+    gpu_frame_slack += (slack - gpu_frame_slack) / 4;
+    frame_delay = gpu_frame_slack * 7 / 8;
+    if (gpu_profiler) {
+        gpu_profiler->EndFrame(*master_semaphore);
+    }
+    return frame_delay;
+}
+
 void Scheduler::DispatchWork() {
+    if (parallel_recording) {
+        // Only split segments once they are large enough to amortize invalidating the state.
+        if (!segment->chunks.empty()) {
+            EndSegment();
+        }
+        return;
+    }
     if (chunk->Empty()) {
         return;
     }
@@ -90,20 +160,57 @@ void Scheduler::DispatchWork() {
 }
 
 void Scheduler::RequestRenderpass(const Framebuffer* framebuffer) {
-    const VkRenderPass renderpass = framebuffer->RenderPass();
-    const VkFramebuffer framebuffer_handle = framebuffer->Handle();
-    const VkExtent2D render_area = framebuffer->RenderArea();
-    if (renderpass == state.renderpass && framebuffer_handle == state.framebuffer &&
-        render_area.width == state.render_area.width &&
-        render_area.height == state.render_area.height) {
+    if (IsRenderPassActive(framebuffer)) {
         return;
     }
+    BeginRenderPass(framebuffer, framebuffer->RenderPass(), {});
+}
+
+bool Scheduler::RequestClearRenderpass(const Framebuffer* framebuffer,
+                                       VkRenderPass clear_renderpass,
+                                       std::span<const VkClearValue> clear_values) {
+    if (IsRenderPassActive(framebuffer)) {
+        return false;
+    }
+    BeginRenderPass(framebuffer, clear_renderpass, clear_values);
+    return true;
+}
+
+bool Scheduler::IsRenderPassActive(const Framebuffer* framebuffer) const {
+    const VkExtent2D render_area = framebuffer->RenderArea();
+    return framebuffer->RenderPass() == state.renderpass &&
+           framebuffer->Handle() == state.framebuffer &&
+           render_area.width == state.render_area.width &&
+           render_area.height == state.render_area.height;
+}
+
+void Scheduler::BeginRenderPass(const Framebuffer* framebuffer, VkRenderPass renderpass,
+                                std::span<const VkClearValue> clear_values) {
+    const VkFramebuffer framebuffer_handle = framebuffer->Handle();
+    const VkExtent2D render_area = framebuffer->RenderArea();
     EndRenderPass();
-    state.renderpass = renderpass;
+    // Track the framebuffer's own renderpass, the clearing one is compatible with it and later
+    // requests on the same framebuffer must not restart the renderpass
+    state.renderpass = framebuffer->RenderPass();
     state.framebuffer = framebuffer_handle;
     state.render_area = render_area;
 
-    Record([renderpass, framebuffer_handle, render_area](vk::CommandBuffer cmdbuf) {
+    // Render passes can only be begun on primary command buffers
+    RequestInlineSegment();
+    if (gpu_profiler) {
+        const RenderPassKey& key = framebuffer->RenderPassFormats();
+        const u64 label = std::hash<RenderPassKey>{}(key);
+        gpu_profiler->NameRenderPass(label, key);
+        renderpass_scope = BeginGpuScope(GpuProfiler::ScopeType::RenderPass, label);
+
+        // Rebind the pipeline so the draws of this render pass are attributed to it
+        state.graphics_pipeline = nullptr;
+    }
+    std::array<VkClearValue, 9> clear_value_array{};
+    std::ranges::copy(clear_values, clear_value_array.begin());
+    Record([renderpass, framebuffer_handle, render_area, contents = renderpass_contents,
+            num_clear_values = static_cast<u32>(clear_values.size()),
+            clear_value_array](vk::CommandBuffer cmdbuf) {
         const VkRenderPassBeginInfo renderpass_bi{
             .sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO,
             .pNext = nullptr,
@@ -114,10 +221,10 @@ void Scheduler::RequestRenderpass(const Framebuffer* framebuffer) {
                     .offset = {.x = 0, .y = 0},
                     .extent = render_area,
                 },
-            .clearValueCount = 0,
-            .pClearValues = nullptr,
+            .clearValueCount = num_clear_values,
+            .pClearValues = num_clear_values != 0 ? clear_value_array.data() : nullptr,
         };
-        cmdbuf.BeginRenderPass(renderpass_bi, VK_SUBPASS_CONTENTS_INLINE);
+        cmdbuf.BeginRenderPass(renderpass_bi, contents);
     });
     num_renderpass_images = framebuffer->NumImages();
     renderpass_images = framebuffer->Images();
@@ -133,6 +240,11 @@ bool Scheduler::UpdateGraphicsPipeline(GraphicsPipeline* pipeline) {
         return false;
     }
     state.graphics_pipeline = pipeline;
+    if (gpu_profiler && state.renderpass) {
+        EndGpuScope(std::exchange(pipeline_scope, GpuProfiler::INVALID_SCOPE));
+        pipeline_scope =
+            BeginGpuScope(GpuProfiler::ScopeType::GraphicsPipeline, pipeline->Key().Hash());
+    }
     return true;
 }
 
@@ -147,20 +259,30 @@ bool Scheduler::UpdateRescaling(bool is_rescaling) {
 
 void Scheduler::WorkerThread(std::stop_token stop_token) {
     Common::SetCurrentThreadName("VulkanWorker");
+    Common::SetCurrentThreadRole(Common::ThreadRole::RenderWorker);
+
+    if (parallel_recording) {
+        WorkerLoop(stop_token, segment_queue);
+    } else {
+        WorkerLoop(stop_token, work_queue);
+    }
+}
 
-    const auto TryPopQueue{[this](auto& work) -> bool {
-        if (work_queue.empty()) {
+template <typename Work>
+void Scheduler::WorkerLoop(std::stop_token stop_token, std::queue<std::unique_ptr<Work>>& queue) {
+    const auto TryPopQueue{[this, &queue](auto& work) -> bool {
+        if (queue.empty()) {
             return false;
         }
 
-        work = std::move(work_queue.front());
-        work_queue.pop();
+        work = std::move(queue.front());
+        queue.pop();
         event_cv.notify_all();
         return true;
     }};
 
     while (!stop_token.stop_requested()) {
-        std::unique_ptr<CommandChunk> work;
+        std::unique_ptr<Work> work;
 
         {
             std::unique_lock lk{queue_mutex};
@@ -178,18 +300,30 @@ void Scheduler::WorkerThread(std::stop_token stop_token) {
             // to complete in the next step.
             std::exchange(lk, std::unique_lock{execution_mutex});
 
-            // Perform the work, tracking whether the chunk was a submission
-            // before executing.
-            const bool has_submit = work->HasSubmit();
-            work->ExecuteAll(current_cmdbuf, current_upload_cmdbuf);
-
-            // If the chunk was a submission, reallocate the command buffer.
-            if (has_submit) {
-                AllocateWorkerCommandBuffer();
+            TRACE_ZONE("Vulkan worker");
+            const auto work_begin = std::chrono::steady_clock::now();
+            if constexpr (std::is_same_v<Work, Segment>) {
+                // Stitch the segment into the primary command buffers, in submission order.
+                StitchSegment(*work);
+            } else {
+                // Perform the work, tracking whether the chunk was a submission
+                // before executing.
+                const bool has_submit = work->HasSubmit();
+                work->ExecuteAll(current_cmdbuf, current_upload_cmdbuf);
+
+                // If the chunk was a submission, reallocate the command buffer.
+                if (has_submit) {
+                    AllocateWorkerCommandBuffer();
+                }
             }
+            const auto work_time = std::chrono::steady_clock::now() - work_begin;
+            Common::PerfMetrics::Add(
+                Common::PerfMetrics::Counter::RenderWorkerBusyNs,
+                static_cast<u64>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(work_time).count()));
         }
 
-        {
+        if constexpr (std::is_same_v<Work, CommandChunk>) {
             std::scoped_lock rl{reserve_mutex};
 
             // Recycle the chunk back to the reserve.
@@ -198,6 +332,123 @@ void Scheduler::WorkerThread(std::stop_token stop_token) {
     }
 }
 
+void Scheduler::StitchSegment(Segment& work) {
+    if (!work.is_inline) {
+        // Wait for a recording worker to finish the secondary command buffers.
+        work.recorded.Wait();
+        current_upload_cmdbuf.ExecuteCommands(*work.upload_cmdbuf);
+        current_cmdbuf.ExecuteCommands(*work.cmdbuf);
+        return;
+    }
+    for (const std::unique_ptr<CommandChunk>& work_chunk : work.chunks) {
+        const bool has_submit = work_chunk->HasSubmit();
+        work_chunk->ExecuteAll(current_cmdbuf, current_upload_cmdbuf);
+        if (has_submit) {
+            AllocateWorkerCommandBuffer();
+        }
+    }
+    std::scoped_lock rl{reserve_mutex};
+    std::ranges::move(work.chunks, std::back_inserter(chunk_reserve));
+}
+
+void Scheduler::RecordSegment(CommandPool& pool, Segment& work) {
+    const VkCommandBufferInheritanceInfo inheritance{
+        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO,
+        .pNext = nullptr,
+        .renderPass = work.renderpass,
+        .subpass = 0,
+        .framebuffer = work.framebuffer,
+        .occlusionQueryEnable = VK_FALSE,
+        .queryFlags = 0,
+        .pipelineStatistics = 0,
+    };
+    const VkCommandBufferInheritanceInfo upload_inheritance{
+        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO,
+        .pNext = nullptr,
+        .renderPass = nullptr,
+        .subpass = 0,
+        .framebuffer = nullptr,
+        .occlusionQueryEnable = VK_FALSE,
+        .queryFlags = 0,
+        .pipelineStatistics = 0,
+    };
+    VkCommandBufferUsageFlags flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    if (work.renderpass) {
+        flags |= VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+    }
+    work.cmdbuf = vk::CommandBuffer(pool.Commit(), device.GetDispatchLoader());
+    work.cmdbuf.Begin({
+        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+        .pNext = nullptr,
+        .flags = flags,
+        .pInheritanceInfo = &inheritance,
+    });
+    work.upload_cmdbuf = vk::CommandBuffer(pool.Commit(), device.GetDispatchLoader());
+    work.upload_cmdbuf.Begin({
+        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+        .pNext = nullptr,
+        .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
+        .pInheritanceInfo = &upload_inheritance,
+    });
+    for (const std::unique_ptr<CommandChunk>& work_chunk : work.chunks) {
+        work_chunk->ExecuteAll(work.cmdbuf, work.upload_cmdbuf);
+    }
+    work.upload_cmdbuf.End();
+    work.cmdbuf.End();
+    {
+        std::scoped_lock rl{reserve_mutex};
+        std::ranges::move(work.chunks, std::back_inserter(chunk_reserve));
+    }
+    work.recorded.Set();
+}
+
+void Scheduler::SpillChunk() {
+    segment->chunks.push_back(std::move(chunk));
+    AcquireNewChunk();
+}
+
+void Scheduler::EndSegment() {
+    if (query_cache) {
+        // Queries and conditional rendering can't be carried across command buffers.
+        query_cache->NotifySegment(false);
+    }
+    QueueSegment();
+
+    // Secondary command buffers don't inherit any state, it has to be recorded again.
+    InvalidateState();
+}
+
+void Scheduler::QueueSegment() {
+    if (!chunk->Empty()) {
+        SpillChunk();
+    }
+    if (segment->chunks.empty()) {
+        return;
+    }
+    if (!segment->is_inline) {
+        recording_workers->QueueWork(
+            [this, work = segment.get()](std::unique_ptr<CommandPool>* pool) {
+                RecordSegment(**pool, *work);
+            });
+    }
+    {
+        std::scoped_lock ql{queue_mutex};
+        segment_queue.push(std::move(segment));
+    }
+    event_cv.notify_all();
+    AcquireNewSegment();
+}
+
+void Scheduler::AcquireNewSegment() {
+    segment = std::make_unique<Segment>();
+    segment->renderpass = state.renderpass;
+    segment->framebuffer = state.framebuffer;
+
+    // Secondary command buffers can only be executed inside render passes begun with
+    // VK_EXT_nested_command_buffer contents.
+    segment->is_inline = state.renderpass && !device.IsExtNestedCommandBufferSupported();
+}
+
 void Scheduler::AllocateWorkerCommandBuffer() {
     current_cmdbuf = vk::CommandBuffer(command_pool->Commit(), device.GetDispatchLoader());
     current_cmdbuf.Begin({
@@ -220,7 +471,10 @@ u64 Scheduler::SubmitExecution(VkSemaphore signal_semaphore, VkSemaphore wait_se
     InvalidateState();
 
     const u64 signal_value = master_semaphore->NextTick();
-    RecordWithUploadBuffer([signal_semaphore, wait_semaphore, signal_value,
+    const u64 timeline_wait_value = std::exchange(timeline_wait_tick, 0);
+    RequestInlineSegment();
+    RecordWithUploadBuffer([signal_semaphore, wait_semaphore, signal_value, timeline_wait_value,
+                            timeline_semaphore = timeline_wait_semaphore,
                             this](vk::CommandBuffer cmdbuf, vk::CommandBuffer upload_cmdbuf) {
         static constexpr VkMemoryBarrier WRITE_BARRIER{
             .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
@@ -239,7 +493,8 @@ u64 Scheduler::SubmitExecution(VkSemaphore signal_semaphore, VkSemaphore wait_se
 
         std::scoped_lock lock{submit_mutex};
         switch (const VkResult result = master_semaphore->SubmitQueue(
-                    cmdbuf, upload_cmdbuf, signal_semaphore, wait_semaphore, signal_value)) {
+                    cmdbuf, upload_cmdbuf, signal_semaphore, wait_semaphore, signal_value,
+                    timeline_semaphore, timeline_wait_value)) {
         case VK_SUCCESS:
             break;
         case VK_ERROR_DEVICE_LOST:
@@ -251,7 +506,11 @@ u64 Scheduler::SubmitExecution(VkSemaphore signal_semaphore, VkSemaphore wait_se
         }
     });
     chunk->MarkSubmit();
-    DispatchWork();
+    if (parallel_recording) {
+        EndSegment();
+    } else {
+        DispatchWork();
+    }
     return signal_value;
 }
 
@@ -269,6 +528,31 @@ void Scheduler::AllocateNewContext() {
     }
 }
 
+u32 Scheduler::BeginGpuScope(GpuProfiler::ScopeType type, u64 label) {
+    if (!gpu_profiler) {
+        return GpuProfiler::INVALID_SCOPE;
+    }
+    const u32 scope = gpu_profiler->BeginScope(type, label);
+    if (scope != GpuProfiler::INVALID_SCOPE) {
+        Record([query_pool = gpu_profiler->QueryPool(),
+                query = GpuProfiler::BeginQuery(scope)](vk::CommandBuffer cmdbuf) {
+            cmdbuf.WriteTimestamp(VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, query_pool, query);
+        });
+    }
+    return scope;
+}
+
+void Scheduler::EndGpuScope(u32 scope) {
+    if (scope == GpuProfiler::INVALID_SCOPE) {
+        return;
+    }
+    Record([query_pool = gpu_profiler->QueryPool(),
+            query = GpuProfiler::EndQuery(scope)](vk::CommandBuffer cmdbuf) {
+        cmdbuf.WriteTimestamp(VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, query_pool, query);
+    });
+    gpu_profiler->EndScope(scope, CurrentTick());
+}
+
 void Scheduler::InvalidateState() {
     state.graphics_pipeline = nullptr;
     state.rescaling_defined = false;
@@ -292,6 +576,8 @@ void Scheduler::EndRenderPass() {
     if (!state.renderpass) {
         return;
     }
+    EndGpuScope(std::exchange(pipeline_scope, GpuProfiler::INVALID_SCOPE));
+    RequestInlineSegment();
     Record([num_images = num_renderpass_images, images = renderpass_images,
             ranges = renderpass_image_ranges](vk::CommandBuffer cmdbuf) {
         std::array<VkImageMemoryBarrier, 9> barriers;
@@ -321,6 +607,7 @@ void Scheduler::EndRenderPass() {
                                VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, nullptr, nullptr,
                                vk::Span(barriers.data(), num_images));
     });
+    EndGpuScope(std::exchange(renderpass_scope, GpuProfiler::INVALID_SCOPE));
     state.renderpass = nullptr;
     num_renderpass_images = 0;
 }
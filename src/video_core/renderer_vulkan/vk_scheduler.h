@@ -3,17 +3,24 @@
 
 #pragma once
 
+#include <algorithm>
+#include <chrono>
 #include <condition_variable>
 #include <cstddef>
 #include <functional>
 #include <memory>
+#include <span>
 #include <thread>
 #include <utility>
 #include <queue>
+#include <vector>
 
 #include "common/alignment.h"
 #include "common/common_types.h"
 #include "common/polyfill_thread.h"
+#include "common/thread.h"
+#include "common/thread_worker.h"
+#include "video_core/renderer_vulkan/vk_gpu_profiler.h"
 #include "video_core/renderer_vulkan/vk_master_semaphore.h"
 #include "video_core/vulkan_common/vulkan_wrapper.h"
 
@@ -55,6 +62,12 @@ public:
     /// Requests to begin a renderpass.
     void RequestRenderpass(const Framebuffer* framebuffer);
 
+    /// Begins a renderpass on a framebuffer using a compatible renderpass that clears attachments
+    /// on load. Returns false without doing anything when the framebuffer is already being
+    /// rendered to, as the clears would then have to be recorded explicitly.
+    bool RequestClearRenderpass(const Framebuffer* framebuffer, VkRenderPass clear_renderpass,
+                                std::span<const VkClearValue> clear_values);
+
     /// Requests the current execution context to be able to execute operations only allowed outside
     /// of a renderpass.
     void RequestOutsideRenderPassOperationContext();
@@ -68,6 +81,12 @@ public:
     /// Invalidates current command buffer state except for render passes
     void InvalidateState();
 
+    /// Starts measuring the GPU time of the following commands when GPU profiling is enabled.
+    u32 BeginGpuScope(GpuProfiler::ScopeType type, u64 label);
+
+    /// Ends a scope returned by BeginGpuScope.
+    void EndGpuScope(u32 scope);
+
     /// Assigns the query cache.
     void SetQueryCache(VideoCommon::QueryCacheBase<QueryCacheParams>& query_cache_) {
         query_cache = &query_cache_;
@@ -78,15 +97,18 @@ public:
         on_submit = std::move(func);
     }
 
+    /// Makes the next submission wait for a tick of a timeline semaphore signaled by another
+    /// queue. Only one semaphore can be waited on.
+    void WaitTimeline(VkSemaphore semaphore, u64 tick) {
+        timeline_wait_semaphore = semaphore;
+        timeline_wait_tick = std::max(timeline_wait_tick, tick);
+    }
+
     /// Send work to a separate thread.
     template <typename T>
         requires std::is_invocable_v<T, vk::CommandBuffer, vk::CommandBuffer>
     void RecordWithUploadBuffer(T&& command) {
-        if (chunk->Record(command)) {
-            return;
-        }
-        DispatchWork();
-        (void)chunk->Record(command);
+        RecordIntoChunk(command);
     }
 
     template <typename T>
@@ -98,6 +120,29 @@ public:
             });
     }
 
+    /// Send work to a separate thread, guaranteeing it's recorded into the primary command buffer.
+    /// Required for commands that begin their own render pass.
+    template <typename T>
+        requires std::is_invocable_v<T, vk::CommandBuffer>
+    void RecordOnPrimary(T&& c) {
+        RequestInlineSegment();
+        auto command = [command = std::move(c)](vk::CommandBuffer cmdbuf, vk::CommandBuffer) {
+            command(cmdbuf);
+        };
+        RecordIntoChunk(command);
+    }
+
+    /// Returns the number of commands recorded so far, used to detect when nothing has been
+    /// recorded between two points.
+    [[nodiscard]] u64 NumRecordedCommands() const noexcept {
+        return num_recorded_commands;
+    }
+
+    /// Returns true when recorded commands may be executed concurrently by several workers.
+    [[nodiscard]] bool IsRecordingInParallel() const noexcept {
+        return parallel_recording;
+    }
+
     /// Returns the current command buffer tick.
     [[nodiscard]] u64 CurrentTick() const noexcept {
         return master_semaphore->CurrentTick();
@@ -117,6 +162,10 @@ public:
         master_semaphore->Wait(tick);
     }
 
+    /// Waits for the frame submitted before the given one, so only one frame is in flight, and
+    /// returns how long the next frame can be delayed before the GPU would run out of work.
+    std::chrono::nanoseconds LimitFramesInFlight(u64 frame_tick);
+
     /// Returns the master timeline semaphore.
     [[nodiscard]] MasterSemaphore& GetMasterSemaphore() const noexcept {
         return *master_semaphore;
@@ -206,6 +255,19 @@ private:
         alignas(std::max_align_t) std::array<u8, 0x8000> data{};
     };
 
+    /// Group of chunks recorded between two split points. When the segment is not inline, a
+    /// recording worker records it into secondary command buffers that are later executed from the
+    /// primary command buffers in submission order.
+    struct Segment {
+        std::vector<std::unique_ptr<CommandChunk>> chunks;
+        VkRenderPass renderpass = nullptr;
+        VkFramebuffer framebuffer = nullptr;
+        vk::CommandBuffer cmdbuf;
+        vk::CommandBuffer upload_cmdbuf;
+        Common::Event recorded;
+        bool is_inline = false;
+    };
+
     struct State {
         VkRenderPass renderpass = nullptr;
         VkFramebuffer framebuffer = nullptr;
@@ -215,8 +277,44 @@ private:
         bool rescaling_defined = false;
     };
 
+    template <typename T>
+    void RecordIntoChunk(T& command) {
+        ++num_recorded_commands;
+        if (chunk->Record(command)) {
+            return;
+        }
+        if (parallel_recording) {
+            SpillChunk();
+        } else {
+            DispatchWork();
+        }
+        (void)chunk->Record(command);
+    }
+
+    /// Forces the current segment to be executed directly on the primary command buffers.
+    void RequestInlineSegment() {
+        if (parallel_recording) {
+            segment->is_inline = true;
+        }
+    }
+
     void WorkerThread(std::stop_token stop_token);
 
+    template <typename Work>
+    void WorkerLoop(std::stop_token stop_token, std::queue<std::unique_ptr<Work>>& queue);
+
+    void StitchSegment(Segment& work);
+
+    void RecordSegment(CommandPool& pool, Segment& work);
+
+    void SpillChunk();
+
+    void EndSegment();
+
+    void QueueSegment();
+
+    void AcquireNewSegment();
+
     void AllocateWorkerCommandBuffer();
 
     u64 SubmitExecution(VkSemaphore signal_semaphore, VkSemaphore wait_semaphore);
@@ -225,6 +323,11 @@ private:
 
     void EndPendingOperations();
 
+    bool IsRenderPassActive(const Framebuffer* framebuffer) const;
+
+    void BeginRenderPass(const Framebuffer* framebuffer, VkRenderPass renderpass,
+                         std::span<const VkClearValue> clear_values);
+
     void EndRenderPass();
 
     void AcquireNewChunk();
@@ -234,6 +337,7 @@ private:
 
     std::unique_ptr<MasterSemaphore> master_semaphore;
     std::unique_ptr<CommandPool> command_pool;
+    std::unique_ptr<GpuProfiler> gpu_profiler;
 
     VideoCommon::QueryCacheBase<QueryCacheParams>* query_cache = nullptr;
 
@@ -243,18 +347,36 @@ private:
     std::unique_ptr<CommandChunk> chunk;
     std::function<void()> on_submit;
 
+    VkSemaphore timeline_wait_semaphore{};
+    u64 timeline_wait_tick{};
+
     State state;
 
+    u32 renderpass_scope = GpuProfiler::INVALID_SCOPE;
+    u32 pipeline_scope = GpuProfiler::INVALID_SCOPE;
+
     u32 num_renderpass_images = 0;
     std::array<VkImage, 9> renderpass_images{};
     std::array<VkImageSubresourceRange, 9> renderpass_image_ranges{};
 
+    u64 num_recorded_commands = 0;
+
+    u64 last_frame_tick = 0;
+    std::chrono::nanoseconds gpu_frame_slack{};
+    std::chrono::nanoseconds frame_delay{};
+
+    bool parallel_recording = false;
+    VkSubpassContents renderpass_contents = VK_SUBPASS_CONTENTS_INLINE;
+    std::unique_ptr<Segment> segment;
+
     std::queue<std::unique_ptr<CommandChunk>> work_queue;
+    std::queue<std::unique_ptr<Segment>> segment_queue;
     std::vector<std::unique_ptr<CommandChunk>> chunk_reserve;
     std::mutex execution_mutex;
     std::mutex reserve_mutex;
     std::mutex queue_mutex;
     std::condition_variable_any event_cv;
+    std::unique_ptr<Common::StatefulThreadWorker<std::unique_ptr<CommandPool>>> recording_workers;
     std::jthread worker_thread;
 };
 
@@ -0,0 +1,211 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <mutex>
+
+#include "common/assert.h"
+#include "common/div_ceil.h"
+#include "video_core/renderer_vulkan/vk_scheduler.h"
+#include "video_core/renderer_vulkan/vk_sparse_image.h"
+#include "video_core/vulkan_common/vulkan_device.h"
+
+namespace Vulkan {
+
+SparseImage::SparseImage(const Device& device_, MemoryAllocator& memory_allocator_,
+                         Scheduler& scheduler_, SparseResidencyStats& stats_, VkImage image_,
+                         const VkImageCreateInfo& ci)
+    : device{device_}, memory_allocator{memory_allocator_}, scheduler{scheduler_}, stats{stats_},
+      image{image_}, extent{ci.extent}, num_levels{ci.mipLevels}, num_layers{ci.arrayLayers} {
+    const vk::Device& logical = device.GetLogical();
+    requirements = logical.GetImageMemoryRequirements(image);
+
+    std::vector<VkSparseMemoryBind> metadata_binds;
+    for (const VkSparseImageMemoryRequirements& sparse :
+         logical.GetImageSparseMemoryRequirements(image)) {
+        const VkSparseImageFormatProperties& format_properties = sparse.formatProperties;
+        const bool is_single_tail =
+            (format_properties.flags & VK_SPARSE_IMAGE_FORMAT_SINGLE_MIPTAIL_BIT) != 0;
+        if ((format_properties.aspectMask & VK_IMAGE_ASPECT_METADATA_BIT) == 0) {
+            color_requirements = sparse;
+            single_mip_tail = is_single_tail;
+            continue;
+        }
+        // Metadata is opaque to the application and must always be resident
+        const u32 num_tails = is_single_tail ? 1 : num_layers;
+        for (u32 tail = 0; tail < num_tails; ++tail) {
+            metadata_binds.push_back(
+                MakeTailBind(sparse, tail, VK_SPARSE_MEMORY_BIND_METADATA_BIT));
+        }
+    }
+    first_tail_level = std::min(color_requirements.imageMipTailFirstLod, num_levels);
+    resident_levels.resize(static_cast<size_t>(num_layers) * first_tail_level);
+    resident_tails.resize(first_tail_level < num_levels ? (single_mip_tail ? 1 : num_layers) : 0);
+    stats.virtual_bytes += requirements.size;
+
+    Bind({}, metadata_binds);
+}
+
+SparseImage::~SparseImage() {
+    stats.virtual_bytes -= requirements.size;
+    stats.committed_bytes -= committed_bytes;
+}
+
+bool SparseImage::IsSupported(const Device& device, const VkImageCreateInfo& ci) {
+    if (!device.IsSparseImageResidencySupported() || ci.imageType != VK_IMAGE_TYPE_2D ||
+        ci.samples != VK_SAMPLE_COUNT_1_BIT) {
+        return false;
+    }
+    const auto properties = device.GetPhysical().GetSparseImageFormatProperties(
+        ci.format, ci.imageType, ci.samples, ci.usage, ci.tiling);
+    if (properties.empty()) {
+        return false;
+    }
+    return std::ranges::all_of(properties, [](const VkSparseImageFormatProperties& property) {
+        // Only single aspect color images with standard block shapes are handled
+        return (property.aspectMask & (VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT)) ==
+                   0 &&
+               (property.flags & VK_SPARSE_IMAGE_FORMAT_NONSTANDARD_BLOCK_SIZE_BIT) == 0;
+    });
+}
+
+void SparseImage::Commit(const VkImageSubresourceRange& range) {
+    const u32 level_end = range.levelCount == VK_REMAINING_MIP_LEVELS
+                              ? num_levels
+                              : std::min(range.baseMipLevel + range.levelCount, num_levels);
+    const u32 layer_end = range.layerCount == VK_REMAINING_ARRAY_LAYERS
+                              ? num_layers
+                              : std::min(range.baseArrayLayer + range.layerCount, num_layers);
+    const VkExtent3D& granularity = color_requirements.formatProperties.imageGranularity;
+
+    std::vector<VkSparseImageMemoryBind> image_binds;
+    std::vector<VkSparseMemoryBind> opaque_binds;
+    for (u32 layer = range.baseArrayLayer; layer < layer_end; ++layer) {
+        for (u32 level = range.baseMipLevel; level < level_end; ++level) {
+            if (level >= first_tail_level) {
+                const u32 tail = single_mip_tail ? 0 : layer;
+                if (!resident_tails[tail]) {
+                    resident_tails[tail] = true;
+                    opaque_binds.push_back(MakeTailBind(color_requirements, tail, 0));
+                }
+                continue;
+            }
+            const size_t index = static_cast<size_t>(layer) * first_tail_level + level;
+            if (resident_levels[index]) {
+                continue;
+            }
+            resident_levels[index] = true;
+
+            const VkExtent3D level_extent{
+                .width = std::max(extent.width >> level, 1U),
+                .height = std::max(extent.height >> level, 1U),
+                .depth = std::max(extent.depth >> level, 1U),
+            };
+            const u64 num_blocks = u64{Common::DivCeil(level_extent.width, granularity.width)} *
+                                   Common::DivCeil(level_extent.height, granularity.height) *
+                                   Common::DivCeil(level_extent.depth, granularity.depth);
+            const MemoryCommit& commit = Allocate(num_blocks * requirements.alignment);
+            image_binds.push_back(VkSparseImageMemoryBind{
+                .subresource{
+                    .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+                    .mipLevel = level,
+                    .arrayLayer = layer,
+                },
+                .offset{0, 0, 0},
+                .extent = level_extent,
+                .memory = commit.Memory(),
+                .memoryOffset = commit.Offset(),
+                .flags = 0,
+            });
+        }
+    }
+    Bind(image_binds, opaque_binds);
+}
+
+void SparseImage::CommitAll() {
+    Commit(VkImageSubresourceRange{
+        .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+        .baseMipLevel = 0,
+        .levelCount = VK_REMAINING_MIP_LEVELS,
+        .baseArrayLayer = 0,
+        .layerCount = VK_REMAINING_ARRAY_LAYERS,
+    });
+}
+
+const MemoryCommit& SparseImage::Allocate(VkDeviceSize size) {
+    const VkMemoryRequirements block_requirements{
+        .size = size,
+        .alignment = requirements.alignment,
+        .memoryTypeBits = requirements.memoryTypeBits,
+    };
+    committed_bytes += size;
+    stats.committed_bytes += size;
+    return commits.emplace_back(
+        memory_allocator.Commit(block_requirements, MemoryUsage::DeviceLocal));
+}
+
+VkSparseMemoryBind SparseImage::MakeTailBind(const VkSparseImageMemoryRequirements& sparse,
+                                             u32 tail_index, VkSparseMemoryBindFlags flags) {
+    const MemoryCommit& commit = Allocate(sparse.imageMipTailSize);
+    return VkSparseMemoryBind{
+        .resourceOffset = sparse.imageMipTailOffset + tail_index * sparse.imageMipTailStride,
+        .size = sparse.imageMipTailSize,
+        .memory = commit.Memory(),
+        .memoryOffset = commit.Offset(),
+        .flags = flags,
+    };
+}
+
+void SparseImage::Bind(std::span<const VkSparseImageMemoryBind> image_binds,
+                       std::span<const VkSparseMemoryBind> opaque_binds) {
+    if (image_binds.empty() && opaque_binds.empty()) {
+        return;
+    }
+    const VkSparseImageMemoryBindInfo image_bind_info{
+        .image = image,
+        .bindCount = static_cast<u32>(image_binds.size()),
+        .pBinds = image_binds.data(),
+    };
+    const VkSparseImageOpaqueMemoryBindInfo opaque_bind_info{
+        .image = image,
+        .bindCount = static_cast<u32>(opaque_binds.size()),
+        .pBinds = opaque_binds.data(),
+    };
+    const VkBindSparseInfo bind_info{
+        .sType = VK_STRUCTURE_TYPE_BIND_SPARSE_INFO,
+        .pNext = nullptr,
+        .waitSemaphoreCount = 0,
+        .pWaitSemaphores = nullptr,
+        .bufferBindCount = 0,
+        .pBufferBinds = nullptr,
+        .imageOpaqueBindCount = opaque_binds.empty() ? 0U : 1U,
+        .pImageOpaqueBinds = &opaque_bind_info,
+        .imageBindCount = image_binds.empty() ? 0U : 1U,
+        .pImageBinds = &image_bind_info,
+        .signalSemaphoreCount = 0,
+        .pSignalSemaphores = nullptr,
+    };
+    const vk::Fence fence = device.GetLogical().CreateFence({
+        .sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO,
+        .pNext = nullptr,
+        .flags = 0,
+    });
+    {
+        std::scoped_lock lock{scheduler.submit_mutex};
+        switch (const VkResult result = device.GetGraphicsQueue().BindSparse(bind_info, *fence)) {
+        case VK_SUCCESS:
+            break;
+        case VK_ERROR_DEVICE_LOST:
+            device.ReportLoss();
+            [[fallthrough]];
+        default:
+            vk::Check(result);
+            break;
+        }
+    }
+    // Sparse binding is not ordered with later submissions, wait for it before they can use it.
+    // Binds only happen the first time a subresource is written, so this is rare.
+    fence.Wait();
+}
+
+} // namespace Vulkan
@@ -0,0 +1,84 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include "common/common_types.h"
+#include "video_core/vulkan_common/vulkan_memory_allocator.h"
+#include "video_core/vulkan_common/vulkan_wrapper.h"
+
+namespace Vulkan {
+
+class Device;
+class Scheduler;
+
+/// Memory usage of all the sparse resident images
+struct SparseResidencyStats {
+    u64 virtual_bytes{};   ///< Bytes the images would use if they were fully resident.
+    u64 committed_bytes{}; ///< Bytes of memory actually bound to the images.
+};
+
+/**
+ * Backs a sparse resident image with memory on demand.
+ * Mip levels are committed one layer at a time the first time they are written to. Levels packed
+ * in the mip tail are committed together, as they can only be bound as a whole.
+ */
+class SparseImage {
+public:
+    explicit SparseImage(const Device& device, MemoryAllocator& memory_allocator,
+                         Scheduler& scheduler, SparseResidencyStats& stats, VkImage image,
+                         const VkImageCreateInfo& ci);
+    ~SparseImage();
+
+    SparseImage(const SparseImage&) = delete;
+    SparseImage& operator=(const SparseImage&) = delete;
+
+    SparseImage(SparseImage&&) = delete;
+    SparseImage& operator=(SparseImage&&) = delete;
+
+    /// Returns true when an image with the given create info can be created as sparse resident
+    [[nodiscard]] static bool IsSupported(const Device& device, const VkImageCreateInfo& ci);
+
+    /// Makes the given subresources resident, binding new memory to them when necessary
+    void Commit(const VkImageSubresourceRange& range);
+
+    /// Makes every subresource of the image resident
+    void CommitAll();
+
+private:
+    /// Allocates memory for a sparse block aligned region of the given size
+    const MemoryCommit& Allocate(VkDeviceSize size);
+
+    /// Returns a bind of new memory to an opaque mip tail region
+    VkSparseMemoryBind MakeTailBind(const VkSparseImageMemoryRequirements& sparse, u32 tail_index,
+                                    VkSparseMemoryBindFlags flags);
+
+    /// Binds the given regions and waits for the binding to complete
+    void Bind(std::span<const VkSparseImageMemoryBind> image_binds,
+              std::span<const VkSparseMemoryBind> opaque_binds);
+
+    const Device& device;
+    MemoryAllocator& memory_allocator;
+    Scheduler& scheduler;
+    SparseResidencyStats& stats;
+    VkImage image;
+
+    VkExtent3D extent{};
+    u32 num_levels{};
+    u32 num_layers{};
+    u32 first_tail_level{};
+    bool single_mip_tail{};
+
+    VkMemoryRequirements requirements{};
+    VkSparseImageMemoryRequirements color_requirements{};
+
+    std::vector<bool> resident_levels; ///< Residency of the levels before the tail, per layer.
+    std::vector<bool> resident_tails;  ///< Residency of the mip tails.
+    std::vector<MemoryCommit> commits;
+    u64 committed_bytes{};
+};
+
+} // namespace Vulkan
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include <algorithm>
+#include <array>
 #include <utility>
 #include <vector>
 
@@ -12,6 +13,8 @@
 #include "common/bit_util.h"
 #include "common/common_types.h"
 #include "common/literals.h"
+#include "common/logging/log.h"
+#include "common/perf_metrics.h"
 #include "video_core/renderer_vulkan/vk_scheduler.h"
 #include "video_core/renderer_vulkan/vk_staging_buffer_pool.h"
 #include "video_core/vulkan_common/vulkan_device.h"
@@ -26,6 +29,8 @@ using namespace Common::Literals;
 constexpr VkDeviceSize MAX_ALIGNMENT = 256;
 // Stream buffer size in bytes
 constexpr VkDeviceSize MAX_STREAM_BUFFER_SIZE = 128_MiB;
+// Download stream buffer size in bytes, readbacks are much smaller than uploads
+constexpr VkDeviceSize MAX_DOWNLOAD_STREAM_BUFFER_SIZE = 64_MiB;
 
 size_t GetStreamBufferSize(const Device& device) {
     VkDeviceSize size{0};
@@ -44,40 +49,82 @@ size_t GetStreamBufferSize(const Device& device) {
     }
     return std::min(Common::AlignUp(size, MAX_ALIGNMENT), MAX_STREAM_BUFFER_SIZE);
 }
+
+/// Shares upload buffers with the dedicated transfer queue, which copies from them too
+void ShareWithTransferQueue(const Device& device, MemoryUsage usage, VkBufferCreateInfo& ci,
+                            std::array<u32, 2>& queue_families) {
+    if (usage != MemoryUsage::Upload || !device.HasDedicatedTransferQueue()) {
+        return;
+    }
+    queue_families = {device.GetGraphicsFamily(), device.GetTransferFamily()};
+    ci.sharingMode = VK_SHARING_MODE_CONCURRENT;
+    ci.queueFamilyIndexCount = static_cast<u32>(queue_families.size());
+    ci.pQueueFamilyIndices = queue_families.data();
+}
 } // Anonymous namespace
 
 StagingBufferPool::StagingBufferPool(const Device& device_, MemoryAllocator& memory_allocator_,
                                      Scheduler& scheduler_)
-    : device{device_}, memory_allocator{memory_allocator_}, scheduler{scheduler_},
-      stream_buffer_size{GetStreamBufferSize(device)}, region_size{stream_buffer_size /
-                                                                   StagingBufferPool::NUM_SYNCS} {
-    VkBufferCreateInfo stream_ci = {
-        .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
-        .pNext = nullptr,
-        .flags = 0,
-        .size = stream_buffer_size,
-        .usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT |
-                 VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
-        .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
-        .queueFamilyIndexCount = 0,
-        .pQueueFamilyIndices = nullptr,
+    : device{device_}, memory_allocator{memory_allocator_}, scheduler{scheduler_} {
+    const auto create_stream = [this](StreamBuffer& stream, VkDeviceSize size,
+                                      VkBufferUsageFlags usage, MemoryUsage memory_usage,
+                                      const char* name) {
+        VkBufferCreateInfo stream_ci = {
+            .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+            .pNext = nullptr,
+            .flags = 0,
+            .size = size,
+            .usage = usage,
+            .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+            .queueFamilyIndexCount = 0,
+            .pQueueFamilyIndices = nullptr,
+        };
+        if (device.IsExtTransformFeedbackSupported()) {
+            stream_ci.usage |= VK_BUFFER_USAGE_TRANSFORM_FEEDBACK_BUFFER_BIT_EXT;
+        }
+        std::array<u32, 2> queue_families{};
+        ShareWithTransferQueue(device, memory_usage, stream_ci, queue_families);
+        stream.buffer = memory_allocator.CreateBuffer(stream_ci, memory_usage);
+        if (device.HasDebuggingToolAttached()) {
+            stream.buffer.SetObjectNameEXT(name);
+        }
+        stream.mapped_span = stream.buffer.Mapped();
+        stream.size = size;
+        stream.region_size = size / NUM_SYNCS;
+        ASSERT_MSG(!stream.mapped_span.empty(), "Stream buffer must be host visible!");
     };
-    if (device.IsExtTransformFeedbackSupported()) {
-        stream_ci.usage |= VK_BUFFER_USAGE_TRANSFORM_FEEDBACK_BUFFER_BIT_EXT;
-    }
-    stream_buffer = memory_allocator.CreateBuffer(stream_ci, MemoryUsage::Stream);
-    if (device.HasDebuggingToolAttached()) {
-        stream_buffer.SetObjectNameEXT("Stream Buffer");
-    }
-    stream_pointer = stream_buffer.Mapped();
-    ASSERT_MSG(!stream_pointer.empty(), "Stream buffer must be host visible!");
+    const VkDeviceSize stream_buffer_size = GetStreamBufferSize(device);
+    create_stream(upload_stream, stream_buffer_size,
+                  VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT |
+                      VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                  MemoryUsage::Stream, "Stream Buffer");
+    // Readbacks land in host cached memory, so the host reads them without uncached accesses
+    create_stream(download_stream, std::min(stream_buffer_size, MAX_DOWNLOAD_STREAM_BUFFER_SIZE),
+                  VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT |
+                      VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                  MemoryUsage::Download, "Download Stream Buffer");
 }
 
 StagingBufferPool::~StagingBufferPool() = default;
 
 StagingBufferRef StagingBufferPool::Request(size_t size, MemoryUsage usage, bool deferred) {
-    if (!deferred && usage == MemoryUsage::Upload && size <= region_size) {
-        return GetStreamBuffer(size);
+    Common::PerfMetrics::Add(Common::PerfMetrics::Counter::StagingBytes, size);
+    switch (usage) {
+    case MemoryUsage::Upload:
+        frame_upload_bytes += size;
+        if (!deferred && size <= upload_stream.region_size) {
+            return GetStreamBuffer(upload_stream, size, usage);
+        }
+        break;
+    case MemoryUsage::Download:
+        frame_download_bytes += size;
+        // Deferred readbacks outlive the stream regions, keep them in their own buffers
+        if (!deferred && size <= download_stream.region_size) {
+            return GetStreamBuffer(download_stream, size, usage);
+        }
+        break;
+    default:
+        break;
     }
     return GetStagingBuffer(size, usage, deferred);
 }
@@ -94,53 +141,90 @@ void StagingBufferPool::FreeDeferred(StagingBufferRef& ref) {
     it->deferred = false;
 }
 
+void StagingBufferPool::InvalidateDownloads() {
+    if (download_invalidate_begin >= download_invalidate_end) {
+        return;
+    }
+    download_stream.buffer.Invalidate(download_invalidate_begin,
+                                      download_invalidate_end - download_invalidate_begin);
+    download_invalidate_begin = std::numeric_limits<size_t>::max();
+    download_invalidate_end = 0;
+}
+
 void StagingBufferPool::TickFrame() {
+    LOG_TRACE(Render_Vulkan, "Staging: {} bytes uploaded, {} bytes downloaded ({} streamed)",
+              frame_upload_bytes, frame_download_bytes, frame_streamed_download_bytes);
+    frame_upload_bytes = 0;
+    frame_download_bytes = 0;
+    frame_streamed_download_bytes = 0;
+
     current_delete_level = (current_delete_level + 1) % NUM_LEVELS;
 
+    if (memory_budget) {
+        using VideoCommon::MemoryBudgetClient;
+        memory_budget->ReportUsage(MemoryBudgetClient::StagingPool, cached_bytes);
+        if (cached_bytes > memory_budget->GetShare(MemoryBudgetClient::StagingPool).critical) {
+            // Over its share, release from every level instead of a single one per frame
+            for (size_t level = 0; level < NUM_LEVELS; ++level) {
+                ReleaseLevel(device_local_cache, level);
+                ReleaseLevel(upload_cache, level);
+                ReleaseLevel(download_cache, level);
+            }
+            return;
+        }
+    }
     ReleaseCache(MemoryUsage::DeviceLocal);
     ReleaseCache(MemoryUsage::Upload);
     ReleaseCache(MemoryUsage::Download);
 }
 
-StagingBufferRef StagingBufferPool::GetStreamBuffer(size_t size) {
-    if (AreRegionsActive(Region(free_iterator) + 1,
-                         std::min(Region(iterator + size) + 1, NUM_SYNCS))) {
+StagingBufferRef StagingBufferPool::GetStreamBuffer(StreamBuffer& stream, size_t size,
+                                                    MemoryUsage usage) {
+    if (AreRegionsActive(stream, stream.Region(stream.free_iterator) + 1,
+                         std::min(stream.Region(stream.iterator + size) + 1, NUM_SYNCS))) {
         // Avoid waiting for the previous usages to be free
-        return GetStagingBuffer(size, MemoryUsage::Upload);
+        return GetStagingBuffer(size, usage);
     }
     const u64 current_tick = scheduler.CurrentTick();
-    std::fill(sync_ticks.begin() + Region(used_iterator), sync_ticks.begin() + Region(iterator),
-              current_tick);
-    used_iterator = iterator;
-    free_iterator = std::max(free_iterator, iterator + size);
+    std::fill(stream.sync_ticks.begin() + stream.Region(stream.used_iterator),
+              stream.sync_ticks.begin() + stream.Region(stream.iterator), current_tick);
+    stream.used_iterator = stream.iterator;
+    stream.free_iterator = std::max(stream.free_iterator, stream.iterator + size);
 
-    if (iterator + size >= stream_buffer_size) {
-        std::fill(sync_ticks.begin() + Region(used_iterator), sync_ticks.begin() + NUM_SYNCS,
-                  current_tick);
-        used_iterator = 0;
-        iterator = 0;
-        free_iterator = size;
+    if (stream.iterator + size >= stream.size) {
+        std::fill(stream.sync_ticks.begin() + stream.Region(stream.used_iterator),
+                  stream.sync_ticks.begin() + NUM_SYNCS, current_tick);
+        stream.used_iterator = 0;
+        stream.iterator = 0;
+        stream.free_iterator = size;
 
-        if (AreRegionsActive(0, Region(size) + 1)) {
+        if (AreRegionsActive(stream, 0, stream.Region(size) + 1)) {
             // Avoid waiting for the previous usages to be free
-            return GetStagingBuffer(size, MemoryUsage::Upload);
+            return GetStagingBuffer(size, usage);
         }
     }
-    const size_t offset = iterator;
-    iterator = Common::AlignUp(iterator + size, MAX_ALIGNMENT);
+    const size_t offset = stream.iterator;
+    stream.iterator = Common::AlignUp(stream.iterator + size, MAX_ALIGNMENT);
+    if (usage == MemoryUsage::Download) {
+        download_invalidate_begin = std::min(download_invalidate_begin, offset);
+        download_invalidate_end = std::max(download_invalidate_end, offset + size);
+        frame_streamed_download_bytes += size;
+    }
     return StagingBufferRef{
-        .buffer = *stream_buffer,
+        .buffer = *stream.buffer,
         .offset = static_cast<VkDeviceSize>(offset),
-        .mapped_span = stream_pointer.subspan(offset, size),
+        .mapped_span = stream.mapped_span.subspan(offset, size),
         .usage{},
         .log2_level{},
         .index{},
     };
 }
 
-bool StagingBufferPool::AreRegionsActive(size_t region_begin, size_t region_end) const {
+bool StagingBufferPool::AreRegionsActive(const StreamBuffer& stream, size_t region_begin,
+                                         size_t region_end) const {
     const u64 gpu_tick = scheduler.GetMasterSemaphore().KnownGpuTick();
-    return std::any_of(sync_ticks.begin() + region_begin, sync_ticks.begin() + region_end,
+    return std::any_of(stream.sync_ticks.begin() + region_begin,
+                       stream.sync_ticks.begin() + region_end,
                        [gpu_tick](u64 sync_tick) { return gpu_tick < sync_tick; });
 };
 
@@ -194,12 +278,15 @@ StagingBufferRef StagingBufferPool::CreateStagingBuffer(size_t size, MemoryUsage
     if (device.IsExtTransformFeedbackSupported()) {
         buffer_ci.usage |= VK_BUFFER_USAGE_TRANSFORM_FEEDBACK_BUFFER_BIT_EXT;
     }
+    std::array<u32, 2> queue_families{};
+    ShareWithTransferQueue(device, usage, buffer_ci, queue_families);
     vk::Buffer buffer = memory_allocator.CreateBuffer(buffer_ci, usage);
     if (device.HasDebuggingToolAttached()) {
         ++buffer_index;
         buffer.SetObjectNameEXT(fmt::format("Staging Buffer {}", buffer_index).c_str());
     }
     const std::span<u8> mapped_span = buffer.Mapped();
+    cached_bytes += size_t{1} << log2;
     StagingBuffer& entry = GetCache(usage)[log2].entries.emplace_back(StagingBuffer{
         .buffer = std::move(buffer),
         .mapped_span = mapped_span,
@@ -246,6 +333,7 @@ void StagingBufferPool::ReleaseLevel(StagingBuffersCache& cache, size_t log2) {
     entries.erase(std::remove_if(begin, end, is_deletable), end);
 
     const size_t new_size = entries.size();
+    cached_bytes -= (old_size - new_size) << log2;
     staging.delete_index += deletions_per_tick;
     if (staging.delete_index >= new_size) {
         staging.delete_index = 0;
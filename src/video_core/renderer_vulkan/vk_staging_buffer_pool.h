@@ -3,11 +3,15 @@
 
 #pragma once
 
+#include <array>
 #include <climits>
+#include <limits>
+#include <span>
 #include <vector>
 
 #include "common/common_types.h"
 
+#include "video_core/memory_budget.h"
 #include "video_core/vulkan_common/vulkan_memory_allocator.h"
 #include "video_core/vulkan_common/vulkan_wrapper.h"
 
@@ -36,18 +40,44 @@ public:
     StagingBufferRef Request(size_t size, MemoryUsage usage, bool deferred = false);
     void FreeDeferred(StagingBufferRef& ref);
 
+    /// Makes the GPU writes to the download stream buffer visible to the host, call after waiting
+    /// for the downloads requested since the last call
+    void InvalidateDownloads();
+
     [[nodiscard]] VkBuffer StreamBuf() const noexcept {
-        return *stream_buffer;
+        return *upload_stream.buffer;
     }
 
     void TickFrame();
 
+    /// Releases cached buffers faster while they take more than the pool's share of the budget
+    void SetMemoryBudget(VideoCommon::MemoryBudget* memory_budget_) noexcept {
+        memory_budget = memory_budget_;
+    }
+
 private:
     struct StreamBufferCommit {
         size_t upper_bound;
         u64 tick;
     };
 
+    /// Ring buffer split in regions, each reused once the GPU is done with its last usage
+    struct StreamBuffer {
+        vk::Buffer buffer;
+        std::span<u8> mapped_span;
+        VkDeviceSize size{};
+        VkDeviceSize region_size{};
+
+        size_t iterator = 0;
+        size_t used_iterator = 0;
+        size_t free_iterator = 0;
+        std::array<u64, NUM_SYNCS> sync_ticks{};
+
+        size_t Region(size_t iter) const noexcept {
+            return iter / region_size;
+        }
+    };
+
     struct StagingBuffer {
         vk::Buffer buffer;
         std::span<u8> mapped_span;
@@ -78,9 +108,10 @@ private:
     static constexpr size_t NUM_LEVELS = sizeof(size_t) * CHAR_BIT;
     using StagingBuffersCache = std::array<StagingBuffers, NUM_LEVELS>;
 
-    StagingBufferRef GetStreamBuffer(size_t size);
+    StagingBufferRef GetStreamBuffer(StreamBuffer& stream, size_t size, MemoryUsage usage);
 
-    bool AreRegionsActive(size_t region_begin, size_t region_end) const;
+    bool AreRegionsActive(const StreamBuffer& stream, size_t region_begin,
+                          size_t region_end) const;
 
     StagingBufferRef GetStagingBuffer(size_t size, MemoryUsage usage, bool deferred = false);
 
@@ -94,27 +125,27 @@ private:
     void ReleaseCache(MemoryUsage usage);
 
     void ReleaseLevel(StagingBuffersCache& cache, size_t log2);
-    size_t Region(size_t iter) const noexcept {
-        return iter / region_size;
-    }
 
     const Device& device;
     MemoryAllocator& memory_allocator;
     Scheduler& scheduler;
+    VideoCommon::MemoryBudget* memory_budget = nullptr;
 
-    vk::Buffer stream_buffer;
-    std::span<u8> stream_pointer;
-    VkDeviceSize stream_buffer_size;
-    VkDeviceSize region_size;
+    StreamBuffer upload_stream;
+    StreamBuffer download_stream;
+    size_t download_invalidate_begin = std::numeric_limits<size_t>::max();
+    size_t download_invalidate_end = 0;
 
-    size_t iterator = 0;
-    size_t used_iterator = 0;
-    size_t free_iterator = 0;
-    std::array<u64, NUM_SYNCS> sync_ticks{};
+    /// Staging bytes requested during the current frame
+    size_t frame_upload_bytes = 0;
+    size_t frame_download_bytes = 0;
+    size_t frame_streamed_download_bytes = 0;
 
     StagingBuffersCache device_local_cache;
     StagingBuffersCache upload_cache;
     StagingBuffersCache download_cache;
+    /// Size of the buffers kept in the caches above
+    size_t cached_bytes = 0;
 
     size_t current_delete_level = 0;
     u64 buffer_index = 0;
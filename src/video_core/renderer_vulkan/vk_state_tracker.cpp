@@ -46,6 +46,7 @@ Flags MakeInvalidationFlags() {
         StencilOp,
         StencilTestEnable,
         VertexBuffers,
+        TransformFeedbackBuffers,
         VertexInput,
         StateEnable,
         PrimitiveRestartEnable,
@@ -53,6 +54,8 @@ Flags MakeInvalidationFlags() {
         DepthBiasEnable,
         LogicOpEnable,
         DepthClampEnable,
+        PolygonMode,
+        AlphaToCoverageEnable,
         LogicOp,
         Blending,
         ColorMask,
@@ -187,6 +190,11 @@ void SetupDirtySpecialOps(Tables& tables) {
     tables[0][OFF(logic_op.op)] = LogicOp;
 }
 
+void SetupDirtyRasterization(Tables& tables) {
+    tables[0][OFF(polygon_mode_front)] = PolygonMode;
+    tables[0][OFF(anti_alias_alpha_control)] = AlphaToCoverageEnable;
+}
+
 void SetupDirtyViewportSwizzles(Tables& tables) {
     static constexpr size_t swizzle_offset = 6;
     for (size_t index = 0; index < Regs::NumViewports; ++index) {
@@ -236,6 +244,7 @@ void StateTracker::SetupTables(Tegra::Control::ChannelState& channel_state) {
     SetupDirtyVertexAttributes(tables);
     SetupDirtyVertexBindings(tables);
     SetupDirtySpecialOps(tables);
+    SetupDirtyRasterization(tables);
 }
 
 void StateTracker::ChangeChannel(Tegra::Control::ChannelState& channel_state) {
@@ -246,6 +255,7 @@ void StateTracker::InvalidateState() {
     flags->set();
     current_topology = INVALID_TOPOLOGY;
     stencil_reset = true;
+    recorded_dynamic_states = 0;
 }
 
 StateTracker::StateTracker()
@@ -3,8 +3,12 @@
 
 #pragma once
 
+#include <array>
 #include <cstddef>
+#include <cstring>
 #include <limits>
+#include <type_traits>
+#include <utility>
 
 #include "common/common_types.h"
 #include "video_core/dirty_flags.h"
@@ -55,6 +59,8 @@ enum : u8 {
     LogicOp,
     LogicOpEnable,
     DepthClampEnable,
+    PolygonMode,
+    AlphaToCoverageEnable,
 
     Blending,
     BlendEnable,
@@ -68,6 +74,33 @@ static_assert(Last <= std::numeric_limits<u8>::max());
 
 } // namespace Dirty
 
+/// Dynamic states whose last recorded value is shadowed by the state tracker
+enum class DynamicState : u8 {
+    DepthBias,
+    BlendConstants,
+    DepthBounds,
+    LineWidth,
+    CullMode,
+    DepthBoundsTestEnable,
+    DepthTestEnable,
+    DepthWriteEnable,
+    DepthCompareOp,
+    FrontFace,
+    StencilTestEnable,
+    PrimitiveRestartEnable,
+    RasterizerDiscardEnable,
+    DepthBiasEnable,
+    LogicOp,
+    LogicOpEnable,
+    DepthClampEnable,
+    PolygonMode,
+    AlphaToCoverageEnable,
+    ColorMask,
+    BlendEnable,
+
+    Last,
+};
+
 class StateTracker {
     using Maxwell = Tegra::Engines::Maxwell3D::Regs;
 
@@ -78,6 +111,7 @@ public:
         (*flags) |= invalidation_flags;
         current_topology = INVALID_TOPOLOGY;
         stencil_reset = true;
+        recorded_dynamic_states = 0;
     }
 
     void InvalidateViewports() {
@@ -164,6 +198,33 @@ public:
         return ExchangeCheck(back.compare_mask, new_value) || stencil_reset;
     }
 
+    /**
+     * Compares a dynamic state value against the one last recorded in the command buffer.
+     * Guests often rewrite registers with the values they already hold, marking states as dirty
+     * without changing them. Returns true when the value has to be recorded.
+     */
+    template <typename T>
+    bool ChangeDynamicState(DynamicState state, const T& value) {
+        static_assert(std::is_trivially_copyable_v<T> && sizeof(T) <= sizeof(DynamicStateValue));
+        DynamicStateValue new_value{};
+        std::memcpy(new_value.data(), &value, sizeof(T));
+        const size_t index = static_cast<size_t>(state);
+        const u32 state_bit = 1U << index;
+        if ((recorded_dynamic_states & state_bit) != 0 &&
+            dynamic_state_values[index] == new_value) {
+            ++num_redundant_dynamic_states;
+            return false;
+        }
+        recorded_dynamic_states |= state_bit;
+        dynamic_state_values[index] = new_value;
+        return true;
+    }
+
+    /// Returns the number of redundant dynamic state updates skipped since the last call
+    size_t ResetRedundantDynamicStates() noexcept {
+        return std::exchange(num_redundant_dynamic_states, 0);
+    }
+
     void ClearStencilReset() {
         stencil_reset = false;
     }
@@ -212,6 +273,14 @@ public:
         return Exchange(Dirty::DepthClampEnable, false);
     }
 
+    bool TouchPolygonMode() {
+        return Exchange(Dirty::PolygonMode, false);
+    }
+
+    bool TouchAlphaToCoverageEnable() {
+        return Exchange(Dirty::AlphaToCoverageEnable, false);
+    }
+
     bool TouchDepthCompareOp() {
         return Exchange(Dirty::DepthCompareOp, false);
     }
@@ -269,6 +338,9 @@ private:
         return is_dirty;
     }
 
+    using DynamicStateValue = std::array<u8, 32>;
+    static_assert(static_cast<size_t>(DynamicState::Last) <= 32);
+
     struct StencilProperties {
         u32 ref = 0;
         u32 write_mask = 0;
@@ -283,6 +355,9 @@ private:
     StencilProperties front{};
     StencilProperties back{};
     bool stencil_reset = false;
+    u32 recorded_dynamic_states = 0;
+    size_t num_redundant_dynamic_states = 0;
+    std::array<DynamicStateValue, static_cast<size_t>(DynamicState::Last)> dynamic_state_values{};
 };
 
 } // namespace Vulkan
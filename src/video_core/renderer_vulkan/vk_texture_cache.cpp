@@ -3,12 +3,14 @@
 
 #include <algorithm>
 #include <array>
+#include <bit>
 #include <span>
 #include <vector>
 #include <boost/container/small_vector.hpp>
 
 #include "common/bit_cast.h"
 #include "common/bit_util.h"
+#include "common/literals.h"
 #include "common/settings.h"
 
 #include "video_core/renderer_vulkan/vk_texture_cache.h"
@@ -19,6 +21,7 @@
 #include "video_core/renderer_vulkan/vk_compute_pass.h"
 #include "video_core/renderer_vulkan/vk_render_pass_cache.h"
 #include "video_core/renderer_vulkan/vk_scheduler.h"
+#include "video_core/renderer_vulkan/vk_sparse_image.h"
 #include "video_core/renderer_vulkan/vk_staging_buffer_pool.h"
 #include "video_core/texture_cache/formatter.h"
 #include "video_core/texture_cache/samples_helper.h"
@@ -42,6 +45,8 @@ using VideoCore::Surface::IsPixelFormatASTC;
 using VideoCore::Surface::IsPixelFormatInteger;
 using VideoCore::Surface::SurfaceType;
 
+using namespace Common::Literals;
+
 namespace {
 constexpr VkBorderColor ConvertBorderColor(const std::array<float, 4>& color) {
     if (color == std::array<float, 4>{0, 0, 0, 0}) {
@@ -120,6 +125,32 @@ constexpr VkBorderColor ConvertBorderColor(const std::array<float, 4>& color) {
     return usage;
 }
 
+/// Returns true when the BCn image is decoded on the GPU by BCnDecoderPass
+[[nodiscard]] bool IsGpuDecodedBcn(const Device& device, const ImageInfo& info) {
+    if (!IsPixelFormatBCn(info.format) || device.IsOptimalBcnSupported()) {
+        return false;
+    }
+    if (info.type == ImageType::Linear || info.size.depth != 1) {
+        return false;
+    }
+    return MaxwellToVK::SurfaceFormat(device, FormatType::Optimal, false, info.format).storage;
+}
+
+/// Smaller images are unswizzled on the CPU, a dispatch would cost more than the swizzle
+constexpr u32 MIN_ACCELERATED_UNSWIZZLE_SIZE = 64_KiB;
+
+/// Returns true when the image is unswizzled on the GPU by BlockLinearUnswizzlePass
+[[nodiscard]] bool IsGpuUnswizzled(const ImageInfo& info, u32 guest_size_bytes) {
+    if (info.type == ImageType::Linear || info.type == ImageType::Buffer) {
+        return false;
+    }
+    // Blocks of 3 bytes or 12 bytes can't be copied in units, gob tile spacing isn't handled
+    if (!std::has_single_bit(BytesPerBlock(info.format)) || info.tile_width_spacing != 0) {
+        return false;
+    }
+    return guest_size_bytes >= MIN_ACCELERATED_UNSWIZZLE_SIZE;
+}
+
 [[nodiscard]] VkImageCreateInfo MakeImageCreateInfo(const Device& device, const ImageInfo& info) {
     const auto format_info =
         MaxwellToVK::SurfaceFormat(device, FormatType::Optimal, false, info.format);
@@ -155,12 +186,25 @@ constexpr VkBorderColor ConvertBorderColor(const std::array<float, 4>& color) {
     };
 }
 
+constexpr VkImageCreateFlags SPARSE_IMAGE_FLAGS =
+    VK_IMAGE_CREATE_SPARSE_BINDING_BIT | VK_IMAGE_CREATE_SPARSE_RESIDENCY_BIT;
+
+/// Images smaller than this are always fully resident
+constexpr u32 MIN_SPARSE_IMAGE_SIZE = 64_MiB;
+
+/// Smaller uploads stay on the graphics queue, making it wait would cost more than the copy
+constexpr u32 MIN_TRANSFER_QUEUE_UPLOAD_SIZE = 256_KiB;
+
 [[nodiscard]] vk::Image MakeImage(const Device& device, const MemoryAllocator& allocator,
-                                  const ImageInfo& info, std::span<const VkFormat> view_formats) {
+                                  const ImageInfo& info, std::span<const VkFormat> view_formats,
+                                  bool is_sparse = false) {
     if (info.type == ImageType::Buffer) {
         return vk::Image{};
     }
     VkImageCreateInfo image_ci = MakeImageCreateInfo(device, info);
+    if (is_sparse) {
+        image_ci.flags |= SPARSE_IMAGE_FLAGS;
+    }
     const VkImageFormatListCreateInfo image_format_list = {
         .sType = VK_STRUCTURE_TYPE_IMAGE_FORMAT_LIST_CREATE_INFO,
         .pNext = nullptr,
@@ -173,6 +217,9 @@ constexpr VkBorderColor ConvertBorderColor(const std::array<float, 4>& color) {
             image_ci.pNext = &image_format_list;
         }
     }
+    if (is_sparse) {
+        return allocator.CreateSparseImage(image_ci);
+    }
     return allocator.CreateImage(image_ci);
 }
 
@@ -843,11 +890,21 @@ TextureCacheRuntime::TextureCacheRuntime(const Device& device_, Scheduler& sched
                                          ComputePassDescriptorQueue& compute_pass_descriptor_queue)
     : device{device_}, scheduler{scheduler_}, memory_allocator{memory_allocator_},
       staging_buffer_pool{staging_buffer_pool_}, blit_image_helper{blit_image_helper_},
-      render_pass_cache{render_pass_cache_}, resolution{Settings::values.resolution_info} {
+      render_pass_cache{render_pass_cache_}, resolution{Settings::values.resolution_info},
+      use_sparse_residency{Settings::values.use_sparse_image_residency.GetValue() &&
+                           device.IsSparseImageResidencySupported()} {
     if (Settings::values.accelerate_astc.GetValue() == Settings::AstcDecodeMode::Gpu) {
         astc_decoder_pass.emplace(device, scheduler, descriptor_pool, staging_buffer_pool,
                                   compute_pass_descriptor_queue, memory_allocator);
     }
+    if (!device.IsOptimalBcnSupported()) {
+        bcn_decoder_pass.emplace(device, scheduler, descriptor_pool, compute_pass_descriptor_queue);
+    }
+    block_linear_unswizzle_pass.emplace(device, scheduler, descriptor_pool, staging_buffer_pool,
+                                        compute_pass_descriptor_queue);
+    if (device.HasDedicatedTransferQueue() && device.HasTimelineSemaphore()) {
+        transfer_queue.emplace(device);
+    }
     if (device.IsStorageImageMultisampleSupported()) {
         msaa_copy_pass = std::make_unique<MSAACopyPass>(
             device, scheduler, descriptor_pool, staging_buffer_pool, compute_pass_descriptor_queue);
@@ -873,6 +930,7 @@ TextureCacheRuntime::TextureCacheRuntime(const Device& device_, Scheduler& sched
 
 void TextureCacheRuntime::Finish() {
     scheduler.Finish();
+    staging_buffer_pool.InvalidateDownloads();
 }
 
 StagingBufferRef TextureCacheRuntime::UploadStagingBuffer(size_t size) {
@@ -950,6 +1008,7 @@ void TextureCacheRuntime::ReinterpretImage(Image& dst, Image& src,
     size_t total_size = 0;
     for (const auto& copy : copies) {
         total_size += copy.extent.width * copy.extent.height * copy.extent.depth * img_bpp;
+        dst.MakeResident(copy.dst_subresource);
     }
     const VkBuffer copy_buffer = GetTemporaryBuffer(total_size);
     const VkImage dst_image = dst.Handle();
@@ -1262,6 +1321,9 @@ void TextureCacheRuntime::CopyImage(Image& dst, Image& src,
     std::ranges::transform(copies, vk_copies.begin(), [aspect_mask](const auto& copy) {
         return MakeImageCopy(copy, aspect_mask);
     });
+    for (const VideoCommon::ImageCopy& copy : copies) {
+        dst.MakeResident(copy.dst_subresource);
+    }
     const VkImage dst_image = dst.Handle();
     const VkImage src_image = src.Handle();
     scheduler.RequestOutsideRenderPassOperationContext();
@@ -1345,6 +1407,9 @@ void TextureCacheRuntime::CopyImage(Image& dst, Image& src,
 void TextureCacheRuntime::CopyImageMSAA(Image& dst, Image& src,
                                         std::span<const VideoCommon::ImageCopy> copies) {
     const bool msaa_to_non_msaa = src.info.num_samples > 1 && dst.info.num_samples == 1;
+    for (const VideoCommon::ImageCopy& copy : copies) {
+        dst.MakeResident(copy.dst_subresource);
+    }
     if (msaa_copy_pass) {
         return msaa_copy_pass->CopyImage(dst, src, copies, msaa_to_non_msaa);
     }
@@ -1363,14 +1428,45 @@ bool TextureCacheRuntime::CanReportMemoryUsage() const {
     return device.CanReportMemoryUsage();
 }
 
-void TextureCacheRuntime::TickFrame() {}
+void TextureCacheRuntime::TickFrame() {
+    if (sparse_residency_stats.committed_bytes != reported_sparse_committed_bytes) {
+        reported_sparse_committed_bytes = sparse_residency_stats.committed_bytes;
+        LOG_DEBUG(Render_Vulkan, "Sparse images: {} MiB committed of {} MiB",
+                  sparse_residency_stats.committed_bytes / 1_MiB,
+                  sparse_residency_stats.virtual_bytes / 1_MiB);
+    }
+}
+
+bool TextureCacheRuntime::ShouldUseSparseResidency(const ImageInfo& info) const {
+    if (!use_sparse_residency || info.type != ImageType::e2D || info.storage ||
+        info.num_samples != 1) {
+        return false;
+    }
+    // Only arrays and mipmapped images can be partially resident
+    if (info.resources.layers == 1 && info.resources.levels == 1) {
+        return false;
+    }
+    if (VideoCommon::CalculateGuestSizeInBytes(info) < MIN_SPARSE_IMAGE_SIZE) {
+        return false;
+    }
+    VkImageCreateInfo image_ci = MakeImageCreateInfo(device, info);
+    image_ci.flags |= SPARSE_IMAGE_FLAGS;
+    return SparseImage::IsSupported(device, image_ci);
+}
 
 Image::Image(TextureCacheRuntime& runtime_, const ImageInfo& info_, GPUVAddr gpu_addr_,
              VAddr cpu_addr_)
     : VideoCommon::ImageBase(info_, gpu_addr_, cpu_addr_), scheduler{&runtime_.scheduler},
-      runtime{&runtime_}, original_image(MakeImage(runtime_.device, runtime_.memory_allocator, info,
-                                                   runtime->ViewFormats(info.format))),
-      aspect_mask(ImageAspectMask(info.format)) {
+      runtime{&runtime_}, aspect_mask(ImageAspectMask(info.format)) {
+    const bool is_sparse = runtime->ShouldUseSparseResidency(info);
+    original_image = MakeImage(runtime->device, runtime->memory_allocator, info,
+                               runtime->ViewFormats(info.format), is_sparse);
+    if (is_sparse) {
+        sparse_image = std::make_unique<SparseImage>(
+            runtime->device, runtime->memory_allocator, *scheduler,
+            runtime->sparse_residency_stats, *original_image,
+            MakeImageCreateInfo(runtime->device, info));
+    }
     if (IsPixelFormatASTC(info.format) && !runtime->device.IsOptimalAstcSupported()) {
         switch (Settings::values.accelerate_astc.GetValue()) {
         case Settings::AstcDecodeMode::Gpu:
@@ -1390,9 +1486,15 @@ Image::Image(TextureCacheRuntime& runtime_, const ImageInfo& info_, GPUVAddr gpu
         flags |= VideoCommon::ImageFlagBits::CostlyLoad;
     }
     if (IsPixelFormatBCn(info.format) && !runtime->device.IsOptimalBcnSupported()) {
+        if (IsGpuDecodedBcn(runtime->device, info)) {
+            flags |= VideoCommon::ImageFlagBits::AcceleratedUpload;
+        }
         flags |= VideoCommon::ImageFlagBits::Converted;
         flags |= VideoCommon::ImageFlagBits::CostlyLoad;
     }
+    if (False(flags & ImageFlagBits::Converted) && IsGpuUnswizzled(info, guest_size_bytes)) {
+        flags |= VideoCommon::ImageFlagBits::AcceleratedUpload;
+    }
     if (runtime->device.HasDebuggingToolAttached()) {
         original_image.SetObjectNameEXT(VideoCommon::Name(*this).c_str());
     }
@@ -1407,6 +1509,17 @@ Image::Image(TextureCacheRuntime& runtime_, const ImageInfo& info_, GPUVAddr gpu
                 MakeStorageView(device, level, *original_image, VK_FORMAT_A8B8G8R8_UNORM_PACK32);
         }
     }
+    if (IsPixelFormatBCn(info.format) && True(flags & ImageFlagBits::AcceleratedUpload)) {
+        // Views of sRGB formats can't be storage images, write through the linear format instead
+        const auto& device = runtime->device.GetLogical();
+        const VkFormat storage_format =
+            MaxwellToVK::SurfaceFormat(runtime->device, FormatType::Optimal, false, info.format)
+                .format;
+        for (s32 level = 0; level < info.resources.levels; ++level) {
+            storage_image_views[level] =
+                MakeStorageView(device, level, *original_image, storage_format);
+        }
+    }
 }
 
 Image::Image(const VideoCommon::NullImageParams& params) : VideoCommon::ImageBase{params} {}
@@ -1420,16 +1533,27 @@ void Image::UploadMemory(VkBuffer buffer, VkDeviceSize offset,
     if (is_rescaled) {
         ScaleDown(true);
     }
+    for (const BufferImageCopy& copy : copies) {
+        MakeResident(copy.image_subresource);
+    }
     scheduler->RequestOutsideRenderPassOperationContext();
     auto vk_copies = TransformBufferImageCopies(copies, offset, aspect_mask);
     const VkBuffer src_buffer = buffer;
     const VkImage vk_image = *original_image;
     const VkImageAspectFlags vk_aspect_mask = aspect_mask;
     const bool is_initialized = std::exchange(initialized, true);
-    scheduler->Record([src_buffer, vk_image, vk_aspect_mask, is_initialized,
-                       vk_copies](vk::CommandBuffer cmdbuf) {
-        CopyBufferToImage(cmdbuf, src_buffer, vk_image, vk_aspect_mask, is_initialized, vk_copies);
-    });
+    // Accelerated uploads read a buffer written on the graphics queue
+    if (!is_initialized && !is_rescaled && !sparse_image && runtime->transfer_queue &&
+        False(flags & ImageFlagBits::AcceleratedUpload) &&
+        guest_size_bytes >= MIN_TRANSFER_QUEUE_UPLOAD_SIZE) {
+        UploadOnTransferQueue(src_buffer, vk_copies);
+    } else {
+        scheduler->Record([src_buffer, vk_image, vk_aspect_mask, is_initialized,
+                           vk_copies](vk::CommandBuffer cmdbuf) {
+            CopyBufferToImage(cmdbuf, src_buffer, vk_image, vk_aspect_mask, is_initialized,
+                              vk_copies);
+        });
+    }
     if (is_rescaled) {
         ScaleUp();
     }
@@ -1439,6 +1563,38 @@ void Image::UploadMemory(const StagingBufferRef& map, std::span<const BufferImag
     UploadMemory(map.buffer, map.offset, copies);
 }
 
+void Image::UploadOnTransferQueue(VkBuffer buffer, std::span<const VkBufferImageCopy> copies) {
+    TransferQueue& transfer_queue = *runtime->transfer_queue;
+    const VkImage vk_image = *original_image;
+    const u64 tick = transfer_queue.UploadImage(buffer, vk_image, aspect_mask, copies);
+    scheduler->WaitTimeline(transfer_queue.Semaphore(), tick);
+    scheduler->Record([vk_image, vk_aspect_mask = aspect_mask,
+                       src_family = runtime->device.GetTransferFamily(),
+                       dst_family = runtime->device.GetGraphicsFamily()](vk::CommandBuffer cmdbuf) {
+        // Acquire the image released by the transfer queue
+        const VkImageMemoryBarrier acquire_barrier{
+            .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+            .pNext = nullptr,
+            .srcAccessMask = 0,
+            .dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT,
+            .oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            .newLayout = VK_IMAGE_LAYOUT_GENERAL,
+            .srcQueueFamilyIndex = src_family,
+            .dstQueueFamilyIndex = dst_family,
+            .image = vk_image,
+            .subresourceRange{
+                .aspectMask = vk_aspect_mask,
+                .baseMipLevel = 0,
+                .levelCount = VK_REMAINING_MIP_LEVELS,
+                .baseArrayLayer = 0,
+                .layerCount = VK_REMAINING_ARRAY_LAYERS,
+            },
+        };
+        cmdbuf.PipelineBarrier(VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                               VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, acquire_barrier);
+    });
+}
+
 void Image::DownloadMemory(VkBuffer buffer, size_t offset,
                            std::span<const VideoCommon::BufferImageCopy> copies) {
     std::array buffer_handles{
@@ -1538,6 +1694,10 @@ void Image::DownloadMemory(const StagingBufferRef& map, std::span<const BufferIm
 VkImageView Image::StorageImageView(s32 level) noexcept {
     auto& view = storage_image_views[level];
     if (!view) {
+        MakeResident(SubresourceRange{
+            .base{.level = level, .layer = 0},
+            .extent{.levels = 1, .layers = info.resources.layers},
+        });
         const auto format_info =
             MaxwellToVK::SurfaceFormat(runtime->device, FormatType::Optimal, true, info.format);
         view =
@@ -1546,6 +1706,19 @@ VkImageView Image::StorageImageView(s32 level) noexcept {
     return *view;
 }
 
+void Image::MakeResident(const VideoCommon::SubresourceLayers& subresource) {
+    MakeResident(SubresourceRange{
+        .base{.level = subresource.base_level, .layer = subresource.base_layer},
+        .extent{.levels = 1, .layers = subresource.num_layers},
+    });
+}
+
+void Image::MakeResident(const SubresourceRange& range) {
+    if (sparse_image) {
+        sparse_image->Commit(MakeSubresourceRange(aspect_mask, range));
+    }
+}
+
 bool Image::IsRescaled() const noexcept {
     return True(flags & ImageFlagBits::Rescaled);
 }
@@ -1597,6 +1770,10 @@ bool Image::ScaleDown(bool ignore) {
     }
     ASSERT(info.type != ImageType::Linear);
     flags &= ~ImageFlagBits::Rescaled;
+    if (sparse_image) {
+        // Scaling down writes every subresource of the original image
+        sparse_image->CommitAll();
+    }
     current_image = *original_image;
     if (ignore) {
         return true;
@@ -1697,6 +1874,10 @@ ImageView::ImageView(TextureCacheRuntime& runtime, const VideoCommon::ImageViewI
       samples(ConvertSampleCount(image.info.num_samples)) {
     using Shader::TextureType;
 
+    if (info.IsRenderTarget()) {
+        // Render target views are also used for blits and conversions, all of them write
+        image.MakeResident(info.range);
+    }
     const VkImageAspectFlags aspect_mask = ImageViewAspectMask(info);
     std::array<SwizzleSource, 4> swizzle{
         SwizzleSource::R,
@@ -1974,8 +2155,7 @@ void Framebuffer::CreateFramebuffer(TextureCacheRuntime& runtime,
                                     std::span<ImageView*, NUM_RT> color_buffers,
                                     ImageView* depth_buffer, bool is_rescaled_) {
     boost::container::small_vector<VkImageView, NUM_RT + 1> attachments;
-    RenderPassKey renderpass_key{};
-    s32 num_layers = 1;
+    s32 max_layers = 1;
 
     is_rescaled = is_rescaled_;
     const auto& resolution = runtime.resolution;
@@ -1994,7 +2174,7 @@ void Framebuffer::CreateFramebuffer(TextureCacheRuntime& runtime,
                                               : color_buffer->size.height);
         attachments.push_back(color_buffer->RenderTarget());
         renderpass_key.color_formats[index] = color_buffer->format;
-        num_layers = std::max(num_layers, color_buffer->range.extent.layers);
+        max_layers = std::max(max_layers, color_buffer->range.extent.layers);
         images[num_images] = color_buffer->ImageHandle();
         image_ranges[num_images] = MakeSubresourceRange(color_buffer);
         rt_map[index] = num_images;
@@ -2009,7 +2189,7 @@ void Framebuffer::CreateFramebuffer(TextureCacheRuntime& runtime,
                                               : depth_buffer->size.height);
         attachments.push_back(depth_buffer->RenderTarget());
         renderpass_key.depth_format = depth_buffer->format;
-        num_layers = std::max(num_layers, depth_buffer->range.extent.layers);
+        max_layers = std::max(max_layers, depth_buffer->range.extent.layers);
         images[num_images] = depth_buffer->ImageHandle();
         const VkImageSubresourceRange subresource_range = MakeSubresourceRange(depth_buffer);
         image_ranges[num_images] = subresource_range;
@@ -2027,6 +2207,7 @@ void Framebuffer::CreateFramebuffer(TextureCacheRuntime& runtime,
     render_area.height = std::min(render_area.height, height);
 
     num_color_buffers = static_cast<u32>(num_colors);
+    num_layers = static_cast<u32>(std::max(max_layers, 1));
     framebuffer = runtime.device.GetLogical().CreateFramebuffer({
         .sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO,
         .pNext = nullptr,
@@ -2036,16 +2217,23 @@ void Framebuffer::CreateFramebuffer(TextureCacheRuntime& runtime,
         .pAttachments = attachments.data(),
         .width = render_area.width,
         .height = render_area.height,
-        .layers = static_cast<u32>(std::max(num_layers, 1)),
+        .layers = num_layers,
     });
 }
 
 void TextureCacheRuntime::AccelerateImageUpload(
     Image& image, const StagingBufferRef& map,
     std::span<const VideoCommon::SwizzleParameters> swizzles) {
+    if (False(image.flags & ImageFlagBits::Converted)) {
+        const auto [buffer, offset] = block_linear_unswizzle_pass->Assemble(image, map, swizzles);
+        return image.UploadMemory(buffer, offset, VideoCommon::FullUploadCopies(image.info));
+    }
     if (IsPixelFormatASTC(image.info.format)) {
         return astc_decoder_pass->Assemble(image, map, swizzles);
     }
+    if (IsPixelFormatBCn(image.info.format)) {
+        return bcn_decoder_pass->Assemble(image, map, swizzles);
+    }
     ASSERT(false);
 }
 
@@ -9,7 +9,10 @@
 
 #include "shader_recompiler/shader_info.h"
 #include "video_core/renderer_vulkan/vk_compute_pass.h"
+#include "video_core/renderer_vulkan/vk_render_pass_cache.h"
+#include "video_core/renderer_vulkan/vk_sparse_image.h"
 #include "video_core/renderer_vulkan/vk_staging_buffer_pool.h"
+#include "video_core/renderer_vulkan/vk_transfer_queue.h"
 #include "video_core/texture_cache/image_view_base.h"
 #include "video_core/vulkan_common/vulkan_memory_allocator.h"
 #include "video_core/vulkan_common/vulkan_wrapper.h"
@@ -112,6 +115,9 @@ public:
 
     void BarrierFeedbackLoop();
 
+    /// Returns true when the image should only be backed by memory where it is written to
+    [[nodiscard]] bool ShouldUseSparseResidency(const VideoCommon::ImageInfo& info) const;
+
     const Device& device;
     Scheduler& scheduler;
     MemoryAllocator& memory_allocator;
@@ -119,10 +125,17 @@ public:
     BlitImageHelper& blit_image_helper;
     RenderPassCache& render_pass_cache;
     std::optional<ASTCDecoderPass> astc_decoder_pass;
+    std::optional<BCnDecoderPass> bcn_decoder_pass;
+    std::optional<BlockLinearUnswizzlePass> block_linear_unswizzle_pass;
+    std::optional<TransferQueue> transfer_queue;
     std::unique_ptr<MSAACopyPass> msaa_copy_pass;
     const Settings::ResolutionScalingInfo& resolution;
     std::array<std::vector<VkFormat>, VideoCore::Surface::MaxPixelFormat> view_formats;
 
+    bool use_sparse_residency{};
+    SparseResidencyStats sparse_residency_stats;
+    u64 reported_sparse_committed_bytes{};
+
     static constexpr size_t indexing_slots = 8 * sizeof(size_t);
     std::array<vk::Buffer, indexing_slots> buffers{};
 };
@@ -171,6 +184,12 @@ public:
 
     VkImageView StorageImageView(s32 level) noexcept;
 
+    /// Binds memory to the given subresources when the image is sparse resident
+    void MakeResident(const VideoCommon::SubresourceLayers& subresource);
+
+    /// Binds memory to the given subresources when the image is sparse resident
+    void MakeResident(const VideoCommon::SubresourceRange& range);
+
     bool IsRescaled() const noexcept;
 
     bool ScaleUp(bool ignore = false);
@@ -178,6 +197,9 @@ public:
     bool ScaleDown(bool ignore = false);
 
 private:
+    /// Uploads to the image on the dedicated transfer queue, the image must not be initialized
+    void UploadOnTransferQueue(VkBuffer buffer, std::span<const VkBufferImageCopy> copies);
+
     bool BlitScaleHelper(bool scale_up);
 
     bool NeedsScaleHelper() const;
@@ -186,6 +208,7 @@ private:
     TextureCacheRuntime* runtime{};
 
     vk::Image original_image;
+    std::unique_ptr<SparseImage> sparse_image;
     std::vector<vk::ImageView> storage_image_views;
     VkImageAspectFlags aspect_mask = 0;
     bool initialized = false;
@@ -325,6 +348,10 @@ public:
         return renderpass;
     }
 
+    [[nodiscard]] const RenderPassKey& RenderPassFormats() const noexcept {
+        return renderpass_key;
+    }
+
     [[nodiscard]] VkExtent2D RenderArea() const noexcept {
         return render_area;
     }
@@ -337,6 +364,15 @@ public:
         return num_color_buffers;
     }
 
+    [[nodiscard]] u32 NumLayers() const noexcept {
+        return num_layers;
+    }
+
+    /// Returns the attachment index of a render target, the depth attachment follows the colors
+    [[nodiscard]] size_t ColorAttachmentIndex(size_t index) const noexcept {
+        return rt_map[index];
+    }
+
     [[nodiscard]] u32 NumImages() const noexcept {
         return num_images;
     }
@@ -368,9 +404,11 @@ public:
 private:
     vk::Framebuffer framebuffer;
     VkRenderPass renderpass{};
+    RenderPassKey renderpass_key{};
     VkExtent2D render_area{};
     VkSampleCountFlagBits samples = VK_SAMPLE_COUNT_1_BIT;
     u32 num_color_buffers = 0;
+    u32 num_layers = 1;
     u32 num_images = 0;
     std::array<VkImage, 9> images{};
     std::array<VkImageSubresourceRange, 9> image_ranges{};
@@ -0,0 +1,50 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <deque>
+#include <span>
+
+#include "common/common_types.h"
+#include "video_core/vulkan_common/vulkan_wrapper.h"
+
+namespace Vulkan {
+
+class Device;
+
+/// Records copies on the dedicated transfer queue of the device, so they run on the copy engine
+/// while the graphics queue keeps rendering. Submissions signal a timeline semaphore.
+class TransferQueue {
+public:
+    explicit TransferQueue(const Device& device);
+    ~TransferQueue();
+
+    /// Copies staging memory to an image that has not been used by any queue yet. The image is
+    /// released to the graphics queue family in the general layout, the graphics queue has to
+    /// acquire it and wait for the returned tick before using it.
+    [[nodiscard]] u64 UploadImage(VkBuffer buffer, VkImage image, VkImageAspectFlags aspect_mask,
+                                  std::span<const VkBufferImageCopy> copies);
+
+    /// Returns the timeline semaphore signaled by the transfer submissions.
+    [[nodiscard]] VkSemaphore Semaphore() const noexcept {
+        return *semaphore;
+    }
+
+private:
+    struct Submission {
+        vk::CommandBuffers cmdbufs;
+        u64 tick;
+    };
+
+    /// Returns a command buffer that is not in use by the GPU.
+    Submission& AcquireCommandBuffer();
+
+    const Device& device;
+    vk::CommandPool command_pool;
+    vk::Semaphore semaphore;
+    std::deque<Submission> submissions; ///< Sorted by the tick of their last submission.
+    u64 current_tick{};
+};
+
+} // namespace Vulkan
@@ -5,6 +5,8 @@
 #include <adrenotools/driver.h>
 #endif
 
+#include <algorithm>
+
 #include "common/literals.h"
 #include "video_core/host_shaders/vulkan_turbo_mode_comp_spv.h"
 #include "video_core/renderer_vulkan/renderer_vulkan.h"
@@ -15,6 +17,27 @@
 namespace Vulkan {
 
 using namespace Common::Literals;
+using namespace std::chrono_literals;
+
+namespace {
+
+// Clocks are no longer kept up once the guest hasn't submitted work for this long
+constexpr std::chrono::steady_clock::duration IDLE_TIMEOUT = 100ms;
+
+#ifndef ANDROID
+// The GPU is considered idle, and a keep-alive dispatch needed, after this long without work
+constexpr std::chrono::steady_clock::duration KEEP_ALIVE_DELAY = 2ms;
+
+// Bounds of the duration of a keep-alive dispatch
+constexpr std::chrono::steady_clock::duration MIN_DISPATCH_TIME = 250us;
+constexpr std::chrono::steady_clock::duration MAX_DISPATCH_TIME = 2ms;
+
+// Bounds of the number of workgroups of a keep-alive dispatch
+constexpr double MIN_GROUPS = 1.0;
+constexpr double MAX_GROUPS = 64.0 * 64.0;
+#endif
+
+} // Anonymous namespace
 
 TurboMode::TurboMode(const vk::Instance& instance, const vk::InstanceDispatch& dld)
 #ifndef ANDROID
@@ -32,7 +55,11 @@ TurboMode::~TurboMode() = default;
 
 void TurboMode::QueueSubmitted() {
     std::scoped_lock lk{m_submission_lock};
-    m_submission_time = std::chrono::steady_clock::now();
+    const auto now = std::chrono::steady_clock::now();
+    if (const auto gap = now - m_submission_time; gap <= IDLE_TIMEOUT) {
+        m_average_gap = (m_average_gap * 7 + gap) / 8;
+    }
+    m_submission_time = now;
     m_submission_cv.notify_one();
 }
 
@@ -148,14 +175,60 @@ void TurboMode::Run(std::stop_token stop_token) {
     // Create a single command buffer.
     auto cmdbufs = command_pool.Allocate(1, VK_COMMAND_BUFFER_LEVEL_PRIMARY);
     auto cmdbuf = vk::CommandBuffer{cmdbufs[0], m_device.GetDispatchLoader()};
+
+    // Number of workgroups of a keep-alive dispatch, adjusted to its measured duration
+    double num_groups = MAX_GROUPS / 16;
+#endif
+#if defined(ANDROID) && defined(ARCHITECTURE_arm64)
+    bool is_turbo_set = false;
 #endif
 
     while (!stop_token.stop_requested()) {
+        std::chrono::steady_clock::duration idle_time;
+        [[maybe_unused]] std::chrono::steady_clock::duration average_gap;
+        {
+            std::unique_lock lk{m_submission_lock};
+            const auto is_active = [this] {
+                return (std::chrono::steady_clock::now() - m_submission_time) <= IDLE_TIMEOUT;
+            };
+            if (!is_active()) {
+#if defined(ANDROID) && defined(ARCHITECTURE_arm64)
+                if (is_turbo_set) {
+                    adrenotools_set_turbo(false);
+                    is_turbo_set = false;
+                }
+#endif
+                // The guest stopped rendering, let the GPU clock down until it resumes
+                Common::CondvarWait(m_submission_cv, lk, stop_token, is_active);
+            }
+            idle_time = std::chrono::steady_clock::now() - m_submission_time;
+            average_gap = m_average_gap;
+        }
+        if (stop_token.stop_requested()) {
+            break;
+        }
 #ifdef ANDROID
 #ifdef ARCHITECTURE_arm64
-        adrenotools_set_turbo(true);
+        if (!is_turbo_set) {
+            adrenotools_set_turbo(true);
+            is_turbo_set = true;
+        }
 #endif
+        // The driver keeps the clocks up, check again once the guest could have gone idle
+        Common::StoppableTimedWait(stop_token, IDLE_TIMEOUT - idle_time);
 #else
+        if (idle_time < KEEP_ALIVE_DELAY) {
+            // The guest is keeping the GPU busy, don't contend with it
+            Common::StoppableTimedWait(stop_token, KEEP_ALIVE_DELAY - idle_time);
+            continue;
+        }
+
+        // Keep dispatches short compared to the gaps between submissions, so the guest's next
+        // submission isn't held back behind one
+        const auto target_time =
+            std::clamp<std::chrono::steady_clock::duration>(average_gap / 4, MIN_DISPATCH_TIME,
+                                                            MAX_DISPATCH_TIME);
+
         // Reset the fence.
         fence.Reset();
 
@@ -200,7 +273,7 @@ void TurboMode::Run(std::stop_token stop_token) {
         cmdbuf.BindPipeline(VK_PIPELINE_BIND_POINT_COMPUTE, *pipeline);
 
         // Dispatch.
-        cmdbuf.Dispatch(64, 64, 1);
+        cmdbuf.Dispatch(static_cast<u32>(num_groups), 1, 1);
 
         // Finish.
         cmdbuf.End();
@@ -217,20 +290,25 @@ void TurboMode::Run(std::stop_token stop_token) {
             .pSignalSemaphores = nullptr,
         };
 
+        const auto submit_time = std::chrono::steady_clock::now();
         m_device.GetGraphicsQueue().Submit(std::array{submit_info}, *fence);
 
         // Wait for completion.
         fence.Wait();
+
+        // Size the next dispatch from how long this one took, the GPU's clock included
+        const auto elapsed = std::chrono::steady_clock::now() - submit_time;
+        if (elapsed.count() > 0) {
+            num_groups = std::clamp(num_groups * static_cast<double>(target_time.count()) /
+                                        static_cast<double>(elapsed.count()),
+                                    MIN_GROUPS, MAX_GROUPS);
+        }
 #endif
-        // Wait for the next graphics queue submission if necessary.
-        std::unique_lock lk{m_submission_lock};
-        Common::CondvarWait(m_submission_cv, lk, stop_token, [this] {
-            return (std::chrono::steady_clock::now() - m_submission_time) <=
-                   std::chrono::milliseconds{100};
-        });
     }
 #if defined(ANDROID) && defined(ARCHITECTURE_arm64)
-    adrenotools_set_turbo(false);
+    if (is_turbo_set) {
+        adrenotools_set_turbo(false);
+    }
 #endif
 }
 
@@ -13,6 +13,8 @@
 
 namespace Vulkan {
 
+/// Keeps the GPU clocked up while the guest is rendering. Adreno drivers are asked directly,
+/// other GPUs get short dispatches in the gaps between the guest's submissions.
 class TurboMode {
 public:
     explicit TurboMode(const vk::Instance& instance, const vk::InstanceDispatch& dld);
@@ -30,6 +32,7 @@ private:
     std::mutex m_submission_lock;
     std::condition_variable_any m_submission_cv;
     std::chrono::time_point<std::chrono::steady_clock> m_submission_time{};
+    std::chrono::steady_clock::duration m_average_gap{};
 
     std::jthread m_thread;
 };
@@ -2,10 +2,16 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <algorithm>
+#include <chrono>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <sstream>
+#include <string>
+#include <unordered_set>
 #include <utility>
 
 #include "common/assert.h"
@@ -13,10 +19,13 @@
 #include "common/common_types.h"
 #include "common/div_ceil.h"
 #include "common/fs/fs.h"
+#include "common/fs/mapped_file.h"
 #include "common/fs/path_util.h"
 #include "common/logging/log.h"
 #include "common/polyfill_ranges.h"
+#include "common/zstd_compression.h"
 #include "shader_recompiler/environment.h"
+#include "shader_recompiler/exception.h"
 #include "video_core/engines/kepler_compute.h"
 #include "video_core/memory_manager.h"
 #include "video_core/shader_environment.h"
@@ -25,7 +34,10 @@
 
 namespace VideoCommon {
 
-constexpr std::array<char, 8> MAGIC_NUMBER{'y', 'u', 'z', 'u', 'c', 'a', 'c', 'h'};
+constexpr std::array<char, 8> MAGIC_NUMBER{'y', 'u', 'z', 'u', 'p', 'c', 'z', '1'};
+// Magic of the uncompressed format storing the environments of each pipeline inline
+constexpr std::array<char, 8> LEGACY_MAGIC_NUMBER{'y', 'u', 'z', 'u', 'c', 'a', 'c', 'h'};
+constexpr size_t HEADER_SIZE = sizeof(MAGIC_NUMBER) + sizeof(u32);
 
 constexpr size_t INST_SIZE = sizeof(u64);
 
@@ -193,7 +205,7 @@ void GenericEnvironment::Dump(u64 pipeline_hash, u64 shader_hash) {
     DumpImpl(pipeline_hash, shader_hash, code, read_highest, read_lowest, initial_offset, stage);
 }
 
-void GenericEnvironment::Serialize(std::ofstream& file) const {
+void GenericEnvironment::Serialize(std::ostream& file) const {
     const u64 code_size{static_cast<u64>(CachedSizeBytes())};
     const u64 num_texture_types{static_cast<u64>(texture_types.size())};
     const u64 num_texture_pixel_formats{static_cast<u64>(texture_pixel_formats.size())};
@@ -448,7 +460,7 @@ u32 ComputeEnvironment::ReadViewportTransformState() {
     return viewport_transform_state;
 }
 
-void FileEnvironment::Deserialize(std::ifstream& file) {
+void FileEnvironment::Deserialize(std::istream& file) {
     u64 code_size{};
     u64 num_texture_types{};
     u64 num_texture_pixel_formats{};
@@ -582,8 +594,304 @@ std::optional<Shader::ReplaceConstant> FileEnvironment::GetReplaceConstBuffer(u3
     return it->second;
 }
 
+RecordingEnvironment::RecordingEnvironment(Shader::Environment& env_) : env{env_} {
+    sph = env.SPH();
+    gp_passthrough_mask = env.GpPassthroughMask();
+    stage = env.ShaderStage();
+    start_address = env.StartAddress();
+    is_proprietary_driver = env.IsProprietaryDriver();
+
+    queries.viewport_transform_state = env.ReadViewportTransformState();
+    queries.local_memory_size = env.LocalMemorySize();
+    queries.texture_bound = env.TextureBoundBuffer();
+}
+
+u64 RecordingEnvironment::ReadInstruction(u32 address) {
+    return env.ReadInstruction(address);
+}
+
+u32 RecordingEnvironment::ReadCbufValue(u32 cbuf_index, u32 cbuf_offset) {
+    const u32 value{env.ReadCbufValue(cbuf_index, cbuf_offset)};
+    queries.cbuf_values.emplace(MakeCbufKey(cbuf_index, cbuf_offset), value);
+    return value;
+}
+
+Shader::TextureType RecordingEnvironment::ReadTextureType(u32 handle) {
+    const Shader::TextureType type{env.ReadTextureType(handle)};
+    queries.texture_types.emplace(handle, type);
+    return type;
+}
+
+Shader::TexturePixelFormat RecordingEnvironment::ReadTexturePixelFormat(u32 handle) {
+    const Shader::TexturePixelFormat format{env.ReadTexturePixelFormat(handle)};
+    queries.texture_pixel_formats.emplace(handle, format);
+    return format;
+}
+
+bool RecordingEnvironment::IsTexturePixelFormatInteger(u32 handle) {
+    const bool is_integer{env.IsTexturePixelFormatInteger(handle)};
+    queries.texture_pixel_format_integers.emplace(handle, is_integer);
+    return is_integer;
+}
+
+u32 RecordingEnvironment::ReadViewportTransformState() {
+    return queries.viewport_transform_state;
+}
+
+u32 RecordingEnvironment::LocalMemorySize() const {
+    return queries.local_memory_size;
+}
+
+u32 RecordingEnvironment::SharedMemorySize() const {
+    return env.SharedMemorySize();
+}
+
+u32 RecordingEnvironment::TextureBoundBuffer() const {
+    return queries.texture_bound;
+}
+
+std::array<u32, 3> RecordingEnvironment::WorkgroupSize() const {
+    return env.WorkgroupSize();
+}
+
+bool RecordingEnvironment::HasHLEMacroState() const {
+    return env.HasHLEMacroState();
+}
+
+std::optional<Shader::ReplaceConstant> RecordingEnvironment::GetReplaceConstBuffer(u32 bank,
+                                                                                   u32 offset) {
+    return env.GetReplaceConstBuffer(bank, offset);
+}
+
+void RecordingEnvironment::Dump(u64 pipeline_hash, u64 shader_hash) {
+    env.Dump(pipeline_hash, shader_hash);
+}
+
+bool MatchesQueries(Shader::Environment& env, const EnvironmentQueries& queries) try {
+    // Constant buffer replacements depend on macro state that isn't recorded
+    if (env.HasHLEMacroState() ||
+        env.ReadViewportTransformState() != queries.viewport_transform_state ||
+        env.LocalMemorySize() != queries.local_memory_size ||
+        env.TextureBoundBuffer() != queries.texture_bound) {
+        return false;
+    }
+    for (const auto& [key, value] : queries.cbuf_values) {
+        const u32 index{static_cast<u32>(key >> 32)};
+        const u32 offset{static_cast<u32>(key)};
+        if (env.ReadCbufValue(index, offset) != value) {
+            return false;
+        }
+    }
+    for (const auto& [handle, type] : queries.texture_types) {
+        if (env.ReadTextureType(handle) != type) {
+            return false;
+        }
+    }
+    for (const auto& [handle, format] : queries.texture_pixel_formats) {
+        if (env.ReadTexturePixelFormat(handle) != format) {
+            return false;
+        }
+    }
+    for (const auto& [handle, is_integer] : queries.texture_pixel_format_integers) {
+        if (env.IsTexturePixelFormatInteger(handle) != is_integer) {
+            return false;
+        }
+    }
+    return true;
+} catch (const Shader::Exception&) {
+    // Cached environments throw on queries they haven't recorded
+    return false;
+}
+
+namespace {
+
+enum class RecordType : u32 {
+    Environment,
+    Pipeline,
+};
+
+struct RecordHeader {
+    RecordType type;
+    u32 size;
+    u64 hash;
+};
+static_assert(sizeof(RecordHeader) == 16);
+
+/// Environments stored in a cache file, so each of them is written once
+struct CacheFileState {
+    std::mutex mutex;
+    std::unordered_set<u64> environments;
+};
+
+/// Records of a mapped cache file
+struct CacheFileIndex {
+    /// Compressed environments by the hash of their uncompressed data
+    std::unordered_map<u64, std::span<const u8>> environments;
+    std::vector<std::span<const u8>> pipelines;
+    bool needs_compaction{};
+};
+
+CacheFileState& GetCacheFileState(const std::filesystem::path& filename) {
+    static std::mutex states_mutex;
+    static std::unordered_map<std::string, CacheFileState> states;
+    std::scoped_lock lock{states_mutex};
+    return states[Common::FS::PathToUTF8String(filename)];
+}
+
+template <typename T>
+void AppendObject(std::string& out, const T& object) {
+    out.append(reinterpret_cast<const char*>(&object), sizeof(object));
+}
+
+std::span<const u8> AsBytes(std::string_view data) {
+    return {reinterpret_cast<const u8*>(data.data()), data.size()};
+}
+
+void WriteRecord(std::ostream& file, RecordType type, u64 hash, std::span<const u8> payload) {
+    const RecordHeader header{
+        .type = type,
+        .size = static_cast<u32>(payload.size()),
+        .hash = hash,
+    };
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header))
+        .write(reinterpret_cast<const char*>(payload.data()), payload.size());
+}
+
+CacheFileIndex IndexCacheFile(std::span<const u8> records) {
+    CacheFileIndex index;
+    std::unordered_set<u64> pipeline_hashes;
+    size_t offset{};
+    while (offset < records.size()) {
+        RecordHeader header;
+        if (records.size() - offset < sizeof(header)) {
+            index.needs_compaction = true;
+            break;
+        }
+        std::memcpy(&header, records.data() + offset, sizeof(header));
+        offset += sizeof(header);
+        if (records.size() - offset < header.size) {
+            // Truncated record, e.g. from closing the emulator while it was written
+            index.needs_compaction = true;
+            break;
+        }
+        const std::span<const u8> payload{records.subspan(offset, header.size)};
+        offset += header.size;
+
+        switch (header.type) {
+        case RecordType::Environment:
+            if (!index.environments.try_emplace(header.hash, payload).second) {
+                index.needs_compaction = true;
+            }
+            break;
+        case RecordType::Pipeline:
+            if (pipeline_hashes.insert(header.hash).second) {
+                index.pipelines.push_back(payload);
+            } else {
+                index.needs_compaction = true;
+            }
+            break;
+        default:
+            index.needs_compaction = true;
+            break;
+        }
+    }
+    return index;
+}
+
+const std::string* FindEnvironmentData(const CacheFileIndex& index,
+                                       std::unordered_map<u64, std::string>& env_data,
+                                       u64 env_hash) {
+    if (const auto it = env_data.find(env_hash); it != env_data.end()) {
+        return &it->second;
+    }
+    const auto it = index.environments.find(env_hash);
+    if (it == index.environments.end()) {
+        return nullptr;
+    }
+    const std::vector<u8> data{Common::Compression::DecompressDataZSTD(it->second)};
+    if (data.empty()) {
+        return nullptr;
+    }
+    return &env_data.emplace(env_hash, std::string(data.begin(), data.end())).first->second;
+}
+
+/// Loads a pipeline record, returns false when its environments can't be read
+bool LoadPipeline(
+    std::span<const u8> pipeline, const CacheFileIndex& index,
+    std::unordered_map<u64, std::string>& env_data,
+    Common::UniqueFunction<void, std::istream&, FileEnvironment>& load_compute,
+    Common::UniqueFunction<void, std::istream&, std::vector<FileEnvironment>>& load_graphics) {
+    std::istringstream stream{
+        std::string(reinterpret_cast<const char*>(pipeline.data()), pipeline.size())};
+    stream.exceptions(std::ios::failbit);
+    u32 num_envs{};
+    stream.read(reinterpret_cast<char*>(&num_envs), sizeof(num_envs));
+    if (num_envs == 0 || num_envs > Maxwell::MaxShaderProgram) {
+        return false;
+    }
+    std::vector<FileEnvironment> envs(num_envs);
+    for (FileEnvironment& env : envs) {
+        u64 env_hash{};
+        stream.read(reinterpret_cast<char*>(&env_hash), sizeof(env_hash));
+        const std::string* const data{FindEnvironmentData(index, env_data, env_hash)};
+        if (!data) {
+            return false;
+        }
+        std::istringstream env_stream{*data};
+        env_stream.exceptions(std::ios::failbit);
+        env.Deserialize(env_stream);
+    }
+    if (envs.front().ShaderStage() == Shader::Stage::Compute) {
+        load_compute(stream, std::move(envs.front()));
+    } else {
+        load_graphics(stream, std::move(envs));
+    }
+    return true;
+}
+
+/// Returns the contents of a cache file holding only the given pipelines and their environments
+std::string CompactCacheFile(std::span<const u8> header, const CacheFileIndex& index,
+                             const std::unordered_map<u64, std::string>& env_data,
+                             std::span<const std::span<const u8>> pipelines) {
+    std::ostringstream file;
+    file.exceptions(std::ios::failbit);
+    file.write(reinterpret_cast<const char*>(header.data()), header.size());
+    for (const auto& [env_hash, data] : env_data) {
+        WriteRecord(file, RecordType::Environment, env_hash, index.environments.at(env_hash));
+    }
+    for (const std::span<const u8> pipeline : pipelines) {
+        const u64 hash{Common::CityHash64(reinterpret_cast<const char*>(pipeline.data()),
+                                          pipeline.size())};
+        WriteRecord(file, RecordType::Pipeline, hash, pipeline);
+    }
+    return file.str();
+}
+
+void ReplaceCacheFile(const std::filesystem::path& filename, std::string_view contents) {
+    std::filesystem::path temp_path{filename};
+    temp_path += ".tmp";
+    {
+        std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+        file.exceptions(std::ofstream::failbit);
+        file.write(contents.data(), contents.size());
+    }
+    if (!Common::FS::RemoveFile(filename) || !Common::FS::RenameFile(temp_path, filename)) {
+        Common::FS::RemoveFile(temp_path);
+        throw std::ios_base::failure("Failed to replace the pipeline cache file");
+    }
+    LOG_INFO(Common_Filesystem, "Compacted pipeline cache to {} bytes", contents.size());
+}
+
+} // Anonymous namespace
+
 void SerializePipeline(std::span<const char> key, std::span<const GenericEnvironment* const> envs,
                        const std::filesystem::path& filename, u32 cache_version) try {
+    if (!std::ranges::all_of(envs, &GenericEnvironment::CanBeSerialized)) {
+        return;
+    }
+    CacheFileState& state{GetCacheFileState(filename)};
+    std::scoped_lock lock{state.mutex};
+
     std::ofstream file(filename, std::ios::binary | std::ios::ate | std::ios::app);
     file.exceptions(std::ifstream::failbit);
     if (!file.is_open()) {
@@ -595,19 +903,34 @@ void SerializePipeline(std::span<const char> key, std::span<const GenericEnviron
         // Write header
         file.write(MAGIC_NUMBER.data(), MAGIC_NUMBER.size())
             .write(reinterpret_cast<const char*>(&cache_version), sizeof(cache_version));
+        state.environments.clear();
     }
-    if (!std::ranges::all_of(envs, &GenericEnvironment::CanBeSerialized)) {
-        return;
-    }
-    const u32 num_envs{static_cast<u32>(envs.size())};
-    file.write(reinterpret_cast<const char*>(&num_envs), sizeof(num_envs));
+    std::string pipeline;
+    AppendObject(pipeline, static_cast<u32>(envs.size()));
     for (const GenericEnvironment* const env : envs) {
-        env->Serialize(file);
+        std::ostringstream env_stream;
+        env_stream.exceptions(std::ios::failbit);
+        env->Serialize(env_stream);
+        const std::string env_data{std::move(env_stream).str()};
+        const u64 env_hash{Common::CityHash64(env_data.data(), env_data.size())};
+        if (!state.environments.contains(env_hash)) {
+            const std::vector<u8> compressed{
+                Common::Compression::CompressDataZSTDDefault(AsBytes(env_data).data(),
+                                                             env_data.size())};
+            WriteRecord(file, RecordType::Environment, env_hash, compressed);
+            state.environments.insert(env_hash);
+        }
+        AppendObject(pipeline, env_hash);
     }
-    file.write(key.data(), key.size_bytes());
+    pipeline.append(key.data(), key.size_bytes());
+    WriteRecord(file, RecordType::Pipeline, Common::CityHash64(pipeline.data(), pipeline.size()),
+                AsBytes(pipeline));
 
 } catch (const std::ios_base::failure& e) {
     LOG_ERROR(Common_Filesystem, "{}", e.what());
+    CacheFileState& state{GetCacheFileState(filename)};
+    std::scoped_lock lock{state.mutex};
+    state.environments.clear();
     if (!Common::FS::RemoveFile(filename)) {
         LOG_ERROR(Common_Filesystem, "Failed to delete pipeline cache file {}",
                   Common::FS::PathToUTF8String(filename));
@@ -616,59 +939,100 @@ void SerializePipeline(std::span<const char> key, std::span<const GenericEnviron
 
 void LoadPipelines(
     std::stop_token stop_loading, const std::filesystem::path& filename, u32 expected_cache_version,
-    Common::UniqueFunction<void, std::ifstream&, FileEnvironment> load_compute,
-    Common::UniqueFunction<void, std::ifstream&, std::vector<FileEnvironment>> load_graphics) try {
-    std::ifstream file(filename, std::ios::binary | std::ios::ate);
-    if (!file.is_open()) {
-        return;
-    }
-    file.exceptions(std::ifstream::failbit);
-    const auto end{file.tellg()};
-    file.seekg(0, std::ios::beg);
-
-    std::array<char, 8> magic_number;
-    u32 cache_version;
-    file.read(magic_number.data(), magic_number.size())
-        .read(reinterpret_cast<char*>(&cache_version), sizeof(cache_version));
-    if (magic_number != MAGIC_NUMBER || cache_version != expected_cache_version) {
-        file.close();
-        if (Common::FS::RemoveFile(filename)) {
-            if (magic_number != MAGIC_NUMBER) {
+    Common::UniqueFunction<void, std::istream&, FileEnvironment> load_compute,
+    Common::UniqueFunction<void, std::istream&, std::vector<FileEnvironment>> load_graphics) try {
+    CacheFileState& state{GetCacheFileState(filename)};
+    std::scoped_lock lock{state.mutex};
+    state.environments.clear();
+
+    bool is_invalid{};
+    std::optional<std::string> compacted;
+    {
+        const Common::FS::MappedFile file(filename);
+        if (!file.IsOpen()) {
+            return;
+        }
+        const std::span<const u8> data{file.GetSpan()};
+        if (data.size() < HEADER_SIZE) {
+            is_invalid = true;
+        } else {
+            std::array<char, 8> magic_number;
+            u32 cache_version;
+            std::memcpy(magic_number.data(), data.data(), magic_number.size());
+            std::memcpy(&cache_version, data.data() + magic_number.size(), sizeof(cache_version));
+            if (magic_number == LEGACY_MAGIC_NUMBER || cache_version != expected_cache_version) {
+                LOG_INFO(Common_Filesystem, "Deleting old pipeline cache");
+                is_invalid = true;
+            } else if (magic_number != MAGIC_NUMBER) {
                 LOG_ERROR(Common_Filesystem, "Invalid pipeline cache file");
+                is_invalid = true;
             }
-            if (cache_version != expected_cache_version) {
-                LOG_INFO(Common_Filesystem, "Deleting old pipeline cache");
+        }
+        if (!is_invalid) {
+            const CacheFileIndex index{IndexCacheFile(data.subspan(HEADER_SIZE))};
+            bool needs_compaction{index.needs_compaction};
+            for (const auto& [env_hash, env] : index.environments) {
+                state.environments.insert(env_hash);
             }
-        } else {
+
+            // Environments are decompressed once, when the first pipeline using them is loaded
+            std::unordered_map<u64, std::string> env_data;
+            std::vector<std::span<const u8>> loaded_pipelines;
+            for (const std::span<const u8> pipeline : index.pipelines) {
+                if (stop_loading.stop_requested()) {
+                    return;
+                }
+                if (!LoadPipeline(pipeline, index, env_data, load_compute, load_graphics)) {
+                    needs_compaction = true;
+                    continue;
+                }
+                loaded_pipelines.push_back(pipeline);
+            }
+            needs_compaction |= env_data.size() != index.environments.size();
+            if (needs_compaction) {
+                compacted = CompactCacheFile(data.first(HEADER_SIZE), index, env_data,
+                                             loaded_pipelines);
+                state.environments.clear();
+                for (const auto& [env_hash, env] : env_data) {
+                    state.environments.insert(env_hash);
+                }
+            }
+        }
+    }
+    if (is_invalid) {
+        if (!Common::FS::RemoveFile(filename)) {
             LOG_ERROR(Common_Filesystem,
                       "Invalid pipeline cache file and failed to delete it in \"{}\"",
                       Common::FS::PathToUTF8String(filename));
         }
         return;
     }
-    while (file.tellg() != end) {
-        if (stop_loading.stop_requested()) {
-            return;
-        }
-        u32 num_envs{};
-        file.read(reinterpret_cast<char*>(&num_envs), sizeof(num_envs));
-        std::vector<FileEnvironment> envs(num_envs);
-        for (FileEnvironment& env : envs) {
-            env.Deserialize(file);
-        }
-        if (envs.front().ShaderStage() == Shader::Stage::Compute) {
-            load_compute(file, std::move(envs.front()));
-        } else {
-            load_graphics(file, std::move(envs));
-        }
+    if (compacted) {
+        ReplaceCacheFile(filename, *compacted);
     }
 
 } catch (const std::ios_base::failure& e) {
     LOG_ERROR(Common_Filesystem, "{}", e.what());
+    CacheFileState& state{GetCacheFileState(filename)};
+    std::scoped_lock lock{state.mutex};
+    state.environments.clear();
     if (!Common::FS::RemoveFile(filename)) {
         LOG_ERROR(Common_Filesystem, "Failed to delete pipeline cache file {}",
                   Common::FS::PathToUTF8String(filename));
     }
 }
 
+void LogWorkLaneStatistics(Common::WorkLane lane, const Common::WorkLaneStatistics& statistics) {
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+    const s64 total_wait_us{duration_cast<microseconds>(statistics.total_wait).count()};
+    const s64 average_wait_us{statistics.num_started == 0
+                                  ? 0
+                                  : total_wait_us / static_cast<s64>(statistics.num_started)};
+    LOG_INFO(Render, "{} shader lane: {} started, {} queued, wait average {} us, max {} us",
+             lane == Common::WorkLane::Foreground ? "Foreground" : "Background",
+             statistics.num_started, statistics.queue_depth, average_wait_us,
+             duration_cast<microseconds>(statistics.max_wait).count());
+}
+
 } // namespace VideoCommon
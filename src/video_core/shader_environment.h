@@ -7,6 +7,7 @@
 #include <filesystem>
 #include <iosfwd>
 #include <limits>
+#include <map>
 #include <memory>
 #include <optional>
 #include <span>
@@ -16,6 +17,7 @@
 
 #include "common/common_types.h"
 #include "common/polyfill_thread.h"
+#include "common/thread_worker.h"
 #include "common/unique_function.h"
 #include "shader_recompiler/environment.h"
 #include "video_core/engines/maxwell_3d.h"
@@ -60,7 +62,7 @@ public:
 
     void Dump(u64 pipeline_hash, u64 shader_hash) override;
 
-    void Serialize(std::ofstream& file) const;
+    void Serialize(std::ostream& file) const;
 
     bool HasHLEMacroState() const override {
         return has_hle_engine_state;
@@ -165,7 +167,7 @@ public:
     FileEnvironment& operator=(const FileEnvironment&) = delete;
     FileEnvironment(const FileEnvironment&) = delete;
 
-    void Deserialize(std::ifstream& file);
+    void Deserialize(std::istream& file);
 
     [[nodiscard]] u64 ReadInstruction(u32 address) override;
 
@@ -212,6 +214,68 @@ private:
     u32 viewport_transform_state = 1;
 };
 
+/// Guest state read by the shader recompiler while translating a program. Two environments with
+/// the same code and the same answers to these queries produce the same host shader.
+struct EnvironmentQueries {
+    std::map<u64, u32> cbuf_values;
+    std::map<u32, Shader::TextureType> texture_types;
+    std::map<u32, Shader::TexturePixelFormat> texture_pixel_formats;
+    std::map<u32, bool> texture_pixel_format_integers;
+    u32 viewport_transform_state{};
+    u32 local_memory_size{};
+    u32 texture_bound{};
+};
+
+/// Forwards every query to another environment while recording the answers
+class RecordingEnvironment final : public Shader::Environment {
+public:
+    explicit RecordingEnvironment(Shader::Environment& env_);
+
+    ~RecordingEnvironment() override = default;
+
+    [[nodiscard]] u64 ReadInstruction(u32 address) override;
+
+    [[nodiscard]] u32 ReadCbufValue(u32 cbuf_index, u32 cbuf_offset) override;
+
+    [[nodiscard]] Shader::TextureType ReadTextureType(u32 handle) override;
+
+    [[nodiscard]] Shader::TexturePixelFormat ReadTexturePixelFormat(u32 handle) override;
+
+    [[nodiscard]] bool IsTexturePixelFormatInteger(u32 handle) override;
+
+    [[nodiscard]] u32 ReadViewportTransformState() override;
+
+    [[nodiscard]] u32 LocalMemorySize() const override;
+
+    [[nodiscard]] u32 SharedMemorySize() const override;
+
+    [[nodiscard]] u32 TextureBoundBuffer() const override;
+
+    [[nodiscard]] std::array<u32, 3> WorkgroupSize() const override;
+
+    [[nodiscard]] bool HasHLEMacroState() const override;
+
+    [[nodiscard]] std::optional<Shader::ReplaceConstant> GetReplaceConstBuffer(u32 bank,
+                                                                               u32 offset) override;
+
+    void Dump(u64 pipeline_hash, u64 shader_hash) override;
+
+    [[nodiscard]] const EnvironmentQueries& Queries() const noexcept {
+        return queries;
+    }
+
+private:
+    Shader::Environment& env;
+    EnvironmentQueries queries;
+};
+
+/// Returns true when the environment answers every recorded query the same way
+[[nodiscard]] bool MatchesQueries(Shader::Environment& env, const EnvironmentQueries& queries);
+
+/**
+ * Appends a pipeline to the cache file. Each environment is stored once per file, compressed, and
+ * shared by all the pipelines using it.
+ */
 void SerializePipeline(std::span<const char> key, std::span<const GenericEnvironment* const> envs,
                        const std::filesystem::path& filename, u32 cache_version);
 
@@ -224,9 +288,24 @@ void SerializePipeline(const Key& key, const Envs& envs, const std::filesystem::
                       std::span(envs.data(), envs.size()), filename, cache_version);
 }
 
+/**
+ * Loads the pipelines of a cache file, the callbacks read the pipeline key from the stream.
+ * Files holding duplicated, unreferenced or truncated records are compacted after loading.
+ */
 void LoadPipelines(
     std::stop_token stop_loading, const std::filesystem::path& filename, u32 expected_cache_version,
-    Common::UniqueFunction<void, std::ifstream&, FileEnvironment> load_compute,
-    Common::UniqueFunction<void, std::ifstream&, std::vector<FileEnvironment>> load_graphics);
+    Common::UniqueFunction<void, std::istream&, FileEnvironment> load_compute,
+    Common::UniqueFunction<void, std::istream&, std::vector<FileEnvironment>> load_graphics);
+
+void LogWorkLaneStatistics(Common::WorkLane lane, const Common::WorkLaneStatistics& statistics);
+
+/// Logs the queue depth and wait times of each lane of a shader worker
+template <typename Worker>
+void LogWorkerStatistics(Worker& worker) {
+    using Common::WorkLane;
+    for (const WorkLane lane : {WorkLane::Foreground, WorkLane::Background}) {
+        LogWorkLaneStatistics(lane, worker.GetStatistics(lane));
+    }
+}
 
 } // namespace VideoCommon
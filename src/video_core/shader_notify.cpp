@@ -1,9 +1,20 @@
 // SPDX-FileCopyrightText: Copyright 2020 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <fstream>
+#include <ios>
+#include <unordered_set>
+#include <utility>
 
+#include <fmt/format.h>
+
+#include "common/fs/fs.h"
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
+#include "common/settings.h"
 #include "video_core/shader_notify.h"
 
 using namespace std::chrono_literals;
@@ -12,6 +23,14 @@ namespace VideoCore {
 
 const auto TIME_TO_STOP_REPORTING = 2s;
 
+ShaderNotify::ShaderNotify() : profiling{Settings::values.profile_shader_compilation.GetValue()} {}
+
+ShaderNotify::~ShaderNotify() {
+    if (profiling) {
+        WriteProfileReport();
+    }
+}
+
 int ShaderNotify::ShadersBuilding() noexcept {
     const int now_complete = num_complete.load(std::memory_order::relaxed);
     const int now_building = num_building.load(std::memory_order::relaxed);
@@ -31,4 +50,64 @@ int ShaderNotify::ShadersBuilding() noexcept {
     return now_building - report_base;
 }
 
+void ShaderNotify::RecordPhases(u64 pipeline_hash,
+                                std::span<const Shader::CompileProfiler::Phase> phases) {
+    std::scoped_lock lock{profile_mutex};
+    for (const Shader::CompileProfiler::Phase& phase : phases) {
+        phase_records.push_back(PhaseRecord{pipeline_hash, phase.name, phase.time});
+    }
+}
+
+void ShaderNotify::RecordPhase(u64 pipeline_hash, std::string_view phase,
+                               std::chrono::nanoseconds time) {
+    std::scoped_lock lock{profile_mutex};
+    phase_records.push_back(PhaseRecord{pipeline_hash, phase, time});
+}
+
+void ShaderNotify::WriteProfileReport() const {
+    if (phase_records.empty()) {
+        return;
+    }
+    using PhaseTotal = std::pair<std::string_view, std::chrono::nanoseconds>;
+    std::vector<PhaseTotal> totals;
+    std::unordered_set<u64> pipelines;
+    for (const PhaseRecord& record : phase_records) {
+        pipelines.insert(record.pipeline_hash);
+        const auto it{std::ranges::find(totals, record.phase, &PhaseTotal::first)};
+        if (it != totals.end()) {
+            it->second += record.time;
+        } else {
+            totals.emplace_back(record.phase, record.time);
+        }
+    }
+    std::ranges::sort(totals, std::ranges::greater{}, &PhaseTotal::second);
+    LOG_INFO(HW_GPU, "Shader compilation profile of {} pipelines:", pipelines.size());
+    for (const auto& [phase, time] : totals) {
+        LOG_INFO(HW_GPU, "  {:<32} {:>10.3f} ms", phase,
+                 std::chrono::duration<double, std::milli>(time).count());
+    }
+
+    const auto base_dir{Common::FS::GetYuzuPath(Common::FS::YuzuPath::DumpDir)};
+    const auto shader_dir{base_dir / "shaders"};
+    if (!Common::FS::CreateDir(base_dir) || !Common::FS::CreateDir(shader_dir)) {
+        LOG_ERROR(Common_Filesystem, "Failed to create shader dump directories");
+        return;
+    }
+    const auto name{shader_dir / "compile_profile.csv"};
+    std::ofstream report_file(name, std::ios::out | std::ios::trunc);
+    if (!report_file) {
+        LOG_ERROR(Common_Filesystem, "Unable to open or create file at {}",
+                  Common::FS::PathToUTF8String(name));
+        return;
+    }
+    report_file << "pipeline,phase,microseconds\n";
+    for (const PhaseRecord& record : phase_records) {
+        report_file << fmt::format(
+            "{:016x},{},{}\n", record.pipeline_hash, record.phase,
+            std::chrono::duration_cast<std::chrono::microseconds>(record.time).count());
+    }
+    LOG_INFO(HW_GPU, "Shader compilation profile written to {}",
+             Common::FS::PathToUTF8String(name));
+}
+
 } // namespace VideoCore
@@ -5,21 +5,52 @@
 
 #include <atomic>
 #include <chrono>
+#include <mutex>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "common/common_types.h"
+#include "common/perf_metrics.h"
+#include "shader_recompiler/compile_profiler.h"
 
 namespace VideoCore {
 class ShaderNotify {
 public:
+    ShaderNotify();
+    ~ShaderNotify();
+
     [[nodiscard]] int ShadersBuilding() noexcept;
 
     void MarkShaderComplete() noexcept {
         ++num_complete;
+        Common::PerfMetrics::Add(Common::PerfMetrics::Counter::PipelinesBuilt, 1);
     }
 
     void MarkShaderBuilding() noexcept {
         ++num_building;
     }
 
+    /// Returns true when compilation phases are being recorded
+    [[nodiscard]] bool IsProfiling() const noexcept {
+        return profiling;
+    }
+
+    /// Records the time spent in the compilation phases of a pipeline
+    void RecordPhases(u64 pipeline_hash, std::span<const Shader::CompileProfiler::Phase> phases);
+
+    /// Records the time spent in a single compilation phase of a pipeline
+    void RecordPhase(u64 pipeline_hash, std::string_view phase, std::chrono::nanoseconds time);
+
 private:
+    struct PhaseRecord {
+        u64 pipeline_hash;
+        std::string_view phase;
+        std::chrono::nanoseconds time;
+    };
+
+    void WriteProfileReport() const;
+
     std::atomic_int num_building{};
     std::atomic_int num_complete{};
     int report_base{};
@@ -27,5 +58,9 @@ private:
     bool completed{};
     int num_when_completed{};
     std::chrono::steady_clock::time_point complete_time;
+
+    bool profiling{};
+    std::mutex profile_mutex;
+    std::vector<PhaseRecord> phase_records;
 };
 } // namespace VideoCore
@@ -1,6 +1,7 @@
 // SPDX-FileCopyrightText: Copyright 2020 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include <array>
 #include <bit>
 
@@ -66,4 +67,48 @@ BlockLinearSwizzle3DParams MakeBlockLinearSwizzle3DParams(const SwizzleParameter
     };
 }
 
+boost::container::small_vector<BlockLinearUnswizzleLevel, 16> MakeBlockLinearUnswizzleLevels(
+    std::span<const SwizzleParameters> swizzles, const ImageInfo& info) {
+    const u32 bytes_per_block = BytesPerBlock(info.format);
+    const u32 num_layers = static_cast<u32>(info.resources.layers);
+    boost::container::small_vector<BlockLinearUnswizzleLevel, 16> levels;
+    u32 host_offset = 0;
+    for (const SwizzleParameters& swizzle : swizzles) {
+        const Extent3D num_tiles = swizzle.num_tiles;
+        const auto params = MakeBlockLinearSwizzle3DParams(swizzle, info);
+        const u32 row_size = num_tiles.width * bytes_per_block;
+        const u32 layer_size = row_size * num_tiles.height * num_tiles.depth;
+        levels.push_back(BlockLinearUnswizzleLevel{
+            .guest_offset = static_cast<u32>(swizzle.buffer_offset),
+            .host_offset = host_offset,
+            .row_size = row_size,
+            .height = num_tiles.height,
+            .layer_size = layer_size,
+            .slice_size = params.slice_size,
+            .block_size = params.block_size,
+            .x_shift = params.x_shift,
+            .block_height = params.block_height,
+            .block_depth = params.block_depth,
+        });
+        host_offset += layer_size * num_layers;
+    }
+    return levels;
+}
+
+BlockLinearUnswizzleParams MakeBlockLinearUnswizzleParams(
+    std::span<const BlockLinearUnswizzleLevel> levels, const ImageInfo& info) {
+    // Sectors of 16 bytes are contiguous in both layouts, copy as much of them as rows allow
+    u32 unit_log2 = 4;
+    for (const BlockLinearUnswizzleLevel& level : levels) {
+        unit_log2 = std::min(unit_log2, static_cast<u32>(std::countr_zero(level.row_size)));
+    }
+    const BlockLinearUnswizzleLevel& last = levels.back();
+    return BlockLinearUnswizzleParams{
+        .num_levels = static_cast<u32>(levels.size()),
+        .layer_stride = info.layer_stride,
+        .unit_log2 = unit_log2,
+        .total_size = last.host_offset + last.layer_size * static_cast<u32>(info.resources.layers),
+    };
+}
+
 } // namespace VideoCommon::Accelerated
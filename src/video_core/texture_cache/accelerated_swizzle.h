@@ -4,6 +4,9 @@
 #pragma once
 
 #include <array>
+#include <span>
+
+#include <boost/container/small_vector.hpp>
 
 #include "common/common_types.h"
 #include "video_core/texture_cache/image_info.h"
@@ -35,10 +38,37 @@ struct BlockLinearSwizzle3DParams {
     u32 block_depth_mask;
 };
 
+/// Layout of a level for the buffer unswizzle pass, the shader reads them from a buffer
+struct BlockLinearUnswizzleLevel {
+    u32 guest_offset; ///< Offset of the level in the swizzled image.
+    u32 host_offset;  ///< Offset of the level in the linear buffer.
+    u32 row_size;     ///< Bytes of a row of blocks in the linear buffer.
+    u32 height;       ///< Rows of blocks in a slice.
+    u32 layer_size;   ///< Bytes of a layer of the level in the linear buffer.
+    u32 slice_size;
+    u32 block_size;
+    u32 x_shift;
+    u32 block_height;
+    u32 block_depth;
+};
+
+struct BlockLinearUnswizzleParams {
+    u32 num_levels;
+    u32 layer_stride;
+    u32 unit_log2; ///< Bytes copied by each invocation, rows unaligned to words copy bytes.
+    u32 total_size;
+};
+
 [[nodiscard]] BlockLinearSwizzle2DParams MakeBlockLinearSwizzle2DParams(
     const SwizzleParameters& swizzle, const ImageInfo& info);
 
 [[nodiscard]] BlockLinearSwizzle3DParams MakeBlockLinearSwizzle3DParams(
     const SwizzleParameters& swizzle, const ImageInfo& info);
 
+[[nodiscard]] boost::container::small_vector<BlockLinearUnswizzleLevel, 16>
+MakeBlockLinearUnswizzleLevels(std::span<const SwizzleParameters> swizzles, const ImageInfo& info);
+
+[[nodiscard]] BlockLinearUnswizzleParams MakeBlockLinearUnswizzleParams(
+    std::span<const BlockLinearUnswizzleLevel> levels, const ImageInfo& info);
+
 } // namespace VideoCommon::Accelerated
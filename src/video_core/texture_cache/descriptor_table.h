@@ -4,6 +4,7 @@
 #pragma once
 
 #include <algorithm>
+#include <optional>
 #include <vector>
 
 #include "common/common_types.h"
@@ -30,6 +31,11 @@ public:
 
     [[nodiscard]] std::pair<Descriptor, bool> Read(u32 index) {
         DEBUG_ASSERT(index <= current_limit);
+        // While the table is tracked, descriptors read since the last write to its memory can't
+        // have changed
+        if (is_tracked && read_generations[index] == generation && IsDescriptorRead(index)) {
+            return {descriptors[index], false};
+        }
         const GPUVAddr gpu_addr = current_gpu_addr + index * sizeof(Descriptor);
         std::pair<Descriptor, bool> result;
         gpu_memory.ReadBlockUnsafe(gpu_addr, &result.first, sizeof(Descriptor));
@@ -42,9 +48,58 @@ public:
         if (result.second) {
             descriptors[index] = result.first;
         }
+        if (is_tracked) {
+            read_generations[index] = generation;
+        }
         return result;
     }
 
+    /// Returns the device address of the table, if it's contiguous in device memory
+    [[nodiscard]] std::optional<DAddr> DeviceAddress() const {
+        if (!gpu_memory.IsContinuousRange(current_gpu_addr, SizeBytes())) {
+            return std::nullopt;
+        }
+        return gpu_memory.GpuToCpuAddress(current_gpu_addr);
+    }
+
+    /// Marks the table as tracked at the given device address, the caller has to report writes
+    /// to its memory with Untrack
+    void Track(DAddr device_addr) noexcept {
+        is_tracked = true;
+        tracked_addr = device_addr;
+        tracked_size = SizeBytes();
+    }
+
+    /// Stops tracking the table, descriptors are read again from guest memory
+    void Untrack() noexcept {
+        is_tracked = false;
+        ++generation;
+    }
+
+    [[nodiscard]] bool IsTracked() const noexcept {
+        return is_tracked;
+    }
+
+    [[nodiscard]] bool Overlaps(DAddr device_addr, size_t size) const noexcept {
+        return device_addr < tracked_addr + tracked_size && tracked_addr < device_addr + size;
+    }
+
+    [[nodiscard]] DAddr TrackedAddress() const noexcept {
+        return tracked_addr;
+    }
+
+    [[nodiscard]] size_t TrackedSize() const noexcept {
+        return tracked_size;
+    }
+
+    [[nodiscard]] GPUVAddr GpuAddr() const noexcept {
+        return current_gpu_addr;
+    }
+
+    [[nodiscard]] size_t SizeBytes() const noexcept {
+        return (static_cast<size_t>(current_limit) + 1) * sizeof(Descriptor);
+    }
+
     [[nodiscard]] u32 Limit() const noexcept {
         return current_limit;
     }
@@ -58,6 +113,7 @@ private:
         read_descriptors.clear();
         read_descriptors.resize(Common::DivCeil(num_descriptors, 64U), 0);
         descriptors.resize(num_descriptors);
+        read_generations.resize(num_descriptors);
     }
 
     void MarkDescriptorAsRead(u32 index) noexcept {
@@ -73,6 +129,13 @@ private:
     u32 current_limit{};
     std::vector<u64> read_descriptors;
     std::vector<Descriptor> descriptors;
+
+    /// Tracked tables skip guest memory reads of descriptors read in the current generation
+    bool is_tracked{};
+    DAddr tracked_addr{};
+    size_t tracked_size{};
+    u64 generation{1};
+    std::vector<u64> read_generations;
 };
 
 } // namespace VideoCommon
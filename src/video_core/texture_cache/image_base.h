@@ -42,6 +42,8 @@ enum class ImageFlagBits : u32 {
 
     AsynchronousDecode = 1 << 16,
     IsDecoding = 1 << 17, ///< Is currently being decoded asynchronously.
+
+    PendingDownload = 1 << 18, ///< Queued for a preemptive download on the next async flush.
 };
 DECLARE_ENUM_FLAG_OPERATORS(ImageFlagBits)
 
@@ -136,7 +138,6 @@ struct ImageMapView {
     VAddr cpu_addr;
     size_t size;
     ImageId image_id;
-    bool picked{};
 };
 
 struct ImageAllocBase {
@@ -0,0 +1,156 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "common/common_types.h"
+#include "common/hash.h"
+
+namespace VideoCommon {
+
+/**
+ * Index of address ranges bucketed by size class.
+ * Each range is stored in the buckets of the smallest class whose buckets are at least as large
+ * as the range, so it lives in at most two buckets. Ranges are kept next to their ids, so lookups
+ * filter out the ranges that don't overlap them without touching the objects they belong to.
+ */
+template <typename Id>
+class SpatialIndex {
+    static constexpr u32 MIN_BUCKET_BITS = 16;
+    static constexpr u32 CLASS_STEP_BITS = 4;
+    static constexpr size_t NUM_CLASSES = 4;
+
+    struct Entry {
+        u64 addr;
+        u64 last_addr;
+        Id id;
+    };
+    using BucketMap = std::unordered_map<u64, std::vector<Entry>, Common::IdentityHash<u64>>;
+
+public:
+    /// Adds a range to the index, the same id may be added multiple times for different ranges
+    void Insert(u64 addr, size_t size, Id id) {
+        const size_t size_class = SizeClass(size);
+        BucketMap& buckets = classes[size_class];
+        const Entry entry{addr, LastAddr(addr, size), id};
+        ForEachBucket(size_class, addr, size,
+                      [&buckets, &entry](u64 bucket) { buckets[bucket].push_back(entry); });
+    }
+
+    /// Removes a range added with the same arguments, returns false when it wasn't in the index
+    bool Erase(u64 addr, size_t size, Id id) {
+        const size_t size_class = SizeClass(size);
+        BucketMap& buckets = classes[size_class];
+        bool found = true;
+        ForEachBucket(size_class, addr, size, [&buckets, &found, addr, id](u64 bucket) {
+            const auto it = buckets.find(bucket);
+            if (it == buckets.end()) {
+                found = false;
+                return;
+            }
+            std::vector<Entry>& entries = it->second;
+            const auto entry_it = std::ranges::find_if(entries, [addr, id](const Entry& entry) {
+                return entry.id == id && entry.addr == addr;
+            });
+            if (entry_it == entries.end()) {
+                found = false;
+                return;
+            }
+            entries.erase(entry_it);
+            if (entries.empty()) {
+                buckets.erase(it);
+            }
+        });
+        return found;
+    }
+
+    /**
+     * Calls func once for the id of each range overlapping the given region.
+     * Iteration stops when func returns true. The index must not be modified from func.
+     */
+    template <typename Func>
+    void ForEach(u64 addr, size_t size, Func&& func) const {
+        using FuncReturn = std::invoke_result_t<Func, Id>;
+        static constexpr bool BOOL_BREAK = std::is_same_v<FuncReturn, bool>;
+        const u64 last_addr = LastAddr(addr, size);
+        for (size_t size_class = 0; size_class < NUM_CLASSES; ++size_class) {
+            const BucketMap& buckets = classes[size_class];
+            if (buckets.empty()) {
+                continue;
+            }
+            const u32 bucket_bits = BucketBits(size_class);
+            const u64 first_bucket = addr >> bucket_bits;
+            const u64 last_bucket = last_addr >> bucket_bits;
+            const auto visit = [&](u64 bucket, const std::vector<Entry>& entries) {
+                for (const Entry& entry : entries) {
+                    if (entry.addr > last_addr || entry.last_addr < addr) {
+                        continue;
+                    }
+                    // Ranges spanning two buckets are only reported from the first one visited
+                    if (bucket != std::max(entry.addr >> bucket_bits, first_bucket)) {
+                        continue;
+                    }
+                    if constexpr (BOOL_BREAK) {
+                        if (func(entry.id)) {
+                            return true;
+                        }
+                    } else {
+                        func(entry.id);
+                    }
+                }
+                return false;
+            };
+            if (last_bucket - first_bucket >= buckets.size()) {
+                // The region covers more buckets than this class uses, walk the used ones instead
+                for (const auto& [bucket, entries] : buckets) {
+                    if (bucket >= first_bucket && bucket <= last_bucket && visit(bucket, entries)) {
+                        return;
+                    }
+                }
+                continue;
+            }
+            for (u64 bucket = first_bucket; bucket <= last_bucket; ++bucket) {
+                const auto it = buckets.find(bucket);
+                if (it != buckets.end() && visit(bucket, it->second)) {
+                    return;
+                }
+            }
+        }
+    }
+
+private:
+    static constexpr u32 BucketBits(size_t size_class) {
+        return MIN_BUCKET_BITS + static_cast<u32>(size_class) * CLASS_STEP_BITS;
+    }
+
+    static constexpr u64 LastAddr(u64 addr, size_t size) {
+        return addr + std::max<size_t>(size, 1) - 1;
+    }
+
+    static constexpr size_t SizeClass(size_t size) {
+        size_t size_class = 0;
+        while (size_class + 1 < NUM_CLASSES && size > (u64{1} << BucketBits(size_class))) {
+            ++size_class;
+        }
+        return size_class;
+    }
+
+    template <typename Func>
+    static void ForEachBucket(size_t size_class, u64 addr, size_t size, Func&& func) {
+        const u32 bucket_bits = BucketBits(size_class);
+        const u64 last_bucket = LastAddr(addr, size) >> bucket_bits;
+        for (u64 bucket = addr >> bucket_bits; bucket <= last_bucket; ++bucket) {
+            func(bucket);
+        }
+    }
+
+    std::array<BucketMap, NUM_CLASSES> classes;
+};
+
+} // namespace VideoCommon
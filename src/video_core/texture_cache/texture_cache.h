@@ -3,10 +3,12 @@
 
 #pragma once
 
+#include <chrono>
 #include <unordered_set>
 #include <boost/container/small_vector.hpp>
 
 #include "common/alignment.h"
+#include "common/perf_metrics.h"
 #include "common/settings.h"
 #include "video_core/control/channel_state.h"
 #include "video_core/dirty_flags.h"
@@ -29,7 +31,8 @@ using namespace Common::Literals;
 
 template <class P>
 TextureCache<P>::TextureCache(Runtime& runtime_, Tegra::MaxwellDeviceMemoryManager& device_memory_)
-    : runtime{runtime_}, device_memory{device_memory_} {
+    : runtime{runtime_}, device_memory{device_memory_},
+      trace_recorder{CacheTraceRecorder::CreateIfEnabled("texture_cache")} {
     // Configure null sampler
     TSCEntry sampler_descriptor{};
     sampler_descriptor.min_filter.Assign(Tegra::Texture::TextureFilter::Linear);
@@ -77,18 +80,28 @@ void TextureCache<P>::RunGarbageCollector() {
     u64 ticks_to_destroy = 0;
     size_t num_iterations = 0;
 
+    // Collection is incremental, whatever doesn't fit in this frame's budget is left for the next
+    const auto start_time = std::chrono::steady_clock::now();
+    auto deadline = start_time;
+    const u64 start_memory = total_used_memory;
+    size_t num_collected = 0;
+
     const auto Configure = [&](bool allow_aggressive) {
         high_priority_mode = total_used_memory >= expected_memory;
         aggressive_mode = allow_aggressive && total_used_memory >= critical_memory;
         ticks_to_destroy = aggressive_mode ? 10ULL : high_priority_mode ? 25ULL : 50ULL;
         num_iterations = aggressive_mode ? 40 : (high_priority_mode ? 20 : 10);
+        deadline = start_time + (aggressive_mode ? std::chrono::microseconds{4000}
+                                                 : std::chrono::microseconds{1000});
     };
-    const auto Cleanup = [this, &num_iterations, &high_priority_mode,
-                          &aggressive_mode](ImageId image_id) {
-        if (num_iterations == 0) {
+    // Images written by the GPU have to be downloaded before they are deleted, making them far
+    // more expensive to collect than sampled images, which are reloaded from guest memory.
+    // They are kept as a separate generation, only collected when sampled images weren't enough.
+    const auto Cleanup = [this, &num_iterations, &high_priority_mode, &aggressive_mode, &deadline,
+                          &num_collected](ImageId image_id, bool collect_gpu_modified) {
+        if (num_iterations == 0 || std::chrono::steady_clock::now() >= deadline) {
             return true;
         }
-        --num_iterations;
         auto& image = slot_images[image_id];
         if (True(image.flags & ImageFlagBits::IsDecoding)) {
             // This image is still being decoded, deleting it will invalidate the slot
@@ -100,22 +113,23 @@ void TextureCache<P>::RunGarbageCollector() {
         }
         const bool must_download =
             image.IsSafeDownload() && False(image.flags & ImageFlagBits::BadOverlap);
-        if (!high_priority_mode && must_download) {
+        if (must_download && !collect_gpu_modified) {
             return false;
         }
+        --num_iterations;
         if (must_download) {
             auto map = runtime.DownloadStagingBuffer(image.unswizzled_size_bytes);
             const auto copies = FullDownloadCopies(image.info);
             image.DownloadMemory(map, copies);
             runtime.Finish();
-            SwizzleImage(*gpu_memory, image.gpu_addr, image.info, copies, map.mapped_span,
-                         swizzle_data_buffer);
+            SwizzleDownloadedImage(image, copies, map.mapped_span);
         }
         if (True(image.flags & ImageFlagBits::Tracked)) {
             UntrackImage(image, image_id);
         }
         UnregisterImage(image_id);
         DeleteImage(image_id, image.scale_tick > frame_tick + 5);
+        ++num_collected;
         if (total_used_memory < critical_memory) {
             if (aggressive_mode) {
                 // Sink the aggresiveness.
@@ -130,26 +144,55 @@ void TextureCache<P>::RunGarbageCollector() {
         }
         return false;
     };
+    const auto Collect = [&] {
+        lru_cache.ForEachItemBelow(frame_tick - ticks_to_destroy,
+                                   [&](ImageId image_id) { return Cleanup(image_id, false); });
+        if (high_priority_mode) {
+            lru_cache.ForEachItemBelow(frame_tick - ticks_to_destroy,
+                                       [&](ImageId image_id) { return Cleanup(image_id, true); });
+        }
+    };
 
     // Try to remove anything old enough and not high priority.
     Configure(false);
-    lru_cache.ForEachItemBelow(frame_tick - ticks_to_destroy, Cleanup);
+    Collect();
 
     // If pressure is still too high, prune aggressively.
     if (total_used_memory >= critical_memory) {
         Configure(true);
-        lru_cache.ForEachItemBelow(frame_tick - ticks_to_destroy, Cleanup);
+        Collect();
+    }
+
+    if (num_collected > 0) {
+        Common::PerfMetrics::Add(Common::PerfMetrics::Counter::TextureEvictions, num_collected);
+        const auto elapsed = std::chrono::steady_clock::now() - start_time;
+        const u64 collected_bytes = start_memory - std::min(start_memory, total_used_memory);
+        LOG_DEBUG(HW_GPU, "Collected {} images ({} KiB) in {} us", num_collected,
+                  collected_bytes / 1024,
+                  std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
     }
 }
 
 template <class P>
 void TextureCache<P>::TickFrame() {
-    // If we can obtain the memory info, use it instead of the estimate.
-    if (runtime.CanReportMemoryUsage()) {
+    if (memory_budget) {
+        // Thresholds are this cache's share of the budget, measured against its own usage
+        memory_budget->ReportUsage(MemoryBudgetClient::TextureCache, total_used_memory);
+        const MemoryBudgetShare& share = memory_budget->GetShare(MemoryBudgetClient::TextureCache);
+        minimum_memory = share.minimum;
+        expected_memory = share.expected;
+        critical_memory = share.critical;
+    } else if (runtime.CanReportMemoryUsage()) {
+        // If we can obtain the memory info, use it instead of the estimate.
         total_used_memory = runtime.GetDeviceMemoryUsage();
     }
     if (total_used_memory > minimum_memory) {
         RunGarbageCollector();
+        // Release the storage left empty by the collected objects
+        slot_images.Compact();
+        slot_image_views.Compact();
+        slot_image_allocs.Compact();
+        slot_map_views.Compact();
     }
     sentenced_images.Tick();
     sentenced_framebuffers.Tick();
@@ -192,12 +235,20 @@ void TextureCache<P>::MarkModification(ImageId id) noexcept {
 template <class P>
 template <bool has_blacklists>
 void TextureCache<P>::FillGraphicsImageViews(std::span<ImageViewInOut> views) {
+    if (trace_recorder) {
+        trace_recorder->Record(CacheTraceOp::TextureFillGraphicsImageViews, 0, 0,
+                               static_cast<u32>(views.size()));
+    }
     FillImageViews<has_blacklists>(channel_state->graphics_image_table,
                                    channel_state->graphics_image_view_ids, views);
 }
 
 template <class P>
 void TextureCache<P>::FillComputeImageViews(std::span<ImageViewInOut> views) {
+    if (trace_recorder) {
+        trace_recorder->Record(CacheTraceOp::TextureFillComputeImageViews, 0, 0,
+                               static_cast<u32>(views.size()));
+    }
     FillImageViews<true>(channel_state->compute_image_table, channel_state->compute_image_view_ids,
                          views);
 }
@@ -296,12 +347,12 @@ void TextureCache<P>::SynchronizeGraphicsDescriptors() {
     const bool linked_tsc = maxwell3d->regs.sampler_binding == SamplerBinding::ViaHeaderBinding;
     const u32 tic_limit = maxwell3d->regs.tex_header.limit;
     const u32 tsc_limit = linked_tsc ? tic_limit : maxwell3d->regs.tex_sampler.limit;
-    if (channel_state->graphics_sampler_table.Synchronize(maxwell3d->regs.tex_sampler.Address(),
-                                                          tsc_limit)) {
+    if (SynchronizeDescriptorTable(channel_state->graphics_sampler_table,
+                                   maxwell3d->regs.tex_sampler.Address(), tsc_limit)) {
         channel_state->graphics_sampler_ids.resize(tsc_limit + 1, CORRUPT_ID);
     }
-    if (channel_state->graphics_image_table.Synchronize(maxwell3d->regs.tex_header.Address(),
-                                                        tic_limit)) {
+    if (SynchronizeDescriptorTable(channel_state->graphics_image_table,
+                                   maxwell3d->regs.tex_header.Address(), tic_limit)) {
         channel_state->graphics_image_view_ids.resize(tic_limit + 1, CORRUPT_ID);
     }
 }
@@ -312,11 +363,11 @@ void TextureCache<P>::SynchronizeComputeDescriptors() {
     const u32 tic_limit = kepler_compute->regs.tic.limit;
     const u32 tsc_limit = linked_tsc ? tic_limit : kepler_compute->regs.tsc.limit;
     const GPUVAddr tsc_gpu_addr = kepler_compute->regs.tsc.Address();
-    if (channel_state->compute_sampler_table.Synchronize(tsc_gpu_addr, tsc_limit)) {
+    if (SynchronizeDescriptorTable(channel_state->compute_sampler_table, tsc_gpu_addr, tsc_limit)) {
         channel_state->compute_sampler_ids.resize(tsc_limit + 1, CORRUPT_ID);
     }
-    if (channel_state->compute_image_table.Synchronize(kepler_compute->regs.tic.Address(),
-                                                       tic_limit)) {
+    if (SynchronizeDescriptorTable(channel_state->compute_image_table,
+                                   kepler_compute->regs.tic.Address(), tic_limit)) {
         channel_state->compute_image_view_ids.resize(tic_limit + 1, CORRUPT_ID);
     }
 }
@@ -419,6 +470,9 @@ bool TextureCache<P>::RescaleRenderTargets() {
 
 template <class P>
 void TextureCache<P>::UpdateRenderTargets(bool is_clear) {
+    if (trace_recorder) {
+        trace_recorder->Record(CacheTraceOp::TextureUpdateRenderTargets, 0, 0, is_clear ? 1 : 0);
+    }
     using namespace VideoCommon::Dirty;
     auto& flags = maxwell3d->dirty.flags;
     if (!flags[Dirty::RenderTargets]) {
@@ -513,6 +567,49 @@ ImageViewId TextureCache<P>::VisitImageView(DescriptorTable<TICEntry>& table,
     return image_view_id;
 }
 
+template <class P>
+template <typename Descriptor>
+bool TextureCache<P>::SynchronizeDescriptorTable(DescriptorTable<Descriptor>& table,
+                                                 GPUVAddr gpu_addr, u32 limit) {
+    const bool has_changed = table.Synchronize(gpu_addr, limit);
+    if (has_changed) {
+        UntrackDescriptorTable(table);
+    }
+    if (table.IsTracked()) {
+        return has_changed;
+    }
+    // Writes to tracked pages are reported through WriteMemory, so unchanged descriptors don't
+    // have to be read and compared again on every draw
+    const std::optional<DAddr> device_addr = table.DeviceAddress();
+    if (device_addr) {
+        device_memory.UpdatePagesCachedCount(*device_addr, table.SizeBytes(), 1);
+        table.Track(*device_addr);
+    }
+    return has_changed;
+}
+
+template <class P>
+template <typename Descriptor>
+void TextureCache<P>::UntrackDescriptorTable(DescriptorTable<Descriptor>& table) {
+    if (!table.IsTracked()) {
+        return;
+    }
+    device_memory.UpdatePagesCachedCount(table.TrackedAddress(), table.TrackedSize(), -1);
+    table.Untrack();
+}
+
+template <class P>
+template <typename Func>
+void TextureCache<P>::ForEachDescriptorTable(Func&& func) {
+    for (size_t c : active_channel_ids) {
+        auto& channel_info = channel_storage[c];
+        func(channel_info, channel_info.graphics_image_table);
+        func(channel_info, channel_info.graphics_sampler_table);
+        func(channel_info, channel_info.compute_image_table);
+        func(channel_info, channel_info.compute_sampler_table);
+    }
+}
+
 template <class P>
 FramebufferId TextureCache<P>::GetFramebufferId(const RenderTargets& key) {
     const auto [pair, is_new] = framebuffers.try_emplace(key);
@@ -531,6 +628,14 @@ FramebufferId TextureCache<P>::GetFramebufferId(const RenderTargets& key) {
 
 template <class P>
 void TextureCache<P>::WriteMemory(DAddr cpu_addr, size_t size) {
+    if (trace_recorder) {
+        trace_recorder->Record(CacheTraceOp::TextureWriteMemory, cpu_addr, size);
+    }
+    ForEachDescriptorTable([&](TextureCacheChannelInfo&, auto& table) {
+        if (table.IsTracked() && table.Overlaps(cpu_addr, size)) {
+            UntrackDescriptorTable(table);
+        }
+    });
     ForEachImageInRegion(cpu_addr, size, [this](ImageId image_id, Image& image) {
         if (True(image.flags & ImageFlagBits::CpuModified)) {
             return;
@@ -544,6 +649,9 @@ void TextureCache<P>::WriteMemory(DAddr cpu_addr, size_t size) {
 
 template <class P>
 void TextureCache<P>::DownloadMemory(DAddr cpu_addr, size_t size) {
+    if (trace_recorder) {
+        trace_recorder->Record(CacheTraceOp::TextureDownloadMemory, cpu_addr, size);
+    }
     boost::container::small_vector<ImageId, 16> images;
     ForEachImageInRegion(cpu_addr, size, [&images](ImageId image_id, ImageBase& image) {
         if (!image.IsSafeDownload()) {
@@ -555,6 +663,12 @@ void TextureCache<P>::DownloadMemory(DAddr cpu_addr, size_t size) {
     if (images.empty()) {
         return;
     }
+    if constexpr (IMPLEMENTS_ASYNC_DOWNLOADS) {
+        // The CPU had to wait for these images, download them ahead of time once they are written
+        for (const ImageId image_id : images) {
+            MarkPreemptiveDownload(slot_images[image_id]);
+        }
+    }
     std::ranges::sort(images, [this](ImageId lhs, ImageId rhs) {
         return slot_images[lhs].modification_tick < slot_images[rhs].modification_tick;
     });
@@ -564,8 +678,7 @@ void TextureCache<P>::DownloadMemory(DAddr cpu_addr, size_t size) {
         const auto copies = FullDownloadCopies(image.info);
         image.DownloadMemory(map, copies);
         runtime.Finish();
-        SwizzleImage(*gpu_memory, image.gpu_addr, image.info, copies, map.mapped_span,
-                     swizzle_data_buffer);
+        SwizzleDownloadedImage(image, copies, map.mapped_span);
     }
 }
 
@@ -585,18 +698,22 @@ std::optional<VideoCore::RasterizerDownloadArea> TextureCache<P>::GetFlushArea(D
         }
         area->start_address = std::min(area->start_address, image.cpu_addr);
         area->end_address = std::max(area->end_address, image.cpu_addr_end);
-        for (auto image_view_id : image.image_view_ids) {
-            auto& image_view = slot_image_views[image_view_id];
-            image_view.flags |= ImageViewFlagBits::PreemtiveDownload;
-        }
         area->preemtive &= image.info.forced_flushed;
-        image.info.forced_flushed = true;
+        MarkPreemptiveDownload(image);
     });
     return area;
 }
 
 template <class P>
 void TextureCache<P>::UnmapMemory(DAddr cpu_addr, size_t size) {
+    if (trace_recorder) {
+        trace_recorder->Record(CacheTraceOp::TextureUnmapMemory, cpu_addr, size);
+    }
+    ForEachDescriptorTable([&](TextureCacheChannelInfo&, auto& table) {
+        if (table.IsTracked() && table.Overlaps(cpu_addr, size)) {
+            UntrackDescriptorTable(table);
+        }
+    });
     boost::container::small_vector<ImageId, 16> deleted_images;
     ForEachImageInRegion(cpu_addr, size, [&](ImageId id, Image&) { deleted_images.push_back(id); });
     for (const ImageId id : deleted_images) {
@@ -611,6 +728,18 @@ void TextureCache<P>::UnmapMemory(DAddr cpu_addr, size_t size) {
 
 template <class P>
 void TextureCache<P>::UnmapGPUMemory(size_t as_id, GPUVAddr gpu_addr, size_t size) {
+    if (trace_recorder) {
+        trace_recorder->Record(CacheTraceOp::TextureUnmapGPUMemory, gpu_addr, size,
+                               static_cast<u32>(as_id));
+    }
+    // Tables are tracked by device address, which changes with the mapping
+    ForEachDescriptorTable([&](TextureCacheChannelInfo& channel_info, auto& table) {
+        const GPUVAddr table_addr = table.GpuAddr();
+        if (table.IsTracked() && channel_info.gpu_memory.GetID() == as_id &&
+            table_addr < gpu_addr + size && gpu_addr < table_addr + table.TrackedSize()) {
+            UntrackDescriptorTable(table);
+        }
+    });
     boost::container::small_vector<ImageId, 16> deleted_images;
     ForEachImageInRegionGPU(as_id, gpu_addr, size,
                             [&](ImageId id, Image&) { deleted_images.push_back(id); });
@@ -732,22 +861,20 @@ template <class P>
 std::pair<typename P::ImageView*, bool> TextureCache<P>::TryFindFramebufferImageView(
     const Tegra::FramebufferConfig& config, DAddr cpu_addr) {
     // TODO: Properly implement this
-    const auto it = page_table.find(cpu_addr >> YUZU_PAGEBITS);
-    if (it == page_table.end()) {
-        return {};
-    }
-    const auto& image_map_ids = it->second;
     boost::container::small_vector<ImageId, 4> valid_image_ids;
-    for (const ImageMapId map_id : image_map_ids) {
+    image_map_index.ForEach(cpu_addr, 1, [&](ImageMapId map_id) {
         const ImageMapView& map = slot_map_views[map_id];
         const ImageBase& image = slot_images[map.image_id];
         if (image.cpu_addr != cpu_addr) {
-            continue;
+            return;
         }
         if (image.image_view_ids.empty()) {
-            continue;
+            return;
         }
         valid_image_ids.push_back(map.image_id);
+    });
+    if (valid_image_ids.empty()) {
+        return {};
     }
 
     const auto view_format = [&]() {
@@ -787,6 +914,47 @@ std::pair<typename P::ImageView*, bool> TextureCache<P>::TryFindFramebufferImage
     return {};
 }
 
+template <class P>
+bool TextureCache<P>::IsVideoFrameCached(const VideoCore::VideoFrameSurface& surface) {
+    return static_cast<bool>(FindVideoFrameImage(surface));
+}
+
+template <class P>
+bool TextureCache<P>::WriteVideoFrame(const VideoCore::VideoFrameSurface& surface,
+                                      std::span<const u8> pixels) {
+    const ImageId image_id = FindVideoFrameImage(surface);
+    if (!image_id) {
+        return false;
+    }
+    // The frame replaces the whole image, the stale guest memory contents are never uploaded
+    PrepareImage(image_id, true, true);
+
+    auto staging = runtime.UploadStagingBuffer(pixels.size_bytes());
+    std::memcpy(staging.mapped_span.data(), pixels.data(), pixels.size_bytes());
+    const BufferImageCopy copy{
+        .buffer_offset = 0,
+        .buffer_size = pixels.size_bytes(),
+        .buffer_row_length = surface.width,
+        .buffer_image_height = surface.height,
+        .image_subresource =
+            {
+                .base_level = 0,
+                .base_layer = 0,
+                .num_layers = 1,
+            },
+        .image_offset = {0, 0, 0},
+        .image_extent =
+            {
+                .width = surface.width,
+                .height = surface.height,
+                .depth = 1,
+            },
+    };
+    slot_images[image_id].UploadMemory(staging, std::span{&copy, 1});
+    runtime.InsertUploadMemoryBarrier();
+    return true;
+}
+
 template <class P>
 bool TextureCache<P>::HasUncommittedFlushes() const noexcept {
     return !uncommitted_downloads.empty();
@@ -826,6 +994,7 @@ void TextureCache<P>::CommitAsyncFlushes() {
             for (const PendingDownload& download_info : download_ids) {
                 if (download_info.is_swizzle) {
                     Image& image = slot_images[download_info.object_id];
+                    image.flags &= ~ImageFlagBits::PendingDownload;
                     const auto copies = FullDownloadCopies(image.info);
                     image.DownloadMemory(download_map, copies);
                     download_map.offset += Common::AlignUp(image.unswizzled_size_bytes, 64);
@@ -863,8 +1032,7 @@ void TextureCache<P>::PopAsyncFlushes() {
                 download_buffer.offset -= Common::AlignUp(image.unswizzled_size_bytes, 64);
                 std::span<u8> download_span =
                     download_buffer.mapped_span.subspan(download_buffer.offset);
-                SwizzleImage(*gpu_memory, image.gpu_addr, image.info, copies, download_span,
-                             swizzle_data_buffer);
+                SwizzleDownloadedImage(image, copies, download_span);
             } else {
                 const BufferDownload& buffer_info = slot_buffer_downloads[download_info.object_id];
                 std::span<u8> download_span =
@@ -912,8 +1080,7 @@ void TextureCache<P>::PopAsyncFlushes() {
             }
             const ImageBase& image = slot_images[download_info.object_id];
             const auto copies = FullDownloadCopies(image.info);
-            SwizzleImage(*gpu_memory, image.gpu_addr, image.info, copies, download_span,
-                         swizzle_data_buffer);
+            SwizzleDownloadedImage(image, copies, download_span);
             download_map.offset += image.unswizzled_size_bytes;
             download_span = download_span.subspan(image.unswizzled_size_bytes);
         }
@@ -922,22 +1089,29 @@ void TextureCache<P>::PopAsyncFlushes() {
 }
 
 template <class P>
-ImageId TextureCache<P>::DmaImageId(const Tegra::DMA::ImageOperand& operand, bool is_upload) {
+ImageId TextureCache<P>::DmaImageId(const Tegra::DMA::ImageOperand& operand, bool is_upload,
+                                    bool is_buffer_resident) {
     const ImageInfo dst_info(operand);
-    const ImageId dst_id = FindDMAImage(dst_info, operand.address);
+    ImageId dst_id = FindDMAImage(dst_info, operand.address);
     if (!dst_id) {
-        return NULL_IMAGE_ID;
+        if (!is_buffer_resident) {
+            // Neither side of the copy is cached, the CPU path is cheaper
+            return NULL_IMAGE_ID;
+        }
+        // Bring the image to the host instead of flushing the buffer, the guest contents are
+        // unswizzled on the GPU when the image is prepared
+        dst_id = FindOrInsertImage(dst_info, operand.address);
+        if (!dst_id) {
+            return NULL_IMAGE_ID;
+        }
     }
     auto& image = slot_images[dst_id];
-    if (False(image.flags & ImageFlagBits::GpuModified)) {
+    const bool is_gpu_modified = True(image.flags & ImageFlagBits::GpuModified);
+    if (!is_gpu_modified && !is_buffer_resident) {
         // No need to waste time on an image that's synced with guest
         return NULL_IMAGE_ID;
     }
-    if (image.info.type == ImageType::e3D) {
-        // Don't accelerate 3D images.
-        return NULL_IMAGE_ID;
-    }
-    if (!is_upload && !image.info.dma_downloaded) {
+    if (is_gpu_modified && !is_upload && !image.info.dma_downloaded) {
         // Force a full sync.
         image.info.dma_downloaded = true;
         return NULL_IMAGE_ID;
@@ -991,6 +1165,10 @@ std::pair<typename TextureCache<P>::Image*, BufferImageCopy> TextureCache<P>::Dm
     const u32 base_y = image_operand.params.origin.y.Value();
     const u32 length_x = convert(copy_info.length_x);
     const u32 length_y = copy_info.length_y;
+    // Copies to 3D images select a slice through the layer parameter
+    const bool is_3d = image->info.type == ImageType::e3D;
+    const u32 base_layer = is_3d ? 0 : base;
+    const u32 base_z = is_3d ? base + image_operand.params.layer : 0;
 
     const BufferImageCopy copy{
         .buffer_offset = 0,
@@ -1000,14 +1178,14 @@ std::pair<typename TextureCache<P>::Image*, BufferImageCopy> TextureCache<P>::Dm
         .image_subresource =
             {
                 .base_level = static_cast<s32>(level),
-                .base_layer = static_cast<s32>(base),
+                .base_layer = static_cast<s32>(base_layer),
                 .num_layers = 1,
             },
         .image_offset =
             {
                 .x = static_cast<s32>(base_x),
                 .y = static_cast<s32>(base_y),
-                .z = 0,
+                .z = static_cast<s32>(base_z),
             },
         .image_extent =
             {
@@ -1080,17 +1258,39 @@ void TextureCache<P>::UploadImageContents(Image& image, StagingBuffer& staging)
                               VideoCommon::CacheType::NoTextureCache);
         const auto uploads = FullUploadSwizzles(image.info);
         runtime.AccelerateImageUpload(image, staging, uploads);
+        ++swizzle_stats.num_gpu_uploads;
+        swizzle_stats.gpu_upload_bytes += image.guest_size_bytes;
         return;
     }
+    if (True(image.flags & ImageFlagBits::Converted)) {
+        ++swizzle_stats.num_converted_uploads;
+    } else if (image.info.type == ImageType::Linear) {
+        ++swizzle_stats.num_linear_uploads;
+    } else {
+        ++swizzle_stats.num_cpu_uploads;
+    }
+    swizzle_stats.cpu_upload_bytes += image.guest_size_bytes;
 
     Tegra::Memory::GpuGuestMemory<u8, Tegra::Memory::GuestMemoryFlags::UnsafeRead> swizzle_data(
         *gpu_memory, gpu_addr, image.guest_size_bytes, &swizzle_data_buffer);
 
     if (True(image.flags & ImageFlagBits::Converted)) {
+        const bool is_cacheable = transcode_cache.IsCacheable(image.info);
+        const u128 cache_key = is_cacheable ? transcode_cache.MakeKey(image.info, swizzle_data)
+                                            : u128{};
+        if (is_cacheable) {
+            if (const auto cached_copies = transcode_cache.Load(cache_key, mapped_span)) {
+                image.UploadMemory(staging, *cached_copies);
+                return;
+            }
+        }
         unswizzle_data_buffer.resize_destructive(image.unswizzled_size_bytes);
         auto copies =
             UnswizzleImage(*gpu_memory, gpu_addr, image.info, swizzle_data, unswizzle_data_buffer);
         ConvertImage(unswizzle_data_buffer, image.info, mapped_span, copies);
+        if (is_cacheable) {
+            transcode_cache.Store(cache_key, mapped_span, copies);
+        }
         image.UploadMemory(staging, copies);
     } else {
         const auto copies =
@@ -1099,6 +1299,15 @@ void TextureCache<P>::UploadImageContents(Image& image, StagingBuffer& staging)
     }
 }
 
+template <class P>
+void TextureCache<P>::SwizzleDownloadedImage(const ImageBase& image,
+                                             std::span<const BufferImageCopy> copies,
+                                             std::span<const u8> memory) {
+    SwizzleImage(*gpu_memory, image.gpu_addr, image.info, copies, memory, swizzle_data_buffer);
+    ++swizzle_stats.num_cpu_downloads;
+    swizzle_stats.cpu_download_bytes += image.guest_size_bytes;
+}
+
 template <class P>
 ImageViewId TextureCache<P>::FindImageView(const TICEntry& config) {
     if (!IsValidEntry(*gpu_memory, config)) {
@@ -1291,24 +1500,88 @@ void TextureCache<P>::QueueAsyncDecode(Image& image, ImageId image_id) {
     local_unswizzle_data_buffer.resize_destructive(image.unswizzled_size_bytes);
     Tegra::Memory::GpuGuestMemory<u8, Tegra::Memory::GuestMemoryFlags::UnsafeRead> swizzle_data(
         *gpu_memory, image.gpu_addr, image.guest_size_bytes, &swizzle_data_buffer);
+    const size_t out_size = MapSizeBytes(image);
+
+    const bool is_cacheable = transcode_cache.IsCacheable(image.info);
+    const u128 cache_key =
+        is_cacheable ? transcode_cache.MakeKey(image.info, swizzle_data) : u128{};
+    if (is_cacheable) {
+        decode->decoded_data.resize_destructive(out_size);
+        if (auto cached_copies = transcode_cache.Load(cache_key, decode->decoded_data)) {
+            // Uploaded on the next tick without going through the decode worker
+            decode->copies = std::move(*cached_copies);
+            decode->complete = true;
+            return;
+        }
+    }
 
     auto copies = UnswizzleImage(*gpu_memory, image.gpu_addr, image.info, swizzle_data,
                                  local_unswizzle_data_buffer);
-    const size_t out_size = MapSizeBytes(image);
 
-    auto func = [out_size, copies, info = image.info,
-                 input = std::move(local_unswizzle_data_buffer),
-                 async_decode = decode_ptr]() mutable {
+    decode->decode = [this, out_size, copies, info = image.info, is_cacheable, cache_key,
+                      input = std::move(local_unswizzle_data_buffer),
+                      async_decode = decode_ptr]() mutable {
         async_decode->decoded_data.resize_destructive(out_size);
         std::span copies_span{copies.data(), copies.size()};
         ConvertImage(input, info, async_decode->decoded_data, copies_span);
+        if (is_cacheable) {
+            transcode_cache.Store(cache_key, async_decode->decoded_data, copies);
+        }
 
         // TODO: Do we need this lock?
         std::unique_lock lock{async_decode->mutex};
         async_decode->copies = std::move(copies);
         async_decode->complete = true;
     };
-    texture_decode_worker.QueueWork(std::move(func));
+    {
+        std::scoped_lock lock{pending_decodes_mutex};
+        pending_decodes.push_back(decode_ptr);
+    }
+    texture_decode_worker.QueueWork([this] { RunNextAsyncDecode(); });
+}
+
+template <class P>
+void TextureCache<P>::PrioritizeAsyncDecode(ImageId image_id) {
+    std::scoped_lock lock{pending_decodes_mutex};
+    const auto it = std::ranges::find_if(pending_decodes, [image_id](AsyncDecodeContext* decode) {
+        return decode->image_id == image_id && !decode->cancelled;
+    });
+    if (it == pending_decodes.end() || it == pending_decodes.begin()) {
+        return;
+    }
+    AsyncDecodeContext* const decode = *it;
+    pending_decodes.erase(it);
+    pending_decodes.push_front(decode);
+}
+
+template <class P>
+void TextureCache<P>::CancelAsyncDecode(ImageId image_id) {
+    std::scoped_lock lock{pending_decodes_mutex};
+    for (const std::unique_ptr<AsyncDecodeContext>& decode : async_decodes) {
+        if (decode->image_id != image_id || decode->cancelled) {
+            continue;
+        }
+        decode->cancelled = true;
+        if (std::erase(pending_decodes, decode.get()) != 0) {
+            // It never started, release it on the next tick
+            decode->complete = true;
+        }
+    }
+}
+
+template <class P>
+void TextureCache<P>::RunNextAsyncDecode() {
+    AsyncDecodeContext* decode;
+    {
+        std::scoped_lock lock{pending_decodes_mutex};
+        if (pending_decodes.empty()) {
+            // Its decode was cancelled before any worker picked it
+            return;
+        }
+        decode = pending_decodes.front();
+        pending_decodes.pop_front();
+    }
+    decode->decode();
 }
 
 template <class P>
@@ -1322,6 +1595,12 @@ void TextureCache<P>::TickAsyncDecode() {
             ++i;
             continue;
         }
+        if (async_decode->cancelled) {
+            // The image was deleted while it was being decoded
+            lock.unlock();
+            i = async_decodes.erase(i);
+            continue;
+        }
         Image& image = slot_images[async_decode->image_id];
         auto staging = runtime.UploadStagingBuffer(MapSizeBytes(image));
         std::memcpy(staging.mapped_span.data(), async_decode->decoded_data.data(),
@@ -1731,6 +2010,38 @@ std::pair<u32, u32> TextureCache<P>::PrepareDmaImage(ImageId dst_id, GPUVAddr ba
     return std::make_pair(base->level, base->layer);
 }
 
+template <class P>
+ImageId TextureCache<P>::FindVideoFrameImage(const VideoCore::VideoFrameSurface& surface) {
+    const u32 bytes_per_pixel = VideoCore::Surface::BytesPerBlock(surface.format);
+    const auto is_frame_layout = [&surface, bytes_per_pixel](const ImageBase& image) {
+        const ImageInfo& info = image.info;
+        if (image.cpu_addr != surface.address || info.format != surface.format ||
+            info.size.width != surface.width || info.size.height != surface.height ||
+            info.resources.levels != 1 || info.resources.layers != 1 || info.num_samples != 1) {
+            return false;
+        }
+        if (!surface.is_block_linear) {
+            return info.type == ImageType::Linear && info.pitch == surface.width * bytes_per_pixel;
+        }
+        return info.type == ImageType::e2D && info.block.width == 0 &&
+               info.block.height == surface.block_height && info.block.depth == 0 &&
+               info.tile_width_spacing == 0;
+    };
+    const size_t frame_size = size_t{surface.width} * surface.height * bytes_per_pixel;
+    ImageId frame_id{};
+    ForEachImageInRegion(surface.address, frame_size, [&](ImageId image_id, ImageBase& image) {
+        // Converted images are uploaded in another format than the frame's pixels
+        if (True(image.flags & (ImageFlagBits::Remapped | ImageFlagBits::Converted)) ||
+            !is_frame_layout(image)) {
+            return;
+        }
+        if (!frame_id || slot_images[frame_id].modification_tick < image.modification_tick) {
+            frame_id = image_id;
+        }
+    });
+    return frame_id;
+}
+
 template <class P>
 SamplerId TextureCache<P>::FindSampler(const TSCEntry& config) {
     if (std::ranges::all_of(config.raw, [](u64 value) { return value == 0; })) {
@@ -1810,50 +2121,25 @@ void TextureCache<P>::ForEachImageInRegion(DAddr cpu_addr, size_t size, Func&& f
     using FuncReturn = typename std::invoke_result<Func, ImageId, Image&>::type;
     static constexpr bool BOOL_BREAK = std::is_same_v<FuncReturn, bool>;
     boost::container::small_vector<ImageId, 32> images;
-    boost::container::small_vector<ImageMapId, 32> maps;
-    ForEachCPUPage(cpu_addr, size, [this, &images, &maps, cpu_addr, size, func](u64 page) {
-        const auto it = page_table.find(page);
-        if (it == page_table.end()) {
-            if constexpr (BOOL_BREAK) {
-                return false;
-            } else {
-                return;
-            }
-        }
-        for (const ImageMapId map_id : it->second) {
-            ImageMapView& map = slot_map_views[map_id];
-            if (map.picked) {
-                continue;
-            }
-            if (!map.Overlaps(cpu_addr, size)) {
-                continue;
-            }
-            map.picked = true;
-            maps.push_back(map_id);
-            Image& image = slot_images[map.image_id];
-            if (True(image.flags & ImageFlagBits::Picked)) {
-                continue;
-            }
-            image.flags |= ImageFlagBits::Picked;
-            images.push_back(map.image_id);
-            if constexpr (BOOL_BREAK) {
-                if (func(map.image_id, image)) {
-                    return true;
-                }
-            } else {
-                func(map.image_id, image);
-            }
+    // The index reports each overlapping map once, only sparse images can be found twice
+    image_map_index.ForEach(cpu_addr, size, [&](ImageMapId map_id) {
+        const ImageMapView& map = slot_map_views[map_id];
+        Image& image = slot_images[map.image_id];
+        if (True(image.flags & ImageFlagBits::Picked)) {
+            return false;
         }
+        image.flags |= ImageFlagBits::Picked;
+        images.push_back(map.image_id);
         if constexpr (BOOL_BREAK) {
+            return func(map.image_id, image);
+        } else {
+            func(map.image_id, image);
             return false;
         }
     });
     for (const ImageId image_id : images) {
         slot_images[image_id].flags &= ~ImageFlagBits::Picked;
     }
-    for (const ImageMapId map_id : maps) {
-        slot_map_views[map_id].picked = false;
-    }
 }
 
 template <class P>
@@ -2006,8 +2292,7 @@ void TextureCache<P>::RegisterImage(ImageId image_id) {
     if (False(image.flags & ImageFlagBits::Sparse)) {
         auto map_id =
             slot_map_views.insert(image.gpu_addr, image.cpu_addr, image.guest_size_bytes, image_id);
-        ForEachCPUPage(image.cpu_addr, image.guest_size_bytes,
-                       [this, map_id](u64 page) { page_table[page].push_back(map_id); });
+        image_map_index.Insert(image.cpu_addr, image.guest_size_bytes, map_id);
         image.map_view_id = map_id;
         return;
     }
@@ -2015,8 +2300,7 @@ void TextureCache<P>::RegisterImage(ImageId image_id) {
     ForEachSparseSegment(
         image, [this, image_id, &sparse_maps](GPUVAddr gpu_addr, DAddr cpu_addr, size_t size) {
             auto map_id = slot_map_views.insert(gpu_addr, cpu_addr, size, image_id);
-            ForEachCPUPage(cpu_addr, size,
-                           [this, map_id](u64 page) { page_table[page].push_back(map_id); });
+            image_map_index.Insert(cpu_addr, size, map_id);
             sparse_maps.push_back(map_id);
         });
     sparse_views.emplace(image_id, std::move(sparse_maps));
@@ -2056,21 +2340,9 @@ void TextureCache<P>::UnregisterImage(ImageId image_id) {
     });
     if (False(image.flags & ImageFlagBits::Sparse)) {
         const auto map_id = image.map_view_id;
-        ForEachCPUPage(image.cpu_addr, image.guest_size_bytes, [this, map_id](u64 page) {
-            const auto page_it = page_table.find(page);
-            if (page_it == page_table.end()) {
-                ASSERT_MSG(false, "Unregistering unregistered page=0x{:x}", page << YUZU_PAGEBITS);
-                return;
-            }
-            std::vector<ImageMapId>& image_map_ids = page_it->second;
-            const auto vector_it = std::ranges::find(image_map_ids, map_id);
-            if (vector_it == image_map_ids.end()) {
-                ASSERT_MSG(false, "Unregistering unregistered image in page=0x{:x}",
-                           page << YUZU_PAGEBITS);
-                return;
-            }
-            image_map_ids.erase(vector_it);
-        });
+        if (!image_map_index.Erase(image.cpu_addr, image.guest_size_bytes, map_id)) {
+            ASSERT_MSG(false, "Unregistering unregistered image at addr=0x{:x}", image.cpu_addr);
+        }
         slot_map_views.erase(map_id);
         return;
     }
@@ -2082,28 +2354,10 @@ void TextureCache<P>::UnregisterImage(ImageId image_id) {
     auto& sparse_maps = it->second;
     for (auto& map_view_id : sparse_maps) {
         const auto& map_range = slot_map_views[map_view_id];
-        const DAddr cpu_addr = map_range.cpu_addr;
-        const std::size_t size = map_range.size;
-        ForEachCPUPage(cpu_addr, size, [this, image_id](u64 page) {
-            const auto page_it = page_table.find(page);
-            if (page_it == page_table.end()) {
-                ASSERT_MSG(false, "Unregistering unregistered page=0x{:x}", page << YUZU_PAGEBITS);
-                return;
-            }
-            std::vector<ImageMapId>& image_map_ids = page_it->second;
-            auto vector_it = image_map_ids.begin();
-            while (vector_it != image_map_ids.end()) {
-                ImageMapView& map = slot_map_views[*vector_it];
-                if (map.image_id != image_id) {
-                    vector_it++;
-                    continue;
-                }
-                if (!map.picked) {
-                    map.picked = true;
-                }
-                vector_it = image_map_ids.erase(vector_it);
-            }
-        });
+        if (!image_map_index.Erase(map_range.cpu_addr, map_range.size, map_view_id)) {
+            ASSERT_MSG(false, "Unregistering unregistered sparse map at addr=0x{:x}",
+                       map_range.cpu_addr);
+        }
         slot_map_views.erase(map_view_id);
     }
     sparse_views.erase(it);
@@ -2162,6 +2416,9 @@ void TextureCache<P>::UntrackImage(ImageBase& image, ImageId image_id) {
 template <class P>
 void TextureCache<P>::DeleteImage(ImageId image_id, bool immediate_delete) {
     ImageBase& image = slot_images[image_id];
+    if (True(image.flags & ImageFlagBits::IsDecoding)) {
+        CancelAsyncDecode(image_id);
+    }
     if (image.HasScaled()) {
         total_used_memory -= GetScaledImageSizeBytes(image);
     }
@@ -2325,8 +2582,41 @@ void TextureCache<P>::SynchronizeAliases(ImageId image_id) {
         const ImageBase& rhs_image = slot_images[rhs->id];
         return lhs_image.modification_tick < rhs_image.modification_tick;
     });
+    // Aliases whose regions are overwritten by a more recently modified alias don't need to be
+    // copied, nor rescaled, their contents would be discarded right away.
+    const auto is_covered = [](const ImageCopy& copy, const ImageCopy& newer) {
+        const SubresourceLayers& dst = copy.dst_subresource;
+        const SubresourceLayers& newer_dst = newer.dst_subresource;
+        const auto covers = [](s32 newer_begin, u32 newer_size, s32 begin, u32 size) {
+            return newer_begin <= begin &&
+                   static_cast<s64>(begin) + size <= static_cast<s64>(newer_begin) + newer_size;
+        };
+        return dst.base_level == newer_dst.base_level &&
+               covers(newer_dst.base_layer, newer_dst.num_layers, dst.base_layer,
+                      dst.num_layers) &&
+               covers(newer.dst_offset.x, newer.extent.width, copy.dst_offset.x,
+                      copy.extent.width) &&
+               covers(newer.dst_offset.y, newer.extent.height, copy.dst_offset.y,
+                      copy.extent.height) &&
+               covers(newer.dst_offset.z, newer.extent.depth, copy.dst_offset.z,
+                      copy.extent.depth);
+    };
+    boost::container::small_vector<const AliasedImage*, 8> copied_aliases;
+    for (auto it = aliased_images.rbegin(); it != aliased_images.rend(); ++it) {
+        const bool is_overwritten = std::ranges::all_of((*it)->copies, [&](const ImageCopy& copy) {
+            return std::ranges::any_of(copied_aliases, [&](const AliasedImage* newer) {
+                return std::ranges::any_of(newer->copies, [&](const ImageCopy& newer_copy) {
+                    return is_covered(copy, newer_copy);
+                });
+            });
+        });
+        if (!is_overwritten) {
+            copied_aliases.push_back(*it);
+        }
+    }
+    std::ranges::reverse(copied_aliases);
     const auto& resolution = Settings::values.resolution_info;
-    for (const AliasedImage* const aliased : aliased_images) {
+    for (const AliasedImage* const aliased : copied_aliases) {
         if (!resolution.active || !any_rescaled) {
             CopyImage(image_id, aliased->id, aliased->copies);
             continue;
@@ -2354,8 +2644,18 @@ void TextureCache<P>::PrepareImage(ImageId image_id, bool is_modification, bool
         RefreshContents(image, image_id);
         SynchronizeAliases(image_id);
     }
+    if (True(image.flags & ImageFlagBits::IsDecoding)) {
+        PrioritizeAsyncDecode(image_id);
+    }
     if (is_modification) {
         MarkModification(image);
+        if constexpr (IMPLEMENTS_ASYNC_DOWNLOADS) {
+            // Start the download with the next fence after the write instead of waiting for the
+            // image to be bound as a render target again
+            if (image.info.forced_flushed) {
+                QueuePreemptiveDownload(image_id);
+            }
+        }
     }
     lru_cache.Touch(image.lru_index, frame_tick);
 }
@@ -2469,13 +2769,34 @@ void TextureCache<P>::BindRenderTarget(ImageViewId* old_id, ImageViewId new_id)
     if (new_id) {
         const ImageViewBase& old_view = slot_image_views[new_id];
         if (True(old_view.flags & ImageViewFlagBits::PreemtiveDownload)) {
-            const PendingDownload new_download{true, 0, old_view.image_id};
-            uncommitted_downloads.emplace_back(new_download);
+            QueuePreemptiveDownload(old_view.image_id);
         }
     }
     *old_id = new_id;
 }
 
+template <class P>
+void TextureCache<P>::MarkPreemptiveDownload(ImageBase& image) {
+    for (const ImageViewId image_view_id : image.image_view_ids) {
+        slot_image_views[image_view_id].flags |= ImageViewFlagBits::PreemtiveDownload;
+    }
+    image.info.forced_flushed = true;
+}
+
+template <class P>
+void TextureCache<P>::QueuePreemptiveDownload(ImageId image_id) {
+    ImageBase& image = slot_images[image_id];
+    if (True(image.flags & ImageFlagBits::PendingDownload)) {
+        return;
+    }
+    if constexpr (IMPLEMENTS_ASYNC_DOWNLOADS) {
+        // Cleared once the download is recorded, later writes queue a new one
+        image.flags |= ImageFlagBits::PendingDownload;
+    }
+    const PendingDownload new_download{true, 0, image_id};
+    uncommitted_downloads.emplace_back(new_download);
+}
+
 template <class P>
 std::pair<FramebufferId, ImageViewId> TextureCache<P>::RenderTargetFromImage(
     ImageId image_id, const ImageViewInfo& view_info) {
@@ -23,18 +23,24 @@
 #include "common/scratch_buffer.h"
 #include "common/slot_vector.h"
 #include "common/thread_worker.h"
+#include "common/unique_function.h"
+#include "video_core/cache_trace.h"
 #include "video_core/compatible_formats.h"
 #include "video_core/control/channel_state_cache.h"
 #include "video_core/delayed_destruction_ring.h"
 #include "video_core/engines/fermi_2d.h"
+#include "video_core/memory_budget.h"
 #include "video_core/surface.h"
 #include "video_core/texture_cache/descriptor_table.h"
 #include "video_core/texture_cache/image_base.h"
 #include "video_core/texture_cache/image_info.h"
 #include "video_core/texture_cache/image_view_base.h"
 #include "video_core/texture_cache/render_targets.h"
+#include "video_core/texture_cache/spatial_index.h"
+#include "video_core/texture_cache/transcode_cache.h"
 #include "video_core/texture_cache/types.h"
 #include "video_core/textures/texture.h"
+#include "video_core/video_frame_surface.h"
 
 namespace Tegra {
 namespace Control {
@@ -59,8 +65,22 @@ struct AsyncDecodeContext {
     ImageId image_id;
     Common::ScratchBuffer<u8> decoded_data;
     boost::container::small_vector<BufferImageCopy, 16> copies;
+    Common::UniqueFunction<void> decode;
     std::mutex mutex;
     std::atomic_bool complete;
+    std::atomic_bool cancelled;
+};
+
+/// Counters of the image uploads and downloads, by the processor moving them between layouts
+struct SwizzleStats {
+    u64 num_gpu_uploads{};       ///< Uploads unswizzled or decoded by the GPU.
+    u64 num_cpu_uploads{};       ///< Block linear uploads unswizzled by the CPU.
+    u64 num_converted_uploads{}; ///< Uploads unswizzled and converted by the CPU.
+    u64 num_linear_uploads{};    ///< Pitch linear uploads, copied as they are.
+    u64 num_cpu_downloads{};     ///< Downloads swizzled by the CPU.
+    u64 gpu_upload_bytes{};      ///< Guest bytes of the uploads done by the GPU.
+    u64 cpu_upload_bytes{};      ///< Guest bytes of the uploads done by the CPU.
+    u64 cpu_download_bytes{};    ///< Guest bytes of the downloads swizzled by the CPU.
 };
 
 using TextureCacheGPUMap = std::unordered_map<u64, std::vector<ImageId>, Common::IdentityHash<u64>>;
@@ -134,6 +154,12 @@ public:
     /// Notify the cache that a new frame has been queued
     void TickFrame();
 
+    /// Collects images against a share of a budget shared with other caches, instead of
+    /// thresholds derived from the device memory
+    void SetMemoryBudget(MemoryBudget* memory_budget_) noexcept {
+        memory_budget = memory_budget_;
+    }
+
     /// Return a constant reference to the given image view id
     [[nodiscard]] const ImageView& GetImageView(ImageViewId id) const noexcept;
 
@@ -215,6 +241,13 @@ public:
     [[nodiscard]] std::pair<ImageView*, bool> TryFindFramebufferImageView(
         const Tegra::FramebufferConfig& config, DAddr cpu_addr);
 
+    /// Return true when an image caches the surface of a video frame
+    [[nodiscard]] bool IsVideoFrameCached(const VideoCore::VideoFrameSurface& surface);
+
+    /// Write the linear pixels of a video frame to the image caching its surface
+    /// @retval True if an image caches the surface and was written.
+    bool WriteVideoFrame(const VideoCore::VideoFrameSurface& surface, std::span<const u8> pixels);
+
     /// Return true when there are uncommitted images to be downloaded
     [[nodiscard]] bool HasUncommittedFlushes() const noexcept;
 
@@ -227,7 +260,10 @@ public:
     /// Pop asynchronous downloads
     void PopAsyncFlushes();
 
-    [[nodiscard]] ImageId DmaImageId(const Tegra::DMA::ImageOperand& operand, bool is_upload);
+    /// Returns the image to accelerate a DMA copy with, creating it when the buffer side of the
+    /// copy is resident on the host and the image is not cached yet
+    [[nodiscard]] ImageId DmaImageId(const Tegra::DMA::ImageOperand& operand, bool is_upload,
+                                     bool is_buffer_resident);
 
     [[nodiscard]] std::pair<Image*, BufferImageCopy> DmaBufferImageCopy(
         const Tegra::DMA::ImageCopy& copy_info, const Tegra::DMA::BufferOperand& buffer_operand,
@@ -242,6 +278,11 @@ public:
 
     [[nodiscard]] bool IsRescaling() const noexcept;
 
+    /// Returns how many uploads and downloads were swizzled on each processor
+    [[nodiscard]] const SwizzleStats& GetSwizzleStats() const noexcept {
+        return swizzle_stats;
+    }
+
     [[nodiscard]] bool IsRescaling(const ImageViewBase& image_view) const noexcept;
 
     /// Create channel state.
@@ -299,6 +340,20 @@ private:
     ImageViewId VisitImageView(DescriptorTable<TICEntry>& table,
                                std::span<ImageViewId> cached_image_view_ids, u32 index);
 
+    /// Refresh a descriptor table and track writes to its memory
+    /// @retval True if the table address or limit has changed.
+    template <typename Descriptor>
+    bool SynchronizeDescriptorTable(DescriptorTable<Descriptor>& table, GPUVAddr gpu_addr,
+                                    u32 limit);
+
+    /// Stop tracking writes to a descriptor table
+    template <typename Descriptor>
+    void UntrackDescriptorTable(DescriptorTable<Descriptor>& table);
+
+    /// Iterate over the descriptor tables of all active channels
+    template <typename Func>
+    void ForEachDescriptorTable(Func&& func);
+
     /// Find or create a framebuffer with the given render target parameters
     FramebufferId GetFramebufferId(const RenderTargets& key);
 
@@ -309,6 +364,10 @@ private:
     template <typename StagingBuffer>
     void UploadImageContents(Image& image, StagingBuffer& staging_buffer);
 
+    /// Write downloaded image contents back to guest memory
+    void SwizzleDownloadedImage(const ImageBase& image, std::span<const BufferImageCopy> copies,
+                                std::span<const u8> memory);
+
     /// Find or create an image view from a guest descriptor
     [[nodiscard]] ImageViewId FindImageView(const TICEntry& config);
 
@@ -333,6 +392,9 @@ private:
 
     [[nodiscard]] ImageId FindDMAImage(const ImageInfo& info, GPUVAddr gpu_addr);
 
+    /// Find the most recently modified image with the exact layout of a video frame surface
+    [[nodiscard]] ImageId FindVideoFrameImage(const VideoCore::VideoFrameSurface& surface);
+
     /// Return a blit image pair from the given guest blit parameters
     [[nodiscard]] std::optional<BlitImages> GetBlitImages(
         const Tegra::Engines::Fermi2D::Surface& dst, const Tegra::Engines::Fermi2D::Surface& src,
@@ -403,6 +465,12 @@ private:
     /// Bind an image view as render target, downloading resources preemtively if needed
     void BindRenderTarget(ImageViewId* old_id, ImageViewId new_id);
 
+    /// Remember that the CPU reads back an image, so it is downloaded after each write
+    void MarkPreemptiveDownload(ImageBase& image);
+
+    /// Queue the download of an image on the next async flush, unless it is already queued
+    void QueuePreemptiveDownload(ImageId image_id);
+
     /// Create a render target from a given image and image view parameters
     [[nodiscard]] std::pair<FramebufferId, ImageViewId> RenderTargetFromImage(
         ImageId, const ImageViewInfo& view_info);
@@ -422,16 +490,27 @@ private:
     void QueueAsyncDecode(Image& image, ImageId image_id);
     void TickAsyncDecode();
 
+    /// Moves the pending decode of an image needed by the current draw to the front of the queue
+    void PrioritizeAsyncDecode(ImageId image_id);
+
+    /// Cancels the decode of an image that is being deleted
+    void CancelAsyncDecode(ImageId image_id);
+
+    /// Runs the most urgent pending decode, called from the decode worker
+    void RunNextAsyncDecode();
+
     Runtime& runtime;
 
     Tegra::MaxwellDeviceMemoryManager& device_memory;
+    std::unique_ptr<CacheTraceRecorder> trace_recorder;
+    MemoryBudget* memory_budget = nullptr;
     std::deque<TextureCacheGPUMap> gpu_page_table_storage;
 
     RenderTargets render_targets;
 
     std::unordered_map<RenderTargets, FramebufferId> framebuffers;
 
-    std::unordered_map<u64, std::vector<ImageMapId>, Common::IdentityHash<u64>> page_table;
+    SpatialIndex<ImageMapId> image_map_index;
     std::unordered_map<ImageId, boost::container::small_vector<ImageViewId, 16>> sparse_views;
 
     DAddr virtual_invalid_space{};
@@ -485,12 +564,16 @@ private:
 
     Common::ScratchBuffer<u8> swizzle_data_buffer;
     Common::ScratchBuffer<u8> unswizzle_data_buffer;
+    SwizzleStats swizzle_stats;
 
     u64 modification_tick = 0;
     u64 frame_tick = 0;
 
-    Common::ThreadWorker texture_decode_worker{1, "TextureDecoder"};
+    TranscodeCache transcode_cache;
     std::vector<std::unique_ptr<AsyncDecodeContext>> async_decodes;
+    std::mutex pending_decodes_mutex;
+    std::deque<AsyncDecodeContext*> pending_decodes;
+    Common::ThreadWorker texture_decode_worker{1, "TextureDecoder"};
 
     // Join caching
     boost::container::small_vector<ImageId, 4> join_overlap_ids;
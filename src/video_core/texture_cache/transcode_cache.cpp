@@ -0,0 +1,183 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <charconv>
+#include <fstream>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "common/cityhash.h"
+#include "common/fs/fs.h"
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
+#include "common/settings.h"
+#include "video_core/surface.h"
+#include "video_core/texture_cache/transcode_cache.h"
+
+namespace VideoCommon {
+
+namespace {
+using VideoCore::Surface::IsPixelFormatASTC;
+
+constexpr std::array<char, 8> MAGIC_NUMBER{'y', 'u', 'z', 'u', 't', 'c', 'c', 'h'};
+constexpr u32 CACHE_VERSION = 1;
+constexpr std::string_view ENTRY_EXTENSION = ".bin";
+
+std::optional<u128> ParseKey(std::string_view name) {
+    if (name.size() != 32) {
+        return std::nullopt;
+    }
+    u128 key{};
+    for (size_t half = 0; half < key.size(); ++half) {
+        const char* const begin = name.data() + half * 16;
+        const auto [ptr, ec] = std::from_chars(begin, begin + 16, key[half], 16);
+        if (ec != std::errc{} || ptr != begin + 16) {
+            return std::nullopt;
+        }
+    }
+    return key;
+}
+} // Anonymous namespace
+
+TranscodeCache::TranscodeCache() {
+    enabled = Settings::values.use_astc_transcode_cache.GetValue();
+    if (!enabled) {
+        return;
+    }
+    cache_dir = Common::FS::GetYuzuPath(Common::FS::YuzuPath::CacheDir) / "transcoded_textures";
+    if (!Common::FS::CreateDirs(cache_dir)) {
+        LOG_ERROR(Common_Filesystem, "Failed to create transcoded texture cache directory");
+        enabled = false;
+        return;
+    }
+    // Index the existing entries so misses never touch the filesystem
+    Common::FS::IterateDirEntries(
+        cache_dir,
+        [this](const std::filesystem::directory_entry& entry) {
+            const std::filesystem::path& path = entry.path();
+            if (path.extension() == ENTRY_EXTENSION) {
+                if (const std::optional<u128> key = ParseKey(path.stem().string())) {
+                    entries.insert(*key);
+                }
+            }
+            return true;
+        },
+        Common::FS::DirEntryFilter::File);
+    LOG_INFO(HW_GPU, "Found {} transcoded textures in the disk cache", entries.size());
+}
+
+TranscodeCache::~TranscodeCache() = default;
+
+bool TranscodeCache::IsCacheable(const ImageInfo& info) const noexcept {
+    return enabled && IsPixelFormatASTC(info.format);
+}
+
+u128 TranscodeCache::MakeKey(const ImageInfo& info, std::span<const u8> guest_data) const {
+    // Everything that changes the transcoded layout is part of the seed
+    const std::array<u32, 10> layout{
+        static_cast<u32>(info.format),
+        static_cast<u32>(info.type),
+        info.size.width,
+        info.size.height,
+        info.size.depth,
+        static_cast<u32>(info.resources.levels),
+        static_cast<u32>(info.resources.layers),
+        info.layer_stride,
+        static_cast<u32>(Settings::values.astc_recompression.GetValue()),
+        CACHE_VERSION,
+    };
+    const u128 seed = Common::CityHash128(reinterpret_cast<const char*>(layout.data()),
+                                          layout.size() * sizeof(u32));
+    return Common::CityHash128WithSeed(reinterpret_cast<const char*>(guest_data.data()),
+                                       guest_data.size(), seed);
+}
+
+std::optional<TranscodeCache::Copies> TranscodeCache::Load(const u128& key,
+                                                           std::span<u8> output) try {
+    {
+        std::scoped_lock lock{mutex};
+        if (!entries.contains(key)) {
+            return std::nullopt;
+        }
+    }
+    const std::filesystem::path path = EntryPath(key);
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return std::nullopt;
+    }
+    file.exceptions(std::ifstream::failbit);
+
+    std::array<char, 8> magic_number;
+    u32 num_copies{};
+    u64 data_size{};
+    file.read(magic_number.data(), magic_number.size())
+        .read(reinterpret_cast<char*>(&num_copies), sizeof(num_copies))
+        .read(reinterpret_cast<char*>(&data_size), sizeof(data_size));
+    if (magic_number != MAGIC_NUMBER || data_size > output.size() ||
+        num_copies > MAX_MIP_LEVELS) {
+        LOG_ERROR(Common_Filesystem, "Invalid transcoded texture cache entry {}",
+                  Common::FS::PathToUTF8String(path));
+        return std::nullopt;
+    }
+    Copies copies(num_copies);
+    file.read(reinterpret_cast<char*>(copies.data()), num_copies * sizeof(BufferImageCopy))
+        .read(reinterpret_cast<char*>(output.data()), data_size);
+    return copies;
+
+} catch (const std::ios_base::failure& e) {
+    LOG_ERROR(Common_Filesystem, "{}", e.what());
+    std::scoped_lock lock{mutex};
+    entries.erase(key);
+    return std::nullopt;
+}
+
+void TranscodeCache::Store(const u128& key, std::span<const u8> data,
+                           std::span<const BufferImageCopy> copies) {
+    {
+        std::scoped_lock lock{mutex};
+        if (!entries.insert(key).second) {
+            return;
+        }
+    }
+    writer.QueueWork([this, key, data_ = std::vector<u8>(data.begin(), data.end()),
+                      copies_ = Copies(copies.begin(), copies.end())] {
+        WriteEntry(key, data_, copies_);
+    });
+}
+
+std::filesystem::path TranscodeCache::EntryPath(const u128& key) const {
+    return cache_dir / fmt::format("{:016x}{:016x}{}", key[0], key[1], ENTRY_EXTENSION);
+}
+
+void TranscodeCache::WriteEntry(const u128& key, std::span<const u8> data,
+                                std::span<const BufferImageCopy> copies) {
+    const std::filesystem::path path = EntryPath(key);
+    std::filesystem::path temp_path = path;
+    temp_path += ".tmp";
+    try {
+        // Write to a temporary file first, so entries are never seen partially written
+        {
+            std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+            file.exceptions(std::ofstream::failbit);
+            const u32 num_copies = static_cast<u32>(copies.size());
+            const u64 data_size = data.size();
+            file.write(MAGIC_NUMBER.data(), MAGIC_NUMBER.size())
+                .write(reinterpret_cast<const char*>(&num_copies), sizeof(num_copies))
+                .write(reinterpret_cast<const char*>(&data_size), sizeof(data_size))
+                .write(reinterpret_cast<const char*>(copies.data()), copies.size_bytes())
+                .write(reinterpret_cast<const char*>(data.data()), data.size_bytes());
+        }
+        if (!Common::FS::RenameFile(temp_path, path)) {
+            throw std::ios_base::failure("Failed to rename transcoded texture cache entry");
+        }
+    } catch (const std::ios_base::failure& e) {
+        LOG_ERROR(Common_Filesystem, "{}", e.what());
+        Common::FS::RemoveFile(temp_path);
+        std::scoped_lock lock{mutex};
+        entries.erase(key);
+    }
+}
+
+} // namespace VideoCommon
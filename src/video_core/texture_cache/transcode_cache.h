@@ -0,0 +1,59 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <span>
+#include <boost/container/small_vector.hpp>
+
+#include "common/common_types.h"
+#include "common/thread_worker.h"
+#include "video_core/texture_cache/image_info.h"
+#include "video_core/texture_cache/types.h"
+
+namespace VideoCommon {
+
+/**
+ * Persistent on-disk cache of CPU transcoded image contents.
+ * ASTC images decoded to RGBA8 or recompressed to BCn are stored keyed by a hash of the guest
+ * texture bytes and the image layout, so later sessions can upload them without decoding again.
+ */
+class TranscodeCache {
+public:
+    using Copies = boost::container::small_vector<BufferImageCopy, 16>;
+
+    explicit TranscodeCache();
+    ~TranscodeCache();
+
+    /// Returns true when the contents of the image are transcoded on the CPU and can be cached
+    [[nodiscard]] bool IsCacheable(const ImageInfo& info) const noexcept;
+
+    /// Returns a key identifying the given guest contents transcoded with the current settings
+    [[nodiscard]] u128 MakeKey(const ImageInfo& info, std::span<const u8> guest_data) const;
+
+    /// Reads the transcoded contents for the key into output, returning their upload copies
+    [[nodiscard]] std::optional<Copies> Load(const u128& key, std::span<u8> output);
+
+    /// Queues the contents for the key to be written to disk in the background
+    void Store(const u128& key, std::span<const u8> data, std::span<const BufferImageCopy> copies);
+
+private:
+    [[nodiscard]] std::filesystem::path EntryPath(const u128& key) const;
+
+    void WriteEntry(const u128& key, std::span<const u8> data,
+                    std::span<const BufferImageCopy> copies);
+
+    bool enabled{};
+    std::filesystem::path cache_dir;
+
+    std::mutex mutex;
+    std::set<u128> entries;
+
+    Common::ThreadWorker writer{1, "TranscodeCacheWriter"};
+};
+
+} // namespace VideoCommon
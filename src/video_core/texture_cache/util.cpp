@@ -862,7 +862,6 @@ boost::container::small_vector<BufferImageCopy, 16> UnswizzleImage(Tegra::Memory
         }};
     }
     const LevelInfo level_info = MakeLevelInfo(info);
-    const s32 num_layers = info.resources.layers;
     const s32 num_levels = info.resources.levels;
     const std::array level_sizes = CalculateLevelSizes(level_info, num_levels);
     const Extent2D gob = GobSize(bpp_log2, info.block.height, info.tile_width_spacing);
@@ -871,26 +870,12 @@ boost::container::small_vector<BufferImageCopy, 16> UnswizzleImage(Tegra::Memory
                                             info.tile_width_spacing);
     size_t guest_offset = 0;
     u32 host_offset = 0;
-    boost::container::small_vector<BufferImageCopy, 16> copies(num_levels);
+    auto copies = FullUploadCopies(info);
 
     for (s32 level = 0; level < num_levels; ++level) {
         const Extent3D level_size = AdjustMipSize(size, level);
         const u32 num_blocks_per_layer = NumBlocks(level_size, tile_size);
         const u32 host_bytes_per_layer = num_blocks_per_layer << bpp_log2;
-        copies[level] = BufferImageCopy{
-            .buffer_offset = host_offset,
-            .buffer_size = static_cast<size_t>(host_bytes_per_layer) * num_layers,
-            .buffer_row_length = Common::AlignUp(level_size.width, tile_size.width),
-            .buffer_image_height = Common::AlignUp(level_size.height, tile_size.height),
-            .image_subresource =
-                {
-                    .base_level = level,
-                    .base_layer = 0,
-                    .num_layers = info.resources.layers,
-                },
-            .image_offset = {0, 0, 0},
-            .image_extent = level_size,
-        };
         const Extent3D num_tiles = AdjustTileSize(level_size, tile_size);
         const Extent3D block =
             AdjustMipBlockSize(num_tiles, level_info.block, level, level_info.num_levels);
@@ -1034,6 +1019,37 @@ boost::container::small_vector<BufferImageCopy, 16> FullDownloadCopies(const Ima
     return copies;
 }
 
+boost::container::small_vector<BufferImageCopy, 16> FullUploadCopies(const ImageInfo& info) {
+    ASSERT(info.type != ImageType::Linear);
+    const u32 bpp_log2 = BytesPerBlockLog2(info.format);
+    const Extent2D tile_size = DefaultBlockSize(info.format);
+    const s32 num_layers = info.resources.layers;
+    const s32 num_levels = info.resources.levels;
+
+    u32 host_offset = 0;
+    boost::container::small_vector<BufferImageCopy, 16> copies(num_levels);
+    for (s32 level = 0; level < num_levels; ++level) {
+        const Extent3D level_size = AdjustMipSize(info.size, level);
+        const u32 host_bytes_per_layer = NumBlocks(level_size, tile_size) << bpp_log2;
+        copies[level] = BufferImageCopy{
+            .buffer_offset = host_offset,
+            .buffer_size = static_cast<size_t>(host_bytes_per_layer) * num_layers,
+            .buffer_row_length = Common::AlignUp(level_size.width, tile_size.width),
+            .buffer_image_height = Common::AlignUp(level_size.height, tile_size.height),
+            .image_subresource =
+                {
+                    .base_level = level,
+                    .base_layer = 0,
+                    .num_layers = num_layers,
+                },
+            .image_offset = {0, 0, 0},
+            .image_extent = level_size,
+        };
+        host_offset += host_bytes_per_layer * num_layers;
+    }
+    return copies;
+}
+
 Extent3D MipSize(Extent3D size, u32 level) {
     return AdjustMipSize(size, level);
 }
@@ -72,6 +72,10 @@ void ConvertImage(std::span<const u8> input, const ImageInfo& info, std::span<u8
 [[nodiscard]] boost::container::small_vector<BufferImageCopy, 16> FullDownloadCopies(
     const ImageInfo& info);
 
+/// Returns the copies of a block linear image unswizzled into a buffer, levels one after another
+[[nodiscard]] boost::container::small_vector<BufferImageCopy, 16> FullUploadCopies(
+    const ImageInfo& info);
+
 [[nodiscard]] Extent3D MipSize(Extent3D size, u32 level);
 
 [[nodiscard]] Extent3D MipBlockSize(const ImageInfo& info, u32 level);
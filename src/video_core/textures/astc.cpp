@@ -16,8 +16,8 @@
 #include "common/alignment.h"
 #include "common/common_types.h"
 #include "common/polyfill_ranges.h"
+#include "common/task_scheduler.h"
 #include "video_core/textures/astc.h"
-#include "video_core/textures/workers.h"
 
 class InputBitStream {
 public:
@@ -1656,7 +1656,7 @@ void Decompress(std::span<const uint8_t> data, uint32_t width, uint32_t height,
     const u32 rows = Common::DivideUp(height, block_height);
     const u32 cols = Common::DivideUp(width, block_width);
 
-    Common::ThreadWorker& workers{GetThreadWorkers()};
+    Common::TaskGroup workers;
 
     for (u32 z = 0; z < depth; ++z) {
         const u32 depth_offset = z * height * width * 4;
@@ -1684,9 +1684,9 @@ void Decompress(std::span<const uint8_t> data, uint32_t width, uint32_t height,
                     }
                 }
             };
-            workers.QueueWork(std::move(decompress_stride));
+            workers.Run(std::move(decompress_stride));
         }
-        workers.WaitForRequests();
+        workers.Wait();
     }
 }
 
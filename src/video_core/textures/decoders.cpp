@@ -1,6 +1,7 @@
 // SPDX-FileCopyrightText: Copyright 2018 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include <array>
 #include <cmath>
 #include <cstring>
@@ -33,6 +34,67 @@ void incrpdep(u32& value) {
     value = ((value | ~mask) + swizzled_incr) & mask;
 }
 
+/// Copies one row of a GOB, each of its four 16 byte sectors is contiguous in both layouts
+template <bool TO_LINEAR>
+void SwizzleGobRow(std::span<u8> output, std::span<const u8> input, u32 swizzled_offset,
+                   u32 unswizzled_offset) {
+    static constexpr u32 SECTOR_SIZE = 16;
+    static constexpr std::array<u32, GOB_SIZE_X / SECTOR_SIZE> SECTOR_OFFSETS{
+        pdep<SWIZZLE_X_BITS>(SECTOR_SIZE * 0),
+        pdep<SWIZZLE_X_BITS>(SECTOR_SIZE * 1),
+        pdep<SWIZZLE_X_BITS>(SECTOR_SIZE * 2),
+        pdep<SWIZZLE_X_BITS>(SECTOR_SIZE * 3),
+    };
+    for (u32 sector = 0; sector < SECTOR_OFFSETS.size(); ++sector) {
+        const u32 sector_swizzled = swizzled_offset + SECTOR_OFFSETS[sector];
+        const u32 sector_unswizzled = unswizzled_offset + sector * SECTOR_SIZE;
+
+        u8* const dst = &output[TO_LINEAR ? sector_swizzled : sector_unswizzled];
+        const u8* const src = &input[TO_LINEAR ? sector_unswizzled : sector_swizzled];
+
+        // Fixed size copies are lowered to a single 128-bit load and store on SSE2 and NEON
+        std::memcpy(dst, src, SECTOR_SIZE);
+    }
+}
+
+/// Swizzles 'num_columns' pixels of a line, 'swizzled_base' includes the y and z offsets
+template <bool TO_LINEAR, u32 BYTES_PER_PIXEL>
+void SwizzleLine(std::span<u8> output, std::span<const u8> input, u32 swizzled_base,
+                 u32 unswizzled_base, u32 origin_x, u32 num_columns, u32 x_shift) {
+    const auto swizzle_pixels = [&](u32 begin, u32 end) {
+        u32 swizzled_x = pdep<SWIZZLE_X_BITS>((begin + origin_x) * BYTES_PER_PIXEL);
+        for (u32 column = begin; column < end;
+             ++column, incrpdep<SWIZZLE_X_BITS, BYTES_PER_PIXEL>(swizzled_x)) {
+            const u32 x = (column + origin_x) * BYTES_PER_PIXEL;
+            const u32 offset_x = (x >> GOB_SIZE_X_SHIFT) << x_shift;
+
+            const u32 swizzled_offset = swizzled_base + offset_x + swizzled_x;
+            const u32 unswizzled_offset = unswizzled_base + column * BYTES_PER_PIXEL;
+
+            u8* const dst = &output[TO_LINEAR ? swizzled_offset : unswizzled_offset];
+            const u8* const src = &input[TO_LINEAR ? unswizzled_offset : swizzled_offset];
+
+            std::memcpy(dst, src, BYTES_PER_PIXEL);
+        }
+    };
+    if constexpr (GOB_SIZE_X % BYTES_PER_PIXEL != 0) {
+        swizzle_pixels(0, num_columns);
+    } else {
+        // Copy whole GOB rows once the line is aligned to a GOB, pixel by pixel otherwise
+        static constexpr u32 GOB_ROW_PIXELS = GOB_SIZE_X / BYTES_PER_PIXEL;
+        const u32 misalignment = origin_x % GOB_ROW_PIXELS;
+        u32 column = std::min(num_columns, misalignment != 0 ? GOB_ROW_PIXELS - misalignment : 0);
+        swizzle_pixels(0, column);
+        for (; column + GOB_ROW_PIXELS <= num_columns; column += GOB_ROW_PIXELS) {
+            const u32 x = (column + origin_x) * BYTES_PER_PIXEL;
+            const u32 offset_x = (x >> GOB_SIZE_X_SHIFT) << x_shift;
+            SwizzleGobRow<TO_LINEAR>(output, input, swizzled_base + offset_x,
+                                     unswizzled_base + column * BYTES_PER_PIXEL);
+        }
+        swizzle_pixels(column, num_columns);
+    }
+}
+
 template <bool TO_LINEAR, u32 BYTES_PER_PIXEL>
 void SwizzleImpl(std::span<u8> output, std::span<const u8> input, u32 width, u32 height, u32 depth,
                  u32 block_height, u32 block_depth, u32 stride) {
@@ -67,23 +129,9 @@ void SwizzleImpl(std::span<u8> output, std::span<const u8> input, u32 width, u32
             const u32 offset_y = (block_y >> block_height) * block_size +
                                  ((block_y & block_height_mask) << GOB_SIZE_SHIFT);
 
-            u32 swizzled_x = pdep<SWIZZLE_X_BITS>(origin_x * BYTES_PER_PIXEL);
-            for (u32 column = 0; column < width;
-                 ++column, incrpdep<SWIZZLE_X_BITS, BYTES_PER_PIXEL>(swizzled_x)) {
-                const u32 x = (column + origin_x) * BYTES_PER_PIXEL;
-                const u32 offset_x = (x >> GOB_SIZE_X_SHIFT) << x_shift;
-
-                const u32 base_swizzled_offset = offset_z + offset_y + offset_x;
-                const u32 swizzled_offset = base_swizzled_offset + (swizzled_x | swizzled_y);
-
-                const u32 unswizzled_offset =
-                    slice * pitch * height + line * pitch + column * BYTES_PER_PIXEL;
-
-                u8* const dst = &output[TO_LINEAR ? swizzled_offset : unswizzled_offset];
-                const u8* const src = &input[TO_LINEAR ? unswizzled_offset : swizzled_offset];
-
-                std::memcpy(dst, src, BYTES_PER_PIXEL);
-            }
+            SwizzleLine<TO_LINEAR, BYTES_PER_PIXEL>(
+                output, input, offset_z + offset_y + swizzled_y,
+                slice * pitch * height + line * pitch, origin_x, width, x_shift);
         }
     }
 }
@@ -126,23 +174,9 @@ void SwizzleSubrectImpl(std::span<u8> output, std::span<const u8> input, u32 wid
             const u32 offset_y = (block_y >> block_height) * block_size +
                                  ((block_y & block_height_mask) << GOB_SIZE_SHIFT);
 
-            u32 swizzled_x = pdep<SWIZZLE_X_BITS>(origin_x * BYTES_PER_PIXEL);
-            for (u32 column = 0; column < extent_x;
-                 ++column, incrpdep<SWIZZLE_X_BITS, BYTES_PER_PIXEL>(swizzled_x)) {
-                const u32 x = (column + origin_x) * BYTES_PER_PIXEL;
-                const u32 offset_x = (x >> GOB_SIZE_X_SHIFT) << x_shift;
-
-                const u32 base_swizzled_offset = offset_z + offset_y + offset_x;
-                const u32 swizzled_offset = base_swizzled_offset + (swizzled_x | swizzled_y);
-
-                const u32 unswizzled_offset =
-                    slice * pitch * height + line * pitch + column * BYTES_PER_PIXEL;
-
-                u8* const dst = &output[TO_LINEAR ? swizzled_offset : unswizzled_offset];
-                const u8* const src = &input[TO_LINEAR ? unswizzled_offset : swizzled_offset];
-
-                std::memcpy(dst, src, BYTES_PER_PIXEL);
-            }
+            SwizzleLine<TO_LINEAR, BYTES_PER_PIXEL>(
+                output, input, offset_z + offset_y + swizzled_y,
+                slice * pitch * height + line * pitch, origin_x, extent_x, x_shift);
         }
         unprocessed_lines -= lines_in_y;
         if (unprocessed_lines == 0) {
@@ -258,6 +292,20 @@ std::size_t CalculateSize(bool tiled, u32 bytes_per_pixel, u32 width, u32 height
     }
 }
 
+BlockRowRange CalculateBlockRowRange(u32 bytes_per_pixel, u32 width, u32 origin_y, u32 num_lines,
+                                     u32 block_height, u32 block_depth) {
+    const u32 lines_per_block = GOB_SIZE_Y << block_height;
+    const u32 first_block = origin_y / lines_per_block;
+    const u32 last_block = (origin_y + std::max(num_lines, 1U) - 1) / lines_per_block;
+    const std::size_t block_row_size =
+        CalculateSize(true, bytes_per_pixel, width, lines_per_block, 1, block_height, block_depth);
+    return BlockRowRange{
+        .first_line = first_block * lines_per_block,
+        .offset = first_block * block_row_size,
+        .size = (last_block - first_block + 1) * block_row_size,
+    };
+}
+
 u64 GetGOBOffset(u32 width, u32 height, u32 dst_x, u32 dst_y, u32 block_height,
                  u32 bytes_per_pixel) {
     auto div_ceil = [](const u32 x, const u32 y) { return ((x + y - 1) / y); };
@@ -55,6 +55,17 @@ void SwizzleTexture(std::span<u8> output, std::span<const u8> input, u32 bytes_p
 std::size_t CalculateSize(bool tiled, u32 bytes_per_pixel, u32 width, u32 height, u32 depth,
                           u32 block_height, u32 block_depth);
 
+/// Range of a block linear surface covering whole rows of blocks.
+struct BlockRowRange {
+    u32 first_line;     ///< First line of the range.
+    std::size_t offset; ///< Offset in bytes from the start of the surface.
+    std::size_t size;   ///< Size in bytes.
+};
+
+/// Calculates the rows of blocks holding lines [origin_y, origin_y + num_lines) of the first slice.
+BlockRowRange CalculateBlockRowRange(u32 bytes_per_pixel, u32 width, u32 origin_y, u32 num_lines,
+                                     u32 block_height, u32 block_depth);
+
 /// Copies an untiled subrectangle into a tiled surface.
 void SwizzleSubrect(std::span<u8> output, std::span<const u8> input, u32 bytes_per_pixel, u32 width,
                     u32 height, u32 depth, u32 origin_x, u32 origin_y, u32 extent_x, u32 extent_y,
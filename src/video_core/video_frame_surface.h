@@ -0,0 +1,22 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "common/common_types.h"
+#include "video_core/surface.h"
+
+namespace VideoCore {
+
+/// Surface a decoded video frame is written to
+struct VideoFrameSurface {
+    DAddr address;
+    Surface::PixelFormat format;
+    u32 width;
+    u32 height;
+    /// Log2 of the block height in GOBs of a block linear surface
+    u32 block_height;
+    bool is_block_linear;
+};
+
+} // namespace VideoCore
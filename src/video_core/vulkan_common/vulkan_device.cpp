@@ -11,6 +11,7 @@
 #include <vector>
 
 #include "common/assert.h"
+#include "common/cityhash.h"
 #include "common/literals.h"
 #include "common/polyfill_ranges.h"
 #include "common/settings.h"
@@ -714,6 +715,7 @@ Device::Device(VkInstance instance_, vk::PhysicalDevice physical_, VkSurfaceKHR
                                VK_EXT_EXTENDED_DYNAMIC_STATE_3_EXTENSION_NAME);
         dynamic_state3_blending = false;
         dynamic_state3_enables = false;
+        dynamic_state3_rasterization = false;
     }
 
     logical = vk::Device::Create(physical, queue_cis, ExtensionListForVulkan(loaded_extensions),
@@ -721,6 +723,9 @@ Device::Device(VkInstance instance_, vk::PhysicalDevice physical_, VkSurfaceKHR
 
     graphics_queue = logical.GetQueue(graphics_family);
     present_queue = logical.GetQueue(present_family);
+    if (has_transfer_queue) {
+        transfer_queue = logical.GetQueue(transfer_family);
+    }
 
     VmaVulkanFunctions functions{};
     functions.vkGetInstanceProcAddr = dld.vkGetInstanceProcAddr;
@@ -848,6 +853,17 @@ bool Device::IsFormatSupported(VkFormat wanted_format, VkFormatFeatureFlags want
     return (supported_usage & wanted_usage) == wanted_usage;
 }
 
+u64 Device::GetDriverFingerprint() const {
+    // Custom driver builds may share a version number, their build information tells them apart
+    std::string identity = fmt::format(
+        "{:08x}{:08x}{:08x}{:08x}{}", properties.properties.vendorID,
+        properties.properties.deviceID, static_cast<u32>(properties.driver.driverID),
+        properties.properties.driverVersion, properties.driver.driverInfo);
+    identity.append(reinterpret_cast<const char*>(properties.properties.pipelineCacheUUID),
+                    VK_UUID_SIZE);
+    return Common::CityHash64(identity.data(), identity.size());
+}
+
 std::string Device::GetDriverName() const {
     switch (properties.driver.driverID) {
     case VK_DRIVER_ID_AMD_PROPRIETARY:
@@ -1096,6 +1112,11 @@ bool Device::GetSuitability(bool requires_swapchain) {
             VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TRANSFORM_FEEDBACK_PROPERTIES_EXT;
         SetNext(next, properties.transform_feedback);
     }
+    if (extensions.graphics_pipeline_library) {
+        properties.graphics_pipeline_library.sType =
+            VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_PROPERTIES_EXT;
+        SetNext(next, properties.graphics_pipeline_library);
+    }
 
     // Perform the property fetch.
     physical.GetProperties2(properties2);
@@ -1169,14 +1190,41 @@ void Device::RemoveUnsuitableExtensions() {
     dynamic_state3_enables =
         features.extended_dynamic_state3.extendedDynamicState3DepthClampEnable &&
         features.extended_dynamic_state3.extendedDynamicState3LogicOpEnable;
+    dynamic_state3_rasterization =
+        features.extended_dynamic_state3.extendedDynamicState3PolygonMode &&
+        features.extended_dynamic_state3.extendedDynamicState3AlphaToCoverageEnable;
 
-    extensions.extended_dynamic_state3 = dynamic_state3_blending || dynamic_state3_enables;
+    extensions.extended_dynamic_state3 =
+        dynamic_state3_blending || dynamic_state3_enables || dynamic_state3_rasterization;
     dynamic_state3_blending = dynamic_state3_blending && extensions.extended_dynamic_state3;
     dynamic_state3_enables = dynamic_state3_enables && extensions.extended_dynamic_state3;
+    dynamic_state3_rasterization =
+        dynamic_state3_rasterization && extensions.extended_dynamic_state3;
     RemoveExtensionFeatureIfUnsuitable(extensions.extended_dynamic_state3,
                                        features.extended_dynamic_state3,
                                        VK_EXT_EXTENDED_DYNAMIC_STATE_3_EXTENSION_NAME);
 
+    // VK_EXT_graphics_pipeline_library
+    if (Settings::values.use_graphics_pipeline_library.GetValue()) {
+        extensions.graphics_pipeline_library =
+            extensions.pipeline_library &&
+            features.graphics_pipeline_library.graphicsPipelineLibrary &&
+            properties.graphics_pipeline_library.graphicsPipelineLibraryFastLinking;
+        RemoveExtensionFeatureIfUnsuitable(extensions.graphics_pipeline_library,
+                                           features.graphics_pipeline_library,
+                                           VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME);
+    } else {
+        RemoveExtensionFeature(extensions.graphics_pipeline_library,
+                               features.graphics_pipeline_library,
+                               VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME);
+    }
+
+    // VK_EXT_nested_command_buffer
+    extensions.nested_command_buffer = features.nested_command_buffer.nestedCommandBuffer;
+    RemoveExtensionFeatureIfUnsuitable(extensions.nested_command_buffer,
+                                       features.nested_command_buffer,
+                                       VK_EXT_NESTED_COMMAND_BUFFER_EXTENSION_NAME);
+
     // VK_EXT_provoking_vertex
     extensions.provoking_vertex =
         features.provoking_vertex.provokingVertexLast &&
@@ -1263,6 +1311,7 @@ void Device::SetupFamilies(VkSurfaceKHR surface) {
         }
         if (queue_family.queueFlags & VK_QUEUE_GRAPHICS_BIT) {
             graphics = index;
+            has_sparse_binding_queue = (queue_family.queueFlags & VK_QUEUE_SPARSE_BINDING_BIT) != 0;
         }
         if (surface && physical.GetSurfaceSupportKHR(index, surface)) {
             present = index;
@@ -1282,6 +1331,25 @@ void Device::SetupFamilies(VkSurfaceKHR surface) {
     if (present) {
         present_family = *present;
     }
+    if (!Settings::values.use_async_transfer_queue.GetValue()) {
+        return;
+    }
+    for (u32 index = 0; index < static_cast<u32>(queue_family_properties.size()); ++index) {
+        // Transfer only families map to copy engines that run in parallel with rendering
+        const VkQueueFamilyProperties& queue_family = queue_family_properties[index];
+        const VkQueueFlags queue_flags = queue_family.queueFlags;
+        const VkExtent3D& granularity = queue_family.minImageTransferGranularity;
+        if (queue_family.queueCount == 0 || (queue_flags & VK_QUEUE_TRANSFER_BIT) == 0 ||
+            (queue_flags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT)) != 0) {
+            continue;
+        }
+        if (granularity.width != 1 || granularity.height != 1 || granularity.depth != 1) {
+            continue;
+        }
+        transfer_family = index;
+        has_transfer_queue = true;
+        break;
+    }
 }
 
 u64 Device::GetDeviceMemoryUsage() const {
@@ -1296,6 +1364,18 @@ u64 Device::GetDeviceMemoryUsage() const {
     return result;
 }
 
+u64 Device::GetDeviceMemoryBudget() const {
+    VkPhysicalDeviceMemoryBudgetPropertiesEXT budget;
+    budget.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+    budget.pNext = nullptr;
+    physical.GetMemoryProperties(&budget);
+    u64 result{};
+    for (const size_t heap : valid_heap_memory) {
+        result += budget.heapBudget[heap];
+    }
+    return result;
+}
+
 void Device::CollectPhysicalMemoryInfo() {
     // Calculate limits using memory budget
     VkPhysicalDeviceMemoryBudgetPropertiesEXT budget{};
@@ -1360,6 +1440,9 @@ std::vector<VkDeviceQueueCreateInfo> Device::GetDeviceQueueCreateInfos() const {
     static constexpr float QUEUE_PRIORITY = 1.0f;
 
     std::unordered_set<u32> unique_queue_families{graphics_family, present_family};
+    if (has_transfer_queue) {
+        unique_queue_families.insert(transfer_family);
+    }
     std::vector<VkDeviceQueueCreateInfo> queue_cis;
     queue_cis.reserve(unique_queue_families.size());
 
@@ -47,8 +47,10 @@ VK_DEFINE_HANDLE(VmaAllocator)
     FEATURE(EXT, ExtendedDynamicState2, EXTENDED_DYNAMIC_STATE_2, extended_dynamic_state2)         \
     FEATURE(EXT, ExtendedDynamicState3, EXTENDED_DYNAMIC_STATE_3, extended_dynamic_state3)         \
     FEATURE(EXT, 4444Formats, 4444_FORMATS, format_a4b4g4r4)                                       \
+    FEATURE(EXT, GraphicsPipelineLibrary, GRAPHICS_PIPELINE_LIBRARY, graphics_pipeline_library)    \
     FEATURE(EXT, IndexTypeUint8, INDEX_TYPE_UINT8, index_type_uint8)                               \
     FEATURE(EXT, LineRasterization, LINE_RASTERIZATION, line_rasterization)                        \
+    FEATURE(EXT, NestedCommandBuffer, NESTED_COMMAND_BUFFER, nested_command_buffer)                \
     FEATURE(EXT, PrimitiveTopologyListRestart, PRIMITIVE_TOPOLOGY_LIST_RESTART,                    \
             primitive_topology_list_restart)                                                       \
     FEATURE(EXT, ProvokingVertex, PROVOKING_VERTEX, provoking_vertex)                              \
@@ -74,6 +76,7 @@ VK_DEFINE_HANDLE(VmaAllocator)
     EXTENSION(EXT, VERTEX_ATTRIBUTE_DIVISOR, vertex_attribute_divisor)                             \
     EXTENSION(KHR, DRAW_INDIRECT_COUNT, draw_indirect_count)                                       \
     EXTENSION(KHR, DRIVER_PROPERTIES, driver_properties)                                           \
+    EXTENSION(KHR, PIPELINE_LIBRARY, pipeline_library)                                             \
     EXTENSION(KHR, PUSH_DESCRIPTOR, push_descriptor)                                               \
     EXTENSION(KHR, SAMPLER_MIRROR_CLAMP_TO_EDGE, sampler_mirror_clamp_to_edge)                     \
     EXTENSION(KHR, SHADER_FLOAT_CONTROLS, shader_float_controls)                                   \
@@ -257,6 +260,21 @@ public:
         return present_family;
     }
 
+    /// Returns the dedicated transfer queue.
+    vk::Queue GetTransferQueue() const {
+        return transfer_queue;
+    }
+
+    /// Returns the dedicated transfer queue family index.
+    u32 GetTransferFamily() const {
+        return transfer_family;
+    }
+
+    /// Returns true if the device exposes a transfer queue without graphics and compute support.
+    bool HasDedicatedTransferQueue() const {
+        return has_transfer_queue;
+    }
+
     /// Returns the current Vulkan API version provided in Vulkan-formatted version numbers.
     u32 ApiVersion() const {
         return properties.properties.apiVersion;
@@ -267,6 +285,11 @@ public:
         return properties.properties.driverVersion;
     }
 
+    /// Returns the UUID identifying pipeline caches compatible with this device and driver.
+    std::span<const u8, VK_UUID_SIZE> GetPipelineCacheUUID() const {
+        return properties.properties.pipelineCacheUUID;
+    }
+
     /// Returns the device name.
     std::string_view GetModelName() const {
         return properties.properties.deviceName;
@@ -277,6 +300,9 @@ public:
         return properties.driver.driverID;
     }
 
+    /// Returns a hash identifying the device and the exact driver build running on it.
+    u64 GetDriverFingerprint() const;
+
     bool ShouldBoostClocks() const;
 
     /// Returns uniform buffer alignment requirement.
@@ -289,6 +315,16 @@ public:
         return properties.properties.limits.minStorageBufferOffsetAlignment;
     }
 
+    /// Returns true when timestamps can be written on all graphics and compute queues.
+    bool SupportsTimestampQueries() const {
+        return properties.properties.limits.timestampComputeAndGraphics == VK_TRUE;
+    }
+
+    /// Returns the number of nanoseconds per timestamp tick.
+    float GetTimestampPeriod() const {
+        return properties.properties.limits.timestampPeriod;
+    }
+
     /// Returns the maximum range for storage buffers.
     VkDeviceSize GetMaxStorageBufferRange() const {
         return properties.properties.limits.maxStorageBufferRange;
@@ -444,6 +480,13 @@ public:
         return extensions.image_format_list || instance_version >= VK_API_VERSION_1_2;
     }
 
+    /// Returns true if 2D images can be partially resident through the main graphics queue.
+    bool IsSparseImageResidencySupported() const {
+        return has_sparse_binding_queue && features.features.sparseBinding &&
+               features.features.sparseResidencyImage2D &&
+               properties.properties.sparseProperties.residencyStandard2DBlockShape;
+    }
+
     /// Returns true if the device supports VK_EXT_primitive_topology_list_restart.
     bool IsTopologyListPrimitiveRestartSupported() const {
         return features.primitive_topology_list_restart.primitiveTopologyListRestart;
@@ -484,6 +527,11 @@ public:
         return extensions.depth_bias_control;
     }
 
+    /// Returns true if the device supports VK_EXT_nested_command_buffer.
+    bool IsExtNestedCommandBufferSupported() const {
+        return extensions.nested_command_buffer;
+    }
+
     /// Returns true if the device supports VK_EXT_shader_viewport_index_layer.
     bool IsExtShaderViewportIndexLayerSupported() const {
         return extensions.shader_viewport_index_layer;
@@ -543,6 +591,11 @@ public:
         return dynamic_state3_enables;
     }
 
+    /// Returns true if the device supports VK_EXT_extended_dynamic_state3.
+    bool IsExtExtendedDynamicState3RasterizationSupported() const {
+        return dynamic_state3_rasterization;
+    }
+
     /// Returns true if the device supports VK_EXT_line_rasterization.
     bool IsExtLineRasterizationSupported() const {
         return extensions.line_rasterization;
@@ -563,6 +616,12 @@ public:
         return extensions.conservative_rasterization;
     }
 
+    /// Returns true if VK_EXT_graphics_pipeline_library is enabled, it is only enabled on drivers
+    /// that can link pipeline libraries fast enough to do it on draws.
+    bool IsExtGraphicsPipelineLibrarySupported() const {
+        return extensions.graphics_pipeline_library;
+    }
+
     /// Returns true if the device supports VK_EXT_provoking_vertex.
     bool IsExtProvokingVertexSupported() const {
         return extensions.provoking_vertex;
@@ -620,6 +679,11 @@ public:
         return supported_extensions;
     }
 
+    /// Returns true if the device is an integrated GPU sharing memory with the host.
+    bool IsIntegrated() const {
+        return is_integrated;
+    }
+
     u64 GetDeviceLocalMemory() const {
         return device_access_memory;
     }
@@ -630,6 +694,9 @@ public:
 
     u64 GetDeviceMemoryUsage() const;
 
+    /// Returns the budget of the device local heaps reported by VK_EXT_memory_budget
+    u64 GetDeviceMemoryBudget() const;
+
     u32 GetSetsPerPool() const {
         return sets_per_pool;
     }
@@ -666,6 +733,10 @@ public:
         return properties.properties.limits.maxVertexInputBindings;
     }
 
+    u32 GetMaxDescriptorSetUniformBuffersDynamic() const {
+        return properties.properties.limits.maxDescriptorSetUniformBuffersDynamic;
+    }
+
     u32 GetMaxViewports() const {
         return properties.properties.limits.maxViewports;
     }
@@ -750,9 +821,11 @@ private:
     vk::Device logical;          ///< Logical device.
     vk::Queue graphics_queue;    ///< Main graphics queue.
     vk::Queue present_queue;     ///< Main present queue.
+    vk::Queue transfer_queue;    ///< Dedicated transfer queue.
     u32 instance_version{};      ///< Vulkan instance version.
     u32 graphics_family{};       ///< Main graphics queue family index.
     u32 present_family{};        ///< Main present queue family index.
+    u32 transfer_family{};       ///< Dedicated transfer queue family index.
 
     struct Extensions {
 #define EXTENSION(prefix, macro_name, var_name) bool var_name{};
@@ -792,6 +865,7 @@ private:
         VkPhysicalDevicePushDescriptorPropertiesKHR push_descriptor{};
         VkPhysicalDeviceSubgroupSizeControlProperties subgroup_size_control{};
         VkPhysicalDeviceTransformFeedbackPropertiesEXT transform_feedback{};
+        VkPhysicalDeviceGraphicsPipelineLibraryPropertiesEXT graphics_pipeline_library{};
 
         VkPhysicalDeviceProperties properties{};
     };
@@ -822,7 +896,10 @@ private:
     bool must_emulate_bgr565{};                ///< Emulates BGR565 by swizzling RGB565 format.
     bool dynamic_state3_blending{};            ///< Has all blending features of dynamic_state3.
     bool dynamic_state3_enables{};             ///< Has all enables features of dynamic_state3.
+    bool dynamic_state3_rasterization{};       ///< Has rasterization features of dynamic_state3.
     bool supports_conditional_barriers{};      ///< Allows barriers in conditional control flow.
+    bool has_sparse_binding_queue{};           ///< Graphics queue supports sparse binding.
+    bool has_transfer_queue{};                 ///< Has a dedicated transfer queue.
     u64 device_access_memory{};                ///< Total size of device local memory in bytes.
     u32 sets_per_pool{};                       ///< Sets per Description Pool
     NvidiaArchitecture nvidia_arch{NvidiaArchitecture::Arch_AmpereOrNewer};
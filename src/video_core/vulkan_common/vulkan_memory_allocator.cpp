@@ -19,6 +19,13 @@
 
 namespace Vulkan {
 namespace {
+using namespace Common::Literals;
+
+/// Largest image allocated from the small image pools
+constexpr VkDeviceSize SMALL_IMAGE_SIZE = 4_MiB;
+/// Size of the blocks of the small image pools
+constexpr VkDeviceSize SMALL_IMAGE_BLOCK_SIZE = 64_MiB;
+
 struct Range {
     u64 begin;
     u64 end;
@@ -219,7 +226,6 @@ MemoryAllocator::MemoryAllocator(const Device& device_)
     // the heap running out of memory. With RenderDoc attached and only a small host/device region,
     // only allow the stream buffer in this memory heap.
     if (device.HasDebuggingToolAttached()) {
-        using namespace Common::Literals;
         ForEachDeviceLocalHostVisibleHeap(device, [this](size_t index, VkMemoryHeap& heap) {
             if (heap.size <= 256_MiB) {
                 valid_memory_types &= ~(1u << index);
@@ -228,7 +234,13 @@ MemoryAllocator::MemoryAllocator(const Device& device_)
     }
 }
 
-MemoryAllocator::~MemoryAllocator() = default;
+MemoryAllocator::~MemoryAllocator() {
+    for (const VmaPool pool : small_image_pools) {
+        if (pool) {
+            vmaDestroyPool(allocator, pool);
+        }
+    }
+}
 
 vk::Image MemoryAllocator::CreateImage(const VkImageCreateInfo& ci) const {
     const VmaAllocationCreateInfo alloc_ci = {
@@ -242,13 +254,50 @@ vk::Image MemoryAllocator::CreateImage(const VkImageCreateInfo& ci) const {
         .priority = 0.f,
     };
 
+    const vk::DeviceDispatch& dld = device.GetDispatchLoader();
+    const VkDevice logical = *device.GetLogical();
     VkImage handle{};
+    vk::Check(dld.vkCreateImage(logical, &ci, nullptr, &handle));
+
+    // Small images are sub-allocated from their own pools, falling back to the default pools
+    // when a pool can't hold them, e.g. when the driver requires a dedicated allocation
     VmaAllocation allocation{};
+    VkResult result = VK_ERROR_OUT_OF_DEVICE_MEMORY;
+    const VkMemoryRequirements requirements =
+        device.GetLogical().GetImageMemoryRequirements(handle);
+    if (requirements.size <= SMALL_IMAGE_SIZE) {
+        if (const VmaPool pool = SmallImagePool(requirements.memoryTypeBits)) {
+            VmaAllocationCreateInfo pool_alloc_ci = alloc_ci;
+            pool_alloc_ci.pool = pool;
+            result = vmaAllocateMemoryForImage(allocator, handle, &pool_alloc_ci, &allocation,
+                                               nullptr);
+        }
+    }
+    if (result != VK_SUCCESS) {
+        result = vmaAllocateMemoryForImage(allocator, handle, &alloc_ci, &allocation, nullptr);
+    }
+    if (result == VK_SUCCESS) {
+        result = vmaBindImageMemory(allocator, allocation, handle);
+    }
+    if (result != VK_SUCCESS) {
+        if (allocation) {
+            vmaFreeMemory(allocator, allocation);
+        }
+        dld.vkDestroyImage(logical, handle, nullptr);
+        throw vk::Exception(result);
+    }
 
-    vk::Check(vmaCreateImage(allocator, &ci, &alloc_ci, &handle, &allocation, nullptr));
+    return vk::Image(handle, logical, allocator, allocation, dld);
+}
+
+vk::Image MemoryAllocator::CreateSparseImage(const VkImageCreateInfo& ci) const {
+    const vk::DeviceDispatch& dld = device.GetDispatchLoader();
+    const VkDevice logical = *device.GetLogical();
+    VkImage handle{};
+    vk::Check(dld.vkCreateImage(logical, &ci, nullptr, &handle));
 
-    return vk::Image(handle, *device.GetLogical(), allocator, allocation,
-                     device.GetDispatchLoader());
+    // Sparse images have no VMA allocation, destroying them only destroys the image handle
+    return vk::Image(handle, logical, allocator, nullptr, dld);
 }
 
 vk::Buffer MemoryAllocator::CreateBuffer(const VkBufferCreateInfo& ci, MemoryUsage usage) const {
@@ -279,6 +328,47 @@ vk::Buffer MemoryAllocator::CreateBuffer(const VkBufferCreateInfo& ci, MemoryUsa
                       device.GetDispatchLoader());
 }
 
+VmaPool MemoryAllocator::SmallImagePool(u32 type_bits) const {
+    // Automatic usages need the resource's create info, prefer device local memory explicitly
+    const VmaAllocationCreateInfo find_ci = {
+        .flags = 0,
+        .usage = VMA_MEMORY_USAGE_UNKNOWN,
+        .requiredFlags = 0,
+        .preferredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+        .memoryTypeBits = 0,
+        .pool = VK_NULL_HANDLE,
+        .pUserData = nullptr,
+        .priority = 0.f,
+    };
+    u32 type_index{};
+    if (vmaFindMemoryTypeIndex(allocator, type_bits, &find_ci, &type_index) != VK_SUCCESS) {
+        return VK_NULL_HANDLE;
+    }
+
+    std::scoped_lock lock{small_image_pools_mutex};
+    VmaPool& pool = small_image_pools[type_index];
+    if (pool || (failed_small_image_pools & (1U << type_index)) != 0) {
+        return pool;
+    }
+    const VmaPoolCreateInfo pool_ci = {
+        .memoryTypeIndex = type_index,
+        .flags = 0,
+        .blockSize = SMALL_IMAGE_BLOCK_SIZE,
+        .minBlockCount = 0,
+        .maxBlockCount = 0,
+        .priority = 0.f,
+        .minAllocationAlignment = 0,
+        .pMemoryAllocateNext = nullptr,
+    };
+    if (vmaCreatePool(allocator, &pool_ci, &pool) != VK_SUCCESS) {
+        LOG_WARNING(Render_Vulkan, "Failed to create small image pool for memory type {}",
+                    type_index);
+        failed_small_image_pools |= 1U << type_index;
+        pool = VK_NULL_HANDLE;
+    }
+    return pool;
+}
+
 MemoryCommit MemoryAllocator::Commit(const VkMemoryRequirements& requirements, MemoryUsage usage) {
     // Find the fastest memory flags we can afford with the current requirements
     const u32 type_mask = requirements.memoryTypeBits;
@@ -3,7 +3,9 @@
 
 #pragma once
 
+#include <array>
 #include <memory>
+#include <mutex>
 #include <span>
 #include <vector>
 #include "common/common_types.h"
@@ -11,6 +13,7 @@
 #include "video_core/vulkan_common/vulkan_wrapper.h"
 
 VK_DEFINE_HANDLE(VmaAllocator)
+VK_DEFINE_HANDLE(VmaPool)
 
 namespace Vulkan {
 
@@ -99,6 +102,10 @@ public:
 
     vk::Image CreateImage(const VkImageCreateInfo& ci) const;
 
+    /// Creates an image without any memory bound to it, its memory has to be bound with sparse
+    /// binding operations.
+    vk::Image CreateSparseImage(const VkImageCreateInfo& ci) const;
+
     vk::Buffer CreateBuffer(const VkBufferCreateInfo& ci, MemoryUsage usage) const;
 
     /**
@@ -115,6 +122,9 @@ public:
     MemoryCommit Commit(const vk::Buffer& buffer, MemoryUsage usage);
 
 private:
+    /// Returns the pool small images compatible with the memory type bits are allocated from.
+    VmaPool SmallImagePool(u32 type_bits) const;
+
     /// Tries to allocate a chunk of memory.
     bool TryAllocMemory(VkMemoryPropertyFlags flags, u32 type_mask, u64 size);
 
@@ -138,6 +148,12 @@ private:
     VkDeviceSize buffer_image_granularity; // The granularity for adjacent offsets between buffers
                                            // and optimal images
     u32 valid_memory_types{~0u};
+
+    /// Small images are kept apart from large ones, so released render targets and large
+    /// textures free whole blocks instead of leaving holes pinned by small textures.
+    mutable std::mutex small_image_pools_mutex;
+    mutable std::array<VmaPool, VK_MAX_MEMORY_TYPES> small_image_pools{};
+    mutable u32 failed_small_image_pools{}; ///< Mask of memory types whose pool failed to create
 };
 
 } // namespace Vulkan
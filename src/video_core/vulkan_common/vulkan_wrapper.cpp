@@ -118,6 +118,7 @@ void Load(VkDevice device, DeviceDispatch& dld) noexcept {
     X(vkCmdEndRenderPass);
     X(vkCmdEndTransformFeedbackEXT);
     X(vkCmdEndDebugUtilsLabelEXT);
+    X(vkCmdExecuteCommands);
     X(vkCmdFillBuffer);
     X(vkCmdPipelineBarrier);
     X(vkCmdPushConstants);
@@ -133,6 +134,7 @@ void Load(VkDevice device, DeviceDispatch& dld) noexcept {
     X(vkCmdSetStencilWriteMask);
     X(vkCmdSetViewport);
     X(vkCmdWaitEvents);
+    X(vkCmdWriteTimestamp);
     X(vkCmdBindVertexBuffers2EXT);
     X(vkCmdSetCullModeEXT);
     X(vkCmdSetDepthBoundsTestEnableEXT);
@@ -144,6 +146,8 @@ void Load(VkDevice device, DeviceDispatch& dld) noexcept {
     X(vkCmdSetDepthBiasEnableEXT);
     X(vkCmdSetLogicOpEnableEXT);
     X(vkCmdSetDepthClampEnableEXT);
+    X(vkCmdSetPolygonModeEXT);
+    X(vkCmdSetAlphaToCoverageEnableEXT);
     X(vkCmdSetFrontFaceEXT);
     X(vkCmdSetLogicOpEXT);
     X(vkCmdSetPatchControlPointsEXT);
@@ -207,6 +211,7 @@ void Load(VkDevice device, DeviceDispatch& dld) noexcept {
     X(vkGetEventStatus);
     X(vkGetFenceStatus);
     X(vkGetImageMemoryRequirements);
+    X(vkGetImageSparseMemoryRequirements);
     X(vkGetPipelineCacheData);
     X(vkGetMemoryFdKHR);
 #ifdef _WIN32
@@ -217,6 +222,7 @@ void Load(VkDevice device, DeviceDispatch& dld) noexcept {
     X(vkGetPipelineExecutableStatisticsKHR);
     X(vkGetSemaphoreCounterValue);
     X(vkMapMemory);
+    X(vkQueueBindSparse);
     X(vkQueueSubmit);
     X(vkResetFences);
     X(vkResetQueryPool);
@@ -282,6 +288,7 @@ bool Load(VkInstance instance, InstanceDispatch& dld) noexcept {
     X(vkDestroySurfaceKHR);
     X(vkGetPhysicalDeviceFeatures2);
     X(vkGetPhysicalDeviceProperties2);
+    X(vkGetPhysicalDeviceSparseImageFormatProperties);
     X(vkGetPhysicalDeviceSurfaceCapabilitiesKHR);
     X(vkGetPhysicalDeviceSurfaceFormatsKHR);
     X(vkGetPhysicalDeviceSurfacePresentModesKHR);
@@ -502,6 +509,12 @@ void Buffer::Invalidate() const {
     }
 }
 
+void Buffer::Invalidate(VkDeviceSize offset, VkDeviceSize size) const {
+    if (!is_coherent) {
+        vmaInvalidateAllocation(allocator, allocation, offset, size);
+    }
+}
+
 void Buffer::SetObjectNameEXT(const char* name) const {
     SetObjectName(dld, owner, handle, VK_OBJECT_TYPE_BUFFER, name);
 }
@@ -819,6 +832,15 @@ VkMemoryRequirements Device::GetImageMemoryRequirements(VkImage image) const noe
     return requirements;
 }
 
+std::vector<VkSparseImageMemoryRequirements> Device::GetImageSparseMemoryRequirements(
+    VkImage image) const {
+    u32 num;
+    dld->vkGetImageSparseMemoryRequirements(handle, image, &num, nullptr);
+    std::vector<VkSparseImageMemoryRequirements> requirements(num);
+    dld->vkGetImageSparseMemoryRequirements(handle, image, &num, requirements.data());
+    return requirements;
+}
+
 std::vector<VkPipelineExecutablePropertiesKHR> Device::GetPipelineExecutablePropertiesKHR(
     VkPipeline pipeline) const {
     const VkPipelineInfoKHR info{
@@ -888,6 +910,21 @@ VkFormatProperties PhysicalDevice::GetFormatProperties(VkFormat format) const no
     return properties;
 }
 
+std::vector<VkSparseImageFormatProperties> PhysicalDevice::GetSparseImageFormatProperties(
+    VkFormat format, VkImageType type, VkSampleCountFlagBits samples, VkImageUsageFlags usage,
+    VkImageTiling tiling) const {
+    if (!dld->vkGetPhysicalDeviceSparseImageFormatProperties) {
+        return {};
+    }
+    u32 num;
+    dld->vkGetPhysicalDeviceSparseImageFormatProperties(physical_device, format, type, samples,
+                                                        usage, tiling, &num, nullptr);
+    std::vector<VkSparseImageFormatProperties> properties(num);
+    dld->vkGetPhysicalDeviceSparseImageFormatProperties(physical_device, format, type, samples,
+                                                        usage, tiling, &num, properties.data());
+    return properties;
+}
+
 std::vector<VkExtensionProperties> PhysicalDevice::EnumerateDeviceExtensionProperties() const {
     u32 num;
     dld->vkEnumerateDeviceExtensionProperties(physical_device, nullptr, &num, nullptr);
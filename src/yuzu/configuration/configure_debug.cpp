@@ -43,6 +43,11 @@ void ConfigureDebug::SetConfiguration() {
         QString::fromStdString(Settings::values.program_args.GetValue()));
     ui->fs_access_log->setEnabled(runtime_lock);
     ui->fs_access_log->setChecked(Settings::values.enable_fs_access_log.GetValue());
+    ui->profile_guest_cpu->setEnabled(runtime_lock);
+    ui->profile_guest_cpu->setChecked(Settings::values.profile_guest_cpu.GetValue());
+    ui->enable_tracing->setEnabled(runtime_lock);
+    ui->enable_tracing->setChecked(Settings::values.enable_tracing.GetValue());
+    ui->show_perf_metrics->setChecked(Settings::values.show_perf_metrics.GetValue());
     ui->reporting_services->setChecked(Settings::values.reporting_services.GetValue());
     ui->dump_audio_commands->setChecked(Settings::values.dump_audio_commands.GetValue());
     ui->quest_flag->setChecked(Settings::values.quest_flag.GetValue());
@@ -65,6 +70,13 @@ void ConfigureDebug::SetConfiguration() {
     ui->dump_shaders->setChecked(Settings::values.dump_shaders.GetValue());
     ui->dump_macros->setEnabled(runtime_lock);
     ui->dump_macros->setChecked(Settings::values.dump_macros.GetValue());
+    ui->profile_macros->setEnabled(runtime_lock);
+    ui->profile_macros->setChecked(Settings::values.profile_macros.GetValue());
+    ui->profile_shader_compilation->setEnabled(runtime_lock);
+    ui->profile_shader_compilation->setChecked(
+        Settings::values.profile_shader_compilation.GetValue());
+    ui->profile_gpu_timestamps->setEnabled(runtime_lock);
+    ui->profile_gpu_timestamps->setChecked(Settings::values.profile_gpu_timestamps.GetValue());
     ui->disable_macro_jit->setEnabled(runtime_lock);
     ui->disable_macro_jit->setChecked(Settings::values.disable_macro_jit.GetValue());
     ui->disable_macro_hle->setEnabled(runtime_lock);
@@ -90,6 +102,9 @@ void ConfigureDebug::ApplyConfiguration() {
     Settings::values.log_filter = ui->log_filter_edit->text().toStdString();
     Settings::values.program_args = ui->homebrew_args_edit->text().toStdString();
     Settings::values.enable_fs_access_log = ui->fs_access_log->isChecked();
+    Settings::values.profile_guest_cpu = ui->profile_guest_cpu->isChecked();
+    Settings::values.enable_tracing = ui->enable_tracing->isChecked();
+    Settings::values.show_perf_metrics = ui->show_perf_metrics->isChecked();
     Settings::values.reporting_services = ui->reporting_services->isChecked();
     Settings::values.dump_audio_commands = ui->dump_audio_commands->isChecked();
     Settings::values.quest_flag = ui->quest_flag->isChecked();
@@ -104,6 +119,9 @@ void ConfigureDebug::ApplyConfiguration() {
     Settings::values.enable_nsight_aftermath = ui->enable_nsight_aftermath->isChecked();
     Settings::values.dump_shaders = ui->dump_shaders->isChecked();
     Settings::values.dump_macros = ui->dump_macros->isChecked();
+    Settings::values.profile_macros = ui->profile_macros->isChecked();
+    Settings::values.profile_shader_compilation = ui->profile_shader_compilation->isChecked();
+    Settings::values.profile_gpu_timestamps = ui->profile_gpu_timestamps->isChecked();
     Settings::values.disable_shader_loop_safety_checks =
         ui->disable_loop_safety_checks->isChecked();
     Settings::values.disable_macro_jit = ui->disable_macro_jit->isChecked();
@@ -50,6 +50,17 @@ std::unique_ptr<TranslationMap> InitializeTranslations(QWidget* parent) {
     INSERT(Settings, audio_muted, tr("Mute audio"), QStringLiteral());
     INSERT(Settings, volume, tr("Volume:"), QStringLiteral());
     INSERT(Settings, dump_audio_commands, QStringLiteral(), QStringLiteral());
+    INSERT(Settings, audio_host_timing, tr("Drop voices based on host processing time"),
+           tr("Measures how long this computer takes to process each audio command, and uses it "
+              "instead of the console's timings\nto decide when games drop voices. Helps avoid "
+              "crackling on slower CPUs."));
+    INSERT(Settings, audio_low_latency, tr("Low latency audio"),
+           tr("Uses the smallest buffer the audio device supports, and keeps as few buffers "
+              "queued as the device's timing allows.\nReduces audio latency, but may crackle on "
+              "devices with unsteady timing."));
+    INSERT(Settings, audio_time_stretch, tr("Time stretch audio"),
+           tr("Stretches audio to the emulation speed while it is not running at full speed, "
+              "keeping its pitch.\nAvoids crackling when emulation slows down."));
     INSERT(UISettings, mute_when_in_background, tr("Mute audio when in background"),
            QStringLiteral());
 
@@ -164,6 +175,13 @@ std::unique_ptr<TranslationMap> InitializeTranslations(QWidget* parent) {
            "the emulator to decompress to an intermediate format any card supports, RGBA8.\n"
            "This option recompresses RGBA8 to either the BC1 or BC3 format, saving VRAM but "
            "negatively affecting image quality."));
+    INSERT(Settings, use_astc_transcode_cache, tr("Cache decoded ASTC textures on disk"),
+           tr("Stores ASTC textures decoded or recompressed on the CPU on disk, so they are not "
+              "decoded again in later sessions.\nUses additional disk space."));
+    INSERT(Settings, use_sparse_image_residency, tr("Use sparse residency for large textures"),
+           tr("Only backs the mip levels and layers of large texture arrays that are uploaded or "
+              "rendered to with video memory.\nReduces VRAM usage on games with huge texture "
+              "arrays. Vulkan only."));
     INSERT(Settings, vram_usage_mode, tr("VRAM Usage Mode:"),
            tr("Selects whether the emulator should prefer to conserve memory or make maximum usage "
               "of available video memory for performance. Has no effect on integrated graphics. "
@@ -183,10 +201,21 @@ std::unique_ptr<TranslationMap> InitializeTranslations(QWidget* parent) {
     // Renderer (Advanced Graphics)
     INSERT(Settings, async_presentation, tr("Enable asynchronous presentation (Vulkan only)"),
            tr("Slightly improves performance by moving presentation to a separate CPU thread."));
+    INSERT(Settings, frame_pacing, tr("Enable frame pacing (Vulkan only)"),
+           tr("Presents frames at the measured average frame rate so frame times stay steady.\n"
+              "Requires asynchronous presentation. May add up to one frame of latency."));
+    INSERT(Settings, low_latency_mode, tr("Low latency mode (Vulkan only)"),
+           tr("Keeps only one frame in flight on the GPU and delays the start of the next emulated "
+              "frame by the measured GPU headroom.\nReduces input latency when GPU bound at a "
+              "small cost in frame rate."));
     INSERT(
         Settings, renderer_force_max_clock, tr("Force maximum clocks (Vulkan only)"),
         tr("Runs work in the background while waiting for graphics commands to keep the GPU from "
            "lowering its clock speed."));
+    INSERT(Settings, use_parallel_command_recording,
+           tr("Enable parallel command recording (Vulkan only)"),
+           tr("Records independent groups of graphics commands on multiple CPU threads.\nMay "
+              "improve performance in draw-heavy games on CPUs with many cores."));
     INSERT(Settings, max_anisotropy, tr("Anisotropic Filtering:"),
            tr("Controls the quality of texture rendering at oblique angles.\nIt’s a light setting "
               "and safe to set at 16x on most GPUs."));
@@ -200,6 +229,24 @@ std::unique_ptr<TranslationMap> InitializeTranslations(QWidget* parent) {
            tr("Enables asynchronous shader compilation, which may reduce shader stutter.\nThis "
               "feature "
               "is experimental."));
+    INSERT(Settings, use_async_fallback_pipelines,
+           tr("Draw with fallback pipelines while shaders build (Vulkan only)"),
+           tr("While a pipeline is built asynchronously, draws with an already built pipeline "
+              "using the same shaders instead of skipping them.\nReduces pop-in at the cost of "
+              "briefly incorrect blending or depth state."));
+    INSERT(Settings, use_graphics_pipeline_library,
+           tr("Use graphics pipeline libraries (Vulkan only)"),
+           tr("Compiles the shader stages of new pipelines separately and links them quickly "
+              "for immediate use, then links an optimized pipeline in the background.\nOnly "
+              "used on drivers with fast linking support."));
+    INSERT(Settings, use_async_transfer_queue, tr("Use dedicated transfer queue (Vulkan only)"),
+           tr("Uploads large textures through the copy engine of the GPU, in parallel with "
+              "rendering.\nOnly used on GPUs exposing a dedicated transfer queue."));
+    INSERT(Settings, use_shader_cbuf_specialization,
+           tr("Specialize shaders on constant buffers (Vulkan only)"),
+           tr("Builds shader variants with the uniform values deciding their branches folded in, "
+              "used while the bound values match.\nSpeeds up heavy shaders at the cost of "
+              "building more pipelines."));
     INSERT(Settings, use_fast_gpu_time, tr("Use Fast GPU Time (Hack)"),
            tr("Enables Fast GPU Time. This option will force most games to run at their highest "
               "native resolution."));
@@ -1,8 +1,10 @@
 // SPDX-FileCopyrightText: Copyright 2018 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <filesystem>
 #include <memory>
 #include <string>
+#include <system_error>
 #include <utility>
 #include <vector>
 
@@ -11,6 +13,7 @@
 #include <QFileInfo>
 #include <QSettings>
 
+#include "common/cityhash.h"
 #include "common/fs/fs.h"
 #include "common/fs/path_util.h"
 #include "core/core.h"
@@ -82,6 +85,12 @@ std::pair<std::vector<u8>, std::string> GetGameListCachedObject(
     if (!Common::FS::Exists(path1) || !Common::FS::Exists(path2)) {
         const auto [icon, nacp] = generator();
 
+        // Without an icon the metadata most likely failed to load, e.g. because of missing keys,
+        // so it is read again next time instead of being cached.
+        if (icon.empty()) {
+            return std::make_pair(icon, nacp);
+        }
+
         QFile file1{QString::fromStdString(path1)};
         if (!file1.open(QFile::WriteOnly)) {
             LOG_ERROR(Frontend, "Failed to open cache file.");
@@ -139,6 +148,31 @@ void GetMetadataFromControlNCA(const FileSys::PatchManager& patch_manager, const
         });
 }
 
+/// Identifies the contents of a game file by its path, size and last write time
+u64 GetFileIdentity(const std::string& physical_name) {
+    std::error_code ec;
+    const std::filesystem::path path{Common::FS::ToU8String(physical_name)};
+    const auto write_time = std::filesystem::last_write_time(path, ec);
+    const auto identity = fmt::format("{}:{}:{}", physical_name, Common::FS::GetSize(path),
+                                      ec ? 0 : write_time.time_since_epoch().count());
+    return Common::CityHash64(identity.data(), identity.size());
+}
+
+/// Reads the icon and title of a game file, cached until the file changes
+void GetMetadataFromLoader(const std::string& physical_name, u64 program_id,
+                           Loader::AppLoader& loader, std::vector<u8>& icon, std::string& name) {
+    std::tie(icon, name) = GetGameListCachedObject(
+        fmt::format("{:016X}_{:016X}", program_id, GetFileIdentity(physical_name)), {},
+        [&loader] {
+            std::vector<u8> loaded_icon;
+            [[maybe_unused]] const auto res1 = loader.ReadIcon(loaded_icon);
+
+            std::string loaded_name = " ";
+            [[maybe_unused]] const auto res3 = loader.ReadTitle(loaded_name);
+            return std::make_pair(std::move(loaded_icon), std::move(loaded_name));
+        });
+}
+
 bool HasSupportedFileExtension(const std::string& file_name) {
     const QFileInfo file = QFileInfo(QString::fromStdString(file_name));
     return GameList::supported_file_extensions.contains(file.suffix(), Qt::CaseInsensitive);
@@ -396,10 +430,8 @@ void GameListWorker::ScanFileSystem(ScanTarget target, const std::string& dir_pa
                         }
 
                         std::vector<u8> icon;
-                        [[maybe_unused]] const auto res1 = loader->ReadIcon(icon);
-
-                        std::string name = " ";
-                        [[maybe_unused]] const auto res3 = loader->ReadTitle(name);
+                        std::string name;
+                        GetMetadataFromLoader(physical_name, id, *loader, icon, name);
 
                         const FileSys::PatchManager patch{id, system.GetFileSystemController(),
                                                           system.GetContentProvider()};
@@ -413,10 +445,8 @@ void GameListWorker::ScanFileSystem(ScanTarget target, const std::string& dir_pa
                     }
                 } else {
                     std::vector<u8> icon;
-                    [[maybe_unused]] const auto res1 = loader->ReadIcon(icon);
-
-                    std::string name = " ";
-                    [[maybe_unused]] const auto res3 = loader->ReadTitle(name);
+                    std::string name;
+                    GetMetadataFromLoader(physical_name, program_id, *loader, icon, name);
 
                     const FileSys::PatchManager patch{program_id, system.GetFileSystemController(),
                                                       system.GetContentProvider()};
@@ -192,6 +192,38 @@ constexpr int default_input_update_timeout = 1;
 
 constexpr size_t CopyBufferSize = 1_MiB;
 
+/// Measures the phases of the startup. They are logged once the main window has been set up, as
+/// the first phases run before logging is initialized.
+class StartupTimes {
+public:
+    /// Ends the current phase, phase must be a string literal
+    void Mark(const char* phase) {
+        const auto now = Clock::now();
+        phases.emplace_back(phase, now - last_mark);
+        last_mark = now;
+    }
+
+    void Log() const {
+        using std::chrono::duration_cast;
+        using std::chrono::milliseconds;
+        for (const auto& [phase, duration] : phases) {
+            LOG_INFO(Frontend, "Startup: {} took {} ms", phase,
+                     duration_cast<milliseconds>(duration).count());
+        }
+        LOG_INFO(Frontend, "Startup took {} ms",
+                 duration_cast<milliseconds>(last_mark - begin).count());
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    Clock::time_point begin = Clock::now();
+    Clock::time_point last_mark = begin;
+    std::vector<std::pair<const char*, Clock::duration>> phases;
+};
+
+static StartupTimes startup_times;
+
 /**
  * "Callouts" are one-time instructional messages shown to the user. In the config settings, there
  * is a bitfield "callout_flags" options, used to track if a message has already been shown to the
@@ -301,6 +333,16 @@ static void OverrideWindowsFont() {
 }
 #endif
 
+std::vector<VkDeviceInfo::Record>& GMainWindow::GetVkDeviceRecords() {
+    // Only the configuration dialogs need the records, so the instance creation and device
+    // enumeration is kept out of the startup path
+    if (!vk_device_records_populated && !UISettings::values.has_broken_vulkan) {
+        VkDeviceInfo::PopulateRecords(vk_device_records, this->window()->windowHandle());
+        vk_device_records_populated = true;
+    }
+    return vk_device_records;
+}
+
 bool GMainWindow::CheckDarkMode() {
 #ifdef __unix__
     const QPalette test_palette(qApp->palette());
@@ -326,6 +368,7 @@ GMainWindow::GMainWindow(std::unique_ptr<QtConfig> config_, bool has_broken_vulk
 
     Common::Log::Initialize();
     Common::Log::Start();
+    startup_times.Mark("Core initialization");
 
     LoadTranslation();
 
@@ -342,6 +385,7 @@ GMainWindow::GMainWindow(std::unique_ptr<QtConfig> config_, bool has_broken_vulk
 
     default_theme_paths = QIcon::themeSearchPaths();
     UpdateUITheme();
+    startup_times.Mark("UI setup");
 
     SetDiscordEnabled(UISettings::values.enable_discord_presence.GetValue());
     discord_rpc->Update();
@@ -362,9 +406,11 @@ GMainWindow::GMainWindow(std::unique_ptr<QtConfig> config_, bool has_broken_vulk
 
     ConnectMenuEvents();
     ConnectWidgetEvents();
+    startup_times.Mark("Widgets");
 
     system->HIDCore().ReloadInputDevices();
     controller_dialog->refreshConfiguration();
+    startup_times.Mark("Input devices");
 
     const auto branch_name = std::string(Common::g_scm_branch);
     const auto description = std::string(Common::g_scm_desc);
@@ -412,6 +458,7 @@ GMainWindow::GMainWindow(std::unique_ptr<QtConfig> config_, bool has_broken_vulk
     UpdateWindowTitle();
 
     show();
+    startup_times.Mark("Show main window");
 
     system->SetContentProvider(std::make_unique<FileSys::ContentProviderUnion>());
     system->RegisterContentProvider(FileSys::ContentProviderUnionSlot::FrontendManual,
@@ -421,11 +468,15 @@ GMainWindow::GMainWindow(std::unique_ptr<QtConfig> config_, bool has_broken_vulk
     // Remove cached contents generated during the previous session
     RemoveCachedContents();
 
+    startup_times.Mark("Filesystem");
+
     // Gen keys if necessary
     OnCheckFirmwareDecryption();
+    startup_times.Mark("Keys");
 
     game_list->LoadCompatibilityList();
     game_list->PopulateAsync(UISettings::values.game_dirs);
+    startup_times.Mark("Game list");
 
     // Show one-time "callout" messages to the user
     ShowTelemetryCallout();
@@ -462,8 +513,6 @@ GMainWindow::GMainWindow(std::unique_ptr<QtConfig> config_, bool has_broken_vulk
         UpdateAPIText();
         renderer_status_button->setDisabled(true);
         renderer_status_button->setChecked(false);
-    } else {
-        VkDeviceInfo::PopulateRecords(vk_device_records, this->window()->windowHandle());
     }
 
 #if defined(HAVE_SDL2) && !defined(_WIN32)
@@ -483,6 +532,8 @@ GMainWindow::GMainWindow(std::unique_ptr<QtConfig> config_, bool has_broken_vulk
 #endif
 
     SetupPrepareForSleep();
+    startup_times.Mark("Remaining setup");
+    startup_times.Log();
 
     QStringList args = QApplication::arguments();
 
@@ -1049,9 +1100,23 @@ void GMainWindow::InitializeWidgets() {
     emu_frametime_label->setToolTip(
         tr("Time taken to emulate a Switch frame, not counting framelimiting or v-sync. For "
            "full-speed emulation this should be at most 16.67 ms."));
+    input_latency_label = new QLabel();
+    input_latency_label->setToolTip(
+        tr("Estimated time from the game reading input to the frame being presented, measured as "
+           "the time taken to emulate a Switch frame plus the time taken to present it."));
+    audio_glitch_label = new QLabel();
+    audio_glitch_label->setToolTip(
+        tr("Times the audio backend ran out of samples (underruns) or had to drop samples "
+           "(overruns) since the last update. Either is heard as crackling."));
+    perf_metrics_label = new QLabel();
+    perf_metrics_label->setToolTip(
+        tr("Busy time of the emulated cores, GPU thread and render worker, pipelines built and "
+           "staging memory used per frame, texture cache evictions and the smallest time left "
+           "before the audio renderer's deadline since the last update."));
 
     for (auto& label : {shader_building_label, res_scale_label, emu_speed_label, game_fps_label,
-                        emu_frametime_label}) {
+                        emu_frametime_label, input_latency_label, audio_glitch_label,
+                        perf_metrics_label}) {
         label->setVisible(false);
         label->setFrameStyle(QFrame::NoFrame);
         label->setContentsMargins(4, 0, 4, 0);
@@ -2192,6 +2257,9 @@ void GMainWindow::OnEmulationStopped() {
     emu_speed_label->setVisible(false);
     game_fps_label->setVisible(false);
     emu_frametime_label->setVisible(false);
+    input_latency_label->setVisible(false);
+    audio_glitch_label->setVisible(false);
+    perf_metrics_label->setVisible(false);
     renderer_status_button->setEnabled(!UISettings::values.has_broken_vulkan);
 
     if (!firmware_label->text().isEmpty()) {
@@ -3740,7 +3808,7 @@ void GMainWindow::OnConfigure() {
 
     Settings::SetConfiguringGlobal(true);
     ConfigureDialog configure_dialog(this, hotkey_registry, input_subsystem.get(),
-                                     vk_device_records, *system,
+                                     GetVkDeviceRecords(), *system,
                                      !multiplayer_state->IsHostingPublicRoom());
     connect(&configure_dialog, &ConfigureDialog::LanguageChanged, this,
             &GMainWindow::OnLanguageChanged);
@@ -4009,7 +4077,7 @@ void GMainWindow::OpenPerGameConfiguration(u64 title_id, const std::string& file
     const auto v_file = Core::GetGameFileFromPath(vfs, file_name);
 
     Settings::SetConfiguringGlobal(false);
-    ConfigurePerGame dialog(this, title_id, file_name, vk_device_records, *system);
+    ConfigurePerGame dialog(this, title_id, file_name, GetVkDeviceRecords(), *system);
     dialog.LoadFromFile(v_file);
     const auto result = dialog.exec();
 
@@ -4666,11 +4734,20 @@ void GMainWindow::UpdateStatusBar() {
             tr("Game: %1 FPS").arg(std::round(results.average_game_fps), 0, 'f', 0));
     }
     emu_frametime_label->setText(tr("Frame: %1 ms").arg(results.frametime * 1000.0, 0, 'f', 2));
+    input_latency_label->setText(
+        tr("Latency: %1 ms").arg(results.input_latency * 1000.0, 0, 'f', 1));
 
     res_scale_label->setVisible(true);
     emu_speed_label->setVisible(!Settings::values.use_multi_core.GetValue());
     game_fps_label->setVisible(true);
     emu_frametime_label->setVisible(true);
+    input_latency_label->setVisible(results.input_latency > 0.0);
+    audio_glitch_label->setText(tr("Audio: %1 underruns, %2 overruns")
+                                    .arg(results.audio_underruns)
+                                    .arg(results.audio_overruns));
+    audio_glitch_label->setVisible(results.audio_underruns != 0 || results.audio_overruns != 0);
+    perf_metrics_label->setText(QString::fromStdString(Core::FormatPerfMetrics(results)));
+    perf_metrics_label->setVisible(Settings::values.show_perf_metrics.GetValue());
     firmware_label->setVisible(false);
 }
 
@@ -5254,6 +5331,7 @@ static void SetHighDPIAttributes() {
 int main(int argc, char* argv[]) {
     std::unique_ptr<QtConfig> config = std::make_unique<QtConfig>();
     UISettings::RestoreWindowState(config);
+    startup_times.Mark("Configuration");
     bool has_broken_vulkan = false;
     bool is_child = false;
     if (CheckEnvVars(&is_child)) {
@@ -5264,6 +5342,7 @@ int main(int argc, char* argv[]) {
                       Settings::values.perform_vulkan_check.GetValue())) {
         return 0;
     }
+    startup_times.Mark("Startup checks");
 
 #ifdef YUZU_CRASH_DUMPS
     Breakpad::InstallCrashHandler();
@@ -5336,6 +5415,7 @@ int main(int argc, char* argv[]) {
     // Qt changes the locale and causes issues in float conversion using std::to_string() when
     // generating shaders
     setlocale(LC_ALL, "C");
+    startup_times.Mark("Qt initialization");
 
     GMainWindow main_window{std::move(config), has_broken_vulkan};
     // After settings have been loaded by GMainWindow, apply the filter
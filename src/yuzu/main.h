@@ -442,6 +442,8 @@ private:
     void LoadTranslation();
     void OpenPerGameConfiguration(u64 title_id, const std::string& file_name);
     bool CheckDarkMode();
+    /// Enumerates the Vulkan devices on first use, this creates a Vulkan instance
+    std::vector<VkDeviceInfo::Record>& GetVkDeviceRecords();
     bool CheckFirmwarePresence();
     void SetFirmwareVersion();
     void ConfigureFilesystemProvider(const std::string& filepath);
@@ -489,6 +491,7 @@ private:
     GameListPlaceholder* game_list_placeholder;
 
     std::vector<VkDeviceInfo::Record> vk_device_records;
+    bool vk_device_records_populated = false;
 
     // Status bar elements
     QLabel* message_label = nullptr;
@@ -497,6 +500,9 @@ private:
     QLabel* emu_speed_label = nullptr;
     QLabel* game_fps_label = nullptr;
     QLabel* emu_frametime_label = nullptr;
+    QLabel* input_latency_label = nullptr;
+    QLabel* audio_glitch_label = nullptr;
+    QLabel* perf_metrics_label = nullptr;
     QLabel* tas_label = nullptr;
     QLabel* firmware_label = nullptr;
     QPushButton* gpu_accuracy_button = nullptr;
@@ -0,0 +1,221 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <utility>
+
+#include <fmt/format.h>
+
+#ifdef __linux__
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+#endif
+
+#include "common/fiber.h"
+#include "common/fs/file.h"
+#include "common/fs/fs.h"
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
+#include "common/settings.h"
+#include "core/core.h"
+#include "yuzu_cmd/benchmark.h"
+
+namespace {
+using namespace std::chrono_literals;
+
+// Stats are sampled at this interval, shorter than the window title updates for finer averages
+constexpr auto SAMPLE_INTERVAL = 1s;
+
+double Percentile(const std::vector<double>& sorted, double percentile) {
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    const auto rank = static_cast<size_t>(std::ceil(percentile / 100.0 * sorted.size()));
+    return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+}
+
+template <typename Func>
+double Mean(const std::vector<Core::PerfStatsResults>& samples, Func&& func) {
+    if (samples.empty()) {
+        return 0.0;
+    }
+    const double sum = std::accumulate(
+        samples.begin(), samples.end(), 0.0,
+        [&](double acc, const Core::PerfStatsResults& results) { return acc + func(results); });
+    return sum / static_cast<double>(samples.size());
+}
+} // Anonymous namespace
+
+Benchmark::Benchmark(Core::System& system_, u64 num_frames_, std::filesystem::path report_path_)
+    : system{system_}, num_frames{num_frames_}, report_path{std::move(report_path_)} {}
+
+Benchmark::~Benchmark() = default;
+
+void Benchmark::ConfigureSettings() {
+    Settings::values.use_speed_limit.SetValue(false);
+    Settings::values.vsync_mode.SetValue(Settings::VSyncMode::Immediate);
+}
+
+bool Benchmark::OnFrameDisplayed() {
+    std::scoped_lock lock{mutex};
+    if (is_complete) {
+        return false;
+    }
+    const auto now = Clock::now();
+    if (begin_time == Clock::time_point{}) {
+        // Start measuring on the first frame, keeping boot times out of the results
+        begin_time = now;
+        last_frame_time = now;
+        last_sample_time = now;
+        begin_thread_times = SampleThreadTimes();
+        void(system.GetAndResetPerfStats());
+        return false;
+    }
+    frame_times_ms.push_back(
+        std::chrono::duration<double, std::milli>(now - last_frame_time).count());
+    last_frame_time = now;
+
+    const bool is_last_frame = frame_times_ms.size() >= num_frames;
+    if (is_last_frame || now - last_sample_time >= SAMPLE_INTERVAL) {
+        samples.push_back(system.GetAndResetPerfStats());
+        last_sample_time = now;
+    }
+    if (!is_last_frame) {
+        return false;
+    }
+    end_time = now;
+    end_thread_times = SampleThreadTimes();
+    is_complete = true;
+    return true;
+}
+
+void Benchmark::WriteReport() const {
+    std::scoped_lock lock{mutex};
+    if (!is_complete) {
+        LOG_WARNING(Frontend, "Benchmark stopped after {} of {} frames, no report written",
+                    frame_times_ms.size(), num_frames);
+        return;
+    }
+    std::vector<double> sorted_frame_times = frame_times_ms;
+    std::ranges::sort(sorted_frame_times);
+    const double seconds = std::chrono::duration<double>(end_time - begin_time).count();
+    const double mean_frame_time =
+        std::accumulate(frame_times_ms.begin(), frame_times_ms.end(), 0.0) /
+        static_cast<double>(frame_times_ms.size());
+
+    std::string report = "metric,value\n";
+    const auto add_row = [&report](std::string_view metric, auto value) {
+        report += fmt::format("{},{}\n", metric, value);
+        LOG_INFO(Frontend, "Benchmark {}: {}", metric, value);
+    };
+    add_row("frames", frame_times_ms.size());
+    add_row("seconds", fmt::format("{:.3f}", seconds));
+    add_row("average_fps",
+            fmt::format("{:.2f}", static_cast<double>(frame_times_ms.size()) / seconds));
+    add_row("frame_time_mean_ms", fmt::format("{:.3f}", mean_frame_time));
+    add_row("frame_time_p50_ms", fmt::format("{:.3f}", Percentile(sorted_frame_times, 50.0)));
+    add_row("frame_time_p90_ms", fmt::format("{:.3f}", Percentile(sorted_frame_times, 90.0)));
+    add_row("frame_time_p99_ms", fmt::format("{:.3f}", Percentile(sorted_frame_times, 99.0)));
+    add_row("frame_time_max_ms", fmt::format("{:.3f}", sorted_frame_times.back()));
+    add_row("emulation_speed_percent",
+            fmt::format("{:.2f}", Mean(samples, [](const auto& r) { return r.emulation_speed; }) *
+                                      100.0));
+    for (size_t core = 0; core < 4; ++core) {
+        add_row(fmt::format("core{}_utilization", core),
+                fmt::format("{:.3f}", Mean(samples, [core](const auto& r) {
+                                return r.core_utilization[core];
+                            })));
+    }
+    add_row("gpu_thread_busy",
+            fmt::format("{:.3f}", Mean(samples, [](const auto& r) { return r.gpu_thread_busy; })));
+    add_row("render_worker_busy",
+            fmt::format("{:.3f}",
+                        Mean(samples, [](const auto& r) { return r.render_worker_busy; })));
+    add_row("pipelines_per_frame",
+            fmt::format("{:.3f}",
+                        Mean(samples, [](const auto& r) { return r.pipelines_per_frame; })));
+    add_row("audio_underruns",
+            std::accumulate(samples.begin(), samples.end(), u64{0},
+                            [](u64 acc, const auto& r) { return acc + r.audio_underruns; }));
+    const Common::Fiber::StackMemoryStats stack_stats = Common::Fiber::GetStackMemoryStats();
+    add_row("fiber_stack_bytes_in_use", stack_stats.bytes_in_use);
+    add_row("fiber_stack_bytes_pooled", stack_stats.bytes_pooled);
+
+    std::optional<double> adsp_margin;
+    for (const Core::PerfStatsResults& results : samples) {
+        if (results.adsp_deadline_margin) {
+            adsp_margin = std::min(adsp_margin.value_or(*results.adsp_deadline_margin),
+                                   *results.adsp_deadline_margin);
+        }
+    }
+    if (adsp_margin) {
+        add_row("adsp_deadline_margin_min_ms", fmt::format("{:.3f}", *adsp_margin * 1000.0));
+    }
+
+    // Thread ids change between runs, so threads are reported by name
+    std::map<std::string, double> cpu_seconds;
+    for (const auto& [tid, thread] : end_thread_times) {
+        const auto it = begin_thread_times.find(tid);
+        const double begin_seconds = it != begin_thread_times.end() ? it->second.cpu_seconds : 0.0;
+        cpu_seconds[thread.name] += thread.cpu_seconds - begin_seconds;
+    }
+    for (const auto& [name, thread_seconds] : cpu_seconds) {
+        add_row(fmt::format("cpu_seconds:{}", name), fmt::format("{:.3f}", thread_seconds));
+    }
+
+    if (!Common::FS::CreateParentDir(report_path)) {
+        LOG_ERROR(Frontend, "Failed to create the directory of {}",
+                  Common::FS::PathToUTF8String(report_path));
+        return;
+    }
+    Common::FS::IOFile file(report_path, Common::FS::FileAccessMode::Write,
+                            Common::FS::FileType::TextFile);
+    if (file.WriteString(report) != report.size()) {
+        LOG_ERROR(Frontend, "Failed to write benchmark report to {}",
+                  Common::FS::PathToUTF8String(report_path));
+        return;
+    }
+    LOG_INFO(Frontend, "Benchmark report written to {}", Common::FS::PathToUTF8String(report_path));
+}
+
+std::map<u64, Benchmark::ThreadTime> Benchmark::SampleThreadTimes() {
+    std::map<u64, ThreadTime> thread_times;
+#ifdef __linux__
+    const double ticks_per_second = static_cast<double>(sysconf(_SC_CLK_TCK));
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator("/proc/self/task", ec)) {
+        std::ifstream stat_file(entry.path() / "stat");
+        std::string stat;
+        if (!std::getline(stat_file, stat)) {
+            continue;
+        }
+        // The name is enclosed in parentheses and may contain spaces, fields follow the last one
+        const size_t name_begin = stat.find('(');
+        const size_t name_end = stat.rfind(')');
+        if (name_begin == std::string::npos || name_end == std::string::npos) {
+            continue;
+        }
+        std::istringstream fields(stat.substr(name_end + 1));
+        std::string field;
+        u64 utime{};
+        u64 stime{};
+        // utime and stime are the 14th and 15th fields, the state being the 3rd
+        for (int index = 3; index <= 15 && fields >> field; ++index) {
+            if (index == 14) {
+                utime = std::strtoull(field.c_str(), nullptr, 10);
+            } else if (index == 15) {
+                stime = std::strtoull(field.c_str(), nullptr, 10);
+            }
+        }
+        const u64 tid = std::strtoull(entry.path().filename().c_str(), nullptr, 10);
+        thread_times[tid] = ThreadTime{
+            .name = stat.substr(name_begin + 1, name_end - name_begin - 1),
+            .cpu_seconds = static_cast<double>(utime + stime) / ticks_per_second,
+        };
+    }
+#endif
+    return thread_times;
+}
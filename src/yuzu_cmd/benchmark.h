@@ -0,0 +1,62 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <chrono>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "common/common_types.h"
+#include "core/perf_stats.h"
+
+namespace Core {
+class System;
+}
+
+/// Runs a title for a fixed number of displayed frames and reports frame time percentiles, the
+/// CPU time of each host thread and the GPU thread's busy time, for regression testing in CI.
+class Benchmark {
+public:
+    explicit Benchmark(Core::System& system_, u64 num_frames_, std::filesystem::path report_path_);
+    ~Benchmark();
+
+    /// Disables the speed limit and v-sync so frames are produced as fast as possible
+    static void ConfigureSettings();
+
+    /// Records a displayed frame, returns true on the frame that completes the benchmark.
+    /// Called from the render thread.
+    bool OnFrameDisplayed();
+
+    /// Writes the results to the report file and to the log
+    void WriteReport() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct ThreadTime {
+        std::string name;
+        double cpu_seconds;
+    };
+
+    /// Returns the CPU time spent by each host thread, indexed by thread id
+    static std::map<u64, ThreadTime> SampleThreadTimes();
+
+    Core::System& system;
+    u64 num_frames;
+    std::filesystem::path report_path;
+
+    mutable std::mutex mutex;
+    std::vector<double> frame_times_ms;
+    Clock::time_point begin_time;
+    Clock::time_point end_time;
+    Clock::time_point last_frame_time;
+    Clock::time_point last_sample_time;
+    std::vector<Core::PerfStatsResults> samples;
+    std::map<u64, ThreadTime> begin_thread_times;
+    std::map<u64, ThreadTime> end_thread_times;
+    bool is_complete = false;
+};
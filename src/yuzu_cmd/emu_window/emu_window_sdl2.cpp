@@ -11,8 +11,10 @@
 #include "hid_core/hid_core.h"
 #include "input_common/drivers/keyboard.h"
 #include "input_common/drivers/mouse.h"
+#include "input_common/drivers/tas_input.h"
 #include "input_common/drivers/touch_screen.h"
 #include "input_common/main.h"
+#include "yuzu_cmd/benchmark.h"
 #include "yuzu_cmd/emu_window/emu_window_sdl2.h"
 #include "yuzu_cmd/yuzu_icon.h"
 
@@ -221,17 +223,30 @@ void EmuWindow_SDL2::WaitEvent() {
     }
 
     const u32 current_time = SDL_GetTicks();
-    if (current_time > last_time + 2000) {
+    if (!benchmark && current_time > last_time + 2000) {
         const auto results = system.GetAndResetPerfStats();
-        const auto title =
+        auto title =
             fmt::format("yuzu {} | {}-{} | FPS: {:.0f} ({:.0f}%)", Common::g_build_fullname,
                         Common::g_scm_branch, Common::g_scm_desc, results.average_game_fps,
                         results.emulation_speed * 100.0);
+        if (Settings::values.show_perf_metrics.GetValue()) {
+            title += fmt::format(" | {}", Core::FormatPerfMetrics(results));
+        }
         SDL_SetWindowTitle(render_window, title.c_str());
         last_time = current_time;
     }
 }
 
+void EmuWindow_SDL2::OnFrameDisplayed() {
+    input_subsystem->GetTas()->UpdateThread();
+    if (benchmark && benchmark->OnFrameDisplayed()) {
+        // Wake up the main thread to stop emulation
+        SDL_Event event{};
+        event.type = SDL_QUIT;
+        SDL_PushEvent(&event);
+    }
+}
+
 // Credits to Samantas5855 and others for this function.
 void EmuWindow_SDL2::SetWindowIcon() {
     SDL_RWops* const yuzu_icon_stream = SDL_RWFromConstMem((void*)yuzu_icon, yuzu_icon_size);
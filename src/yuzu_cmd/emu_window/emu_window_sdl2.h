@@ -10,6 +10,8 @@
 
 struct SDL_Window;
 
+class Benchmark;
+
 namespace Core {
 class System;
 }
@@ -36,6 +38,14 @@ public:
     // Sets the window icon from yuzu.bmp
     void SetWindowIcon();
 
+    /// Reports displayed frames to the benchmark, which takes over sampling the perf stats
+    void SetBenchmark(Benchmark* benchmark_) {
+        benchmark = benchmark_;
+    }
+
+    /// Plays back TAS scripts and closes the window once the benchmark is complete
+    void OnFrameDisplayed() override;
+
 protected:
     /// Called by WaitEvent when a key is pressed or released.
     void OnKeyEvent(int key, u8 state);
@@ -90,6 +100,9 @@ protected:
 
     /// yuzu core instance
     Core::System& system;
+
+    /// Benchmark being run, if any
+    Benchmark* benchmark{};
 };
 
 class DummyContext : public Core::Frontend::GraphicsContext {};
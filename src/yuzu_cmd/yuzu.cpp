@@ -11,6 +11,7 @@
 #include <fmt/ostream.h>
 
 #include "common/detached_tasks.h"
+#include "common/fs/path_util.h"
 #include "common/logging/backend.h"
 #include "common/logging/log.h"
 #include "common/microprofile.h"
@@ -31,10 +32,14 @@
 #include "core/loader/loader.h"
 #include "core/telemetry_session.h"
 #include "frontend_common/config.h"
+#include "hid_core/frontend/emulated_controller.h"
+#include "hid_core/hid_core.h"
+#include "input_common/drivers/tas_input.h"
 #include "input_common/main.h"
 #include "network/network.h"
 #include "sdl_config.h"
 #include "video_core/renderer_base.h"
+#include "yuzu_cmd/benchmark.h"
 #include "yuzu_cmd/emu_window/emu_window_sdl2.h"
 #include "yuzu_cmd/emu_window/emu_window_sdl2_gl.h"
 #include "yuzu_cmd/emu_window/emu_window_sdl2_null.h"
@@ -71,6 +76,10 @@ __declspec(dllexport) int AmdPowerXpressRequestHighPerformance = 1;
 static void PrintHelp(const char* argv0) {
     std::cout << "Usage: " << argv0
               << " [options] <filename>\n"
+                 "-b, --benchmark=frames Run for the given number of frames without a speed "
+                 "limit and write a performance report\n"
+                 "-o, --benchmark-report=file Path of the benchmark report, benchmark.csv in the "
+                 "log directory by default\n"
                  "-c, --config          Load the specified configuration file\n"
                  "-f, --fullscreen      Start in fullscreen mode\n"
                  "-g, --game            File path of the game to load\n"
@@ -78,6 +87,10 @@ static void PrintHelp(const char* argv0) {
                  "-m, --multiplayer=nick:password@address:port"
                  " Nickname, password, address and port for multiplayer\n"
                  "-p, --program         Pass following string as arguments to executable\n"
+                 "-r, --tas-record      Record the input of player 1 to record.txt in the TAS "
+                 "directory\n"
+                 "-t, --tas-play        Play back the TAS scripts, the controllers must be "
+                 "mapped to the TAS engine\n"
                  "-u, --user            Select a specific user profile from 0 to 7\n"
                  "-v, --version         Output version information and exit\n";
 }
@@ -211,6 +224,10 @@ int main(int argc, char** argv) {
     std::optional<std::string> config_path;
     std::string program_args;
     std::optional<int> selected_user;
+    std::optional<u64> benchmark_frames;
+    std::optional<std::string> benchmark_report;
+    bool tas_play = false;
+    bool tas_record = false;
 
     bool use_multiplayer = false;
     bool fullscreen = false;
@@ -221,12 +238,16 @@ int main(int argc, char** argv) {
 
     static struct option long_options[] = {
         // clang-format off
+        {"benchmark", required_argument, 0, 'b'},
+        {"benchmark-report", required_argument, 0, 'o'},
         {"config", required_argument, 0, 'c'},
         {"fullscreen", no_argument, 0, 'f'},
         {"help", no_argument, 0, 'h'},
         {"game", required_argument, 0, 'g'},
         {"multiplayer", required_argument, 0, 'm'},
         {"program", optional_argument, 0, 'p'},
+        {"tas-play", no_argument, 0, 't'},
+        {"tas-record", no_argument, 0, 'r'},
         {"user", required_argument, 0, 'u'},
         {"version", no_argument, 0, 'v'},
         {0, 0, 0, 0},
@@ -234,9 +255,15 @@ int main(int argc, char** argv) {
     };
 
     while (optind < argc) {
-        int arg = getopt_long(argc, argv, "g:fhvp::c:u:", long_options, &option_index);
+        int arg = getopt_long(argc, argv, "b:o:g:fhvp::c:u:tr", long_options, &option_index);
         if (arg != -1) {
             switch (static_cast<char>(arg)) {
+            case 'b':
+                benchmark_frames = std::strtoull(optarg, nullptr, 0);
+                break;
+            case 'o':
+                benchmark_report = optarg;
+                break;
             case 'c':
                 config_path = optarg;
                 break;
@@ -289,6 +316,12 @@ int main(int argc, char** argv) {
                 program_args = argv[optind];
                 ++optind;
                 break;
+            case 'r':
+                tas_record = true;
+                break;
+            case 't':
+                tas_play = true;
+                break;
             case 'u':
                 selected_user = atoi(optarg);
                 break;
@@ -322,6 +355,13 @@ int main(int argc, char** argv) {
         Settings::values.current_user = std::clamp(*selected_user, 0, 7);
     }
 
+    if (benchmark_frames) {
+        Benchmark::ConfigureSettings();
+    }
+    if (tas_play || tas_record) {
+        Settings::values.tas_enable = true;
+    }
+
 #ifdef _WIN32
     LocalFree(argv_w);
 #endif
@@ -359,6 +399,16 @@ int main(int argc, char** argv) {
         break;
     }
 
+    std::unique_ptr<Benchmark> benchmark;
+    if (benchmark_frames) {
+        const auto report_path =
+            benchmark_report ? std::filesystem::path{*benchmark_report}
+                             : Common::FS::GetYuzuPath(Common::FS::YuzuPath::LogDir) /
+                                   "benchmark.csv";
+        benchmark = std::make_unique<Benchmark>(system, *benchmark_frames, report_path);
+        emu_window->SetBenchmark(benchmark.get());
+    }
+
 #ifdef _WIN32
     Common::Windows::SetCurrentTimerResolutionToMaximum();
     system.CoreTiming().SetTimerResolutionNs(Common::Windows::GetCurrentTimerResolution());
@@ -435,6 +485,36 @@ int main(int argc, char** argv) {
         exit(0);
     });
 
+    auto* const tas = input_subsystem.GetTas();
+    auto* const player_1 = system.HIDCore().GetEmulatedController(Core::HID::NpadIdType::Player1);
+    if (tas_play) {
+        tas->Reset();
+        tas->StartStop();
+    }
+    if (tas_record) {
+        // Same as the controller debugger in the Qt frontend
+        player_1->SetCallback({
+            .on_change =
+                [tas, player_1](Core::HID::ControllerTriggerType type) {
+                    if (type != Core::HID::ControllerTriggerType::Button &&
+                        type != Core::HID::ControllerTriggerType::Stick) {
+                        return;
+                    }
+                    u64 buttons = 0;
+                    std::size_t index = 0;
+                    for (const auto& button : player_1->GetButtonsValues()) {
+                        buttons |= button.value ? 1LLU << index : 0;
+                        index++;
+                    }
+                    const auto sticks = player_1->GetSticks();
+                    tas->RecordInput(buttons, {sticks.left.x / 32767.f, sticks.left.y / 32767.f},
+                                     {sticks.right.x / 32767.f, sticks.right.y / 32767.f});
+                },
+            .is_npad_service = false,
+        });
+        void(tas->Record());
+    }
+
 #ifdef __unix__
     Common::Linux::StartGamemode();
 #endif
@@ -448,6 +528,12 @@ int main(int argc, char** argv) {
     }
     system.DetachDebugger();
     void(system.Pause());
+    if (benchmark) {
+        benchmark->WriteReport();
+    }
+    if (tas_record && !tas->Record()) {
+        tas->SaveRecording(false);
+    }
     system.ShutdownMainProcess();
 
 #ifdef __unix__
@@ -0,0 +1,139 @@
+// SPDX-FileCopyrightText: 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstdlib>
+#include <filesystem>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+#include <getopt.h>
+
+#include <fmt/format.h>
+
+#include "common/common_types.h"
+#include "common/fs/fs.h"
+#include "common/fs/path_util.h"
+#include "common/logging/backend.h"
+#include "common/logging/log.h"
+#include "common/polyfill_thread.h"
+#include "common/scm_rev.h"
+#include "common/settings.h"
+#include "video_core/rasterizer_interface.h"
+#include "video_core/renderer_vulkan/vk_offline_pipeline_builder.h"
+
+static void PrintHelp(const char* argv0) {
+    LOG_INFO(Frontend,
+             "Usage: {}"
+             " [options] <title id> <pipeline cache>\n"
+             "Builds the Vulkan pipelines of a title's transferable pipeline cache (vulkan.bin)\n"
+             "and writes the driver pipeline cache and pipeline binaries next to it.\n"
+             "-o, --output   The shader directory to write to, defaults to yuzu's\n"
+             "-d, --device   The index of the Vulkan device to build for\n"
+             "-h, --help     Display this help and exit\n"
+             "-v, --version  Output version information and exit\n",
+             argv0);
+}
+
+static void PrintVersion() {
+    LOG_INFO(Frontend, "yuzu shader pre-warmer {} {}", Common::g_scm_branch, Common::g_scm_desc);
+}
+
+/// Application entry point
+int main(int argc, char** argv) {
+    Common::Log::Initialize();
+    Common::Log::SetColorConsoleBackendEnabled(true);
+    Common::Log::Start();
+
+    std::optional<std::filesystem::path> output_dir;
+    std::optional<int> device_index;
+
+    static struct option long_options[] = {
+        // clang-format off
+        {"output", required_argument, 0, 'o'},
+        {"device", required_argument, 0, 'd'},
+        {"help", no_argument, 0, 'h'},
+        {"version", no_argument, 0, 'v'},
+        {0, 0, 0, 0},
+        // clang-format on
+    };
+
+    int option_index = 0;
+    while (true) {
+        const int arg = getopt_long(argc, argv, "o:d:hv", long_options, &option_index);
+        if (arg == -1) {
+            break;
+        }
+        switch (static_cast<char>(arg)) {
+        case 'o':
+            output_dir = optarg;
+            break;
+        case 'd':
+            device_index = std::atoi(optarg);
+            break;
+        case 'h':
+            PrintHelp(argv[0]);
+            return 0;
+        case 'v':
+            PrintVersion();
+            return 0;
+        default:
+            PrintHelp(argv[0]);
+            return -1;
+        }
+    }
+    if (argc - optind != 2) {
+        PrintHelp(argv[0]);
+        return -1;
+    }
+    const u64 title_id{std::strtoull(argv[optind], nullptr, 16)};
+    const std::filesystem::path input_cache{argv[optind + 1]};
+    if (title_id == 0) {
+        LOG_CRITICAL(Frontend, "Invalid title id {}", argv[optind]);
+        return -1;
+    }
+
+    if (output_dir) {
+        Common::FS::SetYuzuPath(Common::FS::YuzuPath::ShaderDir, *output_dir);
+    }
+    if (device_index) {
+        Settings::values.vulkan_device.SetValue(*device_index);
+    }
+
+    // The pipeline cache reads the transferable cache from the title's shader directory
+    const auto title_dir{Common::FS::GetYuzuPath(Common::FS::YuzuPath::ShaderDir) /
+                         fmt::format("{:016x}", title_id)};
+    if (!Common::FS::CreateDirs(title_dir)) {
+        LOG_CRITICAL(Frontend, "Failed to create shader directory {}",
+                     Common::FS::PathToUTF8String(title_dir));
+        return -1;
+    }
+    const auto target_cache{title_dir / "vulkan.bin"};
+    std::error_code error;
+    if (!std::filesystem::equivalent(input_cache, target_cache, error)) {
+        std::filesystem::copy_file(input_cache, target_cache,
+                                   std::filesystem::copy_options::overwrite_existing, error);
+        if (error) {
+            LOG_CRITICAL(Frontend, "Failed to copy {} to {}: {}",
+                         Common::FS::PathToUTF8String(input_cache),
+                         Common::FS::PathToUTF8String(target_cache), error.message());
+            return -1;
+        }
+    }
+
+    std::stop_source stop_source;
+    const auto callback{[](VideoCore::LoadCallbackStage stage, size_t value, size_t total) {
+        if (stage == VideoCore::LoadCallbackStage::Build && total != 0) {
+            LOG_INFO(Frontend, "Built {} of {} pipelines", value, total);
+        }
+    }};
+    try {
+        Vulkan::BuildOfflinePipelineCaches(title_id, stop_source.get_token(), callback);
+    } catch (const std::runtime_error& exception) {
+        LOG_CRITICAL(Frontend, "{}", exception.what());
+        return -1;
+    }
+    LOG_INFO(Frontend, "Pipeline caches written to {}", Common::FS::PathToUTF8String(title_dir));
+    return 0;
+}